@@ -5,13 +5,9 @@
 #include "engine/BedrockFileSystem.hpp"
 #include "engine/BedrockMemory.hpp"
 #include "ray/Ray.hpp"
-#include "geometry/sphere/Sphere.hpp"
 #include "engine/BedrockMath.hpp"
 #include "engine/job_system/JobSystem.hpp"
-#include "geometry/HitRecord.hpp"
-#include "material/diffuse/Diffuse.hpp"
-#include "material/metal/Metal.hpp"
-#include "material/dielectric/Dielectric.hpp"
+#include "renderer/ProgressiveRenderer.hpp"
 
 #include "glm/glm.hpp"
 
@@ -19,55 +15,6 @@
 
 using namespace MFA;
 
-static float Infinity = std::numeric_limits<float>::infinity();
-
-//-------------------------------------------------------------------------------------------------
-
-glm::vec3 RayTracingWeekendApplication::RayColor(Ray const & ray, int maxDepth) {
-    // glm::vec3 position {};
-    // glm::vec3 normal {};
-    // glm::vec3 color {};
-    
-    // bool hit = false;
-
-    if (maxDepth <= 0) {
-        return glm::vec3 {};
-    }
-    
-    auto const tMax = Infinity;
-
-    HitRecord hitRecord {};
-    hitRecord.t = tMax;
-
-    bool hasHit = false;
-    
-    for (auto const & geometry : mGeometries)
-    {
-        if (geometry->HasIntersect(
-            ray, 
-            0.001f,             // T min
-            hitRecord.t,        // T max
-            hitRecord) == true)
-        {
-            hasHit = true;
-        }
-    }
-
-    if (hasHit) {
-        glm::vec3 attenuation {};
-        Ray scatteredRay;
-        bool const hasScatteredRay = hitRecord.material->Scatter(ray, hitRecord, attenuation, scatteredRay);
-        if (hasScatteredRay)
-        {
-            return attenuation * RayColor(scatteredRay, maxDepth - 1);
-        }
-        return glm::vec3 {0.0f, 0.0f, 0.0f};
-    }
-    
-    auto const t = 0.5f * (ray.GetDirection().y + 1.0f);
-    return glm::mix(glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(0.5f, 0.7f, 1.0f), t);
-}
-
 //-------------------------------------------------------------------------------------------------
 
 RayTracingWeekendApplication::RayTracingWeekendApplication() = default;
@@ -109,105 +56,50 @@ void RayTracingWeekendApplication::run() {
         focusDistance
     };
     
-    // auto redDiffMat = std::make_shared<Diffuse>(glm::vec3 {0.7f, 0.0f, 0.0f});
-    // auto blueDiffMat = std::make_shared<Diffuse>(glm::vec3 {0.0f, 0.0f, 0.7f});
-    // auto metal1 = std::make_shared<Metal>(glm::vec3 {0.8f, 0.8f, 0.8f}, 0.1f);
-    // auto metal2 = std::make_shared<Metal>(glm::vec3 {0.8f, 0.6f, 0.2f}, 0.5f);
-    // auto dielectric1 = std::make_shared<Dielectric>(glm::vec3 {1.0f, 1.0f, 1.0f}, 1.5f);
-
-    // mGeometries.emplace_back(std::make_shared<Sphere>(
-    //     glm::vec3{0.0f, 0.0f, -FocalLength},
-    //     0.5f,
-    //     redDiffMat
-    // ));
-    
-    // mGeometries.emplace_back(std::make_shared<Sphere>(
-    //     glm::vec3{0.0f, -100.5f, -FocalLength},
-    //     100.0f,
-    //     blueDiffMat
-    // ));
-
-    // mGeometries.emplace_back(std::make_shared<Sphere>(
-    //     glm::vec3{-1.0f, 0.0f, -FocalLength},
-    //     0.5f,
-    //     metal1
-    // ));
-
-    // mGeometries.emplace_back(std::make_shared<Sphere>(
-    //     glm::vec3{1.0f, 0.0f, -FocalLength},
-    //     0.5f,
-    //     dielectric1
-    // ));
+    // Scene has to be the same on every run, Otherwise a checkpoint cannot be resumed
+    Math::SetRandomSeed(SceneSeed);
+    if (std::string(ModelPath).empty()) {
+        mScene = Scene::CreateFinalScene(SmallSphereCount);
+    } else {
+        mScene = Scene::CreateModelScene(Path::ForReadWrite(ModelPath), ModelScale);
+    }
+    MFA_LOG_INFO("Scene has %zu geometries", mScene->GetGeometryCount());
 
-    auto const RandomVec3 = [](float min = 0.0f, float max = 1.0f)-> glm::vec3 {
-        return glm::vec3 {
-            Math::Random(min, max),
-            Math::Random(min, max),
-            Math::Random(min, max)
-        };
+    ProgressiveRenderer renderer {
+        static_cast<int>(ImageWidth),
+        static_cast<int>(ImageHeight),
+        MaxDepth
     };
-
-    auto ground_material = std::make_shared<Diffuse>(glm::vec3(0.5f, 0.5f, 0.5f));
-    mGeometries.emplace_back(std::make_shared<Sphere>(glm::vec3(0.0f,-1000.0f,0.0f), 1000.0f, ground_material));
-
-    for (int a = -11; a < 11; a++) {
-        for (int b = -11; b < 11; b++) {
-            float choose_mat = Math::Random<float>(0.0f, 1.0f);
-            glm::vec3 center(a + 0.9f * Math::Random<float>(0.0f, 1.0f), 0.2f, b + 0.9f * Math::Random<float>(0.0f, 1.0f));
-
-            if ((center - glm::vec3(4.0f, 0.2f, 0.0f)).length() > 0.9f) {
-                std::shared_ptr<Material> sphere_material = nullptr;
-
-                if (choose_mat < 0.8f) {
-                    // diffuse
-                    auto albedo = RandomVec3() * RandomVec3();
-                    sphere_material = std::make_shared<Diffuse>(albedo);
-                    mGeometries.emplace_back(std::make_shared<Sphere>(center, 0.2f, sphere_material));
-                } else if (choose_mat < 0.95f) {
-                    // metal
-                    auto albedo = RandomVec3(0.5f, 1.0f);
-                    auto fuzz = Math::Random(0.0f, 0.5f);
-                    sphere_material = std::make_shared<Metal>(albedo, fuzz);
-                    mGeometries.emplace_back(std::make_shared<Sphere>(center, 0.2f, sphere_material));
-                } else {
-                    // glass
-                    sphere_material = std::make_shared<Dielectric>(glm::vec3 {1.0f, 1.0f, 1.0f}, 1.5f);
-                    mGeometries.emplace_back(make_shared<Sphere>(center, 0.2f, sphere_material));
-                }
-            }
-        }
+    renderer.SetCheckpointPath(Path::ForReadWrite(CheckpointName));
+    if (renderer.LoadCheckpoint()) {
+        MFA_LOG_INFO("Resuming from checkpoint with %llu samples", static_cast<unsigned long long>(renderer.GetTotalSampleCount()));
     }
 
-    auto material1 = std::make_shared<Dielectric>(glm::vec3 {1.0f, 1.0f, 1.0f}, 1.5f);
-    mGeometries.emplace_back(std::make_shared<Sphere>(glm::vec3(0.0f, 1.0f, 0.0f), 1.0f, material1));
-
-    auto material2 = std::make_shared<Diffuse>(glm::vec3(0.4f, 0.2f, 0.1f));
-    mGeometries.emplace_back(std::make_shared<Sphere>(glm::vec3(-4.0f, 1.0f, 0.0f), 1.0f, material2));
-
-    auto material3 = std::make_shared<Metal>(glm::vec3(0.7f, 0.6f, 0.5f), 0.0f);
-    mGeometries.emplace_back(std::make_shared<Sphere>(glm::vec3(4.0f, 1.0f, 0.0f), 1.0f, material3));
+    ProgressiveRenderer::Budget budget {};
+    budget.minSamplesPerPixel = MinSampleRate;
+    budget.maxSamplesPerPixel = MaxSampleRate;
+    budget.maxRelativeError = MaxRelativeError;
+    budget.maxTimeInSec = MaxRenderTimeInSec;
+    budget.checkpointIntervalInSec = CheckpointIntervalInSec;
+    renderer.Render(*mScene, camera, budget);
+    renderer.WriteCheckpoint();
 
     for (int i = 0; i < ImageWidth; ++i) {
         for (int j = 0; j < ImageHeight; ++j) {
-            JS::AssignTask([this, i, j, &camera](int num, int count)->void {
-                glm::vec3 color {};
-                for (int s = 0; s < SampleRate; ++s) {
-                    auto u = (static_cast<float>(i) + Math::Random(-1.0f, 1.0f)) / (ImageWidth - 1.0f);
-                    auto v = (static_cast<float>(j) + Math::Random(-1.0f, 1.0f)) / (ImageHeight - 1.0f);
-                    auto const ray = camera.CreateRay(u, v);
-                    color += RayColor(ray, MaxDepth);
-                }
-                color *= ColorPerSample;
-                // reinhard tone mapping
-                color = color / (color + glm::vec3(1.0f));
-                // Gamma correct
-                color = pow(color, glm::vec3(GammaCorrection)); 
-                PutPixel(i, j, color);
-            });
+            PutPixel(i, j, ProgressiveRenderer::ToneMap(renderer.GetColor(i, j)));
         }
     }
 
-    JS::WaitForThreadsToFinish();
+    auto const pixelCount = static_cast<int>(ImageWidth * ImageHeight);
+    MFA_LOG_INFO(
+        "Traced %llu rays in %f seconds, %f million rays per second. %d of %d pixels converged, %f samples per pixel",
+        static_cast<unsigned long long>(renderer.GetRayCount()),
+        renderer.GetRenderTimeInSec(),
+        static_cast<double>(renderer.GetRayCount()) / renderer.GetRenderTimeInSec() / 1000000.0,
+        renderer.GetConvergedPixelCount(),
+        pixelCount,
+        static_cast<double>(renderer.GetTotalSampleCount()) / pixelCount
+    );
 
     MFA_LOG_INFO("Image generation is complete");
     
@@ -1,8 +1,8 @@
 #pragma once
 
 #include "engine/BedrockMemory.hpp"
-#include "geometry/Geometry.hpp"
 #include "camera/Camera.hpp"
+#include "scene/Scene.hpp"
 
 #include <string>
 #include <vector>
@@ -27,25 +27,32 @@ private:
     
     void PutPixel(int x, int y, glm::vec3 const & color);
 
-    [[nodiscard]]
-    glm::vec3 RayColor(Ray const & ray, int maxDepth);
-
     static constexpr char const * OutputFile = "output.jpeg";
     static constexpr float AspectRatio = 16.0f / 9.0f;
     static constexpr float ImageWidth = 400.0f;
     static constexpr float ImageHeight = static_cast<int>(ImageWidth / AspectRatio);
     static constexpr float FocalLength = 1.0f;
+    static constexpr int SmallSphereCount = 484;
+    // Resolved with Path::ForReadWrite, For example "models/FlightHelmet/glTF/FlightHelmet.gltf".
+    // Spheres of the final scene are rendered when it is empty.
+    static constexpr char const * ModelPath = "";
+    static constexpr float ModelScale = 2.0f;
     static constexpr int ComponentCount = 3;
     static constexpr int Quality = 100;
-    static constexpr int SampleRate = 100;
-    static constexpr float ColorPerSample = 1.0f / static_cast<float>(SampleRate);
     static constexpr int MaxDepth = 50;
-    static constexpr float GammaCorrection = 1.0f / 2.2f;
+    static constexpr unsigned int SceneSeed = 1;
+    // Progressive rendering budget, Pixels stop early once their noise is low enough
+    static constexpr char const * CheckpointName = "ray_tracing_checkpoint";
+    static constexpr int MinSampleRate = 16;
+    static constexpr int MaxSampleRate = 1024;
+    static constexpr float MaxRelativeError = 0.02f;
+    static constexpr double MaxRenderTimeInSec = 300.0;
+    static constexpr double CheckpointIntervalInSec = 10.0;
 
     std::string mFilePath {};
     std::shared_ptr<MFA::SmartBlob> mImageBlob = nullptr;
     uint8_t * mByteArray = nullptr;
 
-    std::vector<std::shared_ptr<Geometry>> mGeometries {};
+    std::unique_ptr<Scene> mScene = nullptr;
 
 };
@@ -0,0 +1,330 @@
+#include "BVH.hpp"
+
+#include "engine/BedrockAssert.hpp"
+#include "geometry/Geometry.hpp"
+#include "geometry/HitRecord.hpp"
+#include "geometry/sphere/Sphere.hpp"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+struct BuildContext {
+    std::vector<AABB> const & bounds;
+    std::vector<glm::vec3> centers {};
+    uint32_t leafBatchWidth = 1;
+    uint32_t maxLeafSize = 1;
+    std::vector<BVH::Node> & nodes;
+    std::vector<uint32_t> & indices;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+// Leaves are tested in SIMD batches, So cost of a leaf grows per batch and not per geometry
+static float BatchCount(BuildContext const & context, uint32_t const geometryCount) {
+    return static_cast<float>((geometryCount + context.leafBatchWidth - 1) / context.leafBatchWidth);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+static uint32_t BuildNode(
+    BuildContext & context,
+    uint32_t const first,
+    uint32_t const count,
+    int const depth
+) {
+    auto & nodes = context.nodes;
+    auto & indices = context.indices;
+    auto const & bounds = context.bounds;
+    auto const & centers = context.centers;
+
+    auto const nodeIndex = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+
+    AABB nodeBounds {};
+    AABB centerBounds {};
+    for (uint32_t i = first; i < first + count; ++i) {
+        nodeBounds.Grow(bounds[indices[i]]);
+        centerBounds.Grow(centers[indices[i]]);
+    }
+    nodes[nodeIndex].bounds = nodeBounds;
+
+    auto const makeLeaf = [&nodes, nodeIndex, first, count]()->uint32_t {
+        MFA_ASSERT(count <= std::numeric_limits<uint16_t>::max());
+        auto & node = nodes[nodeIndex];
+        node.rightOrFirst = first;
+        node.geometryCount = static_cast<uint16_t>(count);
+        return nodeIndex;
+    };
+
+    if (count <= context.maxLeafSize || depth >= BVH::MaxDepth - 1) {
+        return makeLeaf();
+    }
+
+    // Binned SAH: Geometries are bucketed by their center along each axis and
+    // every boundary between two bins is evaluated as a split candidate.
+    static constexpr int BinCount = BVH::BinCount;
+    struct Bin {
+        AABB bounds {};
+        uint32_t count = 0;
+    };
+
+    auto const centerExtent = centerBounds.GetExtent();
+    float bestCost = std::numeric_limits<float>::max();
+    int bestAxis = -1;
+    int bestSplit = 0;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        if (centerExtent[axis] <= 0.0f) {
+            continue;
+        }
+        auto const binScale = static_cast<float>(BinCount) / centerExtent[axis];
+
+        std::array<Bin, BinCount> bins {};
+        for (uint32_t i = first; i < first + count; ++i) {
+            auto const index = indices[i];
+            auto const binIndex = std::min(
+                BinCount - 1,
+                static_cast<int>((centers[index][axis] - centerBounds.min[axis]) * binScale)
+            );
+            bins[binIndex].bounds.Grow(bounds[index]);
+            ++bins[binIndex].count;
+        }
+
+        // Sweep from both sides to get the area and count of each side of every split
+        std::array<float, BinCount - 1> leftArea {};
+        std::array<uint32_t, BinCount - 1> leftCount {};
+        AABB leftBounds {};
+        uint32_t leftSum = 0;
+        for (int i = 0; i < BinCount - 1; ++i) {
+            leftBounds.Grow(bins[i].bounds);
+            leftSum += bins[i].count;
+            leftArea[i] = leftBounds.GetSurfaceArea();
+            leftCount[i] = leftSum;
+        }
+
+        AABB rightBounds {};
+        uint32_t rightSum = 0;
+        for (int i = BinCount - 1; i > 0; --i) {
+            rightBounds.Grow(bins[i].bounds);
+            rightSum += bins[i].count;
+            auto const cost = leftArea[i - 1] * BatchCount(context, leftCount[i - 1])
+                + rightBounds.GetSurfaceArea() * BatchCount(context, rightSum);
+            if (leftCount[i - 1] > 0 && rightSum > 0 && cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = i;
+            }
+        }
+    }
+
+    auto const parentArea = nodeBounds.GetSurfaceArea();
+    auto const leafCost = BVH::IntersectionCost * BatchCount(context, count);
+    auto const splitCost = parentArea > 0.0f
+        ? BVH::TraversalCost + BVH::IntersectionCost * bestCost / parentArea
+        : leafCost;
+
+    bool const fitsInLeaf = count <= std::numeric_limits<uint16_t>::max();
+    if (bestAxis < 0 || (splitCost >= leafCost && fitsInLeaf)) {
+        return makeLeaf();
+    }
+
+    auto const binScale = static_cast<float>(BinCount) / centerExtent[bestAxis];
+    auto const middle = std::partition(
+        indices.begin() + first,
+        indices.begin() + first + count,
+        [&](uint32_t const index)->bool {
+            auto const binIndex = std::min(
+                BinCount - 1,
+                static_cast<int>((centers[index][bestAxis] - centerBounds.min[bestAxis]) * binScale)
+            );
+            return binIndex < bestSplit;
+        }
+    );
+    auto const leftCount = static_cast<uint32_t>(middle - (indices.begin() + first));
+    MFA_ASSERT(leftCount > 0 && leftCount < count);
+
+    BuildNode(context, first, leftCount, depth + 1);
+    auto const rightIndex = BuildNode(context, first + leftCount, count - leftCount, depth + 1);
+
+    auto & node = nodes[nodeIndex];
+    node.rightOrFirst = rightIndex;
+    node.geometryCount = 0;
+    node.axis = static_cast<uint16_t>(bestAxis);
+
+    return nodeIndex;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+BVH::BVH() = default;
+
+//-------------------------------------------------------------------------------------------------
+
+void BVH::Build(std::vector<std::shared_ptr<Geometry>> geometries) {
+    mNodes.clear();
+    mGeometries.clear();
+    mSpheres.Clear();
+    mIsSphere.clear();
+    mHasOtherGeometries = false;
+
+    auto const geometryCount = static_cast<uint32_t>(geometries.size());
+    if (geometryCount == 0) {
+        return;
+    }
+
+    std::vector<AABB> bounds (geometryCount);
+    for (uint32_t i = 0; i < geometryCount; ++i) {
+        bounds[i] = geometries[i]->GetAABB();
+    }
+
+    std::vector<uint32_t> indices {};
+    BuildNodes(bounds, SphereSoA::Width, MaxLeafSize, mNodes, indices);
+
+    mGeometries.reserve(geometryCount);
+    for (auto const index : indices) {
+        mGeometries.emplace_back(std::move(geometries[index]));
+    }
+
+    mSpheres.Reserve(geometryCount);
+    mIsSphere.reserve(geometryCount);
+    for (uint32_t i = 0; i < geometryCount; ++i) {
+        auto const * sphere = dynamic_cast<Sphere const *>(mGeometries[i].get());
+        if (sphere != nullptr) {
+            mSpheres.Add(sphere->center, sphere->radius, i);
+        } else {
+            mSpheres.AddEmpty(i);
+            mHasOtherGeometries = true;
+        }
+        mIsSphere.emplace_back(sphere != nullptr);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void BVH::BuildNodes(
+    std::vector<AABB> const & bounds,
+    uint32_t const leafBatchWidth,
+    uint32_t const maxLeafSize,
+    std::vector<Node> & outNodes,
+    std::vector<uint32_t> & outIndices
+) {
+    MFA_ASSERT(leafBatchWidth > 0);
+    outNodes.clear();
+    outIndices.clear();
+
+    auto const count = static_cast<uint32_t>(bounds.size());
+    if (count == 0) {
+        return;
+    }
+
+    BuildContext context {
+        .bounds = bounds,
+        .leafBatchWidth = leafBatchWidth,
+        .maxLeafSize = maxLeafSize,
+        .nodes = outNodes,
+        .indices = outIndices
+    };
+    context.centers.resize(count);
+    outIndices.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        context.centers[i] = bounds[i].GetCenter();
+        outIndices[i] = i;
+    }
+
+    outNodes.reserve(count * 2 - 1);
+    BuildNode(context, 0, count, 0);
+    outNodes.shrink_to_fit();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool BVH::HasIntersect(
+    Ray const & ray,
+    float const tMin,
+    float const tMax,
+    HitRecord & outHitRecord
+) const {
+    if (mNodes.empty()) {
+        return false;
+    }
+
+    auto const rayOrigin = ray.GetOrigin();
+    auto const rayDirection = ray.GetDirection();
+    auto const rayInvDirection = 1.0f / rayDirection;
+    bool const isNegative[3] {rayDirection.x < 0.0f, rayDirection.y < 0.0f, rayDirection.z < 0.0f};
+
+    bool hasHit = false;
+    float closestT = tMax;
+    // Sphere hit record is filled once after the traversal
+    uint32_t closestSphere = SphereSoA::InvalidIndex;
+
+    std::array<uint32_t, MaxDepth> stack {};
+    int stackSize = 0;
+    uint32_t nodeIndex = 0;
+
+    while (true) {
+        auto const & node = mNodes[nodeIndex];
+        if (node.bounds.HasIntersect(rayOrigin, rayInvDirection, tMin, closestT)) {
+            if (node.geometryCount > 0) {
+                if (mSpheres.HasIntersect(
+                    node.rightOrFirst,
+                    node.geometryCount,
+                    rayOrigin,
+                    rayDirection,
+                    tMin,
+                    closestT,
+                    closestSphere
+                )) {
+                    hasHit = true;
+                }
+                if (mHasOtherGeometries) {
+                    for (uint32_t i = node.rightOrFirst; i < node.rightOrFirst + node.geometryCount; ++i) {
+                        if (mIsSphere[i] == false && mGeometries[i]->HasIntersect(ray, tMin, closestT, outHitRecord)) {
+                            hasHit = true;
+                            closestT = outHitRecord.t;
+                            closestSphere = SphereSoA::InvalidIndex;
+                        }
+                    }
+                }
+            } else {
+                // Visit the child that is nearer along the split axis first, The other one is likely to be culled by closestT
+                if (isNegative[node.axis]) {
+                    stack[stackSize++] = nodeIndex + 1;
+                    nodeIndex = node.rightOrFirst;
+                } else {
+                    stack[stackSize++] = node.rightOrFirst;
+                    nodeIndex = nodeIndex + 1;
+                }
+                continue;
+            }
+        }
+        if (stackSize == 0) {
+            break;
+        }
+        nodeIndex = stack[--stackSize];
+    }
+
+    if (closestSphere != SphereSoA::InvalidIndex) {
+        auto const * sphere = static_cast<Sphere const *>(mGeometries[mSpheres.GetId(closestSphere)].get());
+        sphere->FillHitRecord(ray, closestT, outHitRecord);
+    }
+
+    return hasHit;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+std::vector<BVH::Node> const & BVH::GetNodes() const {
+    return mNodes;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+std::vector<std::shared_ptr<Geometry>> const & BVH::GetGeometries() const {
+    return mGeometries;
+}
+
+//-------------------------------------------------------------------------------------------------
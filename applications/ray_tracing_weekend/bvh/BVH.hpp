@@ -0,0 +1,79 @@
+#pragma once
+
+#include "geometry/AABB.hpp"
+#include "geometry/sphere/SphereSoA.hpp"
+#include "ray/Ray.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Geometry;
+
+struct HitRecord;
+
+// Bounding volume hierarchy built with binned surface area heuristic.
+// Nodes are stored depth first in a single array, Left child of an interior node is always the next node.
+// Spheres are also copied into a SphereSoA in leaf order, So leaves are tested with the SIMD kernel instead of virtual calls.
+class BVH {
+public:
+
+    struct Node {
+        AABB bounds {};
+        // Interior node: Index of the right child, Leaf: Index of the first geometry
+        uint32_t rightOrFirst = 0;
+        // Zero for interior nodes
+        uint16_t geometryCount = 0;
+        // Split axis of interior nodes, Used to visit the nearest child first
+        uint16_t axis = 0;
+    };
+
+    static constexpr int BinCount = 16;
+    // A full SIMD batch costs about the same as a single sphere
+    static constexpr int MaxLeafSize = SphereSoA::Width > 4 ? SphereSoA::Width : 4;
+    static constexpr int MaxDepth = 64;
+    // Relative cost of a node visit compared to a geometry intersection
+    static constexpr float TraversalCost = 1.0f;
+    static constexpr float IntersectionCost = 1.0f;
+
+    explicit BVH();
+
+    // Builds the node hierarchy over a list of bounds, Shared with the triangle mesh BLAS.
+    // outIndices lists input items in leaf order. Leaf cost grows per batch of leafBatchWidth items
+    // because leaves are tested with SIMD kernels of that width.
+    static void BuildNodes(
+        std::vector<AABB> const & bounds,
+        uint32_t leafBatchWidth,
+        uint32_t maxLeafSize,
+        std::vector<Node> & outNodes,
+        std::vector<uint32_t> & outIndices
+    );
+
+    // Geometries are reordered so that each leaf references a contiguous range
+    void Build(std::vector<std::shared_ptr<Geometry>> geometries);
+
+    [[nodiscard]]
+    bool HasIntersect(
+        Ray const & ray,
+        float tMin,
+        float tMax,
+        HitRecord & outHitRecord
+    ) const;
+
+    [[nodiscard]]
+    std::vector<Node> const & GetNodes() const;
+
+    [[nodiscard]]
+    std::vector<std::shared_ptr<Geometry>> const & GetGeometries() const;
+
+private:
+
+    std::vector<Node> mNodes {};
+    std::vector<std::shared_ptr<Geometry>> mGeometries {};
+
+    // Same order as mGeometries, Geometries that are not spheres are empty entries
+    SphereSoA mSpheres {};
+    std::vector<bool> mIsSphere {};
+    bool mHasOtherGeometries = false;
+
+};
@@ -10,14 +10,12 @@ using namespace MFA;
 
 //-------------------------------------------------------------------------------------------------
 
-static glm::vec3 RandomUnitDisk(){
+static glm::vec3 RandomUnitDisk(PCG32 & random){
     while(true)
     {
-        glm::vec3 const randomDisk {
-            Math::Random(-1.0f, 1.0f), 
-            Math::Random(-1.0f, 1.0f), 
-            0.0f
-        };
+        auto const x = random.NextFloat(-1.0f, 1.0f);
+        auto const y = random.NextFloat(-1.0f, 1.0f);
+        glm::vec3 const randomDisk {x, y, 0.0f};
         if (glm::length2(randomDisk) > 1.0f) {
             continue;
         }
@@ -54,8 +52,8 @@ Camera::Camera(
 
 //-------------------------------------------------------------------------------------------------
 
-Ray Camera::CreateRay(float u, float v) const {
-    auto const offset = RandomUnitDisk() * mLensRadius;
+Ray Camera::CreateRay(float u, float v, PCG32 & random) const {
+    auto const offset = RandomUnitDisk(random) * mLensRadius;
     return Ray(
         mOrigin + offset, 
         mLowerLeftCorner + u * mHorizontal + v * mVertical - mOrigin - offset
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "random/PCG32.hpp"
 #include "ray/Ray.hpp"
 
 #include "glm/vec3.hpp"
@@ -18,7 +19,7 @@ public:
     );
 
     [[nodiscard]]
-    Ray CreateRay(float u, float v) const;
+    Ray CreateRay(float u, float v, PCG32 & random) const;
 
 private:
 
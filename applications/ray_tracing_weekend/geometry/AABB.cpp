@@ -0,0 +1,77 @@
+#include "AABB.hpp"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+
+//-------------------------------------------------------------------------------------------------
+
+AABB AABB::Merge(AABB const & a, AABB const & b) {
+    AABB result = a;
+    result.Grow(b);
+    return result;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void AABB::Grow(glm::vec3 const & point) {
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void AABB::Grow(AABB const & other) {
+    min = glm::min(min, other.min);
+    max = glm::max(max, other.max);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+glm::vec3 AABB::GetCenter() const {
+    return (min + max) * 0.5f;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+glm::vec3 AABB::GetExtent() const {
+    return max - min;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+float AABB::GetSurfaceArea() const {
+    if (IsValid() == false) {
+        return 0.0f;
+    }
+    auto const extent = GetExtent();
+    return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool AABB::IsValid() const {
+    return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool AABB::HasIntersect(
+    glm::vec3 const & rayOrigin,
+    glm::vec3 const & rayInvDirection,
+    float tMin,
+    float tMax
+) const {
+    auto const t0 = (min - rayOrigin) * rayInvDirection;
+    auto const t1 = (max - rayOrigin) * rayInvDirection;
+
+    auto const tNear = glm::min(t0, t1);
+    auto const tFar = glm::max(t0, t1);
+
+    tMin = std::max(tMin, std::max(tNear.x, std::max(tNear.y, tNear.z)));
+    tMax = std::min(tMax, std::min(tFar.x, std::min(tFar.y, tFar.z)));
+
+    return tMin <= tMax;
+}
+
+//-------------------------------------------------------------------------------------------------
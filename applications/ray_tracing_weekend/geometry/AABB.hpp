@@ -0,0 +1,41 @@
+#pragma once
+
+#include "glm/vec3.hpp"
+
+#include <limits>
+
+// Axis aligned bounding box. Default constructed box is empty, Growing it with any point makes it valid.
+struct AABB {
+
+    [[nodiscard]]
+    static AABB Merge(AABB const & a, AABB const & b);
+
+    void Grow(glm::vec3 const & point);
+
+    void Grow(AABB const & other);
+
+    [[nodiscard]]
+    glm::vec3 GetCenter() const;
+
+    [[nodiscard]]
+    glm::vec3 GetExtent() const;
+
+    [[nodiscard]]
+    float GetSurfaceArea() const;
+
+    [[nodiscard]]
+    bool IsValid() const;
+
+    // Slab test. Inverse direction is passed in because it is shared between all the nodes of a traversal.
+    [[nodiscard]]
+    bool HasIntersect(
+        glm::vec3 const & rayOrigin,
+        glm::vec3 const & rayInvDirection,
+        float tMin,
+        float tMax
+    ) const;
+
+    glm::vec3 min {std::numeric_limits<float>::max()};
+    glm::vec3 max {std::numeric_limits<float>::lowest()};
+
+};
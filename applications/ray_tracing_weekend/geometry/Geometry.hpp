@@ -1,5 +1,6 @@
 #pragma once
 
+#include "geometry/AABB.hpp"
 #include "ray/Ray.hpp"
 #include "material/Material.hpp"
 
@@ -24,5 +25,9 @@ public:
         HitRecord & outHitRecord
     ) = 0;
 
+    // Used by the BVH, Must enclose every point that HasIntersect can report
+    [[nodiscard]]
+    virtual AABB GetAABB() const = 0;
+
     std::shared_ptr<Material> const material = nullptr;
 };
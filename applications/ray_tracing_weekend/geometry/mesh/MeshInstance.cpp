@@ -0,0 +1,168 @@
+#include "MeshInstance.hpp"
+
+#include "engine/BedrockAssert.hpp"
+#include "engine/asset_system/AssetModel.hpp"
+#include "geometry/HitRecord.hpp"
+#include "tools/Importer.hpp"
+
+#include "glm/glm.hpp"
+#include "glm/gtx/quaternion.hpp"
+
+#include <array>
+
+using namespace MFA;
+
+//-------------------------------------------------------------------------------------------------
+
+MeshInstance::MeshInstance(
+    std::shared_ptr<TriangleMesh> mesh_,
+    glm::mat4 const & transform_,
+    std::shared_ptr<Material> material_
+)
+    : Geometry(std::move(material_))
+    , mesh(std::move(mesh_))
+    , transform(transform_)
+    , inverseTransform(glm::inverse(transform_))
+    , normalTransform(glm::transpose(glm::mat3 {glm::inverse(transform_)}))
+{
+    MFA_ASSERT(mesh != nullptr);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool MeshInstance::HasIntersect(
+    Ray const & ray,
+    float const tMin,
+    float const tMax,
+    HitRecord & outHitRecord
+) {
+    // Direction is not normalized in object space, So t stays the same in both spaces
+    TriangleMesh::WatertightRay const localRay {
+        glm::vec3 {inverseTransform * glm::vec4 {ray.GetOrigin(), 1.0f}},
+        glm::vec3 {inverseTransform * glm::vec4 {ray.GetDirection(), 0.0f}}
+    };
+
+    TriangleMesh::Hit hit {};
+    if (mesh->HasIntersect(localRay, tMin, tMax, hit) == false) {
+        return false;
+    }
+
+    glm::vec3 geometricNormal {};
+    glm::vec3 shadingNormal {};
+    std::shared_ptr<Material> meshMaterial {};
+    mesh->GetSurface(hit, geometricNormal, shadingNormal, meshMaterial);
+
+    geometricNormal = normalTransform * geometricNormal;
+    shadingNormal = glm::normalize(normalTransform * shadingNormal);
+
+    outHitRecord.t = hit.t;
+    outHitRecord.position = ray.At(hit.t);
+    outHitRecord.material = material != nullptr ? material : meshMaterial;
+    // Side is decided by the winding, Interpolated normals can point away from the ray on silhouettes
+    outHitRecord.hitFrontFace = glm::dot(ray.GetDirection(), geometricNormal) <= 0.0f;
+    outHitRecord.normal = outHitRecord.hitFrontFace ? shadingNormal : -shadingNormal;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+AABB MeshInstance::GetAABB() const {
+    auto const localBounds = mesh->GetAABB();
+    if (localBounds.IsValid() == false) {
+        return localBounds;
+    }
+
+    AABB bounds {};
+    for (int i = 0; i < 8; ++i) {
+        glm::vec4 const corner {
+            (i & 1) != 0 ? localBounds.max.x : localBounds.min.x,
+            (i & 2) != 0 ? localBounds.max.y : localBounds.min.y,
+            (i & 4) != 0 ? localBounds.max.z : localBounds.min.z,
+            1.0f
+        };
+        bounds.Grow(glm::vec3 {transform * corner});
+    }
+    return bounds;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+std::vector<std::shared_ptr<Geometry>> MeshInstance::CreateInstances(
+    std::shared_ptr<AS::PBR::Mesh> const & mesh,
+    glm::mat4 const & transform,
+    std::shared_ptr<Material> const & material
+) {
+    MFA_ASSERT(mesh != nullptr);
+    auto const & meshData = mesh->getMeshData();
+    auto const & nodes = meshData->nodes;
+
+    // Same as Mesh::ComputeNodeGlobalTransform, Mesh keeps that one private for its own cache
+    std::vector<glm::mat4> globalTransforms (nodes.size());
+    std::vector<bool> isComputed (nodes.size(), false);
+    auto const computeGlobalTransform = [&](auto const & self, int const nodeIndex)->glm::mat4 {
+        if (isComputed[nodeIndex] == false) {
+            auto const & node = nodes[nodeIndex];
+            glm::mat4 matrix {1.0f};
+            matrix = glm::translate(matrix, Copy<glm::vec3>(node.translate));
+            matrix = matrix * glm::toMat4(Copy<glm::quat>(node.rotation));
+            matrix = glm::scale(matrix, Copy<glm::vec3>(node.scale));
+            matrix = matrix * Copy<glm::mat4>(node.transform);
+            if (node.HasParent()) {
+                matrix = self(self, node.parent) * matrix;
+            }
+            globalTransforms[nodeIndex] = matrix;
+            isComputed[nodeIndex] = true;
+        }
+        return globalTransforms[nodeIndex];
+    };
+
+    std::vector<std::shared_ptr<TriangleMesh>> triangleMeshes (meshData->subMeshes.size());
+    std::vector<std::shared_ptr<Geometry>> instances {};
+    for (int nodeIndex = 0; nodeIndex < static_cast<int>(nodes.size()); ++nodeIndex) {
+        auto const & node = nodes[nodeIndex];
+        if (node.hasSubMesh() == false) {
+            continue;
+        }
+
+        auto & triangleMesh = triangleMeshes[node.subMeshIndex];
+        if (triangleMesh == nullptr) {
+            triangleMesh = std::make_shared<TriangleMesh>(mesh, static_cast<uint32_t>(node.subMeshIndex));
+        }
+        if (triangleMesh->GetTriangleCount() == 0) {
+            continue;
+        }
+
+        instances.emplace_back(std::make_shared<MeshInstance>(
+            triangleMesh,
+            transform * computeGlobalTransform(computeGlobalTransform, nodeIndex),
+            material
+        ));
+    }
+
+    return instances;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+std::vector<std::shared_ptr<Geometry>> MeshInstance::ImportGLTF(
+    std::string const & path,
+    glm::mat4 const & transform,
+    std::shared_ptr<Material> const & material
+) {
+    auto const model = Importer::ImportGLTF(path);
+    if (model == nullptr) {
+        MFA_LOG_WARN("Failed to import gltf model");
+        return {};
+    }
+
+    auto const mesh = std::dynamic_pointer_cast<AS::PBR::Mesh>(model->mesh);
+    if (mesh == nullptr || mesh->isValid() == false) {
+        MFA_LOG_WARN("Gltf model does not contain a valid pbr mesh");
+        return {};
+    }
+
+    return CreateInstances(mesh, transform, material);
+}
+
+//-------------------------------------------------------------------------------------------------
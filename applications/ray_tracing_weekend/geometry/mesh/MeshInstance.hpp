@@ -0,0 +1,59 @@
+#pragma once
+
+#include "geometry/Geometry.hpp"
+#include "geometry/mesh/TriangleMesh.hpp"
+
+#include "glm/mat3x3.hpp"
+#include "glm/mat4x4.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Top level entry of a triangle mesh. Scene BVH holds the instances, Rays are moved into object space and
+// tested against the shared TriangleMesh, So the same sub mesh can be placed many times without copying triangles.
+class MeshInstance : public Geometry {
+public:
+
+    // When material_ is nullptr, Each primitive uses the material that is made from its base color factor
+    explicit MeshInstance(
+        std::shared_ptr<TriangleMesh> mesh_,
+        glm::mat4 const & transform_,
+        std::shared_ptr<Material> material_ = nullptr
+    );
+
+    [[nodiscard]]
+    bool HasIntersect(
+        Ray const & ray,
+        float tMin,
+        float tMax,
+        HitRecord & outHitRecord
+    ) override;
+
+    [[nodiscard]]
+    AABB GetAABB() const override;
+
+    // One instance for each node of the mesh that has a sub mesh, Sub meshes are shared between their nodes
+    [[nodiscard]]
+    static std::vector<std::shared_ptr<Geometry>> CreateInstances(
+        std::shared_ptr<MFA::AS::PBR::Mesh> const & mesh,
+        glm::mat4 const & transform,
+        std::shared_ptr<Material> const & material = nullptr
+    );
+
+    // Imports the model with the engine importer, Returns an empty list if the file is not a valid gltf model
+    [[nodiscard]]
+    static std::vector<std::shared_ptr<Geometry>> ImportGLTF(
+        std::string const & path,
+        glm::mat4 const & transform,
+        std::shared_ptr<Material> const & material = nullptr
+    );
+
+    std::shared_ptr<TriangleMesh> const mesh;
+
+    glm::mat4 const transform;
+    glm::mat4 const inverseTransform;
+    // Inverse transpose, Moves normals back to world space
+    glm::mat3 const normalTransform;
+
+};
@@ -0,0 +1,273 @@
+#include "TriangleMesh.hpp"
+
+#include "engine/BedrockAssert.hpp"
+#include "engine/BedrockMemory.hpp"
+#include "material/diffuse/Diffuse.hpp"
+
+#include "glm/glm.hpp"
+
+#include <array>
+#include <cmath>
+#include <utility>
+
+using namespace MFA;
+
+//-------------------------------------------------------------------------------------------------
+
+TriangleMesh::WatertightRay::WatertightRay(glm::vec3 const & origin_, glm::vec3 const & direction_)
+    : origin(origin_)
+    , direction(direction_)
+    , invDirection(1.0f / direction_)
+{
+    // Dominant axis of the direction becomes Z, Winding is kept by swapping the other two when Z is negative
+    auto const absDirection = glm::abs(direction);
+    kz = absDirection.x > absDirection.y
+        ? (absDirection.x > absDirection.z ? 0 : 2)
+        : (absDirection.y > absDirection.z ? 1 : 2);
+    kx = (kz + 1) % 3;
+    ky = (kx + 1) % 3;
+    if (direction[kz] < 0.0f) {
+        std::swap(kx, ky);
+    }
+
+    sx = direction[kx] / direction[kz];
+    sy = direction[ky] / direction[kz];
+    sz = 1.0f / direction[kz];
+}
+
+//-------------------------------------------------------------------------------------------------
+
+TriangleMesh::TriangleMesh(std::shared_ptr<AS::PBR::Mesh> mesh, uint32_t const subMeshIndex)
+    : mMesh(std::move(mesh))
+{
+    MFA_ASSERT(mMesh != nullptr);
+    auto const & meshData = mMesh->getMeshData();
+    MFA_ASSERT(subMeshIndex < meshData->subMeshes.size());
+
+    mVertices = mMesh->getVertexData()->memory.as<AS::PBR::Vertex>();
+    mIndices = mMesh->getIndexData()->memory.as<AS::Index>();
+
+    std::vector<Triangle> triangles {};
+    std::vector<AABB> bounds {};
+
+    auto const & primitives = meshData->subMeshes[subMeshIndex].primitives;
+    for (uint32_t primitiveIndex = 0; primitiveIndex < static_cast<uint32_t>(primitives.size()); ++primitiveIndex) {
+        auto const & primitive = primitives[primitiveIndex];
+        MFA_ASSERT(primitive.indicesCount % 3 == 0);
+        MFA_ASSERT(primitive.indicesOffset % sizeof(AS::Index) == 0);
+
+        auto const firstIndex = static_cast<uint32_t>(primitive.indicesOffset / sizeof(AS::Index));
+        for (uint32_t i = 0; i < primitive.indicesCount; i += 3) {
+            Triangle const triangle {
+                .firstIndex = firstIndex + i,
+                .primitiveIndex = primitiveIndex
+            };
+            AABB triangleBounds {};
+            for (uint32_t j = 0; j < 3; ++j) {
+                triangleBounds.Grow(GetPosition(mIndices[triangle.firstIndex + j]));
+            }
+            triangles.emplace_back(triangle);
+            bounds.emplace_back(triangleBounds);
+        }
+
+        // Primitives without a material have a zero base color factor
+        auto const * factor = primitive.baseColorFactor;
+        auto const color = factor[0] == 0.0f && factor[1] == 0.0f && factor[2] == 0.0f && factor[3] == 0.0f
+            ? glm::vec3 {0.5f, 0.5f, 0.5f}
+            : glm::vec3 {factor[0], factor[1], factor[2]};
+        mMaterials.emplace_back(std::make_shared<Diffuse>(color));
+        mHasNormals.emplace_back(primitive.hasNormalBuffer);
+    }
+
+    std::vector<uint32_t> order {};
+    BVH::BuildNodes(bounds, 1, MaxLeafSize, mNodes, order);
+
+    mTriangles.reserve(triangles.size());
+    for (auto const index : order) {
+        mTriangles.emplace_back(triangles[index]);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool TriangleMesh::IntersectTriangle(
+    WatertightRay const & ray,
+    glm::vec3 const & p0,
+    glm::vec3 const & p1,
+    glm::vec3 const & p2,
+    float const tMin,
+    float const tMax,
+    Hit & outHit
+) {
+    auto const a = p0 - ray.origin;
+    auto const b = p1 - ray.origin;
+    auto const c = p2 - ray.origin;
+
+    // Shear and scale the vertices so the ray goes along +Z
+    auto const ax = a[ray.kx] - ray.sx * a[ray.kz];
+    auto const ay = a[ray.ky] - ray.sy * a[ray.kz];
+    auto const bx = b[ray.kx] - ray.sx * b[ray.kz];
+    auto const by = b[ray.ky] - ray.sy * b[ray.kz];
+    auto const cx = c[ray.kx] - ray.sx * c[ray.kz];
+    auto const cy = c[ray.ky] - ray.sy * c[ray.kz];
+
+    // Scaled barycentric coordinates, Each one is the signed area seen from one edge.
+    // Products of two floats are exact in double, So the result does not depend on whether the compiler fuses them
+    // into FMA and both triangles of a shared edge always agree on its sign.
+    auto const edgeFunction = [](float const x0, float const y0, float const x1, float const y1)->float {
+        return static_cast<float>(static_cast<double>(x0) * static_cast<double>(y1) - static_cast<double>(y0) * static_cast<double>(x1));
+    };
+    auto const u = edgeFunction(cx, cy, bx, by);
+    auto const v = edgeFunction(ax, ay, cx, cy);
+    auto const w = edgeFunction(bx, by, ax, ay);
+
+    // Both faces are hit, So only mixed signs are a miss
+    if ((u < 0.0f || v < 0.0f || w < 0.0f) && (u > 0.0f || v > 0.0f || w > 0.0f)) {
+        return false;
+    }
+
+    auto const determinant = u + v + w;
+    if (determinant == 0.0f) {
+        return false;
+    }
+
+    auto const az = ray.sz * a[ray.kz];
+    auto const bz = ray.sz * b[ray.kz];
+    auto const cz = ray.sz * c[ray.kz];
+
+    auto const invDeterminant = 1.0f / determinant;
+    auto const t = (u * az + v * bz + w * cz) * invDeterminant;
+    if (t < tMin || t > tMax) {
+        return false;
+    }
+
+    outHit.t = t;
+    outHit.u = v * invDeterminant;
+    outHit.v = w * invDeterminant;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool TriangleMesh::HasIntersect(
+    WatertightRay const & ray,
+    float const tMin,
+    float const tMax,
+    Hit & outHit
+) const {
+    if (mNodes.empty()) {
+        return false;
+    }
+
+    bool const isNegative[3] {ray.direction.x < 0.0f, ray.direction.y < 0.0f, ray.direction.z < 0.0f};
+
+    bool hasHit = false;
+    float closestT = tMax;
+
+    std::array<uint32_t, BVH::MaxDepth> stack {};
+    int stackSize = 0;
+    uint32_t nodeIndex = 0;
+
+    while (true) {
+        auto const & node = mNodes[nodeIndex];
+        if (node.bounds.HasIntersect(ray.origin, ray.invDirection, tMin, closestT)) {
+            if (node.geometryCount > 0) {
+                for (uint32_t i = node.rightOrFirst; i < node.rightOrFirst + node.geometryCount; ++i) {
+                    auto const firstIndex = mTriangles[i].firstIndex;
+                    if (IntersectTriangle(
+                        ray,
+                        GetPosition(mIndices[firstIndex]),
+                        GetPosition(mIndices[firstIndex + 1]),
+                        GetPosition(mIndices[firstIndex + 2]),
+                        tMin,
+                        closestT,
+                        outHit
+                    )) {
+                        hasHit = true;
+                        closestT = outHit.t;
+                        outHit.triangle = i;
+                    }
+                }
+            } else {
+                // Nearest child first, Same as the scene BVH
+                if (isNegative[node.axis]) {
+                    stack[stackSize++] = nodeIndex + 1;
+                    nodeIndex = node.rightOrFirst;
+                } else {
+                    stack[stackSize++] = node.rightOrFirst;
+                    nodeIndex = nodeIndex + 1;
+                }
+                continue;
+            }
+        }
+        if (stackSize == 0) {
+            break;
+        }
+        nodeIndex = stack[--stackSize];
+    }
+
+    return hasHit;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void TriangleMesh::GetSurface(
+    Hit const & hit,
+    glm::vec3 & outGeometricNormal,
+    glm::vec3 & outShadingNormal,
+    std::shared_ptr<Material> & outMaterial
+) const {
+    MFA_ASSERT(hit.triangle < mTriangles.size());
+    auto const & triangle = mTriangles[hit.triangle];
+
+    auto const i0 = mIndices[triangle.firstIndex];
+    auto const i1 = mIndices[triangle.firstIndex + 1];
+    auto const i2 = mIndices[triangle.firstIndex + 2];
+
+    auto const p0 = GetPosition(i0);
+    outGeometricNormal = glm::cross(GetPosition(i1) - p0, GetPosition(i2) - p0);
+    outShadingNormal = outGeometricNormal;
+
+    if (mHasNormals[triangle.primitiveIndex]) {
+        auto const normal = (1.0f - hit.u - hit.v) * Copy<glm::vec3>(mVertices[i0].normalValue)
+            + hit.u * Copy<glm::vec3>(mVertices[i1].normalValue)
+            + hit.v * Copy<glm::vec3>(mVertices[i2].normalValue);
+        // Opposite vertex normals can cancel each other out
+        if (glm::dot(normal, normal) > 0.0f) {
+            outShadingNormal = normal;
+        }
+    }
+
+    outMaterial = mMaterials[triangle.primitiveIndex];
+}
+
+//-------------------------------------------------------------------------------------------------
+
+AABB TriangleMesh::GetAABB() const {
+    if (mNodes.empty()) {
+        return AABB {};
+    }
+    return mNodes[0].bounds;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+uint32_t TriangleMesh::GetTriangleCount() const {
+    return static_cast<uint32_t>(mTriangles.size());
+}
+
+//-------------------------------------------------------------------------------------------------
+
+std::vector<BVH::Node> const & TriangleMesh::GetNodes() const {
+    return mNodes;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+glm::vec3 TriangleMesh::GetPosition(uint32_t const index) const {
+    // Indices are global, They already include the starting vertex of their primitive
+    auto const & position = mVertices[index].position;
+    return glm::vec3 {position[0], position[1], position[2]};
+}
+
+//-------------------------------------------------------------------------------------------------
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "bvh/BVH.hpp"
+#include "engine/asset_system/Asset_PBR_Mesh.hpp"
+#include "geometry/AABB.hpp"
+
+#include "glm/vec3.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+class Material;
+
+// Bottom level acceleration structure of a single sub mesh of a PBR mesh.
+// Positions and normals are read in place from the vertex and index blobs of the mesh,
+// Only the order of triangles inside the BVH leaves is stored here. Shared between all instances of the sub mesh.
+class TriangleMesh {
+public:
+
+    static constexpr uint32_t InvalidTriangle = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t MaxLeafSize = 4;
+
+    // Ray data that is shared by all triangle tests of a traversal.
+    // Woop, Benthin and Wald 2013, Watertight ray/triangle intersection: Vertices are moved into a space where the ray
+    // starts at the origin and goes along +Z, So shared edges are tested with exactly the same operations from both sides.
+    struct WatertightRay {
+
+        // Direction does not have to be normalized, t is measured in units of direction
+        explicit WatertightRay(glm::vec3 const & origin_, glm::vec3 const & direction_);
+
+        glm::vec3 origin {};
+        glm::vec3 direction {};
+        glm::vec3 invDirection {};
+        int kx = 0;
+        int ky = 1;
+        int kz = 2;
+        float sx = 0.0f;
+        float sy = 0.0f;
+        float sz = 1.0f;
+
+    };
+
+    struct Hit {
+        float t = 0.0f;
+        // Barycentric weights of the second and third vertex
+        float u = 0.0f;
+        float v = 0.0f;
+        uint32_t triangle = InvalidTriangle;
+    };
+
+    explicit TriangleMesh(std::shared_ptr<MFA::AS::PBR::Mesh> mesh, uint32_t subMeshIndex);
+
+    // Edges and vertices that are shared by two triangles are never missed by both of them
+    [[nodiscard]]
+    static bool IntersectTriangle(
+        WatertightRay const & ray,
+        glm::vec3 const & p0,
+        glm::vec3 const & p1,
+        glm::vec3 const & p2,
+        float tMin,
+        float tMax,
+        Hit & outHit
+    );
+
+    // Returns the closest hit in range, outHit.t is used as the initial tMax only if a triangle is hit
+    [[nodiscard]]
+    bool HasIntersect(
+        WatertightRay const & ray,
+        float tMin,
+        float tMax,
+        Hit & outHit
+    ) const;
+
+    // Normals are in object space and not normalized. Shading normal is interpolated when the primitive has a normal buffer.
+    void GetSurface(
+        Hit const & hit,
+        glm::vec3 & outGeometricNormal,
+        glm::vec3 & outShadingNormal,
+        std::shared_ptr<Material> & outMaterial
+    ) const;
+
+    [[nodiscard]]
+    AABB GetAABB() const;
+
+    [[nodiscard]]
+    uint32_t GetTriangleCount() const;
+
+    [[nodiscard]]
+    std::vector<BVH::Node> const & GetNodes() const;
+
+private:
+
+    struct Triangle {
+        // Index of the first vertex index inside the index blob
+        uint32_t firstIndex = 0;
+        uint32_t primitiveIndex = 0;
+    };
+
+    [[nodiscard]]
+    glm::vec3 GetPosition(uint32_t index) const;
+
+    std::shared_ptr<MFA::AS::PBR::Mesh> mMesh {};
+    MFA::AS::PBR::Vertex const * mVertices = nullptr;
+    MFA::AS::Index const * mIndices = nullptr;
+
+    std::vector<Triangle> mTriangles {};
+    std::vector<BVH::Node> mNodes {};
+
+    // Per primitive, Diffuse material made from the base color factor
+    std::vector<std::shared_ptr<Material>> mMaterials {};
+    std::vector<bool> mHasNormals {};
+
+};
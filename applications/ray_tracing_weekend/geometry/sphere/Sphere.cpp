@@ -52,18 +52,34 @@ bool Sphere::HasIntersect(
         }
     }
     
-    hitRecord.t = t;
+    FillHitRecord(ray, t, hitRecord);
+    
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void Sphere::FillHitRecord(Ray const & ray, float const t, HitRecord & outHitRecord) const {
+    outHitRecord.t = t;
 
-    hitRecord.position = ray.At(t);
-    hitRecord.normal = (hitRecord.position - center) / radius;
-    hitRecord.material = material;
-    hitRecord.hitFrontFace = glm::dot(ray.GetDirection(), hitRecord.normal) <= 0.0f;
+    outHitRecord.position = ray.At(t);
+    outHitRecord.normal = (outHitRecord.position - center) / radius;
+    outHitRecord.material = material;
+    outHitRecord.hitFrontFace = glm::dot(ray.GetDirection(), outHitRecord.normal) <= 0.0f;
     
-    if (hitRecord.hitFrontFace == false) {
-        hitRecord.normal = -hitRecord.normal;
+    if (outHitRecord.hitFrontFace == false) {
+        outHitRecord.normal = -outHitRecord.normal;
     }
-    
-    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+AABB Sphere::GetAABB() const {
+    auto const extent = glm::vec3 {radius, radius, radius};
+    return AABB {
+        .min = center - extent,
+        .max = center + extent
+    };
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -22,6 +22,12 @@ public:
         HitRecord & hitRecord
     ) override;
 
+    [[nodiscard]]
+    AABB GetAABB() const override;
+
+    // Used when intersection distance is already known, For example from SphereSoA
+    void FillHitRecord(Ray const & ray, float t, HitRecord & outHitRecord) const;
+
     glm::vec3 const center;
     
     float const radius;
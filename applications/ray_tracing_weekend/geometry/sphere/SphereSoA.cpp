@@ -0,0 +1,284 @@
+#include "SphereSoA.hpp"
+
+#include "engine/BedrockAssert.hpp"
+
+#include <cmath>
+#include <limits>
+
+// Makes the discriminant negative infinity, So the entry is never hit
+static constexpr float EmptySqrRadius = -std::numeric_limits<float>::infinity();
+
+//-------------------------------------------------------------------------------------------------
+
+SphereSoA::SphereSoA() {
+    Clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void SphereSoA::Clear() {
+    mCount = 0;
+
+    mCenterX.assign(Width, 0.0f);
+    mCenterY.assign(Width, 0.0f);
+    mCenterZ.assign(Width, 0.0f);
+    mSqrRadius.assign(Width, EmptySqrRadius);
+    mIds.assign(Width, InvalidIndex);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void SphereSoA::Reserve(size_t const count) {
+    mCenterX.reserve(count + Width);
+    mCenterY.reserve(count + Width);
+    mCenterZ.reserve(count + Width);
+    mSqrRadius.reserve(count + Width);
+    mIds.reserve(count + Width);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void SphereSoA::Add(glm::vec3 const & center, float const radius, uint32_t const id) {
+    Push(center.x, center.y, center.z, radius * radius, id);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void SphereSoA::AddEmpty(uint32_t const id) {
+    Push(0.0f, 0.0f, 0.0f, EmptySqrRadius, id);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void SphereSoA::Push(float const x, float const y, float const z, float const sqrRadius, uint32_t const id) {
+    // Last Width entries are always padding, New entry takes the place of the first padding entry
+    auto const index = mCount;
+    mCenterX.insert(mCenterX.begin() + index, x);
+    mCenterY.insert(mCenterY.begin() + index, y);
+    mCenterZ.insert(mCenterZ.begin() + index, z);
+    mSqrRadius.insert(mSqrRadius.begin() + index, sqrRadius);
+    mIds.insert(mIds.begin() + index, id);
+    ++mCount;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+size_t SphereSoA::GetCount() const {
+    return mCount;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+uint32_t SphereSoA::GetId(uint32_t const index) const {
+    MFA_ASSERT(index < mCount);
+    return mIds[index];
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool SphereSoA::HasIntersectScalar(
+    uint32_t const first,
+    uint32_t const count,
+    glm::vec3 const & rayOrigin,
+    glm::vec3 const & rayDirection,
+    float const tMin,
+    float & inOutTMax,
+    uint32_t & outIndex
+) const {
+    MFA_ASSERT(first + count <= mCount);
+    bool hasHit = false;
+    for (uint32_t i = first; i < first + count; ++i) {
+        auto const ocX = rayOrigin.x - mCenterX[i];
+        auto const ocY = rayOrigin.y - mCenterY[i];
+        auto const ocZ = rayOrigin.z - mCenterZ[i];
+
+        auto const b = rayDirection.x * ocX + rayDirection.y * ocY + rayDirection.z * ocZ;
+        auto const c = ocX * ocX + ocY * ocY + ocZ * ocZ - mSqrRadius[i];
+        auto const discriminant = b * b - c;
+        if (discriminant < 0.0f) {
+            continue;
+        }
+
+        auto const disSqrt = std::sqrt(discriminant);
+        auto t = -b - disSqrt;
+        if (t < tMin) {
+            t = -b + disSqrt;
+        }
+        if (t < tMin || t > inOutTMax) {
+            continue;
+        }
+
+        inOutTMax = t;
+        outIndex = i;
+        hasHit = true;
+    }
+    return hasHit;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+#if defined(ENABLE_SIMD) && defined(__AVX2__)
+
+bool SphereSoA::HasIntersect(
+    uint32_t const first,
+    uint32_t const count,
+    glm::vec3 const & rayOrigin,
+    glm::vec3 const & rayDirection,
+    float const tMin,
+    float & inOutTMax,
+    uint32_t & outIndex
+) const {
+    MFA_ASSERT(first + count <= mCount);
+
+    auto const originX = _mm256_set1_ps(rayOrigin.x);
+    auto const originY = _mm256_set1_ps(rayOrigin.y);
+    auto const originZ = _mm256_set1_ps(rayOrigin.z);
+    auto const directionX = _mm256_set1_ps(rayDirection.x);
+    auto const directionY = _mm256_set1_ps(rayDirection.y);
+    auto const directionZ = _mm256_set1_ps(rayDirection.z);
+    auto const tMinVar = _mm256_set1_ps(tMin);
+    auto const zero = _mm256_setzero_ps();
+    auto const laneIndices = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+    bool hasHit = false;
+    for (uint32_t batch = first; batch < first + count; batch += Width) {
+        auto const ocX = _mm256_sub_ps(originX, _mm256_loadu_ps(mCenterX.data() + batch));
+        auto const ocY = _mm256_sub_ps(originY, _mm256_loadu_ps(mCenterY.data() + batch));
+        auto const ocZ = _mm256_sub_ps(originZ, _mm256_loadu_ps(mCenterZ.data() + batch));
+
+        auto b = _mm256_mul_ps(directionX, ocX);
+        b = _mm256_add_ps(b, _mm256_mul_ps(directionY, ocY));
+        b = _mm256_add_ps(b, _mm256_mul_ps(directionZ, ocZ));
+
+        auto c = _mm256_mul_ps(ocX, ocX);
+        c = _mm256_add_ps(c, _mm256_mul_ps(ocY, ocY));
+        c = _mm256_add_ps(c, _mm256_mul_ps(ocZ, ocZ));
+        c = _mm256_sub_ps(c, _mm256_loadu_ps(mSqrRadius.data() + batch));
+
+        auto const discriminant = _mm256_sub_ps(_mm256_mul_ps(b, b), c);
+        auto const hasRoot = _mm256_cmp_ps(discriminant, zero, _CMP_GE_OQ);
+        auto const disSqrt = _mm256_sqrt_ps(_mm256_max_ps(discriminant, zero));
+
+        auto const negB = _mm256_sub_ps(zero, b);
+        auto const nearT = _mm256_sub_ps(negB, disSqrt);
+        auto const farT = _mm256_add_ps(negB, disSqrt);
+        auto const t = _mm256_blendv_ps(nearT, farT, _mm256_cmp_ps(nearT, tMinVar, _CMP_LT_OQ));
+
+        // Lanes past the end of the range are ignored
+        auto const remaining = static_cast<float>(first + count - batch);
+        auto const inRange = _mm256_cmp_ps(laneIndices, _mm256_set1_ps(remaining), _CMP_LT_OQ);
+
+        auto valid = _mm256_and_ps(hasRoot, inRange);
+        valid = _mm256_and_ps(valid, _mm256_cmp_ps(t, tMinVar, _CMP_GE_OQ));
+        valid = _mm256_and_ps(valid, _mm256_cmp_ps(t, _mm256_set1_ps(inOutTMax), _CMP_LE_OQ));
+
+        auto const mask = _mm256_movemask_ps(valid);
+        if (mask == 0) {
+            continue;
+        }
+
+        alignas(32) float tValues[Width];
+        _mm256_store_ps(tValues, t);
+        for (int lane = 0; lane < Width; ++lane) {
+            if ((mask & (1 << lane)) != 0 && tValues[lane] <= inOutTMax) {
+                inOutTMax = tValues[lane];
+                outIndex = batch + lane;
+                hasHit = true;
+            }
+        }
+    }
+    return hasHit;
+}
+
+#elif defined(ENABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+
+bool SphereSoA::HasIntersect(
+    uint32_t const first,
+    uint32_t const count,
+    glm::vec3 const & rayOrigin,
+    glm::vec3 const & rayDirection,
+    float const tMin,
+    float & inOutTMax,
+    uint32_t & outIndex
+) const {
+    MFA_ASSERT(first + count <= mCount);
+
+    auto const originX = _mm_set1_ps(rayOrigin.x);
+    auto const originY = _mm_set1_ps(rayOrigin.y);
+    auto const originZ = _mm_set1_ps(rayOrigin.z);
+    auto const directionX = _mm_set1_ps(rayDirection.x);
+    auto const directionY = _mm_set1_ps(rayDirection.y);
+    auto const directionZ = _mm_set1_ps(rayDirection.z);
+    auto const tMinVar = _mm_set1_ps(tMin);
+    auto const zero = _mm_setzero_ps();
+    auto const laneIndices = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+    bool hasHit = false;
+    for (uint32_t batch = first; batch < first + count; batch += Width) {
+        auto const ocX = _mm_sub_ps(originX, _mm_loadu_ps(mCenterX.data() + batch));
+        auto const ocY = _mm_sub_ps(originY, _mm_loadu_ps(mCenterY.data() + batch));
+        auto const ocZ = _mm_sub_ps(originZ, _mm_loadu_ps(mCenterZ.data() + batch));
+
+        auto b = _mm_mul_ps(directionX, ocX);
+        b = _mm_add_ps(b, _mm_mul_ps(directionY, ocY));
+        b = _mm_add_ps(b, _mm_mul_ps(directionZ, ocZ));
+
+        auto c = _mm_mul_ps(ocX, ocX);
+        c = _mm_add_ps(c, _mm_mul_ps(ocY, ocY));
+        c = _mm_add_ps(c, _mm_mul_ps(ocZ, ocZ));
+        c = _mm_sub_ps(c, _mm_loadu_ps(mSqrRadius.data() + batch));
+
+        auto const discriminant = _mm_sub_ps(_mm_mul_ps(b, b), c);
+        auto const hasRoot = _mm_cmpge_ps(discriminant, zero);
+        auto const disSqrt = _mm_sqrt_ps(_mm_max_ps(discriminant, zero));
+
+        auto const negB = _mm_sub_ps(zero, b);
+        auto const nearT = _mm_sub_ps(negB, disSqrt);
+        auto const farT = _mm_add_ps(negB, disSqrt);
+        // SSE2 has no blend instruction
+        auto const useFar = _mm_cmplt_ps(nearT, tMinVar);
+        auto const t = _mm_or_ps(_mm_and_ps(useFar, farT), _mm_andnot_ps(useFar, nearT));
+
+        // Lanes past the end of the range are ignored
+        auto const remaining = static_cast<float>(first + count - batch);
+        auto const inRange = _mm_cmplt_ps(laneIndices, _mm_set1_ps(remaining));
+
+        auto valid = _mm_and_ps(hasRoot, inRange);
+        valid = _mm_and_ps(valid, _mm_cmpge_ps(t, tMinVar));
+        valid = _mm_and_ps(valid, _mm_cmple_ps(t, _mm_set1_ps(inOutTMax)));
+
+        auto const mask = _mm_movemask_ps(valid);
+        if (mask == 0) {
+            continue;
+        }
+
+        alignas(16) float tValues[Width];
+        _mm_store_ps(tValues, t);
+        for (int lane = 0; lane < Width; ++lane) {
+            if ((mask & (1 << lane)) != 0 && tValues[lane] <= inOutTMax) {
+                inOutTMax = tValues[lane];
+                outIndex = batch + lane;
+                hasHit = true;
+            }
+        }
+    }
+    return hasHit;
+}
+
+#else
+
+bool SphereSoA::HasIntersect(
+    uint32_t const first,
+    uint32_t const count,
+    glm::vec3 const & rayOrigin,
+    glm::vec3 const & rayDirection,
+    float const tMin,
+    float & inOutTMax,
+    uint32_t & outIndex
+) const {
+    return HasIntersectScalar(first, count, rayOrigin, rayDirection, tMin, inOutTMax, outIndex);
+}
+
+#endif
+
+//-------------------------------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "glm/vec3.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#if defined(ENABLE_SIMD) && (defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64))
+#include <immintrin.h>
+#endif
+
+// Spheres stored as struct of arrays, So a single instruction can test a ray against several of them.
+// AVX2 kernel tests 8 spheres at once, SSE kernel tests 4 and the scalar kernel is used on other targets.
+// Arrays are padded with spheres that can never be hit, Kernels are free to read a full batch past the last entry.
+class SphereSoA {
+public:
+
+#if defined(ENABLE_SIMD) && defined(__AVX2__)
+    static constexpr int Width = 8;
+#elif defined(ENABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+    static constexpr int Width = 4;
+#else
+    static constexpr int Width = 1;
+#endif
+
+    static constexpr uint32_t InvalidIndex = static_cast<uint32_t>(-1);
+
+    explicit SphereSoA();
+
+    void Clear();
+
+    void Reserve(size_t count);
+
+    void Add(glm::vec3 const & center, float radius, uint32_t id);
+
+    // Placeholder for an entry that is not a sphere, Keeps indices of the arrays in sync with the owner
+    void AddEmpty(uint32_t id);
+
+    [[nodiscard]]
+    size_t GetCount() const;
+
+    [[nodiscard]]
+    uint32_t GetId(uint32_t index) const;
+
+    // Tests spheres in [first, first + count). Ray direction must be normalized.
+    // On hit, inOutTMax is set to the distance of the closest hit and outIndex to its index
+    [[nodiscard]]
+    bool HasIntersect(
+        uint32_t first,
+        uint32_t count,
+        glm::vec3 const & rayOrigin,
+        glm::vec3 const & rayDirection,
+        float tMin,
+        float & inOutTMax,
+        uint32_t & outIndex
+    ) const;
+
+    // Reference implementation, Same result as HasIntersect up to floating point rounding
+    [[nodiscard]]
+    bool HasIntersectScalar(
+        uint32_t first,
+        uint32_t count,
+        glm::vec3 const & rayOrigin,
+        glm::vec3 const & rayDirection,
+        float tMin,
+        float & inOutTMax,
+        uint32_t & outIndex
+    ) const;
+
+private:
+
+    void Push(float x, float y, float z, float sqrRadius, uint32_t id);
+
+    std::vector<float> mCenterX {};
+    std::vector<float> mCenterY {};
+    std::vector<float> mCenterZ {};
+    std::vector<float> mSqrRadius {};
+    std::vector<uint32_t> mIds {};
+
+    size_t mCount = 0;
+
+};
@@ -14,18 +14,17 @@ Material::Material(glm::vec3 color_) : color(color_) {}
 
 //-------------------------------------------------------------------------------------------------
 
-glm::vec3 Material::RandomVec3(float min, float max) {
-    return glm::vec3 {
-        Math::Random(min, max),
-        Math::Random(min, max),
-        Math::Random(min, max)
-    };
+glm::vec3 Material::RandomVec3(PCG32 & random, float min, float max) {
+    auto const x = random.NextFloat(min, max);
+    auto const y = random.NextFloat(min, max);
+    auto const z = random.NextFloat(min, max);
+    return glm::vec3 {x, y, z};
 }
 
 //-------------------------------------------------------------------------------------------------
 
-glm::vec3 Material::RandomUnitVector() {
-    return glm::normalize(RandomVec3(-1.0f, 1.0f));
+glm::vec3 Material::RandomUnitVector(PCG32 & random) {
+    return glm::normalize(RandomVec3(random, -1.0f, 1.0f));
 }
 
 //-------------------------------------------------------------------------------------------------
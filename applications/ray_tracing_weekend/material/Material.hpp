@@ -1,5 +1,6 @@
 #pragma once
 
+#include "random/PCG32.hpp"
 #include "ray/Ray.hpp"
 
 #include "glm/vec3.hpp"
@@ -14,13 +15,14 @@ public:
     virtual bool Scatter(
         Ray const & ray,
         HitRecord const & hitRecord,
+        PCG32 & random,
         glm::vec3 & outAttenuation,
         Ray & outScatteredRay
     ) const = 0;
 
-    static glm::vec3 RandomVec3(float min, float max);
+    static glm::vec3 RandomVec3(PCG32 & random, float min, float max);
 
-    static glm::vec3 RandomUnitVector();
+    static glm::vec3 RandomUnitVector(PCG32 & random);
 
     static glm::vec3 Reflect(
         glm::vec3 const & vector, 
@@ -6,6 +6,7 @@
 #include "glm/glm.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 using namespace MFA;
 
@@ -22,7 +23,7 @@ static float Reflectance(float cosine, float reflectionIndex) {
     // Use Schlick's approximation for reflectance.
     float r0 = (1 - reflectionIndex) / (1.0f + reflectionIndex);
     r0 = r0 * r0;
-    return r0 + (1.0f - r0) * std::powf((1.0f - cosine), 5);
+    return r0 + (1.0f - r0) * std::pow((1.0f - cosine), 5.0f);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -30,6 +31,7 @@ static float Reflectance(float cosine, float reflectionIndex) {
 bool Dielectric::Scatter(
     Ray const & ray,
     HitRecord const & hitRecord,
+    PCG32 & random,
     glm::vec3 & outAttenuation,
     Ray & outScatteredRay
 ) const {
@@ -45,7 +47,7 @@ bool Dielectric::Scatter(
         ? (1.0f / refractionIndex) 
         : (refractionIndex / 1.0f);
     
-    auto refractDir = std::abs(sinTheta) > 1 || Reflectance(cosTheta, refractionRatio) > Math::Random(0.0f, 1.0f)
+    auto refractDir = std::abs(sinTheta) > 1 || Reflectance(cosTheta, refractionRatio) > random.NextFloat()
         ? Reflect(rayDir, hitRecord.normal) // Roughness is considered zero here for simplicity
         : Refract(rayDir, hitRecord.normal, refractionRatio);
     
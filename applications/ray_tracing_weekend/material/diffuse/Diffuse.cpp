@@ -10,11 +10,12 @@ using namespace MFA;
 bool Diffuse::Scatter(
     Ray const & ray,
     HitRecord const & hitRecord,
+    PCG32 & random,
     glm::vec3 & outAttenuation,
     Ray & outScatteredRay
 ) const {
     outAttenuation = color;
-    auto direction = hitRecord.normal + RandomUnitVector();
+    auto direction = hitRecord.normal + RandomUnitVector(random);
     if (Matrix::IsNearZero(direction)) {
         direction = hitRecord.normal;
     }
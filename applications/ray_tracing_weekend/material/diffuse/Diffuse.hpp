@@ -10,6 +10,7 @@ public:
     bool Scatter(
         Ray const & ray,
         HitRecord const & hitRecord,
+        PCG32 & random,
         glm::vec3 & outAttenuation,
         Ray & outScatteredRay
     ) const override;
@@ -19,13 +19,14 @@ Metal::Metal(glm::vec3 const & color_, float roughness_)
 bool Metal::Scatter(
     Ray const & ray,
     HitRecord const & hitRecord,
+    PCG32 & random,
     glm::vec3 & outAttenuation,
     Ray & outScatteredRay
 ) const 
 {
     auto direction = Reflect(ray.GetDirection(), hitRecord.normal);
     if (roughness > Math::Epsilon<float>()) {
-        direction += roughness * RandomUnitVector();
+        direction += roughness * RandomUnitVector(random);
     }
     outScatteredRay = Ray {hitRecord.position, direction};
     outAttenuation = color;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+// Permuted congruential generator (pcg32, XSH RR variant).
+// It is cheap enough to create one per pixel sample, So the random sequence of a sample only depends on
+// the pixel and sample index and not on the thread that renders it.
+class PCG32 {
+public:
+
+    explicit PCG32(uint64_t const seed, uint64_t const sequence = 0) {
+        mIncrement = (sequence << 1u) | 1u;
+        step();
+        mState += SplitMix64(seed);
+        step();
+    }
+
+    // Pixel index and sample index are hashed together, Neighbouring pixels get uncorrelated sequences
+    explicit PCG32(uint32_t const pixelIndex, uint32_t const sampleIndex)
+        : PCG32((static_cast<uint64_t>(pixelIndex) << 32u) | sampleIndex)
+    {}
+
+    [[nodiscard]]
+    uint32_t NextUInt() {
+        auto const oldState = mState;
+        step();
+        auto const xorShifted = static_cast<uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+        auto const rotation = static_cast<uint32_t>(oldState >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31u));
+    }
+
+    // Range is [0, 1)
+    [[nodiscard]]
+    float NextFloat() {
+        return static_cast<float>(NextUInt() >> 8u) * (1.0f / 16777216.0f);
+    }
+
+    // Range is [min, max)
+    [[nodiscard]]
+    float NextFloat(float const min, float const max) {
+        return min + NextFloat() * (max - min);
+    }
+
+private:
+
+    void step() {
+        mState = mState * 6364136223846793005ull + mIncrement;
+    }
+
+    [[nodiscard]]
+    static uint64_t SplitMix64(uint64_t value) {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30u)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27u)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31u);
+    }
+
+    uint64_t mState = 0;
+    uint64_t mIncrement = 0;
+
+};
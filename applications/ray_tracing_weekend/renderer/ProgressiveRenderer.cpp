@@ -0,0 +1,390 @@
+#include "ProgressiveRenderer.hpp"
+
+#include "renderer/TileRenderer.hpp"
+#include "engine/BedrockAssert.hpp"
+#include "engine/BedrockFileSystem.hpp"
+#include "engine/BedrockMemory.hpp"
+
+#include "glm/glm.hpp"
+
+#include "libs/stb_image/stb_image_write.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+
+using namespace MFA;
+
+namespace {
+
+    struct CheckpointHeader {
+        uint32_t magic = 0;
+        uint32_t formatVersion = 0;
+        int32_t width = 0;
+        int32_t height = 0;
+        int32_t passCount = 0;
+    };
+
+    constexpr uint32_t CheckpointMagic = 0x50435452;   // "RTCP"
+    constexpr uint32_t CheckpointFormatVersion = 1;
+    constexpr int ComponentCount = 3;
+    // Dark pixels would never converge with a purely relative error
+    constexpr float MinLuminance = 0.001f;
+
+    float Luminance(glm::vec3 const & color) {
+        return glm::dot(color, glm::vec3 {0.2126f, 0.7152f, 0.0722f});
+    }
+
+    template<typename T>
+    bool ReadArray(FS::FileHandle const & file, std::vector<T> & outArray) {
+        auto const size = outArray.size() * sizeof(T);
+        return file.read(Blob {outArray.data(), size}) == size;
+    }
+
+    template<typename T>
+    bool WriteArray(FS::FileHandle const & file, std::vector<T> const & array) {
+        auto const size = array.size() * sizeof(T);
+        return file.write(CBlob {array.data(), size}) == size;
+    }
+
+}
+
+//-------------------------------------------------------------------------------------------------
+
+ProgressiveRenderer::ProgressiveRenderer(int const width, int const height, int const maxDepth)
+    : mWidth(width)
+    , mHeight(height)
+    , mMaxDepth(maxDepth)
+{
+    MFA_ASSERT(width > 1 && height > 1);
+    auto const pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+    mColorSum.resize(pixelCount);
+    mLuminanceSum.resize(pixelCount);
+    mLuminanceSqrSum.resize(pixelCount);
+    mSampleCount.resize(pixelCount);
+    mIsConverged.resize(pixelCount);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void ProgressiveRenderer::Render(
+    Scene const & scene,
+    Camera const & camera,
+    Budget const & budget,
+    uint32_t const threadCount
+) {
+    MFA_ASSERT(budget.samplesPerPass > 0);
+    MFA_ASSERT(budget.minSamplesPerPixel <= budget.maxSamplesPerPixel);
+
+    using Clock = std::chrono::steady_clock;
+    auto const startTime = Clock::now();
+    auto lastCheckpointTime = startTime;
+    auto const elapsedSince = [](Clock::time_point const time)->double {
+        return std::chrono::duration<double>(Clock::now() - time).count();
+    };
+
+    // Budget may differ from the previous call or the checkpoint
+    for (size_t i = 0; i < mSampleCount.size(); ++i) {
+        UpdateConvergence(i, budget);
+    }
+
+    while (GetConvergedPixelCount() < static_cast<int>(mSampleCount.size())) {
+        RenderPass(scene, camera, budget, threadCount);
+
+        if (
+            budget.checkpointIntervalInSec > 0.0 &&
+            mCheckpointPath.empty() == false &&
+            elapsedSince(lastCheckpointTime) >= budget.checkpointIntervalInSec
+        ) {
+            WriteCheckpoint();
+            lastCheckpointTime = Clock::now();
+        }
+
+        if (budget.maxTimeInSec > 0.0 && elapsedSince(startTime) >= budget.maxTimeInSec) {
+            break;
+        }
+    }
+
+    mRenderTimeInSec += elapsedSince(startTime);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void ProgressiveRenderer::RenderPass(
+    Scene const & scene,
+    Camera const & camera,
+    Budget const & budget,
+    uint32_t const threadCount
+) {
+    mRayCount += TileRenderer::ForEachTile(
+        mWidth,
+        mHeight,
+        threadCount,
+        [this, &scene, &camera, &budget](int const beginX, int const beginY, int const endX, int const endY, uint64_t & rayCount)->void {
+            for (int y = beginY; y < endY; ++y) {
+                for (int x = beginX; x < endX; ++x) {
+                    auto const pixelIndex = static_cast<size_t>(y) * mWidth + x;
+                    if (mIsConverged[pixelIndex] != 0) {
+                        continue;
+                    }
+
+                    auto const firstSample = mSampleCount[pixelIndex];
+                    auto const lastSample = std::min(
+                        firstSample + static_cast<uint32_t>(budget.samplesPerPass),
+                        static_cast<uint32_t>(budget.maxSamplesPerPixel)
+                    );
+                    for (auto sampleIndex = firstSample; sampleIndex < lastSample; ++sampleIndex) {
+                        auto const color = TileRenderer::TraceSample(
+                            scene, camera, mWidth, mHeight, x, y, sampleIndex, mMaxDepth, rayCount
+                        );
+                        auto const luminance = Luminance(color);
+                        mColorSum[pixelIndex] += color;
+                        mLuminanceSum[pixelIndex] += luminance;
+                        mLuminanceSqrSum[pixelIndex] += luminance * luminance;
+                    }
+                    mSampleCount[pixelIndex] = lastSample;
+
+                    UpdateConvergence(pixelIndex, budget);
+                }
+            }
+        }
+    );
+    ++mPassCount;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void ProgressiveRenderer::UpdateConvergence(size_t const pixelIndex, Budget const & budget) {
+    auto const sampleCount = mSampleCount[pixelIndex];
+    if (sampleCount >= static_cast<uint32_t>(budget.maxSamplesPerPixel)) {
+        mIsConverged[pixelIndex] = 1;
+        return;
+    }
+    if (sampleCount < static_cast<uint32_t>(std::max(budget.minSamplesPerPixel, 2))) {
+        mIsConverged[pixelIndex] = 0;
+        return;
+    }
+
+    auto const n = static_cast<float>(sampleCount);
+    auto const mean = mLuminanceSum[pixelIndex] / n;
+    auto const variance = std::max(0.0f, (mLuminanceSqrSum[pixelIndex] - mean * mLuminanceSum[pixelIndex]) / (n - 1.0f));
+    auto const standardError = std::sqrt(variance / n);
+
+    mIsConverged[pixelIndex] = standardError <= budget.maxRelativeError * std::max(mean, MinLuminance) ? 1 : 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void ProgressiveRenderer::SetCheckpointPath(std::string checkpointPath) {
+    mCheckpointPath = std::move(checkpointPath);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool ProgressiveRenderer::WriteCheckpoint() const {
+    MFA_ASSERT(mCheckpointPath.empty() == false);
+
+    bool success = true;
+    success &= WritePreview(mCheckpointPath + ".png");
+    success &= WriteHDR(mCheckpointPath + ".hdr");
+    success &= WriteAccumulation(mCheckpointPath + ".checkpoint");
+    if (success == false) {
+        MFA_LOG_WARN("Failed to write checkpoint %s", mCheckpointPath.c_str());
+    }
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool ProgressiveRenderer::WritePreview(std::string const & path) const {
+    std::vector<uint8_t> pixels (static_cast<size_t>(mWidth) * mHeight * ComponentCount);
+    for (int y = 0; y < mHeight; ++y) {
+        for (int x = 0; x < mWidth; ++x) {
+            auto const color = ToneMap(GetColor(x, y));
+            auto const index = (static_cast<size_t>(mHeight - y - 1) * mWidth + x) * ComponentCount;
+            pixels[index] = static_cast<uint8_t>(color.r * 255.99f);
+            pixels[index + 1] = static_cast<uint8_t>(color.g * 255.99f);
+            pixels[index + 2] = static_cast<uint8_t>(color.b * 255.99f);
+        }
+    }
+    return stbi_write_png(path.c_str(), mWidth, mHeight, ComponentCount, pixels.data(), mWidth * ComponentCount) == 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool ProgressiveRenderer::WriteHDR(std::string const & path) const {
+    std::vector<float> pixels (static_cast<size_t>(mWidth) * mHeight * ComponentCount);
+    for (int y = 0; y < mHeight; ++y) {
+        for (int x = 0; x < mWidth; ++x) {
+            auto const color = GetColor(x, y);
+            auto const index = (static_cast<size_t>(mHeight - y - 1) * mWidth + x) * ComponentCount;
+            pixels[index] = color.r;
+            pixels[index + 1] = color.g;
+            pixels[index + 2] = color.b;
+        }
+    }
+    return stbi_write_hdr(path.c_str(), mWidth, mHeight, ComponentCount, pixels.data()) == 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool ProgressiveRenderer::WriteAccumulation(std::string const & path) const {
+    CheckpointHeader header {};
+    header.magic = CheckpointMagic;
+    header.formatVersion = CheckpointFormatVersion;
+    header.width = mWidth;
+    header.height = mHeight;
+    header.passCount = mPassCount;
+
+    // We write into a temporary file first so a crash during the write never corrupts the previous checkpoint
+    auto const tempPath = path + ".tmp";
+
+    bool success = true;
+    {
+        auto const file = FS::OpenFile(tempPath, FS::Usage::Write);
+        if (FS::FileIsUsable(file.get()) == false) {
+            return false;
+        }
+        success &= file->write(CBlobAliasOf(header)) == sizeof(header);
+        success &= WriteArray(*file, mColorSum);
+        success &= WriteArray(*file, mLuminanceSum);
+        success &= WriteArray(*file, mLuminanceSqrSum);
+        success &= WriteArray(*file, mSampleCount);
+        success &= WriteArray(*file, mIsConverged);
+    }
+
+    std::error_code errorCode {};
+    if (success) {
+        std::filesystem::rename(tempPath, path, errorCode);
+        success = !errorCode;
+    }
+    if (success == false) {
+        std::filesystem::remove(tempPath, errorCode);
+    }
+    return success;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool ProgressiveRenderer::LoadCheckpoint() {
+    MFA_ASSERT(mCheckpointPath.empty() == false);
+
+    auto const path = mCheckpointPath + ".checkpoint";
+    if (FS::Exists(path) == false) {
+        return false;
+    }
+
+    auto const file = FS::OpenFile(path, FS::Usage::Read);
+    if (FS::FileIsUsable(file.get()) == false) {
+        return false;
+    }
+
+    CheckpointHeader header {};
+    if (file->read(Blob {&header, sizeof(header)}) != sizeof(header)) {
+        return false;
+    }
+    if (
+        header.magic != CheckpointMagic ||
+        header.formatVersion != CheckpointFormatVersion ||
+        header.width != mWidth ||
+        header.height != mHeight
+    ) {
+        MFA_LOG_WARN("Checkpoint %s does not match the current render", path.c_str());
+        return false;
+    }
+
+    // Read into copies, So a truncated file leaves the current buffers untouched
+    auto colorSum = mColorSum;
+    auto luminanceSum = mLuminanceSum;
+    auto luminanceSqrSum = mLuminanceSqrSum;
+    auto sampleCount = mSampleCount;
+    auto isConverged = mIsConverged;
+    if (
+        ReadArray(*file, colorSum) == false ||
+        ReadArray(*file, luminanceSum) == false ||
+        ReadArray(*file, luminanceSqrSum) == false ||
+        ReadArray(*file, sampleCount) == false ||
+        ReadArray(*file, isConverged) == false
+    ) {
+        MFA_LOG_WARN("Checkpoint %s is truncated", path.c_str());
+        return false;
+    }
+
+    mColorSum = std::move(colorSum);
+    mLuminanceSum = std::move(luminanceSum);
+    mLuminanceSqrSum = std::move(luminanceSqrSum);
+    mSampleCount = std::move(sampleCount);
+    mIsConverged = std::move(isConverged);
+    mPassCount = header.passCount;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+glm::vec3 ProgressiveRenderer::GetColor(int const x, int const y) const {
+    MFA_ASSERT(x >= 0 && x < mWidth);
+    MFA_ASSERT(y >= 0 && y < mHeight);
+    auto const pixelIndex = static_cast<size_t>(y) * mWidth + x;
+    auto const sampleCount = mSampleCount[pixelIndex];
+    if (sampleCount == 0) {
+        return glm::vec3 {};
+    }
+    return mColorSum[pixelIndex] / static_cast<float>(sampleCount);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+uint32_t ProgressiveRenderer::GetSampleCount(int const x, int const y) const {
+    MFA_ASSERT(x >= 0 && x < mWidth);
+    MFA_ASSERT(y >= 0 && y < mHeight);
+    return mSampleCount[static_cast<size_t>(y) * mWidth + x];
+}
+
+//-------------------------------------------------------------------------------------------------
+
+int ProgressiveRenderer::GetConvergedPixelCount() const {
+    return static_cast<int>(std::count(mIsConverged.begin(), mIsConverged.end(), static_cast<uint8_t>(1)));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+uint64_t ProgressiveRenderer::GetTotalSampleCount() const {
+    uint64_t total = 0;
+    for (auto const sampleCount : mSampleCount) {
+        total += sampleCount;
+    }
+    return total;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+uint64_t ProgressiveRenderer::GetRayCount() const {
+    return mRayCount;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+double ProgressiveRenderer::GetRenderTimeInSec() const {
+    return mRenderTimeInSec;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+int ProgressiveRenderer::GetPassCount() const {
+    return mPassCount;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+glm::vec3 ProgressiveRenderer::ToneMap(glm::vec3 const & color) {
+    static constexpr float GammaCorrection = 1.0f / 2.2f;
+    // reinhard tone mapping
+    auto const mapped = color / (color + glm::vec3(1.0f));
+    // Gamma correct
+    return glm::pow(mapped, glm::vec3(GammaCorrection));
+}
+
+//-------------------------------------------------------------------------------------------------
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "glm/vec3.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Camera;
+class Scene;
+
+// Accumulates samples in passes until every pixel converges or the budget runs out.
+// Each pixel keeps the sum and squared sum of its sample luminance, A pixel stops receiving samples when
+// the standard error of its mean is small relative to the mean.
+// Sample indices continue from the accumulated count, So a render that is resumed from a checkpoint
+// gives the same image as an uninterrupted one.
+class ProgressiveRenderer {
+public:
+
+    struct Budget {
+        int minSamplesPerPixel = 16;
+        int maxSamplesPerPixel = 1024;
+        int samplesPerPass = 4;
+        // Quality budget, Pixel is converged when standard error of its luminance <= maxRelativeError * mean
+        float maxRelativeError = 0.02f;
+        // Time budget, Zero means no limit. Checked between passes.
+        double maxTimeInSec = 0.0;
+        // Zero disables checkpoints, Requires a checkpoint path
+        double checkpointIntervalInSec = 0.0;
+    };
+
+    explicit ProgressiveRenderer(int width, int height, int maxDepth);
+
+    // Renders until converged or out of budget. Can be called again to continue with a new budget.
+    // Zero thread count means all job system threads.
+    void Render(
+        Scene const & scene,
+        Camera const & camera,
+        Budget const & budget,
+        uint32_t threadCount = 0
+    );
+
+    // Checkpoint path is used without extension. ".png" preview, ".hdr" linear image and
+    // ".checkpoint" accumulation buffers are written next to each other.
+    void SetCheckpointPath(std::string checkpointPath);
+
+    bool WriteCheckpoint() const;
+
+    // Restores accumulation buffers of a render with the same size. Returns false if there is no valid checkpoint.
+    bool LoadCheckpoint();
+
+    // Average linear color of the pixel, Row zero is the bottom of the image
+    [[nodiscard]]
+    glm::vec3 GetColor(int x, int y) const;
+
+    [[nodiscard]]
+    uint32_t GetSampleCount(int x, int y) const;
+
+    [[nodiscard]]
+    int GetConvergedPixelCount() const;
+
+    [[nodiscard]]
+    uint64_t GetTotalSampleCount() const;
+
+    [[nodiscard]]
+    uint64_t GetRayCount() const;
+
+    [[nodiscard]]
+    double GetRenderTimeInSec() const;
+
+    [[nodiscard]]
+    int GetPassCount() const;
+
+    // Reinhard tone mapping followed by gamma correction
+    [[nodiscard]]
+    static glm::vec3 ToneMap(glm::vec3 const & color);
+
+private:
+
+    void RenderPass(
+        Scene const & scene,
+        Camera const & camera,
+        Budget const & budget,
+        uint32_t threadCount
+    );
+
+    void UpdateConvergence(size_t pixelIndex, Budget const & budget);
+
+    bool WritePreview(std::string const & path) const;
+
+    bool WriteHDR(std::string const & path) const;
+
+    bool WriteAccumulation(std::string const & path) const;
+
+    int const mWidth;
+    int const mHeight;
+    int const mMaxDepth;
+
+    std::vector<glm::vec3> mColorSum {};
+    std::vector<float> mLuminanceSum {};
+    std::vector<float> mLuminanceSqrSum {};
+    std::vector<uint32_t> mSampleCount {};
+    std::vector<uint8_t> mIsConverged {};
+
+    std::string mCheckpointPath {};
+
+    int mPassCount = 0;
+    uint64_t mRayCount = 0;
+    double mRenderTimeInSec = 0.0;
+
+};
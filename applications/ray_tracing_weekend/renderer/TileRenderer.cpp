@@ -0,0 +1,174 @@
+#include "TileRenderer.hpp"
+
+#include "camera/Camera.hpp"
+#include "engine/BedrockAssert.hpp"
+#include "engine/job_system/JobSystem.hpp"
+#include "random/PCG32.hpp"
+#include "scene/Scene.hpp"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+using namespace MFA;
+
+//-------------------------------------------------------------------------------------------------
+
+TileRenderer::TileRenderer(int const width, int const height, int const sampleCount, int const maxDepth)
+    : mWidth(width)
+    , mHeight(height)
+    , mSampleCount(sampleCount)
+    , mMaxDepth(maxDepth)
+    , mColors(static_cast<size_t>(width) * static_cast<size_t>(height))
+{
+    MFA_ASSERT(width > 1 && height > 1);
+    MFA_ASSERT(sampleCount > 0);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+uint64_t TileRenderer::ForEachTile(
+    int const width,
+    int const height,
+    uint32_t threadCount,
+    TileCallback const & callback
+) {
+    MFA_ASSERT(callback != nullptr);
+
+    auto const tileCountX = (width + TileSize - 1) / TileSize;
+    auto const tileCountY = (height + TileSize - 1) / TileSize;
+    auto const tileCount = tileCountX * tileCountY;
+
+    std::atomic<int> nextTile = 0;
+    std::atomic<uint64_t> totalRayCount = 0;
+
+    auto const renderTiles = [&]()->void {
+        uint64_t rayCount = 0;
+        while (true) {
+            auto const tileIndex = nextTile.fetch_add(1, std::memory_order_relaxed);
+            if (tileIndex >= tileCount) {
+                break;
+            }
+            auto const beginX = (tileIndex % tileCountX) * TileSize;
+            auto const beginY = (tileIndex / tileCountX) * TileSize;
+            callback(
+                beginX,
+                beginY,
+                std::min(beginX + TileSize, width),
+                std::min(beginY + TileSize, height),
+                rayCount
+            );
+        }
+        totalRayCount.fetch_add(rayCount, std::memory_order_relaxed);
+    };
+
+    if (threadCount == 0) {
+        threadCount = JS::GetNumberOfAvailableThreads();
+    }
+
+    if (threadCount <= 1) {
+        renderTiles();
+    } else {
+        // One item per thread that pulls tiles, Only the threads of this call are waited for
+        JS::ParallelFor(threadCount, 1, [&renderTiles](uint32_t const beginIndex, uint32_t const endIndex)->void {
+            for (auto i = beginIndex; i < endIndex; ++i) {
+                renderTiles();
+            }
+        });
+    }
+
+    return totalRayCount.load();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void TileRenderer::Render(Scene const & scene, Camera const & camera, uint32_t const threadCount) {
+    auto const startTime = std::chrono::steady_clock::now();
+
+    auto const colorPerSample = 1.0f / static_cast<float>(mSampleCount);
+
+    mRayCount = ForEachTile(
+        mWidth,
+        mHeight,
+        threadCount,
+        [this, &scene, &camera, colorPerSample](int const beginX, int const beginY, int const endX, int const endY, uint64_t & rayCount)->void {
+            for (int y = beginY; y < endY; ++y) {
+                for (int x = beginX; x < endX; ++x) {
+                    auto const pixelIndex = static_cast<uint32_t>(y * mWidth + x);
+                    glm::vec3 color {};
+                    for (int s = 0; s < mSampleCount; ++s) {
+                        color += TraceSample(scene, camera, mWidth, mHeight, x, y, static_cast<uint32_t>(s), mMaxDepth, rayCount);
+                    }
+                    mColors[pixelIndex] = color * colorPerSample;
+                }
+            }
+        }
+    );
+
+    mRenderTimeInSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+glm::vec3 TileRenderer::TraceSample(
+    Scene const & scene,
+    Camera const & camera,
+    int const width,
+    int const height,
+    int const x,
+    int const y,
+    uint32_t const sampleIndex,
+    int const maxDepth,
+    uint64_t & rayCount
+) {
+    PCG32 random {static_cast<uint32_t>(y * width + x), sampleIndex};
+    auto const u = (static_cast<float>(x) + random.NextFloat(-1.0f, 1.0f)) / static_cast<float>(width - 1);
+    auto const v = (static_cast<float>(y) + random.NextFloat(-1.0f, 1.0f)) / static_cast<float>(height - 1);
+    auto const ray = camera.CreateRay(u, v, random);
+    return scene.RayColor(ray, maxDepth, random, rayCount);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+std::vector<glm::vec3> const & TileRenderer::GetColors() const {
+    return mColors;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+glm::vec3 const & TileRenderer::GetColor(int const x, int const y) const {
+    MFA_ASSERT(x >= 0 && x < mWidth);
+    MFA_ASSERT(y >= 0 && y < mHeight);
+    return mColors[y * mWidth + x];
+}
+
+//-------------------------------------------------------------------------------------------------
+
+uint64_t TileRenderer::GetRayCount() const {
+    return mRayCount;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+double TileRenderer::GetRenderTimeInSec() const {
+    return mRenderTimeInSec;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+double TileRenderer::GetRaysPerSecond() const {
+    if (mRenderTimeInSec <= 0.0) {
+        return 0.0;
+    }
+    return static_cast<double>(mRayCount) / mRenderTimeInSec;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+int TileRenderer::GetTileCount() const {
+    return ((mWidth + TileSize - 1) / TileSize) * ((mHeight + TileSize - 1) / TileSize);
+}
+
+//-------------------------------------------------------------------------------------------------
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "glm/vec3.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class Camera;
+class Scene;
+
+// Splits the image into square tiles, Threads pull the next tile from an atomic counter until none is left.
+// Every sample has its own random generator seeded by pixel and sample index,
+// So the result is bit-identical regardless of the number of threads.
+class TileRenderer {
+public:
+
+    static constexpr int TileSize = 16;
+
+    // Range is [begin, end), Ray count is a per thread counter that is summed after all tiles are done
+    using TileCallback = std::function<void(int beginX, int beginY, int endX, int endY, uint64_t & rayCount)>;
+
+    // Calls the callback once per tile on up to threadCount threads and blocks until all tiles are done.
+    // Zero thread count means all job system threads. Returns the total ray count.
+    static uint64_t ForEachTile(int width, int height, uint32_t threadCount, TileCallback const & callback);
+
+    explicit TileRenderer(int width, int height, int sampleCount, int maxDepth);
+
+    // Blocks until the whole image is rendered. Zero thread count means all job system threads.
+    void Render(Scene const & scene, Camera const & camera, uint32_t threadCount = 0);
+
+    // Average linear color of each pixel, Row zero is the bottom of the image
+    [[nodiscard]]
+    std::vector<glm::vec3> const & GetColors() const;
+
+    [[nodiscard]]
+    glm::vec3 const & GetColor(int x, int y) const;
+
+    [[nodiscard]]
+    uint64_t GetRayCount() const;
+
+    [[nodiscard]]
+    double GetRenderTimeInSec() const;
+
+    [[nodiscard]]
+    double GetRaysPerSecond() const;
+
+    [[nodiscard]]
+    int GetTileCount() const;
+
+    // Color of a single sample. Random sequence only depends on the pixel and the sample index.
+    [[nodiscard]]
+    static glm::vec3 TraceSample(
+        Scene const & scene,
+        Camera const & camera,
+        int width,
+        int height,
+        int x,
+        int y,
+        uint32_t sampleIndex,
+        int maxDepth,
+        uint64_t & rayCount
+    );
+
+private:
+
+    int const mWidth;
+    int const mHeight;
+    int const mSampleCount;
+    int const mMaxDepth;
+
+    std::vector<glm::vec3> mColors {};
+
+    uint64_t mRayCount = 0;
+    double mRenderTimeInSec = 0.0;
+
+};
@@ -0,0 +1,173 @@
+#include "Scene.hpp"
+
+#include "engine/BedrockMath.hpp"
+#include "geometry/Geometry.hpp"
+#include "geometry/HitRecord.hpp"
+#include "geometry/mesh/MeshInstance.hpp"
+#include "geometry/sphere/Sphere.hpp"
+#include "material/dielectric/Dielectric.hpp"
+#include "material/diffuse/Diffuse.hpp"
+#include "material/metal/Metal.hpp"
+
+#include "glm/glm.hpp"
+#include "glm/ext/matrix_transform.hpp"
+
+#include <cmath>
+#include <limits>
+
+using namespace MFA;
+
+static float Infinity = std::numeric_limits<float>::infinity();
+
+//-------------------------------------------------------------------------------------------------
+
+Scene::Scene() = default;
+
+//-------------------------------------------------------------------------------------------------
+
+void Scene::AddGeometry(std::shared_ptr<Geometry> geometry) {
+    mPendingGeometries.emplace_back(std::move(geometry));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void Scene::Build() {
+    auto geometries = mBVH.GetGeometries();
+    geometries.insert(geometries.end(), mPendingGeometries.begin(), mPendingGeometries.end());
+    mPendingGeometries.clear();
+    mBVH.Build(std::move(geometries));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool Scene::HasIntersect(
+    Ray const & ray,
+    float const tMin,
+    float const tMax,
+    HitRecord & outHitRecord
+) const {
+    return mBVH.HasIntersect(ray, tMin, tMax, outHitRecord);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+glm::vec3 Scene::RayColor(
+    Ray const & ray,
+    int maxDepth,
+    PCG32 & random,
+    uint64_t & rayCount
+) const {
+    if (maxDepth <= 0) {
+        return glm::vec3 {};
+    }
+
+    ++rayCount;
+
+    HitRecord hitRecord {};
+    hitRecord.t = Infinity;
+
+    if (HasIntersect(ray, 0.001f, Infinity, hitRecord)) {
+        glm::vec3 attenuation {};
+        Ray scatteredRay;
+        bool const hasScatteredRay = hitRecord.material->Scatter(ray, hitRecord, random, attenuation, scatteredRay);
+        if (hasScatteredRay)
+        {
+            return attenuation * RayColor(scatteredRay, maxDepth - 1, random, rayCount);
+        }
+        return glm::vec3 {0.0f, 0.0f, 0.0f};
+    }
+
+    auto const t = 0.5f * (ray.GetDirection().y + 1.0f);
+    return glm::mix(glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(0.5f, 0.7f, 1.0f), t);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+size_t Scene::GetGeometryCount() const {
+    return mBVH.GetGeometries().size() + mPendingGeometries.size();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+BVH const & Scene::GetBVH() const {
+    return mBVH;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Scene> Scene::CreateFinalScene(int const smallSphereCount) {
+    auto scene = std::make_unique<Scene>();
+
+    auto const RandomVec3 = [](float min = 0.0f, float max = 1.0f)-> glm::vec3 {
+        return glm::vec3 {
+            Math::Random(min, max),
+            Math::Random(min, max),
+            Math::Random(min, max)
+        };
+    };
+
+    auto ground_material = std::make_shared<Diffuse>(glm::vec3(0.5f, 0.5f, 0.5f));
+    scene->AddGeometry(std::make_shared<Sphere>(glm::vec3(0.0f,-1000.0f,0.0f), 1000.0f, ground_material));
+
+    auto const halfGridSize = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(smallSphereCount)) * 0.5f));
+    int sphereCount = 0;
+
+    for (int a = -halfGridSize; a < halfGridSize && sphereCount < smallSphereCount; a++) {
+        for (int b = -halfGridSize; b < halfGridSize && sphereCount < smallSphereCount; b++) {
+            float choose_mat = Math::Random<float>(0.0f, 1.0f);
+            glm::vec3 center(a + 0.9f * Math::Random<float>(0.0f, 1.0f), 0.2f, b + 0.9f * Math::Random<float>(0.0f, 1.0f));
+
+            std::shared_ptr<Material> sphere_material = nullptr;
+
+            if (choose_mat < 0.8f) {
+                // diffuse
+                auto albedo = RandomVec3() * RandomVec3();
+                sphere_material = std::make_shared<Diffuse>(albedo);
+            } else if (choose_mat < 0.95f) {
+                // metal
+                auto albedo = RandomVec3(0.5f, 1.0f);
+                auto fuzz = Math::Random(0.0f, 0.5f);
+                sphere_material = std::make_shared<Metal>(albedo, fuzz);
+            } else {
+                // glass
+                sphere_material = std::make_shared<Dielectric>(glm::vec3 {1.0f, 1.0f, 1.0f}, 1.5f);
+            }
+            scene->AddGeometry(std::make_shared<Sphere>(center, 0.2f, sphere_material));
+            ++sphereCount;
+        }
+    }
+
+    auto material1 = std::make_shared<Dielectric>(glm::vec3 {1.0f, 1.0f, 1.0f}, 1.5f);
+    scene->AddGeometry(std::make_shared<Sphere>(glm::vec3(0.0f, 1.0f, 0.0f), 1.0f, material1));
+
+    auto material2 = std::make_shared<Diffuse>(glm::vec3(0.4f, 0.2f, 0.1f));
+    scene->AddGeometry(std::make_shared<Sphere>(glm::vec3(-4.0f, 1.0f, 0.0f), 1.0f, material2));
+
+    auto material3 = std::make_shared<Metal>(glm::vec3(0.7f, 0.6f, 0.5f), 0.0f);
+    scene->AddGeometry(std::make_shared<Sphere>(glm::vec3(4.0f, 1.0f, 0.0f), 1.0f, material3));
+
+    scene->Build();
+
+    return scene;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+std::unique_ptr<Scene> Scene::CreateModelScene(std::string const & modelPath, float const modelScale) {
+    auto scene = std::make_unique<Scene>();
+
+    auto ground_material = std::make_shared<Diffuse>(glm::vec3(0.5f, 0.5f, 0.5f));
+    scene->AddGeometry(std::make_shared<Sphere>(glm::vec3(0.0f,-1000.0f,0.0f), 1000.0f, ground_material));
+
+    auto const transform = glm::scale(glm::identity<glm::mat4>(), glm::vec3 {modelScale});
+    auto const instances = MeshInstance::ImportGLTF(modelPath, transform);
+    for (auto const & instance : instances) {
+        scene->AddGeometry(instance);
+    }
+
+    scene->Build();
+
+    return scene;
+}
+
+//-------------------------------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "bvh/BVH.hpp"
+#include "random/PCG32.hpp"
+#include "ray/Ray.hpp"
+
+#include "glm/vec3.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Geometry;
+
+struct HitRecord;
+
+class Scene {
+public:
+
+    explicit Scene();
+
+    // Geometries are not visible to rays until Build is called
+    void AddGeometry(std::shared_ptr<Geometry> geometry);
+
+    void Build();
+
+    [[nodiscard]]
+    bool HasIntersect(
+        Ray const & ray,
+        float tMin,
+        float tMax,
+        HitRecord & outHitRecord
+    ) const;
+
+    // Every traced ray, Including scattered ones, Increments rayCount
+    [[nodiscard]]
+    glm::vec3 RayColor(
+        Ray const & ray,
+        int maxDepth,
+        PCG32 & random,
+        uint64_t & rayCount
+    ) const;
+
+    [[nodiscard]]
+    size_t GetGeometryCount() const;
+
+    [[nodiscard]]
+    BVH const & GetBVH() const;
+
+    // Ray tracing in one weekend final scene, Small spheres are placed on a square grid that grows with their count.
+    // Original scene has 484 small spheres.
+    [[nodiscard]]
+    static std::unique_ptr<Scene> CreateFinalScene(int smallSphereCount);
+
+    // Gltf model on top of the ground sphere of the final scene. Model is uniformly scaled by modelScale,
+    // Used as a reference for the raster pbr pipeline (Only base color factor of materials is used).
+    [[nodiscard]]
+    static std::unique_ptr<Scene> CreateModelScene(std::string const & modelPath, float modelScale);
+
+private:
+
+    std::vector<std::shared_ptr<Geometry>> mPendingGeometries {};
+    BVH mBVH {};
+
+};
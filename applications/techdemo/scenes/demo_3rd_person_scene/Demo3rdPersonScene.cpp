@@ -333,6 +333,9 @@ void Demo3rdPersonScene::createFireEssence(std::shared_ptr<RT::GpuTexture> const
         },
         AS::Particle::Params{
             .count = 256,
+        },
+        AS::Particle::EmitterParams{
+            .spawnRate = 400.0f,
             .minLife = 0.2f,
             .maxLife = 1.0f,
             .minSpeed = 0.5f,
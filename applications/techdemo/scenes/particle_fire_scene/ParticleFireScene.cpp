@@ -12,6 +12,7 @@
 #include "engine/entity_system/components/BoundingVolumeRendererComponent.hpp"
 #include "engine/entity_system/components/ColorComponent.hpp"
 #include "engine/entity_system/components/MeshRendererComponent.hpp"
+#include "engine/entity_system/components/ParticleEmitterComponent.hpp"
 #include "engine/entity_system/components/TransformComponent.hpp"
 #include "engine/resource_manager/ResourceManager.hpp"
 #include "engine/scene_manager/SceneManager.hpp"
@@ -23,6 +24,10 @@ using namespace MFA;
 
 static constexpr float FireRadius = 0.7f;
 
+// Fills the gpu particle pool with 1024 emitters of 1024 particles each (1M particles)
+static constexpr bool MillionParticleBenchmark = false;
+static constexpr uint32_t BenchmarkGridSize = 32;
+
 //-------------------------------------------------------------------------------------------------
 
 ParticleFireScene::ParticleFireScene()
@@ -81,20 +86,60 @@ void ParticleFireScene::createFireEssence() const
             "images/fire/particle_fire.ktx",
             [this](std::shared_ptr<RT::GpuTexture> const & texture)->void{
 
+                AS::Particle::Params const params {
+                    .count = 1024
+                };
+
+                AS::Particle::EmitterParams const emitterParams {
+                    .spawnRate = static_cast<float>(params.count) / 1.25f,
+                    .radius = FireRadius
+                };
+
                 mParticlePipeline->addEssence(
                     std::make_shared<FireEssence>(
                         "ParticleSceneFire",
-                        100,
+                        MillionParticleBenchmark ? BenchmarkGridSize * BenchmarkGridSize : 100,
                         std::vector {texture},
                         MFA::FireParams {},
-                        AS::Particle::Params {
-                            .count = 1024,
-                            .radius = FireRadius
-                        }
+                        params,
+                        emitterParams
                     )
                 );
 
-                createFireInstance(glm::vec3 {0.0f, 0.0f, 0.0f});
+                if constexpr (MillionParticleBenchmark)
+                {
+                    for (uint32_t x = 0; x < BenchmarkGridSize; ++x)
+                    {
+                        for (uint32_t z = 0; z < BenchmarkGridSize; ++z)
+                        {
+                            createFireInstance(
+                                glm::vec3 {
+                                    (static_cast<float>(x) - BenchmarkGridSize * 0.5f) * 2.0f * FireRadius,
+                                    0.0f,
+                                    (static_cast<float>(z) - BenchmarkGridSize * 0.5f) * 2.0f * FireRadius
+                                },
+                                emitterParams
+                            );
+                        }
+                    }
+                }
+                else
+                {
+                    // Each fire has its own emitter params
+                    createFireInstance(glm::vec3 {0.0f, 0.0f, 0.0f}, emitterParams);
+
+                    auto smallFire = emitterParams;
+                    smallFire.spawnRate *= 0.4f;
+                    smallFire.radius *= 0.5f;
+                    smallFire.sizeScale = 0.6f;
+                    createFireInstance(glm::vec3 {-2.0f, 0.0f, 0.0f}, smallFire);
+
+                    auto blueFire = emitterParams;
+                    blueFire.minSpeed *= 1.5f;
+                    blueFire.maxSpeed *= 1.5f;
+                    blueFire.color = glm::vec3 {0.2f, 0.4f, 1.0f};
+                    createFireInstance(glm::vec3 {2.0f, 0.0f, 0.0f}, blueFire);
+                }
 
             }
         );
@@ -103,7 +148,10 @@ void ParticleFireScene::createFireEssence() const
 
 //-------------------------------------------------------------------------------------------------
 
-void ParticleFireScene::createFireInstance(glm::vec3 const & position) const
+void ParticleFireScene::createFireInstance(
+    glm::vec3 const & position,
+    AS::Particle::EmitterParams const & emitterParams
+) const
 {
     auto * entity = EntitySystem::CreateEntity("FireInstance", GetRootEntity());
     MFA_ASSERT(entity != nullptr);
@@ -112,20 +160,21 @@ void ParticleFireScene::createFireInstance(glm::vec3 const & position) const
     MFA_ASSERT(transform != nullptr);
     transform->SetLocalPosition(position);
     
+    entity->AddComponent<ParticleEmitterComponent>(emitterParams);
     entity->AddComponent<MeshRendererComponent>(
         mParticlePipeline,
         "ParticleSceneFire"
     );
     entity->AddComponent<AxisAlignedBoundingBoxComponent>(
         glm::vec3{ 0.0f, -0.8f, 0.0f },
-        glm::vec3{ FireRadius, 1.0f, FireRadius },
+        glm::vec3{ emitterParams.radius, 1.0f, emitterParams.radius },
         true
     );
     entity->AddComponent<ColorComponent>(glm::vec3{ 1.0f, 0.0f, 0.0f });
 
     auto const boundingVolumeRenderer = entity->AddComponent<BoundingVolumeRendererComponent>();
     MFA_ASSERT(boundingVolumeRenderer != nullptr);
-    boundingVolumeRenderer->SetActive(true);
+    boundingVolumeRenderer->SetActive(MillionParticleBenchmark == false);
 
     EntitySystem::InitEntity(entity);
 }
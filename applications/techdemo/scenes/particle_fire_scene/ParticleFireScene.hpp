@@ -16,8 +16,7 @@ namespace MFA
     {
         namespace Particle
         {
-            class Mesh;
-            struct Vertex;
+            struct EmitterParams;
         }
     }
 }
@@ -45,7 +44,10 @@ public:
 private:
 
     void createFireEssence() const;
-    void createFireInstance(glm::vec3 const & position) const;
+    void createFireInstance(
+        glm::vec3 const & position,
+        MFA::AssetSystem::Particle::EmitterParams const & emitterParams
+    ) const;
 
     void createCamera();
     
@@ -10,7 +10,9 @@ float3 CalculateNormalFromTexture(
     sampler textureSampler
 )
 {
-    float3 tangentNormal = normalTexture.Sample(textureSampler, normalTexCoord).rgb * 2.0 - 1.0;
+    // Blue is rebuilt from red and green since BC5 normal maps only store those two
+    float2 tangentNormalXY = normalTexture.Sample(textureSampler, normalTexCoord).rg * 2.0 - 1.0;
+    float3 tangentNormal = float3(tangentNormalXY, sqrt(saturate(1.0 - dot(tangentNormalXY, tangentNormalXY))));
     float3x3 TBN = transpose(float3x3(worldTangent, worldBiTangent, worldNormal));
     float3 pixelNormal = mul(TBN, tangentNormal).xyz;
     return pixelNormal;
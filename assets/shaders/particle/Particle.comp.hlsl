@@ -1,81 +1,73 @@
+#include "../CameraBuffer.hlsl"
 #include "../Random.hlsl"
 #include "../TimeBuffer.hlsl"
+#include "ParticleTypes.hlsl"
 
-struct Params {
-    int count;
-    float3 moveDirection;
-    
-    float minLife;
-    float maxLife;
-    float minSpeed;
-    float maxSpeed;
-
-    float radius;
-    float3 noiseMin;
-
-    float alpha;    
-    float3 noiseMax;
-
-    float pointSize;
-    float3 placeholder;
-};
-
-struct Particle
-{
-    // Per vertex data
-    float3 localPosition;
-    int textureIndex;
-
-    float3 color;
-    float alpha;
-    
-    float pointSize;
-
-    // State variables
-    float remainingLifeInSec;
-    float totalLifeInSec;
-    float placeholder0;
-    
-    float3 initialLocalPosition;
-    float speed;
-};
+ConstantBuffer <CameraData> cameraBuffer : register(b0, space0);
+ConstantBuffer<Time> time : register(b2, space0);
 
 ConstantBuffer<Params> params : register(b0, space1);
 RWStructuredBuffer<Particle> particles : register(u1, space1);
+RWStructuredBuffer<uint> deadList : register(u2, space1);
+RWStructuredBuffer<uint> aliveLists : register(u3, space1);
+RWStructuredBuffer<DrawEntry> drawList : register(u4, space1);
+RWByteAddressBuffer counters : register(u5, space1);
+StructuredBuffer<Emitter> emitters : register(t6, space1);
+
+[[vk::push_constant]]
+cbuffer {
+    PushConsts pushConsts;
+};
 
-ConstantBuffer<Time> time : register(b2, space0);
-
-[numthreads(256, 1, 1)]
+// Dispatched indirectly with one thread per alive particle
+[numthreads(SIMULATION_GROUP_SIZE, 1, 1)]
 void main(uint3 GlobalInvocationID : SV_DispatchThreadID)
 {
-    // Current SSBO index
+    uint currentList = pushConsts.currentList;
+    uint nextList = 1 - currentList;
+
     uint index = GlobalInvocationID.x;
-	// Don't try to write beyond particle count
-    if (index >= params.count)
+    if (index >= counters.Load(COUNTERS_ALIVE_COUNT(currentList)))
     {
-		return;
+        return;
     }
 
-    // TODO: Instead of reading from rand  we should use a noise texture
-    
-    float3 deltaPosition = time.deltaTime * particles[index].speed * params.moveDirection;
-    particles[index].localPosition += deltaPosition;
-    particles[index].localPosition += rand(particles[index].localPosition, params.noiseMin, params.noiseMax) * time.deltaTime;
-    
-    particles[index].remainingLifeInSec -= time.deltaTime;
-    if (particles[index].remainingLifeInSec <= 0)
-    {
-        particles[index].localPosition = particles[index].initialLocalPosition;
+    uint particleIndex = aliveLists[currentList * pushConsts.capacity + index];
+    Particle particle = particles[particleIndex];
 
-        particles[index].speed = rand(particles[index].localPosition, params.minSpeed, params.maxSpeed);
-        particles[index].remainingLifeInSec = rand(particles[index].localPosition, params.minLife, params.maxLife);
-        particles[index].totalLifeInSec = particles[index].remainingLifeInSec;
+    // Particles of hidden emitters are kept as they are, Emitters that are removed do not hide their particles
+    bool isVisible = particle.emitterIndex >= pushConsts.emitterCount || emitters[particle.emitterIndex].isVisible != 0;
+    if (isVisible)
+    {
+        particle.remainingLifeInSec -= time.deltaTime;
+        if (particle.remainingLifeInSec <= 0.0f)
+        {
+            uint deadIndex;
+            counters.InterlockedAdd(COUNTERS_DEAD_COUNT, 1, deadIndex);
+            deadList[deadIndex] = particleIndex;
+            return;
+        }
+
+        // TODO: Instead of reading from rand  we should use a noise texture
+        particle.position += particle.velocity * time.deltaTime;
+        particle.position += rand(particle.position, params.noiseMin, params.noiseMax) * time.deltaTime;
+
+        float lifePercentage = particle.remainingLifeInSec / particle.totalLifeInSec;
+        particle.alpha = params.alpha;
+        particle.pointSize = params.pointSize * particle.sizeScale * lifePercentage;
+
+        particles[particleIndex] = particle;
     }
 
-    float lifePercentage = particles[index].remainingLifeInSec / particles[index].totalLifeInSec;
-
-    particles[index].alpha = params.alpha;
-
-    particles[index].pointSize = params.pointSize * lifePercentage;
+    // Compaction, Survivors are packed at the front of the next list
+    uint aliveIndex;
+    counters.InterlockedAdd(COUNTERS_ALIVE_COUNT(nextList), 1, aliveIndex);
+    aliveLists[nextList * pushConsts.capacity + aliveIndex] = particleIndex;
+
+    // Ascending order of the key is back to front
+    float4 clipPosition = mul(cameraBuffer.viewProjection, float4(particle.position, 1.0f));
+    DrawEntry drawEntry;
+    drawEntry.sortKey = -clipPosition.w;
+    drawEntry.particleIndex = particleIndex;
+    drawList[aliveIndex] = drawEntry;
 }
-
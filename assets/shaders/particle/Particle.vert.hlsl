@@ -1,16 +1,5 @@
 #include "../CameraBuffer.hlsl"
-
-struct VSIn {
-    // Per vertex data
-    float3 localPosition : SV_POSITION;
-    int textureIndex;
-    float3 color : COLOR0;
-    float alpha : COLOR1;
-    float pointSize;
-
-    // Per instance data
-    float3 instancePosition: SV_POSITION;
-};
+#include "ParticleTypes.hlsl"
 
 struct VSOut {
     float4 position : SV_POSITION;
@@ -25,6 +14,9 @@ struct VSOut {
 
 ConstantBuffer <CameraData> cameraBuffer: register(b0, space0);
 
+StructuredBuffer<Particle> particles : register(t1, space1);
+StructuredBuffer<DrawEntry> drawList : register(t2, space1);
+
 struct PushConsts
 {
     float2 viewportDimension;
@@ -37,22 +29,25 @@ cbuffer {
     PushConsts pushConsts;
 };
 
-VSOut main(VSIn input) {
+// Vertex count comes from the indirect draw, Each vertex is one entry of the draw list
+VSOut main(uint vertexIndex : SV_VertexID) {
     VSOut output;
 
+    Particle particle = particles[drawList[vertexIndex].particleIndex];
+
     // Position
-    float4 position = mul(cameraBuffer.viewProjection, float4(input.instancePosition + input.localPosition, 1.0f));
+    float4 position = mul(cameraBuffer.viewProjection, float4(particle.position, 1.0f));
     output.position = position;
     // TODO Read more about screen space
     output.centerPosition = ((position.xy / position.w) + 1.0) * 0.5 * pushConsts.viewportDimension; // Vertex position in screen space
-    output.textureIndex = input.textureIndex;
+    output.textureIndex = particle.textureIndex;
     // output.uv = input.uv;
-    output.color = input.color;
-    output.alpha = input.alpha;
+    output.color = particle.color;
+    output.alpha = particle.alpha;
 
-    float pointSize = input.pointSize / position.w;
+    float pointSize = particle.pointSize / position.w;
     output.pointRadius = pointSize / 2.0f;
     output.PSize = pointSize;
 
     return output;
-}
\ No newline at end of file
+}
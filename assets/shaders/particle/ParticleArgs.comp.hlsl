@@ -0,0 +1,37 @@
+#include "ParticleTypes.hlsl"
+
+RWByteAddressBuffer counters : register(u5, space1);
+
+[[vk::push_constant]]
+cbuffer {
+    PushConsts pushConsts;
+};
+
+#define STAGE_PREPARE_SIMULATION 0
+#define STAGE_PREPARE_DRAW 1
+
+// Turns alive counts into indirect arguments, So the cpu never waits for the gpu to know the particle count
+[numthreads(1, 1, 1)]
+void main()
+{
+    uint currentList = pushConsts.currentList;
+    uint nextList = 1 - currentList;
+
+    if (pushConsts.stage == STAGE_PREPARE_SIMULATION)
+    {
+        uint aliveCount = counters.Load(COUNTERS_ALIVE_COUNT(currentList));
+        counters.Store(COUNTERS_GROUP_COUNT_X, (aliveCount + SIMULATION_GROUP_SIZE - 1) / SIMULATION_GROUP_SIZE);
+        counters.Store(COUNTERS_GROUP_COUNT_Y, 1);
+        counters.Store(COUNTERS_GROUP_COUNT_Z, 1);
+        // Simulation appends the survivors to the next list
+        counters.Store(COUNTERS_ALIVE_COUNT(nextList), 0);
+    }
+    else
+    {
+        // Next frame emits into the list that simulation just filled
+        counters.Store(COUNTERS_VERTEX_COUNT, counters.Load(COUNTERS_ALIVE_COUNT(nextList)));
+        counters.Store(COUNTERS_INSTANCE_COUNT, 1);
+        counters.Store(COUNTERS_FIRST_VERTEX, 0);
+        counters.Store(COUNTERS_FIRST_INSTANCE, 0);
+    }
+}
@@ -0,0 +1,61 @@
+#include "ParticleTypes.hlsl"
+
+ConstantBuffer<Params> params : register(b0, space1);
+RWStructuredBuffer<Particle> particles : register(u1, space1);
+RWStructuredBuffer<uint> deadList : register(u2, space1);
+RWStructuredBuffer<uint> aliveLists : register(u3, space1);
+RWByteAddressBuffer counters : register(u5, space1);
+StructuredBuffer<Emitter> emitters : register(t6, space1);
+
+[[vk::push_constant]]
+cbuffer {
+    PushConsts pushConsts;
+};
+
+static const float PI = 3.14159265f;
+
+// Each row of groups belongs to one emitter
+[numthreads(EMIT_GROUP_SIZE, 1, 1)]
+void main(uint3 GroupID : SV_GroupID, uint3 GlobalInvocationID : SV_DispatchThreadID)
+{
+    uint emitterIndex = GroupID.y;
+    Emitter emitter = emitters[emitterIndex];
+    if (GlobalInvocationID.x >= emitter.emitCount)
+    {
+        return;
+    }
+
+    // Pop a dead particle, Threads that find the list empty give their decrement back
+    uint previousDeadCount;
+    counters.InterlockedAdd(COUNTERS_DEAD_COUNT, 0xFFFFFFFFu, previousDeadCount);
+    int deadCount = asint(previousDeadCount);
+    if (deadCount <= 0)
+    {
+        counters.InterlockedAdd(COUNTERS_DEAD_COUNT, 1);
+        return;
+    }
+    uint particleIndex = deadList[deadCount - 1];
+
+    uint randomState = pcgHash(emitter.seed ^ pcgHash(GlobalInvocationID.x));
+
+    // Random point on the emitter disk, Biased towards the outer ring like the original fire
+    float yaw = nextRandom(randomState, -PI, PI);
+    float distanceFromCenter = nextRandom(randomState, 0.0f, emitter.radius) * nextRandom(randomState, 0.5f, 1.0f);
+
+    Particle particle;
+    particle.position = emitter.position + float3(cos(yaw), 0.0f, -sin(yaw)) * distanceFromCenter;
+    particle.velocity = emitter.moveDirection * nextRandom(randomState, emitter.minSpeed, emitter.maxSpeed);
+    particle.remainingLifeInSec = nextRandom(randomState, emitter.minLife, emitter.maxLife);
+    particle.totalLifeInSec = particle.remainingLifeInSec;
+    particle.color = emitter.color;
+    particle.alpha = params.alpha;
+    particle.pointSize = params.pointSize * emitter.sizeScale;
+    particle.textureIndex = params.textureIndex;
+    particle.emitterIndex = emitterIndex;
+    particle.sizeScale = emitter.sizeScale;
+    particles[particleIndex] = particle;
+
+    uint aliveIndex;
+    counters.InterlockedAdd(COUNTERS_ALIVE_COUNT(pushConsts.currentList), 1, aliveIndex);
+    aliveLists[pushConsts.currentList * pushConsts.capacity + aliveIndex] = particleIndex;
+}
@@ -0,0 +1,106 @@
+#include "ParticleTypes.hlsl"
+
+RWStructuredBuffer<DrawEntry> drawList : register(u4, space1);
+RWByteAddressBuffer counters : register(u5, space1);
+
+[[vk::push_constant]]
+cbuffer {
+    PushConsts pushConsts;
+};
+
+// Must match ParticleSort.hpp
+#define GROUP_SIZE 256
+#define LOCAL_SIZE 512
+
+#define STAGE_LOCAL_SORT 0
+#define STAGE_GLOBAL_MERGE 1
+#define STAGE_LOCAL_MERGE 2
+
+// Sorts the draw list by ascending key, Entries past the alive count are not drawn so they are moved to the end
+static const float SENTINEL_KEY = 3.402823466e+38f;
+
+groupshared DrawEntry localEntries[LOCAL_SIZE];
+
+bool shouldSwap(DrawEntry left, DrawEntry right, bool ascending)
+{
+    return (left.sortKey > right.sortKey) == ascending;
+}
+
+// Compare and swap step with distance j inside shared memory, Direction comes from the global index
+void localStep(uint localIndex, uint groupOffset, uint k, uint j)
+{
+    uint left = (localIndex / j) * 2 * j + (localIndex % j);
+    uint right = left + j;
+    bool ascending = ((groupOffset + left) & k) == 0;
+
+    DrawEntry leftEntry = localEntries[left];
+    DrawEntry rightEntry = localEntries[right];
+    if (shouldSwap(leftEntry, rightEntry, ascending))
+    {
+        localEntries[left] = rightEntry;
+        localEntries[right] = leftEntry;
+    }
+    GroupMemoryBarrierWithGroupSync();
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void main(uint3 GroupID : SV_GroupID, uint3 LocalInvocationID : SV_GroupThreadID, uint3 GlobalInvocationID : SV_DispatchThreadID)
+{
+    uint k = pushConsts.k;
+
+    if (pushConsts.stage == STAGE_GLOBAL_MERGE)
+    {
+        uint j = pushConsts.j;
+        uint thread = GlobalInvocationID.x;
+        uint left = (thread / j) * 2 * j + (thread % j);
+        uint right = left + j;
+        bool ascending = (left & k) == 0;
+
+        DrawEntry leftEntry = drawList[left];
+        DrawEntry rightEntry = drawList[right];
+        if (shouldSwap(leftEntry, rightEntry, ascending))
+        {
+            drawList[left] = rightEntry;
+            drawList[right] = leftEntry;
+        }
+        return;
+    }
+
+    uint localIndex = LocalInvocationID.x;
+    uint groupOffset = GroupID.x * LOCAL_SIZE;
+
+    for (uint i = localIndex; i < LOCAL_SIZE; i += GROUP_SIZE)
+    {
+        DrawEntry entry = drawList[groupOffset + i];
+        // First pass replaces the stale entries after the alive ones
+        if (pushConsts.stage == STAGE_LOCAL_SORT && groupOffset + i >= counters.Load(COUNTERS_VERTEX_COUNT))
+        {
+            entry.sortKey = SENTINEL_KEY;
+        }
+        localEntries[i] = entry;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (pushConsts.stage == STAGE_LOCAL_SORT)
+    {
+        for (uint kk = 2; kk <= LOCAL_SIZE; kk <<= 1)
+        {
+            for (uint jj = kk >> 1; jj > 0; jj >>= 1)
+            {
+                localStep(localIndex, groupOffset, kk, jj);
+            }
+        }
+    }
+    else
+    {
+        for (uint jj = LOCAL_SIZE >> 1; jj > 0; jj >>= 1)
+        {
+            localStep(localIndex, groupOffset, k, jj);
+        }
+    }
+
+    for (uint i = localIndex; i < LOCAL_SIZE; i += GROUP_SIZE)
+    {
+        drawList[groupOffset + i] = localEntries[i];
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef PARTICLE_TYPES_HLSL
+#define PARTICLE_TYPES_HLSL
+
+// Must match AssetParticleMesh.hpp
+
+struct Params {
+    int count;
+    float3 noiseMin;
+
+    float alpha;
+    float3 noiseMax;
+
+    float pointSize;
+    int textureIndex;
+    int sortByDepth;
+    int placeholder0;
+};
+
+struct Emitter {
+    float3 position;
+    uint emitCount;
+
+    float3 moveDirection;
+    uint isVisible;
+
+    float3 color;
+    float radius;
+
+    float minLife;
+    float maxLife;
+    float minSpeed;
+    float maxSpeed;
+
+    float sizeScale;
+    uint seed;
+    float placeholder0;
+    float placeholder1;
+};
+
+struct Particle {
+    float3 position;
+    float remainingLifeInSec;
+
+    float3 velocity;
+    float totalLifeInSec;
+
+    float3 color;
+    float alpha;
+
+    float pointSize;
+    int textureIndex;
+    uint emitterIndex;
+    float sizeScale;
+};
+
+struct DrawEntry {
+    float sortKey;
+    uint particleIndex;
+};
+
+// Byte offsets inside the counters buffer, First 16 bytes are VkDrawIndirectCommand and next 12 bytes are VkDispatchIndirectCommand
+#define COUNTERS_VERTEX_COUNT 0
+#define COUNTERS_INSTANCE_COUNT 4
+#define COUNTERS_FIRST_VERTEX 8
+#define COUNTERS_FIRST_INSTANCE 12
+#define COUNTERS_GROUP_COUNT_X 16
+#define COUNTERS_GROUP_COUNT_Y 20
+#define COUNTERS_GROUP_COUNT_Z 24
+#define COUNTERS_ALIVE_COUNT(list) (32 + (list) * 4)
+#define COUNTERS_DEAD_COUNT 40
+
+// Must match ParticleEssence::ComputePushConstants
+struct PushConsts {
+    uint currentList;
+    uint emitterCount;
+    uint capacity;
+    uint stage;
+
+    uint k;
+    uint j;
+    uint placeholder0;
+    uint placeholder1;
+};
+
+#define EMIT_GROUP_SIZE 64
+#define SIMULATION_GROUP_SIZE 256
+
+// PCG hash, Good enough to seed a particle from its emitter and thread index
+uint pcgHash(uint value)
+{
+    uint state = value * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+// Returns a number in the 0...1 range and advances the state
+float nextRandom(inout uint state)
+{
+    state = pcgHash(state);
+    return float(state >> 8) / 16777216.0f;
+}
+
+float nextRandom(inout uint state, float minimum, float maximum)
+{
+    return lerp(minimum, maximum, nextRandom(state));
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "Application.hpp"
 
 #include "engine/BedrockAssert.hpp"
+#include "engine/BedrockMemory.hpp"
 #include "engine/BedrockPath.hpp"
 #include "engine/InputManager.hpp"
 #include "engine/entity_system/EntitySystem.hpp"
@@ -36,9 +37,11 @@ Application::~Application() = default;
 
 void Application::Init() {
 
+    Log::Init();
     Path::Init();
     RC::Init();
     RF::Init(GetRenderFrontendInitParams());
+    Memory::Init(Memory::InitParams {.framesInFlight = RF::GetMaxFramesPerFlight()});
     JS::Init();
     UI::Init();
     IM::Init();
@@ -70,7 +73,9 @@ void Application::Shutdown() {
     UI::Shutdown();
     RC::Shutdown();
     RF::Shutdown();
+    Memory::Shutdown();
     Path::Shutdown();
+    Log::Shutdown();
 
     mIsInitialized = false;
 }
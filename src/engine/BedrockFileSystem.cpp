@@ -78,7 +78,7 @@ namespace MFA::FileSystem {
         return ret;    
     }
 
-    bool FileHandle::seek(const int offset, const Origin origin) const {
+    bool FileHandle::seek(const int64_t offset, const Origin origin) const {
         bool ret = false;
         if (isOk()) {
             int _origin {};
@@ -95,7 +95,12 @@ namespace MFA::FileSystem {
                 default:
                 MFA_CRASH("Invalid origin");
             }
-            int const seek_result = ::fseek(mFile, offset, _origin);
+            // Plain fseek takes a long, Which is 32 bit on windows
+        #if defined(__PLATFORM_WIN__)
+            int const seek_result = ::_fseeki64(mFile, offset, _origin);
+        #else
+            int const seek_result = ::fseeko(mFile, static_cast<off_t>(offset), _origin);
+        #endif
             ret = (0 == seek_result);
         }
         return ret;
@@ -108,7 +113,11 @@ namespace MFA::FileSystem {
     bool FileHandle::tell(int64_t & outLocation) const {
         bool success = false;
         if (isOk()) {
-            outLocation = ::ftell(mFile);
+        #if defined(__PLATFORM_WIN__)
+            outLocation = ::_ftelli64(mFile);
+        #else
+            outLocation = static_cast<int64_t>(::ftello(mFile));
+        #endif
             success = true;
         }
         return success;
@@ -206,7 +215,7 @@ namespace MFA::FileSystem {
     }
 
     [[nodiscard]]
-    bool AndroidAssetHandle::seek(const int offset, const Origin origin) const {
+    bool AndroidAssetHandle::seek(const int64_t offset, const Origin origin) const {
         bool success = false;
         if (isOk()) {
             int _origin {};
@@ -223,7 +232,7 @@ namespace MFA::FileSystem {
                 default:
                     MFA_CRASH("Invalid origin");
             }
-            auto const seekResult = AAsset_seek(mFile, offset, _origin);
+            auto const seekResult = AAsset_seek64(mFile, offset, _origin);
             success = (seekResult >= 0);
         }
         return success;
@@ -297,7 +306,7 @@ namespace MFA::FileSystem {
         return file != nullptr && file->isOk();
     }
 
-    bool Android_Seek(AndroidAssetHandle * file, int offset, Origin origin) {
+    bool Android_Seek(AndroidAssetHandle * file, int64_t offset, Origin origin) {
         return file != nullptr && file->seek(offset, origin);
     }
 
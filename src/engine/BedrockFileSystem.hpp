@@ -43,7 +43,7 @@ namespace MFA::FileSystem
         bool close();
 
         [[nodiscard]]
-        bool seek(const int offset, const Origin origin) const;
+        bool seek(const int64_t offset, const Origin origin) const;
 
         [[nodiscard]]
         bool seekToEnd() const;
@@ -93,7 +93,7 @@ namespace MFA::FileSystem
         bool close();
 
         [[nodiscard]]
-        bool seek(const int offset, const Origin origin) const;
+        bool seek(const int64_t offset, const Origin origin) const;
 
         [[nodiscard]]
         bool seekToEnd() const;
@@ -126,7 +126,7 @@ namespace MFA::FileSystem
     bool Android_AssetIsUsable(AndroidAssetHandle * file);
 
     [[nodiscard]]
-    bool Android_Seek(AndroidAssetHandle * file, int offset, Origin origin);
+    bool Android_Seek(AndroidAssetHandle * file, int64_t offset, Origin origin);
 
     [[nodiscard]]
     bool Android_Tell(AndroidAssetHandle * file, int64_t & outLocation);
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "engine/BedrockAssert.hpp"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace MFA
+{
+
+    template<typename Signature, size_t InlineSize = 48>
+    class SmallFunction;
+
+    // Same role as std::function, Callables up to InlineSize bytes are stored inside the object instead of the heap.
+    // Member function wrappers and lambdas with a few captures fit, So copying a listener does not allocate.
+    template<typename ReturnT, typename ... ArgsT, size_t InlineSize>
+    class SmallFunction<ReturnT(ArgsT...), InlineSize>
+    {
+    public:
+
+        SmallFunction() noexcept = default;
+
+        SmallFunction(std::nullptr_t) noexcept {}
+
+        template<
+            typename Callable,
+            typename = std::enable_if_t<
+                std::is_same_v<std::decay_t<Callable>, SmallFunction> == false &&
+                std::is_invocable_r_v<ReturnT, std::decay_t<Callable> &, ArgsT...>
+            >
+        >
+        SmallFunction(Callable && callable)
+        {
+            using Type = std::decay_t<Callable>;
+            if constexpr (std::is_constructible_v<bool, Type const &>)
+            {
+                // Empty std::function or null function pointer
+                if (static_cast<bool>(callable) == false)
+                {
+                    return;
+                }
+            }
+            if constexpr (IsStoredInline<Type>())
+            {
+                new (mStorage) Type(std::forward<Callable>(callable));
+                mVTable = &InlineVTable<Type>;
+            }
+            else
+            {
+                *reinterpret_cast<Type **>(mStorage) = new Type(std::forward<Callable>(callable));
+                mVTable = &HeapVTable<Type>;
+            }
+        }
+
+        SmallFunction(SmallFunction const & other)
+        {
+            if (other.mVTable != nullptr)
+            {
+                other.mVTable->copy(mStorage, other.mStorage);
+                mVTable = other.mVTable;
+            }
+        }
+
+        SmallFunction(SmallFunction && other) noexcept
+        {
+            if (other.mVTable != nullptr)
+            {
+                other.mVTable->move(mStorage, other.mStorage);
+                mVTable = other.mVTable;
+                other.reset();
+            }
+        }
+
+        SmallFunction & operator = (SmallFunction const & other)
+        {
+            if (this != &other)
+            {
+                SmallFunction copy {other};
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        SmallFunction & operator = (SmallFunction && other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                if (other.mVTable != nullptr)
+                {
+                    other.mVTable->move(mStorage, other.mStorage);
+                    mVTable = other.mVTable;
+                    other.reset();
+                }
+            }
+            return *this;
+        }
+
+        ~SmallFunction()
+        {
+            reset();
+        }
+
+        ReturnT operator()(ArgsT ... args) const
+        {
+            MFA_ASSERT(mVTable != nullptr);
+            return mVTable->invoke(const_cast<std::byte *>(mStorage), std::forward<ArgsT>(args)...);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return mVTable != nullptr;
+        }
+
+        bool operator == (std::nullptr_t) const noexcept
+        {
+            return mVTable == nullptr;
+        }
+
+        bool operator != (std::nullptr_t) const noexcept
+        {
+            return mVTable != nullptr;
+        }
+
+        // True when the callable is stored inside the object
+        [[nodiscard]]
+        bool IsInline() const noexcept
+        {
+            return mVTable != nullptr && mVTable->isInline;
+        }
+
+        template<typename Callable>
+        static constexpr bool IsStoredInline()
+        {
+            return sizeof(Callable) <= InlineSize &&
+                alignof(Callable) <= alignof(std::max_align_t) &&
+                std::is_nothrow_move_constructible_v<Callable>;
+        }
+
+    private:
+
+        struct VTable
+        {
+            ReturnT (*invoke)(std::byte * storage, ArgsT && ... args);
+            void (*copy)(std::byte * destination, std::byte const * source);
+            void (*move)(std::byte * destination, std::byte * source);     // Source is destroyed by the caller
+            void (*destroy)(std::byte * storage);
+            bool isInline;
+        };
+
+        template<typename Callable>
+        static constexpr VTable InlineVTable {
+            .invoke = [](std::byte * storage, ArgsT && ... args)->ReturnT
+            {
+                return (*std::launder(reinterpret_cast<Callable *>(storage)))(std::forward<ArgsT>(args)...);
+            },
+            .copy = [](std::byte * destination, std::byte const * source)->void
+            {
+                new (destination) Callable(*std::launder(reinterpret_cast<Callable const *>(source)));
+            },
+            .move = [](std::byte * destination, std::byte * source)->void
+            {
+                new (destination) Callable(std::move(*std::launder(reinterpret_cast<Callable *>(source))));
+            },
+            .destroy = [](std::byte * storage)->void
+            {
+                std::launder(reinterpret_cast<Callable *>(storage))->~Callable();
+            },
+            .isInline = true
+        };
+
+        template<typename Callable>
+        static constexpr VTable HeapVTable {
+            .invoke = [](std::byte * storage, ArgsT && ... args)->ReturnT
+            {
+                return (**reinterpret_cast<Callable **>(storage))(std::forward<ArgsT>(args)...);
+            },
+            .copy = [](std::byte * destination, std::byte const * source)->void
+            {
+                *reinterpret_cast<Callable **>(destination) = new Callable(**reinterpret_cast<Callable * const *>(source));
+            },
+            .move = [](std::byte * destination, std::byte * source)->void
+            {
+                // Pointer is taken over, Destroy of the source must not delete it
+                auto ** sourcePointer = reinterpret_cast<Callable **>(source);
+                *reinterpret_cast<Callable **>(destination) = *sourcePointer;
+                *sourcePointer = nullptr;
+            },
+            .destroy = [](std::byte * storage)->void
+            {
+                delete *reinterpret_cast<Callable **>(storage);
+            },
+            .isInline = false
+        };
+
+        void reset() noexcept
+        {
+            if (mVTable != nullptr)
+            {
+                mVTable->destroy(mStorage);
+                mVTable = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) std::byte mStorage[InlineSize] {};
+
+        VTable const * mVTable = nullptr;
+
+    };
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "BedrockCommon.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Stable (platform and run independent) hash functions. Use these when the result is stored on disk.
+namespace MFA::Hash
+{
+
+    static constexpr uint64_t FnvOffsetBasis = 14695981039346656037ull;
+    static constexpr uint64_t FnvPrime = 1099511628211ull;
+
+    [[nodiscard]]
+    inline uint64_t Fnv1a(CBlob const data, uint64_t hash = FnvOffsetBasis)
+    {
+        for (size_t i = 0; i < data.len; ++i)
+        {
+            hash ^= static_cast<uint64_t>(data.ptr[i]);
+            hash *= FnvPrime;
+        }
+        return hash;
+    }
+
+    // Same bytes give the same hash as the blob version, Can be used at compile time
+    [[nodiscard]]
+    constexpr uint64_t Fnv1a(std::string_view const text, uint64_t hash = FnvOffsetBasis)
+    {
+        for (auto const character : text)
+        {
+            hash ^= static_cast<uint64_t>(static_cast<uint8_t>(character));
+            hash *= FnvPrime;
+        }
+        return hash;
+    }
+
+    // Only use for types without padding
+    template<typename T>
+    [[nodiscard]]
+    uint64_t Combine(uint64_t const hash, T const & value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return Fnv1a(CBlobAliasOf(value), hash);
+    }
+
+}
@@ -0,0 +1,1164 @@
+#include "BedrockLog.hpp"
+
+#include "BedrockAssert.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace MFA::Log
+{
+
+    namespace Internal
+    {
+        std::atomic<uint32_t> EnabledMask {0xFFFFFFFFu};
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Header of each message inside a ring buffer, Arguments follow it
+    struct RecordHeader
+    {
+        Site * site = nullptr;                      // Nullptr marks the skipped end of the ring
+        uint64_t timestampNs = 0;
+        uint32_t size = 0;                          // Header and arguments, Multiple of RecordAlignment
+        uint32_t argsSize = 0;
+        uint32_t suppressedCount = 0;
+        uint32_t padding = 0;
+    };
+
+    static constexpr uint32_t RecordAlignment = 8;
+
+    static_assert(sizeof(RecordHeader) % RecordAlignment == 0);
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Single producer single consumer ring, The owner thread writes and the log thread reads
+    struct ThreadBuffer
+    {
+        explicit ThreadBuffer(uint32_t const capacity_)
+            : memory(new uint8_t[capacity_])
+            , capacity(capacity_)
+        {}
+
+        std::unique_ptr<uint8_t[]> const memory;        // Not cleared, Pages are touched only when the thread logs
+        uint32_t const capacity;
+        uint32_t threadIndex = 0;
+
+        alignas(64) std::atomic<uint64_t> head {};      // Written by the owner thread
+        uint64_t cachedTail = 0;                        // Owner thread copy of tail, Refreshed only when the ring looks full
+        uint64_t pendingHead = 0;                       // End of the message that owner thread is writing
+
+        alignas(64) std::atomic<uint64_t> tail {};      // Written by the log thread
+        uint64_t reportedDropCount = 0;                 // Log thread only
+
+        std::atomic<uint64_t> dropCount {};
+        std::atomic<bool> isThreadAlive {true};
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    struct ThreadState
+    {
+        ~ThreadState()
+        {
+            if (buffer != nullptr)
+            {
+                buffer->isThreadAlive.store(false, std::memory_order_release);
+            }
+        }
+
+        std::shared_ptr<ThreadBuffer> buffer {};
+        uint32_t generation = 0;
+
+        // Messages that are formatted on the calling thread
+        std::vector<uint8_t> scratch {};
+        uint32_t scratchSuppressedCount = 0;
+        bool isWritingToScratch = false;
+    };
+
+    static thread_local ThreadState threadState {};
+
+    //-------------------------------------------------------------------------------------------------
+
+    struct State
+    {
+        InitParams params {};
+
+        std::atomic<bool> isRunning {false};
+        std::atomic<uint32_t> generation {1};
+
+        std::atomic<uint32_t> rateLimitCount {32};
+        std::atomic<uint32_t> rateLimitWindowMs {1000};
+
+        std::mutex buffersMutex {};
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers {};
+        std::vector<std::shared_ptr<ThreadBuffer>> freeBuffers {};     // Drained buffers of finished threads
+        uint32_t nextThreadIndex = 0;
+
+        std::thread thread {};
+        std::mutex wakeMutex {};
+        std::condition_variable wakeCondition {};
+        std::condition_variable flushCondition {};
+        std::atomic<uint64_t> flushRequest {};
+        std::atomic<uint64_t> flushCompleted {};
+        bool isStopRequested = false;
+
+        // Log thread only
+        FILE * binaryFile = nullptr;
+        std::unordered_map<Site const *, uint32_t> siteIds {};
+
+        std::mutex textMutex {};
+
+        std::atomic<uint64_t> droppedCount {};
+    };
+
+    static State state {};
+
+    //-------------------------------------------------------------------------------------------------
+
+    static constexpr char BinaryFileMagic[8] = {'M', 'F', 'A', 'L', 'O', 'G', '0', '1'};
+
+    enum class BinaryRecordType : uint8_t
+    {
+        Site = 1,
+        Message = 2,
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    static uint64_t NowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static uint32_t AlignRecordSize(size_t const size)
+    {
+        return static_cast<uint32_t>((size + RecordAlignment - 1) & ~static_cast<size_t>(RecordAlignment - 1));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static uint32_t NextPowerOfTwo(uint32_t const value)
+    {
+        uint32_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Returns false when the site already wrote its share of messages in the current window
+    static bool PassRateLimit(Site & site, uint64_t const timestampNs, uint32_t & outSuppressedCount)
+    {
+        outSuppressedCount = 0;
+
+        auto const limit = state.rateLimitCount.load(std::memory_order_relaxed);
+        if (limit == 0)
+        {
+            return true;
+        }
+
+        auto const nowMs = static_cast<int64_t>(timestampNs / 1000000);
+        auto windowStartMs = site.windowStartMs.load(std::memory_order_relaxed);
+        if (nowMs - windowStartMs >= static_cast<int64_t>(state.rateLimitWindowMs.load(std::memory_order_relaxed)))
+        {
+            if (site.windowStartMs.compare_exchange_strong(windowStartMs, nowMs, std::memory_order_relaxed))
+            {
+                site.windowCount.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        if (site.windowCount.fetch_add(1, std::memory_order_relaxed) >= limit)
+        {
+            site.suppressedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        outSuppressedCount = site.suppressedCount.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void WriteText(
+        Severity const severity,
+        char const * file,
+        int const line,
+        char const * function,
+        std::string const & text,
+        uint32_t const suppressedCount
+    )
+    {
+        auto * textFile = state.params.textFile;
+        if (textFile == nullptr)
+        {
+            return;
+        }
+
+        std::string suppressedText {};
+        if (suppressedCount > 0)
+        {
+            suppressedText = "(" + std::to_string(suppressedCount) + " similar messages were suppressed)\n";
+        }
+
+#ifdef __ANDROID__
+        if (textFile == stdout)
+        {
+            static constexpr android_LogPriority Priorities[] {
+                ANDROID_LOG_DEBUG,
+                ANDROID_LOG_INFO,
+                ANDROID_LOG_WARN,
+                ANDROID_LOG_ERROR
+            };
+            __android_log_print(
+                Priorities[static_cast<int>(severity)],
+                "MFA",
+                "\n-----------%s------------\nFile: %s\nLine: %d\nFunction: %s\n%s\n%s---------------------------\n",
+                SeverityName(severity),
+                file,
+                line,
+                function,
+                text.c_str(),
+                suppressedText.c_str()
+            );
+            return;
+        }
+#endif
+
+        fprintf(
+            textFile,
+            "\n-----------%s------------\nFile: %s\nLine: %d\nFunction: %s\n%s\n%s---------------------------\n",
+            SeverityName(severity),
+            file,
+            line,
+            function,
+            text.c_str(),
+            suppressedText.c_str()
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void WriteBinary(void const * data, size_t const size)
+    {
+        fwrite(data, 1, size, state.binaryFile);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void WriteBinaryString(char const * string)
+    {
+        auto const size = static_cast<uint32_t>(strlen(string));
+        WriteBinary(&size, sizeof(size));
+        WriteBinary(string, size);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Sites are written once, Messages only refer to them by id
+    static uint32_t GetBinarySiteId(Site const & site)
+    {
+        auto const findResult = state.siteIds.find(&site);
+        if (findResult != state.siteIds.end())
+        {
+            return findResult->second;
+        }
+
+        auto const siteId = static_cast<uint32_t>(state.siteIds.size());
+        state.siteIds[&site] = siteId;
+
+        auto const recordType = BinaryRecordType::Site;
+        WriteBinary(&recordType, sizeof(recordType));
+        WriteBinary(&siteId, sizeof(siteId));
+        WriteBinary(&site.severity, sizeof(site.severity));
+        WriteBinary(&site.category, sizeof(site.category));
+        auto const line = static_cast<int32_t>(site.line);
+        WriteBinary(&line, sizeof(line));
+        WriteBinaryString(site.file);
+        WriteBinaryString(site.function);
+        WriteBinaryString(site.format);
+
+        return siteId;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Binary output keeps the arguments encoded, Formatting happens only when the file is read
+    static void WriteBinaryMessage(RecordHeader const & header, uint32_t const threadIndex, uint8_t const * args)
+    {
+        auto const siteId = GetBinarySiteId(*header.site);
+
+        auto const recordType = BinaryRecordType::Message;
+        WriteBinary(&recordType, sizeof(recordType));
+        WriteBinary(&siteId, sizeof(siteId));
+        WriteBinary(&header.timestampNs, sizeof(header.timestampNs));
+        WriteBinary(&threadIndex, sizeof(threadIndex));
+        WriteBinary(&header.suppressedCount, sizeof(header.suppressedCount));
+        WriteBinary(&header.argsSize, sizeof(header.argsSize));
+        WriteBinary(args, header.argsSize);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    struct PendingRecord
+    {
+        RecordHeader const * header = nullptr;
+        uint32_t threadIndex = 0;
+    };
+
+    // Runs on the log thread, Messages of all threads are written in timestamp order
+    static void Drain()
+    {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers {};
+        {
+            std::lock_guard lock {state.buffersMutex};
+            buffers = state.buffers;
+        }
+
+        static thread_local std::vector<PendingRecord> pendingRecords {};
+        pendingRecords.clear();
+
+        std::vector<uint64_t> heads(buffers.size());
+        for (size_t i = 0; i < buffers.size(); ++i)
+        {
+            auto & buffer = *buffers[i];
+            auto const head = buffer.head.load(std::memory_order_acquire);
+            auto tail = buffer.tail.load(std::memory_order_relaxed);
+            heads[i] = head;
+
+            while (tail < head)
+            {
+                auto const offset = static_cast<uint32_t>(tail & (buffer.capacity - 1));
+                auto const contiguousSize = buffer.capacity - offset;
+                if (contiguousSize < sizeof(RecordHeader))
+                {
+                    tail += contiguousSize;
+                    continue;
+                }
+                auto const * header = reinterpret_cast<RecordHeader const *>(buffer.memory.get() + offset);
+                if (header->site != nullptr)
+                {
+                    pendingRecords.emplace_back(PendingRecord {
+                        .header = header,
+                        .threadIndex = buffer.threadIndex
+                    });
+                }
+                tail += header->size;
+            }
+        }
+
+        std::stable_sort(pendingRecords.begin(), pendingRecords.end(), [](PendingRecord const & a, PendingRecord const & b)->bool
+        {
+            return a.header->timestampNs < b.header->timestampNs;
+        });
+
+        for (auto const & record : pendingRecords)
+        {
+            auto const & header = *record.header;
+            auto const * args = reinterpret_cast<uint8_t const *>(&header + 1);
+            auto const & site = *header.site;
+
+            if (state.params.textFile != nullptr)
+            {
+                WriteText(
+                    site.severity,
+                    site.file,
+                    site.line,
+                    site.function,
+                    Internal::FormatArgs(site.format, args, header.argsSize),
+                    header.suppressedCount
+                );
+            }
+            if (state.binaryFile != nullptr)
+            {
+                WriteBinaryMessage(header, record.threadIndex, args);
+            }
+        }
+
+        for (size_t i = 0; i < buffers.size(); ++i)
+        {
+            auto & buffer = *buffers[i];
+            buffer.tail.store(heads[i], std::memory_order_release);
+
+            auto const dropCount = buffer.dropCount.load(std::memory_order_relaxed);
+            if (dropCount != buffer.reportedDropCount && state.params.textFile != nullptr)
+            {
+                fprintf(
+                    state.params.textFile,
+                    "\n%llu log messages of thread %u were dropped, Ring buffer is full\n",
+                    static_cast<unsigned long long>(dropCount - buffer.reportedDropCount),
+                    buffer.threadIndex
+                );
+            }
+            buffer.reportedDropCount = dropCount;
+        }
+
+        if (state.params.textFile != nullptr)
+        {
+            fflush(state.params.textFile);
+        }
+        if (state.binaryFile != nullptr)
+        {
+            fflush(state.binaryFile);
+        }
+
+        // Buffers of finished threads are reused once they are empty, Short lived threads do not allocate a new ring each time
+        {
+            std::lock_guard lock {state.buffersMutex};
+            for (size_t i = 0; i < state.buffers.size();)
+            {
+                auto & buffer = state.buffers[i];
+                if (
+                    buffer->isThreadAlive.load(std::memory_order_acquire) == false &&
+                    buffer->tail.load(std::memory_order_relaxed) == buffer->head.load(std::memory_order_acquire)
+                )
+                {
+                    state.freeBuffers.emplace_back(std::move(buffer));
+                    buffer = std::move(state.buffers.back());
+                    state.buffers.pop_back();
+                    continue;
+                }
+                ++i;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void LogThreadMain()
+    {
+        while (true)
+        {
+            bool isStopRequested = false;
+            {
+                std::unique_lock lock {state.wakeMutex};
+                state.wakeCondition.wait_for(lock, std::chrono::milliseconds(state.params.flushIntervalMs), []()->bool
+                {
+                    return state.isStopRequested ||
+                        state.flushRequest.load(std::memory_order_relaxed) != state.flushCompleted.load(std::memory_order_relaxed);
+                });
+                isStopRequested = state.isStopRequested;
+            }
+
+            // Request is read before draining, So every message written before it was made is drained
+            auto const flushRequest = state.flushRequest.load(std::memory_order_acquire);
+            Drain();
+            {
+                std::lock_guard lock {state.wakeMutex};
+                state.flushCompleted.store(flushRequest, std::memory_order_release);
+            }
+            state.flushCondition.notify_all();
+
+            if (isStopRequested)
+            {
+                break;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static ThreadBuffer * GetThreadBuffer()
+    {
+        auto const generation = state.generation.load(std::memory_order_acquire);
+        if (threadState.buffer == nullptr || threadState.generation != generation)
+        {
+            std::lock_guard lock {state.buffersMutex};
+            if (state.freeBuffers.empty() == false)
+            {
+                threadState.buffer = std::move(state.freeBuffers.back());
+                state.freeBuffers.pop_back();
+                threadState.buffer->cachedTail = threadState.buffer->tail.load(std::memory_order_acquire);
+                threadState.buffer->isThreadAlive.store(true, std::memory_order_relaxed);
+            }
+            else
+            {
+                threadState.buffer = std::make_shared<ThreadBuffer>(
+                    NextPowerOfTwo(std::max<uint32_t>(state.params.bufferSizePerThread, 4 * 1024))
+                );
+            }
+            threadState.buffer->threadIndex = state.nextThreadIndex++;
+            threadState.generation = generation;
+            state.buffers.emplace_back(threadState.buffer);
+        }
+        return threadState.buffer.get();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Init(InitParams const & params)
+    {
+        MFA_ASSERT(state.isRunning == false);
+
+        state.params = params;
+        state.isStopRequested = false;
+        state.siteIds.clear();
+
+        if (params.binaryFilePath.empty() == false)
+        {
+            state.binaryFile = fopen(params.binaryFilePath.c_str(), "wb");
+            if (state.binaryFile != nullptr)
+            {
+                WriteBinary(BinaryFileMagic, sizeof(BinaryFileMagic));
+            }
+        }
+
+        state.thread = std::thread(LogThreadMain);
+        state.isRunning.store(true, std::memory_order_release);
+
+        if (params.binaryFilePath.empty() == false && state.binaryFile == nullptr)
+        {
+            MFA_LOG_WARN("Failed to open binary log file %s", params.binaryFilePath.c_str());
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Shutdown()
+    {
+        MFA_ASSERT(state.isRunning == true);
+
+        state.isRunning.store(false, std::memory_order_release);
+        {
+            std::lock_guard lock {state.wakeMutex};
+            state.isStopRequested = true;
+        }
+        state.wakeCondition.notify_one();
+        state.thread.join();
+
+        if (state.binaryFile != nullptr)
+        {
+            fclose(state.binaryFile);
+            state.binaryFile = nullptr;
+        }
+
+        {
+            std::lock_guard lock {state.buffersMutex};
+            state.buffers.clear();
+            state.freeBuffers.clear();
+            state.nextThreadIndex = 0;
+        }
+        // Threads create new buffers after the next init
+        state.generation.fetch_add(1, std::memory_order_acq_rel);
+
+        state.params.textFile = stdout;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool IsRunning()
+    {
+        return state.isRunning.load(std::memory_order_acquire);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Flush()
+    {
+        if (IsRunning() == false)
+        {
+            return;
+        }
+
+        std::unique_lock lock {state.wakeMutex};
+        auto const flushRequest = state.flushRequest.fetch_add(1, std::memory_order_acq_rel) + 1;
+        state.wakeCondition.notify_one();
+        state.flushCondition.wait(lock, [flushRequest]()->bool
+        {
+            return state.flushCompleted.load(std::memory_order_acquire) >= flushRequest ||
+                state.isRunning.load(std::memory_order_acquire) == false;
+        });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SetMinSeverity(Severity const severity)
+    {
+        uint32_t severityMask = 0;
+        for (auto i = static_cast<uint32_t>(severity); i < static_cast<uint32_t>(Severity::Count); ++i)
+        {
+            severityMask |= 1u << i;
+        }
+
+        static constexpr uint32_t AllSeverities = (1u << Internal::CategoryBitOffset) - 1;
+        auto mask = Internal::EnabledMask.load(std::memory_order_relaxed);
+        while (Internal::EnabledMask.compare_exchange_weak(
+            mask,
+            (mask & ~AllSeverities) | severityMask,
+            std::memory_order_relaxed
+        ) == false) {}
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SetCategoryEnabled(Category const category, bool const enabled)
+    {
+        auto const bit = 1u << (Internal::CategoryBitOffset + static_cast<uint32_t>(category));
+        if (enabled)
+        {
+            Internal::EnabledMask.fetch_or(bit, std::memory_order_relaxed);
+        }
+        else
+        {
+            Internal::EnabledMask.fetch_and(~bit, std::memory_order_relaxed);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SetRateLimit(uint32_t const messageCount, uint32_t const windowMs)
+    {
+        state.rateLimitWindowMs.store(std::max<uint32_t>(windowMs, 1), std::memory_order_relaxed);
+        state.rateLimitCount.store(messageCount, std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint64_t GetDroppedCount()
+    {
+        return state.droppedCount.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    char const * SeverityName(Severity const severity)
+    {
+        switch (severity)
+        {
+            case Severity::Debug:
+                return "DEBUG";
+            case Severity::Info:
+                return "INFO";
+            case Severity::Warning:
+                return "WARN";
+            case Severity::Error:
+                return "ERROR";
+            default:
+                return "UNKNOWN";
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    char const * CategoryName(Category const category)
+    {
+        switch (category)
+        {
+            case Category::General:
+                return "General";
+            case Category::Render:
+                return "Render";
+            case Category::Asset:
+                return "Asset";
+            case Category::Entity:
+                return "Entity";
+            case Category::Physics:
+                return "Physics";
+            case Category::Job:
+                return "Job";
+            default:
+                return "Unknown";
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    namespace Internal
+    {
+
+        uint8_t * BeginMessage(Site & site, size_t const argsSize)
+        {
+            auto const timestampNs = NowNs();
+            uint32_t suppressedCount = 0;
+            if (PassRateLimit(site, timestampNs, suppressedCount) == false)
+            {
+                return nullptr;
+            }
+
+            if (IsRunning() == false)
+            {
+                threadState.isWritingToScratch = true;
+                threadState.scratchSuppressedCount = suppressedCount;
+                threadState.scratch.resize(argsSize);
+                return threadState.scratch.data();
+            }
+            threadState.isWritingToScratch = false;
+
+            auto & buffer = *GetThreadBuffer();
+
+            auto const recordSize = AlignRecordSize(sizeof(RecordHeader) + argsSize);
+            if (recordSize > buffer.capacity / 2)
+            {
+                buffer.dropCount.fetch_add(1, std::memory_order_relaxed);
+                state.droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            // Record never wraps, The rest of the ring is skipped instead
+            auto head = buffer.head.load(std::memory_order_relaxed);
+            auto const offset = static_cast<uint32_t>(head & (buffer.capacity - 1));
+            auto const contiguousSize = buffer.capacity - offset;
+            auto const skipSize = recordSize > contiguousSize ? contiguousSize : 0;
+
+            auto const requiredSize = skipSize + recordSize;
+            if (head + requiredSize - buffer.cachedTail > buffer.capacity)
+            {
+                buffer.cachedTail = buffer.tail.load(std::memory_order_acquire);
+                if (head + requiredSize - buffer.cachedTail > buffer.capacity)
+                {
+                    buffer.dropCount.fetch_add(1, std::memory_order_relaxed);
+                    state.droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+            }
+
+            if (skipSize > 0)
+            {
+                if (skipSize >= sizeof(RecordHeader))
+                {
+                    auto * skipHeader = reinterpret_cast<RecordHeader *>(buffer.memory.get() + offset);
+                    *skipHeader = RecordHeader {.size = skipSize};
+                }
+                head += skipSize;
+            }
+
+            auto * header = reinterpret_cast<RecordHeader *>(buffer.memory.get() + (head & (buffer.capacity - 1)));
+            *header = RecordHeader {
+                .site = &site,
+                .timestampNs = timestampNs,
+                .size = recordSize,
+                .argsSize = static_cast<uint32_t>(argsSize),
+                .suppressedCount = suppressedCount,
+            };
+            buffer.pendingHead = head + recordSize;
+
+            return reinterpret_cast<uint8_t *>(header + 1);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void EndMessage(Site & site)
+        {
+            if (threadState.isWritingToScratch)
+            {
+                std::lock_guard lock {state.textMutex};
+                WriteText(
+                    site.severity,
+                    site.file,
+                    site.line,
+                    site.function,
+                    FormatArgs(site.format, threadState.scratch.data(), threadState.scratch.size()),
+                    threadState.scratchSuppressedCount
+                );
+                return;
+            }
+
+            auto & buffer = *threadState.buffer;
+            buffer.head.store(buffer.pendingHead, std::memory_order_release);
+
+            // Errors are usually followed by an assert, They have to reach the output first
+            if (site.severity == Severity::Error)
+            {
+                Flush();
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        class ArgReader
+        {
+        public:
+
+            explicit ArgReader(uint8_t const * args, size_t const argsSize)
+                : mArgs(args)
+                , mEnd(args + argsSize)
+            {}
+
+            bool Next(ArgType & outType, uint64_t & outBits, std::string_view & outString)
+            {
+                if (mArgs == nullptr || mArgs >= mEnd)
+                {
+                    return false;
+                }
+                outType = static_cast<ArgType>(*mArgs);
+                ++mArgs;
+                if (outType == ArgType::String)
+                {
+                    uint32_t size = 0;
+                    std::memcpy(&size, mArgs, sizeof(size));
+                    mArgs += sizeof(size);
+                    outString = std::string_view(reinterpret_cast<char const *>(mArgs), size);
+                    mArgs += size;
+                }
+                else
+                {
+                    std::memcpy(&outBits, mArgs, sizeof(outBits));
+                    mArgs += sizeof(outBits);
+                }
+                return true;
+            }
+
+        private:
+
+            uint8_t const * mArgs;
+            uint8_t const * mEnd;
+
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        static int64_t AsInt(ArgType const type, uint64_t const bits)
+        {
+            if (type == ArgType::Double)
+            {
+                double number = 0.0;
+                std::memcpy(&number, &bits, sizeof(number));
+                return static_cast<int64_t>(number);
+            }
+            return static_cast<int64_t>(bits);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        static double AsDouble(ArgType const type, uint64_t const bits)
+        {
+            if (type == ArgType::Double)
+            {
+                double number = 0.0;
+                std::memcpy(&number, &bits, sizeof(number));
+                return number;
+            }
+            if (type == ArgType::Int)
+            {
+                return static_cast<double>(static_cast<int64_t>(bits));
+            }
+            return static_cast<double>(bits);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        // Each conversion is formatted on its own by snprintf, Length modifiers are replaced by the stored 64 bit types
+        std::string FormatArgs(char const * format, uint8_t const * args, size_t const argsSize)
+        {
+            std::string result {};
+            if (format == nullptr)
+            {
+                return result;
+            }
+
+            ArgReader reader {args, argsSize};
+            ArgType type {};
+            uint64_t bits = 0;
+            std::string_view string {};
+
+            char spec[32] {};
+            char number[64] {};
+
+            auto const appendFormatted = [&result](char const * specFormat, auto const value)->void
+            {
+                char buffer[128] {};
+                auto const length = snprintf(buffer, sizeof(buffer), specFormat, value);
+                if (length < 0)
+                {
+                    return;
+                }
+                if (static_cast<size_t>(length) < sizeof(buffer))
+                {
+                    result.append(buffer, length);
+                    return;
+                }
+                std::string large(static_cast<size_t>(length) + 1, '\0');
+                snprintf(large.data(), large.size(), specFormat, value);
+                result.append(large.data(), length);
+            };
+
+            char const * cursor = format;
+            while (*cursor != '\0')
+            {
+                if (*cursor != '%')
+                {
+                    auto const * next = strchr(cursor, '%');
+                    if (next == nullptr)
+                    {
+                        result.append(cursor);
+                        break;
+                    }
+                    result.append(cursor, next - cursor);
+                    cursor = next;
+                    continue;
+                }
+
+                if (cursor[1] == '%')
+                {
+                    result.push_back('%');
+                    cursor += 2;
+                    continue;
+                }
+
+                // Flags, Width and precision are kept, Stars are replaced by their argument
+                size_t specSize = 0;
+                spec[specSize++] = '%';
+                ++cursor;
+                while (*cursor != '\0' && strchr("-+ #0", *cursor) != nullptr && specSize < 8)
+                {
+                    spec[specSize++] = *cursor++;
+                }
+                for (int part = 0; part < 2; ++part)
+                {
+                    if (part == 1)
+                    {
+                        if (*cursor != '.')
+                        {
+                            break;
+                        }
+                        spec[specSize++] = *cursor++;
+                    }
+                    if (*cursor == '*')
+                    {
+                        ++cursor;
+                        int64_t starValue = 0;
+                        if (reader.Next(type, bits, string))
+                        {
+                            starValue = AsInt(type, bits);
+                        }
+                        auto const length = snprintf(number, sizeof(number), "%d", static_cast<int>(starValue));
+                        for (int i = 0; i < length && specSize < 24; ++i)
+                        {
+                            spec[specSize++] = number[i];
+                        }
+                    }
+                    while (*cursor >= '0' && *cursor <= '9')
+                    {
+                        if (specSize < 24)
+                        {
+                            spec[specSize++] = *cursor;
+                        }
+                        ++cursor;
+                    }
+                }
+                while (*cursor != '\0' && strchr("hlLqjzt", *cursor) != nullptr)
+                {
+                    ++cursor;
+                }
+
+                auto const conversion = *cursor;
+                if (conversion == '\0')
+                {
+                    break;
+                }
+                ++cursor;
+
+                if (reader.Next(type, bits, string) == false)
+                {
+                    result.append("<missing>");
+                    continue;
+                }
+
+                switch (conversion)
+                {
+                    case 'd':
+                    case 'i':
+                    {
+                        spec[specSize++] = 'l';
+                        spec[specSize++] = 'l';
+                        spec[specSize++] = conversion;
+                        spec[specSize] = '\0';
+                        appendFormatted(spec, static_cast<long long>(AsInt(type, bits)));
+                    }
+                    break;
+                    case 'u':
+                    case 'x':
+                    case 'X':
+                    case 'o':
+                    {
+                        spec[specSize++] = 'l';
+                        spec[specSize++] = 'l';
+                        spec[specSize++] = conversion;
+                        spec[specSize] = '\0';
+                        appendFormatted(spec, static_cast<unsigned long long>(AsInt(type, bits)));
+                    }
+                    break;
+                    case 'c':
+                    {
+                        spec[specSize++] = conversion;
+                        spec[specSize] = '\0';
+                        appendFormatted(spec, static_cast<int>(AsInt(type, bits)));
+                    }
+                    break;
+                    case 'f':
+                    case 'F':
+                    case 'e':
+                    case 'E':
+                    case 'g':
+                    case 'G':
+                    case 'a':
+                    case 'A':
+                    {
+                        spec[specSize++] = conversion;
+                        spec[specSize] = '\0';
+                        appendFormatted(spec, AsDouble(type, bits));
+                    }
+                    break;
+                    case 's':
+                    {
+                        if (type != ArgType::String)
+                        {
+                            result.append("<invalid>");
+                            break;
+                        }
+                        // Strings are not null terminated inside the record
+                        std::string const value {string};
+                        spec[specSize++] = conversion;
+                        spec[specSize] = '\0';
+                        appendFormatted(spec, value.c_str());
+                    }
+                    break;
+                    case 'p':
+                    {
+                        spec[specSize++] = conversion;
+                        spec[specSize] = '\0';
+                        appendFormatted(spec, reinterpret_cast<void const *>(static_cast<uintptr_t>(bits)));
+                    }
+                    break;
+                    default:
+                    {
+                        result.push_back('%');
+                        result.push_back(conversion);
+                    }
+                    break;
+                }
+            }
+
+            return result;
+        }
+
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static bool ReadBinary(FILE * file, void * data, size_t const size)
+    {
+        return fread(data, 1, size, file) == size;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static bool ReadBinaryString(FILE * file, std::string & outString)
+    {
+        uint32_t size = 0;
+        if (ReadBinary(file, &size, sizeof(size)) == false)
+        {
+            return false;
+        }
+        outString.resize(size);
+        return size == 0 || ReadBinary(file, outString.data(), size);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool ReadBinaryFile(std::string const & path, std::function<void(Message const &)> const & listener)
+    {
+        struct BinarySite
+        {
+            Severity severity {};
+            Category category {};
+            int32_t line = 0;
+            std::string file {};
+            std::string function {};
+            std::string format {};
+        };
+
+        auto * file = fopen(path.c_str(), "rb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        bool success = true;
+        char magic[sizeof(BinaryFileMagic)] {};
+        if (ReadBinary(file, magic, sizeof(magic)) == false || std::memcmp(magic, BinaryFileMagic, sizeof(magic)) != 0)
+        {
+            success = false;
+        }
+
+        std::vector<BinarySite> sites {};
+        std::vector<uint8_t> args {};
+        Message message {};
+
+        while (success)
+        {
+            BinaryRecordType recordType {};
+            if (ReadBinary(file, &recordType, sizeof(recordType)) == false)
+            {
+                break;
+            }
+
+            if (recordType == BinaryRecordType::Site)
+            {
+                uint32_t siteId = 0;
+                BinarySite site {};
+                success = ReadBinary(file, &siteId, sizeof(siteId)) &&
+                    ReadBinary(file, &site.severity, sizeof(site.severity)) &&
+                    ReadBinary(file, &site.category, sizeof(site.category)) &&
+                    ReadBinary(file, &site.line, sizeof(site.line)) &&
+                    ReadBinaryString(file, site.file) &&
+                    ReadBinaryString(file, site.function) &&
+                    ReadBinaryString(file, site.format) &&
+                    siteId == sites.size();
+                if (success)
+                {
+                    sites.emplace_back(std::move(site));
+                }
+            }
+            else if (recordType == BinaryRecordType::Message)
+            {
+                uint32_t siteId = 0;
+                uint32_t argsSize = 0;
+                success = ReadBinary(file, &siteId, sizeof(siteId)) &&
+                    ReadBinary(file, &message.timestampNs, sizeof(message.timestampNs)) &&
+                    ReadBinary(file, &message.threadIndex, sizeof(message.threadIndex)) &&
+                    ReadBinary(file, &message.suppressedCount, sizeof(message.suppressedCount)) &&
+                    ReadBinary(file, &argsSize, sizeof(argsSize)) &&
+                    siteId < sites.size();
+                if (success)
+                {
+                    args.resize(argsSize);
+                    success = argsSize == 0 || ReadBinary(file, args.data(), argsSize);
+                }
+                if (success)
+                {
+                    auto const & site = sites[siteId];
+                    message.severity = site.severity;
+                    message.category = site.category;
+                    message.file = site.file;
+                    message.line = site.line;
+                    message.function = site.function;
+                    message.text = Internal::FormatArgs(site.format.c_str(), args.data(), args.size());
+                    listener(message);
+                }
+            }
+            else
+            {
+                success = false;
+            }
+        }
+
+        fclose(file);
+        return success;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
@@ -7,30 +7,313 @@
 #include <android_native_app_glue.h>
 #endif
 
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
 #include <string>
+#include <type_traits>
+#include <vector>
+
+// Messages are written into a ring buffer of the calling thread and formatted later by the log thread.
+// Only the arguments are copied, File, line, function and format live in a static Site of each call.
+// Before Log::Init and after Log::Shutdown messages are formatted and printed on the calling thread.
+#define MFA_LOG(severity_, category_, fmt_, ...)                                                                        \
+    do                                                                                                                  \
+    {                                                                                                                   \
+        if (MFA::Log::IsEnabled(MFA::Log::Severity::severity_, MFA::Log::Category::category_))                         \
+        {                                                                                                               \
+            static MFA::Log::Site mfaLogSite_ {                                                                         \
+                MFA::Log::Severity::severity_,                                                                          \
+                MFA::Log::Category::category_,                                                                          \
+                __FILE__,                                                                                               \
+                __LINE__,                                                                                               \
+                __FUNCTION__,                                                                                           \
+                fmt_                                                                                                    \
+            };                                                                                                          \
+            MFA::Log::Write(mfaLogSite_, ##__VA_ARGS__);                                                                \
+        }                                                                                                               \
+    } while (false)
 
 #ifdef MFA_DEBUG
-    #if defined(__DESKTOP__) || defined(__IOS__)
-        #define MFA_LOG_DEBUG(fmt_, ...)                printf("\n-----------DEBUG------------\nFile: %s\nLine: %d\nFunction: %s\n" # fmt_, __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__)
-    #elif defined(__ANDROID__)
-        #define MFA_LOG_DEBUG(fmt_, ...)                __android_log_print(ANDROID_LOG_DEBUG, "MFA", "\n-----------DEBUG------------\nFile: %s\nLine: %d\nFunction: %s\n" # fmt_, __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__)
-    #else
-        #error Os is not supported
-    #endif
+    #define MFA_LOG_DEBUG(fmt_, ...)                    MFA_LOG(Debug, General, fmt_, ##__VA_ARGS__)
 #else
-#define MFA_LOG_DEBUG(fmt_, ...)                         
+    #define MFA_LOG_DEBUG(fmt_, ...)
 #endif
 
 #if defined(__DESKTOP__) || defined(__IOS__)
-    #define MFA_LOG_INFO(fmt_, ...)                     printf("\n-----------INFO------------\nFile: %s\nLine: %d\nFunction: %s\n" #fmt_ "\n---------------------------\n", __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__)
-    #define MFA_LOG_WARN(fmt_, ...)                     printf("\n-----------WARN------------\nFile: %s\nLine: %d\nFunction: %s\n" #fmt_ "\n---------------------------\n", __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__)
-    #define MFA_LOG_ERROR(fmt_, ...)                    printf("\n-----------ERROR------------\nFile: %s\nLine: %d\nFunction: %s\n" #fmt_ "\n---------------------------\n", __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__); MFA_ASSERT(false)
+    #define MFA_LOG_INFO(fmt_, ...)                     MFA_LOG(Info, General, fmt_, ##__VA_ARGS__)
+    #define MFA_LOG_WARN(fmt_, ...)                     MFA_LOG(Warning, General, fmt_, ##__VA_ARGS__)
+    #define MFA_LOG_ERROR(fmt_, ...)                    MFA_LOG(Error, General, fmt_, ##__VA_ARGS__); MFA_ASSERT(false)
 #elif defined(__ANDROID__)
-    #define MFA_LOG_INFO(fmt_, ...)                     __android_log_print(ANDROID_LOG_INFO, "MFA", "\n-----------INFO------------\nFile: %s\nLine: %d\nFunction: %s\n" #fmt_ "\n---------------------------\n", __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__)
-    #define MFA_LOG_WARN(fmt_, ...)                     __android_log_print(ANDROID_LOG_WARN, "MFA", "\n-----------WARN------------\nFile: %s\nLine: %d\nFunction: %s\n" #fmt_ "\n---------------------------\n", __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__)
-    #define MFA_LOG_ERROR(fmt_, ...)                    __android_log_print(ANDROID_LOG_ERROR, "MFA", "\n-----------ERROR------------\nFile: %s\nLine: %d\nFunction: %s\n" #fmt_ "\n---------------------------\n", __FILE__, __LINE__, __FUNCTION__, ##__VA_ARGS__)
+    #define MFA_LOG_INFO(fmt_, ...)                     MFA_LOG(Info, General, fmt_, ##__VA_ARGS__)
+    #define MFA_LOG_WARN(fmt_, ...)                     MFA_LOG(Warning, General, fmt_, ##__VA_ARGS__)
+    #define MFA_LOG_ERROR(fmt_, ...)                    MFA_LOG(Error, General, fmt_, ##__VA_ARGS__)
 #else
     #error Os is not supported
 #endif
 
-namespace MFA::Log {} // MFA::Log
+namespace MFA::Log
+{
+
+    enum class Severity : uint8_t
+    {
+        Debug = 0,
+        Info = 1,
+        Warning = 2,
+        Error = 3,
+        Count
+    };
+
+    enum class Category : uint8_t
+    {
+        General = 0,
+        Render = 1,
+        Asset = 2,
+        Entity = 3,
+        Physics = 4,
+        Job = 5,
+        Count
+    };
+
+    // Static data of a single MFA_LOG call
+    struct Site
+    {
+        Severity const severity;
+        Category const category;
+        char const * const file;
+        int const line;
+        char const * const function;
+        char const * const format;
+
+        // Rate limit state, Shared by all threads that reach this call
+        std::atomic<int64_t> windowStartMs {};
+        std::atomic<uint32_t> windowCount {};
+        std::atomic<uint32_t> suppressedCount {};
+    };
+
+    struct InitParams
+    {
+        FILE * textFile = stdout;                   // Nullptr disables the text output
+        std::string binaryFilePath {};              // Empty path disables the binary output
+        uint32_t bufferSizePerThread = 256 * 1024;  // Rounded up to a power of two, Messages are dropped when it is full
+        uint32_t flushIntervalMs = 5;
+    };
+
+    // Message read back from a binary log file
+    struct Message
+    {
+        Severity severity = Severity::Info;
+        Category category = Category::General;
+        std::string file {};
+        int line = 0;
+        std::string function {};
+        std::string text {};
+        uint64_t timestampNs = 0;
+        uint32_t threadIndex = 0;
+        uint32_t suppressedCount = 0;
+    };
+
+    void Init(InitParams const & params = InitParams {});
+
+    // Writes every pending message before returning
+    void Shutdown();
+
+    [[nodiscard]]
+    bool IsRunning();
+
+    // Blocks until messages that this thread wrote so far are written by the log thread
+    void Flush();
+
+    void SetMinSeverity(Severity severity);
+
+    void SetCategoryEnabled(Category category, bool enabled);
+
+    // A call site writes at most messageCount messages per window, The rest are counted and reported with the next message
+    // Zero messageCount disables the limit, Default is 32 messages per second
+    void SetRateLimit(uint32_t messageCount, uint32_t windowMs = 1000);
+
+    // Messages that did not fit into a full ring buffer
+    [[nodiscard]]
+    uint64_t GetDroppedCount();
+
+    [[nodiscard]]
+    char const * SeverityName(Severity severity);
+
+    [[nodiscard]]
+    char const * CategoryName(Category category);
+
+    // Calls the listener for every message of the file in order, Returns false if the file is missing or corrupted
+    bool ReadBinaryFile(std::string const & path, std::function<void(Message const &)> const & listener);
+
+    namespace Internal
+    {
+
+        // Bit per severity followed by a bit per category
+        extern std::atomic<uint32_t> EnabledMask;
+
+        static constexpr uint32_t CategoryBitOffset = 8;
+
+        static constexpr uint32_t MaxStringSize = 8 * 1024;
+
+        enum class ArgType : uint8_t
+        {
+            Int = 0,
+            UInt = 1,
+            Double = 2,
+            String = 3,
+            Pointer = 4,
+        };
+
+        template<typename T>
+        struct AlwaysFalse : std::false_type {};
+
+        template<typename T>
+        constexpr ArgType TypeOf()
+        {
+            using Type = std::decay_t<T>;
+            if constexpr (std::is_same_v<Type, char *> || std::is_same_v<Type, char const *>)
+            {
+                return ArgType::String;
+            }
+            else if constexpr (std::is_pointer_v<Type> || std::is_null_pointer_v<Type>)
+            {
+                return ArgType::Pointer;
+            }
+            else if constexpr (std::is_floating_point_v<Type>)
+            {
+                return ArgType::Double;
+            }
+            else if constexpr (std::is_enum_v<Type>)
+            {
+                return TypeOf<std::underlying_type_t<Type>>();
+            }
+            else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+            {
+                return ArgType::Int;
+            }
+            else if constexpr (std::is_integral_v<Type>)
+            {
+                return ArgType::UInt;
+            }
+            else
+            {
+                static_assert(AlwaysFalse<Type>::value, "Argument type cannot be logged");
+                return ArgType::Int;
+            }
+        }
+
+        inline uint32_t StringSize(char const * string)
+        {
+            if (string == nullptr)
+            {
+                return 0;
+            }
+            auto const size = strnlen(string, MaxStringSize);
+            return static_cast<uint32_t>(size);
+        }
+
+        // Strings are stored as size and characters, Everything else as 8 bytes
+        template<typename T>
+        size_t ArgSize(T const & value)
+        {
+            if constexpr (TypeOf<T>() == ArgType::String)
+            {
+                return 1 + sizeof(uint32_t) + StringSize(value);
+            }
+            else
+            {
+                return 1 + sizeof(uint64_t);
+            }
+        }
+
+        template<typename T>
+        uint8_t * WriteArg(uint8_t * destination, T const & value)
+        {
+            constexpr auto type = TypeOf<T>();
+            *destination = static_cast<uint8_t>(type);
+            ++destination;
+
+            if constexpr (type == ArgType::String)
+            {
+                char const * string = value;
+                auto const size = StringSize(string);
+                std::memcpy(destination, &size, sizeof(size));
+                if (size > 0)
+                {
+                    std::memcpy(destination + sizeof(size), string, size);
+                }
+                return destination + sizeof(size) + size;
+            }
+            else
+            {
+                uint64_t bits = 0;
+                if constexpr (type == ArgType::Pointer)
+                {
+                    bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+                }
+                else if constexpr (type == ArgType::Double)
+                {
+                    auto const number = static_cast<double>(value);
+                    std::memcpy(&bits, &number, sizeof(number));
+                }
+                else if constexpr (type == ArgType::Int)
+                {
+                    auto const number = static_cast<int64_t>(value);
+                    std::memcpy(&bits, &number, sizeof(number));
+                }
+                else
+                {
+                    bits = static_cast<uint64_t>(value);
+                }
+                std::memcpy(destination, &bits, sizeof(bits));
+                return destination + sizeof(bits);
+            }
+        }
+
+        // Returns where the arguments should be written, Nullptr means that the message is dropped or rate limited
+        [[nodiscard]]
+        uint8_t * BeginMessage(Site & site, size_t argsSize);
+
+        void EndMessage(Site & site);
+
+        // Printf like formatting of the encoded arguments
+        [[nodiscard]]
+        std::string FormatArgs(char const * format, uint8_t const * args, size_t argsSize);
+
+    }
+
+    [[nodiscard]]
+    inline bool IsEnabled(Severity const severity, Category const category)
+    {
+        auto const mask = Internal::EnabledMask.load(std::memory_order_relaxed);
+        return (mask & (1u << static_cast<uint32_t>(severity))) != 0 &&
+            (mask & (1u << (Internal::CategoryBitOffset + static_cast<uint32_t>(category)))) != 0;
+    }
+
+    template<typename ... Args>
+    void Write(Site & site, Args const & ... args)
+    {
+        size_t const argsSize = (size_t {0} + ... + Internal::ArgSize(args));
+        auto * destination = Internal::BeginMessage(site, argsSize);
+        if (destination == nullptr)
+        {
+            return;
+        }
+        ((destination = Internal::WriteArg(destination, args)), ...);
+        Internal::EndMessage(site);
+    }
+
+    // Same result as the log thread produces for the given format and arguments
+    template<typename ... Args>
+    [[nodiscard]]
+    std::string Format(char const * format, Args const & ... args)
+    {
+        std::vector<uint8_t> encoded((size_t {0} + ... + Internal::ArgSize(args)));
+        [[maybe_unused]] auto * destination = encoded.data();
+        ((destination = Internal::WriteArg(destination, args)), ...);
+        return Internal::FormatArgs(format, encoded.data(), encoded.size());
+    }
+
+} // MFA::Log
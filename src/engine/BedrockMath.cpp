@@ -0,0 +1,403 @@
+#include "BedrockMath.hpp"
+
+#include "BedrockAssert.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+
+#if defined(ENABLE_SIMD) && (defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64))
+#include <immintrin.h>
+#elif defined(ENABLE_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace MFA::Math
+{
+
+    struct RandomSeedState
+    {
+        // Thread generators compare their epoch with this one to know that they have to be reseeded
+        std::atomic<uint64_t> epoch = 1;
+        std::atomic<uint64_t> seed = 0;
+        std::atomic<bool> isDeterministic = false;
+        std::atomic<uint32_t> nextStream = 0;
+    };
+
+    static RandomSeedState SeedState {};
+
+    struct ThreadRandomState
+    {
+        RandomGenerator generator {};
+        uint64_t epoch = 0;
+    };
+
+    static thread_local ThreadRandomState ThreadState {};
+
+    // Below this count lanes cost more to seed than they save
+    static constexpr size_t MinBatchCount = 4 * RandomLaneCount;
+
+    // Unit vectors and disk samples are made from chunks of uniform values that stay in the cache
+    static constexpr size_t ChunkSize = 256;
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RandomGenerator::Jump()
+    {
+        static constexpr uint32_t JumpTable[] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+
+        uint32_t s0 = 0;
+        uint32_t s1 = 0;
+        uint32_t s2 = 0;
+        uint32_t s3 = 0;
+        for (auto const jump : JumpTable)
+        {
+            for (int bit = 0; bit < 32; ++bit)
+            {
+                if ((jump & (1u << bit)) != 0)
+                {
+                    s0 ^= state[0];
+                    s1 ^= state[1];
+                    s2 ^= state[2];
+                    s3 ^= state[3];
+                }
+                [[maybe_unused]] auto const value = NextUInt();
+            }
+        }
+        state[0] = s0;
+        state[1] = s1;
+        state[2] = s2;
+        state[3] = s3;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    RandomGenerator & GetRandomGenerator()
+    {
+        auto & threadState = ThreadState;
+        auto const epoch = SeedState.epoch.load(std::memory_order_acquire);
+        if (threadState.epoch != epoch)
+        {
+            if (SeedState.isDeterministic.load(std::memory_order_relaxed))
+            {
+                auto const stream = SeedState.nextStream.fetch_add(1, std::memory_order_relaxed);
+                threadState.generator.Seed(SeedState.seed.load(std::memory_order_relaxed));
+                for (uint32_t i = 0; i < stream; ++i)
+                {
+                    threadState.generator.Jump();
+                }
+            }
+            else
+            {
+                std::random_device device {};
+                threadState.generator.Seed((static_cast<uint64_t>(device()) << 32) | device());
+            }
+            threadState.epoch = epoch;
+        }
+        return threadState.generator;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SetRandomSeed(uint64_t const seed)
+    {
+        SeedState.seed.store(seed, std::memory_order_relaxed);
+        SeedState.isDeterministic.store(true, std::memory_order_relaxed);
+        SeedState.nextStream.store(0, std::memory_order_relaxed);
+        SeedState.epoch.fetch_add(1, std::memory_order_release);
+        [[maybe_unused]] auto & generator = GetRandomGenerator();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ClearRandomSeed()
+    {
+        SeedState.isDeterministic.store(false, std::memory_order_relaxed);
+        SeedState.epoch.fetch_add(1, std::memory_order_release);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // xoshiro128+ state of every lane, Stored as struct of arrays so one register holds the same word of several lanes
+    struct RandomLanes
+    {
+        alignas(32) uint32_t s0[RandomLaneCount];
+        alignas(32) uint32_t s1[RandomLaneCount];
+        alignas(32) uint32_t s2[RandomLaneCount];
+        alignas(32) uint32_t s3[RandomLaneCount];
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Each lane is seeded from the parent generator, So the parent advances and the next batch is different
+    static void SeedLanes(RandomGenerator & generator, RandomLanes & outLanes)
+    {
+        for (int lane = 0; lane < RandomLaneCount; ++lane)
+        {
+            auto const seed = (static_cast<uint64_t>(generator.NextUInt()) << 32) | generator.NextUInt();
+            RandomGenerator const laneGenerator {seed};
+            outLanes.s0[lane] = laneGenerator.state[0];
+            outLanes.s1[lane] = laneGenerator.state[1];
+            outLanes.s2[lane] = laneGenerator.state[2];
+            outLanes.s3[lane] = laneGenerator.state[3];
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Writes blockCount * RandomLaneCount values in [min, max), Value i of each block comes from lane i
+    static void NextFloats(
+        RandomLanes & lanes,
+        float * outValues,
+        size_t const blockCount,
+        float const min,
+        float const max
+    )
+    {
+        auto const scale = (max - min) * 0x1.0p-24f;
+
+#if defined(ENABLE_SIMD) && defined(__AVX2__)
+
+        auto s0 = _mm256_load_si256(reinterpret_cast<__m256i const *>(lanes.s0));
+        auto s1 = _mm256_load_si256(reinterpret_cast<__m256i const *>(lanes.s1));
+        auto s2 = _mm256_load_si256(reinterpret_cast<__m256i const *>(lanes.s2));
+        auto s3 = _mm256_load_si256(reinterpret_cast<__m256i const *>(lanes.s3));
+        auto const scaleVar = _mm256_set1_ps(scale);
+        auto const minVar = _mm256_set1_ps(min);
+
+        for (size_t block = 0; block < blockCount; ++block)
+        {
+            auto const result = _mm256_add_epi32(s0, s3);
+            auto const t = _mm256_slli_epi32(s1, 9);
+            s2 = _mm256_xor_si256(s2, s0);
+            s3 = _mm256_xor_si256(s3, s1);
+            s1 = _mm256_xor_si256(s1, s2);
+            s0 = _mm256_xor_si256(s0, s3);
+            s2 = _mm256_xor_si256(s2, t);
+            s3 = _mm256_or_si256(_mm256_slli_epi32(s3, 11), _mm256_srli_epi32(s3, 21));
+
+            auto const value = _mm256_cvtepi32_ps(_mm256_srli_epi32(result, 8));
+            _mm256_storeu_ps(outValues + block * RandomLaneCount, _mm256_add_ps(_mm256_mul_ps(value, scaleVar), minVar));
+        }
+
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes.s0), s0);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes.s1), s1);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes.s2), s2);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes.s3), s3);
+
+#elif defined(ENABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+
+        auto const scaleVar = _mm_set1_ps(scale);
+        auto const minVar = _mm_set1_ps(min);
+
+        // Two registers cover the eight lanes
+        for (int half = 0; half < RandomLaneCount; half += 4)
+        {
+            auto s0 = _mm_load_si128(reinterpret_cast<__m128i const *>(lanes.s0 + half));
+            auto s1 = _mm_load_si128(reinterpret_cast<__m128i const *>(lanes.s1 + half));
+            auto s2 = _mm_load_si128(reinterpret_cast<__m128i const *>(lanes.s2 + half));
+            auto s3 = _mm_load_si128(reinterpret_cast<__m128i const *>(lanes.s3 + half));
+
+            for (size_t block = 0; block < blockCount; ++block)
+            {
+                auto const result = _mm_add_epi32(s0, s3);
+                auto const t = _mm_slli_epi32(s1, 9);
+                s2 = _mm_xor_si128(s2, s0);
+                s3 = _mm_xor_si128(s3, s1);
+                s1 = _mm_xor_si128(s1, s2);
+                s0 = _mm_xor_si128(s0, s3);
+                s2 = _mm_xor_si128(s2, t);
+                s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+
+                auto const value = _mm_cvtepi32_ps(_mm_srli_epi32(result, 8));
+                _mm_storeu_ps(outValues + block * RandomLaneCount + half, _mm_add_ps(_mm_mul_ps(value, scaleVar), minVar));
+            }
+
+            _mm_store_si128(reinterpret_cast<__m128i *>(lanes.s0 + half), s0);
+            _mm_store_si128(reinterpret_cast<__m128i *>(lanes.s1 + half), s1);
+            _mm_store_si128(reinterpret_cast<__m128i *>(lanes.s2 + half), s2);
+            _mm_store_si128(reinterpret_cast<__m128i *>(lanes.s3 + half), s3);
+        }
+
+#elif defined(ENABLE_SIMD) && defined(__ARM_NEON)
+
+        auto const scaleVar = vdupq_n_f32(scale);
+        auto const minVar = vdupq_n_f32(min);
+
+        for (int half = 0; half < RandomLaneCount; half += 4)
+        {
+            auto s0 = vld1q_u32(lanes.s0 + half);
+            auto s1 = vld1q_u32(lanes.s1 + half);
+            auto s2 = vld1q_u32(lanes.s2 + half);
+            auto s3 = vld1q_u32(lanes.s3 + half);
+
+            for (size_t block = 0; block < blockCount; ++block)
+            {
+                auto const result = vaddq_u32(s0, s3);
+                auto const t = vshlq_n_u32(s1, 9);
+                s2 = veorq_u32(s2, s0);
+                s3 = veorq_u32(s3, s1);
+                s1 = veorq_u32(s1, s2);
+                s0 = veorq_u32(s0, s3);
+                s2 = veorq_u32(s2, t);
+                s3 = vorrq_u32(vshlq_n_u32(s3, 11), vshrq_n_u32(s3, 21));
+
+                auto const value = vcvtq_f32_u32(vshrq_n_u32(result, 8));
+                vst1q_f32(outValues + block * RandomLaneCount + half, vaddq_f32(vmulq_f32(value, scaleVar), minVar));
+            }
+
+            vst1q_u32(lanes.s0 + half, s0);
+            vst1q_u32(lanes.s1 + half, s1);
+            vst1q_u32(lanes.s2 + half, s2);
+            vst1q_u32(lanes.s3 + half, s3);
+        }
+
+#else
+
+        for (size_t block = 0; block < blockCount; ++block)
+        {
+            for (int lane = 0; lane < RandomLaneCount; ++lane)
+            {
+                auto const result = lanes.s0[lane] + lanes.s3[lane];
+                auto const t = lanes.s1[lane] << 9;
+                lanes.s2[lane] ^= lanes.s0[lane];
+                lanes.s3[lane] ^= lanes.s1[lane];
+                lanes.s1[lane] ^= lanes.s2[lane];
+                lanes.s0[lane] ^= lanes.s3[lane];
+                lanes.s2[lane] ^= t;
+                lanes.s3[lane] = (lanes.s3[lane] << 11) | (lanes.s3[lane] >> 21);
+
+                outValues[block * RandomLaneCount + lane] = static_cast<float>(result >> 8) * scale + min;
+            }
+        }
+
+#endif
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Points on the unit circle at angle 2 * Pi * value, Uniform values give uniform points.
+    // First half of the range is mapped to [-Pi / 2, Pi / 2) where Taylor series of sine and cosine are accurate to
+    // about 1e-7, Second half is the same angle rotated by Pi. No calls and no branches, So the loop can be vectorized.
+    static void UnitCircle(float const * values, size_t const count, float * outCos, float * outSin)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto const doubled = 2.0f * values[i];
+            auto const half = static_cast<float>(static_cast<int>(doubled));
+            auto const sign = 1.0f - 2.0f * half;
+            auto const angle = PiFloat * (doubled - half - 0.5f);
+            auto const sqr = angle * angle;
+
+            auto const sine = angle * (1.0f + sqr * (-1.0f / 6.0f + sqr * (1.0f / 120.0f + sqr * (-1.0f / 5040.0f
+                + sqr * (1.0f / 362880.0f + sqr * (-1.0f / 39916800.0f))))));
+            auto const cosine = 1.0f + sqr * (-1.0f / 2.0f + sqr * (1.0f / 24.0f + sqr * (-1.0f / 720.0f
+                + sqr * (1.0f / 40320.0f + sqr * (-1.0f / 3628800.0f + sqr * (1.0f / 479001600.0f))))));
+            outCos[i] = sign * cosine;
+            outSin[i] = sign * sine;
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void FillRandom(
+        RandomGenerator & generator,
+        float * outValues,
+        size_t const count,
+        float const min,
+        float const max
+    )
+    {
+        MFA_ASSERT(outValues != nullptr || count == 0);
+
+        size_t filledCount = 0;
+        if (count >= MinBatchCount)
+        {
+            RandomLanes lanes {};
+            SeedLanes(generator, lanes);
+            auto const blockCount = count / RandomLaneCount;
+            NextFloats(lanes, outValues, blockCount, min, max);
+            filledCount = blockCount * RandomLaneCount;
+        }
+
+        for (auto i = filledCount; i < count; ++i)
+        {
+            outValues[i] = generator.NextFloat(min, max);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void FillRandom(float * outValues, size_t const count, float const min, float const max)
+    {
+        FillRandom(GetRandomGenerator(), outValues, count, min, max);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void FillRandomUnitVectors(RandomGenerator & generator, glm::vec3 * outVectors, size_t const count)
+    {
+        MFA_ASSERT(outVectors != nullptr || count == 0);
+
+        // Archimedes: Height is uniform in [-1, 1] and angle around the height axis is uniform
+        float heights[ChunkSize];
+        float angles[ChunkSize];
+        float cosines[ChunkSize];
+        float sines[ChunkSize];
+        for (size_t first = 0; first < count; first += ChunkSize)
+        {
+            auto const chunkCount = std::min(ChunkSize, count - first);
+            FillRandom(generator, heights, chunkCount, -1.0f, 1.0f);
+            FillRandom(generator, angles, chunkCount, 0.0f, 1.0f);
+            UnitCircle(angles, chunkCount, cosines, sines);
+            for (size_t i = 0; i < chunkCount; ++i)
+            {
+                auto const z = heights[i];
+                auto const radius = std::sqrt(std::max(0.0f, 1.0f - z * z));
+                outVectors[first + i] = glm::vec3 {radius * cosines[i], radius * sines[i], z};
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void FillRandomUnitVectors(glm::vec3 * outVectors, size_t const count)
+    {
+        FillRandomUnitVectors(GetRandomGenerator(), outVectors, count);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void FillRandomInDisk(RandomGenerator & generator, glm::vec2 * outPoints, size_t const count, float const radius)
+    {
+        MFA_ASSERT(outPoints != nullptr || count == 0);
+
+        // Square root of the distance keeps the density uniform over the area
+        float distances[ChunkSize];
+        float angles[ChunkSize];
+        float cosines[ChunkSize];
+        float sines[ChunkSize];
+        for (size_t first = 0; first < count; first += ChunkSize)
+        {
+            auto const chunkCount = std::min(ChunkSize, count - first);
+            FillRandom(generator, distances, chunkCount, 0.0f, 1.0f);
+            FillRandom(generator, angles, chunkCount, 0.0f, 1.0f);
+            UnitCircle(angles, chunkCount, cosines, sines);
+            for (size_t i = 0; i < chunkCount; ++i)
+            {
+                auto const distance = radius * std::sqrt(distances[i]);
+                outPoints[first + i] = glm::vec2 {distance * cosines[i], distance * sines[i]};
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void FillRandomInDisk(glm::vec2 * outPoints, size_t const count, float const radius)
+    {
+        FillRandomInDisk(GetRandomGenerator(), outPoints, count, radius);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
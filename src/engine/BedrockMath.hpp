@@ -2,9 +2,12 @@
 
 #include <glm/vec4.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vec2.hpp>
 
-#include <cstdlib>
-#include <random>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 
 namespace MFA::Math
 {
@@ -80,21 +83,112 @@ namespace MFA::Math
         return std::numeric_limits<genType>::infinity();
     }
 
+    // xoshiro128+ (Blackman and Vigna). Floats are made from the upper 24 bits, So the weak low bits are never used.
+    // Small enough to keep one per thread or one per job for reproducible parallel work.
+    class RandomGenerator
+    {
+    public:
+
+        explicit RandomGenerator(uint64_t const seed = 0)
+        {
+            Seed(seed);
+        }
+
+        // State is expanded from the seed with SplitMix64, So similar seeds give unrelated sequences
+        void Seed(uint64_t seed)
+        {
+            for (int i = 0; i < 4; i += 2)
+            {
+                auto const value = SplitMix64(seed);
+                state[i] = static_cast<uint32_t>(value);
+                state[i + 1] = static_cast<uint32_t>(value >> 32);
+            }
+        }
+
+        [[nodiscard]]
+        uint32_t NextUInt()
+        {
+            auto const result = state[0] + state[3];
+            auto const t = state[1] << 9;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = (state[3] << 11) | (state[3] >> 21);
+            return result;
+        }
+
+        // [0, 1)
+        [[nodiscard]]
+        float NextFloat()
+        {
+            return static_cast<float>(NextUInt() >> 8) * 0x1.0p-24f;
+        }
+
+        // [min, max)
+        [[nodiscard]]
+        float NextFloat(float const min, float const max)
+        {
+            return NextFloat() * (max - min) + min;
+        }
+
+        // Same as 2^64 calls to NextUInt, Used to give each thread a stream that never overlaps the others
+        void Jump();
+
+        [[nodiscard]]
+        static uint64_t SplitMix64(uint64_t & inOutState)
+        {
+            auto z = (inOutState += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        uint32_t state[4] {};
+
+    };
+
+    // Generator of the calling thread, Created on first use.
+    // By default each thread is seeded from std::random_device. After SetRandomSeed, Threads get jumped streams of
+    // that seed in the order they first ask for their generator, So runs are reproducible as long as that order is.
+    [[nodiscard]]
+    RandomGenerator & GetRandomGenerator();
+
+    // Deterministic mode, Calling thread gets the first stream and other threads are reseeded on their next use.
+    // Must not be called while other threads are drawing numbers.
+    void SetRandomSeed(uint64_t seed);
+
+    // Back to seeding from std::random_device
+    void ClearRandomSeed();
+
     template<typename T>
     T Random(T min, T max)
     {
         float const fMin = static_cast<float>(min);
         float const fMax = static_cast<float>(max);
-        float value = (static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX))
-           * (fMax - fMin) + fMin;
-        return static_cast<T>(value);
-
-        // For some strange reason this implementation breaks the particle fire
-        //static std::uniform_real_distribution<T> distribution(min, max);
-        //static std::mt19937 generator {};
-        //return distribution(generator);
+        return static_cast<T>(GetRandomGenerator().NextFloat(fMin, fMax));
     }
 
+    // Batch fills draw several independent lanes at once (AVX2, SSE2 or NEON).
+    // Lane count is the same on every target, So a seed gives the same values with and without SIMD.
+    static constexpr int RandomLaneCount = 8;
+
+    // Uniform in [min, max)
+    void FillRandom(RandomGenerator & generator, float * outValues, size_t count, float min = 0.0f, float max = 1.0f);
+
+    void FillRandom(float * outValues, size_t count, float min = 0.0f, float max = 1.0f);
+
+    // Uniform on the unit sphere
+    void FillRandomUnitVectors(RandomGenerator & generator, glm::vec3 * outVectors, size_t count);
+
+    void FillRandomUnitVectors(glm::vec3 * outVectors, size_t count);
+
+    // Uniform inside a disk on XY plane
+    void FillRandomInDisk(RandomGenerator & generator, glm::vec2 * outPoints, size_t count, float radius = 1.0f);
+
+    void FillRandomInDisk(glm::vec2 * outPoints, size_t count, float radius = 1.0f);
+
     [[nodiscard]]
     inline float ACosSafe(float const value)
     {
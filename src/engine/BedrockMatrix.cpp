@@ -3,6 +3,17 @@
 #include "BedrockAssert.hpp"
 #include "BedrockCommon.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#if defined(ENABLE_SIMD) && (defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64))
+#include <immintrin.h>
+#elif defined(ENABLE_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace MFA::Matrix
 {
 
@@ -293,4 +304,520 @@ namespace MFA::Matrix
     
     //-------------------------------------------------------------------------------------------------
 
+    // Four float lanes that the kernels below are written with, Each backend only has to provide these few operations
+
+#if defined(ENABLE_SIMD) && (defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64))
+
+    using Float4 = __m128;
+
+    static Float4 Load(float const * values) { return _mm_loadu_ps(values); }
+    static void Store(float * values, Float4 const value) { _mm_storeu_ps(values, value); }
+    static Float4 Splat(float const value) { return _mm_set1_ps(value); }
+    static Float4 Set(float const x, float const y, float const z, float const w) { return _mm_setr_ps(x, y, z, w); }
+    static Float4 Add(Float4 const a, Float4 const b) { return _mm_add_ps(a, b); }
+    static Float4 Sub(Float4 const a, Float4 const b) { return _mm_sub_ps(a, b); }
+    static Float4 Mul(Float4 const a, Float4 const b) { return _mm_mul_ps(a, b); }
+    static Float4 Abs(Float4 const value) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+
+    // a * b + c
+    static Float4 MulAdd(Float4 const a, Float4 const b, Float4 const c)
+    {
+#if defined(__FMA__)
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+    }
+
+    template<int Lane>
+    static Float4 Broadcast(Float4 const value) { return _mm_shuffle_ps(value, value, _MM_SHUFFLE(Lane, Lane, Lane, Lane)); }
+
+    // Lanes become y, z, x, w
+    static Float4 ShuffleYZX(Float4 const value) { return _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 2, 1)); }
+
+    static float HorizontalSum(Float4 const value)
+    {
+        auto const sum = _mm_add_ps(value, _mm_movehl_ps(value, value));
+        return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    static void Transpose(Float4 & row0, Float4 & row1, Float4 & row2, Float4 & row3)
+    {
+        _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    }
+
+#elif defined(ENABLE_SIMD) && defined(__ARM_NEON)
+
+    using Float4 = float32x4_t;
+
+    static Float4 Load(float const * values) { return vld1q_f32(values); }
+    static void Store(float * values, Float4 const value) { vst1q_f32(values, value); }
+    static Float4 Splat(float const value) { return vdupq_n_f32(value); }
+    static Float4 Add(Float4 const a, Float4 const b) { return vaddq_f32(a, b); }
+    static Float4 Sub(Float4 const a, Float4 const b) { return vsubq_f32(a, b); }
+    static Float4 Mul(Float4 const a, Float4 const b) { return vmulq_f32(a, b); }
+    static Float4 Abs(Float4 const value) { return vabsq_f32(value); }
+
+    static Float4 Set(float const x, float const y, float const z, float const w)
+    {
+        float const values[4] {x, y, z, w};
+        return vld1q_f32(values);
+    }
+
+    // a * b + c
+    static Float4 MulAdd(Float4 const a, Float4 const b, Float4 const c)
+    {
+#if defined(__aarch64__)
+        return vfmaq_f32(c, a, b);
+#else
+        return vmlaq_f32(c, a, b);
+#endif
+    }
+
+    template<int Lane>
+    static Float4 Broadcast(Float4 const value) { return vdupq_n_f32(vgetq_lane_f32(value, Lane)); }
+
+    // Lanes become y, z, x, x. Callers ignore the last lane.
+    static Float4 ShuffleYZX(Float4 const value)
+    {
+        return vsetq_lane_f32(vgetq_lane_f32(value, 0), vextq_f32(value, value, 1), 2);
+    }
+
+    static float HorizontalSum(Float4 const value)
+    {
+        auto const sum = vadd_f32(vget_low_f32(value), vget_high_f32(value));
+        return vget_lane_f32(vpadd_f32(sum, sum), 0);
+    }
+
+    static void Transpose(Float4 & row0, Float4 & row1, Float4 & row2, Float4 & row3)
+    {
+        auto const row01 = vtrnq_f32(row0, row1);
+        auto const row23 = vtrnq_f32(row2, row3);
+        row0 = vcombine_f32(vget_low_f32(row01.val[0]), vget_low_f32(row23.val[0]));
+        row1 = vcombine_f32(vget_low_f32(row01.val[1]), vget_low_f32(row23.val[1]));
+        row2 = vcombine_f32(vget_high_f32(row01.val[0]), vget_high_f32(row23.val[0]));
+        row3 = vcombine_f32(vget_high_f32(row01.val[1]), vget_high_f32(row23.val[1]));
+    }
+
+#else
+
+    struct Float4
+    {
+        float lanes[4];
+    };
+
+    template<typename Operation>
+    static Float4 ForEachLane(Float4 const a, Float4 const b, Operation const & operation)
+    {
+        return Float4 {{
+            operation(a.lanes[0], b.lanes[0]),
+            operation(a.lanes[1], b.lanes[1]),
+            operation(a.lanes[2], b.lanes[2]),
+            operation(a.lanes[3], b.lanes[3])
+        }};
+    }
+
+    static Float4 Load(float const * values) { return Float4 {{values[0], values[1], values[2], values[3]}}; }
+    static void Store(float * values, Float4 const value) { std::copy_n(value.lanes, 4, values); }
+    static Float4 Splat(float const value) { return Float4 {{value, value, value, value}}; }
+    static Float4 Set(float const x, float const y, float const z, float const w) { return Float4 {{x, y, z, w}}; }
+    static Float4 Add(Float4 const a, Float4 const b) { return ForEachLane(a, b, [](float x, float y) { return x + y; }); }
+    static Float4 Sub(Float4 const a, Float4 const b) { return ForEachLane(a, b, [](float x, float y) { return x - y; }); }
+    static Float4 Mul(Float4 const a, Float4 const b) { return ForEachLane(a, b, [](float x, float y) { return x * y; }); }
+    static Float4 MulAdd(Float4 const a, Float4 const b, Float4 const c) { return Add(Mul(a, b), c); }
+
+    static Float4 Abs(Float4 const value)
+    {
+        return Float4 {{std::fabs(value.lanes[0]), std::fabs(value.lanes[1]), std::fabs(value.lanes[2]), std::fabs(value.lanes[3])}};
+    }
+
+    template<int Lane>
+    static Float4 Broadcast(Float4 const value) { return Splat(value.lanes[Lane]); }
+
+    // Lanes become y, z, x, w
+    static Float4 ShuffleYZX(Float4 const value)
+    {
+        return Float4 {{value.lanes[1], value.lanes[2], value.lanes[0], value.lanes[3]}};
+    }
+
+    static float HorizontalSum(Float4 const value)
+    {
+        return (value.lanes[0] + value.lanes[2]) + (value.lanes[1] + value.lanes[3]);
+    }
+
+    static void Transpose(Float4 & row0, Float4 & row1, Float4 & row2, Float4 & row3)
+    {
+        std::swap(row0.lanes[1], row1.lanes[0]);
+        std::swap(row0.lanes[2], row2.lanes[0]);
+        std::swap(row0.lanes[3], row3.lanes[0]);
+        std::swap(row1.lanes[2], row2.lanes[1]);
+        std::swap(row1.lanes[3], row3.lanes[1]);
+        std::swap(row2.lanes[3], row3.lanes[2]);
+    }
+
+#endif
+
+    static Float4 Load(glm::vec3 const & value) { return Set(value.x, value.y, value.z, 0.0f); }
+
+    static void Store(glm::vec3 & outValue, Float4 const value)
+    {
+        float lanes[4];
+        Store(lanes, value);
+        outValue = glm::vec3 {lanes[0], lanes[1], lanes[2]};
+    }
+
+    // glm keeps quaternions as x, y, z, w unless GLM_FORCE_QUAT_DATA_WXYZ is defined
+    static_assert(offsetof(glm::quat, x) == 0 && offsetof(glm::quat, w) == 3 * sizeof(float));
+
+    static Float4 Load(glm::quat const & value) { return Load(&value.x); }
+
+    static void Store(glm::quat & outValue, Float4 const value) { Store(&outValue.x, value); }
+
+    // Last lane is only meaningful when both inputs have zero in it
+    static Float4 Cross(Float4 const a, Float4 const b)
+    {
+        return ShuffleYZX(Sub(Mul(a, ShuffleYZX(b)), Mul(ShuffleYZX(a), b)));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Left hand side of a multiply that is loaded once and reused for every right hand side.
+    // With AVX two columns of the result are computed at once, So each column is repeated in both halves.
+    struct LeftMatrix
+    {
+#if defined(ENABLE_SIMD) && defined(__AVX2__)
+        __m256 columns[4];
+#else
+        Float4 columns[4];
+#endif
+    };
+
+    static LeftMatrix LoadLeftMatrix(glm::mat4 const & matrix)
+    {
+        LeftMatrix result {};
+        for (int i = 0; i < 4; ++i)
+        {
+#if defined(ENABLE_SIMD) && defined(__AVX2__)
+            result.columns[i] = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(&matrix[i][0]));
+#else
+            result.columns[i] = Load(&matrix[i][0]);
+#endif
+        }
+        return result;
+    }
+
+    // Each column of the result is the left matrix columns weighted by the matching column of the right matrix.
+    // Right hand side is fully read before its columns are written, So outMatrix may alias it.
+    static void MultiplyLeftMatrix(LeftMatrix const & left, glm::mat4 const & right, glm::mat4 & outMatrix)
+    {
+#if defined(ENABLE_SIMD) && defined(__AVX2__)
+        auto const & columns = left.columns;
+        auto const multiplyTwoColumns = [&columns](__m256 const rightColumns)->__m256
+        {
+            auto result = _mm256_mul_ps(columns[0], _mm256_shuffle_ps(rightColumns, rightColumns, 0x00));
+#if defined(__FMA__)
+            result = _mm256_fmadd_ps(columns[1], _mm256_shuffle_ps(rightColumns, rightColumns, 0x55), result);
+            result = _mm256_fmadd_ps(columns[2], _mm256_shuffle_ps(rightColumns, rightColumns, 0xAA), result);
+            result = _mm256_fmadd_ps(columns[3], _mm256_shuffle_ps(rightColumns, rightColumns, 0xFF), result);
+#else
+            result = _mm256_add_ps(result, _mm256_mul_ps(columns[1], _mm256_shuffle_ps(rightColumns, rightColumns, 0x55)));
+            result = _mm256_add_ps(result, _mm256_mul_ps(columns[2], _mm256_shuffle_ps(rightColumns, rightColumns, 0xAA)));
+            result = _mm256_add_ps(result, _mm256_mul_ps(columns[3], _mm256_shuffle_ps(rightColumns, rightColumns, 0xFF)));
+#endif
+            return result;
+        };
+        auto const result01 = multiplyTwoColumns(_mm256_loadu_ps(&right[0][0]));
+        auto const result23 = multiplyTwoColumns(_mm256_loadu_ps(&right[2][0]));
+        _mm256_storeu_ps(&outMatrix[0][0], result01);
+        _mm256_storeu_ps(&outMatrix[2][0], result23);
+#else
+        auto const & columns = left.columns;
+        Float4 result[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            auto const rightColumn = Load(&right[i][0]);
+            result[i] = Mul(columns[0], Broadcast<0>(rightColumn));
+            result[i] = MulAdd(columns[1], Broadcast<1>(rightColumn), result[i]);
+            result[i] = MulAdd(columns[2], Broadcast<2>(rightColumn), result[i]);
+            result[i] = MulAdd(columns[3], Broadcast<3>(rightColumn), result[i]);
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            Store(&outMatrix[i][0], result[i]);
+        }
+#endif
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    glm::mat4 Multiply(glm::mat4 const & a, glm::mat4 const & b)
+    {
+        glm::mat4 result;
+        MultiplyLeftMatrix(LoadLeftMatrix(a), b, result);
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Multiply(
+        glm::mat4 const & a,
+        glm::mat4 const * b,
+        size_t const count,
+        glm::mat4 * outMatrices
+    )
+    {
+        MFA_ASSERT(count == 0 || (b != nullptr && outMatrices != nullptr));
+        auto const left = LoadLeftMatrix(a);
+        for (size_t i = 0; i < count; ++i)
+        {
+            MultiplyLeftMatrix(left, b[i], outMatrices[i]);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Multiply(
+        glm::mat4 const * a,
+        glm::mat4 const * b,
+        size_t const count,
+        glm::mat4 * outMatrices
+    )
+    {
+        MFA_ASSERT(count == 0 || (a != nullptr && b != nullptr && outMatrices != nullptr));
+        for (size_t i = 0; i < count; ++i)
+        {
+            MultiplyLeftMatrix(LoadLeftMatrix(a[i]), b[i], outMatrices[i]);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    glm::mat4 ComposeTRS(
+        glm::vec3 const & translation,
+        glm::quat const & rotation,
+        glm::vec3 const & scale
+    )
+    {
+        // Translation and scale only touch the last column and the length of the others, So no multiply is needed
+        auto const rotationMatrix = glm::mat3_cast(rotation);
+        return glm::mat4 {
+            glm::vec4 {rotationMatrix[0] * scale.x, 0.0f},
+            glm::vec4 {rotationMatrix[1] * scale.y, 0.0f},
+            glm::vec4 {rotationMatrix[2] * scale.z, 0.0f},
+            glm::vec4 {translation, 1.0f}
+        };
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ComposeTRS(
+        glm::vec3 const * translations,
+        glm::quat const * rotations,
+        glm::vec3 const * scales,
+        size_t const count,
+        glm::mat4 * outMatrices
+    )
+    {
+        MFA_ASSERT(count == 0 || (translations != nullptr && rotations != nullptr && scales != nullptr && outMatrices != nullptr));
+
+        // Four matrices at a time, Each lane belongs to one of them
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            auto const * r = rotations + i;
+            auto x = Load(r[0]);
+            auto y = Load(r[1]);
+            auto z = Load(r[2]);
+            auto w = Load(r[3]);
+            Transpose(x, y, z, w);
+
+            auto const * s = scales + i;
+            auto const scaleX = Set(s[0].x, s[1].x, s[2].x, s[3].x);
+            auto const scaleY = Set(s[0].y, s[1].y, s[2].y, s[3].y);
+            auto const scaleZ = Set(s[0].z, s[1].z, s[2].z, s[3].z);
+
+            // Same terms as glm::mat3_cast
+            auto const x2 = Add(x, x);
+            auto const y2 = Add(y, y);
+            auto const z2 = Add(z, z);
+            auto const xx = Mul(x, x2);
+            auto const yy = Mul(y, y2);
+            auto const zz = Mul(z, z2);
+            auto const xy = Mul(x, y2);
+            auto const xz = Mul(x, z2);
+            auto const yz = Mul(y, z2);
+            auto const wx = Mul(w, x2);
+            auto const wy = Mul(w, y2);
+            auto const wz = Mul(w, z2);
+            auto const one = Splat(1.0f);
+
+            // Rows of the transposed columns, Transposing them gives the same column of all four matrices
+            auto const storeColumn = [outMatrices, i](int const column, Float4 row0, Float4 row1, Float4 row2)->void
+            {
+                auto row3 = Splat(0.0f);
+                Transpose(row0, row1, row2, row3);
+                Store(&outMatrices[i][column][0], row0);
+                Store(&outMatrices[i + 1][column][0], row1);
+                Store(&outMatrices[i + 2][column][0], row2);
+                Store(&outMatrices[i + 3][column][0], row3);
+            };
+            storeColumn(
+                0,
+                Mul(Sub(one, Add(yy, zz)), scaleX),
+                Mul(Add(xy, wz), scaleX),
+                Mul(Sub(xz, wy), scaleX)
+            );
+            storeColumn(
+                1,
+                Mul(Sub(xy, wz), scaleY),
+                Mul(Sub(one, Add(xx, zz)), scaleY),
+                Mul(Add(yz, wx), scaleY)
+            );
+            storeColumn(
+                2,
+                Mul(Add(xz, wy), scaleZ),
+                Mul(Sub(yz, wx), scaleZ),
+                Mul(Sub(one, Add(xx, yy)), scaleZ)
+            );
+
+            for (size_t j = i; j < i + 4; ++j)
+            {
+                auto const & translation = translations[j];
+                Store(&outMatrices[j][3][0], Set(translation.x, translation.y, translation.z, 1.0f));
+            }
+        }
+
+        for (; i < count; ++i)
+        {
+            outMatrices[i] = ComposeTRS(translations[i], rotations[i], scales[i]);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    glm::mat4 AffineInverse(glm::mat4 const & matrix)
+    {
+        auto const column0 = Load(&matrix[0][0]);
+        auto const column1 = Load(&matrix[1][0]);
+        auto const column2 = Load(&matrix[2][0]);
+        auto const column3 = Load(&matrix[3][0]);
+
+        // Rows of the inverse of the upper 3x3 are cross products of its columns divided by the determinant
+        auto row0 = Cross(column1, column2);
+        auto row1 = Cross(column2, column0);
+        auto row2 = Cross(column0, column1);
+        auto row3 = Splat(0.0f);
+
+        auto const inverseDeterminant = Splat(1.0f / HorizontalSum(Mul(column0, row0)));
+        row0 = Mul(row0, inverseDeterminant);
+        row1 = Mul(row1, inverseDeterminant);
+        row2 = Mul(row2, inverseDeterminant);
+        Transpose(row0, row1, row2, row3);
+
+        // Translation is moved back by the inverse rotation and scale
+        auto translation = Mul(row0, Broadcast<0>(column3));
+        translation = MulAdd(row1, Broadcast<1>(column3), translation);
+        translation = MulAdd(row2, Broadcast<2>(column3), translation);
+
+        glm::mat4 result;
+        Store(&result[0][0], row0);
+        Store(&result[1][0], row1);
+        Store(&result[2][0], row2);
+        Store(&result[3][0], Sub(Set(0.0f, 0.0f, 0.0f, 1.0f), translation));
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    glm::quat Nlerp(glm::quat const & from, glm::quat const & to, float const fraction)
+    {
+        auto const a = Load(from);
+        auto const b = Load(to);
+        auto const toWeight = HorizontalSum(Mul(a, b)) < 0.0f ? -fraction : fraction;
+
+        auto const blend = MulAdd(b, Splat(toWeight), Mul(a, Splat(1.0f - fraction)));
+        auto const length2 = HorizontalSum(Mul(blend, blend));
+
+        glm::quat result;
+        Store(result, Mul(blend, Splat(1.0f / std::sqrt(length2))));
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    glm::quat Slerp(glm::quat const & from, glm::quat const & to, float const fraction)
+    {
+        auto const a = Load(from);
+        auto const b = Load(to);
+
+        auto cosTheta = HorizontalSum(Mul(a, b));
+        auto sign = 1.0f;
+        if (cosTheta < 0.0f)
+        {
+            sign = -1.0f;
+            cosTheta = -cosTheta;
+        }
+
+        float fromWeight = 1.0f - fraction;
+        float toWeight = fraction;
+        // Same threshold as glm, sin(angle) is too close to zero below it
+        if (cosTheta <= 1.0f - Math::Epsilon<float>())
+        {
+            auto const angle = std::acos(cosTheta);
+            auto const inverseSin = 1.0f / std::sin(angle);
+            fromWeight = std::sin(fromWeight * angle) * inverseSin;
+            toWeight = std::sin(toWeight * angle) * inverseSin;
+        }
+
+        glm::quat result;
+        Store(result, MulAdd(b, Splat(sign * toWeight), Mul(a, Splat(fromWeight))));
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void TransformAABB(
+        glm::mat4 const & matrix,
+        glm::vec3 const * mins,
+        glm::vec3 const * maxs,
+        size_t const count,
+        glm::vec3 * outMins,
+        glm::vec3 * outMaxs
+    )
+    {
+        MFA_ASSERT(count == 0 || (mins != nullptr && maxs != nullptr && outMins != nullptr && outMaxs != nullptr));
+
+        auto const column0 = Load(&matrix[0][0]);
+        auto const column1 = Load(&matrix[1][0]);
+        auto const column2 = Load(&matrix[2][0]);
+        auto const column3 = Load(&matrix[3][0]);
+        auto const absColumn0 = Abs(column0);
+        auto const absColumn1 = Abs(column1);
+        auto const absColumn2 = Abs(column2);
+        auto const half = Splat(0.5f);
+
+        // Arvo 1990, Transforming axis-aligned bounding boxes: The center is transformed as a point
+        // and the extent by the absolute value of the rotation and scale part
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto const min = Load(mins[i]);
+            auto const max = Load(maxs[i]);
+            auto const center = Mul(Add(min, max), half);
+            auto const extent = Mul(Sub(max, min), half);
+
+            auto newCenter = MulAdd(column0, Broadcast<0>(center), column3);
+            newCenter = MulAdd(column1, Broadcast<1>(center), newCenter);
+            newCenter = MulAdd(column2, Broadcast<2>(center), newCenter);
+
+            auto newExtent = Mul(absColumn0, Broadcast<0>(extent));
+            newExtent = MulAdd(absColumn1, Broadcast<1>(extent), newExtent);
+            newExtent = MulAdd(absColumn2, Broadcast<2>(extent), newExtent);
+
+            Store(outMins[i], Sub(newCenter, newExtent));
+            Store(outMaxs[i], Add(newCenter, newExtent));
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
 }
@@ -7,8 +7,12 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/norm.hpp>
 
-#ifdef ENABLE_SIMD
+#include <cstddef>
+
+#if defined(ENABLE_SIMD) && (defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64))
 #include <immintrin.h>
+#elif defined(ENABLE_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
 #endif
 
 namespace MFA::Matrix 
@@ -94,51 +98,144 @@ namespace MFA::Matrix
         float maxDegreeDelta
     );
 
-#ifdef ENABLE_SIMD
+    // Kernels below use SSE/AVX or NEON when the build has ENABLE_SIMD and fall back to scalar code otherwise.
+    // Results match glm up to floating point rounding.
+
+    [[nodiscard]]
+    glm::mat4 Multiply(glm::mat4 const & a, glm::mat4 const & b);
+
+    // outMatrices[i] = a * b[i], Used for joint palettes. outMatrices may alias b.
+    void Multiply(
+        glm::mat4 const & a,
+        glm::mat4 const * b,
+        size_t count,
+        glm::mat4 * outMatrices
+    );
+
+    // outMatrices[i] = a[i] * b[i], outMatrices may alias a or b
+    void Multiply(
+        glm::mat4 const * a,
+        glm::mat4 const * b,
+        size_t count,
+        glm::mat4 * outMatrices
+    );
+
+    // Same as glm::translate(translation) * glm::toMat4(rotation) * glm::scale(scale), Rotation must be normalized
+    [[nodiscard]]
+    glm::mat4 ComposeTRS(
+        glm::vec3 const & translation,
+        glm::quat const & rotation,
+        glm::vec3 const & scale
+    );
+
+    void ComposeTRS(
+        glm::vec3 const * translations,
+        glm::quat const * rotations,
+        glm::vec3 const * scales,
+        size_t count,
+        glm::mat4 * outMatrices
+    );
+
+    // Inverse of a matrix whose last row is (0, 0, 0, 1). Much cheaper than glm::inverse and works with scale and shear.
+    [[nodiscard]]
+    glm::mat4 AffineInverse(glm::mat4 const & matrix);
+
+    // Normalized linear interpolation through the shortest path. Cheaper than Slerp but the speed is not constant.
+    [[nodiscard]]
+    glm::quat Nlerp(glm::quat const & from, glm::quat const & to, float fraction);
+
+    // Same as glm::slerp, Interpolates through the shortest path
+    [[nodiscard]]
+    glm::quat Slerp(glm::quat const & from, glm::quat const & to, float fraction);
+
+    // Axis aligned bounds of the transformed boxes, matrix must be affine. outMins and outMaxs may alias the inputs.
+    void TransformAABB(
+        glm::mat4 const & matrix,
+        glm::vec3 const * mins,
+        glm::vec3 const * maxs,
+        size_t count,
+        glm::vec3 * outMins,
+        glm::vec3 * outMaxs
+    );
+
+    // Vector helpers, Each one matches the glm function with the same name bit for bit
 
-    static __m256 convertToM256(glm::vec4 const & vec)
+#if defined(ENABLE_SIMD) && (defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64))
+
+    [[nodiscard]]
+    inline glm::vec4 Add(glm::vec4 const & vec1, glm::vec4 const & vec2)
+    {
+        glm::vec4 result;
+        _mm_storeu_ps(&result[0], _mm_add_ps(_mm_loadu_ps(&vec1[0]), _mm_loadu_ps(&vec2[0])));
+        return result;
+    }
+
+    // Sums (x + y) + (z + w) like glm
+    [[nodiscard]]
+    inline float Dot(glm::vec4 const & vec1, glm::vec4 const & vec2)
     {
-        return _mm256_set_ps(vec[0], vec[1], vec[2], vec[3], 0.0f, 0.0f, 0.0f, 0.0f);
+        auto const product = _mm_mul_ps(_mm_loadu_ps(&vec1[0]), _mm_loadu_ps(&vec2[0]));
+        auto const pairs = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_movehl_ps(pairs, pairs)));
     }
 
-    static glm::vec4 convertToVec4(__m256 const & var)
+    [[nodiscard]]
+    inline glm::vec4 Lerp(glm::vec4 const & vec1, glm::vec4 const & vec2, float const fraction)
     {
-        auto const * values = reinterpret_cast<float const *>(&var);
-        return glm::vec4 {values[7], values[6], values[5], values[4]};
+        auto const a = _mm_mul_ps(_mm_loadu_ps(&vec1[0]), _mm_set1_ps(1.0f - fraction));
+        auto const b = _mm_mul_ps(_mm_loadu_ps(&vec2[0]), _mm_set1_ps(fraction));
+        glm::vec4 result;
+        _mm_storeu_ps(&result[0], _mm_add_ps(a, b));
+        return result;
     }
 
+#elif defined(ENABLE_SIMD) && defined(__ARM_NEON)
+
     [[nodiscard]]
-    glm::vec4 Add(glm::vec4 const & vec1, glm::vec4 const & vec2)
+    inline glm::vec4 Add(glm::vec4 const & vec1, glm::vec4 const & vec2)
     {
-        __m256 a = convertToM256(vec1);
-        __m256 b = convertToM256(vec2);
-        __m256 c = _mm256_add_ps(a, b);
-        return convertToVec4(c);
+        glm::vec4 result;
+        vst1q_f32(&result[0], vaddq_f32(vld1q_f32(&vec1[0]), vld1q_f32(&vec2[0])));
+        return result;
     }
 
+    // Sums (x + y) + (z + w) like glm
     [[nodiscard]]
-    float Dot(glm::vec4 const & vec1, glm::vec4 const & vec2)
+    inline float Dot(glm::vec4 const & vec1, glm::vec4 const & vec2)
     {
-        __m256 const a = convertToM256(vec1);
-        __m256 const b = convertToM256(vec2);
-        auto const c = _mm256_dp_ps(a, b, 0b11111000);
-        auto const * values = reinterpret_cast<float const *>(&c);
-        return values[7];
+        auto const product = vmulq_f32(vld1q_f32(&vec1[0]), vld1q_f32(&vec2[0]));
+        auto const pairs = vpadd_f32(vget_low_f32(product), vget_high_f32(product));
+        return vget_lane_f32(pairs, 0) + vget_lane_f32(pairs, 1);
     }
 
     [[nodiscard]]
-    glm::vec4 Lerp(glm::vec4 const & vec1, glm::vec4 const & vec2, float fraction)
+    inline glm::vec4 Lerp(glm::vec4 const & vec1, glm::vec4 const & vec2, float const fraction)
     {
-        __m256 aVar = convertToM256(vec1);
-        __m256 const aFrac = _mm256_set1_ps(1.0f - fraction);
-        aVar = _mm256_mul_ps(aVar, aFrac);
+        auto const a = vmulq_n_f32(vld1q_f32(&vec1[0]), 1.0f - fraction);
+        auto const b = vmulq_n_f32(vld1q_f32(&vec2[0]), fraction);
+        glm::vec4 result;
+        vst1q_f32(&result[0], vaddq_f32(a, b));
+        return result;
+    }
 
-        __m256 bVar = convertToM256(vec2);
-        __m256 const bFrac = _mm256_set1_ps(fraction);
-        bVar = _mm256_mul_ps(bVar, bFrac);
+#else
 
-        __m256 cVar = _mm256_add_ps(aVar, bVar);
-        return convertToVec4(cVar);
+    [[nodiscard]]
+    inline glm::vec4 Add(glm::vec4 const & vec1, glm::vec4 const & vec2)
+    {
+        return vec1 + vec2;
+    }
+
+    [[nodiscard]]
+    inline float Dot(glm::vec4 const & vec1, glm::vec4 const & vec2)
+    {
+        return glm::dot(vec1, vec2);
+    }
+
+    [[nodiscard]]
+    inline glm::vec4 Lerp(glm::vec4 const & vec1, glm::vec4 const & vec2, float const fraction)
+    {
+        return glm::mix(vec1, vec2, fraction);
     }
 
 #endif
@@ -1,29 +1,715 @@
 #include "BedrockMemory.hpp"
 
+#include "BedrockAssert.hpp"
+#include "job_system/ScopeLock.hpp"
+
+#include <algorithm>
+#include <array>
 #include <cstdlib>
 
-namespace MFA::Memory {
+namespace MFA::Memory
+{
+
+    struct AtomicTagStats
+    {
+        std::atomic<uint64_t> currentBytes {0};
+        std::atomic<uint64_t> peakBytes {0};
+        std::atomic<uint64_t> allocationCount {0};
+        std::atomic<uint64_t> allocatedBytes {0};
+    };
+
+    static std::array<AtomicTagStats, static_cast<size_t>(Tag::Count)> TagStatsList {};
+
+    static std::atomic<size_t> ScratchArenaSize {1024 * 1024};
+    static std::atomic<size_t> MaxScratchArenaSize {16 * 1024 * 1024};
+
+    struct State
+    {
+        std::vector<std::unique_ptr<LinearArena>> frameArenas {};
+        LinearArena * activeFrameArena = nullptr;
+    };
+    static State * state = nullptr;
+
+    //-------------------------------------------------------------------------------------------------
+
+    static size_t AlignUp(size_t const value, size_t const alignment)
+    {
+        MFA_ASSERT((alignment & (alignment - 1)) == 0);
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Init(InitParams const & params)
+    {
+        MFA_ASSERT(state == nullptr);
+        MFA_ASSERT(params.framesInFlight > 0);
+
+        ScratchArenaSize = params.scratchArenaSize;
+        MaxScratchArenaSize = params.maxScratchArenaSize;
 
-    std::shared_ptr<SmartBlob> Alloc (size_t const size) {
+        state = new State();
+        for (uint32_t i = 0; i < params.framesInFlight; ++i)
+        {
+            state->frameArenas.emplace_back(std::make_unique<LinearArena>(params.frameArenaSize, Tag::Frame));
+        }
+        state->activeFrameArena = state->frameArenas[0].get();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Shutdown()
+    {
+        MFA_ASSERT(state != nullptr);
+        delete state;
+        state = nullptr;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::shared_ptr<SmartBlob> Alloc(size_t const size, Tag const tag)
+    {
         return std::make_shared<SmartBlob>(Blob {
             static_cast<uint8_t *>(::malloc(size)),
             size
-        });
+        }, tag);
     }
 
-    static void Free (Blob const & mem) {
-        if (mem.ptr != nullptr) {
+    //-------------------------------------------------------------------------------------------------
+
+    static void Free(Blob const & mem)
+    {
+        if (mem.ptr != nullptr)
+        {
             ::free(mem.ptr);
         }
     }
 
+    //-------------------------------------------------------------------------------------------------
+
+    void TrackAlloc(Tag const tag, size_t const size)
+    {
+        auto & stats = TagStatsList[static_cast<size_t>(tag)];
+        auto const currentBytes = stats.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        auto peakBytes = stats.peakBytes.load(std::memory_order_relaxed);
+        while (currentBytes > peakBytes && stats.peakBytes.compare_exchange_weak(peakBytes, currentBytes, std::memory_order_relaxed) == false)
+        {}
+        stats.allocationCount.fetch_add(1, std::memory_order_relaxed);
+        stats.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void TrackFree(Tag const tag, size_t const size)
+    {
+        auto & stats = TagStatsList[static_cast<size_t>(tag)];
+        MFA_ASSERT(stats.currentBytes.load(std::memory_order_relaxed) >= size);
+        stats.currentBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    TagStats GetStats(Tag const tag)
+    {
+        auto const & stats = TagStatsList[static_cast<size_t>(tag)];
+        return TagStats {
+            .currentBytes = stats.currentBytes.load(std::memory_order_relaxed),
+            .peakBytes = stats.peakBytes.load(std::memory_order_relaxed),
+            .allocationCount = stats.allocationCount.load(std::memory_order_relaxed),
+            .allocatedBytes = stats.allocatedBytes.load(std::memory_order_relaxed),
+        };
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    char const * TagName(Tag const tag)
+    {
+        switch (tag)
+        {
+        case Tag::General:
+            return "General";
+        case Tag::Frame:
+            return "Frame";
+        case Tag::Scratch:
+            return "Scratch";
+        case Tag::Pool:
+            return "Pool";
+        case Tag::Texture:
+            return "Texture";
+        case Tag::Mesh:
+            return "Mesh";
+        case Tag::Physics:
+            return "Physics";
+        default:
+            MFA_ASSERT(false);
+            return "";
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    LinearArena::LinearArena(size_t const capacity, Tag const tag, size_t const maxCapacity)
+        : mCapacity(AlignUp(capacity, DefaultAlignment))
+        , mMaxCapacity(std::max(maxCapacity, mCapacity))
+        , mTag(tag)
+    {
+        MFA_ASSERT(mCapacity > 0);
+        mMemory = static_cast<uint8_t *>(::malloc(mCapacity));
+        MFA_ASSERT(mMemory != nullptr);
+        TrackAlloc(mTag, mCapacity);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    LinearArena::~LinearArena()
+    {
+        freeOverflowBlocks(0);
+        ::free(mMemory);
+        TrackFree(mTag, mCapacity);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    Blob LinearArena::Alloc(size_t const size, size_t const alignment)
+    {
+        auto const base = reinterpret_cast<uintptr_t>(mMemory);
+        auto offset = mOffset.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto const begin = AlignUp(base + offset, alignment) - base;
+            auto const end = begin + size;
+            if (end > mCapacity)
+            {
+                return allocOverflow(size, alignment);
+            }
+            if (mOffset.compare_exchange_weak(offset, end, std::memory_order_relaxed))
+            {
+                return Blob {mMemory + begin, size};
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void LinearArena::Reset()
+    {
+        updatePeak();
+
+        // Memory did not fit last time, So the arena grows until the overflow is not needed anymore
+        bool const hasOverflow = mOverflowBytes.load(std::memory_order_relaxed) > 0;
+        freeOverflowBlocks(0);
+        if (hasOverflow && mPeakBytes > mCapacity && mCapacity < mMaxCapacity)
+        {
+            ::free(mMemory);
+            TrackFree(mTag, mCapacity);
+
+            mCapacity = std::min(AlignUp(mPeakBytes, DefaultAlignment), mMaxCapacity);
+            mMemory = static_cast<uint8_t *>(::malloc(mCapacity));
+            MFA_ASSERT(mMemory != nullptr);
+            TrackAlloc(mTag, mCapacity);
+        }
+
+        mOffset.store(0, std::memory_order_relaxed);
+        mPeakBytes = 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    LinearArena::Marker LinearArena::GetMarker() const
+    {
+        return Marker {
+            .offset = mOffset.load(std::memory_order_relaxed),
+            .overflowBlockCount = mOverflowBlockCount.load(std::memory_order_relaxed)
+        };
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void LinearArena::ResetToMarker(Marker const & marker)
+    {
+        MFA_ASSERT(marker.offset <= mOffset.load(std::memory_order_relaxed));
+        updatePeak();
+        freeOverflowBlocks(marker.overflowBlockCount);
+        mOffset.store(marker.offset, std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t LinearArena::GetCapacity() const
+    {
+        return mCapacity;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t LinearArena::GetUsedBytes() const
+    {
+        return mOffset.load(std::memory_order_relaxed) + mOverflowBytes.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t LinearArena::GetPeakBytes() const
+    {
+        return std::max(mPeakBytes, GetUsedBytes());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    Blob LinearArena::allocOverflow(size_t const size, size_t const alignment)
+    {
+        auto const blockSize = size + alignment;
+        auto * block = static_cast<uint8_t *>(::malloc(blockSize));
+        MFA_ASSERT(block != nullptr);
+        TrackAlloc(mTag, blockSize);
+        {
+            SCOPE_LOCK(mOverflowLock)
+            mOverflowBlocks.emplace_back(Blob {block, blockSize});
+            mOverflowBlockCount.store(mOverflowBlocks.size(), std::memory_order_relaxed);
+        }
+        mOverflowBytes.fetch_add(blockSize, std::memory_order_relaxed);
+
+        auto const address = reinterpret_cast<uintptr_t>(block);
+        return Blob {block + (AlignUp(address, alignment) - address), size};
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void LinearArena::freeOverflowBlocks(size_t const keepCount)
+    {
+        if (mOverflowBlockCount.load(std::memory_order_relaxed) <= keepCount)
+        {
+            return;
+        }
+
+        SCOPE_LOCK(mOverflowLock)
+        for (size_t i = keepCount; i < mOverflowBlocks.size(); ++i)
+        {
+            auto const & block = mOverflowBlocks[i];
+            ::free(block.ptr);
+            TrackFree(mTag, block.len);
+            mOverflowBytes.fetch_sub(block.len, std::memory_order_relaxed);
+        }
+        mOverflowBlocks.resize(keepCount);
+        mOverflowBlockCount.store(keepCount, std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void LinearArena::updatePeak()
+    {
+        mPeakBytes = std::max(
+            mPeakBytes,
+            mOffset.load(std::memory_order_relaxed) + mOverflowBytes.load(std::memory_order_relaxed)
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void BeginFrame(uint32_t const frameIndex)
+    {
+        MFA_ASSERT(state != nullptr);
+        MFA_ASSERT(frameIndex < state->frameArenas.size());
+        state->activeFrameArena = state->frameArenas[frameIndex].get();
+        state->activeFrameArena->Reset();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    Blob FrameAlloc(size_t const size, size_t const alignment)
+    {
+        MFA_ASSERT(state != nullptr);
+        return state->activeFrameArena->Alloc(size, alignment);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static LinearArena & GetScratchArena()
+    {
+        // Created on first use, So threads that never need scratch memory do not pay for it
+        thread_local std::unique_ptr<LinearArena> scratchArena = nullptr;
+        if (scratchArena == nullptr)
+        {
+            scratchArena = std::make_unique<LinearArena>(
+                ScratchArenaSize.load(),
+                Tag::Scratch,
+                MaxScratchArenaSize.load()
+            );
+        }
+        return *scratchArena;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    ScratchScope::ScratchScope()
+        : mArena(GetScratchArena())
+        , mMarker(mArena.GetMarker())
+    {}
+
+    //-------------------------------------------------------------------------------------------------
+
+    ScratchScope::~ScratchScope()
+    {
+        // Outermost scope resets completely, That is when the arena may grow
+        if (mMarker.offset == 0 && mMarker.overflowBlockCount == 0)
+        {
+            mArena.Reset();
+        }
+        else
+        {
+            mArena.ResetToMarker(mMarker);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    Blob ScratchScope::Alloc(size_t const size, size_t const alignment)
+    {
+        return mArena.Alloc(size, alignment);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    FixedPool::FixedPool(size_t const blockSize, uint32_t const blocksPerPage, Tag const tag)
+        : mBlockSize(AlignUp(std::max(blockSize, sizeof(FreeBlock)), DefaultAlignment))
+        , mBlocksPerPage(blocksPerPage)
+        , mTag(tag)
+    {
+        MFA_ASSERT(mBlocksPerPage > 0);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    FixedPool::~FixedPool()
+    {
+        MFA_ASSERT(mUsedBlockCount.load() == 0);
+        for (auto * page : mPages)
+        {
+            ::free(page);
+            TrackFree(mTag, mBlockSize * mBlocksPerPage);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void * FixedPool::Alloc()
+    {
+        SCOPE_LOCK(mLock)
+        if (mFreeList == nullptr)
+        {
+            addPage();
+        }
+        auto * block = mFreeList;
+        mFreeList = block->next;
+        mUsedBlockCount.fetch_add(1, std::memory_order_relaxed);
+        return block;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void FixedPool::Free(void * block)
+    {
+        if (block == nullptr)
+        {
+            return;
+        }
+        SCOPE_LOCK(mLock)
+        auto * freeBlock = static_cast<FreeBlock *>(block);
+        freeBlock->next = mFreeList;
+        mFreeList = freeBlock;
+        MFA_ASSERT(mUsedBlockCount.load(std::memory_order_relaxed) > 0);
+        mUsedBlockCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t FixedPool::AllocBatch(void ** outBlocks, uint32_t const count)
+    {
+        SCOPE_LOCK(mLock)
+        if (mFreeList == nullptr)
+        {
+            addPage();
+        }
+        uint32_t allocatedCount = 0;
+        while (allocatedCount < count && mFreeList != nullptr)
+        {
+            outBlocks[allocatedCount] = mFreeList;
+            mFreeList = mFreeList->next;
+            ++allocatedCount;
+        }
+        mUsedBlockCount.fetch_add(allocatedCount, std::memory_order_relaxed);
+        return allocatedCount;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void FixedPool::FreeBatch(void * const * blocks, uint32_t const count)
+    {
+        SCOPE_LOCK(mLock)
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto * freeBlock = static_cast<FreeBlock *>(blocks[i]);
+            freeBlock->next = mFreeList;
+            mFreeList = freeBlock;
+        }
+        MFA_ASSERT(mUsedBlockCount.load(std::memory_order_relaxed) >= count);
+        mUsedBlockCount.fetch_sub(count, std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t FixedPool::GetBlockSize() const
+    {
+        return mBlockSize;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t FixedPool::GetUsedBlockCount() const
+    {
+        return mUsedBlockCount.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t FixedPool::GetPageCount() const
+    {
+        SCOPE_LOCK(mLock)
+        return static_cast<uint32_t>(mPages.size());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Must be called while holding mLock
+    void FixedPool::addPage()
+    {
+        auto const pageSize = mBlockSize * mBlocksPerPage;
+        auto * page = static_cast<uint8_t *>(::malloc(pageSize));
+        MFA_ASSERT(page != nullptr);
+        TrackAlloc(mTag, pageSize);
+        mPages.emplace_back(page);
+
+        // Blocks are linked in address order, So consecutive allocations are next to each other
+        for (int i = static_cast<int>(mBlocksPerPage) - 1; i >= 0; --i)
+        {
+            auto * block = reinterpret_cast<FreeBlock *>(page + i * mBlockSize);
+            block->next = mFreeList;
+            mFreeList = block;
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static constexpr size_t PoolSizeClassStep = 16;
+    static constexpr size_t PoolSizeClassCount = MaxPoolBlockSize / PoolSizeClassStep;
+    static constexpr size_t PoolPageSize = 64 * 1024;
+    static constexpr uint32_t PoolCacheBatchSize = 32;           // Blocks that move between a thread cache and its pool at once
+
+    static size_t SizeClassIndex(size_t const size)
+    {
+        MFA_ASSERT(size > 0 && size <= MaxPoolBlockSize);
+        return (size - 1) / PoolSizeClassStep;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static FixedPool & GetSizeClassPool(size_t const classIndex)
+    {
+        // Intentionally never destroyed, Static objects may still release pooled memory during exit
+        static auto * pools = []()
+        {
+            auto * result = new std::array<std::unique_ptr<FixedPool>, PoolSizeClassCount> {};
+            for (size_t i = 0; i < PoolSizeClassCount; ++i)
+            {
+                auto const blockSize = (i + 1) * PoolSizeClassStep;
+                (*result)[i] = std::make_unique<FixedPool>(
+                    blockSize,
+                    static_cast<uint32_t>(PoolPageSize / blockSize),
+                    Tag::Pool
+                );
+            }
+            return result;
+        }();
+        return *(*pools)[classIndex];
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Free blocks of one thread, Linked through their first bytes like the free list of the pool
+    struct PoolThreadCache
+    {
+        struct CachedBlock
+        {
+            CachedBlock * next;
+        };
+
+        struct SizeClass
+        {
+            CachedBlock * head = nullptr;
+            uint32_t count = 0;
+        };
+
+        ~PoolThreadCache()
+        {
+            for (size_t classIndex = 0; classIndex < PoolSizeClassCount; ++classIndex)
+            {
+                release(classIndex, sizeClasses[classIndex].count);
+            }
+        }
+
+        void * Alloc(size_t const classIndex)
+        {
+            auto & sizeClass = sizeClasses[classIndex];
+            if (sizeClass.head == nullptr)
+            {
+                void * blocks[PoolCacheBatchSize];
+                auto const count = GetSizeClassPool(classIndex).AllocBatch(blocks, PoolCacheBatchSize);
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    push(sizeClass, blocks[i]);
+                }
+            }
+            auto * block = sizeClass.head;
+            sizeClass.head = block->next;
+            --sizeClass.count;
+            return block;
+        }
+
+        void Free(size_t const classIndex, void * memory)
+        {
+            auto & sizeClass = sizeClasses[classIndex];
+            push(sizeClass, memory);
+            if (sizeClass.count > 2 * PoolCacheBatchSize)
+            {
+                release(classIndex, PoolCacheBatchSize);
+            }
+        }
+
+    private:
+
+        static void push(SizeClass & sizeClass, void * memory)
+        {
+            auto * block = static_cast<CachedBlock *>(memory);
+            block->next = sizeClass.head;
+            sizeClass.head = block;
+            ++sizeClass.count;
+        }
+
+        void release(size_t const classIndex, uint32_t const count)
+        {
+            auto & sizeClass = sizeClasses[classIndex];
+            void * blocks[PoolCacheBatchSize];
+            uint32_t remaining = count;
+            while (remaining > 0)
+            {
+                uint32_t batchCount = 0;
+                while (batchCount < PoolCacheBatchSize && batchCount < remaining)
+                {
+                    blocks[batchCount++] = sizeClass.head;
+                    sizeClass.head = sizeClass.head->next;
+                }
+                sizeClass.count -= batchCount;
+                remaining -= batchCount;
+                GetSizeClassPool(classIndex).FreeBatch(blocks, batchCount);
+            }
+        }
+
+        std::array<SizeClass, PoolSizeClassCount> sizeClasses {};
+    };
+
+    // Plain pointers stay readable while thread and static objects are destroyed, Later frees go to the pools directly
+    static thread_local PoolThreadCache * ThreadCache = nullptr;
+    static thread_local bool IsThreadCacheDestroyed = false;
+
+    struct PoolThreadCacheOwner
+    {
+        ~PoolThreadCacheOwner()
+        {
+            ThreadCache = nullptr;
+            IsThreadCacheDestroyed = true;
+        }
+
+        PoolThreadCache cache {};
+    };
+
+    static PoolThreadCache * GetThreadCache()
+    {
+        if (ThreadCache == nullptr && IsThreadCacheDestroyed == false)
+        {
+            thread_local PoolThreadCacheOwner owner {};
+            ThreadCache = &owner.cache;
+        }
+        return ThreadCache;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void * PoolAlloc(size_t const size)
+    {
+        if (size == 0 || size > MaxPoolBlockSize)
+        {
+            auto * memory = ::malloc(size == 0 ? 1 : size);
+            if (memory == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return memory;
+        }
+        auto const classIndex = SizeClassIndex(size);
+        if (auto * cache = GetThreadCache(); cache != nullptr)
+        {
+            return cache->Alloc(classIndex);
+        }
+        return GetSizeClassPool(classIndex).Alloc();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void PoolFree(void * memory, size_t const size)
+    {
+        if (size == 0 || size > MaxPoolBlockSize)
+        {
+            ::free(memory);
+            return;
+        }
+        if (memory == nullptr)
+        {
+            return;
+        }
+        auto const classIndex = SizeClassIndex(size);
+        if (auto * cache = GetThreadCache(); cache != nullptr)
+        {
+            cache->Free(classIndex, memory);
+            return;
+        }
+        GetSizeClassPool(classIndex).Free(memory);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
 }
 
-MFA::SmartBlob::SmartBlob(Blob memory_)
+//-------------------------------------------------------------------------------------------------
+
+MFA::SmartBlob::SmartBlob(Blob memory_, Memory::Tag const tag_)
     : memory(memory_)
-{}
+    , tag(tag_)
+{
+    if (memory.ptr != nullptr)
+    {
+        Memory::TrackAlloc(tag, memory.len);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
 
 MFA::SmartBlob::~SmartBlob()
 {
+    if (memory.ptr != nullptr)
+    {
+        Memory::TrackFree(tag, memory.len);
+    }
     Memory::Free(memory);
 }
+
+//-------------------------------------------------------------------------------------------------
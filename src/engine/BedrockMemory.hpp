@@ -2,12 +2,36 @@
 
 #include "BedrockCommon.hpp"
 
+#include <atomic>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace MFA::Memory
+{
+
+    // Allocations are counted per tag, See GetStats
+    enum class Tag : uint8_t
+    {
+        General = 0,
+        Frame = 1,
+        Scratch = 2,
+        Pool = 3,
+        Texture = 4,
+        Mesh = 5,
+        Physics = 6,
+        Count
+    };
+
+}
+
 namespace MFA
 {
     struct SmartBlob
     {
 
-        explicit SmartBlob(Blob memory_);
+        explicit SmartBlob(Blob memory_, Memory::Tag tag_ = Memory::Tag::General);
         ~SmartBlob();
 
         SmartBlob(SmartBlob const &) noexcept = delete;
@@ -17,72 +41,294 @@ namespace MFA
 
         Blob const memory {};
 
+        Memory::Tag const tag = Memory::Tag::General;
+
     };
 }
 
 namespace MFA::Memory
 {
 
-    std::shared_ptr<SmartBlob> Alloc(size_t size);
-
-    //void Free(SmartBlob const & mem);
-
-    //void PtrFree(void * ptr);
-
-    //template <typename T>
-    //T * New_NoConstruct()
-    //{
-    //    auto blob = Alloc(sizeof(T));
-    //    return blob.as<T>();
-    //}
-
-    //template <typename T>
-    //void Delete_NoDestruct(T * ptr)
-    //{
-    //    return Free({ ptr, sizeof(T) });
-    //}
-
-    //template <typename T>
-    //TBlob<T> NewArray_NoConstruct(size_t count)
-    //{
-    //    auto blob = Alloc(sizeof(T) * count);
-    //    return { blob.as<void>(), blob.len };
-    //}
-
-    //template <typename T>
-    //void DeleteArray_NoDestruct(TBlob<T> blob)
-    //{
-    //    Free({ blob.ptr, blob.len * sizeof(T) });
-    //}
-
-    //template <typename T, typename ... ArgTypes>
-    //T * New(ArgTypes && ... args)
-    //{
-    //    auto ret = New_NoConstruct<T>();
-    //    if (ret)
-    //    {
-    //        try
-    //        {
-    //            new (ret) T(std::forward<ArgTypes>(args)...);
-    //        }
-    //        catch (...)
-    //        {
-    //            ret->~T();
-    //            Delete_NoDestruct(ret);
-    //            ret = nullptr;
-    //        }
-    //    }
-    //    return ret;
-    //}
-
-    //template <typename T>
-    //void Delete(T * ptr)
-    //{
-    //    if (ptr)
-    //    {
-    //        ptr->~T();
-    //        Delete_NoDestruct(ptr);
-    //    }
-    //}
+    static constexpr size_t DefaultAlignment = 16;
+
+    struct TagStats
+    {
+        uint64_t currentBytes = 0;          // Heap memory that is owned right now, Arena blocks count as a whole
+        uint64_t peakBytes = 0;
+        uint64_t allocationCount = 0;       // Heap allocations and arena sub allocations since start
+        uint64_t allocatedBytes = 0;
+    };
+
+    struct InitParams
+    {
+        uint32_t framesInFlight = 2;
+        size_t frameArenaSize = 4 * 1024 * 1024;
+        size_t scratchArenaSize = 1024 * 1024;      // Initial size of each thread's scratch arena
+        size_t maxScratchArenaSize = 16 * 1024 * 1024;  // Rare larger usage is served by overflow blocks
+    };
+
+    // Frame arenas need the number of frames in flight, Everything else works without Init
+    void Init(InitParams const & params);
+
+    void Shutdown();
+
+    std::shared_ptr<SmartBlob> Alloc(size_t size, Tag tag = Tag::General);
+
+    // For memory that is owned elsewhere but should show up in the stats
+    void TrackAlloc(Tag tag, size_t size);
+
+    void TrackFree(Tag tag, size_t size);
+
+    [[nodiscard]]
+    TagStats GetStats(Tag tag);
+
+    [[nodiscard]]
+    char const * TagName(Tag tag);
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Bump allocator, Individual allocations are never freed, Reset releases all of them at once.
+    // Alloc is thread safe, Reset and ResetToMarker are not.
+    // Allocations that do not fit go to separate heap blocks, The next Reset grows the arena to the peak usage up to maxCapacity.
+    class LinearArena
+    {
+    public:
+
+        struct Marker
+        {
+            size_t offset = 0;
+            size_t overflowBlockCount = 0;
+        };
+
+        explicit LinearArena(size_t capacity, Tag tag, size_t maxCapacity = std::numeric_limits<size_t>::max());
+        ~LinearArena();
+
+        LinearArena(LinearArena const &) noexcept = delete;
+        LinearArena(LinearArena &&) noexcept = delete;
+        LinearArena & operator = (LinearArena const &) noexcept = delete;
+        LinearArena & operator = (LinearArena &&) noexcept = delete;
+
+        [[nodiscard]]
+        Blob Alloc(size_t size, size_t alignment = DefaultAlignment);
+
+        // Memory is not constructed, So only trivial types are allowed
+        template<typename T>
+        [[nodiscard]]
+        TBlob<T> AllocArray(size_t const count)
+        {
+            static_assert(std::is_trivially_destructible_v<T>);
+            auto const blob = Alloc(count * sizeof(T), alignof(T) > DefaultAlignment ? alignof(T) : DefaultAlignment);
+            return TBlob<T> {reinterpret_cast<T *>(blob.ptr), count};
+        }
+
+        void Reset();
+
+        [[nodiscard]]
+        Marker GetMarker() const;
+
+        // Frees everything that was allocated after the marker
+        void ResetToMarker(Marker const & marker);
+
+        [[nodiscard]]
+        size_t GetCapacity() const;
+
+        [[nodiscard]]
+        size_t GetUsedBytes() const;
+
+        // Largest usage between two resets, Including the overflow
+        [[nodiscard]]
+        size_t GetPeakBytes() const;
+
+    private:
+
+        Blob allocOverflow(size_t size, size_t alignment);
+
+        void freeOverflowBlocks(size_t keepCount);
+
+        void updatePeak();
+
+        uint8_t * mMemory = nullptr;
+        size_t mCapacity = 0;
+        size_t const mMaxCapacity;
+        Tag const mTag;
+
+        std::atomic<size_t> mOffset {0};
+
+        std::atomic<bool> mOverflowLock = false;
+        std::vector<Blob> mOverflowBlocks {};               // Guarded by mOverflowLock
+        std::atomic<size_t> mOverflowBlockCount {0};        // Readable without the lock
+        std::atomic<size_t> mOverflowBytes {0};
+
+        size_t mPeakBytes = 0;
+
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Arena of the frame that is being recorded, Called when the gpu is done with the previous use of this frame slot
+    void BeginFrame(uint32_t frameIndex);
+
+    // Memory is valid until BeginFrame is called again with the same frame index, It is never freed individually
+    [[nodiscard]]
+    Blob FrameAlloc(size_t size, size_t alignment = DefaultAlignment);
+
+    template<typename T>
+    [[nodiscard]]
+    TBlob<T> FrameAllocArray(size_t const count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>);
+        auto const blob = FrameAlloc(count * sizeof(T), alignof(T) > DefaultAlignment ? alignof(T) : DefaultAlignment);
+        return TBlob<T> {reinterpret_cast<T *>(blob.ptr), count};
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Each thread has its own scratch arena, Everything allocated through a scope is released when the scope ends.
+    // Scopes nest like a stack, Memory must not leave the thread or outlive the scope.
+    class ScratchScope
+    {
+    public:
+
+        explicit ScratchScope();
+        ~ScratchScope();
+
+        ScratchScope(ScratchScope const &) noexcept = delete;
+        ScratchScope(ScratchScope &&) noexcept = delete;
+        ScratchScope & operator = (ScratchScope const &) noexcept = delete;
+        ScratchScope & operator = (ScratchScope &&) noexcept = delete;
+
+        [[nodiscard]]
+        Blob Alloc(size_t size, size_t alignment = DefaultAlignment);
+
+        template<typename T>
+        [[nodiscard]]
+        TBlob<T> AllocArray(size_t const count)
+        {
+            return mArena.AllocArray<T>(count);
+        }
+
+    private:
+
+        LinearArena & mArena;
+        LinearArena::Marker const mMarker;
+
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Free list of equally sized blocks, Pages are allocated on demand and kept until the pool is destroyed
+    class FixedPool
+    {
+    public:
+
+        explicit FixedPool(size_t blockSize, uint32_t blocksPerPage, Tag tag);
+        ~FixedPool();
+
+        FixedPool(FixedPool const &) noexcept = delete;
+        FixedPool(FixedPool &&) noexcept = delete;
+        FixedPool & operator = (FixedPool const &) noexcept = delete;
+        FixedPool & operator = (FixedPool &&) noexcept = delete;
+
+        [[nodiscard]]
+        void * Alloc();
+
+        void Free(void * block);
+
+        // Takes up to count blocks with a single lock, Returns how many were written to outBlocks
+        [[nodiscard]]
+        uint32_t AllocBatch(void ** outBlocks, uint32_t count);
+
+        void FreeBatch(void * const * blocks, uint32_t count);
+
+        [[nodiscard]]
+        size_t GetBlockSize() const;
+
+        // Blocks that are handed out, Including the ones that wait in thread caches of the size class pools
+        [[nodiscard]]
+        uint32_t GetUsedBlockCount() const;
+
+        [[nodiscard]]
+        uint32_t GetPageCount() const;
+
+    private:
+
+        struct FreeBlock
+        {
+            FreeBlock * next;
+        };
+
+        void addPage();
+
+        size_t const mBlockSize;
+        uint32_t const mBlocksPerPage;
+        Tag const mTag;
+
+        mutable std::atomic<bool> mLock = false;
+        FreeBlock * mFreeList = nullptr;                    // Guarded by mLock
+        std::vector<void *> mPages {};                      // Guarded by mLock
+        std::atomic<uint32_t> mUsedBlockCount {0};
+
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Small objects come from shared pools of 16 byte size classes, Larger ones from the heap.
+    // Each thread keeps a few free blocks per size class, So most calls do not touch the shared pool.
+    // Memory may be freed on a different thread than the one that allocated it.
+    static constexpr size_t MaxPoolBlockSize = 512;
+
+    [[nodiscard]]
+    void * PoolAlloc(size_t size);
+
+    void PoolFree(void * memory, size_t size);
+
+    // Allocator for containers and allocate_shared, Control block and object share one pooled block
+    template<typename T>
+    struct PoolAllocator
+    {
+        using value_type = T;
+
+        PoolAllocator() noexcept = default;
+
+        template<typename U>
+        PoolAllocator(PoolAllocator<U> const &) noexcept {}
+
+        [[nodiscard]]
+        T * allocate(size_t const count)
+        {
+            if constexpr (alignof(T) > DefaultAlignment)
+            {
+                return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t {alignof(T)}));
+            }
+            else
+            {
+                return static_cast<T *>(PoolAlloc(count * sizeof(T)));
+            }
+        }
+
+        void deallocate(T * memory, size_t const count) noexcept
+        {
+            if constexpr (alignof(T) > DefaultAlignment)
+            {
+                ::operator delete(memory, std::align_val_t {alignof(T)});
+            }
+            else
+            {
+                PoolFree(memory, count * sizeof(T));
+            }
+        }
+
+        template<typename U>
+        bool operator == (PoolAllocator<U> const &) const noexcept
+        {
+            return true;
+        }
+
+        template<typename U>
+        bool operator != (PoolAllocator<U> const &) const noexcept
+        {
+            return false;
+        }
+    };
 
 } // MFA::Memory
@@ -1,23 +1,31 @@
 #pragma once
 
 #include "engine/BedrockAssert.hpp"
+#include "engine/BedrockFunction.hpp"
+#include "engine/BedrockMemory.hpp"
 #include "engine/BedrockSignalTypes.hpp"
 #include "engine/job_system/ScopeLock.hpp"
 #include "engine/job_system/JobSystem.hpp"
 
-#include <functional>
+#include <atomic>
 #include <vector>
 
-// TODO Make this file thread safe by having a queue of tasks
 namespace MFA
 {
 
+    // Listeners live in an immutable snapshot. Register and UnRegister build a new snapshot under a lock and publish it,
+    // Emit only reads the current one, So it neither locks nor allocates.
+    // Replaced snapshots are retired and freed by a later change once no emit is running.
+    // A signal must outlive its emits, Listeners may register and unregister while it is emitting.
     template<typename ... ArgsT>
     class Signal
     {
     public:
 
-        using Listener = std::function<void(ArgsT ... args)>;
+        using Listener = SmallFunction<void(ArgsT ...)>;
+
+        // Listeners per job of EmitMultiThread
+        static constexpr uint32_t ListenersPerChunk = 32;
 
         struct Slot
         {
@@ -25,6 +33,23 @@ namespace MFA
             Listener listener;
         };
 
+        explicit Signal() = default;
+
+        ~Signal()
+        {
+            MFA_ASSERT(mActiveEmitCount.load() == 0);
+            delete mSnapshot.load();
+            for (auto * snapshot : mRetiredSnapshots)
+            {
+                delete snapshot;
+            }
+        }
+
+        Signal(Signal const &) noexcept = delete;
+        Signal(Signal &&) noexcept = delete;
+        Signal & operator = (Signal const &) noexcept = delete;
+        Signal & operator = (Signal &&) noexcept = delete;
+
         template <typename Instance>
         SignalId Register(Instance * obj, void (Instance:: * memFunc)(ArgsT...))
         {
@@ -34,37 +59,50 @@ namespace MFA
                 (obj->*memFunc)(std::forward<ArgsT>(args)...);
             };
 
-            return Register(std::move(wrapperLambda));
+            return Register(Listener {std::move(wrapperLambda)});
         }
 
-        SignalId Register(const Listener & listener)
+        SignalId Register(Listener listener)
         {
             SCOPE_LOCK(mLock)
 
             MFA_ASSERT(listener != nullptr);
 
-            mSlots.emplace_back(Slot{ mNextId, listener });
+            auto * snapshot = copySnapshot();
+            auto const id = mNextId;
+            snapshot->slots.emplace_back(Slot {id, std::move(listener)});
             ++mNextId;
             MFA_ASSERT(mNextId != SignalIdInvalid);
-            auto const id = mSlots.back().id;
-            
+
+            publish(snapshot);
+
             return id;
         }
 
         bool UnRegister(SignalId listenerId)
         {
-            if (listenerId != SignalIdInvalid)
+            if (listenerId == SignalIdInvalid)
+            {
+                return false;
+            }
+
+            SCOPE_LOCK(mLock)
+
+            auto const * current = mSnapshot.load(std::memory_order_relaxed);
+            if (current == nullptr)
             {
-                SCOPE_LOCK(mLock)
+                return false;
+            }
 
-                for (int i = static_cast<int>(mSlots.size() - 1); i >= 0; --i)
+            for (int i = static_cast<int>(current->slots.size() - 1); i >= 0; --i)
+            {
+                if (current->slots[i].id == listenerId)
                 {
-                    if (mSlots[i].id == listenerId)
-                    {
-                        mSlots[i] = mSlots.back();
-                        mSlots.pop_back();
-                        return true;
-                    }
+                    auto * snapshot = copySnapshot();
+                    snapshot->slots[i] = std::move(snapshot->slots.back());
+                    snapshot->slots.pop_back();
+                    publish(snapshot);
+                    return true;
                 }
             }
             return false;
@@ -72,65 +110,148 @@ namespace MFA
 
         void Emit(ArgsT ... args)
         {
-            std::vector<Listener> listeners {};
+            EmitScope const scope {*this};
+            if (scope.snapshot == nullptr)
             {
-                SCOPE_LOCK(mLock)
-                for (auto & slot : mSlots)
-                {
-                    MFA_ASSERT(slot.listener != nullptr);
-                    listeners.emplace_back(slot.listener);
-                }
+                return;
             }
 
-            for (auto & listener : listeners)
+            for (auto const & slot : scope.snapshot->slots)
             {
-                listener(std::forward<ArgsT>(args)...);
+                MFA_ASSERT(slot.listener != nullptr);
+                slot.listener(args...);
             }
         }
 
+        // Listeners are split into chunks of ListenersPerChunk that the calling thread and the job threads pick up one by one.
+        // Returns once the listeners of this emit are called, Other jobs of the pool are not waited for.
+        // Small signals run on the calling thread.
         void EmitMultiThread(ArgsT ... args)
         {
-            std::vector<Listener> listeners {};
+            EmitScope const scope {*this};
+            if (scope.snapshot == nullptr || scope.snapshot->slots.empty())
             {
-                SCOPE_LOCK(mLock)
-                for (auto & slot : mSlots)
+                return;
+            }
+
+            auto const & slots = scope.snapshot->slots;
+            auto const listenerCount = static_cast<uint32_t>(slots.size());
+            if (listenerCount <= ListenersPerChunk)
+            {
+                for (auto const & slot : slots)
                 {
-                    MFA_ASSERT(slot.listener != nullptr);
-                    listeners.emplace_back(slot.listener);
+                    slot.listener(args...);
                 }
+                return;
             }
 
-            if (listeners.empty() == false)
+            // Captures are references only, So the callback fits the small buffer of std::function
+            auto const callArgs = [&args...](Listener const & listener)->void
             {
-                JS::AssignTaskPerThread(
-                    [... args = std::forward<ArgsT>(args), listeners]
-                    (uint32_t const threadNumber, uint32_t const threadCount)->void
+                listener(args...);
+            };
+            JS::ParallelFor(
+                listenerCount,
+                ListenersPerChunk,
+                [&slots, &callArgs](uint32_t const beginIndex, uint32_t const endIndex)->void
+                {
+                    for (uint32_t i = beginIndex; i < endIndex; ++i)
                     {
-                        for (uint32_t i = threadNumber; i < static_cast<uint32_t>(listeners.size()); i += threadCount)
-                        {
-                            MFA_ASSERT(listeners[i] != nullptr);
-                            listeners[i](args...);
-                        }
+                        MFA_ASSERT(slots[i].listener != nullptr);
+                        callArgs(slots[i].listener);
                     }
-                );
-
-                if (JS::IsMainThread())
-                {
-                    JS::WaitForThreadsToFinish();
                 }
-            }
+            );
         }
 
         [[nodiscard]]
-        bool IsEmpty()
+        bool IsEmpty() const
         {
-            SCOPE_LOCK(mLock)
-            return mSlots.empty();
+            auto const * snapshot = mSnapshot.load(std::memory_order_acquire);
+            return snapshot == nullptr || snapshot->slots.empty();
         }
 
     private:
 
-        std::vector<Slot> mSlots{};
+        // Snapshots are replaced on every change, So they and their slots come from the small object pools
+        struct Snapshot
+        {
+            static void * operator new(size_t const size)
+            {
+                return Memory::PoolAlloc(size);
+            }
+
+            static void operator delete(void * memory, size_t const size)
+            {
+                Memory::PoolFree(memory, size);
+            }
+
+            std::vector<Slot, Memory::PoolAllocator<Slot>> slots {};
+        };
+
+        // Marks an emit as running for the lifetime of the scope, So the snapshot it reads is not freed
+        struct EmitScope
+        {
+            explicit EmitScope(Signal & signal_)
+                : signal(signal_)
+            {
+                signal.mActiveEmitCount.fetch_add(1, std::memory_order_seq_cst);
+                snapshot = signal.mSnapshot.load(std::memory_order_seq_cst);
+            }
+
+            ~EmitScope()
+            {
+                signal.mActiveEmitCount.fetch_sub(1, std::memory_order_release);
+            }
+
+            EmitScope(EmitScope const &) noexcept = delete;
+            EmitScope(EmitScope &&) noexcept = delete;
+            EmitScope & operator = (EmitScope const &) noexcept = delete;
+            EmitScope & operator = (EmitScope &&) noexcept = delete;
+
+            Signal & signal;
+            Snapshot const * snapshot = nullptr;
+        };
+
+        // Must be called while holding mLock
+        Snapshot * copySnapshot() const
+        {
+            auto const * current = mSnapshot.load(std::memory_order_relaxed);
+            auto * snapshot = new Snapshot {};
+            if (current != nullptr)
+            {
+                snapshot->slots.reserve(current->slots.size() + 1);
+                snapshot->slots = current->slots;
+            }
+            return snapshot;
+        }
+
+        // Must be called while holding mLock
+        void publish(Snapshot * snapshot)
+        {
+            auto * previous = mSnapshot.exchange(snapshot, std::memory_order_seq_cst);
+
+            // Emits that start from now on read the new snapshot, So with no running emit every retired one is unused
+            if (mActiveEmitCount.load(std::memory_order_seq_cst) == 0)
+            {
+                for (auto * retired : mRetiredSnapshots)
+                {
+                    delete retired;
+                }
+                mRetiredSnapshots.clear();
+                delete previous;
+            }
+            else if (previous != nullptr)
+            {
+                mRetiredSnapshots.emplace_back(previous);
+            }
+        }
+
+        std::atomic<Snapshot *> mSnapshot {nullptr};
+
+        std::atomic<uint32_t> mActiveEmitCount {0};
+
+        std::vector<Snapshot *> mRetiredSnapshots {};      // Guarded by mLock
 
         SignalId mNextId = 0;
 
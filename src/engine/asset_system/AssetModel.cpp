@@ -7,11 +7,13 @@ namespace MFA::AssetSystem
     Model::Model(
         std::shared_ptr<MeshBase> mesh_,
         std::vector<std::string> textureIds_,
-        std::vector<SamplerConfig> samplerConfigs_
+        std::vector<SamplerConfig> samplerConfigs_,
+        std::vector<TextureUsage> textureUsages_
     )
         : mesh(std::move(mesh_))
         , textureIds(std::move(textureIds_))
         , samplerConfigs(std::move(samplerConfigs_))
+        , textureUsages(std::move(textureUsages_))
     {}
 
     //-------------------------------------------------------------------------------------------------
@@ -14,11 +14,13 @@ namespace MFA::AssetSystem
         std::shared_ptr<MeshBase> const mesh{};
         std::vector<std::string> const textureIds{};       // Texture local address
         std::vector<SamplerConfig> const samplerConfigs{};
+        std::vector<TextureUsage> const textureUsages{};   // Role of each texture in the materials, Same order as textureIds
 
         explicit Model(
             std::shared_ptr<MeshBase> mesh_,
             std::vector<std::string> textureIds_,
-            std::vector<SamplerConfig> samplerConfigs_
+            std::vector<SamplerConfig> samplerConfigs_,
+            std::vector<TextureUsage> textureUsages_ = {}
         );
         ~Model();
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
@@ -8,48 +10,101 @@
 namespace MFA::AssetSystem::Particle
 {
     // TODO Add rotation
-    struct Vertex
+    // Gpu side state of a single particle, Must match Particle in ParticleTypes.hlsl
+    struct ParticleData
     {
-        // Per vertex data
-        float localPosition[3] {};
-        int textureIndex = -1;
+        float position[3] {};
+        float remainingLifeInSec = 0.0f;
+
+        float velocity[3] {};
+        float totalLifeInSec = 0.0f;
 
         float color[3] {};
-        float alpha  = 1.0f;
+        float alpha = 1.0f;
 
         float pointSize = 1.0f;
+        int textureIndex = -1;
+        uint32_t emitterIndex = 0;
+        float sizeScale = 1.0f;
+    };
 
-        // State variables
-        float remainingLifeInSec = 0.0f;
-        float totalLifeInSec = 0.0f;
-        float placeholder0 = 0.0f;
-        
-        float initialLocalPosition[3] {};
-        float speed = 0.0f;
+    // Entry of the draw list, Vertex i of the draw call renders particle drawList[i].particleIndex.
+    // Entries are sorted by sortKey when the essence requires depth sorting.
+    struct DrawEntry
+    {
+        float sortKey = 0.0f;
+        uint32_t particleIndex = 0;
     };
 
-    struct PerInstanceData
+    // Layout of the counters buffer, The first two members are used as indirect draw and dispatch arguments.
+    // Must match the offsets in ParticleTypes.hlsl
+    struct Counters
     {
-        float instancePosition[3] {};
+        // VkDrawIndirectCommand
+        uint32_t vertexCount = 0;
+        uint32_t instanceCount = 1;
+        uint32_t firstVertex = 0;
+        uint32_t firstInstance = 0;
+
+        // VkDispatchIndirectCommand
+        uint32_t groupCountX = 0;
+        uint32_t groupCountY = 1;
+        uint32_t groupCountZ = 1;
+        uint32_t placeholder0 = 0;
+
+        uint32_t aliveCount[2] {};          // Alive lists are swapped every frame
+        int32_t deadCount = 0;
+        uint32_t placeholder1 = 0;
     };
 
-    struct Params {
-        int count = 512;
-        glm::vec3 moveDirection = -Math::UpVec3;
-        
+    // Per emitter parameters, Each variant can override them using a ParticleEmitterComponent
+    struct EmitterParams
+    {
+        float spawnRate = 800.0f;           // Particles per second
         float minLife = 1.0f;
         float maxLife = 1.5f;
         float minSpeed = 1.0f;
         float maxSpeed = 2.0f;
-
         float radius = 0.7f;
+        float sizeScale = 1.0f;
+        glm::vec3 moveDirection = -Math::UpVec3;
+        glm::vec3 color {1.0f, 0.0f, 0.0f};
+    };
+
+    // Gpu side emitter, Must match Emitter in ParticleTypes.hlsl
+    struct EmitterData
+    {
+        float position[3] {};
+        uint32_t emitCount = 0;             // Particles to emit this frame
+
+        float moveDirection[3] {};
+        uint32_t isVisible = 0;             // Particles of hidden emitters are not simulated
+
+        float color[3] {};
+        float radius = 0.0f;
+
+        float minLife = 0.0f;
+        float maxLife = 0.0f;
+        float minSpeed = 0.0f;
+        float maxSpeed = 0.0f;
+
+        float sizeScale = 1.0f;
+        uint32_t seed = 0;
+        float placeholder[2] {};
+    };
+
+    // Shared by all emitters of an essence
+    struct Params {
+        int count = 512;                    // Maximum number of particles per emitter
         glm::vec3 noiseMin {-1.0f, -1.0f, -1.0f};
 
-        float alpha = 0.0001f;    
+        float alpha = 0.0001f;
         glm::vec3 noiseMax {1.0f, 1.0f, 1.0f};
 
         float pointSize = 0.0f;
-        glm::vec3 placeholder {};
+        int textureIndex = 0;
+        int sortByDepth = 1;                // Blended particles are drawn back to front
+        int placeholder = 0;
     };
 
 }
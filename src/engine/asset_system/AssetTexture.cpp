@@ -36,7 +36,14 @@ namespace MFA::AssetSystem
     )
     {
         auto const & d = mipLevelDimension;
-        size_t const p = FormatTable[static_cast<unsigned>(format)].bits_total / 8;
+        auto const & formatInfo = FormatTable[static_cast<unsigned>(format)];
+        if (formatInfo.compression != 0)
+        {
+            // Block compressed formats store 4x4 pixel blocks, Partial blocks on the edges take a whole block
+            size_t const blockBytes = formatInfo.bits_total * 16 / 8;
+            return blockBytes * slices * ((d.width + 3) / 4) * ((d.height + 3) / 4) * d.depth;
+        }
+        size_t const p = formatInfo.bits_total / 8;
         return p * slices * d.width * d.height * d.depth;
     }
 
@@ -110,12 +117,31 @@ namespace MFA::AssetSystem
         MFA_ASSERT(data.ptr != nullptr);
         MFA_ASSERT(data.len > 0);
 
-        MFA_ASSERT(mPreviousMipWidth == -1 || mPreviousMipWidth > static_cast<int>(dimension.width));
-        MFA_ASSERT(mPreviousMipHeight == -1 || mPreviousMipHeight > static_cast<int>(dimension.height));
+        auto const mipBlob = addMipmap(dimension, data.len);
+        ::memcpy(mipBlob.ptr, data.ptr, data.len);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    Blob Texture::addMipmap(
+        Dimensions const & dimension,
+        size_t const size
+    )
+    {
+        MFA_ASSERT(size > 0);
+
+        // Non square chains keep the shorter side at 1 while the longer side is still halving
+        MFA_ASSERT(mPreviousMipWidth == -1 || mPreviousMipWidth >= static_cast<int>(dimension.width));
+        MFA_ASSERT(mPreviousMipHeight == -1 || mPreviousMipHeight >= static_cast<int>(dimension.height));
+        MFA_ASSERT(
+            mPreviousMipWidth == -1 ||
+            mPreviousMipWidth > static_cast<int>(dimension.width) ||
+            mPreviousMipHeight > static_cast<int>(dimension.height)
+        );
         mPreviousMipWidth = static_cast<int>(dimension.width);
         mPreviousMipHeight = static_cast<int>(dimension.height);
 
-        auto const dataLen = static_cast<uint32_t>(data.len);
+        auto const dataLen = static_cast<uint32_t>(size);
         {
             MipmapInfo mipmapInfo{};
             mipmapInfo.offset = mCurrentOffset;
@@ -126,10 +152,12 @@ namespace MFA::AssetSystem
         uint64_t const nextOffset = mCurrentOffset + dataLen;
         MFA_ASSERT(mBuffer->memory.ptr != nullptr);
         MFA_ASSERT(nextOffset <= mBuffer->memory.len);
-        ::memcpy(mBuffer->memory.ptr + mCurrentOffset, data.ptr, data.len);
+        Blob const mipBlob {mBuffer->memory.ptr + mCurrentOffset, size};
         mCurrentOffset = nextOffset;
 
         ++mMipCount;
+
+        return mipBlob;
     }
 
     //-------------------------------------------------------------------------------------------------
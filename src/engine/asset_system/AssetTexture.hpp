@@ -61,10 +61,10 @@ namespace MFA::AssetSystem
             {Format::BC6H_SFloat_Linear_RGB                  , 6, 3, 5, 0, 16, 16, 16, 0, 8},
 
             {Format::BC5_UNorm_Linear_RG                     , 5, 2, 0, 0, 8, 8, 0, 0, 8},
-            {Format::BC5_SNorm_Linear_RG                     , 5, 2, 0, 1, 8, 8, 0, 0, 8},
+            {Format::BC5_SNorm_Linear_RG                     , 5, 2, 1, 0, 8, 8, 0, 0, 8},
 
-            {Format::BC4_UNorm_Linear_R                      , 5, 2, 0, 0, 8, 8, 0, 0, 16},
-            {Format::BC4_SNorm_Linear_R                      , 5, 2, 0, 1, 8, 8, 0, 0, 16},
+            {Format::BC4_UNorm_Linear_R                      , 4, 1, 0, 0, 8, 0, 0, 0,  4},
+            {Format::BC4_SNorm_Linear_R                      , 4, 1, 1, 0, 8, 0, 0, 0,  4},
 
         };
         static_assert(ArrayCount(FormatTable) == static_cast<unsigned>(Format::Count));
@@ -81,9 +81,7 @@ namespace MFA::AssetSystem
 
         static uint8_t ComputeMipCount(Dimensions const & dimensions);
 
-        /*
-         * This function result is only correct for uncompressed data
-         */
+        // Block compressed formats are rounded up to whole 4x4 blocks
         [[nodiscard]]
         static size_t MipSizeBytes(
             Format format,
@@ -128,6 +126,14 @@ namespace MFA::AssetSystem
             CBlob const & data
         );
 
+        // Reserves the next mip level and returns its memory inside the texture buffer,
+        // So loaders can read the level straight into place instead of copying it
+        [[nodiscard]]
+        Blob addMipmap(
+            Dimensions const & dimension,
+            size_t size
+        );
+
         [[nodiscard]]
         size_t mipOffsetInBytes(uint8_t mip_level, uint8_t slice_index = 0) const;
 
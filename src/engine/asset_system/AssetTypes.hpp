@@ -57,6 +57,15 @@ namespace MFA::AssetSystem
         Count
     };
 
+    // What the material reads from a texture, Decides which block compression keeps the texture intact
+    enum class TextureUsage : uint8_t
+    {
+        Generic = 0,            // Unknown role, Kept uncompressed
+        Color = 1,              // All four channels (base color, emissive, metallic roughness), BC7
+        Normal = 2,             // Tangent space normal, Red and green only since the shader rebuilds blue, BC5
+        Mask = 3                // Red only (occlusion), BC4
+    };
+
     using Position = float[3];
     using Normal = float[3];
     using UV = float[2];
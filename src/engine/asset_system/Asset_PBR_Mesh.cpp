@@ -454,11 +454,11 @@ namespace MFA::AssetSystem::PBR
 
         triangleMesh.trianglesCount = primitive.indicesCount / 3;
         triangleMesh.trianglesStride = 3 * sizeof(Index);
-        triangleMesh.triangleBuffer = Memory::Alloc(primitive.indicesCount * sizeof(Index));
+        triangleMesh.triangleBuffer = Memory::Alloc(primitive.indicesCount * sizeof(Index), Memory::Tag::Physics);
 
         triangleMesh.pointsStride = sizeof(physx::PxVec3);
         triangleMesh.pointsCount = primitive.vertexCount;
-        triangleMesh.pointsBuffer = Memory::Alloc(primitive.vertexCount * sizeof(physx::PxVec3));
+        triangleMesh.pointsBuffer = Memory::Alloc(primitive.vertexCount * sizeof(physx::PxVec3), Memory::Tag::Physics);
 
         auto * pointsArray = triangleMesh.pointsBuffer->memory.as<physx::PxVec3>();
         auto * trianglesArray = triangleMesh.triangleBuffer->memory.as<Index>();
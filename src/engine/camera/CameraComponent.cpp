@@ -81,6 +81,20 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    SpatialIndex::Frustum CameraComponent::GetFrustum() const
+    {
+        return SpatialIndex::Frustum {
+            SpatialIndex::Plane::FromPoint(mNearPlane.direction, mNearPlane.position),
+            SpatialIndex::Plane::FromPoint(mFarPlane.direction, mFarPlane.position),
+            SpatialIndex::Plane::FromPoint(mLeftPlane.direction, mLeftPlane.position),
+            SpatialIndex::Plane::FromPoint(mRightPlane.direction, mRightPlane.position),
+            SpatialIndex::Plane::FromPoint(mTopPlane.direction, mTopPlane.position),
+            SpatialIndex::Plane::FromPoint(mBottomPlane.direction, mBottomPlane.position)
+        };
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     CameraComponent::CameraBufferData const & CameraComponent::GetCameraData() const
     {
         return mCameraBufferData;
@@ -359,6 +373,13 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    float CameraComponent::GetFieldOfView() const
+    {
+        return mFieldOfView;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     TransformComponent * CameraComponent::GetTransform() const
     {
         auto const transformComponent = mTransformComponent.lock();
@@ -7,6 +7,7 @@
 #include <glm/mat4x4.hpp>
 
 #include "engine/BedrockRotation.hpp"
+#include "engine/scene_manager/SpatialIndex.hpp"
 
 namespace MFA
 {
@@ -49,6 +50,10 @@ namespace MFA
         [[nodiscard]]
         bool IsPointInsideFrustum(glm::vec3 const & point, glm::vec3 const & extend) const;
 
+        // Same planes as IsPointInsideFrustum in the form that the batched culling of the scene expects
+        [[nodiscard]]
+        SpatialIndex::Frustum GetFrustum() const;
+
         [[nodiscard]]
         CameraBufferData const & GetCameraData() const;
 
@@ -66,6 +71,10 @@ namespace MFA
         [[nodiscard]]
         glm::vec2 GetViewportDimension() const;
 
+        // Vertical field of view in degrees
+        [[nodiscard]]
+        float GetFieldOfView() const;
+
         [[nodiscard]]
         TransformComponent * GetTransform() const;
 
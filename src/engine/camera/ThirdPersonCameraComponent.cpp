@@ -7,6 +7,7 @@
 #include "engine/BedrockMath.hpp"
 #include "engine/BedrockMatrix.hpp"
 #include "engine/entity_system/Entity.hpp"
+#include "engine/entity_system/components/RigidbodyComponent.hpp"
 #include "engine/entity_system/components/TransformComponent.hpp"
 
 namespace MFA
@@ -106,6 +107,16 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    void ThirdPersonCameraComponent::GetUpdateDependencies(std::vector<ComponentTypeId> & outDependencies) const
+    {
+        CameraComponent::GetUpdateDependencies(outDependencies);
+
+        // Follow target is usually moved by physics
+        outDependencies.emplace_back(RigidbodyComponent::GetTypeId());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void ThirdPersonCameraComponent::Shutdown()
     {
         CameraComponent::Shutdown();
@@ -42,6 +42,8 @@ namespace MFA
 
         void Update(float deltaTimeInSec) override;
 
+        void GetUpdateDependencies(std::vector<ComponentTypeId> & outDependencies) const override;
+
         void Shutdown() override;
 
         void OnUI() override;
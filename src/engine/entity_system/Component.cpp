@@ -12,7 +12,11 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
-    Component::~Component() = default;
+    Component::~Component()
+    {
+        ComponentRegistry::RemoveFromPool(this);
+        UpdateScheduler::Remove(this);
+    }
 
     //-------------------------------------------------------------------------------------------------
 
@@ -45,19 +49,9 @@ namespace MFA
         mIsActive = isActive;
 
         // Update event
-        if ((requiredEvents() & EventTypes::UpdateEvent) > 0)
+        if ((requiredEvents() & EventTypes::UpdateEvent) > 0 && mEntity != nullptr)
         {
-            if (mIsActive)
-            {
-                mUpdateEventId = GetEntity()->mUpdateSignal.Register([this](float const deltaTimeInSec)->void
-                {
-                    Update(deltaTimeInSec);
-                });
-            }
-            else
-            {
-                GetEntity()->mUpdateSignal.UnRegister(mUpdateEventId);
-            }
+            mEntity->UpdateEntity();
         }
 
         if ((requiredEvents() & EventTypes::ActivationChangeEvent) > 0)
@@ -79,6 +73,10 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    void Component::GetUpdateDependencies(std::vector<ComponentTypeId> & outDependencies) const {}
+
+    //-------------------------------------------------------------------------------------------------
+
     void Component::OnUI()
     {
         if (UI::TreeNode("Component"))
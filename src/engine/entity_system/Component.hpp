@@ -1,5 +1,9 @@
 #pragma once
 
+#include "ComponentRegistry.hpp"
+#include "EntitySystemTypes.hpp"
+#include "UpdateScheduler.hpp"
+#include "engine/BedrockHash.hpp"
 #include "engine/BedrockSignal.hpp"
 
 #include "libs/nlohmann/json_fwd.hpp"
@@ -17,6 +21,7 @@ public:
 using Parent = parent;                                                                  \
                                                                                         \
 static constexpr char const * Name = #componentName;                                    \
+static constexpr uint64_t NameHash = Hash::Fnv1a(#componentName);                       \
 static constexpr EventType RequiredEvents = eventTypes;                                 \
                                                                                         \
 std::weak_ptr<componentName> selfPtr()                                                  \
@@ -38,20 +43,40 @@ void GetParents(std::vector<std::string> & parents) override
                                                                                         \
 bool HaveSameNameOrParent(std::string const & name) override                            \
 {                                                                                       \
-    static QueryInformation queryInfo {};                                               \
-    if (queryInfo.isValid == false)                                                     \
-    {                                                                                   \
-        GetParents(queryInfo.parents);                                                  \
-        queryInfo.isValid = true;                                                       \
-    }                                                                                   \
-    for (auto & item : queryInfo.parents)                                               \
-    {                                                                                   \
-        if (item == name)                                                               \
-        {                                                                               \
-            return true;                                                                \
-        }                                                                               \
-    }                                                                                   \
-    return false;                                                                       \
+    auto const typeId = ComponentRegistry::FindTypeId(name);                            \
+    return typeId != ComponentTypeIdInvalid && GetTypeMask().test(typeId);              \
+}                                                                                       \
+                                                                                        \
+[[nodiscard]]                                                                           \
+static ComponentTypeId GetTypeId()                                                      \
+{                                                                                       \
+    static ComponentTypeId const typeId = ComponentRegistry::RegisterType(              \
+        Name,                                                                           \
+        NameHash                                                                        \
+    );                                                                                  \
+    return typeId;                                                                      \
+}                                                                                       \
+                                                                                        \
+[[nodiscard]]                                                                           \
+static ComponentTypeMask const & GetTypeMask()                                          \
+{                                                                                       \
+    static ComponentTypeMask const typeMask = ComponentRegistry::MakeTypeMask(          \
+        GetTypeId(),                                                                    \
+        Parent::GetTypeMask()                                                           \
+    );                                                                                  \
+    return typeMask;                                                                    \
+}                                                                                       \
+                                                                                        \
+[[nodiscard]]                                                                           \
+ComponentTypeId GetInstanceTypeId() const override                                      \
+{                                                                                       \
+    return GetTypeId();                                                                 \
+}                                                                                       \
+                                                                                        \
+[[nodiscard]]                                                                           \
+ComponentTypeMask const & GetInstanceTypeMask() const override                          \
+{                                                                                       \
+    return GetTypeMask();                                                               \
 }                                                                                       \
                                                                                         \
 [[nodiscard]]                                                                           \
@@ -163,14 +188,19 @@ protected:                                                      \
     {
     public:
 
-        struct QueryInformation
-        {
-            // Including component name and all of its parents names
-            std::vector<std::string> parents{};
-            bool isValid = false;
-        };
-
         friend Entity;
+        friend void ComponentRegistry::AddToPool(Component * component);
+        friend void ComponentRegistry::RemoveFromPool(Component * component);
+        friend void UpdateScheduler::Add(Component * component);
+        friend void UpdateScheduler::Remove(Component * component);
+        friend bool UpdateScheduler::IsScheduled(Component const * component);
+        friend void UpdateScheduler::Update(float deltaTimeInSec);
+
+        // Returns nullptr when no component is registered with this name
+        static std::shared_ptr<Component> CreateComponent(std::string const & name);
+
+        static constexpr uint32_t PoolIndexInvalid = UINT32_MAX;
+        static constexpr uint32_t UpdateIndexInvalid = UINT32_MAX;
 
         using EventType = uint8_t;
 
@@ -236,6 +266,20 @@ protected:                                                      \
 
         virtual void GetParents(std::vector<std::string> & parents);
 
+        // Base component does not have a type id, Only classes that use component props macro do.
+        [[nodiscard]]
+        static ComponentTypeMask const & GetTypeMask()
+        {
+            static ComponentTypeMask const emptyMask {};
+            return emptyMask;
+        }
+
+        [[nodiscard]]
+        virtual ComponentTypeId GetInstanceTypeId() const = 0;
+
+        [[nodiscard]]
+        virtual ComponentTypeMask const & GetInstanceTypeMask() const = 0;
+
         //virtual int getFamily() = 0;
 
         virtual void Init();
@@ -244,6 +288,10 @@ protected:                                                      \
 
         virtual void Update(float deltaTimeInSec);
 
+        // Update of this component runs after update of all components of these types (Or their children).
+        // Only called once per component type.
+        virtual void GetUpdateDependencies(std::vector<ComponentTypeId> & outDependencies) const;
+
         virtual void Shutdown();
 
         virtual void OnActivationStatusChanged(bool isActive);
@@ -279,19 +327,29 @@ protected:                                                      \
 
         SignalId mLateInitEventId = SignalIdInvalid;
 
-        SignalId mUpdateEventId = SignalIdInvalid;
-
         SignalId mShutdownEventId = SignalIdInvalid;
 
         SignalId mActivationChangeEventId = SignalIdInvalid;
 
+        // Location inside ComponentRegistry pools
+        ComponentTypeId mPoolTypeId = ComponentTypeIdInvalid;
+
+        uint32_t mPoolIndex = PoolIndexInvalid;
+
+        // Location inside UpdateScheduler lists
+        ComponentTypeId mUpdateTypeId = ComponentTypeIdInvalid;
+
+        uint32_t mUpdateIndex = UpdateIndexInvalid;
+
+        bool mIsUpdatePending = false;
+
+        bool mIsRemovePending = false;
+
         static void RegisterComponent(
             std::string const & name,
             std::function<std::shared_ptr<Component>()> const & recipe
         );
 
-        static std::shared_ptr<Component> CreateComponent(std::string const & name);
-
     protected:
 
         template<typename T>
@@ -0,0 +1,195 @@
+#include "ComponentRegistry.hpp"
+
+#include "Component.hpp"
+#include "engine/BedrockAssert.hpp"
+#include "engine/BedrockHash.hpp"
+#include "engine/job_system/ScopeLock.hpp"
+
+#include <array>
+#include <string_view>
+
+namespace MFA::ComponentRegistry
+{
+
+    struct Pool
+    {
+        std::vector<Component *> components {};
+        ComponentTypeMask typeMask {};
+    };
+
+    // Slot of the name table, Empty until typeId is published
+    struct TypeSlot
+    {
+        uint64_t nameHash = 0;
+        std::atomic<ComponentTypeId> typeId = ComponentTypeIdInvalid;
+    };
+
+    // Power of two and at most half full, So probe sequences stay short
+    static constexpr uint32_t TypeTableSize = 2 * MaxComponentTypes;
+    static_assert((TypeTableSize & (TypeTableSize - 1)) == 0);
+
+    struct State
+    {
+        // Names and slots are written once before they are published and never change after,
+        // So readers do not take the lock. Lock is only for registration.
+        std::atomic<bool> typeLock = false;
+        std::array<std::string_view, MaxComponentTypes> typeNames {};
+        std::array<TypeSlot, TypeTableSize> typeTable {};
+        std::atomic<ComponentTypeId> typeCount = 0;
+
+        std::atomic<bool> poolLock = false;
+        std::array<Pool, MaxComponentTypes> pools {};
+    };
+
+    // Registration happens during static initialization so state cannot be a normal global variable
+    static State & GetState()
+    {
+        static State state {};
+        return state;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Linear probing, Stops at the first empty slot because slots are never removed
+    static ComponentTypeId FindTypeId(State const & state, uint64_t const nameHash, std::string_view const name)
+    {
+        for (uint32_t probe = 0; probe < TypeTableSize; ++probe)
+        {
+            auto const & slot = state.typeTable[(nameHash + probe) & (TypeTableSize - 1)];
+            auto const typeId = slot.typeId.load(std::memory_order_acquire);
+            if (typeId == ComponentTypeIdInvalid)
+            {
+                break;
+            }
+            // Names are compared too, So a hash collision can not return another type
+            if (slot.nameHash == nameHash && state.typeNames[typeId] == name)
+            {
+                return typeId;
+            }
+        }
+        return ComponentTypeIdInvalid;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    ComponentTypeId RegisterType(char const * name, uint64_t const nameHash)
+    {
+        MFA_ASSERT(name != nullptr);
+        MFA_ASSERT(nameHash == Hash::Fnv1a(name));
+        auto & state = GetState();
+
+        SCOPE_LOCK(state.typeLock)
+
+        MFA_ASSERT(FindTypeId(state, nameHash, name) == ComponentTypeIdInvalid);
+        auto const typeId = state.typeCount.load(std::memory_order_relaxed);
+        MFA_REQUIRE(typeId < MaxComponentTypes);
+
+        // Name is a string literal of the component class, So the view stays valid
+        state.typeNames[typeId] = name;
+
+        // Table is never more than half full, So there is always an empty slot
+        auto index = static_cast<uint32_t>(nameHash & (TypeTableSize - 1));
+        while (state.typeTable[index].typeId.load(std::memory_order_relaxed) != ComponentTypeIdInvalid)
+        {
+            index = (index + 1) & (TypeTableSize - 1);
+        }
+        auto & slot = state.typeTable[index];
+        slot.nameHash = nameHash;
+        slot.typeId.store(typeId, std::memory_order_release);
+
+        state.typeCount.store(typeId + 1, std::memory_order_release);
+
+        return typeId;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    ComponentTypeId FindTypeId(std::string_view const name)
+    {
+        return FindTypeId(GetState(), Hash::Fnv1a(name), name);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    ComponentTypeId GetTypeCount()
+    {
+        return GetState().typeCount;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    ComponentTypeMask MakeTypeMask(ComponentTypeId const typeId, ComponentTypeMask const & parentMask)
+    {
+        MFA_ASSERT(typeId < MaxComponentTypes);
+        ComponentTypeMask mask = parentMask;
+        mask.set(typeId);
+        return mask;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void AddToPool(Component * component)
+    {
+        MFA_ASSERT(component != nullptr);
+        MFA_ASSERT(component->mPoolIndex == Component::PoolIndexInvalid);
+
+        auto & state = GetState();
+        auto const typeId = component->GetInstanceTypeId();
+        MFA_ASSERT(typeId < MaxComponentTypes);
+
+        SCOPE_LOCK(state.poolLock)
+
+        auto & pool = state.pools[typeId];
+        pool.typeMask = component->GetInstanceTypeMask();
+
+        component->mPoolTypeId = typeId;
+        component->mPoolIndex = static_cast<uint32_t>(pool.components.size());
+        pool.components.emplace_back(component);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RemoveFromPool(Component * component)
+    {
+        MFA_ASSERT(component != nullptr);
+        if (component->mPoolIndex == Component::PoolIndexInvalid)
+        {
+            return;
+        }
+
+        auto & state = GetState();
+
+        SCOPE_LOCK(state.poolLock)
+
+        auto & components = state.pools[component->mPoolTypeId].components;
+        auto const index = component->mPoolIndex;
+        MFA_ASSERT(index < components.size());
+        MFA_ASSERT(components[index] == component);
+
+        components[index] = components.back();
+        components[index]->mPoolIndex = index;
+        components.pop_back();
+
+        component->mPoolIndex = Component::PoolIndexInvalid;
+        component->mPoolTypeId = ComponentTypeIdInvalid;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::vector<Component *> const & GetPool(ComponentTypeId const typeId)
+    {
+        MFA_ASSERT(typeId < MaxComponentTypes);
+        return GetState().pools[typeId].components;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    ComponentTypeMask const & GetPoolTypeMask(ComponentTypeId const typeId)
+    {
+        MFA_ASSERT(typeId < MaxComponentTypes);
+        return GetState().pools[typeId].typeMask;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
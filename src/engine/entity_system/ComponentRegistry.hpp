@@ -0,0 +1,68 @@
+#pragma once
+
+#include "EntitySystemTypes.hpp"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace MFA
+{
+    class Component;
+}
+
+// Keeps track of component types and a dense list of live components per type.
+// Systems can use ForEach to iterate all components of a type without going through entities.
+namespace MFA::ComponentRegistry
+{
+
+    // Called once per component class by MFA_COMPONENT_COMMON_PROPS, Name must outlive the registry.
+    // NameHash is Hash::Fnv1a of the name and is computed at compile time by the macro.
+    // Type ids are dense indices (type masks and scheduler arrays use them), So they are given in registration order.
+    [[nodiscard]]
+    ComponentTypeId RegisterType(char const * name, uint64_t nameHash);
+
+    // Returns ComponentTypeIdInvalid if no component with that name (or its children) is ever used.
+    // Lock free, Looks up an open addressed table keyed by name hash whose slots never change once written.
+    [[nodiscard]]
+    ComponentTypeId FindTypeId(std::string_view name);
+
+    [[nodiscard]]
+    ComponentTypeId GetTypeCount();
+
+    [[nodiscard]]
+    ComponentTypeMask MakeTypeMask(ComponentTypeId typeId, ComponentTypeMask const & parentMask);
+
+    // Entity adds/removes its components. Thread safe.
+    void AddToPool(Component * component);
+
+    void RemoveFromPool(Component * component);
+
+    // Components with exact type of typeId (children are not included)
+    [[nodiscard]]
+    std::vector<Component *> const & GetPool(ComponentTypeId typeId);
+
+    [[nodiscard]]
+    ComponentTypeMask const & GetPoolTypeMask(ComponentTypeId typeId);
+
+    // Iterates over all components that are of type T or are derived from T.
+    // Note: Components should not be added or removed while iterating.
+    template<typename T, typename Callback>
+    void ForEach(Callback const & callback)
+    {
+        auto const typeId = T::GetTypeId();
+        auto const typeCount = GetTypeCount();
+        for (ComponentTypeId poolId = 0; poolId < typeCount; ++poolId)
+        {
+            if (GetPoolTypeMask(poolId).test(typeId) == false)
+            {
+                continue;
+            }
+            for (auto * component : GetPool(poolId))
+            {
+                callback(static_cast<T *>(component));
+            }
+        }
+    }
+
+}
@@ -16,17 +16,28 @@ namespace MFA
         EntityId const id,
         std::string name,
         Entity * parent,
-        bool const serializable
+        bool const serializable,
+        EntityHandle const handle
     )
         : mId(id)
+        , mHandle(handle)
         , mName(std::move(name))
         , mParent(parent)
         , mSerializable(serializable)
-    {}
+    {
+        mComponentIndexByType.fill(ComponentIndexInvalid);
+    }
 
     //-------------------------------------------------------------------------------------------------
 
-    Entity::~Entity() = default;
+    Entity::~Entity()
+    {
+        for (auto const & component : mComponents)
+        {
+            ComponentRegistry::RemoveFromPool(component.get());
+            UpdateScheduler::Remove(component.get());
+        }
+    }
 
     //-------------------------------------------------------------------------------------------------
 
@@ -61,17 +72,6 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
-    void Entity::Update(float const deltaTimeInSec)
-    {
-        if (mIsActive == false)
-        {
-            return;
-        }
-        mUpdateSignal.EmitMultiThread(deltaTimeInSec);
-    }
-
-    //-------------------------------------------------------------------------------------------------
-
     void Entity::Shutdown(bool const shouldNotifyParent)
     {
         if (mIsInitialized == false)
@@ -110,16 +110,12 @@ namespace MFA
 
     bool Entity::RemoveComponent(std::string const & componentName)
     {
-        for (int i = static_cast<int>(mComponents.size()) - 1; i >= 0; --i)
+        auto const component = GetComponent(componentName);
+        if (component == nullptr)
         {
-            if (mComponents[i]->HaveSameNameOrParent(componentName))
-            {
-                UnLinkComponent(mComponents[i].get());
-                mComponents.erase(mComponents.begin() + i);
-                return true;
-            }   
+            return false;
         }
-        return false;
+        return RemoveComponent(component.get());
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -143,6 +139,11 @@ namespace MFA
             }
         }
 
+        if (removed)
+        {
+            UpdateComponentIndices();
+        }
+
         return removed;
     }
 
@@ -150,14 +151,17 @@ namespace MFA
 
     std::shared_ptr<Component> Entity::GetComponent(std::string const & componentName) const
     {
-        for (auto & component : mComponents)
+        auto const typeId = ComponentRegistry::FindTypeId(componentName);
+        if (typeId == ComponentTypeIdInvalid)
         {
-            if (component->HaveSameNameOrParent(componentName))
-            {
-                return component;
-            }   
+            return {};
         }
-        return {};
+        auto const index = mComponentIndexByType[typeId];
+        if (index == ComponentIndexInvalid)
+        {
+            return {};
+        }
+        return mComponents[index];
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -169,6 +173,13 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    EntityHandle Entity::GetHandle() const noexcept
+    {
+        return mHandle;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     Entity * Entity::GetParent() const noexcept
     {
         return mParent;
@@ -211,6 +222,13 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    bool Entity::IsSelfActive() const noexcept
+    {
+        return mIsActive;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     std::vector<Entity *> const & Entity::GetChildEntities() const
     {
         return mChildEntities;
@@ -444,6 +462,13 @@ namespace MFA
 
         // Linked entity
         component->mEntity = this;
+
+        // Type lookup table
+        MFA_ASSERT(mComponents.size() < ComponentIndexInvalid);
+        MFA_ASSERT(mComponents.back().get() == component);
+        IndexComponent(static_cast<ComponentIndex>(mComponents.size() - 1));
+
+        ComponentRegistry::AddToPool(component);
         // Init event
         LINK_TO_EVENT(
             mInitEventId,
@@ -462,16 +487,6 @@ namespace MFA
                 component->LateInit();
             }
         )
-        // Update event
-        LINK_TO_EVENT(
-            mUpdateEventId,
-            UpdateEvent,
-            mUpdateSignal,
-            [component](float const deltaTimeInSec)->void
-            {
-                component->Update(deltaTimeInSec);
-            }
-        )
         // Shutdown event
         LINK_TO_EVENT(
             mShutdownEventId,
@@ -492,6 +507,11 @@ namespace MFA
                 component->OnActivationStatusChanged(isActive);
             }
         )
+        // Update event is handled by UpdateScheduler
+        if ((requiredEvents & Component::EventTypes::UpdateEvent) > 0)
+        {
+            UpdateEntity();
+        }
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -502,6 +522,9 @@ namespace MFA
         
         auto const requiredEvents = component->requiredEvents();
 
+        ComponentRegistry::RemoveFromPool(component);
+        UpdateScheduler::Remove(component);
+
         #define UNLINK_FROM_EVENT(eventType, eventId, signal)               \
         if ((requiredEvents & Component::EventTypes::eventType) > 0)        \
         {                                                                   \
@@ -514,9 +537,6 @@ namespace MFA
         // Late init event
         UNLINK_FROM_EVENT(LateInitEvent, mLateInitEventId, mLateInitSignal)
 
-        // Update event
-        UNLINK_FROM_EVENT(UpdateEvent, mUpdateEventId, mUpdateSignal)
-
         // Shutdown event
         UNLINK_FROM_EVENT(ShutdownEvent, mShutdownEventId, mShutdownSignal)
         
@@ -526,6 +546,32 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    void Entity::IndexComponent(ComponentIndex const index)
+    {
+        auto const & typeMask = mComponents[index]->GetInstanceTypeMask();
+        auto const typeCount = ComponentRegistry::GetTypeCount();
+        for (ComponentTypeId typeId = 0; typeId < typeCount; ++typeId)
+        {
+            if (typeMask.test(typeId) && mComponentIndexByType[typeId] == ComponentIndexInvalid)
+            {
+                mComponentIndexByType[typeId] = index;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Entity::UpdateComponentIndices()
+    {
+        mComponentIndexByType.fill(ComponentIndexInvalid);
+        for (size_t i = 0; i < mComponents.size(); ++i)
+        {
+            IndexComponent(static_cast<ComponentIndex>(i));
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void Entity::UpdateEntity()
     {
         if (mIsInitialized == false)
@@ -2,11 +2,14 @@
 
 #include "Component.hpp"
 #include "engine/BedrockAssert.hpp"
+#include "engine/BedrockMemory.hpp"
 #include "engine/BedrockSignal.hpp"
+#include "EntityHandle.hpp"
 #include "EntitySystemTypes.hpp"
 
 #include "libs/nlohmann/json_fwd.hpp"
 
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -17,7 +20,7 @@ namespace MFA::EntitySystem
 {
     void InitEntity(Entity * entity, bool triggerSignals);
     void UpdateEntity(Entity * entity);
-    static void destroyEntity(EntityId const entityId, bool const shouldNotifyParent);
+    static void destroyEntity(Entity * entity, bool shouldNotifyParent);
 }
 
 namespace MFA
@@ -28,14 +31,15 @@ namespace MFA
     public:
         friend void EntitySystem::InitEntity(Entity * entity, bool triggerSignals);
         friend void EntitySystem::UpdateEntity(Entity * entity);
-        friend void EntitySystem::destroyEntity(EntityId const entityId, bool const shouldNotifyParent);
+        friend void EntitySystem::destroyEntity(Entity * entity, bool shouldNotifyParent);
         friend Component;
 
         explicit Entity(
             EntityId id,
             std::string name,
             Entity * parent,
-            bool serializable
+            bool serializable,
+            EntityHandle handle = EntityHandle {}
         );
 
         ~Entity();
@@ -45,18 +49,10 @@ namespace MFA
         Entity & operator = (Entity const &) noexcept = delete;
         Entity & operator = (Entity && rhs) noexcept = delete;
 
-        [[nodiscard]]
-        bool NeedUpdateEvent() noexcept
-        {
-            return mUpdateSignal.IsEmpty() == false && IsActive();
-        }
-
         void Init(bool triggerSignal = true);
 
         void LateInit(bool triggerSignal = true);
 
-        void Update(float deltaTimeInSec);
-
         void Shutdown(bool shouldNotifyParent = true);
 
         template<typename ComponentClass, typename ... ArgsT>
@@ -68,7 +64,11 @@ namespace MFA
                 MFA_LOG_WARN("Component with name %s alreay exists", ComponentClass::Name);
                 return existingComponent;
             }
-            auto newComponent = std::make_shared<ComponentClass>(std::forward<ArgsT>(args)...);
+            // Component and its control block share one pooled block
+            auto newComponent = std::allocate_shared<ComponentClass>(
+                Memory::PoolAllocator<ComponentClass> {},
+                std::forward<ArgsT>(args)...
+            );
             mComponents.emplace_back(newComponent);
             LinkComponent(newComponent.get());
             return newComponent;
@@ -83,32 +83,25 @@ namespace MFA
         template<typename ComponentClass>
         bool RemoveComponent()
         {
-            for (int i = static_cast<int>(mComponents.size()) - 1; i >= 0; --i)
+            auto const index = mComponentIndexByType[ComponentClass::GetTypeId()];
+            if (index == ComponentIndexInvalid)
             {
-                auto castResult = std::dynamic_pointer_cast<ComponentClass>(mComponents[i]);
-                if (castResult != nullptr)
-                {
-                    UnLinkComponent(mComponents[i].get());
-                    mComponents.erase(mComponents.begin() + i);
-                    return true;
-                } 
+                return false;
             }
-            return false;
+            return RemoveComponent(mComponents[index].get());
         }
 
+        // O(1), Returns the component with the exact type or a child of it.
         template<typename ComponentClass>
         [[nodiscard]]
         std::shared_ptr<ComponentClass> GetComponent()
         {
-            for (auto & component : mComponents)
+            auto const index = mComponentIndexByType[ComponentClass::GetTypeId()];
+            if (index == ComponentIndexInvalid)
             {
-                auto castResult = std::dynamic_pointer_cast<ComponentClass>(component);
-                if (castResult != nullptr)
-                {
-                    return castResult;
-                }   
+                return {};
             }
-            return {};
+            return std::static_pointer_cast<ComponentClass>(mComponents[index]);
         }
 
         // TODO: We need GetComponentsInChildren
@@ -119,6 +112,10 @@ namespace MFA
         [[nodiscard]]
         EntityId getId() const noexcept;
 
+        // Invalid for entities that are not created by EntitySystem
+        [[nodiscard]]
+        EntityHandle GetHandle() const noexcept;
+
         [[nodiscard]]
         Entity * GetParent() const noexcept;
 
@@ -132,6 +129,10 @@ namespace MFA
 
         void SetActive(bool isActive);
 
+        // Own flag, Ignores the parents
+        [[nodiscard]]
+        bool IsSelfActive() const noexcept;
+
         [[nodiscard]]
         std::vector<Entity *> const & GetChildEntities() const;
 
@@ -155,6 +156,9 @@ namespace MFA
 
     private:
 
+        using ComponentIndex = uint8_t;
+        static constexpr ComponentIndex ComponentIndexInvalid = UINT8_MAX;
+
         void NotifyANewChildAdded(Entity * entity);
 
         void NotifyAChildRemoved(Entity * entity);
@@ -165,6 +169,10 @@ namespace MFA
 
         void UnLinkComponent(Component * component);
 
+        void UpdateComponentIndices();
+
+        void IndexComponent(ComponentIndex index);
+
         void UpdateEntity();
 
 
@@ -175,15 +183,18 @@ namespace MFA
     private:
 
         EntityId const mId;
+        EntityHandle const mHandle;
         std::string mName{};
         Entity * mParent = nullptr;
         bool mSerializable = true;
 
         std::vector<std::shared_ptr<Component>> mComponents{};
 
+        // Index of the component inside mComponents, For each component type and its parents
+        std::array<ComponentIndex, MaxComponentTypes> mComponentIndexByType {};
+
         Signal<> mInitSignal{};
         Signal<> mLateInitSignal{};
-        Signal<float> mUpdateSignal{};
         Signal<> mShutdownSignal{};
         Signal<bool> mActivationStatusChangeSignal{};
 
@@ -191,8 +202,6 @@ namespace MFA
         bool mIsActive = true;
         bool mIsParentActive = true;    // It should be true by default because not everyone have parent
 
-        SignalId mUpdateListenerId = SignalIdInvalid;
-
         int mParentActivationStatusChangeListenerId = 0;
 
         std::vector<Entity *> mChildEntities{};
@@ -4,9 +4,17 @@
 
 namespace MFA {
 
+// Index of the entity slot inside EntitySystem and the version of that slot.
+// Version is increased each time the slot is freed, So handles of destroyed entities never resolve to a new entity.
 class EntityHandle {
 public:
 
+    static constexpr uint32_t VersionInvalid = 0;
+
+    explicit EntityHandle()
+        : mData(Data {.Value = 0})
+    {}
+
     explicit EntityHandle(uint64_t const value)
         : mData(Data {.Value = value})
     {}
@@ -34,6 +42,16 @@ public:
         return mData.IndexAndVersion.Version;
     }
 
+    [[nodiscard]]
+    bool IsValid() const noexcept {
+        return GetVersion() != VersionInvalid;
+    }
+
+    [[nodiscard]]
+    bool operator == (EntityHandle const & other) const noexcept {
+        return mData.Value == other.mData.Value;
+    }
+
 private:
 
     union Data {
@@ -47,4 +65,4 @@ private:
 
 };
 
-}
\ No newline at end of file
+}
@@ -6,35 +6,94 @@
 #include "engine/scene_manager/Scene.hpp"
 #include "engine/scene_manager/SceneManager.hpp"
 #include "EntitySystemTypes.hpp"
+#include "UpdateScheduler.hpp"
+#include "engine/job_system/JobSystem.hpp"
+#include "engine/job_system/ScopeLock.hpp"
 
-#include <vector>
+#include <atomic>
 #include <memory>
-
-// TODO This class will need optimization in future
+#include <new>
+#include <string>
+#include <vector>
 
 namespace MFA::EntitySystem
 {
-    //constexpr int MAX_ENTITIES = 1024 * 5;
 
-    struct EntityRef
+    // Entities are stored in pages so their address never changes after creation
+    static constexpr uint32_t EntitiesPerPage = 256;
+    static constexpr uint32_t SlotIndexInvalid = UINT32_MAX;
+
+    struct EntitySlot
     {
-        std::unique_ptr<Entity> ptr;
-        //EntityHandle Handle {ENTITY_HANDLE_INVALID};      // We need entityHandle to distinguish entities and be able to remove entities by that
-        //bool IsAlive = false;
-        //uint32_t NextFreeRef = 0.0f;
-    };
+        alignas(Entity) std::byte storage[sizeof(Entity)];
+        uint32_t version = 1;
+        uint32_t nextFreeIndex = SlotIndexInvalid;
+        bool isAlive = false;
 
-    using Task = std::function<void()>;
+        [[nodiscard]]
+        Entity * GetEntity()
+        {
+            return std::launder(reinterpret_cast<Entity *>(storage));
+        }
+    };
 
     struct State
     {
-        std::vector<EntityRef> entitiesRefsList{};  // TODO Shouldn't we use map or something faster ?
-        Signal<float> updateSignal{};
+        std::vector<std::unique_ptr<EntitySlot[]>> pages {};
+        uint32_t slotCount = 0;
+        uint32_t firstFreeIndex = SlotIndexInvalid;     // Freed slots are reused in LIFO order
+        uint32_t entityCount = 0;
+        EntityId nextEntityId = 0;
+
+        std::atomic<bool> destroyQueueLock = false;
+        std::vector<EntityHandle> destroyQueue {};
     };
     State * state = nullptr;
 
     //-------------------------------------------------------------------------------------------------
 
+    static EntitySlot & getSlot(uint32_t const index)
+    {
+        MFA_ASSERT(index < state->slotCount);
+        return state->pages[index / EntitiesPerPage][index % EntitiesPerPage];
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static EntitySlot * findSlot(EntityHandle const handle)
+    {
+        if (handle.IsValid() == false || handle.GetIndex() >= state->slotCount)
+        {
+            return nullptr;
+        }
+        auto & slot = getSlot(handle.GetIndex());
+        if (slot.isAlive == false || slot.version != handle.GetVersion())
+        {
+            return nullptr;
+        }
+        return &slot;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static uint32_t allocateSlot()
+    {
+        if (state->firstFreeIndex != SlotIndexInvalid)
+        {
+            auto const index = state->firstFreeIndex;
+            state->firstFreeIndex = getSlot(index).nextFreeIndex;
+            return index;
+        }
+
+        if (state->slotCount == state->pages.size() * EntitiesPerPage)
+        {
+            state->pages.emplace_back(std::make_unique<EntitySlot[]>(EntitiesPerPage));
+        }
+        return state->slotCount++;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void Init()
     {
         state = new State();
@@ -44,7 +103,7 @@ namespace MFA::EntitySystem
 
     void Update(float const deltaTimeInSec)
     {
-        state->updateSignal.EmitMultiThread(deltaTimeInSec);
+        UpdateScheduler::Update(deltaTimeInSec);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -68,11 +127,25 @@ namespace MFA::EntitySystem
 
     void Shutdown()
     {
-        for (auto const & entityRef : state->entitiesRefsList)
+        for (uint32_t i = 0; i < state->slotCount; ++i)
+        {
+            auto & slot = getSlot(i);
+            if (slot.isAlive)
+            {
+                slot.GetEntity()->Shutdown();
+            }
+        }
+        for (uint32_t i = 0; i < state->slotCount; ++i)
         {
-            entityRef.ptr->Shutdown();
+            auto & slot = getSlot(i);
+            if (slot.isAlive)
+            {
+                slot.isAlive = false;
+                slot.GetEntity()->~Entity();
+            }
         }
         delete state;
+        state = nullptr;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -83,22 +156,55 @@ namespace MFA::EntitySystem
         CreateEntityParams const & params
     )
     {
-        static EntityId nextEntityId = 0;
         // Checking if we have not reached maximum possible entity limit
-        MFA_ASSERT(nextEntityId < std::numeric_limits<EntityId>::max());
+        MFA_ASSERT(state->nextEntityId < std::numeric_limits<EntityId>::max());
+        auto const entityId = state->nextEntityId++;
+
+        std::string entityName {};
+        entityName.reserve(name.size() + 21);
+        entityName.append(name).append(" ").append(std::to_string(entityId));
+
+        auto const index = allocateSlot();
+        auto & slot = getSlot(index);
+        MFA_ASSERT(slot.isAlive == false);
+
+        auto * entity = new (slot.storage) Entity(
+            entityId,
+            std::move(entityName),
+            parent,
+            params.serializable,
+            EntityHandle {index, slot.version}
+        );
+        slot.isAlive = true;
+        ++state->entityCount;
+
+        return entity;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    Entity * GetEntity(EntityHandle const handle)
+    {
+        auto * slot = findSlot(handle);
+        if (slot == nullptr)
+        {
+            return nullptr;
+        }
+        return slot->GetEntity();
+    }
 
-        char nameBuffer[100] {};
-        auto const nameLength = sprintf(nameBuffer, "%s %d", name.c_str(), static_cast<int>(nextEntityId));
+    //-------------------------------------------------------------------------------------------------
 
-        state->entitiesRefsList.emplace_back(EntityRef{
-            .ptr = std::make_unique<Entity>(
-                nextEntityId++,
-                std::string(nameBuffer, nameLength),
-                parent,
-                params.serializable
-            )
-        });
-        return state->entitiesRefsList.back().ptr.get();
+    bool IsAlive(EntityHandle const handle)
+    {
+        return findSlot(handle) != nullptr;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t GetEntityCount()
+    {
+        return state->entityCount;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -119,57 +225,59 @@ namespace MFA::EntitySystem
     void UpdateEntity(Entity * entity)
     {
         MFA_ASSERT(entity != nullptr);
-        MFA_ASSERT(entity->mIsInitialized == true);
-        if (entity->NeedUpdateEvent())
+        // O(1) per component, Only components with update event are scheduled
+        for (auto const & component : entity->mComponents)
         {
-            if (entity->mUpdateListenerId == SignalIdInvalid)
+            if ((component->requiredEvents() & Component::EventTypes::UpdateEvent) == 0)
             {
-                entity->mUpdateListenerId = state->updateSignal.Register([entity](float const deltaTime) -> void
-                {
-                    entity->Update(deltaTime);
-                });
+                continue;
+            }
+            if (entity->mIsInitialized && component->IsActive())
+            {
+                UpdateScheduler::Add(component.get());
+            }
+            else
+            {
+                UpdateScheduler::Remove(component.get());
             }
-        }
-        else
-        {
-            state->updateSignal.UnRegister(entity->mUpdateListenerId);
-            entity->mUpdateListenerId = SignalIdInvalid;
         }
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    static void destroyEntity(EntityId const entityId, bool const shouldNotifyParent)
+    static void destroyEntity(Entity * entity, bool const shouldNotifyParent)
     {
-        for (int i = static_cast<int>(state->entitiesRefsList.size()) - 1; i >= 0; --i)
+        MFA_ASSERT(entity != nullptr);
+
+        auto const handle = entity->GetHandle();
+        auto * slot = findSlot(handle);
+        if (slot == nullptr || slot->GetEntity() != entity)
         {
-            if (state->entitiesRefsList[i].ptr->getId() == entityId)
-            {
-                std::unique_ptr<Entity> const deletedEntity = std::move(state->entitiesRefsList[i].ptr);
-                MFA_ASSERT(deletedEntity != nullptr);
-
-                // We should remove item before removing children because index might change
-                state->entitiesRefsList[i] = std::move(state->entitiesRefsList.back());
-                state->entitiesRefsList.pop_back();
-
-                deletedEntity->Shutdown(shouldNotifyParent);
-                
-                if (deletedEntity->NeedUpdateEvent())
-                {
-                    state->updateSignal.UnRegister(deletedEntity->mUpdateListenerId);
-                }
-
-                for (auto * childEntity : deletedEntity->GetChildEntities())
-                {
-                    MFA_ASSERT(childEntity != nullptr);
-                    destroyEntity(childEntity->getId(), false);
-                }
-
-                return;
-            }
+            MFA_LOG(Warning, Entity, "Entity with id %d is not created by entity system or is already destroyed", static_cast<int>(entity->getId()));
+            return;
+        }
+
+        entity->Shutdown(shouldNotifyParent);
+        UpdateEntity(entity);
+
+        // Children do not need to notify the parent because it is being destroyed as well
+        for (auto * childEntity : entity->GetChildEntities())
+        {
+            MFA_ASSERT(childEntity != nullptr);
+            destroyEntity(childEntity, false);
         }
 
-        MFA_LOG_WARN("Entity with id %d is not found", static_cast<int>(entityId));
+        entity->~Entity();
+
+        slot->isAlive = false;
+        ++slot->version;
+        if (slot->version == EntityHandle::VersionInvalid)
+        {
+            ++slot->version;
+        }
+        slot->nextFreeIndex = state->firstFreeIndex;
+        state->firstFreeIndex = handle.GetIndex();
+        --state->entityCount;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -177,9 +285,39 @@ namespace MFA::EntitySystem
     void DestroyEntity(Entity * entity)
     {
         MFA_ASSERT(entity != nullptr);
+        destroyEntity(entity, true);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void QueueDestroyEntity(Entity * entity)
+    {
+        MFA_ASSERT(entity != nullptr);
+        SCOPE_LOCK(state->destroyQueueLock)
+        state->destroyQueue.emplace_back(entity->GetHandle());
+    }
 
-        auto const entityId = entity->getId();
-        destroyEntity(entityId, true);
+    //-------------------------------------------------------------------------------------------------
+
+    void DestroyQueuedEntities()
+    {
+        MFA_ASSERT(JS::IsMainThread());
+
+        std::vector<EntityHandle> destroyQueue {};
+        {
+            SCOPE_LOCK(state->destroyQueueLock)
+            destroyQueue.swap(state->destroyQueue);
+        }
+
+        for (auto const handle : destroyQueue)
+        {
+            // Entity might be queued twice or destroyed with its parent
+            auto * entity = GetEntity(handle);
+            if (entity != nullptr)
+            {
+                destroyEntity(entity, true);
+            }
+        }
     }
 
     //-------------------------------------------------------------------------------------------------
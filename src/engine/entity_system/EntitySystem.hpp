@@ -1,5 +1,8 @@
 #pragma once
 
+#include "EntityHandle.hpp"
+
+#include <cstdint>
 #include <string>
 
 namespace MFA
@@ -27,10 +30,27 @@ namespace MFA::EntitySystem {
         CreateEntityParams const & params = {}
     );
 
+    // O(1), Returns nullptr if the entity is destroyed
+    [[nodiscard]]
+    Entity * GetEntity(EntityHandle handle);
+
+    [[nodiscard]]
+    bool IsAlive(EntityHandle handle);
+
+    [[nodiscard]]
+    uint32_t GetEntityCount();
+
     void InitEntity(Entity * entity, bool triggerSignals = true);
 
     void UpdateEntity(Entity * entity);
 
+    // Destroys the entity and its children immediately. Must not be called while entity or its children are being updated.
     void DestroyEntity(Entity * entity);
 
+    // Thread safe, Entity is destroyed at the end of the frame. Use this for entities that destroy themselves.
+    void QueueDestroyEntity(Entity * entity);
+
+    // Called by SceneManager at the end of the frame
+    void DestroyQueuedEntities();
+
 }
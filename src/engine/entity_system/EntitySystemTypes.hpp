@@ -1,7 +1,16 @@
 #pragma once
 
+#include <bitset>
 #include <cstdint>
 
 namespace MFA {
     using EntityId = uint64_t;
+
+    // Dense index that is assigned to each component class (Including abstract ones) once.
+    using ComponentTypeId = uint16_t;
+    static constexpr ComponentTypeId ComponentTypeIdInvalid = UINT16_MAX;
+    static constexpr ComponentTypeId MaxComponentTypes = 128;
+
+    // Contains type id of the component and all of its parents
+    using ComponentTypeMask = std::bitset<MaxComponentTypes>;
 }
@@ -0,0 +1,313 @@
+#include "UpdateScheduler.hpp"
+
+#include "Component.hpp"
+#include "engine/BedrockAssert.hpp"
+#include "engine/job_system/JobSystem.hpp"
+#include "engine/job_system/ScopeLock.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace MFA::UpdateScheduler
+{
+
+    struct UpdateList
+    {
+        bool isCreated = false;
+        ComponentTypeMask typeMask {};
+        std::vector<ComponentTypeId> dependencies {};
+        std::vector<Component *> components {};
+    };
+
+    struct State
+    {
+        std::atomic<bool> lock = false;
+        std::array<UpdateList, MaxComponentTypes> lists {};
+        std::vector<ComponentTypeId> executionOrder {};
+        bool isExecutionOrderDirty = false;
+        bool isUpdating = false;
+        std::vector<Component *> pendingComponents {};
+        // Other threads might be iterating the lists during update, Removals are applied after the pass
+        std::vector<Component *> pendingRemovals {};
+    };
+
+    // Components can be destroyed after entity system shutdown, So state lives as long as the program
+    static State & GetState()
+    {
+        static State state {};
+        return state;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Kahn's algorithm, Lists with the same depth run in type id order to keep the result deterministic.
+    static void ComputeExecutionOrder(State & state)
+    {
+        auto const typeCount = ComponentRegistry::GetTypeCount();
+
+        std::array<std::vector<ComponentTypeId>, MaxComponentTypes> dependants {};
+        std::array<uint32_t, MaxComponentTypes> remainingDependencies {};
+        std::vector<ComponentTypeId> createdLists {};
+
+        for (ComponentTypeId typeId = 0; typeId < typeCount; ++typeId)
+        {
+            auto const & list = state.lists[typeId];
+            if (list.isCreated == false)
+            {
+                continue;
+            }
+            createdLists.emplace_back(typeId);
+
+            for (ComponentTypeId otherTypeId = 0; otherTypeId < typeCount; ++otherTypeId)
+            {
+                auto const & otherList = state.lists[otherTypeId];
+                if (otherTypeId == typeId || otherList.isCreated == false)
+                {
+                    continue;
+                }
+                for (auto const dependency : list.dependencies)
+                {
+                    if (otherList.typeMask.test(dependency))
+                    {
+                        dependants[otherTypeId].emplace_back(typeId);
+                        ++remainingDependencies[typeId];
+                        break;
+                    }
+                }
+            }
+        }
+
+        state.executionOrder.clear();
+        std::vector<bool> isOrdered (typeCount, false);
+        while (state.executionOrder.size() < createdLists.size())
+        {
+            bool foundList = false;
+            for (auto const typeId : createdLists)
+            {
+                if (isOrdered[typeId] == false && remainingDependencies[typeId] == 0)
+                {
+                    isOrdered[typeId] = true;
+                    state.executionOrder.emplace_back(typeId);
+                    for (auto const dependant : dependants[typeId])
+                    {
+                        --remainingDependencies[dependant];
+                    }
+                    foundList = true;
+                    break;
+                }
+            }
+
+            if (foundList == false)
+            {
+                MFA_LOG(Warning, Entity, "Update dependencies contain a cycle. Remaining systems run in type id order");
+                for (auto const typeId : createdLists)
+                {
+                    if (isOrdered[typeId] == false)
+                    {
+                        isOrdered[typeId] = true;
+                        state.executionOrder.emplace_back(typeId);
+                    }
+                }
+            }
+        }
+
+        state.isExecutionOrderDirty = false;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Add(Component * component)
+    {
+        MFA_ASSERT(component != nullptr);
+        auto & state = GetState();
+
+        SCOPE_LOCK(state.lock)
+
+        if (component->mIsRemovePending)
+        {
+            // Still inside its list, Cancelling the removal is enough
+            auto & pendingRemovals = state.pendingRemovals;
+            pendingRemovals.erase(std::ranges::find(pendingRemovals, component));
+            component->mIsRemovePending = false;
+            return;
+        }
+
+        if (component->mUpdateIndex != Component::UpdateIndexInvalid || component->mIsUpdatePending)
+        {
+            return;
+        }
+
+        if (state.isUpdating)
+        {
+            component->mIsUpdatePending = true;
+            state.pendingComponents.emplace_back(component);
+            return;
+        }
+
+        auto const typeId = component->GetInstanceTypeId();
+        MFA_ASSERT(typeId < MaxComponentTypes);
+
+        auto & list = state.lists[typeId];
+        if (list.isCreated == false)
+        {
+            list.isCreated = true;
+            list.typeMask = component->GetInstanceTypeMask();
+            component->GetUpdateDependencies(list.dependencies);
+            state.isExecutionOrderDirty = true;
+        }
+
+        component->mUpdateTypeId = typeId;
+        component->mUpdateIndex = static_cast<uint32_t>(list.components.size());
+        list.components.emplace_back(component);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Remove(Component * component)
+    {
+        MFA_ASSERT(component != nullptr);
+        auto & state = GetState();
+
+        SCOPE_LOCK(state.lock)
+
+        if (component->mIsUpdatePending)
+        {
+            auto & pendingComponents = state.pendingComponents;
+            pendingComponents.erase(std::ranges::find(pendingComponents, component));
+            component->mIsUpdatePending = false;
+            return;
+        }
+
+        if (component->mUpdateIndex == Component::UpdateIndexInvalid || component->mIsRemovePending)
+        {
+            return;
+        }
+
+        if (state.isUpdating)
+        {
+            // Workers read the lists without the lock, So the list is not touched until the pass is over
+            component->mIsRemovePending = true;
+            state.pendingRemovals.emplace_back(component);
+            return;
+        }
+
+        auto const index = component->mUpdateIndex;
+        auto & components = state.lists[component->mUpdateTypeId].components;
+        MFA_ASSERT(index < components.size());
+        MFA_ASSERT(components[index] == component);
+
+        components[index] = components.back();
+        components[index]->mUpdateIndex = index;
+        components.pop_back();
+
+        component->mUpdateIndex = Component::UpdateIndexInvalid;
+        component->mUpdateTypeId = ComponentTypeIdInvalid;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool IsScheduled(Component const * component)
+    {
+        MFA_ASSERT(component != nullptr);
+        auto & state = GetState();
+
+        SCOPE_LOCK(state.lock)
+
+        return (component->mUpdateIndex != Component::UpdateIndexInvalid && component->mIsRemovePending == false) ||
+            component->mIsUpdatePending;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Update(float const deltaTimeInSec)
+    {
+        auto & state = GetState();
+
+        {
+            SCOPE_LOCK(state.lock)
+            MFA_ASSERT(state.isUpdating == false);
+            state.isUpdating = true;
+            if (state.isExecutionOrderDirty)
+            {
+                ComputeExecutionOrder(state);
+            }
+        }
+
+        // Lists are not modified during the pass, Add and Remove are applied after it
+        for (auto const typeId : state.executionOrder)
+        {
+            auto & components = state.lists[typeId].components;
+            JS::ParallelFor(
+                static_cast<uint32_t>(components.size()),
+                ChunkSize,
+                [&components, deltaTimeInSec](uint32_t const beginIndex, uint32_t const endIndex)->void
+                {
+                    for (auto i = beginIndex; i < endIndex; ++i)
+                    {
+                        components[i]->Update(deltaTimeInSec);
+                    }
+                }
+            );
+        }
+
+        std::vector<Component *> pendingRemovals {};
+        std::vector<Component *> pendingComponents {};
+        {
+            SCOPE_LOCK(state.lock)
+            state.isUpdating = false;
+
+            pendingRemovals.swap(state.pendingRemovals);
+            for (auto * component : pendingRemovals)
+            {
+                component->mIsRemovePending = false;
+            }
+
+            pendingComponents.swap(state.pendingComponents);
+            for (auto * component : pendingComponents)
+            {
+                component->mIsUpdatePending = false;
+            }
+        }
+
+        for (auto * component : pendingRemovals)
+        {
+            Remove(component);
+        }
+
+        for (auto * component : pendingComponents)
+        {
+            Add(component);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t GetUpdateListSize(ComponentTypeId const typeId)
+    {
+        MFA_ASSERT(typeId < MaxComponentTypes);
+        auto & state = GetState();
+
+        SCOPE_LOCK(state.lock)
+
+        return state.lists[typeId].components.size();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::vector<ComponentTypeId> GetExecutionOrder()
+    {
+        auto & state = GetState();
+
+        SCOPE_LOCK(state.lock)
+
+        if (state.isExecutionOrderDirty)
+        {
+            ComputeExecutionOrder(state);
+        }
+        return state.executionOrder;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "EntitySystemTypes.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace MFA
+{
+    class Component;
+}
+
+// Each component type that needs update event has its own update list (A system).
+// Systems run one after another in the order of their declared dependencies (See Component::GetUpdateDependencies),
+// Components of a single system are updated in parallel in contiguous chunks.
+namespace MFA::UpdateScheduler
+{
+
+    // Number of components that a single task updates
+    static constexpr uint32_t ChunkSize = 64;
+
+    // O(1), Does nothing if component is already scheduled.
+    // When called during Update, Component is added after the current pass.
+    void Add(Component * component);
+
+    // O(1), Does nothing if component is not scheduled. Safe to call during Update.
+    // When called during Update, Component is removed after the current pass and must stay alive until then
+    // (Use EntitySystem::QueueDestroyEntity).
+    void Remove(Component * component);
+
+    [[nodiscard]]
+    bool IsScheduled(Component const * component);
+
+    // Must be called from the main thread
+    void Update(float deltaTimeInSec);
+
+    // Number of components inside the update list of the exact type
+    [[nodiscard]]
+    size_t GetUpdateListSize(ComponentTypeId typeId);
+
+    // Type ids of the update lists in execution order
+    [[nodiscard]]
+    std::vector<ComponentTypeId> GetExecutionOrder();
+
+}
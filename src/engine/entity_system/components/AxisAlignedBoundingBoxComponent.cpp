@@ -181,10 +181,9 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
-    bool AxisAlignedBoundingBoxComponent::IsInsideCameraFrustum(CameraComponent const * camera)
+    glm::vec3 AxisAlignedBoundingBoxComponent::GetWorldExtent() const
     {
-        MFA_ASSERT(camera != nullptr);
-        return camera->IsPointInsideFrustum(mWorldPosition, mAABB_Extent);
+        return mAABB_Extent;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -50,9 +50,10 @@ namespace MFA
         [[nodiscard]]
         glm::vec4 const & GetWorldPosition() const override;
 
-    protected:
+        [[nodiscard]]
+        glm::vec3 GetWorldExtent() const override;
 
-        bool IsInsideCameraFrustum(CameraComponent const * camera) override;
+    protected:
 
         void computeWorldPosition();
 
@@ -1,8 +1,11 @@
 #include "BoundingVolumeComponent.hpp"
 
+#include "RigidbodyComponent.hpp"
 #include "TransformComponent.hpp"
 #include "engine/BedrockAssert.hpp"
+#include "engine/BedrockMath.hpp"
 #include "engine/BedrockString.hpp"
+#include "engine/camera/CameraComponent.hpp"
 #include "engine/entity_system/Entity.hpp"
 #include "engine/entity_system/EntitySystem.hpp"
 #include "engine/scene_manager/Scene.hpp"
@@ -10,6 +13,10 @@
 #include "engine/ui_system/UI_System.hpp"
 #include "libs/nlohmann/json.hpp"
 
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+
 //-------------------------------------------------------------------------------------------------
 
 MFA::BoundingVolumeComponent::BoundingVolumeComponent(bool const occlusionCullingEnabled)
@@ -55,8 +62,10 @@ void MFA::BoundingVolumeComponent::Update(float const deltaTimeInSec)
 {
     Component::Update(deltaTimeInSec);
 
-    // Checking if we are inside frustum or not
-    updateFrustumVisibility();
+    // Frustum test itself runs for all volumes at once after the update, See SceneManager
+    updateSpatialProxy();
+
+    updateScreenSize();
 
     // Updating BVTransform
     updateVolumeTransform();
@@ -64,10 +73,27 @@ void MFA::BoundingVolumeComponent::Update(float const deltaTimeInSec)
 
 //-------------------------------------------------------------------------------------------------
 
+void MFA::BoundingVolumeComponent::GetUpdateDependencies(std::vector<ComponentTypeId> & outDependencies) const
+{
+    Component::GetUpdateDependencies(outDependencies);
+
+    // Frustum check needs the final transform of the entity and the camera for this frame
+    outDependencies.emplace_back(RigidbodyComponent::GetTypeId());
+    outDependencies.emplace_back(CameraComponent::GetTypeId());
+}
+
+//-------------------------------------------------------------------------------------------------
+
 void MFA::BoundingVolumeComponent::Shutdown()
 {
     Component::Shutdown();
 
+    if (mProxyId != SpatialIndex::InvalidProxy)
+    {
+        SceneManager::GetSpatialIndex().Remove(mProxyId);
+        mProxyId = SpatialIndex::InvalidProxy;
+    }
+
     if (auto const ptr = mBvTransform.lock())
     {
         EntitySystem::DestroyEntity(ptr->GetEntity());
@@ -80,22 +106,28 @@ void MFA::BoundingVolumeComponent::OnUI()
 {
     Component::OnUI();
     UI::Checkbox("Occlusion culling enabled", &mOcclusionEnabled);
-    UI::Text("Is inside frustum: %s", mIsInFrustum ? "true" : "false");
+    UI::Text("Is inside frustum: %s", IsInFrustum() ? "true" : "false");
 }
 
 //-------------------------------------------------------------------------------------------------
 
 bool MFA::BoundingVolumeComponent::IsInFrustum() const
 {
-    return mIsInFrustum;
+    return SceneManager::GetSpatialIndex().IsVisible(mProxyId);
 }
 
 //-------------------------------------------------------------------------------------------------
 
-bool MFA::BoundingVolumeComponent::IsInsideCameraFrustum(CameraComponent const * camera)
+MFA::SpatialIndex::ProxyId MFA::BoundingVolumeComponent::GetProxyId() const
 {
-    MFA_ASSERT(camera != nullptr);
-    return true;
+    return mProxyId;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+float MFA::BoundingVolumeComponent::GetScreenSize() const
+{
+    return mScreenSize;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -128,7 +160,25 @@ void MFA::BoundingVolumeComponent::Deserialize(nlohmann::json const & jsonObject
 
 //-------------------------------------------------------------------------------------------------
 
-void MFA::BoundingVolumeComponent::updateFrustumVisibility()
+void MFA::BoundingVolumeComponent::updateSpatialProxy()
+{
+    // Bounds are known after the transform of the first frame, So the proxy is added lazily
+    glm::vec3 const center {GetWorldPosition()};
+    auto const extent = GetWorldExtent();
+    auto & spatialIndex = SceneManager::GetSpatialIndex();
+    if (mProxyId == SpatialIndex::InvalidProxy)
+    {
+        mProxyId = spatialIndex.Add(center, extent);
+    }
+    else
+    {
+        spatialIndex.Move(mProxyId, center, extent);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::BoundingVolumeComponent::updateScreenSize()
 {
     auto const activeScene = SceneManager::GetActiveScene();
     if (activeScene == nullptr)
@@ -140,7 +190,18 @@ void MFA::BoundingVolumeComponent::updateFrustumVisibility()
     {
         return;
     }
-    mIsInFrustum = IsInsideCameraFrustum(activeCamera.get());
+
+    auto const * cameraTransform = activeCamera->GetTransform();
+    if (cameraTransform != nullptr)
+    {
+        auto const distance = glm::distance(
+            glm::vec3(GetWorldPosition()),
+            glm::vec3(cameraTransform->GetWorldPosition())
+        );
+        auto const radius = GetRadius();
+        auto const halfFovTan = tanf(Math::Deg2Rad(activeCamera->GetFieldOfView() * 0.5f));
+        mScreenSize = distance > radius ? std::min(radius / (distance * halfFovTan), 1.0f) : 1.0f;
+    }
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/entity_system/Component.hpp"
+#include "engine/scene_manager/SpatialIndex.hpp"
 
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
@@ -26,13 +27,24 @@ namespace MFA {
 
         void Update(float deltaTimeInSec) override;
 
+        void GetUpdateDependencies(std::vector<ComponentTypeId> & outDependencies) const override;
+
         void Shutdown() override;
 
         void OnUI() override;
 
+        // Result of the culling pass of the scene for the previous update
         [[nodiscard]]
         bool IsInFrustum() const;
 
+        // Id of the volume inside the spatial index of the scene, Invalid until the first update
+        [[nodiscard]]
+        SpatialIndex::ProxyId GetProxyId() const;
+
+        // Projected radius relative to half of the screen height (0 to 1), Used for level of detail
+        [[nodiscard]]
+        float GetScreenSize() const;
+
         [[nodiscard]]
         virtual glm::vec3 const & GetLocalPosition() const = 0;
 
@@ -45,6 +57,10 @@ namespace MFA {
         [[nodiscard]]
         virtual glm::vec4 const & GetWorldPosition() const = 0;
 
+        // Half size of the world space axis aligned box that contains the volume
+        [[nodiscard]]
+        virtual glm::vec3 GetWorldExtent() const = 0;
+
         std::weak_ptr<TransformComponent> GetVolumeTransform();
 
         [[nodiscard]]
@@ -54,17 +70,17 @@ namespace MFA {
 
         void Deserialize(nlohmann::json const & jsonObject) override;
 
-    protected:
-
-        virtual bool IsInsideCameraFrustum(CameraComponent const * camera);
-
     private:
 
-        void updateFrustumVisibility();
+        void updateSpatialProxy();
+
+        void updateScreenSize();
 
         void updateVolumeTransform() const;
 
-        bool mIsInFrustum = false;
+        SpatialIndex::ProxyId mProxyId = SpatialIndex::InvalidProxy;
+
+        float mScreenSize = 1.0f;
 
         bool mOcclusionEnabled = false;
 
@@ -33,15 +33,17 @@ namespace MFA
     {
         RendererComponent::Init();
 
+        mStreamRequest = std::make_shared<RC::StreamRequest>();
         RC::AcquireEssence(mNameId, mPipeline, [this](bool const success)->void{
             MFA_ASSERT(JS::IsMainThread());
             MFA_ASSERT(success == true);
+            mStreamRequest = nullptr;
             mEssenceLoaded = true;
             if (mLateInitIsCalled)
             {
                 createVariant();
             }
-        });
+        }, true, mStreamRequest);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -39,15 +39,32 @@ namespace MFA
             MFA_ASSERT(mNameId.empty() == false);
         }
 
+        mStreamRequest = std::make_shared<RC::StreamRequest>();
         RC::AcquirePhysicsMesh(
             mNameId,
             mIsConvex,
             [this](std::shared_ptr<Physics::TriangleMeshGroup> const & meshGroup)->void{
+                mStreamRequest = nullptr;
                 mPhysicsMesh = meshGroup;
                 ColliderComponent::Init();
-            }
+            },
+            true,
+            mStreamRequest
         );
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MeshColliderComponent::Shutdown()
+    {
+        // Callback would initialize the collider after shutdown
+        if (mStreamRequest != nullptr)
+        {
+            mStreamRequest->Cancel();
+            mStreamRequest = nullptr;
+        }
+        ColliderComponent::Shutdown();
+    }
     
     //-------------------------------------------------------------------------------------------------
 
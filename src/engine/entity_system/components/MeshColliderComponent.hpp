@@ -2,6 +2,7 @@
 
 #include "ColliderComponent.hpp"
 #include "engine/entity_system/Component.hpp"
+#include "engine/resource_manager/StreamingScheduler.hpp"
 
 #include <string>
 
@@ -23,6 +24,8 @@ namespace MFA
 
         void Init() override;
 
+        void Shutdown() override;
+
         void Serialize(nlohmann::json & jsonObject) const override;
 
         void Deserialize(nlohmann::json const & jsonObject) override;
@@ -39,6 +42,7 @@ namespace MFA
         bool mIsConvex = false;
         std::shared_ptr<physx::PxGeometry> mGeometry {};
         std::shared_ptr<Physics::TriangleMeshGroup> mPhysicsMesh {};
+        std::shared_ptr<ResourceManager::StreamRequest> mStreamRequest {};      // While the physics mesh is loading
     };
 
     using MeshCollider = MeshColliderComponent;
@@ -33,12 +33,29 @@ namespace MFA
 
         mInitialized = true;
 
+        mBoundingVolume = GetEntity()->GetComponent<BoundingVolumeComponent>();
+
+        mStreamRequest = std::make_shared<RC::StreamRequest>(computeStreamPriority());
         RC::AcquireEssence(mNameId, mPipeline, [this](bool success)->void{
+            mStreamRequest = nullptr;
             if (MFA_VERIFY(success))
             {
                 createVariant();
             }
-        });
+        }, true, mStreamRequest);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MeshRendererComponent::Update(float const deltaTimeInSec)
+    {
+        RendererComponent::Update(deltaTimeInSec);
+
+        // Callback runs on the main thread between updates, So the request does not change during the update
+        if (mStreamRequest != nullptr)
+        {
+            mStreamRequest->SetPriority(computeStreamPriority());
+        }
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -94,4 +111,16 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    float MeshRendererComponent::computeStreamPriority() const
+    {
+        auto const boundingVolume = mBoundingVolume.lock();
+        if (boundingVolume == nullptr)
+        {
+            return RC::StreamRequest::DefaultPriority;
+        }
+        return RC::ComputeStreamPriority(boundingVolume->GetScreenSize(), boundingVolume->IsInFrustum());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
 }
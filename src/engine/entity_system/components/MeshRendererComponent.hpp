@@ -12,6 +12,7 @@ namespace MFA
     }
 
     class PBR_Variant;
+    class BoundingVolumeComponent;
 
     class MeshRendererComponent final : public RendererComponent
     {
@@ -19,7 +20,7 @@ namespace MFA
 
         MFA_COMPONENT_PROPS(
             MeshRendererComponent,
-            EventTypes::InitEvent | EventTypes::ShutdownEvent,
+            EventTypes::InitEvent | EventTypes::UpdateEvent | EventTypes::ShutdownEvent,
             RendererComponent
         )
 
@@ -27,6 +28,9 @@ namespace MFA
 
         void Init() override;
 
+        // Keeps the priority of the essence load in sync with the screen size of the entity until it is loaded
+        void Update(float deltaTimeInSec) override;
+
         void Shutdown() override;
 
         void OnUI() override;
@@ -37,7 +41,11 @@ namespace MFA
         
         void createVariant();
 
+        [[nodiscard]]
+        float computeStreamPriority() const;
+
         bool mInitialized = false;
+        std::weak_ptr<BoundingVolumeComponent> mBoundingVolume {};
 
     };
 
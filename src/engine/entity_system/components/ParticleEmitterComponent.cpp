@@ -0,0 +1,82 @@
+#include "ParticleEmitterComponent.hpp"
+
+#include "engine/entity_system/Entity.hpp"
+#include "engine/ui_system/UI_System.hpp"
+#include "tools/JsonUtils.hpp"
+
+#include "libs/nlohmann/json.hpp"
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::ParticleEmitterComponent::SetParams(AS::Particle::EmitterParams const & params)
+{
+    mParams = params;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+MFA::AS::Particle::EmitterParams const & MFA::ParticleEmitterComponent::GetParams() const
+{
+    return mParams;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::ParticleEmitterComponent::OnUI()
+{
+    if (UI::TreeNode("ParticleEmitter"))
+    {
+        Component::OnUI();
+        UI::InputFloat("SpawnRate", mParams.spawnRate);
+        UI::InputFloat("MinLife", mParams.minLife);
+        UI::InputFloat("MaxLife", mParams.maxLife);
+        UI::InputFloat("MinSpeed", mParams.minSpeed);
+        UI::InputFloat("MaxSpeed", mParams.maxSpeed);
+        UI::InputFloat("Radius", mParams.radius);
+        UI::InputFloat("SizeScale", mParams.sizeScale);
+        UI::InputFloat("MoveDirection", mParams.moveDirection);
+        UI::InputFloat("Color", mParams.color);
+        UI::TreePop();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::ParticleEmitterComponent::Clone(Entity * entity) const
+{
+    MFA_ASSERT(entity != nullptr);
+    entity->AddComponent<ParticleEmitterComponent>(mParams);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::ParticleEmitterComponent::Serialize(nlohmann::json & jsonObject) const
+{
+    jsonObject["SpawnRate"] = mParams.spawnRate;
+    jsonObject["MinLife"] = mParams.minLife;
+    jsonObject["MaxLife"] = mParams.maxLife;
+    jsonObject["MinSpeed"] = mParams.minSpeed;
+    jsonObject["MaxSpeed"] = mParams.maxSpeed;
+    jsonObject["Radius"] = mParams.radius;
+    jsonObject["SizeScale"] = mParams.sizeScale;
+    JsonUtils::SerializeVec3(jsonObject, "MoveDirection", mParams.moveDirection);
+    JsonUtils::SerializeVec3(jsonObject, "Color", mParams.color);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::ParticleEmitterComponent::Deserialize(nlohmann::json const & jsonObject)
+{
+    AS::Particle::EmitterParams const defaultParams {};
+    mParams.spawnRate = jsonObject.value("SpawnRate", defaultParams.spawnRate);
+    mParams.minLife = jsonObject.value("MinLife", defaultParams.minLife);
+    mParams.maxLife = jsonObject.value("MaxLife", defaultParams.maxLife);
+    mParams.minSpeed = jsonObject.value("MinSpeed", defaultParams.minSpeed);
+    mParams.maxSpeed = jsonObject.value("MaxSpeed", defaultParams.maxSpeed);
+    mParams.radius = jsonObject.value("Radius", defaultParams.radius);
+    mParams.sizeScale = jsonObject.value("SizeScale", defaultParams.sizeScale);
+    JsonUtils::DeserializeVec3(jsonObject, "MoveDirection", mParams.moveDirection);
+    JsonUtils::DeserializeVec3(jsonObject, "Color", mParams.color);
+}
+
+//-------------------------------------------------------------------------------------------------
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "engine/entity_system/Component.hpp"
+#include "engine/asset_system/AssetParticleMesh.hpp"
+
+namespace MFA {
+
+class ParticleEmitterComponent final : public Component
+{
+
+public:
+
+    MFA_COMPONENT_PROPS(
+        ParticleEmitterComponent,
+        EventTypes::EmptyEvent,
+        Component
+    )
+
+    explicit ParticleEmitterComponent() = default;
+
+    explicit ParticleEmitterComponent(AS::Particle::EmitterParams const & params) : mParams(params) {}
+
+    void SetParams(AS::Particle::EmitterParams const & params);
+
+    [[nodiscard]]
+    AS::Particle::EmitterParams const & GetParams() const;
+
+    void OnUI() override;
+
+    void Clone(Entity * entity) const override;
+
+    void Serialize(nlohmann::json & jsonObject) const override;
+
+    void Deserialize(nlohmann::json const & jsonObject) override;
+
+private:
+
+    AS::Particle::EmitterParams mParams {};
+};
+
+}
@@ -146,25 +146,22 @@ bool MFA::PointLightComponent::IsVisible() const
 //-------------------------------------------------------------------------------------------------
 
 bool MFA::PointLightComponent::IsBoundingVolumeInRange(BoundingVolumeComponent const * bvComponent) const
+{
+    return SpatialIndex::TestBit(mObjectsInRange, bvComponent->GetProxyId());
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::PointLightComponent::UpdateObjectsInRange(SpatialIndex const & spatialIndex)
 {
     auto const transformComponent = mTransformComponent.lock();
     if (transformComponent == nullptr)
     {
-        return false;
+        mObjectsInRange.clear();
+        return;
     }
 
-    auto const & lightWP = transformComponent->GetWorldPosition();
-
-    auto const & bvWP = bvComponent->GetWorldPosition();
-    auto const bvRadius = bvComponent->GetRadius();
-
-    auto const xDiff = bvWP.x - lightWP.x;
-    auto const yDiff = bvWP.y - lightWP.y;
-    auto const zDiff = bvWP.z - lightWP.z;
-
-    float const squareDistance = ((xDiff * xDiff) + (yDiff * yDiff) + (zDiff * zDiff)) - (bvRadius * bvRadius);
-
-    return squareDistance <= mMaxSquareDistance;
+    spatialIndex.QuerySphere(glm::vec3(transformComponent->GetWorldPosition()), mMaxDistance, mObjectsInRange);
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -3,6 +3,7 @@
 #include "ColorComponent.hpp"
 #include "TransformComponent.hpp"
 #include "engine/entity_system/Component.hpp"
+#include "engine/scene_manager/SpatialIndex.hpp"
 
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
@@ -51,8 +52,13 @@ namespace MFA {
         [[nodiscard]]
         bool IsVisible() const;
 
+        // Result of the last UpdateObjectsInRange
+        [[nodiscard]]
         bool IsBoundingVolumeInRange(BoundingVolumeComponent const * bvComponent) const;
 
+        // Collects the bounding volumes within max distance of the light with a single tree query
+        void UpdateObjectsInRange(SpatialIndex const & spatialIndex);
+
         void GetShadowViewProjectionMatrices(float outData[6][16]) const;
 
         [[nodiscard]]
@@ -95,6 +101,8 @@ namespace MFA {
         float mProjectionFarDistance = 0.0f;                        // Used for shadow projection
 
         float mMaxSquareDistance = 0.0f;
+
+        ProxyBitset mObjectsInRange {};
         float mLinearAttenuation = 0.0f;
         float mQuadraticAttenuation = 0.0f;
 
@@ -13,6 +13,11 @@
 void MFA::RendererComponent::Shutdown()
 {
     Component::Shutdown();
+    if (mStreamRequest != nullptr)
+    {
+        mStreamRequest->Cancel();
+        mStreamRequest = nullptr;
+    }
     if (auto const variant = mVariant.lock())
     {
         mPipeline->removeVariant(*variant);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/entity_system/Component.hpp"
+#include "engine/resource_manager/StreamingScheduler.hpp"
 
 namespace MFA {
 
@@ -32,6 +33,8 @@ namespace MFA {
         std::string mNameId {};
         BasePipeline * mPipeline = nullptr;
         std::weak_ptr<VariantBase> mVariant {};
+        // Request of the essence while it is loading, Cancelled on shutdown so the load callback never outlives the component
+        std::shared_ptr<ResourceManager::StreamRequest> mStreamRequest {};
 
     };
 
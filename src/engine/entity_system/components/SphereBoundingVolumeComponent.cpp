@@ -82,11 +82,9 @@ void MFA::SphereBoundingVolumeComponent::Deserialize(nlohmann::json const & json
 
 //-------------------------------------------------------------------------------------------------
 
-bool MFA::SphereBoundingVolumeComponent::IsInsideCameraFrustum(CameraComponent const * camera)
+glm::vec3 MFA::SphereBoundingVolumeComponent::GetWorldExtent() const
 {
-    MFA_ASSERT(camera != nullptr);
-    // TODO
-    return true;
+    return glm::vec3 {mRadius};
 }
 
 //-------------------------------------------------------------------------------------------------
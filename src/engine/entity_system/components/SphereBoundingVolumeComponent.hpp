@@ -35,16 +35,15 @@ namespace MFA
         [[nodiscard]]
         glm::vec4 const & GetWorldPosition() const override;
 
+        [[nodiscard]]
+        glm::vec3 GetWorldExtent() const override;
+
         void Clone(Entity * entity) const override;
 
         void Serialize(nlohmann::json & jsonObject) const override;
 
         void Deserialize(nlohmann::json const & jsonObject) override;
 
-    protected:
-
-        bool IsInsideCameraFrustum(CameraComponent const * camera) override;
-
     private:
 
         float mRadius = 0.0f;
@@ -275,8 +275,8 @@ namespace MFA
         // Rotation
         auto const & rotationMatrix = mWorldRotation.GetMatrix();
 
-        mWorldTransform = translateMatrix * scaleMatrix * rotationMatrix;
-        mInverseWorldTransform = glm::inverse(mWorldTransform);
+        mWorldTransform = Matrix::Multiply(Matrix::Multiply(translateMatrix, scaleMatrix), rotationMatrix);
+        mInverseWorldTransform = Matrix::AffineInverse(mWorldTransform);
 
         if (auto const parentTransform = mParentTransform.lock())
         {
@@ -496,9 +496,9 @@ namespace MFA
             pWorldScale = ptr->GetWorldScale();
         }
 
-        mWorldTransform = pMatrix * translateMatrix * scaleMatrix * rotationMatrix;
+        mWorldTransform = Matrix::Multiply(pMatrix, Matrix::Multiply(Matrix::Multiply(translateMatrix, scaleMatrix), rotationMatrix));
 
-        mInverseWorldTransform = glm::inverse(mWorldTransform);
+        mInverseWorldTransform = Matrix::AffineInverse(mWorldTransform);
 
         auto previousWorldPosition = mWorldPosition;
         mWorldPosition = mWorldTransform * glm::vec4 { 0, 0, 0, 1.0f };
@@ -4,6 +4,11 @@
 #include "ThreadPool.hpp"
 #include "engine/BedrockAssert.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
 namespace MFA::JobSystem
 {
 
@@ -69,6 +74,89 @@ namespace MFA::JobSystem
 
     //-------------------------------------------------------------------------------------------------
 
+    void ParallelFor(uint32_t const itemCount, uint32_t const chunkSize, ParallelForCallback const & callback)
+    {
+        MFA_ASSERT(callback != nullptr);
+        MFA_ASSERT(chunkSize > 0);
+
+        if (itemCount == 0)
+        {
+            return;
+        }
+
+        auto const chunkCount = (itemCount + chunkSize - 1) / chunkSize;
+        // Thread pool runs the tasks on the calling thread when it has less than two threads
+        if (chunkCount == 1 || state == nullptr || GetNumberOfAvailableThreads() < 2)
+        {
+            callback(0, itemCount);
+            return;
+        }
+
+        // Helpers can start after the call has returned, So they only share this context.
+        // Callback is only used by a thread that claimed a chunk, That can only happen while the caller waits.
+        struct Context
+        {
+            std::atomic<uint32_t> nextChunk = 0;
+            std::atomic<uint32_t> remainingChunks = 0;
+            uint32_t chunkCount = 0;
+            uint32_t chunkSize = 0;
+            uint32_t itemCount = 0;
+            ParallelForCallback const * callback = nullptr;
+        };
+        auto context = std::make_shared<Context>();
+        context->remainingChunks = chunkCount;
+        context->chunkCount = chunkCount;
+        context->chunkSize = chunkSize;
+        context->itemCount = itemCount;
+        context->callback = &callback;
+
+        // Threads pick the next chunk as soon as they are done, So uneven chunks do not stall a whole thread
+        auto const processChunks = [](Context & context)->void
+        {
+            while (true)
+            {
+                auto const chunkIndex = context.nextChunk.fetch_add(1);
+                if (chunkIndex >= context.chunkCount)
+                {
+                    break;
+                }
+                // Chunk counts as done even when the callback throws, So the caller never waits forever
+                struct CompleteOnExit
+                {
+                    std::atomic<uint32_t> & remainingChunks;
+                    ~CompleteOnExit()
+                    {
+                        remainingChunks.fetch_sub(1, std::memory_order_release);
+                    }
+                } const completeOnExit {context.remainingChunks};
+
+                auto const beginIndex = chunkIndex * context.chunkSize;
+                auto const endIndex = std::min(beginIndex + context.chunkSize, context.itemCount);
+                (*context.callback)(beginIndex, endIndex);
+            }
+        };
+
+        // Helpers are queued like any other job, The caller does not wait for them to start
+        auto const helperCount = std::min(GetNumberOfAvailableThreads(), chunkCount - 1);
+        for (uint32_t i = 0; i < helperCount; ++i)
+        {
+            state->threadPool.AssignTask([context, processChunks](ThreadNumber, ThreadNumber)->void
+            {
+                processChunks(*context);
+            });
+        }
+
+        // Caller works on the chunks too, So the loop finishes even when every worker is busy with other jobs.
+        // Only the chunks that other threads are still running are waited for.
+        processChunks(*context);
+        while (context->remainingChunks.load(std::memory_order_acquire) > 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     uint32_t GetNumberOfAvailableThreads()
     {
         return state->threadPool.GetNumberOfAvailableThreads();
@@ -88,6 +176,7 @@ namespace MFA::JobSystem
         MFA_ASSERT(state != nullptr);
         WaitForThreadsToFinish();
         delete state;
+        state = nullptr;
     }
 
     //-------------------------------------------------------------------------------------------------
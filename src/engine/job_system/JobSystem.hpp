@@ -12,6 +12,11 @@ namespace MFA::JobSystem
     void AssignTask(Task const & task, OnFinishCallback const & onTaskFinished = nullptr);
 
     void AssignTaskPerThread(Task const & task, OnFinishCallback const & onTaskFinished = nullptr);
+
+    // Splits [0, itemCount) into chunks of chunkSize and processes them on the calling thread and the workers.
+    // Blocks until the chunks of this call are done, Other jobs of the pool are not waited for.
+    // Can be called from any thread, The calling thread processes chunks too so it never waits for a busy pool.
+    void ParallelFor(uint32_t itemCount, uint32_t chunkSize, ParallelForCallback const & callback);
     
     [[nodiscard]]
     uint32_t GetNumberOfAvailableThreads();
@@ -7,6 +7,8 @@ namespace MFA::JobSystem {
     using ThreadNumber = uint32_t;
     using Task = std::function<void(ThreadNumber threadNumber, ThreadNumber totalThreadCount)>;
     using OnFinishCallback = std::function<void()>;
+    // Range is [beginIndex, endIndex)
+    using ParallelForCallback = std::function<void(uint32_t beginIndex, uint32_t endIndex)>;
 }
 
 namespace MFA
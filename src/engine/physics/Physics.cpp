@@ -4,6 +4,7 @@
 #include "PhysicsTypes.hpp"
 #include "engine/BedrockAssert.hpp"
 #include "engine/BedrockMatrix.hpp"
+#include "engine/BedrockHash.hpp"
 
 #include "physx/PxPhysicsAPI.h"
 
@@ -78,6 +79,7 @@ namespace MFA::Physics
         SimulationEventCallback simulationEventCallback{};
         SharedHandle<PxMaterial> defaultMaterial{};
         SharedHandle<PxCooking> cooking{};
+        uint64_t cookingHash = 0;
     };
     State * state = nullptr;
 
@@ -93,6 +95,24 @@ namespace MFA::Physics
 
     //-------------------------------------------------------------------------------------------------
 
+    static uint64_t ComputeCookingHash(PxCookingParams const & params)
+    {
+        uint64_t hash = Hash::FnvOffsetBasis;
+        hash = Hash::Combine(hash, static_cast<uint32_t>(PX_PHYSICS_VERSION));
+        hash = Hash::Combine(hash, params.scale.length);
+        hash = Hash::Combine(hash, params.scale.speed);
+        hash = Hash::Combine(hash, static_cast<uint32_t>(params.meshPreprocessParams));
+        hash = Hash::Combine(hash, static_cast<uint32_t>(params.midphaseDesc.getType()));
+        hash = Hash::Combine(hash, static_cast<uint32_t>(params.midphaseDesc.mBVH33Desc.meshCookingHint));
+        hash = Hash::Combine(hash, params.midphaseDesc.mBVH33Desc.meshSizePerformanceTradeOff);
+        hash = Hash::Combine(hash, params.meshWeldTolerance);
+        hash = Hash::Combine(hash, static_cast<uint32_t>(params.buildTriangleAdjacencies));
+        hash = Hash::Combine(hash, static_cast<uint32_t>(params.buildGPUData));
+        return hash;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void Init(InitParams const & params)
     {
         state = new State();
@@ -183,6 +203,7 @@ namespace MFA::Physics
             state->foundation->Ref(),
             cookingParams
         ));
+        state->cookingHash = ComputeCookingHash(cookingParams);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -262,26 +283,72 @@ namespace MFA::Physics
     {
         SharedHandle<PxTriangleMesh> mesh = nullptr;
 
+        auto const cookedData = CookTriangleMesh(meshDesc);
+        if (cookedData != nullptr)
+        {
+            mesh = CreateTriangleMesh(cookedData->memory);
+        }
+
+        return mesh;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::shared_ptr<SmartBlob> CookTriangleMesh(PxTriangleMeshDesc const & meshDesc)
+    {
+        std::shared_ptr<SmartBlob> cookedData = nullptr;
+
         PxDefaultMemoryOutputStream buf;
         PxTriangleMeshCookingResult::Enum result;
 
         bool const cookResult = state->cooking->Ptr()->cookTriangleMesh(meshDesc, buf, &result);
         MFA_ASSERT(cookResult == true);
-        //if (MFA_VERIFY(cookResult == true))
         if (cookResult)
         {
-            PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
-            mesh = CreateHandle(state->physics->Ptr()->createTriangleMesh(input));
+            cookedData = Memory::Alloc(buf.getSize(), Memory::Tag::Physics);
+            ::memcpy(cookedData->memory.ptr, buf.getData(), buf.getSize());
         } else
         {
             MFA_LOG_WARN("Cooking failed!");
         }
 
+        return cookedData;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    SharedHandle<PxTriangleMesh> CreateTriangleMesh(CBlob const cookedData)
+    {
+        MFA_ASSERT(cookedData.ptr != nullptr);
+        MFA_ASSERT(cookedData.len > 0);
+
+        SharedHandle<PxTriangleMesh> mesh = nullptr;
+
+        PxDefaultMemoryInputData input(
+            const_cast<PxU8 *>(cookedData.ptr),
+            static_cast<PxU32>(cookedData.len)
+        );
+        auto * pxMesh = state->physics->Ptr()->createTriangleMesh(input);
+        if (pxMesh != nullptr)
+        {
+            mesh = CreateHandle(pxMesh);
+        } else
+        {
+            MFA_LOG_WARN("Failed to create triangle mesh from cooked data");
+        }
+
         return mesh;
     }
 
     //-------------------------------------------------------------------------------------------------
 
+    uint64_t GetCookingHash()
+    {
+        return state->cookingHash;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     PxShape * CreateShape(
         PxRigidActor & actor,
         PxGeometry const & geometry,
@@ -50,6 +50,17 @@ namespace MFA::Physics// final : public IPhysicsWorld, public PxSimulationEventC
 
     SharedHandle<physx::PxTriangleMesh> CreateTriangleMesh(physx::PxTriangleMeshDesc const & meshDesc);
 
+    // Returns the cooked (serialized) representation of the mesh. Can be called from any thread.
+    [[nodiscard]]
+    std::shared_ptr<SmartBlob> CookTriangleMesh(physx::PxTriangleMeshDesc const & meshDesc);
+
+    // Creates the mesh from data that is previously generated by CookTriangleMesh
+    SharedHandle<physx::PxTriangleMesh> CreateTriangleMesh(CBlob cookedData);
+
+    // Changes whenever physx version or cooking parameters change. Used to invalidate cooked data on disk.
+    [[nodiscard]]
+    uint64_t GetCookingHash();
+
     void AddActor(physx::PxActor & actor);
 
     void RemoveActor(physx::PxActor & actor);
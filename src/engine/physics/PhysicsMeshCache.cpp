@@ -0,0 +1,216 @@
+#include "PhysicsMeshCache.hpp"
+
+#include "Physics.hpp"
+#include "engine/BedrockAssert.hpp"
+#include "engine/BedrockFileSystem.hpp"
+#include "engine/BedrockHash.hpp"
+#include "engine/BedrockPath.hpp"
+
+#include <filesystem>
+
+namespace MFA::Physics::MeshCache
+{
+
+    static constexpr char const * CacheDirectory = "cache/physics";
+    static constexpr uint32_t Magic = 0x4D465043;          // MFPC
+    static constexpr uint32_t FormatVersion = 1;
+
+    struct Header
+    {
+        uint32_t magic = Magic;
+        uint32_t formatVersion = FormatVersion;
+        uint64_t cookingHash = 0;
+        uint64_t sourceSize = 0;
+        int64_t sourceWriteTime = 0;
+        uint32_t meshType = 0;
+        uint32_t meshCount = 0;
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    static std::string CacheFilePath(Key const & key)
+    {
+        auto hash = Hash::Fnv1a(key.modelPath);
+        hash = Hash::Combine(hash, static_cast<uint32_t>(key.meshType));
+
+        char fileName[32] {};
+        auto const length = snprintf(fileName, sizeof(fileName), "%016llx.pxcache", static_cast<unsigned long long>(hash));
+
+        return Path::ForReadWrite(std::string(CacheDirectory) + "/" + std::string(fileName, length));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static bool ReadSourceInfo(Key const & key, uint64_t & outSize, int64_t & outWriteTime)
+    {
+        std::error_code errorCode {};
+        auto const sourcePath = std::filesystem::path(Path::ForReadWrite(key.modelPath));
+
+        outSize = std::filesystem::file_size(sourcePath, errorCode);
+        if (errorCode)
+        {
+            return false;
+        }
+
+        auto const writeTime = std::filesystem::last_write_time(sourcePath, errorCode);
+        if (errorCode)
+        {
+            return false;
+        }
+        outWriteTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool IsCacheable(Key const & key)
+    {
+#if defined(__DESKTOP__)
+        return key.modelPath.empty() == false && FS::Exists(Path::ForReadWrite(key.modelPath));
+#else
+        // Assets are read-only on mobile platforms
+        return false;
+#endif
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Load(Key const & key, CookedMeshList & outCookedMeshes)
+    {
+        outCookedMeshes.clear();
+
+        if (IsCacheable(key) == false)
+        {
+            return false;
+        }
+
+        auto const file = FS::OpenFile(CacheFilePath(key), FS::Usage::Read);
+        if (FS::FileIsUsable(file.get()) == false)
+        {
+            return false;
+        }
+
+        Header header {};
+        if (file->read(Blob {&header, sizeof(header)}) != sizeof(header))
+        {
+            return false;
+        }
+
+        uint64_t sourceSize = 0;
+        int64_t sourceWriteTime = 0;
+        if (
+            header.magic != Magic ||
+            header.formatVersion != FormatVersion ||
+            header.cookingHash != GetCookingHash() ||
+            header.meshType != static_cast<uint32_t>(key.meshType) ||
+            ReadSourceInfo(key, sourceSize, sourceWriteTime) == false ||
+            header.sourceSize != sourceSize ||
+            header.sourceWriteTime != sourceWriteTime
+        )
+        {
+            return false;
+        }
+
+        auto const fileSize = file->size();
+        uint64_t remainingBytes = fileSize - sizeof(header);
+
+        for (uint32_t i = 0; i < header.meshCount; ++i)
+        {
+            uint64_t meshSize = 0;
+            if (
+                remainingBytes < sizeof(meshSize) ||
+                file->read(Blob {&meshSize, sizeof(meshSize)}) != sizeof(meshSize)
+            )
+            {
+                outCookedMeshes.clear();
+                return false;
+            }
+            remainingBytes -= sizeof(meshSize);
+
+            if (meshSize == 0 || meshSize > remainingBytes)
+            {
+                outCookedMeshes.clear();
+                return false;
+            }
+
+            auto cookedMesh = Memory::Alloc(meshSize, Memory::Tag::Physics);
+            if (file->read(cookedMesh->memory) != meshSize)
+            {
+                outCookedMeshes.clear();
+                return false;
+            }
+            remainingBytes -= meshSize;
+
+            outCookedMeshes.emplace_back(std::move(cookedMesh));
+        }
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Save(Key const & key, CookedMeshList const & cookedMeshes)
+    {
+        if (IsCacheable(key) == false)
+        {
+            return false;
+        }
+
+        Header header {};
+        header.cookingHash = GetCookingHash();
+        header.meshType = static_cast<uint32_t>(key.meshType);
+        header.meshCount = static_cast<uint32_t>(cookedMeshes.size());
+        if (ReadSourceInfo(key, header.sourceSize, header.sourceWriteTime) == false)
+        {
+            return false;
+        }
+
+        std::error_code errorCode {};
+        std::filesystem::create_directories(Path::ForReadWrite(CacheDirectory), errorCode);
+        if (errorCode)
+        {
+            MFA_LOG(Warning, Physics, "Failed to create physics cache directory: %s", errorCode.message().c_str());
+            return false;
+        }
+
+        // We write into a temporary file first so a crash or concurrent reader never sees a half written cache
+        auto const cachePath = CacheFilePath(key);
+        auto const tempPath = cachePath + ".tmp";
+
+        bool success = true;
+        {
+            auto const file = FS::OpenFile(tempPath, FS::Usage::Write);
+            if (FS::FileIsUsable(file.get()) == false)
+            {
+                return false;
+            }
+
+            success &= file->write(CBlobAliasOf(header)) == sizeof(header);
+            for (auto const & cookedMesh : cookedMeshes)
+            {
+                MFA_ASSERT(cookedMesh != nullptr);
+                uint64_t const meshSize = cookedMesh->memory.len;
+                success &= file->write(CBlobAliasOf(meshSize)) == sizeof(meshSize);
+                success &= file->write(cookedMesh->memory) == meshSize;
+            }
+        }
+
+        if (success)
+        {
+            std::filesystem::rename(tempPath, cachePath, errorCode);
+            success = !errorCode;
+        }
+
+        if (success == false)
+        {
+            std::filesystem::remove(tempPath, errorCode);
+            MFA_LOG(Warning, Physics, "Failed to write physics cache for %s", key.modelPath.c_str());
+        }
+
+        return success;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "engine/BedrockMemory.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Disk cache for cooked physics meshes. Cooking (specially midphase construction for large meshes) is expensive,
+// So we cook each model once and store the result next to the assets.
+namespace MFA::Physics::MeshCache
+{
+
+    enum class MeshType : uint32_t
+    {
+        Triangle = 0,
+        Convex = 1,         // Reserved, Convex meshes are not supported yet
+    };
+
+    struct Key
+    {
+        std::string modelPath {};           // Relative to asset folder
+        MeshType meshType = MeshType::Triangle;
+        // Note: Mesh scale is not part of the key because it is applied at runtime using PxMeshScale
+    };
+
+    using CookedMeshList = std::vector<std::shared_ptr<SmartBlob>>;
+
+    // Returns false if there is no valid entry for the key. Can be called from any thread.
+    [[nodiscard]]
+    bool Load(Key const & key, CookedMeshList & outCookedMeshes);
+
+    // Can be called from any thread, Only one thread should write a key at a time.
+    bool Save(Key const & key, CookedMeshList const & cookedMeshes);
+
+    // Returns false if the source model does not exist on disk (Generated shapes for example)
+    [[nodiscard]]
+    bool IsCacheable(Key const & key);
+
+}
@@ -0,0 +1,131 @@
+#include "DynamicResolution.hpp"
+
+#include "engine/BedrockAssert.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MFA
+{
+
+    //-------------------------------------------------------------------------------------------------
+
+    DynamicResolution::DynamicResolution()
+        : DynamicResolution(Params {})
+    {}
+
+    //-------------------------------------------------------------------------------------------------
+
+    DynamicResolution::DynamicResolution(Params const & params, float const initialScale)
+        : mParams(params)
+    {
+        Reset(initialScale);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void DynamicResolution::SetParams(Params const & params)
+    {
+        MFA_ASSERT(params.minScale > 0.0f && params.minScale <= params.maxScale);
+        MFA_ASSERT(params.targetFrameTimeMs > 0.0f);
+        mParams = params;
+        mScale = clampScale(mScale);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void DynamicResolution::Reset(float const scale)
+    {
+        mScale = clampScale(scale);
+        mAverageFrameTimeMs = 0.0f;
+        mHasSample = false;
+        mFramesSinceChange = 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    float DynamicResolution::Update(float const gpuFrameTimeMs)
+    {
+        if (gpuFrameTimeMs <= 0.0f)
+        {
+            return mScale;
+        }
+
+        if (mHasSample == false)
+        {
+            mAverageFrameTimeMs = gpuFrameTimeMs;
+            mHasSample = true;
+        }
+        else
+        {
+            mAverageFrameTimeMs += (gpuFrameTimeMs - mAverageFrameTimeMs) * mParams.smoothing;
+        }
+
+        ++mFramesSinceChange;
+        if (mFramesSinceChange < mParams.cooldownFrames)
+        {
+            return mScale;
+        }
+
+        auto const target = mParams.targetFrameTimeMs;
+        bool const isOverBudget = mAverageFrameTimeMs > target * mParams.decreaseThreshold;
+        bool const hasHeadroom = mAverageFrameTimeMs < target * mParams.increaseThreshold;
+        if (isOverBudget == false && hasHeadroom == false)
+        {
+            return mScale;
+        }
+
+        // Going up only aims for the increase threshold, Otherwise the next frames would be over budget again
+        auto const desiredTime = isOverBudget ? target : target * mParams.increaseThreshold;
+        auto desiredScale = mScale * std::sqrt(desiredTime / mAverageFrameTimeMs);
+        desiredScale = std::clamp(desiredScale, mScale - mParams.maxStep, mScale + mParams.maxStep);
+
+        // Rounding down errs on the side of staying within the budget in both directions
+        desiredScale = std::floor(desiredScale / mParams.quantization + 0.001f) * mParams.quantization;
+        desiredScale = clampScale(desiredScale);
+
+        if (std::abs(desiredScale - mScale) < mParams.quantization * 0.5f)
+        {
+            return mScale;
+        }
+
+        // Average is predicted for the new scale, It would take many frames for the samples to catch up
+        auto const ratio = desiredScale / mScale;
+        mAverageFrameTimeMs *= ratio * ratio;
+        mScale = desiredScale;
+        mFramesSinceChange = 0;
+
+        return mScale;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    float DynamicResolution::GetScale() const
+    {
+        return mScale;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    float DynamicResolution::GetAverageFrameTimeMs() const
+    {
+        return mAverageFrameTimeMs;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    DynamicResolution::Params const & DynamicResolution::GetParams() const
+    {
+        return mParams;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    float DynamicResolution::clampScale(float const scale) const
+    {
+        return std::clamp(scale, mParams.minScale, mParams.maxScale);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+namespace MFA
+{
+
+    // Picks the render scale from the measured gpu frame time.
+    // Shading cost grows with the pixel count, So the scale moves by the square root of the time ratio.
+    // Frame time is smoothed, Changes are quantized and followed by a cooldown so the resolution does not flicker.
+    class DynamicResolution
+    {
+    public:
+
+        struct Params
+        {
+            float targetFrameTimeMs = 1000.0f / 60.0f;
+            float minScale = 0.5f;
+            float maxScale = 1.0f;
+            float smoothing = 0.1f;                 // Weight of the newest sample in the moving average
+            float decreaseThreshold = 1.0f;         // Scale goes down when the average is above target * decreaseThreshold
+            float increaseThreshold = 0.85f;        // Scale goes up when the average is below target * increaseThreshold
+            float maxStep = 0.1f;                   // Largest change of a single update
+            float quantization = 1.0f / 32.0f;      // Scales are multiples of this value
+            uint32_t cooldownFrames = 8;            // Frames to wait after a change, Timings of the old scale are still in flight
+        };
+
+        explicit DynamicResolution();
+
+        explicit DynamicResolution(Params const & params, float initialScale = 1.0f);
+
+        void SetParams(Params const & params);
+
+        // Forgets the measured frame time, Next sample starts a new average
+        void Reset(float scale);
+
+        // Returns the render scale that next frame should use
+        float Update(float gpuFrameTimeMs);
+
+        [[nodiscard]]
+        float GetScale() const;
+
+        [[nodiscard]]
+        float GetAverageFrameTimeMs() const;
+
+        [[nodiscard]]
+        Params const & GetParams() const;
+
+    private:
+
+        [[nodiscard]]
+        float clampScale(float scale) const;
+
+        Params mParams {};
+
+        float mScale = 1.0f;
+
+        float mAverageFrameTimeMs = 0.0f;
+
+        bool mHasSample = false;
+
+        uint32_t mFramesSinceChange = 0;
+
+    };
+
+}
@@ -20,6 +20,7 @@
 
 #include <vulkan/vulkan.h>
 
+#include <algorithm>
 #include <vector>
 #include <cstring>
 #include <set>
@@ -737,6 +738,29 @@ namespace MFA::RenderBackend
             source_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
             destination_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
         }
+        else if (
+            oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL &&
+            newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+        )
+        {
+            // Frames that were submitted earlier may still be sampling the image
+            barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+            source_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            destination_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        }
+        else if (
+            oldLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL &&
+            newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        )
+        {
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            source_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+            destination_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        }
         else
         {
             MFA_CRASH("unsupported layout transition!");
@@ -927,7 +951,9 @@ namespace MFA::RenderBackend
         VkDevice device,
         VkPhysicalDevice physicalDevice,
         VkQueue graphicQueue,
-        VkCommandPool commandPool
+        VkCommandPool commandPool,
+        bool const generateMipmaps,
+        uint8_t const firstMip
     )
     {
         MFA_ASSERT(device != nullptr);
@@ -939,11 +965,17 @@ namespace MFA::RenderBackend
         if (cpuTexture.isValid())
         {
             auto const format = cpuTexture.GetFormat();
-            auto const mipCount = cpuTexture.GetMipCount();
+            auto const cpuMipCount = cpuTexture.GetMipCount();
+            MFA_ASSERT(firstMip < cpuMipCount);
             auto const sliceCount = cpuTexture.GetSlices();
-            auto const & largestMipmapInfo = cpuTexture.GetMipmap(0);
-            auto const buffer = cpuTexture.GetBuffer();
-            MFA_ASSERT(buffer.ptr != nullptr && buffer.len > 0);
+            auto const & largestMipmapInfo = cpuTexture.GetMipmap(firstMip);
+            // Mips are stored from the largest one, So the resident mips are the end of the buffer
+            auto const fullBuffer = cpuTexture.GetBuffer();
+            MFA_ASSERT(fullBuffer.ptr != nullptr && fullBuffer.len > 0);
+            CBlob const buffer {
+                fullBuffer.ptr + largestMipmapInfo.offset,
+                fullBuffer.len - largestMipmapInfo.offset
+            };
             // Create upload buffer
             auto const uploadBufferGroup = CreateBuffer(    // TODO: We can cache this buffer
                 device,
@@ -958,6 +990,26 @@ namespace MFA::RenderBackend
 
             auto const vulkan_format = ConvertCpuTextureFormatToGpu(format);
 
+            bool useGpuMipmaps = false;
+            if (generateMipmaps && cpuMipCount == 1 && largestMipmapInfo.dimension.depth == 1)
+            {
+                useGpuMipmaps = CanGenerateMipmaps(physicalDevice, vulkan_format);
+                if (useGpuMipmaps == false)
+                {
+                    MFA_LOG_WARN("Texture format does not support linear blit, Mipmaps are not generated");
+                }
+            }
+            auto const mipCount = useGpuMipmaps
+                ? AS::Texture::ComputeMipCount(largestMipmapInfo.dimension)
+                : static_cast<uint8_t>(cpuMipCount - firstMip);
+
+            VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+            // Mip streaming copies the resident mips into the next image, See ChangeTextureResidency
+            if (useGpuMipmaps || cpuMipCount > 1)
+            {
+                usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            }
+
             auto imageGroup = CreateImage(
                 device,
                 physicalDevice,
@@ -968,7 +1020,7 @@ namespace MFA::RenderBackend
                 sliceCount,
                 vulkan_format,
                 VK_IMAGE_TILING_OPTIMAL,
-                VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                usage,
                 VK_SAMPLE_COUNT_1_BIT,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
             );
@@ -990,19 +1042,37 @@ namespace MFA::RenderBackend
                 uploadBufferGroup->buffer,
                 imageGroup->image,
                 graphicQueue,
-                cpuTexture
+                cpuTexture,
+                firstMip,
+                cpuMipCount
             );
 
-            TransferImageLayout(
-                device,
-                graphicQueue,
-                commandPool,
-                imageGroup->image,
-                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                mipCount,
-                sliceCount
-            );
+            if (useGpuMipmaps)
+            {
+                GenerateMipmaps(
+                    device,
+                    graphicQueue,
+                    commandPool,
+                    imageGroup->image,
+                    largestMipmapInfo.dimension.width,
+                    largestMipmapInfo.dimension.height,
+                    mipCount,
+                    sliceCount
+                );
+            }
+            else
+            {
+                TransferImageLayout(
+                    device,
+                    graphicQueue,
+                    commandPool,
+                    imageGroup->image,
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    mipCount,
+                    sliceCount
+                );
+            }
 
             auto imageView = CreateImageView(
                 device,
@@ -1016,13 +1086,355 @@ namespace MFA::RenderBackend
 
             std::shared_ptr<RT::GpuTexture> gpuTexture = std::make_shared<RT::GpuTexture>(
                 std::move(imageGroup),
-                std::move(imageView)
+                std::move(imageView),
+                vulkan_format,
+                VkExtent3D {
+                    .width = largestMipmapInfo.dimension.width,
+                    .height = largestMipmapInfo.dimension.height,
+                    .depth = largestMipmapInfo.dimension.depth
+                },
+                static_cast<uint8_t>(mipCount + firstMip),
+                sliceCount,
+                firstMip
             );
             return gpuTexture;
         }
         return nullptr;
     }
 
+    //-------------------------------------------------------------------------------------------------
+
+    static VkExtent3D MipExtent(VkExtent3D const & extent, uint32_t const mipLevel)
+    {
+        return VkExtent3D {
+            .width = std::max(extent.width >> mipLevel, 1u),
+            .height = std::max(extent.height >> mipLevel, 1u),
+            .depth = std::max(extent.depth >> mipLevel, 1u)
+        };
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ChangeTextureResidency(
+        VkDevice device,
+        VkPhysicalDevice physicalDevice,
+        VkQueue graphicQueue,
+        VkCommandPool commandPool,
+        RT::GpuTexture & gpuTexture,
+        uint8_t const firstMip,
+        AS::Texture const * cpuTexture,
+        std::shared_ptr<RT::ImageGroup> & outOldImageGroup,
+        std::shared_ptr<RT::ImageViewGroup> & outOldImageView
+    )
+    {
+        MFA_ASSERT(device != nullptr);
+        MFA_ASSERT(physicalDevice != nullptr);
+        MFA_ASSERT(graphicQueue != nullptr);
+        MFA_ASSERT(commandPool != VK_NULL_HANDLE);
+        MFA_ASSERT(gpuTexture.imageGroup != nullptr);
+        MFA_ASSERT(firstMip < gpuTexture.mipCount);
+        MFA_ASSERT(firstMip != gpuTexture.firstResidentMip);
+
+        auto const oldFirstMip = gpuTexture.firstResidentMip;
+        auto const oldMipCount = static_cast<uint32_t>(gpuTexture.mipCount - oldFirstMip);
+        auto const mipCount = static_cast<uint32_t>(gpuTexture.mipCount - firstMip);
+        auto const sliceCount = gpuTexture.sliceCount;
+
+        VkExtent3D extent {};
+        if (firstMip < oldFirstMip)
+        {
+            MFA_ASSERT(cpuTexture != nullptr && cpuTexture->isValid());
+            MFA_ASSERT(cpuTexture->GetMipCount() == gpuTexture.mipCount);
+            auto const & dimension = cpuTexture->GetMipmap(firstMip).dimension;
+            extent = VkExtent3D {.width = dimension.width, .height = dimension.height, .depth = dimension.depth};
+        }
+        else
+        {
+            extent = MipExtent(gpuTexture.extent, firstMip - oldFirstMip);
+        }
+
+        auto imageGroup = CreateImage(
+            device,
+            physicalDevice,
+            extent.width,
+            extent.height,
+            extent.depth,
+            static_cast<uint8_t>(mipCount),
+            sliceCount,
+            gpuTexture.format,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            VK_SAMPLE_COUNT_1_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        );
+
+        TransferImageLayout(
+            device,
+            graphicQueue,
+            commandPool,
+            imageGroup->image,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            mipCount,
+            sliceCount
+        );
+
+        // Mips that were not resident come from the cpu texture
+        if (firstMip < oldFirstMip)
+        {
+            auto const fullBuffer = cpuTexture->GetBuffer();
+            auto const startOffset = cpuTexture->GetMipmap(firstMip).offset;
+            CBlob const buffer {
+                fullBuffer.ptr + startOffset,
+                cpuTexture->GetMipmap(oldFirstMip).offset - startOffset
+            };
+            auto const uploadBufferGroup = CreateBuffer(
+                device,
+                physicalDevice,
+                buffer.len,
+                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+            );
+            CopyDataToHostVisibleBuffer(device, uploadBufferGroup->memory, buffer);
+
+            CopyBufferToImage(
+                device,
+                commandPool,
+                uploadBufferGroup->buffer,
+                imageGroup->image,
+                graphicQueue,
+                *cpuTexture,
+                firstMip,
+                oldFirstMip
+            );
+        }
+
+        // Mips that both images have are copied on the gpu.
+        // Barriers of the single time commands also wait for earlier frames that sample the old image.
+        TransferImageLayout(
+            device,
+            graphicQueue,
+            commandPool,
+            gpuTexture.imageGroup->image,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            oldMipCount,
+            sliceCount
+        );
+        {
+            auto const commonFirstMip = std::max(firstMip, oldFirstMip);
+            auto const commonMipCount = static_cast<uint32_t>(gpuTexture.mipCount - commonFirstMip);
+
+            auto const commandBuffer = BeginSingleTimeCommand(device, commandPool);
+
+            Memory::ScratchScope scratch {};
+            auto * regions = scratch.AllocArray<VkImageCopy>(commonMipCount).ptr;
+            for (uint32_t i = 0; i < commonMipCount; ++i)
+            {
+                auto const srcMip = commonFirstMip - oldFirstMip + i;
+                auto const dstMip = commonFirstMip - firstMip + i;
+                // Both chains are halved from their own first mip, So odd sizes can differ by a texel
+                auto const srcExtent = MipExtent(gpuTexture.extent, srcMip);
+                auto const dstExtent = MipExtent(extent, dstMip);
+
+                auto & region = regions[i];
+                region = {};
+                region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                region.srcSubresource.mipLevel = srcMip;
+                region.srcSubresource.baseArrayLayer = 0;
+                region.srcSubresource.layerCount = sliceCount;
+                region.dstSubresource = region.srcSubresource;
+                region.dstSubresource.mipLevel = dstMip;
+                region.extent = VkExtent3D {
+                    .width = std::min(srcExtent.width, dstExtent.width),
+                    .height = std::min(srcExtent.height, dstExtent.height),
+                    .depth = std::min(srcExtent.depth, dstExtent.depth)
+                };
+            }
+
+            vkCmdCopyImage(
+                commandBuffer,
+                gpuTexture.imageGroup->image,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                imageGroup->image,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                commonMipCount,
+                regions
+            );
+
+            EndAndSubmitSingleTimeCommand(device, commandPool, graphicQueue, commandBuffer);
+        }
+        TransferImageLayout(
+            device,
+            graphicQueue,
+            commandPool,
+            gpuTexture.imageGroup->image,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            oldMipCount,
+            sliceCount
+        );
+
+        TransferImageLayout(
+            device,
+            graphicQueue,
+            commandPool,
+            imageGroup->image,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            mipCount,
+            sliceCount
+        );
+
+        auto imageView = CreateImageView(
+            device,
+            imageGroup->image,
+            gpuTexture.format,
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            mipCount,
+            sliceCount,
+            VK_IMAGE_VIEW_TYPE_2D
+        );
+
+        outOldImageGroup = std::move(gpuTexture.imageGroup);
+        outOldImageView = std::move(gpuTexture.imageView);
+        gpuTexture.imageGroup = std::move(imageGroup);
+        gpuTexture.imageView = std::move(imageView);
+        gpuTexture.extent = extent;
+        gpuTexture.firstResidentMip = firstMip;
+        ++gpuTexture.residencyVersion;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool CanGenerateMipmaps(VkPhysicalDevice physicalDevice, VkFormat const format)
+    {
+        MFA_ASSERT(physicalDevice != nullptr);
+        VkFormatProperties properties {};
+        vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+        VkFormatFeatureFlags const requiredFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT
+            | VK_FORMAT_FEATURE_BLIT_DST_BIT
+            | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        return (properties.optimalTilingFeatures & requiredFeatures) == requiredFeatures;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void GenerateMipmaps(
+        VkDevice device,
+        VkQueue graphicQueue,
+        VkCommandPool commandPool,
+        VkImage image,
+        uint32_t const width,
+        uint32_t const height,
+        uint8_t const mipCount,
+        uint16_t const sliceCount
+    )
+    {
+        MFA_ASSERT(device != nullptr);
+        MFA_ASSERT(graphicQueue != nullptr);
+        MFA_ASSERT(commandPool != VK_NULL_HANDLE);
+        MFA_ASSERT(image != VK_NULL_HANDLE);
+        MFA_ASSERT(mipCount > 0);
+
+        auto const commandBuffer = BeginSingleTimeCommand(device, commandPool);
+
+        VkImageMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = sliceCount;
+
+        AS::Texture::Dimensions const originalDimensions {width, height, 1};
+        auto previousDimensions = originalDimensions;
+
+        for (uint8_t mipLevel = 1; mipLevel < mipCount; ++mipLevel)
+        {
+            // Previous level is complete, It becomes the source of this blit
+            barrier.subresourceRange.baseMipLevel = mipLevel - 1;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            vkCmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                1, &barrier
+            );
+
+            // Same rounding as the cpu mip chain
+            auto const dimensions = AS::Texture::MipDimensions(mipLevel, mipCount, originalDimensions);
+
+            VkImageBlit blit {};
+            blit.srcOffsets[1] = VkOffset3D {
+                static_cast<int32_t>(previousDimensions.width),
+                static_cast<int32_t>(previousDimensions.height),
+                1
+            };
+            blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            blit.srcSubresource.mipLevel = mipLevel - 1;
+            blit.srcSubresource.baseArrayLayer = 0;
+            blit.srcSubresource.layerCount = sliceCount;
+            blit.dstOffsets[1] = VkOffset3D {
+                static_cast<int32_t>(dimensions.width),
+                static_cast<int32_t>(dimensions.height),
+                1
+            };
+            blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            blit.dstSubresource.mipLevel = mipLevel;
+            blit.dstSubresource.baseArrayLayer = 0;
+            blit.dstSubresource.layerCount = sliceCount;
+
+            // Blits decode and encode sRGB formats, So filtering happens in linear space
+            vkCmdBlitImage(
+                commandBuffer,
+                image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                1, &blit,
+                VK_FILTER_LINEAR
+            );
+
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            vkCmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                0,
+                0, nullptr,
+                0, nullptr,
+                1, &barrier
+            );
+
+            previousDimensions = dimensions;
+        }
+
+        // Last level is only written
+        barrier.subresourceRange.baseMipLevel = mipCount - 1;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            0,
+            0, nullptr,
+            0, nullptr,
+            1, &barrier
+        );
+
+        EndAndSubmitSingleTimeCommand(device, commandPool, graphicQueue, commandBuffer);
+    }
+
     //-------------------------------------------------------------------------------------------------
     // I probable will delete many of these functions because they are no longer required to exist
     void DestroyTexture(VkDevice device, RT::GpuTexture const & gpuTexture)
@@ -1087,7 +1499,9 @@ namespace MFA::RenderBackend
         VkBuffer buffer,
         VkImage image,
         VkQueue graphicQueue,
-        AS::Texture const & cpuTexture
+        AS::Texture const & cpuTexture,
+        uint8_t const firstMip,
+        uint8_t const endMip
     )
     {
         MFA_ASSERT(device != nullptr);
@@ -1099,30 +1513,31 @@ namespace MFA::RenderBackend
             cpuTexture.GetMipmap(cpuTexture.GetMipCount() - 1).offset +
             cpuTexture.GetMipmap(cpuTexture.GetMipCount() - 1).size == cpuTexture.GetBuffer().len
         );
+        MFA_ASSERT(firstMip < endMip && endMip <= cpuTexture.GetMipCount());
 
         auto const commandBuffer = BeginSingleTimeCommand(device, commandPool);
 
-        auto const mipCount = cpuTexture.GetMipCount();
+        auto const mipCount = static_cast<uint8_t>(endMip - firstMip);
         auto const slices = cpuTexture.GetSlices();
         auto const regionCount = mipCount * slices;
-        // TODO Maybe add a function allocate from heap
-        auto const regionsBlob = Memory::Alloc(regionCount * sizeof(VkBufferImageCopy));
-        auto * regionsArray = regionsBlob->memory.as<VkBufferImageCopy>();
+        auto const bufferStart = cpuTexture.mipOffsetInBytes(firstMip, 0);
+        Memory::ScratchScope scratch {};
+        auto * regionsArray = scratch.AllocArray<VkBufferImageCopy>(regionCount).ptr;
         for (uint8_t sliceIndex = 0; sliceIndex < slices; sliceIndex++)
         {
-            for (uint8_t mipLevel = 0; mipLevel < mipCount; mipLevel++)
+            for (uint8_t mipLevel = firstMip; mipLevel < endMip; mipLevel++)
             {
                 auto const & mipInfo = cpuTexture.GetMipmap(mipLevel);
-                auto & region = regionsArray[mipLevel];
+                auto & region = regionsArray[sliceIndex * mipCount + (mipLevel - firstMip)];
                 region.imageExtent.width = mipInfo.dimension.width;
                 region.imageExtent.height = mipInfo.dimension.height;
                 region.imageExtent.depth = mipInfo.dimension.depth;
                 region.imageOffset.x = 0;
                 region.imageOffset.y = 0;
                 region.imageOffset.z = 0;
-                region.bufferOffset = static_cast<uint32_t>(cpuTexture.mipOffsetInBytes(mipLevel, sliceIndex));
+                region.bufferOffset = static_cast<uint32_t>(cpuTexture.mipOffsetInBytes(mipLevel, sliceIndex) - bufferStart);
                 region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-                region.imageSubresource.mipLevel = mipLevel;
+                region.imageSubresource.mipLevel = mipLevel - firstMip;
                 region.imageSubresource.baseArrayLayer = sliceIndex;
                 region.imageSubresource.layerCount = 1;
                 region.bufferRowLength = 0;
@@ -1661,7 +2076,7 @@ namespace MFA::RenderBackend
         createInfo.imageColorSpace = selectedSurfaceFormat.colorSpace;
         createInfo.imageExtent = selected_swap_chain_extent;
         createInfo.imageArrayLayers = 1;
-        createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;      // Upscaled scene is blitted into the swap-chain
         createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
         createInfo.queueFamilyIndexCount = 0;
         createInfo.pQueueFamilyIndices = nullptr;
@@ -2723,6 +3138,25 @@ namespace MFA::RenderBackend
 
     //-------------------------------------------------------------------------------------------------
 
+    void DrawIndirect(
+        VkCommandBuffer const commandBuffer,
+        VkBuffer const buffer,
+        VkDeviceSize const offset,
+        uint32_t const drawCount,
+        uint32_t const stride
+    )
+    {
+        vkCmdDrawIndirect(
+            commandBuffer,
+            buffer,
+            offset,
+            drawCount,
+            stride
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void SetScissor(VkCommandBuffer commandBuffer, VkRect2D const & scissor)
     {
         MFA_ASSERT(commandBuffer != nullptr);
@@ -2990,6 +3424,28 @@ namespace MFA::RenderBackend
 
     //-------------------------------------------------------------------------------------------------
 
+    void BlitImage(
+        VkCommandBuffer commandBuffer,
+        VkImage sourceImage,
+        VkImage destinationImage,
+        VkImageBlit const & blitRegion,
+        VkFilter const filter
+    )
+    {
+        vkCmdBlitImage(
+            commandBuffer,
+            sourceImage,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            destinationImage,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1,
+            &blitRegion,
+            filter
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void WaitForQueue(VkQueue queue)
     {
         VK_Check(vkQueueWaitIdle(queue));
@@ -3027,6 +3483,18 @@ namespace MFA::RenderBackend
 
     //-------------------------------------------------------------------------------------------------
 
+    void WriteTimestamp(
+        VkCommandBuffer commandBuffer,
+        VkPipelineStageFlagBits const pipelineStage,
+        VkQueryPool queryPool,
+        uint32_t const queryId
+    )
+    {
+        vkCmdWriteTimestamp(commandBuffer, pipelineStage, queryPool, queryId);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void GetQueryPoolResult(
         VkDevice device,
         VkQueryPool queryPool,
@@ -3082,4 +3550,19 @@ namespace MFA::RenderBackend
 
     //-------------------------------------------------------------------------------------------------
 
+    void DispatchIndirect(
+        VkCommandBuffer const commandBuffer,
+        VkBuffer const buffer,
+        VkDeviceSize const offset
+    )
+    {
+        vkCmdDispatchIndirect(
+            commandBuffer,
+            buffer,
+            offset
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
 }
@@ -206,13 +206,51 @@ namespace MFA::RenderBackend
     );
 
     // TODO: We should ask for commandbuffer instead
+    // When generateMipmaps is set and the cpu texture has a single level, The rest of the chain is blitted on the gpu.
+    // Falls back to the single level when the format cannot be blitted with a linear filter.
+    // Only mips [firstMip, mipCount) are allocated and uploaded, Mip streaming adds the others later.
     [[nodiscard]]
     std::shared_ptr<RT::GpuTexture> CreateTexture(
         AS::Texture const & cpuTexture,
         VkDevice device,
         VkPhysicalDevice physicalDevice,
         VkQueue graphicQueue,
-        VkCommandPool commandPool
+        VkCommandPool commandPool,
+        bool generateMipmaps = false,
+        uint8_t firstMip = 0
+    );
+
+    // Moves the texture to a new image that holds mips [firstMip, mipCount) of its full chain.
+    // Mips that the current image has are copied on the gpu and the others are uploaded from cpuTexture,
+    // So cpuTexture is only needed when firstMip is below the first resident mip.
+    // Frames in flight may still sample the old image, So it is handed back instead of being destroyed.
+    void ChangeTextureResidency(
+        VkDevice device,
+        VkPhysicalDevice physicalDevice,
+        VkQueue graphicQueue,
+        VkCommandPool commandPool,
+        RT::GpuTexture & gpuTexture,
+        uint8_t firstMip,
+        AS::Texture const * cpuTexture,
+        std::shared_ptr<RT::ImageGroup> & outOldImageGroup,
+        std::shared_ptr<RT::ImageViewGroup> & outOldImageView
+    );
+
+    // Format can be both source and destination of a blit with a linear filter
+    [[nodiscard]]
+    bool CanGenerateMipmaps(VkPhysicalDevice physicalDevice, VkFormat format);
+
+    // Each level is blitted from the previous one. Every level has to be in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+    // and the first one has to be filled. All levels end up in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+    void GenerateMipmaps(
+        VkDevice device,
+        VkQueue graphicQueue,
+        VkCommandPool commandPool,
+        VkImage image,
+        uint32_t width,
+        uint32_t height,
+        uint8_t mipCount,
+        uint16_t sliceCount
     );
 
     void DestroyTexture(VkDevice device, RT::GpuTexture & gpuTexture);
@@ -226,7 +264,9 @@ namespace MFA::RenderBackend
         VkBuffer buffer,
         VkImage image,
         VkQueue graphicQueue,
-        AS::Texture const & cpuTexture
+        AS::Texture const & cpuTexture,
+        uint8_t firstMip,                   // Buffer starts with this mip and it is the first mip of the image
+        uint8_t endMip
     );
 
     [[nodiscard]]
@@ -592,6 +632,14 @@ namespace MFA::RenderBackend
         uint32_t firstInstance = 0
     );
 
+    void DrawIndirect(
+        VkCommandBuffer commandBuffer,
+        VkBuffer buffer,
+        VkDeviceSize offset,
+        uint32_t drawCount,
+        uint32_t stride
+    );
+
     void SetScissor(VkCommandBuffer commandBuffer, VkRect2D const & scissor);
 
     void SetViewport(VkCommandBuffer commandBuffer, VkViewport const & viewport);
@@ -670,6 +718,14 @@ namespace MFA::RenderBackend
         VkImageCopy const & copyRegion
     );
 
+    void BlitImage(
+        VkCommandBuffer commandBuffer,
+        VkImage sourceImage,
+        VkImage destinationImage,
+        VkImageBlit const & blitRegion,
+        VkFilter filter
+    );
+
     void WaitForQueue(VkQueue queue);
 
     VkQueryPool CreateQueryPool(VkDevice device, VkQueryPoolCreateInfo const & createInfo);
@@ -680,6 +736,13 @@ namespace MFA::RenderBackend
 
     void EndQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t queryId);
 
+    void WriteTimestamp(
+        VkCommandBuffer commandBuffer,
+        VkPipelineStageFlagBits pipelineStage,
+        VkQueryPool queryPool,
+        uint32_t queryId
+    );
+
     void GetQueryPoolResult(
         VkDevice device,
         VkQueryPool queryPool,
@@ -702,6 +765,12 @@ namespace MFA::RenderBackend
         uint32_t groupCountZ
     );
 
+    void DispatchIndirect(
+        VkCommandBuffer commandBuffer,
+        VkBuffer buffer,
+        VkDeviceSize offset
+    );
+
 }
 
 namespace MFA
@@ -4,10 +4,12 @@
 #include "engine/BedrockAssert.hpp"
 #include "RenderBackend.hpp"
 #include "engine/BedrockLog.hpp"
+#include "engine/BedrockMemory.hpp"
 #include "render_passes/display_render_pass/DisplayRenderPass.hpp"
 #include "engine/BedrockSignal.hpp"
 #include "engine/asset_system/AssetBaseMesh.hpp"
 #include "engine/asset_system/AssetModel.hpp"
+#include "DynamicResolution.hpp"
 
 #ifdef __DESKTOP__
 #include "libs/sdl/SDL.hpp"
@@ -24,6 +26,8 @@
 
 #include "libs/imgui/imgui.h"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 
 namespace MFA::RenderFrontend
@@ -86,6 +90,15 @@ namespace MFA::RenderFrontend
         uint8_t currentFrame = 0;
         VkFormat depthFormat{};
         bool isWindowVisible = true;                        // Currently only minimize can cause this to be false
+        // Render quality
+        RT::RenderQuality renderQuality {};
+        bool isRenderQualityDirty = false;                  // Sample counts changed, Render passes and pipelines are recreated before next frame
+        Signal<> renderQualityEventSignal{};
+        DynamicResolution dynamicResolution {};
+        // Gpu frame timer, Two timestamps per frame in flight
+        VkQueryPool frameTimerQueryPool {};
+        std::vector<bool> isFrameTimerWritten {};
+        float gpuFrameTimeMs = 0.0f;
 
 #ifdef __DESKTOP__
         // CreateWindow
@@ -183,6 +196,107 @@ namespace MFA::RenderFrontend
 
     //-------------------------------------------------------------------------------------------------
 
+    static constexpr float MinRenderScale = 0.25f;
+
+    static RT::RenderQuality SanitizeRenderQuality(RT::RenderQuality quality)
+    {
+        auto const clampSampleCount = [](VkSampleCountFlagBits const sampleCount)->VkSampleCountFlagBits
+        {
+            return static_cast<VkSampleCountFlagBits>(std::clamp(
+                static_cast<uint32_t>(sampleCount),
+                static_cast<uint32_t>(VK_SAMPLE_COUNT_1_BIT),
+                static_cast<uint32_t>(state->maxSampleCount)
+            ));
+        };
+        quality.displaySampleCount = clampSampleCount(quality.displaySampleCount);
+        quality.depthPrePassSampleCount = clampSampleCount(quality.depthPrePassSampleCount);
+
+        quality.maxRenderScale = std::clamp(quality.maxRenderScale, MinRenderScale, 1.0f);
+        quality.minRenderScale = std::clamp(quality.minRenderScale, MinRenderScale, quality.maxRenderScale);
+        quality.renderScale = quality.dynamicResolution
+            ? std::clamp(quality.renderScale, quality.minRenderScale, quality.maxRenderScale)
+            : std::clamp(quality.renderScale, MinRenderScale, 1.0f);
+        quality.targetGpuFrameTimeMs = std::max(quality.targetGpuFrameTimeMs, 1.0f);
+        return quality;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static DynamicResolution::Params CreateDynamicResolutionParams(RT::RenderQuality const & quality)
+    {
+        DynamicResolution::Params params {};
+        params.targetFrameTimeMs = quality.targetGpuFrameTimeMs;
+        params.minScale = quality.minRenderScale;
+        params.maxScale = quality.maxRenderScale;
+        return params;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void CreateFrameTimer()
+    {
+        state->isFrameTimerWritten.assign(state->maxFramesPerFlight, false);
+        if (state->physicalDeviceProperties.limits.timestampComputeAndGraphics == VK_FALSE)
+        {
+            MFA_LOG_WARN("Timestamp queries are not supported, Dynamic resolution is disabled");
+            return;
+        }
+        state->frameTimerQueryPool = RB::CreateQueryPool(
+            state->logicalDevice.device,
+            VkQueryPoolCreateInfo {
+                .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                .queryType = VK_QUERY_TYPE_TIMESTAMP,
+                .queryCount = state->maxFramesPerFlight * 2,
+            }
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void DestroyFrameTimer()
+    {
+        if (state->frameTimerQueryPool != VK_NULL_HANDLE)
+        {
+            RB::DestroyQueryPool(state->logicalDevice.device, state->frameTimerQueryPool);
+            state->frameTimerQueryPool = VK_NULL_HANDLE;
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Must be called after the fences of the frame are signaled, Otherwise reading the result would stall
+    static void ReadFrameTimer(uint32_t const frameIndex)
+    {
+        if (state->frameTimerQueryPool == VK_NULL_HANDLE || state->isFrameTimerWritten[frameIndex] == false)
+        {
+            return;
+        }
+        state->isFrameTimerWritten[frameIndex] = false;
+
+        uint64_t timestamps[2] {};
+        RB::GetQueryPoolResult(
+            state->logicalDevice.device,
+            state->frameTimerQueryPool,
+            2,
+            timestamps,
+            frameIndex * 2
+        );
+        if (timestamps[1] <= timestamps[0])
+        {
+            return;
+        }
+
+        auto const nanoSeconds = static_cast<double>(timestamps[1] - timestamps[0]) * state->physicalDeviceProperties.limits.timestampPeriod;
+        state->gpuFrameTimeMs = static_cast<float>(nanoSeconds / 1000000.0);
+
+        if (state->renderQuality.dynamicResolution)
+        {
+            state->renderQuality.renderScale = state->dynamicResolution.Update(state->gpuFrameTimeMs);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     bool Init(InitParams const & params)
     {
         state = new State();
@@ -251,7 +365,7 @@ namespace MFA::RenderFrontend
             state->physicalDevice = findPhysicalDeviceResult.physicalDevice;
             // I'm not sure if this is a correct thing to do but currently I'm enabling all gpu features.
             state->physicalDeviceFeatures = findPhysicalDeviceResult.physicalDeviceFeatures;
-            state->maxSampleCount = VK_SAMPLE_COUNT_2_BIT;//findPhysicalDeviceResult.maxSampleCount;                    // TODO It should be a setting
+            state->maxSampleCount = findPhysicalDeviceResult.maxSampleCount;
             state->physicalDeviceProperties = findPhysicalDeviceResult.physicalDeviceProperties;
             std::string message = "Supported physical device features are:";
             message += "\nSample rate shading support: ";
@@ -351,6 +465,12 @@ namespace MFA::RenderFrontend
 
         state->depthFormat = RB::FindDepthFormat(state->physicalDevice);
 
+        state->renderQuality = SanitizeRenderQuality(params.renderQuality);
+        state->dynamicResolution.SetParams(CreateDynamicResolutionParams(state->renderQuality));
+        state->dynamicResolution.Reset(state->renderQuality.renderScale);
+
+        CreateFrameTimer();
+
         state->displayRenderPass.Init();
         
         return true;
@@ -358,6 +478,19 @@ namespace MFA::RenderFrontend
 
     //-------------------------------------------------------------------------------------------------
 
+    static void ApplyRenderQuality()
+    {
+        DeviceWaitIdle();
+
+        state->isRenderQualityDirty = false;
+
+        // Display render pass owns the images that other passes draw into
+        state->displayRenderPass.OnRenderQualityChanged();
+        state->renderQualityEventSignal.Emit();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     static void OnResize()
     {
         DeviceWaitIdle();
@@ -386,6 +519,7 @@ namespace MFA::RenderFrontend
         DeviceWaitIdle();
 
         MFA_ASSERT(state->resizeEventSignal.IsEmpty());
+        MFA_ASSERT(state->renderQualityEventSignal.IsEmpty());
 
 #ifdef __DESKTOP__
         MFA_ASSERT(state->sdlEventListeners.empty());
@@ -394,6 +528,8 @@ namespace MFA::RenderFrontend
 
         state->displayRenderPass.Shutdown();
 
+        DestroyFrameTimer();
+
         // Graphic
         RB::DestroySemaphored(
             state->logicalDevice.device,
@@ -470,6 +606,112 @@ namespace MFA::RenderFrontend
 
     //-------------------------------------------------------------------------------------------------
 
+    int AddRenderQualityEventListener(RT::RenderQualityEventListener const & eventListener)
+    {
+        MFA_ASSERT(eventListener != nullptr);
+        return state->renderQualityEventSignal.Register(eventListener);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool RemoveRenderQualityEventListener(RT::RenderQualityEventListenerId const listenerId)
+    {
+        return state->renderQualityEventSignal.UnRegister(listenerId);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    RT::RenderQuality const & GetRenderQuality()
+    {
+        return state->renderQuality;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SetRenderQuality(RT::RenderQuality const & renderQuality)
+    {
+        auto const newQuality = SanitizeRenderQuality(renderQuality);
+        auto const & oldQuality = state->renderQuality;
+
+        if (
+            newQuality.displaySampleCount != oldQuality.displaySampleCount ||
+            newQuality.depthPrePassSampleCount != oldQuality.depthPrePassSampleCount
+        )
+        {
+            state->isRenderQualityDirty = true;
+        }
+
+        state->dynamicResolution.SetParams(CreateDynamicResolutionParams(newQuality));
+        if (newQuality.dynamicResolution && oldQuality.dynamicResolution == false)
+        {
+            state->dynamicResolution.Reset(newQuality.renderScale);
+        }
+
+        // Render targets are allocated for full resolution, So a new scale only changes the viewport
+        state->renderQuality = newQuality;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    VkExtent2D GetRenderExtent()
+    {
+        auto const & extent = state->surfaceCapabilities.currentExtent;
+        auto const scale = state->renderQuality.renderScale;
+        auto const scaleDimension = [scale](uint32_t const dimension)->uint32_t
+        {
+            auto const scaled = static_cast<uint32_t>(std::round(static_cast<float>(dimension) * scale));
+            return std::clamp(scaled, std::min(1u, dimension), dimension);
+        };
+        return VkExtent2D {
+            .width = scaleDimension(extent.width),
+            .height = scaleDimension(extent.height)
+        };
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    float GetGpuFrameTimeMs()
+    {
+        return state->gpuFrameTimeMs;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void BeginFrameTimer(RT::CommandRecordState const & recordState)
+    {
+        if (state->frameTimerQueryPool == VK_NULL_HANDLE)
+        {
+            return;
+        }
+        auto const firstQuery = recordState.frameIndex * 2;
+        RB::ResetQueryPool(recordState.commandBuffer, state->frameTimerQueryPool, 2, firstQuery);
+        RB::WriteTimestamp(
+            recordState.commandBuffer,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            state->frameTimerQueryPool,
+            firstQuery
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void EndFrameTimer(RT::CommandRecordState const & recordState)
+    {
+        if (state->frameTimerQueryPool == VK_NULL_HANDLE)
+        {
+            return;
+        }
+        RB::WriteTimestamp(
+            recordState.commandBuffer,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            state->frameTimerQueryPool,
+            recordState.frameIndex * 2 + 1
+        );
+        state->isFrameTimerWritten[recordState.frameIndex] = true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     std::shared_ptr<RT::DescriptorSetLayoutGroup> CreateDescriptorSetLayout(
         uint8_t const bindingsCount,
         VkDescriptorSetLayoutBinding * bindings
@@ -815,14 +1057,20 @@ namespace MFA::RenderFrontend
 
     //-------------------------------------------------------------------------------------------------
 
-    std::shared_ptr<RT::GpuTexture> CreateTexture(AS::Texture const & texture)
+    std::shared_ptr<RT::GpuTexture> CreateTexture(
+        AS::Texture const & texture,
+        bool const generateMipmaps,
+        uint8_t const firstMip
+    )
     {   // TODO: We might be able to batch command buffers together
         auto gpuTexture = RB::CreateTexture(
             texture,
             state->logicalDevice.device,
             state->physicalDevice,
             state->graphicQueue,
-            state->graphicCommandPool
+            state->graphicCommandPool,
+            generateMipmaps,
+            firstMip
         );
         MFA_ASSERT(gpuTexture != nullptr);
         return gpuTexture;
@@ -830,6 +1078,29 @@ namespace MFA::RenderFrontend
 
     //-------------------------------------------------------------------------------------------------
 
+    void ChangeTextureResidency(
+        RT::GpuTexture & texture,
+        uint8_t const firstMip,
+        AS::Texture const * cpuTexture,
+        std::shared_ptr<RT::ImageGroup> & outOldImageGroup,
+        std::shared_ptr<RT::ImageViewGroup> & outOldImageView
+    )
+    {
+        RB::ChangeTextureResidency(
+            state->logicalDevice.device,
+            state->physicalDevice,
+            state->graphicQueue,
+            state->graphicCommandPool,
+            texture,
+            firstMip,
+            cpuTexture,
+            outOldImageGroup,
+            outOldImageView
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void DestroyImage(RT::ImageGroup const & imageGroup)
     {
         DeviceWaitIdle();
@@ -1117,6 +1388,26 @@ namespace MFA::RenderFrontend
 
     //-------------------------------------------------------------------------------------------------
 
+    void DrawIndirect(
+        RT::CommandRecordState const & recordState,
+        RT::BufferAndMemory const & argumentsBuffer,
+        VkDeviceSize const offset,
+        uint32_t const drawCount,
+        uint32_t const stride
+    )
+    {
+        MFA_ASSERT(recordState.isValid);
+        RB::DrawIndirect(
+            recordState.commandBuffer,
+            argumentsBuffer.buffer,
+            offset,
+            drawCount,
+            stride
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void BeginRenderPass(
         VkCommandBuffer commandBuffer,
         VkRenderPass renderPass,
@@ -1917,6 +2208,11 @@ namespace MFA::RenderFrontend
             return recordState;
         }
 
+        if (state->isRenderQualityDirty)
+        {
+            ApplyRenderQuality();
+        }
+
         recordState.frameIndex = state->currentFrame;
         recordState.isValid = true;
         ++state->currentFrame;
@@ -1933,6 +2229,12 @@ namespace MFA::RenderFrontend
         WaitForFence(computeFence);
         ResetFence(computeFence);
 
+        // Previous use of this frame slot is complete, So its timestamps are ready
+        ReadFrameTimer(recordState.frameIndex);
+
+        // Same for the cpu memory that was recorded into this frame slot
+        Memory::BeginFrame(recordState.frameIndex);
+
         // We ignore failed acquire of image because a resize will be triggered at end of pass
         AcquireNextImage(
             GetPresentSemaphore(recordState),
@@ -2023,4 +2325,19 @@ namespace MFA::RenderFrontend
 
     //-------------------------------------------------------------------------------------------------
 
+    void DispatchIndirect(
+        RT::CommandRecordState const & recordState,
+        RT::BufferAndMemory const & argumentsBuffer,
+        VkDeviceSize const offset
+    )
+    {
+        RB::DispatchIndirect(
+            recordState.commandBuffer,
+            argumentsBuffer.buffer,
+            offset
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
 }
@@ -40,6 +40,30 @@ namespace MFA::RenderFrontend
     int AddResizeEventListener(RT::ResizeEventListener const & eventListener);
     bool RemoveResizeEventListener(RT::ResizeEventListenerId listenerId);
 
+    // Listeners are called when sample counts change, Render passes are recreated by then and pipelines must be recreated
+    int AddRenderQualityEventListener(RT::RenderQualityEventListener const & eventListener);
+    bool RemoveRenderQualityEventListener(RT::RenderQualityEventListenerId listenerId);
+
+    //------------------------------------------RenderQuality------------------------------------------
+
+    [[nodiscard]]
+    RT::RenderQuality const & GetRenderQuality();
+
+    // Sample count changes are applied before the next frame, Render scale changes take effect immediately
+    void SetRenderQuality(RT::RenderQuality const & renderQuality);
+
+    // Part of the swap-chain extent that the scene is rendered into
+    [[nodiscard]]
+    VkExtent2D GetRenderExtent();
+
+    // Time that gpu spent on the graphic command buffer of the latest completed frame
+    [[nodiscard]]
+    float GetGpuFrameTimeMs();
+
+    void BeginFrameTimer(RT::CommandRecordState const & recordState);
+
+    void EndFrameTimer(RT::CommandRecordState const & recordState);
+
     [[nodiscard]]
     std::shared_ptr<RT::DescriptorSetLayoutGroup> CreateDescriptorSetLayout(
         uint8_t bindingsCount,
@@ -105,8 +129,25 @@ namespace MFA::RenderFrontend
         RT::BufferAndMemory const & indexStageBuffer
     );*/
 
+    // generateMipmaps blits the mip chain on the gpu for textures that only have their first level, Useful for runtime textures
+    // firstMip leaves the larger mips out of the gpu image, See ChangeTextureResidency
     [[nodiscard]]
-    std::shared_ptr<RT::GpuTexture> CreateTexture(AS::Texture const & texture);
+    std::shared_ptr<RT::GpuTexture> CreateTexture(
+        AS::Texture const & texture,
+        bool generateMipmaps = false,
+        uint8_t firstMip = 0
+    );
+
+    // Replaces the image of a streamed texture with one that holds mips [firstMip, mipCount).
+    // cpuTexture is only needed when mips are added. Old image and view are returned, The caller keeps them
+    // alive until no frame in flight can sample them.
+    void ChangeTextureResidency(
+        RT::GpuTexture & texture,
+        uint8_t firstMip,
+        AS::Texture const * cpuTexture,
+        std::shared_ptr<RT::ImageGroup> & outOldImageGroup,
+        std::shared_ptr<RT::ImageViewGroup> & outOldImageView
+    );
 
     void DestroyImage(RT::ImageGroup const & imageGroup);
 
@@ -292,6 +333,15 @@ namespace MFA::RenderFrontend
         uint32_t firstInstance = 0
     );
 
+    // Draw parameters are read from the buffer as VkDrawIndirectCommand
+    void DrawIndirect(
+        RT::CommandRecordState const & recordState,
+        RT::BufferAndMemory const & argumentsBuffer,
+        VkDeviceSize offset = 0,
+        uint32_t drawCount = 1,
+        uint32_t stride = sizeof(VkDrawIndirectCommand)
+    );
+
     void BeginRenderPass(
         VkCommandBuffer commandBuffer,
         VkRenderPass renderPass,
@@ -508,6 +558,7 @@ namespace MFA::RenderFrontend
 
     DisplayRenderPass * GetDisplayRenderPass();
     
+    // Device limit, Passes use the sample counts of RenderQuality
     VkSampleCountFlagBits GetMaxSamplesCount();
     
     //------------------------------------------QueryPool----------------------------------------------
@@ -567,6 +618,13 @@ namespace MFA::RenderFrontend
         uint32_t groupCountZ
     );
 
+    // Group counts are read from the buffer as VkDispatchIndirectCommand
+    void DispatchIndirect(
+        RT::CommandRecordState const & recordState,
+        RT::BufferAndMemory const & argumentsBuffer,
+        VkDeviceSize offset = 0
+    );
+
 }
 
 namespace MFA
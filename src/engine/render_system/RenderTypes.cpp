@@ -73,11 +73,23 @@ MFA::RT::ImageViewGroup::~ImageViewGroup()
 
 MFA::RT::GpuTexture::GpuTexture(
     std::shared_ptr<ImageGroup> imageGroup,
-    std::shared_ptr<ImageViewGroup> imageView
+    std::shared_ptr<ImageViewGroup> imageView,
+    VkFormat const format,
+    VkExtent3D const extent,
+    uint8_t const mipCount,
+    uint16_t const sliceCount,
+    uint8_t const firstResidentMip
 )
     : imageGroup(std::move(imageGroup))
     , imageView(std::move(imageView))
-{}
+    , format(format)
+    , extent(extent)
+    , mipCount(mipCount)
+    , sliceCount(sliceCount)
+    , firstResidentMip(firstResidentMip)
+{
+    MFA_ASSERT(firstResidentMip < mipCount);
+}
 
 //-------------------------------------------------------------------------------------------------
 
@@ -97,7 +97,12 @@ namespace MFA
 
             explicit GpuTexture(
                 std::shared_ptr<ImageGroup> imageGroup,
-                std::shared_ptr<ImageViewGroup> imageView
+                std::shared_ptr<ImageViewGroup> imageView,
+                VkFormat format = VK_FORMAT_UNDEFINED,
+                VkExtent3D extent = {},
+                uint8_t mipCount = 1,
+                uint16_t sliceCount = 1,
+                uint8_t firstResidentMip = 0
             );
             ~GpuTexture();
 
@@ -106,8 +111,16 @@ namespace MFA
             GpuTexture & operator= (GpuTexture const & rhs) noexcept = delete;
             GpuTexture & operator= (GpuTexture && rhs) noexcept = delete;
 
-            std::shared_ptr<ImageGroup> const imageGroup{};
-            std::shared_ptr<ImageViewGroup> const imageView{};
+            // Replaced when the resident mips of a streamed texture change, See RF::ChangeTextureResidency
+            std::shared_ptr<ImageGroup> imageGroup{};
+            std::shared_ptr<ImageViewGroup> imageView{};
+
+            VkFormat format = VK_FORMAT_UNDEFINED;
+            VkExtent3D extent {};                   // Of the first resident mip
+            uint8_t mipCount = 1;                   // Full chain, Mip 0 is the largest
+            uint16_t sliceCount = 1;
+            uint8_t firstResidentMip = 0;           // Image only holds mips [firstResidentMip, mipCount)
+            uint32_t residencyVersion = 0;          // Increases each time the image is replaced
         };
     
 
@@ -389,6 +402,24 @@ namespace MFA
         using ScreenWidth = Platforms::ScreenSize;
         using ScreenHeight = Platforms::ScreenSize;
 
+        // Pipelines that draw into a pass must use the sample count of that pass
+        struct RenderQuality
+        {
+            VkSampleCountFlagBits displaySampleCount = VK_SAMPLE_COUNT_2_BIT;
+            // Used by occlusion pass as well because it tests against the depth pre-pass image.
+            // If it differs from display sample count, Depth pre-pass gets its own depth image and display pass writes its own depth.
+            VkSampleCountFlagBits depthPrePassSampleCount = VK_SAMPLE_COUNT_1_BIT;
+
+            // Scene is rendered into this fraction of the swap-chain extent and then upscaled, Ui is always drawn at full resolution
+            float renderScale = 1.0f;
+
+            // Render scale follows the gpu frame time, It stays between min and max render scale
+            bool dynamicResolution = false;
+            float targetGpuFrameTimeMs = 1000.0f / 60.0f;
+            float minRenderScale = 0.5f;
+            float maxRenderScale = 1.0f;
+        };
+
         struct FrontendInitParams
         {
 #ifdef __DESKTOP__
@@ -403,6 +434,7 @@ namespace MFA
 #error Os is not supported
 #endif
             char const * applicationName = nullptr;
+            RenderQuality renderQuality {};
         };
 
     };
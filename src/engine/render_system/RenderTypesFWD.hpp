@@ -62,6 +62,11 @@ namespace MFA
         using ResizeEventListenerId = int;
         using ResizeEventListener = std::function<void()>;
 
+        struct RenderQuality;
+
+        using RenderQualityEventListenerId = int;
+        using RenderQualityEventListener = std::function<void()>;
+
         using VariantId = uint32_t;
 
         struct DescriptorSetLayoutGroup;
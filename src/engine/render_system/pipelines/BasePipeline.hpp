@@ -126,6 +126,9 @@ namespace MFA
 
         virtual void onResize() = 0;
 
+        // Sample count of a render pass changed, Pipelines that draw into it must be recreated
+        virtual void onRenderQualityChanged() = 0;
+
         [[nodiscard]]
         virtual char const * GetName() const = 0;
 
@@ -140,6 +140,17 @@ bool MFA::VariantBase::IsVisible() const
 
 //-------------------------------------------------------------------------------------------------
 
+float MFA::VariantBase::GetScreenSize() const
+{
+    if (auto const ptr = mBoundingVolumeComponent.lock())
+    {
+        return ptr->GetScreenSize();
+    }
+    return 1.0f;
+}
+
+//-------------------------------------------------------------------------------------------------
+
 bool MFA::VariantBase::IsOccluded() const
 {
     if (auto const ptr = mBoundingVolumeComponent.lock())
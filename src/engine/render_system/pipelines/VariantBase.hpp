@@ -52,6 +52,10 @@ namespace MFA
         [[nodiscard]]
         bool IsVisible() const;
 
+        // Returns 1 if variant has no bounding volume
+        [[nodiscard]]
+        float GetScreenSize() const;
+
         [[nodiscard]]
         bool IsOccluded() const;
 
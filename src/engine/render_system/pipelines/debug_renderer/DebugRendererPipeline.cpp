@@ -120,7 +120,7 @@ namespace MFA
             
             for (auto & variant : variantsList)
             {
-                if (variant->IsActive())
+                if (variant->IsActive() && variant->IsInFrustum())
                 {
                     auto * debugVariant = CAST_VARIANT(variant);
                     MFA_ASSERT(debugVariant != nullptr);
@@ -147,6 +147,13 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    void DebugRendererPipeline::onRenderQualityChanged()
+    {
+        createPipeline();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void DebugRendererPipeline::freeUnusedEssences() {}
 
     //-------------------------------------------------------------------------------------------------
@@ -247,7 +254,7 @@ namespace MFA
         pipelineOptions.useStaticViewportAndScissor = false;
         pipelineOptions.primitiveTopology = VK_PRIMITIVE_TOPOLOGY_LINE_STRIP;
         // TODO I think we should submit each pipeline . Each one should have independent depth buffer 
-        pipelineOptions.rasterizationSamples = RF::GetMaxSamplesCount();            // TODO Find a way to set sample count to 1. We only need MSAA for pbr-pipeline
+        pipelineOptions.rasterizationSamples = RF::GetRenderQuality().displaySampleCount;
         pipelineOptions.cullMode = VK_CULL_MODE_NONE;
         pipelineOptions.colorBlendAttachments.blendEnable = VK_FALSE;
 
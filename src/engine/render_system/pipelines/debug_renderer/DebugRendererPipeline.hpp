@@ -36,6 +36,8 @@ namespace MFA
 
         void onResize() override;
 
+        void onRenderQualityChanged() override;
+
         void freeUnusedEssences() override;
 
         std::weak_ptr<DebugEssence> GetEssence(std::string const & nameId);
@@ -24,7 +24,8 @@ namespace MFA
             std::vector<std::shared_ptr<RT::GpuTexture>> fireTextures,
             // TODO Smoke texture
             FireParams const & fireParams = FireParams {},
-            AS::Particle::Params const & params = AS::Particle::Params {}
+            AS::Particle::Params const & params = AS::Particle::Params {},
+            AS::Particle::EmitterParams const & defaultEmitterParams = AS::Particle::EmitterParams {}
         );
 
         ~FireEssence() override;
@@ -40,8 +41,6 @@ namespace MFA
 
         void computePointSize();
 
-        float mInitialPointSize = 0.0f;
-
         SignalId mResizeSignal = -1;
 
         FireParams mFireParams {};
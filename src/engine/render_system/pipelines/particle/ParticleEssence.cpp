@@ -2,11 +2,12 @@
 
 #include "ParticleVariant.hpp"
 #include "engine/BedrockAssert.hpp"
+#include "engine/BedrockMath.hpp"
 #include "engine/BedrockMemory.hpp"
 #include "engine/render_system/RenderFrontend.hpp"
 #include "engine/render_system/pipelines/DescriptorSetSchema.hpp"
 
-#include <cmath>
+#include <numeric>
 
 #define CAST_VARIANT(variant) static_pointer_cast<ParticleVariant>(variant)
 
@@ -14,66 +15,75 @@ namespace MFA
 {
     using namespace AS::Particle;
 
-    static constexpr uint32_t VERTEX_BUFFER_BIND_ID = 0;
-    static constexpr uint32_t INSTANCE_BUFFER_BIND_ID = 1;
+    // Must match ParticleEmit.comp.hlsl and Particle.comp.hlsl
+    static constexpr uint32_t EMIT_GROUP_SIZE = 64;
+    static constexpr uint32_t SIMULATION_GROUP_SIZE = 256;
+
+    static constexpr VkDeviceSize DRAW_ARGUMENTS_OFFSET = offsetof(Counters, vertexCount);
+    static constexpr VkDeviceSize DISPATCH_ARGUMENTS_OFFSET = offsetof(Counters, groupCountX);
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticleEssence::createVertexBuffer(
+    void ParticleEssence::createParticleBuffers(
         VkCommandBuffer commandBuffer,
-        CBlob const & vertexBlob,
-        std::shared_ptr<RT::BufferGroup> & outStageBuffer
+        std::vector<std::shared_ptr<RT::BufferGroup>> & outStageBuffers
     )
     {
-        mVertexBuffer = RF::CreateBufferGroup(
-            vertexBlob.len,
-            1,
-            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-        );
-
-        outStageBuffer = RF::CreateStageBuffer(vertexBlob.len, 1);
+        auto const createLocalBuffer = [commandBuffer, &outStageBuffers](
+            VkDeviceSize const bufferSize,
+            VkBufferUsageFlags const usageFlags,
+            CBlob const * initialData
+        )->std::shared_ptr<RT::BufferGroup>
+        {
+            auto bufferGroup = RF::CreateBufferGroup(
+                bufferSize,
+                1,
+                usageFlags | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+            );
+            if (initialData != nullptr)
+            {
+                MFA_ASSERT(initialData->len == bufferSize);
+                auto const stageBuffer = RF::CreateStageBuffer(bufferSize, 1);
+                RF::UpdateHostVisibleBuffer(*stageBuffer->buffers[0], *initialData);
+                RF::UpdateLocalBuffer(commandBuffer, *bufferGroup->buffers[0], *stageBuffer->buffers[0]);
+                outStageBuffers.emplace_back(stageBuffer);
+            }
+            return bufferGroup;
+        };
 
-        RF::UpdateHostVisibleBuffer(
-            *outStageBuffer->buffers[0],
-            vertexBlob
-        );
+        // Particles start dead, So their content does not matter
+        mParticleBuffer = createLocalBuffer(mCapacity * sizeof(ParticleData), 0, nullptr);
 
-        RF::UpdateLocalBuffer(
-            commandBuffer,
-            *mVertexBuffer->buffers[0],
-            *outStageBuffer->buffers[0]
-        );
-    }
+        {// Dead list
+            Memory::ScratchScope scratch {};
+            auto const deadList = scratch.Alloc(mCapacity * sizeof(uint32_t));
+            auto * indices = deadList.as<uint32_t>();
+            std::iota(indices, indices + mCapacity, 0u);
+            CBlob const deadListBlob = deadList;
+            mDeadListBuffer = createLocalBuffer(deadListBlob.len, 0, &deadListBlob);
+        }
 
-    //-------------------------------------------------------------------------------------------------
+        mAliveListBuffer = createLocalBuffer(2 * mCapacity * sizeof(uint32_t), 0, nullptr);
 
-    void ParticleEssence::createIndexBuffer(
-        VkCommandBuffer commandBuffer,
-        CBlob const & indexBlob,
-        std::shared_ptr<RT::BufferGroup> & outStageBuffer
-    )
-    {
-        outStageBuffer = RF::CreateStageBuffer(indexBlob.len, 1);
+        mDrawListBuffer = createLocalBuffer(ParticleSort::PaddedCount(mCapacity) * sizeof(DrawEntry), 0, nullptr);
 
-        mIndexBuffer =  RF::CreateIndexBuffer(
-            commandBuffer,
-            *outStageBuffer->buffers[0],
-            indexBlob
-        );
+        {// Counters
+            Counters counters {};
+            counters.deadCount = static_cast<int32_t>(mCapacity);
+            auto const countersBlob = CBlobAliasOf(counters);
+            mCountersBuffer = createLocalBuffer(sizeof(Counters), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, &countersBlob);
+        }
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticleEssence::createInstanceBuffer()
+    void ParticleEssence::createEmitterBuffer()
     {
-        auto const bufferSize = mMaxInstanceCount * sizeof(PerInstanceData);
-        mInstanceData = Memory::Alloc(bufferSize);
-        mInstanceBuffer = RF::CreateBufferGroup(
-            bufferSize,
-            RF::GetMaxFramesPerFlight(),
-            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+        mEmitterData.resize(mMaxInstanceCount);
+        mEmitterBuffer = RF::CreateHostVisibleStorageBuffer(
+            mMaxInstanceCount * sizeof(EmitterData),
+            RF::GetMaxFramesPerFlight()
         );
     }
 
@@ -105,28 +115,31 @@ namespace MFA
     ParticleEssence::ParticleEssence(
         std::string nameId,
         Params const & params,
+        EmitterParams const & defaultEmitterParams,
         uint32_t const maxInstanceCount,
         std::vector<std::shared_ptr<RT::GpuTexture>> textures
     )
         : EssenceBase(std::move(nameId))
         , mParams(params)
+        , mDefaultEmitterParams(defaultEmitterParams)
         , mMaxInstanceCount(maxInstanceCount)
+        , mCapacity(static_cast<uint32_t>(params.count) * maxInstanceCount)
         , mTextures(std::move(textures))
-    {}
+    {
+        MFA_ASSERT(mCapacity > 0);
+        ParticleSort::BuildPlan(mCapacity, mSortPlan);
+    }
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticleEssence::init(CBlob const & vertexData, CBlob const & indexData)
+    void ParticleEssence::init()
     {
 
         //--------------Local buffers-----------
         auto const commandBuffer = RF::BeginSingleTimeGraphicCommand();
 
-        std::shared_ptr<RT::BufferGroup> vertexStageBuffer = nullptr;
-        createVertexBuffer(commandBuffer, vertexData, vertexStageBuffer);
-
-        std::shared_ptr<RT::BufferGroup> indexStageBuffer = nullptr;
-        createIndexBuffer(commandBuffer, indexData, indexStageBuffer);
+        std::vector<std::shared_ptr<RT::BufferGroup>> stageBuffers {};
+        createParticleBuffers(commandBuffer, stageBuffers);
 
         std::shared_ptr<RT::BufferGroup> paramsStageBuffer = nullptr;
         createParamsBuffer(commandBuffer, paramsStageBuffer);
@@ -134,7 +147,7 @@ namespace MFA
         RF::EndAndSubmitGraphicSingleTimeCommand(commandBuffer);
         //---------------------------------------
 
-        createInstanceBuffer();
+        createEmitterBuffer();
 
         mIsInitialized = true;
 
@@ -146,12 +159,53 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticleEssence::update(VariantsList const & variants)
+    void ParticleEssence::update(VariantsList const & variants, float const deltaTimeInSec)
     {
         checkIfUpdateIsRequired(variants);
         if (mShouldUpdate)
         {
-            updateInstanceData(variants);
+            updateEmitterData(variants, deltaTimeInSec);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool ParticleEssence::shouldUpdate() const
+    {
+        return mShouldUpdate;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool ParticleEssence::requiresSorting() const
+    {
+        return mParams.sortByDepth != 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ParticleEssence::addBufferBarrier(
+        RT::BufferGroup const & bufferGroup,
+        VkAccessFlags const sourceAccess,
+        VkAccessFlags const destinationAccess,
+        uint32_t const sourceQueueFamily,
+        uint32_t const destinationQueueFamily,
+        std::vector<VkBufferMemoryBarrier> & outBarrier
+    )
+    {
+        for (auto const & buffer : bufferGroup.buffers)
+        {
+            outBarrier.emplace_back(VkBufferMemoryBarrier {
+                .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = sourceAccess,
+                .dstAccessMask = destinationAccess,
+                .srcQueueFamilyIndex = sourceQueueFamily,
+                .dstQueueFamilyIndex = destinationQueueFamily,
+                .buffer = buffer->buffer,
+                .offset = 0,
+                .size = buffer->size
+            });
         }
     }
 
@@ -159,25 +213,58 @@ namespace MFA
 
     void ParticleEssence::preComputeBarrier(std::vector<VkBufferMemoryBarrier> & outBarrier) const
     {
-        VkBufferMemoryBarrier barrier =
-		{
-			VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
-			nullptr,
-			0,
-			VK_ACCESS_SHADER_WRITE_BIT,
-			RF::GetGraphicQueueFamily(),
-			RF::GetComputeQueueFamily(),
-			mVertexBuffer->buffers[0]->buffer,
-			0,
-			mVertexBuffer->buffers[0]->size
-		};
-
-        outBarrier.emplace_back(barrier);
+        for (auto const * bufferGroup : {mParticleBuffer.get(), mDrawListBuffer.get(), mCountersBuffer.get()})
+        {
+            addBufferBarrier(
+                *bufferGroup,
+                0,
+                VK_ACCESS_SHADER_WRITE_BIT,
+                RF::GetGraphicQueueFamily(),
+                RF::GetComputeQueueFamily(),
+                outBarrier
+            );
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ParticleEssence::computeBarrier(std::vector<VkBufferMemoryBarrier> & outBarrier) const
+    {
+        if (mShouldUpdate == false)
+        {
+            return;
+        }
+
+        for (auto const * bufferGroup : {
+            mParticleBuffer.get(),
+            mDeadListBuffer.get(),
+            mAliveListBuffer.get(),
+            mDrawListBuffer.get()
+        })
+        {
+            addBufferBarrier(
+                *bufferGroup,
+                VK_ACCESS_SHADER_WRITE_BIT,
+                VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                VK_QUEUE_FAMILY_IGNORED,
+                VK_QUEUE_FAMILY_IGNORED,
+                outBarrier
+            );
+        }
+
+        addBufferBarrier(
+            *mCountersBuffer,
+            VK_ACCESS_SHADER_WRITE_BIT,
+            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+            VK_QUEUE_FAMILY_IGNORED,
+            VK_QUEUE_FAMILY_IGNORED,
+            outBarrier
+        );
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticleEssence::compute(RT::CommandRecordState const & recordState)
+    void ParticleEssence::emit(RT::CommandRecordState const & recordState)
     {
         if (mShouldUpdate == false)
         {
@@ -190,33 +277,131 @@ namespace MFA
             mIsParamsBufferDirty = false;
         }
 
+        updateEmitterBuffer(recordState);
+
+        if (mMaxEmitCount == 0)
+        {
+            return;
+        }
+
         bindComputeDescriptorSet(recordState);
-        auto const dispatchCount = static_cast<uint32_t>(std::ceil(static_cast<float>(mParams.count) / 256.0f));
+        pushConstants(recordState, makePushConstants());
+
+        // One row of groups per emitter
         RF::Dispatch(
             recordState,
-            dispatchCount,
-            1,
+            (mMaxEmitCount + EMIT_GROUP_SIZE - 1) / EMIT_GROUP_SIZE,
+            mEmitterCount,
             1
         );
     }
 
     //-------------------------------------------------------------------------------------------------
 
+    void ParticleEssence::prepareArguments(RT::CommandRecordState const & recordState, ArgsStage const stage) const
+    {
+        if (mShouldUpdate == false)
+        {
+            return;
+        }
+
+        bindComputeDescriptorSet(recordState);
+
+        auto pushConstantsData = makePushConstants();
+        pushConstantsData.stage = static_cast<uint32_t>(stage);
+        pushConstants(recordState, pushConstantsData);
+
+        RF::Dispatch(recordState, 1, 1, 1);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ParticleEssence::simulate(RT::CommandRecordState const & recordState) const
+    {
+        if (mShouldUpdate == false)
+        {
+            return;
+        }
+
+        bindComputeDescriptorSet(recordState);
+        pushConstants(recordState, makePushConstants());
+
+        // Group count is ceil(aliveCount / SIMULATION_GROUP_SIZE), Written by the prepare simulation stage
+        RF::DispatchIndirect(recordState, *mCountersBuffer->buffers[0], DISPATCH_ARGUMENTS_OFFSET);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ParticleEssence::sort(RT::CommandRecordState const & recordState) const
+    {
+        if (mShouldUpdate == false || requiresSorting() == false)
+        {
+            return;
+        }
+
+        bindComputeDescriptorSet(recordState);
+
+        std::vector<VkBufferMemoryBarrier> barriers {};
+        addBufferBarrier(
+            *mDrawListBuffer,
+            VK_ACCESS_SHADER_WRITE_BIT,
+            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+            VK_QUEUE_FAMILY_IGNORED,
+            VK_QUEUE_FAMILY_IGNORED,
+            barriers
+        );
+
+        auto pushConstantsData = makePushConstants();
+        for (size_t i = 0; i < mSortPlan.size(); ++i)
+        {
+            auto const & pass = mSortPlan[i];
+
+            pushConstantsData.stage = static_cast<uint32_t>(pass.stage);
+            pushConstantsData.k = pass.k;
+            pushConstantsData.j = pass.j;
+            pushConstants(recordState, pushConstantsData);
+
+            RF::Dispatch(recordState, pass.groupCount, 1, 1);
+
+            if (i + 1 < mSortPlan.size())
+            {
+                RF::PipelineBarrier(
+                    recordState,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                    static_cast<uint32_t>(barriers.size()),
+                    barriers.data()
+                );
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ParticleEssence::endCompute()
+    {
+        if (mShouldUpdate == false)
+        {
+            return;
+        }
+        mCurrentList = 1 - mCurrentList;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void ParticleEssence::preRenderBarrier(std::vector<VkBufferMemoryBarrier> & outBarrier) const
     {
-        VkBufferMemoryBarrier barrier =
-		{
-			VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
-			nullptr,
-			VK_ACCESS_SHADER_WRITE_BIT,
-			0,
-			RF::GetComputeQueueFamily(),
-			RF::GetGraphicQueueFamily(),
-			mVertexBuffer->buffers[0]->buffer,
-			0,
-			mVertexBuffer->buffers[0]->size
-		};
-        outBarrier.emplace_back(barrier);
+        for (auto const * bufferGroup : {mParticleBuffer.get(), mDrawListBuffer.get(), mCountersBuffer.get()})
+        {
+            addBufferBarrier(
+                *bufferGroup,
+                VK_ACCESS_SHADER_WRITE_BIT,
+                0,
+                RF::GetComputeQueueFamily(),
+                RF::GetGraphicQueueFamily(),
+                outBarrier
+            );
+        }
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -228,19 +413,10 @@ namespace MFA
             return;
         }
 
-        updateInstanceBuffer(recordState);
-
-        bindVertexBuffer(recordState);
-        bindInstanceBuffer(recordState);
-        bindIndexBuffer(recordState);
         bindGraphicDescriptorSet(recordState);
 
-        // Draw
-        RF::DrawIndexed(
-            recordState,
-            mParams.count,
-            mNextDrawInstanceCount
-        );
+        // Vertex count is the alive count, Written by the prepare draw stage
+        RF::DrawIndirect(recordState, *mCountersBuffer->buffers[0], DRAW_ARGUMENTS_OFFSET);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -252,6 +428,20 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    EmitterParams const & ParticleEssence::getDefaultEmitterParams() const
+    {
+        return mDefaultEmitterParams;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t ParticleEssence::getCapacity() const
+    {
+        return mCapacity;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void ParticleEssence::createGraphicDescriptorSet(
         VkDescriptorPool descriptorPool,
         VkDescriptorSetLayout descriptorSetLayout,
@@ -296,6 +486,23 @@ namespace MFA
                 imageInfos.data(),
                 static_cast<uint32_t>(imageInfos.size())
             );
+
+            // -----------Particles-------------
+            VkDescriptorBufferInfo const particleBufferInfo {
+                .buffer = mParticleBuffer->buffers[0]->buffer,
+                .offset = 0,
+                .range = mParticleBuffer->bufferSize
+            };
+            descriptorSetSchema.AddStorageBuffer(&particleBufferInfo);
+
+            // -----------DrawList-------------
+            VkDescriptorBufferInfo const drawListBufferInfo {
+                .buffer = mDrawListBuffer->buffers[0]->buffer,
+                .offset = 0,
+                .range = mDrawListBuffer->bufferSize
+            };
+            descriptorSetSchema.AddStorageBuffer(&drawListBufferInfo);
+
             // --------------------------------
             descriptorSetSchema.UpdateDescriptorSets();
         }
@@ -307,122 +514,164 @@ namespace MFA
     {
         mComputeDescriptorSet = RF::CreateDescriptorSets(
             descriptorPool,
-            1,
+            RF::GetMaxFramesPerFlight(),
             descriptorSetLayout
         );
 
-        auto const & descriptorSet = mComputeDescriptorSet.descriptorSets[0];
-        MFA_ASSERT(descriptorSet != VK_NULL_HANDLE);
-
-        DescriptorSetSchema descriptorSetSchema{ descriptorSet };
-
-        // -----------Params-------------
-        VkDescriptorBufferInfo const paramsBufferInfo {
-            .buffer = mParamsBuffer->buffers[0]->buffer,
-            .offset = 0,
-            .range = mParamsBuffer->bufferSize
-        };
-        descriptorSetSchema.AddUniformBuffer(&paramsBufferInfo);
+        for (uint32_t frameIndex = 0; frameIndex < RF::GetMaxFramesPerFlight(); ++frameIndex)
+        {
+            auto const & descriptorSet = mComputeDescriptorSet.descriptorSets[frameIndex];
+            MFA_ASSERT(descriptorSet != VK_NULL_HANDLE);
 
-        // -----------Particles-------------
-        VkDescriptorBufferInfo const particleBufferInfo {
-            .buffer = mVertexBuffer->buffers[0]->buffer,
-            .offset = 0,
-            .range = mVertexBuffer->bufferSize
-        };
-        descriptorSetSchema.AddStorageBuffer(&particleBufferInfo);
+            DescriptorSetSchema descriptorSetSchema{ descriptorSet };
 
-        // --------------------------------
-        descriptorSetSchema.UpdateDescriptorSets();
-    }
+            // -----------Params-------------
+            VkDescriptorBufferInfo const paramsBufferInfo {
+                .buffer = mParamsBuffer->buffers[0]->buffer,
+                .offset = 0,
+                .range = mParamsBuffer->bufferSize
+            };
+            descriptorSetSchema.AddUniformBuffer(&paramsBufferInfo);
+
+            // -----------Storage buffers-------------
+            for (auto const * bufferGroup : {
+                mParticleBuffer.get(),
+                mDeadListBuffer.get(),
+                mAliveListBuffer.get(),
+                mDrawListBuffer.get(),
+                mCountersBuffer.get()
+            })
+            {
+                VkDescriptorBufferInfo const bufferInfo {
+                    .buffer = bufferGroup->buffers[0]->buffer,
+                    .offset = 0,
+                    .range = bufferGroup->bufferSize
+                };
+                descriptorSetSchema.AddStorageBuffer(&bufferInfo);
+            }
 
-    //-------------------------------------------------------------------------------------------------
+            // -----------Emitters-------------
+            VkDescriptorBufferInfo const emitterBufferInfo {
+                .buffer = mEmitterBuffer->buffers[frameIndex]->buffer,
+                .offset = 0,
+                .range = mEmitterBuffer->bufferSize
+            };
+            descriptorSetSchema.AddStorageBuffer(&emitterBufferInfo);
 
-    void ParticleEssence::bindVertexBuffer(RT::CommandRecordState const & recordState) const
-    {
-        RF::BindVertexBuffer(
-            recordState,
-            *mVertexBuffer->buffers[0],
-            VERTEX_BUFFER_BIND_ID
-        );
+            // --------------------------------
+            descriptorSetSchema.UpdateDescriptorSets();
+        }
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticleEssence::updateInstanceData(VariantsList const & variants)
+    void ParticleEssence::updateEmitterData(VariantsList const & variants, float const deltaTimeInSec)
     {
         MFA_ASSERT(variants.size() <= mMaxInstanceCount);
-        mNextDrawInstanceCount = std::min<uint32_t>(
+        mEmitterCount = std::min<uint32_t>(
             static_cast<uint32_t>(variants.size()),
             mMaxInstanceCount
         );
 
-        auto * instanceData = mInstanceData->memory.as<PerInstanceData>();
+        auto & randomGenerator = Math::GetRandomGenerator();
 
-        uint32_t visibleVariantCount = 0;
-        for (uint32_t i = 0; i < mNextDrawInstanceCount; ++i)
+        mMaxEmitCount = 0;
+        for (uint32_t i = 0; i < mEmitterCount; ++i)
         {
             auto const & variant = CAST_VARIANT(variants[i]);
-            if (variant->IsVisible())
+            auto const & params = variant->getEmitterParams();
+            auto & emitter = mEmitterData[i];
+
+            variant->getWorldPosition(emitter.position);
+            Copy<3>(emitter.moveDirection, params.moveDirection);
+            Copy<3>(emitter.color, params.color);
+            emitter.radius = params.radius;
+            emitter.minLife = params.minLife;
+            emitter.maxLife = params.maxLife;
+            emitter.minSpeed = params.minSpeed;
+            emitter.maxSpeed = params.maxSpeed;
+            emitter.sizeScale = params.sizeScale;
+            emitter.seed = randomGenerator.NextUInt();
+
+            // Particles of hidden emitters keep their state until the emitter becomes visible again
+            emitter.isVisible = variant->IsVisible() ? 1 : 0;
+            if (emitter.isVisible != 0)
             {
-                variant->getWorldPosition(instanceData[visibleVariantCount].instancePosition);
-                ++visibleVariantCount;
+                emitter.emitCount = variant->consumeEmitCount(
+                    params.spawnRate,
+                    deltaTimeInSec,
+                    static_cast<uint32_t>(mParams.count)
+                );
             }
+            else
+            {
+                variant->resetEmitCount();
+                emitter.emitCount = 0;
+            }
+            mMaxEmitCount = std::max(mMaxEmitCount, emitter.emitCount);
         }
-        mNextDrawInstanceCount = visibleVariantCount;
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticleEssence::updateInstanceBuffer(RT::CommandRecordState const & recordState) const
+    void ParticleEssence::updateEmitterBuffer(RT::CommandRecordState const & recordState) const
     {
+        if (mEmitterCount == 0)
+        {
+            return;
+        }
         RF::UpdateHostVisibleBuffer(
-            *mInstanceBuffer->buffers[recordState.frameIndex],
-            mInstanceData->memory
+            *mEmitterBuffer->buffers[recordState.frameIndex],
+            CBlob {mEmitterData.data(), mEmitterCount * sizeof(EmitterData)}
         );
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticleEssence::bindInstanceBuffer(RT::CommandRecordState const & recordState) const
+    void ParticleEssence::bindGraphicDescriptorSet(RT::CommandRecordState const & recordState) const
     {
-        RF::BindVertexBuffer(
+        RF::AutoBindDescriptorSet(
             recordState,
-            *mInstanceBuffer->buffers[recordState.frameIndex],
-            INSTANCE_BUFFER_BIND_ID
+            RF::UpdateFrequency::PerEssence,
+            mGraphicDescriptorSet
         );
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticleEssence::bindIndexBuffer(RT::CommandRecordState const & recordState) const
+    void ParticleEssence::bindComputeDescriptorSet(RT::CommandRecordState const & recordState) const
     {
-        RF::BindIndexBuffer(
+        RF::AutoBindDescriptorSet(
             recordState,
-            *mIndexBuffer
+            RF::UpdateFrequency::PerEssence,
+            mComputeDescriptorSet
         );
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticleEssence::bindGraphicDescriptorSet(RT::CommandRecordState const & recordState) const
+    void ParticleEssence::pushConstants(
+        RT::CommandRecordState const & recordState,
+        ComputePushConstants const & pushConstants
+    ) const
     {
-        RF::AutoBindDescriptorSet(
+        RF::PushConstants(
             recordState,
-            RF::UpdateFrequency::PerEssence,
-            mGraphicDescriptorSet
+            AS::ShaderStage::Compute,
+            0,
+            CBlobAliasOf(pushConstants)
         );
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticleEssence::bindComputeDescriptorSet(RT::CommandRecordState const & recordState) const
+    ParticleEssence::ComputePushConstants ParticleEssence::makePushConstants() const
     {
-        RF::BindDescriptorSet(
-            recordState,
-            RF::UpdateFrequency::PerEssence,
-            mComputeDescriptorSet.descriptorSets[0]
-        );
+        return ComputePushConstants {
+            .currentList = mCurrentList,
+            .emitterCount = mEmitterCount,
+            .capacity = mCapacity
+        };
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -430,6 +679,10 @@ namespace MFA
     void ParticleEssence::checkIfUpdateIsRequired(VariantsList const & variants)
     {
         mShouldUpdate = false;
+        if (mIsInitialized == false)
+        {
+            return;
+        }
         for (auto const & variant : variants)
         {
             // TODO: We need an occlusion test for particles as well
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ParticleSort.hpp"
 #include "engine/render_system/pipelines/EssenceBase.hpp"
 #include "engine/asset_system/AssetParticleMesh.hpp"
 #include "engine/asset_system/AssetModel.hpp"
@@ -9,24 +10,68 @@ namespace MFA
 
     class VariantBase;
 
+    // Particles of all variants share a single pool on the gpu, Each variant is an emitter.
+    // Every frame the compute passes run in this order:
+    // emit (Pops the dead list) -> simulate (Compacts survivors into the other alive list) -> sort -> indirect draw.
+    // Cpu never reads the alive count back, Simulation and draw sizes come from indirect arguments.
     class ParticleEssence : public EssenceBase
     {
     public:
 
         using VariantsList = std::vector<std::shared_ptr<VariantBase>>;
 
+        // Shared by all particle compute shaders, Must match PushConsts in ParticleTypes.hlsl
+        struct ComputePushConstants
+        {
+            uint32_t currentList = 0;               // Alive list that holds the particles of the previous frame
+            uint32_t emitterCount = 0;
+            uint32_t capacity = 0;
+            uint32_t stage = 0;
+
+            uint32_t k = 0;
+            uint32_t j = 0;
+            uint32_t placeholder[2] {};
+        };
+
+        // Must match ParticleArgs.comp.hlsl
+        enum class ArgsStage : uint32_t
+        {
+            PrepareSimulation = 0,
+            PrepareDraw = 1
+        };
+
         ~ParticleEssence() override;
-        
+
         ParticleEssence & operator= (ParticleEssence && rhs) noexcept = delete;
         ParticleEssence (ParticleEssence const &) noexcept = delete;
         ParticleEssence (ParticleEssence && rhs) noexcept = delete;
         ParticleEssence & operator = (ParticleEssence const &) noexcept = delete;
 
-        void update(VariantsList const & variants);
+        void update(VariantsList const & variants, float deltaTimeInSec);
+
+        [[nodiscard]]
+        bool shouldUpdate() const;
+
+        [[nodiscard]]
+        bool requiresSorting() const;
 
+        // Queue family ownership transfer of the buffers that graphic queue reads
         void preComputeBarrier(std::vector<VkBufferMemoryBarrier> & outBarrier) const;
 
-        void compute(RT::CommandRecordState const & recordState);
+        // Makes the writes of the previous compute pass visible to the next one
+        void computeBarrier(std::vector<VkBufferMemoryBarrier> & outBarrier) const;
+
+        void emit(RT::CommandRecordState const & recordState);
+
+        void prepareArguments(RT::CommandRecordState const & recordState, ArgsStage stage) const;
+
+        void simulate(RT::CommandRecordState const & recordState) const;
+
+        // Records every pass of the bitonic sort, Passes depend on each other so each one is followed by a barrier
+        void sort(RT::CommandRecordState const & recordState) const;
+
+        // Alive lists are swapped once all compute passes of the frame are recorded
+        void endCompute();
 
         void preRenderBarrier(std::vector<VkBufferMemoryBarrier> & outBarrier) const;
 
@@ -34,6 +79,12 @@ namespace MFA
 
         void notifyParamsBufferUpdated();
 
+        [[nodiscard]]
+        AS::Particle::EmitterParams const & getDefaultEmitterParams() const;
+
+        [[nodiscard]]
+        uint32_t getCapacity() const;
+
         void createGraphicDescriptorSet(
             VkDescriptorPool descriptorPool,
             VkDescriptorSetLayout descriptorSetLayout,
@@ -51,69 +102,75 @@ namespace MFA
         explicit ParticleEssence(
             std::string nameId,
             AS::Particle::Params const & params,
+            AS::Particle::EmitterParams const & defaultEmitterParams,
             uint32_t maxInstanceCount,
             std::vector<std::shared_ptr<RT::GpuTexture>> textures
         );
 
-        void init(
-            CBlob const & vertexData,
-            CBlob const & indexData
-        );
+        void init();
 
     private:
 
-        void updateInstanceData(VariantsList const & variants);
+        void updateEmitterData(VariantsList const & variants, float deltaTimeInSec);
 
-        void updateInstanceBuffer(RT::CommandRecordState const & recordState) const;
-
-        void bindVertexBuffer(RT::CommandRecordState const & recordState) const;
-
-        void bindInstanceBuffer(RT::CommandRecordState const & recordState) const;
-
-        void bindIndexBuffer(RT::CommandRecordState const & recordState) const;
+        void updateEmitterBuffer(RT::CommandRecordState const & recordState) const;
 
         void bindGraphicDescriptorSet(RT::CommandRecordState const & recordState) const;
 
         void bindComputeDescriptorSet(RT::CommandRecordState const & recordState) const;
 
+        void pushConstants(RT::CommandRecordState const & recordState, ComputePushConstants const & pushConstants) const;
+
+        [[nodiscard]]
+        ComputePushConstants makePushConstants() const;
+
         void checkIfUpdateIsRequired(VariantsList const & variants);
 
         void updateParamsBuffer(RT::CommandRecordState const & recordState);
 
-        void createVertexBuffer(
-            VkCommandBuffer commandBuffer,
-            CBlob const & vertexBlob,
-            std::shared_ptr<RT::BufferGroup> & outStageBuffer
-        );
-
-        void createIndexBuffer(
+        void createParticleBuffers(
             VkCommandBuffer commandBuffer,
-            CBlob const & indexBlob,
-            std::shared_ptr<RT::BufferGroup> & outStageBuffer
+            std::vector<std::shared_ptr<RT::BufferGroup>> & outStageBuffers
         );
 
-        void createInstanceBuffer();
+        void createEmitterBuffer();
 
         void createParamsBuffer(
             VkCommandBuffer commandBuffer,
             std::shared_ptr<RT::BufferGroup> & outStageBuffer
         );
 
+        static void addBufferBarrier(
+            RT::BufferGroup const & bufferGroup,
+            VkAccessFlags sourceAccess,
+            VkAccessFlags destinationAccess,
+            uint32_t sourceQueueFamily,
+            uint32_t destinationQueueFamily,
+            std::vector<VkBufferMemoryBarrier> & outBarrier
+        );
+
     protected:
 
         bool mShouldUpdate = false; // We only have to update if variants are visible
 
-        std::shared_ptr<RT::BufferGroup> mVertexBuffer = nullptr;   // StorageBuffer | VertexBuffer     // Only 1
-        std::shared_ptr<RT::BufferAndMemory> mIndexBuffer = nullptr;                                    // Only 1
-        std::shared_ptr<RT::BufferGroup> mInstanceBuffer = nullptr; // VertexBuffer                     // Per frame
+        std::shared_ptr<RT::BufferGroup> mParticleBuffer = nullptr;     // Only 1
+        std::shared_ptr<RT::BufferGroup> mDeadListBuffer = nullptr;     // Only 1
+        std::shared_ptr<RT::BufferGroup> mAliveListBuffer = nullptr;    // Only 1, Holds both alive lists
+        std::shared_ptr<RT::BufferGroup> mDrawListBuffer = nullptr;     // Only 1, Padded to the sort size
+        std::shared_ptr<RT::BufferGroup> mCountersBuffer = nullptr;     // Only 1, Also used as indirect arguments
+        std::shared_ptr<RT::BufferGroup> mEmitterBuffer = nullptr;      // Per frame
 
         AS::Particle::Params mParams {};
 
+        AS::Particle::EmitterParams const mDefaultEmitterParams {};
+
         std::shared_ptr<RT::BufferGroup> mParamsBuffer = nullptr;
         std::shared_ptr<RT::BufferGroup> mParamsStageBuffer = nullptr;
 
         uint32_t const mMaxInstanceCount;
-        
+
+        uint32_t const mCapacity;
+
         std::vector<std::shared_ptr<RT::GpuTexture>> const mTextures;
 
         RT::DescriptorSetGroup mGraphicDescriptorSet {};
@@ -121,9 +178,15 @@ namespace MFA
 
     private:
 
-        std::shared_ptr<SmartBlob> mInstanceData {};
-        
-        uint32_t mNextDrawInstanceCount = 0;
+        std::vector<AS::Particle::EmitterData> mEmitterData {};
+
+        uint32_t mEmitterCount = 0;
+
+        uint32_t mMaxEmitCount = 0;
+
+        uint32_t mCurrentList = 0;
+
+        std::vector<ParticleSort::Pass> mSortPlan {};
 
         bool mIsInitialized = false;
 
@@ -68,7 +68,7 @@ namespace MFA
                 createPerFrameDescriptorSets();
 
                 createGraphicPipeline();
-                createComputePipeline();
+                createComputePipelines();
             });
 
         });
@@ -77,6 +77,18 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    void ParticlePipeline::onRenderQualityChanged()
+    {
+        // Init has not reached the main thread yet, Pipeline will be created with the new quality
+        if (mGraphicPipeline == nullptr)
+        {
+            return;
+        }
+        createGraphicPipeline();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void ParticlePipeline::shutdown()
     {
         BasePipeline::shutdown();
@@ -142,10 +154,10 @@ namespace MFA
 
         for (auto & essenceAndVariants : mEssenceAndVariantsMap)
         {
-            JS::AssignTask([&essenceAndVariants](uint32_t threadNumber, uint32_t threadCount)->void{
+            JS::AssignTask([&essenceAndVariants, deltaTimeInSec](uint32_t threadNumber, uint32_t threadCount)->void{
                 auto * essence = essenceAndVariants.second.essence.get();
                 auto const & variants = essenceAndVariants.second.variants;
-                CAST_ESSENCE_PURE(essence)->update(variants);
+                CAST_ESSENCE_PURE(essence)->update(variants, deltaTimeInSec);
             });
         }
 
@@ -183,24 +195,55 @@ namespace MFA
 
             RF::PipelineBarrier(
             	recordState,
-				VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+				VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
 				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
 			    static_cast<uint32_t>(barriers.size()),
                 barriers.data()
             );
 		}
 
-        RF::BindPipeline(recordState, *mComputePipeline);
+        // Each pass is recorded for all essences before the barrier, So essences do not wait for each other
 
-        RF::AutoBindDescriptorSet(
-            recordState,
-            RF::UpdateFrequency::PerFrame,
-            mPerFrameDescriptorSetGroup
-        );
+        // Emit: Pops particles from the dead list and appends them to the current alive list
+        bindComputePipeline(recordState, *mEmitPipeline);
+        for (auto * essence : mAllEssencesList)
+        {
+            CAST_ESSENCE_PURE(essence)->emit(recordState);
+        }
+        computeBarrier(recordState);
 
+        bindComputePipeline(recordState, *mArgsPipeline);
         for (auto * essence : mAllEssencesList)
         {
-            CAST_ESSENCE_PURE(essence)->compute(recordState);
+            CAST_ESSENCE_PURE(essence)->prepareArguments(recordState, ParticleEssence::ArgsStage::PrepareSimulation);
+        }
+        computeBarrier(recordState);
+
+        // Simulate: Dead particles go back to the dead list, Survivors are compacted into the next alive list
+        bindComputePipeline(recordState, *mSimulatePipeline);
+        for (auto * essence : mAllEssencesList)
+        {
+            CAST_ESSENCE_PURE(essence)->simulate(recordState);
+        }
+        computeBarrier(recordState);
+
+        bindComputePipeline(recordState, *mArgsPipeline);
+        for (auto * essence : mAllEssencesList)
+        {
+            CAST_ESSENCE_PURE(essence)->prepareArguments(recordState, ParticleEssence::ArgsStage::PrepareDraw);
+        }
+        computeBarrier(recordState);
+
+        // Sort: Back to front order for blended particles
+        bindComputePipeline(recordState, *mSortPipeline);
+        for (auto * essence : mAllEssencesList)
+        {
+            CAST_ESSENCE_PURE(essence)->sort(recordState);
+        }
+
+        for (auto * essence : mAllEssencesList)
+        {
+            CAST_ESSENCE_PURE(essence)->endCompute();
         }
 
         if (RF::GetComputeQueueFamily() != RF::GetGraphicQueueFamily())
@@ -215,7 +258,7 @@ namespace MFA
             RF::PipelineBarrier(
                 recordState,
                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
                 static_cast<uint32_t>(barriers.size()),
                 barriers.data()
             );
@@ -225,6 +268,43 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    void ParticlePipeline::bindComputePipeline(RT::CommandRecordState & recordState, RT::PipelineGroup & pipeline) const
+    {
+        RF::BindPipeline(recordState, pipeline);
+
+        RF::AutoBindDescriptorSet(
+            recordState,
+            RF::UpdateFrequency::PerFrame,
+            mPerFrameDescriptorSetGroup
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ParticlePipeline::computeBarrier(RT::CommandRecordState const & recordState) const
+    {
+        std::vector<VkBufferMemoryBarrier> barriers {};
+        for (auto * essence : mAllEssencesList)
+        {
+            CAST_ESSENCE_PURE(essence)->computeBarrier(barriers);
+        }
+
+        if (barriers.empty())
+        {
+            return;
+        }
+
+        RF::PipelineBarrier(
+            recordState,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+            static_cast<uint32_t>(barriers.size()),
+            barriers.data()
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     std::shared_ptr<EssenceBase> ParticlePipeline::CreateEssence(std::string const & nameId,
         std::shared_ptr<AssetSystem::Model> const & cpuModel,
         std::vector<std::shared_ptr<RT::GpuTexture>> const & gpuTextures)
@@ -273,7 +353,7 @@ namespace MFA
             .binding = static_cast<uint32_t>(bindings.size()),
             .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
             .descriptorCount = 1,
-            .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+            .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT,   // Compute uses it for the sort key
         };
         bindings.emplace_back(cameraBufferLayoutBinding);
 
@@ -313,6 +393,22 @@ namespace MFA
             .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
         });
 
+        // Particles
+        bindings.emplace_back(VkDescriptorSetLayoutBinding{
+            .binding = static_cast<uint32_t>(bindings.size()),
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+        });
+
+        // DrawList
+        bindings.emplace_back(VkDescriptorSetLayoutBinding{
+            .binding = static_cast<uint32_t>(bindings.size()),
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+        });
+
         mPerEssenceGraphicDescriptorSetLayout = RF::CreateDescriptorSetLayout(
             static_cast<uint8_t>(bindings.size()),
             bindings.data()
@@ -333,13 +429,17 @@ namespace MFA
             .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
         });
 
-        // Particles
-        bindings.emplace_back(VkDescriptorSetLayoutBinding {
-            .binding = static_cast<uint32_t>(bindings.size()),
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .descriptorCount = 1,
-            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
-        });
+        // Particles, DeadList, AliveLists, DrawList, Counters, Emitters
+        static constexpr uint32_t StorageBufferCount = 6;
+        for (uint32_t i = 0; i < StorageBufferCount; ++i)
+        {
+            bindings.emplace_back(VkDescriptorSetLayoutBinding {
+                .binding = static_cast<uint32_t>(bindings.size()),
+                .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                .descriptorCount = 1,
+                .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+            });
+        }
 
         mPerEssenceComputeDescriptorSetLayout = RF::CreateDescriptorSetLayout(
             static_cast<uint8_t>(bindings.size()),
@@ -399,27 +499,42 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
-    void ParticlePipeline::createComputePipeline()
+    void ParticlePipeline::createComputePipelines()
     {
-        RF_CREATE_SHADER("shaders/particle/Particle.comp.spv", Compute)
+        mEmitPipeline = createComputePipeline("shaders/particle/ParticleEmit.comp.spv");
+        mArgsPipeline = createComputePipeline("shaders/particle/ParticleArgs.comp.spv");
+        mSimulatePipeline = createComputePipeline("shaders/particle/Particle.comp.spv");
+        mSortPipeline = createComputePipeline("shaders/particle/ParticleSort.comp.spv");
+    }
 
-        std::vector<RT::GpuShader const *> shaders {gpuComputeShader.get()};
+    //-------------------------------------------------------------------------------------------------
+
+    std::shared_ptr<RT::PipelineGroup> ParticlePipeline::createComputePipeline(char const * shaderPath) const
+    {
+        RF_CREATE_SHADER(shaderPath, Compute)
 
         std::vector<VkDescriptorSetLayout> const descriptorSetLayouts {
             mPerFrameDescriptorSetLayout->descriptorSetLayout,
             mPerEssenceComputeDescriptorSetLayout->descriptorSetLayout,
         };
 
+        VkPushConstantRange const pushConstantRange {
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+            .offset = 0,
+            .size = sizeof(ParticleEssence::ComputePushConstants),
+        };
+
         auto const pipelineLayout = RF::CreatePipelineLayout(
             static_cast<uint32_t>(descriptorSetLayouts.size()),
             descriptorSetLayouts.data(),
-            0,
-            nullptr
+            1,
+            &pushConstantRange
         );
         MFA_ASSERT(pipelineLayout != VK_NULL_HANDLE);
 
-        mComputePipeline = RF::CreateComputePipeline(*gpuComputeShader, pipelineLayout);
-        MFA_ASSERT(mComputePipeline != nullptr);
+        auto pipeline = RF::CreateComputePipeline(*gpuComputeShader, pipelineLayout);
+        MFA_ASSERT(pipeline != nullptr);
+        return pipeline;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -431,68 +546,10 @@ namespace MFA
 
         std::vector<RT::GpuShader const *> shaders{ gpuVertexShader.get(), gpuFragmentShader.get() };
 
-        std::vector<VkVertexInputBindingDescription> vertexInputBindingDescriptions {};
-        vertexInputBindingDescriptions.emplace_back(VkVertexInputBindingDescription {
-            .binding = 0,
-            .stride = sizeof(Vertex),
-            .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
-        });
-        vertexInputBindingDescriptions.emplace_back(VkVertexInputBindingDescription {
-            .binding = 1,
-            .stride = sizeof(PerInstanceData),
-            .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE
-        });
-
-        std::vector<VkVertexInputAttributeDescription> inputAttributeDescriptions{};
-
-        // Position
-        inputAttributeDescriptions.emplace_back(VkVertexInputAttributeDescription{
-            .location = static_cast<uint32_t>(inputAttributeDescriptions.size()),
-            .binding = 0,
-            .format = VK_FORMAT_R32G32B32_SFLOAT,
-            .offset = offsetof(Vertex, localPosition)
-        });
-
-        // Texture index
-        inputAttributeDescriptions.emplace_back(VkVertexInputAttributeDescription{
-            .location = static_cast<uint32_t>(inputAttributeDescriptions.size()),
-            .binding = 0,
-            .format = VK_FORMAT_R32_SINT,
-            .offset = offsetof(Vertex, textureIndex)
-        });
-
-        // Color
-        inputAttributeDescriptions.emplace_back(VkVertexInputAttributeDescription{
-            .location = static_cast<uint32_t>(inputAttributeDescriptions.size()),
-            .binding = 0,
-            .format = VK_FORMAT_R32G32B32_SFLOAT,
-            .offset = offsetof(Vertex, color)
-        });
+        // Vertex shader reads the particles from storage buffers using the vertex index
+        std::vector<VkVertexInputBindingDescription> const vertexInputBindingDescriptions {};
+        std::vector<VkVertexInputAttributeDescription> inputAttributeDescriptions {};
 
-        // Alpha
-        inputAttributeDescriptions.emplace_back(VkVertexInputAttributeDescription{
-            .location = static_cast<uint32_t>(inputAttributeDescriptions.size()),
-            .binding = 0,
-            .format = VK_FORMAT_R32_SFLOAT,
-            .offset = offsetof(Vertex, alpha)
-        });
-
-        // PointSize
-        inputAttributeDescriptions.emplace_back(VkVertexInputAttributeDescription{
-            .location = static_cast<uint32_t>(inputAttributeDescriptions.size()),
-            .binding = 0,
-            .format = VK_FORMAT_R32_SFLOAT,
-            .offset = offsetof(Vertex, pointSize)
-        });
-
-        // Instance position
-        inputAttributeDescriptions.emplace_back(VkVertexInputAttributeDescription {
-            .location = static_cast<uint32_t>(inputAttributeDescriptions.size()),
-            .binding = 1,
-            .format =VK_FORMAT_R32G32B32_SFLOAT,
-            .offset = offsetof(PerInstanceData, instancePosition)
-        });
-        
         std::vector<VkPushConstantRange> pushConstantRanges {};
         VkPushConstantRange pushConstantRange{
             .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
@@ -503,7 +560,7 @@ namespace MFA
         
         RT::CreateGraphicPipelineOptions pipelineOptions{};
         pipelineOptions.primitiveTopology = VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
-        pipelineOptions.rasterizationSamples = RF::GetMaxSamplesCount();
+        pipelineOptions.rasterizationSamples = RF::GetRenderQuality().displaySampleCount;
         pipelineOptions.cullMode = VK_CULL_MODE_NONE;
         pipelineOptions.colorBlendAttachments.blendEnable = VK_TRUE;
         pipelineOptions.colorBlendAttachments.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
@@ -35,6 +35,8 @@ namespace MFA
 
         void onResize() override {}
 
+        void onRenderQualityChanged() override;
+
         void shutdown() override;
         
         void render(RT::CommandRecordState & recordState, float deltaTimeInSec) override;
@@ -64,9 +66,17 @@ namespace MFA
 
         void createPerFrameDescriptorSets();
         
-        void createComputePipeline();
+        void createComputePipelines();
+
+        [[nodiscard]]
+        std::shared_ptr<RT::PipelineGroup> createComputePipeline(char const * shaderPath) const;
 
         void createGraphicPipeline();
+
+        void bindComputePipeline(RT::CommandRecordState & recordState, RT::PipelineGroup & pipeline) const;
+
+        // Waits for the writes of the previous particle pass, Indirect arguments included
+        void computeBarrier(RT::CommandRecordState const & recordState) const;
         
         static constexpr int MAXIMUM_TEXTURE_PER_ESSENCE = 10;
         
@@ -79,7 +89,10 @@ namespace MFA
         std::shared_ptr<RT::SamplerGroup> mSamplerGroup {};
         std::shared_ptr<RT::GpuTexture> mErrorTexture {};
 
-        std::shared_ptr<RT::PipelineGroup> mComputePipeline {};
+        std::shared_ptr<RT::PipelineGroup> mEmitPipeline {};
+        std::shared_ptr<RT::PipelineGroup> mArgsPipeline {};
+        std::shared_ptr<RT::PipelineGroup> mSimulatePipeline {};
+        std::shared_ptr<RT::PipelineGroup> mSortPipeline {};
         std::shared_ptr<RT::PipelineGroup> mGraphicPipeline {};
     };
 
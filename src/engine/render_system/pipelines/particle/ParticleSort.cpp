@@ -0,0 +1,60 @@
+#include "ParticleSort.hpp"
+
+#include "engine/BedrockAssert.hpp"
+
+namespace MFA::ParticleSort
+{
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t PaddedCount(uint32_t const count)
+    {
+        MFA_ASSERT(count <= (1u << 31));
+        uint32_t paddedCount = LocalSize;
+        while (paddedCount < count)
+        {
+            paddedCount <<= 1;
+        }
+        return paddedCount;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void BuildPlan(uint32_t const count, std::vector<Pass> & outPasses)
+    {
+        outPasses.clear();
+
+        auto const paddedCount = PaddedCount(count);
+        auto const localGroupCount = paddedCount / LocalSize;
+        auto const globalGroupCount = paddedCount / 2 / GroupSize;
+
+        outPasses.emplace_back(Pass {
+            .stage = Stage::LocalSort,
+            .k = LocalSize,
+            .j = 0,
+            .groupCount = localGroupCount
+        });
+
+        for (uint32_t k = LocalSize * 2; k <= paddedCount; k <<= 1)
+        {
+            for (uint32_t j = k >> 1; j >= LocalSize; j >>= 1)
+            {
+                outPasses.emplace_back(Pass {
+                    .stage = Stage::GlobalMerge,
+                    .k = k,
+                    .j = j,
+                    .groupCount = globalGroupCount
+                });
+            }
+            outPasses.emplace_back(Pass {
+                .stage = Stage::LocalMerge,
+                .k = k,
+                .j = 0,
+                .groupCount = localGroupCount
+            });
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Dispatch plan of the bitonic sort in ParticleSort.comp.hlsl.
+// Stages that fit into a work group run in shared memory, Only the large merge steps touch the storage buffer per step.
+namespace MFA::ParticleSort
+{
+
+    // Must match ParticleSort.comp.hlsl
+    static constexpr uint32_t GroupSize = 256;
+    static constexpr uint32_t LocalSize = GroupSize * 2;   // Each thread sorts two entries
+
+    enum class Stage : uint32_t
+    {
+        LocalSort = 0,              // Sorts each block of LocalSize entries, Entries beyond the alive count are replaced by a sentinel
+        GlobalMerge = 1,            // Single compare and swap step with distance j >= LocalSize
+        LocalMerge = 2              // Remaining steps of merge k with distance j < LocalSize
+    };
+
+    struct Pass
+    {
+        Stage stage = Stage::LocalSort;
+        uint32_t k = 0;             // Size of the bitonic sequences that are being merged
+        uint32_t j = 0;             // Compare distance, Only used by GlobalMerge
+        uint32_t groupCount = 0;
+    };
+
+    // Sort buffer must hold this many entries, Power of two and at least LocalSize
+    [[nodiscard]]
+    uint32_t PaddedCount(uint32_t count);
+
+    void BuildPlan(uint32_t count, std::vector<Pass> & outPasses);
+
+}
@@ -2,9 +2,12 @@
 
 #include "ParticleEssence.hpp"
 #include "engine/BedrockMatrix.hpp"
-#include "engine/asset_system/AssetParticleMesh.hpp"
+#include "engine/entity_system/Entity.hpp"
+#include "engine/entity_system/components/ParticleEmitterComponent.hpp"
 #include "engine/entity_system/components/TransformComponent.hpp"
 
+#include <cmath>
+
 namespace MFA
 {
     using namespace AS::Particle;
@@ -34,4 +37,42 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    EmitterParams const & ParticleVariant::getEmitterParams() const
+    {
+        if (auto const ptr = mEmitterComponent.lock())
+        {
+            return ptr->GetParams();
+        }
+        return static_cast<ParticleEssence const *>(mEssence)->getDefaultEmitterParams();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t ParticleVariant::consumeEmitCount(float const spawnRate, float const deltaTimeInSec, uint32_t const maxCount)
+    {
+        mSpawnRemainder += Math::Max(spawnRate, 0.0f) * deltaTimeInSec;
+        auto const emitCount = std::floor(mSpawnRemainder);
+        mSpawnRemainder -= emitCount;
+        return Math::Min(static_cast<uint32_t>(emitCount), maxCount);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ParticleVariant::resetEmitCount()
+    {
+        mSpawnRemainder = 0.0f;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void ParticleVariant::internalInit()
+    {
+        VariantBase::internalInit();
+
+        // Optional
+        mEmitterComponent = mEntity->GetComponent<ParticleEmitterComponent>();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
 }
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "engine/render_system/pipelines/VariantBase.hpp"
+#include "engine/asset_system/AssetParticleMesh.hpp"
 
 namespace MFA
 {
     class ParticleEssence;
+    class ParticleEmitterComponent;
 
     class ParticleVariant final : public VariantBase
     {
@@ -19,8 +21,27 @@ namespace MFA
         ParticleVariant & operator= (ParticleVariant && rhs) noexcept = delete;
 
         bool getWorldPosition(float outWorldPosition[3]) const;
-        
+
+        // Returns params of the emitter component, Or default params of the essence when the entity has none
+        [[nodiscard]]
+        AS::Particle::EmitterParams const & getEmitterParams() const;
+
+        // Number of particles to spawn this frame, Fractions are carried to the next frame
+        [[nodiscard]]
+        uint32_t consumeEmitCount(float spawnRate, float deltaTimeInSec, uint32_t maxCount);
+
+        // Hidden emitters do not accumulate particles, So they do not burst when they become visible
+        void resetEmitCount();
+
     protected:
-    
+
+        void internalInit() override;
+
+    private:
+
+        std::weak_ptr<ParticleEmitterComponent> mEmitterComponent {};
+
+        float mSpawnRemainder = 0.0f;
+
     };
 }
@@ -259,55 +259,99 @@ void MFA::PBR_Essence::createGraphicDescriptorSet(
         RF::GetMaxFramesPerFlight(),
         descriptorSetLayout
     );
+    mErrorTexture = &errorTexture;
+    mWrittenResidencyVersions.resize(RF::GetMaxFramesPerFlight());
 
     for (uint32_t frameIndex = 0; frameIndex < RF::GetMaxFramesPerFlight(); ++frameIndex)
     {
-        auto const & descriptorSet = mGraphicDescriptorSet.descriptorSets[frameIndex];
-        MFA_ASSERT(descriptorSet != VK_NULL_HANDLE);
-
-        DescriptorSetSchema descriptorSetSchema{ descriptorSet };
-
-        /////////////////////////////////////////////////////////////////
-        // Fragment shader
-        /////////////////////////////////////////////////////////////////
-
-        // Primitives
-        VkDescriptorBufferInfo primitiveBufferInfo{
-            .buffer = mPrimitivesBuffer->buffers[0]->buffer,
-            .offset = 0,
-            .range = mPrimitivesBuffer->bufferSize,
-        };
-        descriptorSetSchema.AddUniformBuffer(&primitiveBufferInfo);
-
-        // TODO Each one need their own sampler
-        // Textures
-        MFA_ASSERT(mTextures.size() <= MAX_TEXTURE_COUNT);
-        // We need to keep imageInfos alive
-        std::vector<VkDescriptorImageInfo> imageInfos{};
-        for (auto const & texture : mTextures)
-        {
-            imageInfos.emplace_back(VkDescriptorImageInfo{
-                .sampler = VK_NULL_HANDLE,
-                .imageView = texture->imageView->imageView,
-                .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-            });
-        }
-        for (auto i = static_cast<uint32_t>(mTextures.size()); i < MAX_TEXTURE_COUNT; ++i)
-        {
-            imageInfos.emplace_back(VkDescriptorImageInfo{
-                .sampler = VK_NULL_HANDLE,
-                .imageView = errorTexture.imageView->imageView,
-                .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-            });
-        }
-        MFA_ASSERT(imageInfos.size() == MAX_TEXTURE_COUNT);
-        descriptorSetSchema.AddImage(
-            imageInfos.data(),
-            static_cast<uint32_t>(imageInfos.size())
-        );
+        writeGraphicDescriptorSet(frameIndex);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::PBR_Essence::updateGraphicDescriptorSet(RT::CommandRecordState const & recordState)
+{
+    MFA_ASSERT(recordState.frameIndex < mWrittenResidencyVersions.size());
+    // Set of this frame index is not used by any frame in flight
+    if (mWrittenResidencyVersions[recordState.frameIndex] != computeResidencyVersion())
+    {
+        writeGraphicDescriptorSet(recordState.frameIndex);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
+std::vector<std::shared_ptr<MFA::RT::GpuTexture>> const & MFA::PBR_Essence::getTextures() const
+{
+    return mTextures;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::PBR_Essence::writeGraphicDescriptorSet(uint32_t const frameIndex)
+{
+    MFA_ASSERT(mErrorTexture != nullptr);
 
-        descriptorSetSchema.UpdateDescriptorSets();
+    auto const & descriptorSet = mGraphicDescriptorSet.descriptorSets[frameIndex];
+    MFA_ASSERT(descriptorSet != VK_NULL_HANDLE);
+
+    DescriptorSetSchema descriptorSetSchema{ descriptorSet };
+
+    /////////////////////////////////////////////////////////////////
+    // Fragment shader
+    /////////////////////////////////////////////////////////////////
+
+    // Primitives
+    VkDescriptorBufferInfo primitiveBufferInfo{
+        .buffer = mPrimitivesBuffer->buffers[0]->buffer,
+        .offset = 0,
+        .range = mPrimitivesBuffer->bufferSize,
+    };
+    descriptorSetSchema.AddUniformBuffer(&primitiveBufferInfo);
+
+    // TODO Each one need their own sampler
+    // Textures
+    MFA_ASSERT(mTextures.size() <= MAX_TEXTURE_COUNT);
+    // We need to keep imageInfos alive
+    std::vector<VkDescriptorImageInfo> imageInfos{};
+    for (auto const & texture : mTextures)
+    {
+        imageInfos.emplace_back(VkDescriptorImageInfo{
+            .sampler = VK_NULL_HANDLE,
+            .imageView = texture->imageView->imageView,
+            .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        });
+    }
+    for (auto i = static_cast<uint32_t>(mTextures.size()); i < MAX_TEXTURE_COUNT; ++i)
+    {
+        imageInfos.emplace_back(VkDescriptorImageInfo{
+            .sampler = VK_NULL_HANDLE,
+            .imageView = mErrorTexture->imageView->imageView,
+            .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        });
+    }
+    MFA_ASSERT(imageInfos.size() == MAX_TEXTURE_COUNT);
+    descriptorSetSchema.AddImage(
+        imageInfos.data(),
+        static_cast<uint32_t>(imageInfos.size())
+    );
+
+    descriptorSetSchema.UpdateDescriptorSets();
+
+    mWrittenResidencyVersions[frameIndex] = computeResidencyVersion();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+uint64_t MFA::PBR_Essence::computeResidencyVersion() const
+{
+    uint64_t version = mErrorTexture->residencyVersion;
+    for (auto const & texture : mTextures)
+    {
+        version += texture->residencyVersion;
     }
+    return version;
 }
 
 //-------------------------------------------------------------------------------------------------
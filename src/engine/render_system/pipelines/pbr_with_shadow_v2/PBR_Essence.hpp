@@ -115,6 +115,13 @@ public:
         VkDescriptorSetLayout descriptorSetLayout
     );
 
+    // Rewrites the descriptor set of this frame when a streamed texture has replaced its image.
+    // Must be called before the set is bound in this frame.
+    void updateGraphicDescriptorSet(RT::CommandRecordState const & recordState);
+
+    [[nodiscard]]
+    std::vector<std::shared_ptr<RT::GpuTexture>> const & getTextures() const;
+
     void bindForGraphicPipeline(RT::CommandRecordState const & recordState) const;
 
     void bindForComputePipeline(RT::CommandRecordState const & recordState) const;
@@ -134,9 +141,19 @@ private:
     void bindGraphicDescriptorSet(RT::CommandRecordState const & recordState) const;
 
     void bindComputeDescriptorSet(RT::CommandRecordState const & recordState) const;
-    
+
+    void writeGraphicDescriptorSet(uint32_t frameIndex);
+
+    // Sum of the texture versions only grows, So it changes whenever any texture is replaced
+    [[nodiscard]]
+    uint64_t computeResidencyVersion() const;
+
     RT::DescriptorSetGroup mGraphicDescriptorSet {};
 
+    RT::GpuTexture const * mErrorTexture = nullptr;         // Owned by the pipeline
+
+    std::vector<uint64_t> mWrittenResidencyVersions {};     // Per frame
+
     RT::DescriptorSetGroup mComputeDescriptorSet {};
 
     std::shared_ptr<RT::BufferGroup> mPrimitivesBuffer = nullptr;
@@ -20,6 +20,19 @@ namespace MFA
     // TODO: We have to separate PBR and animation
     // TODO: We need an animator component
     using namespace AS::PBR;
+
+    struct AnimationLOD
+    {
+        float minScreenSize;            // See BoundingVolumeComponent::GetScreenSize
+        uint32_t updateInterval;        // In frames
+    };
+
+    static constexpr AnimationLOD AnimationLODs[] {
+        {.minScreenSize = 0.25f, .updateInterval = 1},
+        {.minScreenSize = 0.08f, .updateInterval = 2},
+        {.minScreenSize = 0.0f, .updateInterval = 4},
+    };
+
     //-------------------------------------------------------------------------------------------------
 
     PBR_Variant::PBR_Variant(PBR_Essence const * essence)
@@ -77,6 +90,8 @@ namespace MFA
 
         prepareSkinJointsBuffer();
         prepareSkinnedVerticesBuffer(essence->getVertexCount());
+
+        mAnimationFrameIndex = static_cast<uint32_t>(mId);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -141,15 +156,57 @@ namespace MFA
             return;
         }
 
-        // If object is not visible we only need to update animation time and we can avoid updating skin joints
-        auto const isVisible = IsVisible();
-        updateAnimation(deltaTimeInSec, isVisible);
-        computeNodesGlobalTransform();
-        if (isVisible)
+        // If object is not visible we only need to update animation time, Hierarchy is evaluated when it becomes visible again
+        if (IsVisible() == false)
         {
+            updateAnimation(deltaTimeInSec, false);
+            mWasVisible = false;
+            return;
+        }
+
+        // Small variants evaluate their animation every few frames
+        mAnimationUpdateInterval = computeAnimationUpdateInterval();
+        mSkippedAnimationTimeInSec += deltaTimeInSec;
+        bool const shouldUpdateAnimation = mWasVisible == false || mAnimationFrameIndex % mAnimationUpdateInterval == 0;
+        ++mAnimationFrameIndex;
+
+        if (shouldUpdateAnimation)
+        {
+            if (mIsSkinJointsInterpolated)
+            {
+                // Skin joints are only written when they change, So we need the evaluated values back
+                auto * joints = reinterpret_cast<JointTransformData *>(mCachedSkinsJointsBlob->memory.ptr);
+                for (size_t i = 0; i < mTargetSkinsJoints.size(); ++i)
+                {
+                    joints[i].model = mTargetSkinsJoints[i];
+                }
+                mIsSkinJointsInterpolated = false;
+            }
+
+            updateAnimation(mSkippedAnimationTimeInSec, true);
+            mSkippedAnimationTimeInSec = 0.0f;
+            computeNodesGlobalTransform();
             updateAllSkinsJoints();
+            mIsModelTransformChanged = false;
+
+            storeSkinsJointsForInterpolation(mWasVisible == false);
+            mFramesSinceAnimationUpdate = 0;
+        }
+        else
+        {
+            ++mFramesSinceAnimationUpdate;
+            if (mIsModelTransformChanged)
+            {
+                updateNodesModelTransform();
+                mIsModelTransformChanged = false;
+            }
+        }
+
+        if (mAnimationUpdateInterval > 1)
+        {
+            interpolateSkinsJoints();
         }
-        mIsModelTransformChanged = false;
+        mWasVisible = true;
         
         // We update buffers after all of computations
 
@@ -309,7 +366,7 @@ namespace MFA
                                 Copy<4>(rotPrev, previousOutput);
                                 Copy<4>(rotNext, nextOutput);
 
-                                node.currentRotation = glm::slerp(rotPrev, rotNext, fraction);
+                                node.currentRotation = Matrix::Slerp(rotPrev, rotNext, fraction);
                             }
                             else if (channel.path == Animation::Path::Scale)
                             {
@@ -396,7 +453,7 @@ namespace MFA
                             Copy<4>(rotPrev, previousOutput);
                             Copy<4>(rotNext, nextOutput);
 
-                            node.previousRotation = glm::slerp(rotPrev, rotNext, fraction);
+                            node.previousRotation = Matrix::Slerp(rotPrev, rotNext, fraction);
                         }
                         else if (channel.path == Animation::Path::Scale)
                         {
@@ -423,6 +480,94 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    uint32_t PBR_Variant::computeAnimationUpdateInterval() const
+    {
+        auto const screenSize = GetScreenSize();
+        for (auto const & lod : AnimationLODs)
+        {
+            if (screenSize >= lod.minScreenSize)
+            {
+                return lod.updateInterval;
+            }
+        }
+        return AnimationLODs[std::size(AnimationLODs) - 1].updateInterval;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void PBR_Variant::updateNodesModelTransform()
+    {
+        auto const transformComponentPtr = mTransformComponent.lock();
+        if (transformComponentPtr == nullptr)
+        {
+            return;
+        }
+        auto const & worldTransform = transformComponentPtr->GetWorldTransform();
+        for (auto & node : mNodes)
+        {
+            if (node.isCachedDataValid && node.meshNode->hasSubMesh())
+            {
+                node.cachedModelTransform = worldTransform * node.cachedGlobalTransform;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void PBR_Variant::storeSkinsJointsForInterpolation(bool const resetPrevious)
+    {
+        if (mCachedSkinsJointsBlob == nullptr)
+        {
+            return;
+        }
+
+        auto const jointsCount = mCachedSkinsJointsBlob->memory.len / sizeof(JointTransformData);
+        auto const * joints = reinterpret_cast<JointTransformData const *>(mCachedSkinsJointsBlob->memory.ptr);
+
+        mTargetSkinsJoints.resize(jointsCount);
+        if (resetPrevious == false)
+        {
+            mPreviousSkinsJoints.swap(mTargetSkinsJoints);
+            mTargetSkinsJoints.resize(jointsCount);
+        }
+        for (size_t i = 0; i < jointsCount; ++i)
+        {
+            mTargetSkinsJoints[i] = joints[i].model;
+        }
+        if (resetPrevious)
+        {
+            mPreviousSkinsJoints = mTargetSkinsJoints;
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // We display the pose between the last two evaluated frames, This adds (interval - 1) frames of latency
+    // but avoids the visible stutter of holding a pose. Linear blend of matrices is fine for small steps.
+    void PBR_Variant::interpolateSkinsJoints()
+    {
+        if (mTargetSkinsJoints.empty() || mPreviousSkinsJoints.size() != mTargetSkinsJoints.size())
+        {
+            return;
+        }
+
+        auto const fraction = std::min(
+            static_cast<float>(mFramesSinceAnimationUpdate + 1) / static_cast<float>(mAnimationUpdateInterval),
+            1.0f
+        );
+
+        auto * joints = reinterpret_cast<JointTransformData *>(mCachedSkinsJointsBlob->memory.ptr);
+        for (size_t i = 0; i < mTargetSkinsJoints.size(); ++i)
+        {
+            joints[i].model = mPreviousSkinsJoints[i] + (mTargetSkinsJoints[i] - mPreviousSkinsJoints[i]) * fraction;
+        }
+
+        mIsSkinJointsInterpolated = true;
+        mIsSkinJointsChanged = true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void PBR_Variant::computeNodesGlobalTransform()
     {
         // TODO: For root nodes we should apply root motion to transform instead if possible (But which one is the root transform ?)
@@ -457,7 +602,7 @@ namespace MFA
             if (joint.isCachedGlobalTransformChanged)
             {
                 auto const nodeMatrix = joint.cachedGlobalTransform;
-                jointMatrices[i].model = nodeMatrix * skin.inverseBindMatrices[i];  // T - S = changes
+                jointMatrices[i].model = Matrix::Multiply(nodeMatrix, skin.inverseBindMatrices[i]);  // T - S = changes
                 joint.isCachedGlobalTransformChanged = false;
                 mIsSkinJointsChanged = true;
             }
@@ -564,7 +709,6 @@ namespace MFA
 
     glm::mat4 PBR_Variant::computeNodeLocalTransform(Node const & node) const
     {
-        glm::mat4 currentTransform{ 1 };
         auto translate = node.currentTranslate;
         auto rotation = node.currentRotation;
         auto scale = node.currentScale;
@@ -572,14 +716,10 @@ namespace MFA
         {
             auto const fraction = (mAnimationTransitionDurationInSec - mAnimationRemainingTransitionDurationInSec) / mAnimationTransitionDurationInSec;
             translate = glm::mix(node.previousTranslate, translate, fraction);
-            rotation = glm::slerp(node.previousRotation, rotation, fraction);
+            rotation = Matrix::Slerp(node.previousRotation, rotation, fraction);
             scale = glm::mix(node.previousScale, scale, fraction);
         }
-        currentTransform = glm::translate(currentTransform, translate);
-        currentTransform = currentTransform * glm::toMat4(rotation);
-        currentTransform = glm::scale(currentTransform, scale);
-        currentTransform = currentTransform * node.currentTransform;
-        return currentTransform;
+        return Matrix::Multiply(Matrix::ComposeTRS(translate, rotation, scale), node.currentTransform);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -604,7 +744,7 @@ namespace MFA
             }
             else
             {
-                node.cachedGlobalTransform = parentNode->cachedGlobalTransform * node.cachedLocalTransform;
+                node.cachedGlobalTransform = Matrix::Multiply(parentNode->cachedGlobalTransform, node.cachedLocalTransform);
             }
             isChanged = true;
             node.isCachedGlobalTransformChanged = true;
@@ -614,13 +754,13 @@ namespace MFA
         {
             if (auto const transformComponentPtr = mTransformComponent.lock())
             {
-                node.cachedModelTransform = transformComponentPtr->GetWorldTransform() * node.cachedGlobalTransform;
+                node.cachedModelTransform = Matrix::Multiply(transformComponentPtr->GetWorldTransform(), node.cachedGlobalTransform);
             }
         }
         if (isChanged && node.meshNode->hasSubMesh() && node.meshNode->skin > -1)
         {
-            // TODO Knowing that there is no scale we might be able to compute this cheaper
-            node.cachedGlobalInverseTransform = glm::inverse(node.cachedGlobalTransform);
+            // Node transforms are always affine
+            node.cachedGlobalInverseTransform = Matrix::AffineInverse(node.cachedGlobalTransform);
         }
 
         node.isCachedDataValid = true;
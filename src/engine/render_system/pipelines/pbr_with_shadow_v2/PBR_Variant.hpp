@@ -133,6 +133,15 @@ namespace MFA
 
         void updateAnimation(float deltaTimeInSec, bool isVisible);
 
+        [[nodiscard]]
+        uint32_t computeAnimationUpdateInterval() const;
+
+        void updateNodesModelTransform();
+
+        void storeSkinsJointsForInterpolation(bool resetPrevious);
+
+        void interpolateSkinsJoints();
+
         void computeNodesGlobalTransform();
 
         void updateAllSkinsJoints();
@@ -214,6 +223,17 @@ namespace MFA
 
         size_t mAnimationInputIndex[300]{};
 
+        // Animation LOD
+        uint32_t mAnimationUpdateInterval = 1;
+        uint32_t mAnimationFrameIndex = 0;              // Starts from variant id so instances do not update on the same frame
+        uint32_t mFramesSinceAnimationUpdate = 0;
+        float mSkippedAnimationTimeInSec = 0.0f;
+        bool mWasVisible = false;
+        bool mIsSkinJointsInterpolated = false;
+        // Joint palettes of the last two evaluated frames. Skipped frames are interpolated between them.
+        std::vector<glm::mat4> mPreviousSkinsJoints {};
+        std::vector<glm::mat4> mTargetSkinsJoints {};
+
         RT::DescriptorSetGroup mComputeDescriptorSet {};
 
         std::shared_ptr<RT::BufferGroup> mSkinsJointsBuffer{};
@@ -82,7 +82,7 @@ namespace MFA
         , mDirectionalLightShadowRenderPass(std::make_unique<DirectionalLightShadowRenderPass>())
         , mDirectionalLightShadowResources(std::make_unique<DirectionalLightShadowResources>())
         , mDepthPrePass(std::make_unique<DepthPrePass>())
-        , mOcclusionRenderPass(std::make_unique<OcclusionRenderPass>())
+        , mOcclusionRenderPass(std::make_unique<OcclusionRenderPass>(mDepthPrePass.get()))
     {
     }
 
@@ -209,6 +209,9 @@ namespace MFA
     {
         BasePipeline::compute(recordState, deltaTime);
 
+        // Compute is the first pass of the frame, So the sets are updated before any of them is bound
+        updateTextureStreaming(recordState);
+
         updateVariantsBuffers(recordState);
 
         preComputeBarrier(recordState);
@@ -233,6 +236,38 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    void PBRWithShadowPipelineV2::updateTextureStreaming(RT::CommandRecordState const & recordState)
+    {
+        // Screen size is the radius of the bounding volume relative to half of the screen height
+        auto const screenHeight = static_cast<float>(RF::GetRenderExtent().height);
+
+        for (auto const & essenceAndVariantList : mEssenceAndVariantsMap)
+        {
+            auto * essence = CAST_ESSENCE_SHARED(essenceAndVariantList.second.essence);
+
+            // Textures are shared by every variant of the essence, So the largest visible one decides
+            float screenSize = 0.0f;
+            for (auto const & variant : essenceAndVariantList.second.variants)
+            {
+                if (variant->IsVisible())
+                {
+                    screenSize = std::max(screenSize, variant->GetScreenSize());
+                }
+            }
+            if (screenSize > 0.0f)
+            {
+                for (auto const & texture : essence->getTextures())
+                {
+                    RC::RequestTextureMips(*texture, screenSize * screenHeight);
+                }
+            }
+
+            essence->updateGraphicDescriptorSet(recordState);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void PBRWithShadowPipelineV2::performSkinning(RT::CommandRecordState & recordState)
     {
         RF::BindPipeline(recordState, *mSkinningPipeline);
@@ -371,7 +406,11 @@ namespace MFA
 
         prepareShadowMapsForSampling(recordState);
 
-        RF::GetDisplayRenderPass()->notifyDepthImageLayoutIsSet();
+        // Otherwise display pass clears its own depth image
+        if (mDepthPrePass->IsSharingDisplayDepth())
+        {
+            RF::GetDisplayRenderPass()->notifyDepthImageLayoutIsSet();
+        }
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -397,6 +436,24 @@ namespace MFA
         mDepthPrePass->OnResize();
         mOcclusionRenderPass->OnResize();
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void PBRWithShadowPipelineV2::onRenderQualityChanged()
+    {
+        mDepthPrePass->OnRenderQualityChanged();
+        mOcclusionRenderPass->OnRenderQualityChanged();
+
+        auto const descriptorSetLayouts = std::vector<VkDescriptorSetLayout>{
+            mGfxPerFrameDescriptorSetLayout->descriptorSetLayout,
+            mGfxPerEssenceDescriptorSetLayout->descriptorSetLayout,
+        };
+
+        // Shadow passes do not depend on the render quality
+        createDisplayPassPipeline(descriptorSetLayouts);
+        createDepthPassPipeline(descriptorSetLayouts);
+        createOcclusionQueryPipeline(descriptorSetLayouts);
+    }
     
     //-------------------------------------------------------------------------------------------------
 
@@ -1206,9 +1263,10 @@ namespace MFA
         );
 
         RT::CreateGraphicPipelineOptions options{};
-        options.rasterizationSamples = RF::GetMaxSamplesCount();
+        options.rasterizationSamples = RF::GetRenderQuality().displaySampleCount;
         options.cullMode = VK_CULL_MODE_BACK_BIT;
-        options.depthStencil.depthWriteEnable = VK_FALSE;
+        // Depth is already written by depth pre-pass unless it uses a separate image with a different sample count
+        options.depthStencil.depthWriteEnable = mDepthPrePass->IsSharingDisplayDepth() ? VK_FALSE : VK_TRUE;
         options.depthStencil.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;          // It must be less or equal because transparent and transluent objects are discarded in depth prepass and occlusion pass
 
         mDisplayPassPipeline = RF::CreateGraphicPipeline(
@@ -1399,7 +1457,7 @@ namespace MFA
 
         RT::CreateGraphicPipelineOptions graphicPipelineOptions{};
         graphicPipelineOptions.cullMode = VK_CULL_MODE_BACK_BIT;
-        graphicPipelineOptions.rasterizationSamples = RF::GetMaxSamplesCount();
+        graphicPipelineOptions.rasterizationSamples = mDepthPrePass->GetSampleCount();
         graphicPipelineOptions.depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
 
         graphicPipelineOptions.colorBlendAttachments.blendEnable = VK_FALSE;
@@ -1569,7 +1627,7 @@ namespace MFA
 
         RT::CreateGraphicPipelineOptions graphicPipelineOptions{};
         graphicPipelineOptions.cullMode = VK_CULL_MODE_NONE;
-        graphicPipelineOptions.rasterizationSamples = RF::GetMaxSamplesCount();
+        graphicPipelineOptions.rasterizationSamples = mDepthPrePass->GetSampleCount();
         graphicPipelineOptions.depthStencil.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
         graphicPipelineOptions.depthStencil.depthWriteEnable = VK_FALSE;
         graphicPipelineOptions.primitiveTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
@@ -108,6 +108,8 @@ namespace MFA
 
         void onResize() override;
 
+        void onRenderQualityChanged() override;
+
         std::shared_ptr<EssenceBase> CreateEssence(
             std::string const & nameId,
             std::shared_ptr<AssetSystem::Model> const & cpuModel,
@@ -124,6 +126,10 @@ namespace MFA
 
         void updateVariantsBuffers(RT::CommandRecordState const & recordState) const;
 
+        // Requests texture mips from the screen size of the visible variants and refreshes the descriptor sets
+        // of textures that were streamed since this frame index was recorded
+        void updateTextureStreaming(RT::CommandRecordState const & recordState);
+
         void performSkinning(RT::CommandRecordState & recordState);
 
         void preComputeBarrier(RT::CommandRecordState const & recordState) const;
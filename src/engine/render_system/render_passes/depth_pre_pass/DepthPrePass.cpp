@@ -24,6 +24,10 @@ void MFA::DepthPrePass::internalInit()
         .height = surfaceCapabilities.currentExtent.height
     };
 
+    mSampleCount = RF::GetRenderQuality().depthPrePassSampleCount;
+
+    createDepthImages(swapChainExtent);
+
     createRenderPass();
 
     createFrameBuffers(swapChainExtent);
@@ -33,12 +37,11 @@ void MFA::DepthPrePass::internalInit()
 
 void MFA::DepthPrePass::internalShutdown()
 {
-    RF::DestroyFrameBuffers(
-        static_cast<uint32_t>(mFrameBuffers.size()),
-        mFrameBuffers.data()
-    );
+    destroyFrameBuffers();
 
     RF::DestroyRenderPass(mRenderPass);
+
+    mDepthImageGroupList.clear();
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -47,13 +50,9 @@ void MFA::DepthPrePass::BeginRenderPass(RT::CommandRecordState & recordState)
 {
     RenderPass::BeginRenderPass(recordState);
     
-    auto surfaceCapabilities = RF::GetSurfaceCapabilities();
-    auto const swapChainExtend = VkExtent2D{
-        .width = surfaceCapabilities.currentExtent.width,
-        .height = surfaceCapabilities.currentExtent.height
-    };
+    auto const renderExtent = RF::GetRenderExtent();
 
-    RF::AssignViewportAndScissorToCommandBuffer(recordState.commandBuffer, swapChainExtend);
+    RF::AssignViewportAndScissorToCommandBuffer(recordState.commandBuffer, renderExtent);
 
     std::vector<VkClearValue> clearValues{};
     clearValues.resize(1);
@@ -63,7 +62,7 @@ void MFA::DepthPrePass::BeginRenderPass(RT::CommandRecordState & recordState)
         recordState.commandBuffer,
         mRenderPass,
         getFrameBuffer(recordState),
-        swapChainExtend,
+        renderExtent,
         static_cast<uint32_t>(clearValues.size()),
         clearValues.data()
     );
@@ -88,22 +87,67 @@ void MFA::DepthPrePass::OnResize()
         .height = surfaceCapabilities.currentExtent.height
     };
 
+    createDepthImages(swapChainExtend);
+
     // Depth frame-buffer
-    RF::DestroyFrameBuffers(
-        static_cast<uint32_t>(mFrameBuffers.size()),
-        mFrameBuffers.data()
-    );
+    destroyFrameBuffers();
+    createFrameBuffers(swapChainExtend);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::DepthPrePass::OnRenderQualityChanged()
+{
+    auto surfaceCapabilities = RF::GetSurfaceCapabilities();
+    auto const swapChainExtend = VkExtent2D{
+        .width = surfaceCapabilities.currentExtent.width,
+        .height = surfaceCapabilities.currentExtent.height
+    };
+
+    // Display depth images might be recreated as well, So frame-buffers are always rebuilt
+    mSampleCount = RF::GetRenderQuality().depthPrePassSampleCount;
+
+    destroyFrameBuffers();
+    RF::DestroyRenderPass(mRenderPass);
+
+    createDepthImages(swapChainExtend);
+    createRenderPass();
     createFrameBuffers(swapChainExtend);
 }
 
 //-------------------------------------------------------------------------------------------------
 
+std::vector<std::shared_ptr<MFA::RT::DepthImageGroup>> const & MFA::DepthPrePass::GetDepthImages() const
+{
+    if (IsSharingDisplayDepth())
+    {
+        return mDisplayRenderPass->GetDepthImages();
+    }
+    return mDepthImageGroupList;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+VkSampleCountFlagBits MFA::DepthPrePass::GetSampleCount() const
+{
+    return mSampleCount;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool MFA::DepthPrePass::IsSharingDisplayDepth() const
+{
+    return mSampleCount == RF::GetRenderQuality().displaySampleCount;
+}
+
+//-------------------------------------------------------------------------------------------------
+
 void MFA::DepthPrePass::createRenderPass()
 {
 
     VkAttachmentDescription const depthAttachment{
-        .format = mDisplayRenderPass->GetDepthImages()[0]->imageFormat,
-        .samples = RF::GetMaxSamplesCount(),
+        .format = GetDepthImages()[0]->imageFormat,
+        .samples = mSampleCount,
         .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
         .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
         .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
@@ -171,7 +215,7 @@ void MFA::DepthPrePass::createFrameBuffers(VkExtent2D const & extent)
     mFrameBuffers.resize(RF::GetSwapChainImagesCount());
     for (int i = 0; i < static_cast<int>(mFrameBuffers.size()); ++i)
     {
-        std::vector<VkImageView> const attachments = {mDisplayRenderPass->GetDepthImages()[i]->imageView->imageView};
+        std::vector<VkImageView> const attachments = {GetDepthImages()[i]->imageView->imageView};
         mFrameBuffers[i] = RF::CreateFrameBuffer(
             mRenderPass,
             attachments.data(),
@@ -184,6 +228,40 @@ void MFA::DepthPrePass::createFrameBuffers(VkExtent2D const & extent)
 
 //-------------------------------------------------------------------------------------------------
 
+void MFA::DepthPrePass::destroyFrameBuffers()
+{
+    RF::DestroyFrameBuffers(
+        static_cast<uint32_t>(mFrameBuffers.size()),
+        mFrameBuffers.data()
+    );
+    mFrameBuffers.clear();
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::DepthPrePass::createDepthImages(VkExtent2D const & extent)
+{
+    mDepthImageGroupList.clear();
+    if (IsSharingDisplayDepth())
+    {
+        return;
+    }
+
+    // Same size as the display images, Render scale only shrinks the part that is drawn
+    mDepthImageGroupList.resize(RF::GetSwapChainImagesCount());
+    for (auto & depthImage : mDepthImageGroupList)
+    {
+        depthImage = RF::CreateDepthImage(
+            extent,
+            RT::CreateDepthImageOptions{
+                .samplesCount = mSampleCount
+            }
+        );
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+
 VkFramebuffer MFA::DepthPrePass::getFrameBuffer(RT::CommandRecordState const & drawPass) const
 {
     return mFrameBuffers[drawPass.imageIndex];
@@ -6,6 +6,8 @@ namespace MFA
 {
     class DisplayRenderPass;
 
+    // Uses the display pass depth image when both passes have the same sample count, So the display pass can skip hidden fragments.
+    // Otherwise it renders into its own depth image that only the occlusion pass reads.
     class DepthPrePass final : public RenderPass
     {
     public:
@@ -26,6 +28,17 @@ namespace MFA
 
         void OnResize() override;
 
+        void OnRenderQualityChanged();
+
+        [[nodiscard]]
+        std::vector<std::shared_ptr<RT::DepthImageGroup>> const & GetDepthImages() const;
+
+        [[nodiscard]]
+        VkSampleCountFlagBits GetSampleCount() const;
+
+        [[nodiscard]]
+        bool IsSharingDisplayDepth() const;
+
     protected:
 
         void internalInit() override;
@@ -35,14 +48,21 @@ namespace MFA
     private:
 
         void createRenderPass();
+
+        void createDepthImages(VkExtent2D const & extent);
         
         void createFrameBuffers(VkExtent2D const & extent);
 
+        void destroyFrameBuffers();
+
         [[nodiscard]]
         VkFramebuffer getFrameBuffer(RT::CommandRecordState const & drawPass) const;
 
         VkRenderPass mRenderPass {};
         std::vector<VkFramebuffer> mFrameBuffers {};
+        std::vector<std::shared_ptr<RT::DepthImageGroup>> mDepthImageGroupList {};     // Empty when sharing the display depth
+
+        VkSampleCountFlagBits mSampleCount = VK_SAMPLE_COUNT_1_BIT;
 
         DisplayRenderPass * mDisplayRenderPass = nullptr;
 
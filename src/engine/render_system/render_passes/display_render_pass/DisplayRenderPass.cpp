@@ -24,6 +24,13 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    VkRenderPass DisplayRenderPass::GetPresentVkRenderPass() const
+    {
+        return mVkPresentRenderPass;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void DisplayRenderPass::internalInit()
     {
 
@@ -37,24 +44,18 @@ namespace MFA
 
         mSwapChainImages = RF::CreateSwapChain();
 
-        mMSAAImageGroupList.resize(mSwapChainImagesCount);
-        for (uint32_t i = 0; i < mSwapChainImagesCount; ++i)
-        {
-            mMSAAImageGroupList[i] = RF::CreateColorImage(
-                swapChainExtent,
-                mSwapChainImages->swapChainFormat,
-                RT::CreateColorImageOptions{
-                    .samplesCount = RF::GetMaxSamplesCount()
-                }
-            );
-        }
+        mSampleCount = RF::GetRenderQuality().displaySampleCount;
 
-        createDepthImages(swapChainExtent);
+        createRenderTargets(swapChainExtent);
 
         createDisplayRenderPass();
 
+        createPresentRenderPass();
+
         createDisplayFrameBuffers(swapChainExtent);
 
+        createPresentFrameBuffers(swapChainExtent);
+
         createPresentToDrawBarrier();
 
     }
@@ -65,14 +66,13 @@ namespace MFA
     {
         mSwapChainImages.reset();
         mMSAAImageGroupList.clear();
+        mSceneImageGroupList.clear();
         mDepthImageGroupList.clear();
 
-        RF::DestroyFrameBuffers(
-            static_cast<uint32_t>(mDisplayFrameBuffers.size()),
-            mDisplayFrameBuffers.data()
-        );
+        destroyFrameBuffers();
 
         RF::DestroyRenderPass(mVkDisplayRenderPass);
+        RF::DestroyRenderPass(mVkPresentRenderPass);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -83,7 +83,44 @@ namespace MFA
 
         RenderPass::BeginRenderPass(recordState);
 
-        usePresentToDrawBarrier(recordState);
+        auto const renderExtent = RF::GetRenderExtent();
+
+        RF::AssignViewportAndScissorToCommandBuffer(recordState.commandBuffer, renderExtent);
+
+        // Color attachments come first and depth is the last one
+        std::vector<VkClearValue> clearValues{};
+        clearValues.resize(isMultiSampled() ? 3 : 2);
+        for (size_t i = 0; i + 1 < clearValues.size(); ++i)
+        {
+            clearValues[i].color = VkClearColorValue{ .float32 = {0.1f, 0.1f, 0.1f, 1.0f } };
+        }
+        clearValues.back().depthStencil = { .depth = 1.0f, .stencil = 0 };
+
+        RF::BeginRenderPass(
+            recordState.commandBuffer,
+            mVkDisplayRenderPass,
+            getDisplayFrameBuffer(recordState),
+            renderExtent,
+            static_cast<uint32_t>(clearValues.size()),
+            clearValues.data()
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void DisplayRenderPass::EndRenderPass(RT::CommandRecordState & recordState)
+    {
+        RenderPass::EndRenderPass(recordState);
+        RF::EndRenderPass(recordState.commandBuffer);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void DisplayRenderPass::BeginPresentPass(RT::CommandRecordState & recordState)
+    {
+        upscaleToSwapChain(recordState);
+
+        RenderPass::BeginRenderPass(recordState);
 
         auto surfaceCapabilities = RF::GetSurfaceCapabilities();
         auto const swapChainExtend = VkExtent2D{
@@ -93,25 +130,19 @@ namespace MFA
 
         RF::AssignViewportAndScissorToCommandBuffer(recordState.commandBuffer, swapChainExtend);
 
-        std::vector<VkClearValue> clearValues{};
-        clearValues.resize(3);
-        clearValues[0].color = VkClearColorValue{ .float32 = {0.1f, 0.1f, 0.1f, 1.0f } };
-        clearValues[1].color = VkClearColorValue{ .float32 = {0.1f, 0.1f, 0.1f, 1.0f } };
-        clearValues[2].depthStencil = { .depth = 1.0f, .stencil = 0 };
-
         RF::BeginRenderPass(
             recordState.commandBuffer,
-            mVkDisplayRenderPass,
-            getDisplayFrameBuffer(recordState),
+            mVkPresentRenderPass,
+            mPresentFrameBuffers[recordState.imageIndex],
             swapChainExtend,
-            static_cast<uint32_t>(clearValues.size()),
-            clearValues.data()
+            0,
+            nullptr
         );
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    void DisplayRenderPass::EndRenderPass(RT::CommandRecordState & recordState)
+    void DisplayRenderPass::EndPresentPass(RT::CommandRecordState & recordState)
     {
         RenderPass::EndRenderPass(recordState);
 
@@ -168,32 +199,46 @@ namespace MFA
             .height = surfaceCapabilities.currentExtent.height
         };
 
-        // Depth image
-        createDepthImages(swapChainExtend);
-
-        // MSAA image
-        for (uint32_t i = 0; i < mSwapChainImagesCount; ++i)
-        {
-            mMSAAImageGroupList[i] = RF::CreateColorImage(
-                swapChainExtend,
-                mSwapChainImages->swapChainFormat,
-                RT::CreateColorImageOptions{
-                    .samplesCount = RF::GetMaxSamplesCount()
-                }
-            );
-        }
+        // Depth, MSAA and scene images
+        createRenderTargets(swapChainExtend);
 
         // Swap-chain
         auto const oldSwapChainImages = mSwapChainImages;
         mSwapChainImages = RF::CreateSwapChain(oldSwapChainImages->swapChain);
 
-        // Display frame-buffer
-        RF::DestroyFrameBuffers(
-            static_cast<uint32_t>(mDisplayFrameBuffers.size()),
-            mDisplayFrameBuffers.data()
-        );
+        // Display and present frame-buffers
+        destroyFrameBuffers();
+        createDisplayFrameBuffers(swapChainExtend);
+        createPresentFrameBuffers(swapChainExtend);
+
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void DisplayRenderPass::OnRenderQualityChanged()
+    {
+        auto const sampleCount = RF::GetRenderQuality().displaySampleCount;
+        if (sampleCount == mSampleCount)
+        {
+            return;
+        }
+        mSampleCount = sampleCount;
+
+        auto surfaceCapabilities = RF::GetSurfaceCapabilities();
+        auto const swapChainExtend = VkExtent2D{
+            .width = surfaceCapabilities.currentExtent.width,
+            .height = surfaceCapabilities.currentExtent.height
+        };
+
+        destroyFrameBuffers();
+        RF::DestroyRenderPass(mVkDisplayRenderPass);
+
+        createRenderTargets(swapChainExtend);
+        createDisplayRenderPass();
         createDisplayFrameBuffers(swapChainExtend);
+        createPresentFrameBuffers(swapChainExtend);
 
+        mIsDepthImageUndefined = true;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -270,11 +315,14 @@ namespace MFA
         mDisplayFrameBuffers.resize(mSwapChainImagesCount);
         for (int i = 0; i < static_cast<int>(mDisplayFrameBuffers.size()); ++i)
         {
-            std::vector<VkImageView> const attachments{
-                mMSAAImageGroupList[i]->imageView->imageView,
-                mSwapChainImages->swapChainImageViews[i]->imageView,
-                mDepthImageGroupList[i]->imageView->imageView
-            };
+            std::vector<VkImageView> attachments{};
+            if (isMultiSampled())
+            {
+                attachments.emplace_back(mMSAAImageGroupList[i]->imageView->imageView);
+            }
+            attachments.emplace_back(mSceneImageGroupList[i]->imageView->imageView);
+            attachments.emplace_back(mDepthImageGroupList[i]->imageView->imageView);
+
             mDisplayFrameBuffers[i] = RF::CreateFrameBuffer(
                 mVkDisplayRenderPass,
                 attachments.data(),
@@ -287,35 +335,111 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
+    void DisplayRenderPass::createPresentFrameBuffers(VkExtent2D const & extent)
+    {
+        mPresentFrameBuffers.clear();
+        mPresentFrameBuffers.resize(mSwapChainImagesCount);
+        for (int i = 0; i < static_cast<int>(mPresentFrameBuffers.size()); ++i)
+        {
+            std::vector<VkImageView> const attachments{
+                mSwapChainImages->swapChainImageViews[i]->imageView
+            };
+            mPresentFrameBuffers[i] = RF::CreateFrameBuffer(
+                mVkPresentRenderPass,
+                attachments.data(),
+                static_cast<uint32_t>(attachments.size()),
+                extent,
+                1
+            );
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void DisplayRenderPass::destroyFrameBuffers()
+    {
+        RF::DestroyFrameBuffers(
+            static_cast<uint32_t>(mDisplayFrameBuffers.size()),
+            mDisplayFrameBuffers.data()
+        );
+        mDisplayFrameBuffers.clear();
+
+        RF::DestroyFrameBuffers(
+            static_cast<uint32_t>(mPresentFrameBuffers.size()),
+            mPresentFrameBuffers.data()
+        );
+        mPresentFrameBuffers.clear();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void DisplayRenderPass::createRenderTargets(VkExtent2D const & extent)
+    {
+        // Images are allocated for the full extent, Render scale only shrinks the part that is drawn
+        mMSAAImageGroupList.clear();
+        if (isMultiSampled())
+        {
+            mMSAAImageGroupList.resize(mSwapChainImagesCount);
+            for (auto & msaaImage : mMSAAImageGroupList)
+            {
+                msaaImage = RF::CreateColorImage(
+                    extent,
+                    mSwapChainImages->swapChainFormat,
+                    RT::CreateColorImageOptions{
+                        .samplesCount = mSampleCount
+                    }
+                );
+            }
+        }
+
+        mSceneImageGroupList.resize(mSwapChainImagesCount);
+        for (auto & sceneImage : mSceneImageGroupList)
+        {
+            sceneImage = RF::CreateColorImage(
+                extent,
+                mSwapChainImages->swapChainFormat,
+                RT::CreateColorImageOptions{
+                    .usageFlags = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                    .samplesCount = VK_SAMPLE_COUNT_1_BIT
+                }
+            );
+        }
+
+        createDepthImages(extent);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void DisplayRenderPass::createDisplayRenderPass()
     {
 
-        // Multi-sampled attachment that we render to
+        // Multi-sampled attachment that we render to, Only the resolved image is kept
         VkAttachmentDescription const msaaAttachment{
             .format = mSwapChainImages->swapChainFormat,
-            .samples = RF::GetMaxSamplesCount(),
+            .samples = mSampleCount,
             .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
-            .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+            .storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
             .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
             .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
             .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
             .finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
         };
 
-        VkAttachmentDescription const swapChainAttachment{
+        // Resolve target when multi-sampled, Otherwise we render to it directly. It is the source of the upscale.
+        VkAttachmentDescription const sceneAttachment{
             .format = mSwapChainImages->swapChainFormat,
             .samples = VK_SAMPLE_COUNT_1_BIT,
-            .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+            .loadOp = isMultiSampled() ? VK_ATTACHMENT_LOAD_OP_DONT_CARE : VK_ATTACHMENT_LOAD_OP_CLEAR,
             .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
             .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
             .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
-            .initialLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-            .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            .finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
         };
 
         VkAttachmentDescription const depthAttachment{
             .format = RF::GetDepthFormat(),
-            .samples = RF::GetMaxSamplesCount(),
+            .samples = mSampleCount,
             .loadOp = VK_ATTACHMENT_LOAD_OP_LOAD,
             .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
             .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
@@ -324,20 +448,28 @@ namespace MFA
             .finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
         };
 
+        std::vector<VkAttachmentDescription> attachments {};
+        if (isMultiSampled())
+        {
+            attachments.emplace_back(msaaAttachment);
+        }
+        attachments.emplace_back(sceneAttachment);
+        attachments.emplace_back(depthAttachment);
+
         // Note: hardware will automatically transition attachment to the specified layout
         // Note: index refers to attachment descriptions array
-        VkAttachmentReference msaaAttachmentReference{
+        VkAttachmentReference colorAttachmentReference{
             .attachment = 0,
             .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
         };
 
-        VkAttachmentReference swapChainAttachmentReference{
+        VkAttachmentReference resolveAttachmentReference{
             .attachment = 1,
             .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
         };
 
         VkAttachmentReference depthAttachmentRef{
-            .attachment = 2,
+            .attachment = static_cast<uint32_t>(attachments.size() - 1),
             .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
         };
 
@@ -347,15 +479,75 @@ namespace MFA
             VkSubpassDescription {
                 .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
                 .colorAttachmentCount = 1,
-                .pColorAttachments = &msaaAttachmentReference,
-                .pResolveAttachments = &swapChainAttachmentReference,
+                .pColorAttachments = &colorAttachmentReference,
+                .pResolveAttachments = isMultiSampled() ? &resolveAttachmentReference : nullptr,
                 .pDepthStencilAttachment = &depthAttachmentRef,
             }
         };
 
-        std::vector<VkAttachmentDescription> attachments = { msaaAttachment, swapChainAttachment, depthAttachment };
+        std::vector<VkSubpassDependency> dependencies{
+            // Depth comes from the pre-pass and the scene image was read by the upscale of an earlier frame
+            VkSubpassDependency {
+                .srcSubpass = VK_SUBPASS_EXTERNAL,
+                .dstSubpass = 0,
+                .srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                .dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            },
+            // Scene image is blitted into the swap-chain after this pass
+            VkSubpassDependency {
+                .srcSubpass = 0,
+                .dstSubpass = VK_SUBPASS_EXTERNAL,
+                .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+                .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+            }
+        };
 
         mVkDisplayRenderPass = RF::CreateRenderPass(
+            attachments.data(),
+            static_cast<uint32_t>(attachments.size()),
+            subPassDescription.data(),
+            static_cast<uint32_t>(subPassDescription.size()),
+            dependencies.data(),
+            static_cast<uint32_t>(dependencies.size())
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void DisplayRenderPass::createPresentRenderPass()
+    {
+        // Keeps the upscaled scene, Ui is drawn on top of it
+        VkAttachmentDescription const swapChainAttachment{
+            .format = mSwapChainImages->swapChainFormat,
+            .samples = VK_SAMPLE_COUNT_1_BIT,
+            .loadOp = VK_ATTACHMENT_LOAD_OP_LOAD,
+            .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+            .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+            .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+        };
+
+        VkAttachmentReference swapChainAttachmentReference{
+            .attachment = 0,
+            .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        };
+
+        std::vector<VkSubpassDescription> subPassDescription{
+            VkSubpassDescription {
+                .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+                .colorAttachmentCount = 1,
+                .pColorAttachments = &swapChainAttachmentReference,
+            }
+        };
+
+        std::vector<VkAttachmentDescription> attachments = { swapChainAttachment };
+
+        mVkPresentRenderPass = RF::CreateRenderPass(
             attachments.data(),
             static_cast<uint32_t>(attachments.size()),
             subPassDescription.data(),
@@ -376,7 +568,7 @@ namespace MFA
                 extent2D,
                 RT::CreateDepthImageOptions{
                     .usageFlags = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
-                    .samplesCount = RF::GetMaxSamplesCount()
+                    .samplesCount = mSampleCount
                 }
             );
         }
@@ -388,12 +580,13 @@ namespace MFA
     {
         // If present queue family and graphics queue family are different, then a barrier is necessary
         // The barrier is also needed initially to transition the image to the present layout
+        // Swap-chain image is fully overwritten by the upscale, So its previous content is discarded
         VkImageMemoryBarrier presentToDrawBarrier = {};
         presentToDrawBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
         presentToDrawBarrier.srcAccessMask = 0;
-        presentToDrawBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        presentToDrawBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
         presentToDrawBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        presentToDrawBarrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        presentToDrawBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
 
         auto const presentQueueFamily = RF::GetPresentQueueFamily();
         auto const graphicQueueFamily = RF::GetGraphicQueueFamily();
@@ -504,21 +697,77 @@ namespace MFA
 
     //-------------------------------------------------------------------------------------------------
 
-    void DisplayRenderPass::usePresentToDrawBarrier(RT::CommandRecordState const & recordState)
+    void DisplayRenderPass::upscaleToSwapChain(RT::CommandRecordState const & recordState)
     {
-        mPresentToDrawBarrier.image = mSwapChainImages->swapChainImages[recordState.imageIndex];
+        auto const swapChainImage = mSwapChainImages->swapChainImages[recordState.imageIndex];
+        auto const sceneImage = mSceneImageGroupList[recordState.imageIndex]->imageGroup->image;
 
-        std::vector<VkImageMemoryBarrier> const barriers {mPresentToDrawBarrier};
+        mPresentToDrawBarrier.image = swapChainImage;
 
+        // Source stage matches the wait stage of the present semaphore, So the blit waits for the image to be acquired
         RF::PipelineBarrier(
             recordState,
             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            1,
+            &mPresentToDrawBarrier
+        );
+
+        auto const renderExtent = RF::GetRenderExtent();
+        auto const surfaceCapabilities = RF::GetSurfaceCapabilities();
+
+        VkImageBlit blit {};
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.layerCount = 1;
+        blit.srcOffsets[1] = VkOffset3D {
+            static_cast<int32_t>(renderExtent.width),
+            static_cast<int32_t>(renderExtent.height),
+            1
+        };
+        blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.dstSubresource.layerCount = 1;
+        blit.dstOffsets[1] = VkOffset3D {
+            static_cast<int32_t>(surfaceCapabilities.currentExtent.width),
+            static_cast<int32_t>(surfaceCapabilities.currentExtent.height),
+            1
+        };
+
+        RB::BlitImage(
+            recordState.commandBuffer,
+            sceneImage,
+            swapChainImage,
+            blit,
+            VK_FILTER_LINEAR
+        );
+
+        VkImageMemoryBarrier const blitToDrawBarrier {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            .newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = swapChainImage,
+            .subresourceRange = mPresentToDrawBarrier.subresourceRange
+        };
+
+        RF::PipelineBarrier(
+            recordState,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-            static_cast<uint32_t>(barriers.size()),
-            barriers.data()
+            1,
+            &blitToDrawBarrier
         );
     }
 
     //-------------------------------------------------------------------------------------------------
 
+    bool DisplayRenderPass::isMultiSampled() const
+    {
+        return mSampleCount != VK_SAMPLE_COUNT_1_BIT;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
 }
@@ -6,6 +6,8 @@
 namespace MFA
 {
 
+    // Scene is drawn into off-screen images with the display sample count, Only the render extent part of them is used.
+    // Present pass upscales the resolved scene into the swap-chain image and then ui is drawn on top of it at full resolution.
     class DisplayRenderPass final : public RenderPass
     {
     public:
@@ -21,6 +23,10 @@ namespace MFA
         [[nodiscard]]
         VkRenderPass GetVkRenderPass() override;
 
+        // Single sampled pass that draws into the swap-chain image
+        [[nodiscard]]
+        VkRenderPass GetPresentVkRenderPass() const;
+
         [[nodiscard]]
         VkImage GetSwapChainImage(RT::CommandRecordState const & drawPass) const;
 
@@ -34,8 +40,15 @@ namespace MFA
 
         void EndRenderPass(RT::CommandRecordState & recordState);
 
+        // Upscales the scene into the swap-chain image and begins the present pass
+        void BeginPresentPass(RT::CommandRecordState & recordState);
+
+        void EndPresentPass(RT::CommandRecordState & recordState);
+
         void OnResize() override;
 
+        void OnRenderQualityChanged();
+
         void notifyDepthImageLayoutIsSet();
 
     protected:
@@ -49,23 +62,38 @@ namespace MFA
         [[nodiscard]]
         VkFramebuffer getDisplayFrameBuffer(RT::CommandRecordState const & drawPass) const;
 
+        void createRenderTargets(VkExtent2D const & extent);
+
         void createDisplayFrameBuffers(VkExtent2D const & extent);
 
+        void createPresentFrameBuffers(VkExtent2D const & extent);
+
+        void destroyFrameBuffers();
+
         void createDisplayRenderPass();
 
+        void createPresentRenderPass();
+
         void createDepthImages(VkExtent2D const & extent2D);
 
         void createPresentToDrawBarrier();
 
         void clearDepthBufferIfNeeded(RT::CommandRecordState const & recordState);
-        
-        void usePresentToDrawBarrier(RT::CommandRecordState const & recordState);
+
+        void upscaleToSwapChain(RT::CommandRecordState const & recordState);
+
+        [[nodiscard]]
+        bool isMultiSampled() const;
 
         VkRenderPass mVkDisplayRenderPass{};            // TODO Make this a renderType
+        VkRenderPass mVkPresentRenderPass{};
         uint32_t mSwapChainImagesCount = 0;
+        VkSampleCountFlagBits mSampleCount = VK_SAMPLE_COUNT_1_BIT;
         std::shared_ptr<RT::SwapChainGroup> mSwapChainImages{};
         std::vector<VkFramebuffer> mDisplayFrameBuffers{};
-        std::vector<std::shared_ptr<RT::ColorImageGroup>> mMSAAImageGroupList{};
+        std::vector<VkFramebuffer> mPresentFrameBuffers{};
+        std::vector<std::shared_ptr<RT::ColorImageGroup>> mMSAAImageGroupList{};      // Empty when the display pass is single sampled
+        std::vector<std::shared_ptr<RT::ColorImageGroup>> mSceneImageGroupList{};     // Resolved scene, Source of the upscale
         std::vector<std::shared_ptr<RT::DepthImageGroup>> mDepthImageGroupList{};
 
         VkImageMemoryBarrier mPresentToDrawBarrier {};
@@ -1,12 +1,18 @@
 #include "OcclusionRenderPass.hpp"
 
+#include "engine/BedrockAssert.hpp"
 #include "engine/render_system/RenderFrontend.hpp"
 #include "engine/render_system/render_passes/display_render_pass/DisplayRenderPass.hpp"
+#include "engine/render_system/render_passes/depth_pre_pass/DepthPrePass.hpp"
 #include "engine/render_system/RenderBackend.hpp"
 
 //-------------------------------------------------------------------------------------------------
 
-MFA::OcclusionRenderPass::OcclusionRenderPass() = default;
+MFA::OcclusionRenderPass::OcclusionRenderPass(DepthPrePass const * depthPrePass)
+    : mDepthPrePass(depthPrePass)
+{
+    MFA_ASSERT(mDepthPrePass != nullptr);
+}
 
 //-------------------------------------------------------------------------------------------------
 
@@ -37,10 +43,7 @@ void MFA::OcclusionRenderPass::internalInit()
 
 void MFA::OcclusionRenderPass::internalShutdown()
 {
-    RF::DestroyFrameBuffers(
-        static_cast<uint32_t>(mFrameBuffers.size()),
-        mFrameBuffers.data()
-    );
+    destroyFrameBuffers();
 
     RF::DestroyRenderPass(mRenderPass);
 }
@@ -49,10 +52,8 @@ void MFA::OcclusionRenderPass::internalShutdown()
 
 void MFA::OcclusionRenderPass::BeginRenderPass(RT::CommandRecordState & recordState)
 {
-    auto const extent = VkExtent2D {
-        .width = mImageWidth,
-        .height = mImageHeight
-    };
+    // Same part of the image that depth pre-pass rendered into
+    auto const extent = RF::GetRenderExtent();
 
     //copyDisplayPassDepthBuffer(recordState, extent);
 
@@ -98,11 +99,35 @@ void MFA::OcclusionRenderPass::OnResize()
     //createDepthImage(extent);
 
     // Depth frame-buffer
+    destroyFrameBuffers();
+    createFrameBuffers(extent);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::OcclusionRenderPass::OnRenderQualityChanged()
+{
+    auto const extent = VkExtent2D {
+        .width = mImageWidth,
+        .height = mImageHeight
+    };
+
+    destroyFrameBuffers();
+    RF::DestroyRenderPass(mRenderPass);
+
+    createRenderPass();
+    createFrameBuffers(extent);
+}
+
+//-------------------------------------------------------------------------------------------------
+
+void MFA::OcclusionRenderPass::destroyFrameBuffers()
+{
     RF::DestroyFrameBuffers(
         static_cast<uint32_t>(mFrameBuffers.size()),
         mFrameBuffers.data()
     );
-    createFrameBuffers(extent);
+    mFrameBuffers.clear();
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -111,8 +136,8 @@ void MFA::OcclusionRenderPass::createRenderPass()
 {
 
     VkAttachmentDescription const depthAttachment{
-        .format = RF::GetDisplayRenderPass()->GetDepthImages()[0]->imageFormat,//mDepthImageGroupList[0]->imageFormat,
-        .samples = RF::GetMaxSamplesCount(),
+        .format = mDepthPrePass->GetDepthImages()[0]->imageFormat,
+        .samples = mDepthPrePass->GetSampleCount(),
         .loadOp = VK_ATTACHMENT_LOAD_OP_LOAD,
         .storeOp = VK_ATTACHMENT_STORE_OP_STORE, //VK_ATTACHMENT_STORE_OP_DONT_CARE
         .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
@@ -159,7 +184,7 @@ void MFA::OcclusionRenderPass::createFrameBuffers(VkExtent2D const & extent)
     {
         std::vector<VkImageView> const attachments {
             //mDepthImageGroupList[i]->imageView->imageView
-            RF::GetDisplayRenderPass()->GetDepthImages()[i]->imageView->imageView
+            mDepthPrePass->GetDepthImages()[i]->imageView->imageView
         };
         mFrameBuffers[i] = RF::CreateFrameBuffer(
             mRenderPass,
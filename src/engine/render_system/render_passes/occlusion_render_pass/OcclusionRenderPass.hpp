@@ -4,12 +4,14 @@
 
 namespace MFA
 {
+    class DepthPrePass;
 
+    // Tests occluders against the depth pre-pass image, So it uses the depth pre-pass sample count
     class OcclusionRenderPass final : public RenderPass
     {
     public:
 
-        explicit OcclusionRenderPass();
+        explicit OcclusionRenderPass(DepthPrePass const * depthPrePass);
 
         VkRenderPass GetVkRenderPass() override;
 
@@ -19,6 +21,8 @@ namespace MFA
 
         void OnResize() override;
 
+        void OnRenderQualityChanged();
+
     protected:
 
         void internalInit() override;
@@ -31,6 +35,8 @@ namespace MFA
         
         void createFrameBuffers(VkExtent2D const & extent);
 
+        void destroyFrameBuffers();
+
         [[nodiscard]]
         VkFramebuffer getFrameBuffer(RT::CommandRecordState const & drawPass) const;
 
@@ -39,6 +45,8 @@ namespace MFA
 
         VkRenderPass mRenderPass {};
         std::vector<VkFramebuffer> mFrameBuffers {};
+
+        DepthPrePass const * mDepthPrePass = nullptr;
     };
 
 }
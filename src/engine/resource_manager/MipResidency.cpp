@@ -0,0 +1,312 @@
+#include "MipResidency.hpp"
+
+#include "engine/BedrockAssert.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MFA::ResourceManager
+{
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint8_t ComputeDesiredMip(uint32_t const largestDimension, float const screenPixels, uint8_t const mipCount)
+    {
+        MFA_ASSERT(mipCount > 0);
+        auto const lastMip = static_cast<uint8_t>(mipCount - 1);
+        if (screenPixels <= 0.0f)
+        {
+            return lastMip;
+        }
+        // Each mip halves the texels that cover the same pixels
+        auto const ratio = static_cast<float>(largestDimension) / screenPixels;
+        if (ratio <= 1.0f)
+        {
+            return 0;
+        }
+        auto const mip = static_cast<uint32_t>(std::floor(std::log2(ratio)));
+        return static_cast<uint8_t>(std::min<uint32_t>(mip, lastMip));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    MipResidency::MipResidency(size_t const budgetBytes, uint32_t const maxPendingCount)
+        : mBudgetBytes(budgetBytes)
+        , mMaxPendingCount(maxPendingCount)
+    {
+        MFA_ASSERT(mMaxPendingCount > 0);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    MipResidency::Handle MipResidency::Add(std::vector<size_t> mipSizes, uint8_t const tailMip)
+    {
+        MFA_ASSERT(tailMip < mipSizes.size());
+
+        Texture texture {};
+        texture.bytesFrom.resize(tailMip + 1);
+        texture.bytesFrom[tailMip] = 0;
+        for (int mip = static_cast<int>(tailMip) - 1; mip >= 0; --mip)
+        {
+            texture.bytesFrom[mip] = texture.bytesFrom[mip + 1] + mipSizes[mip];
+        }
+        texture.tailMip = tailMip;
+        texture.residentMip = tailMip;
+        texture.targetMip = tailMip;
+        texture.desiredMip = tailMip;
+
+        auto const handle = mNextHandle++;
+        mTextures.emplace(handle, std::move(texture));
+        return handle;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MipResidency::Remove(Handle const handle)
+    {
+        auto const findResult = mTextures.find(handle);
+        if (findResult == mTextures.end())
+        {
+            MFA_ASSERT(false);
+            return;
+        }
+        auto const & texture = findResult->second;
+        if (texture.targetMip != texture.residentMip)
+        {
+            --mPendingCount;
+        }
+        mResidentBytes -= texture.bytesFrom[texture.targetMip];
+        mTextures.erase(findResult);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MipResidency::Request(Handle const handle, uint8_t const desiredMip)
+    {
+        auto const findResult = mTextures.find(handle);
+        if (findResult == mTextures.end())
+        {
+            MFA_ASSERT(false);
+            return;
+        }
+        auto & texture = findResult->second;
+        auto const clampedMip = std::min(desiredMip, texture.tailMip);
+        texture.desiredMip = isRequested(texture) ? std::min(texture.desiredMip, clampedMip) : clampedMip;
+        texture.lastRequestTick = mTick;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::vector<MipResidency::Change> MipResidency::Update()
+    {
+        std::vector<Change> changes {};
+        std::vector<Demotion> demotions {};
+
+        // Budget was lowered
+        if (mResidentBytes > mBudgetBytes)
+        {
+            (void)planEviction(mResidentBytes - mBudgetBytes, InvalidHandle, demotions);
+            applyDemotions(demotions, changes);
+        }
+
+        // Textures that miss the most mips go first
+        std::vector<Handle> candidates {};
+        for (auto const & [handle, texture] : mTextures)
+        {
+            if (isRequested(texture) && texture.targetMip == texture.residentMip && texture.desiredMip < texture.residentMip)
+            {
+                candidates.emplace_back(handle);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](Handle const a, Handle const b)->bool
+        {
+            auto const & textureA = mTextures.at(a);
+            auto const & textureB = mTextures.at(b);
+            auto const missingA = textureA.residentMip - textureA.desiredMip;
+            auto const missingB = textureB.residentMip - textureB.desiredMip;
+            return missingA != missingB ? missingA > missingB : a < b;
+        });
+
+        for (auto const handle : candidates)
+        {
+            if (mPendingCount >= mMaxPendingCount)
+            {
+                break;
+            }
+            auto & texture = mTextures.at(handle);
+            // Falls back to fewer mips when the desired ones do not fit
+            for (auto targetMip = texture.desiredMip; targetMip < texture.residentMip; ++targetMip)
+            {
+                auto const neededBytes = texture.bytesFrom[targetMip] - texture.bytesFrom[texture.residentMip];
+                auto const freeBytes = mBudgetBytes > mResidentBytes ? mBudgetBytes - mResidentBytes : 0;
+                if (neededBytes > freeBytes)
+                {
+                    demotions.clear();
+                    if (planEviction(neededBytes - freeBytes, handle, demotions) < neededBytes - freeBytes)
+                    {
+                        continue;
+                    }
+                    applyDemotions(demotions, changes);
+                }
+                setTarget(handle, texture, targetMip, changes);
+                ++mPromotionCount;
+                break;
+            }
+        }
+
+        ++mTick;
+        return changes;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MipResidency::OnChangeApplied(Handle const handle)
+    {
+        auto const findResult = mTextures.find(handle);
+        if (findResult == mTextures.end())
+        {
+            return;     // Removed while the change was in flight
+        }
+        auto & texture = findResult->second;
+        MFA_ASSERT(texture.targetMip != texture.residentMip);
+        texture.residentMip = texture.targetMip;
+        --mPendingCount;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MipResidency::OnChangeFailed(Handle const handle)
+    {
+        auto const findResult = mTextures.find(handle);
+        if (findResult == mTextures.end())
+        {
+            return;
+        }
+        auto & texture = findResult->second;
+        MFA_ASSERT(texture.targetMip != texture.residentMip);
+        mResidentBytes -= texture.bytesFrom[texture.targetMip];
+        mResidentBytes += texture.bytesFrom[texture.residentMip];
+        texture.targetMip = texture.residentMip;
+        --mPendingCount;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MipResidency::SetBudget(size_t const budgetBytes)
+    {
+        mBudgetBytes = budgetBytes;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint8_t MipResidency::GetResidentMip(Handle const handle) const
+    {
+        auto const findResult = mTextures.find(handle);
+        MFA_ASSERT(findResult != mTextures.end());
+        return findResult != mTextures.end() ? findResult->second.residentMip : 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    MipResidencyStats MipResidency::GetStats() const
+    {
+        return MipResidencyStats {
+            .residentBytes = mResidentBytes,
+            .budgetBytes = mBudgetBytes,
+            .textureCount = static_cast<uint32_t>(mTextures.size()),
+            .pendingCount = mPendingCount,
+            .promotionCount = mPromotionCount,
+            .evictionCount = mEvictionCount
+        };
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool MipResidency::isRequested(Texture const & texture) const
+    {
+        return texture.lastRequestTick == mTick;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t MipResidency::planEviction(
+        size_t const neededBytes,
+        Handle const excludedHandle,
+        std::vector<Demotion> & outDemotions
+    ) const
+    {
+        struct Candidate
+        {
+            Handle handle;
+            uint64_t lastRequestTick;
+        };
+        std::vector<Candidate> candidates {};
+        for (auto const & [handle, texture] : mTextures)
+        {
+            if (handle != excludedHandle && texture.targetMip == texture.residentMip && texture.residentMip < texture.tailMip)
+            {
+                candidates.emplace_back(Candidate {.handle = handle, .lastRequestTick = texture.lastRequestTick});
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](Candidate const & a, Candidate const & b)->bool
+        {
+            return a.lastRequestTick != b.lastRequestTick ? a.lastRequestTick < b.lastRequestTick : a.handle < b.handle;
+        });
+
+        size_t plannedBytes = 0;
+        for (auto const & candidate : candidates)
+        {
+            if (plannedBytes >= neededBytes)
+            {
+                break;
+            }
+            auto const & texture = mTextures.at(candidate.handle);
+            // Textures that are in use keep the mips that they asked for
+            auto const lowestMip = isRequested(texture) ? std::max(texture.desiredMip, texture.residentMip) : texture.tailMip;
+            auto firstMip = texture.residentMip;
+            while (firstMip < lowestMip && plannedBytes < neededBytes)
+            {
+                plannedBytes += texture.bytesFrom[firstMip] - texture.bytesFrom[firstMip + 1];
+                ++firstMip;
+            }
+            if (firstMip != texture.residentMip)
+            {
+                outDemotions.emplace_back(Demotion {.handle = candidate.handle, .firstMip = firstMip});
+            }
+        }
+        return plannedBytes;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MipResidency::applyDemotions(std::vector<Demotion> const & demotions, std::vector<Change> & outChanges)
+    {
+        for (auto const & demotion : demotions)
+        {
+            auto & texture = mTextures.at(demotion.handle);
+            mEvictionCount += demotion.firstMip - texture.residentMip;
+            setTarget(demotion.handle, texture, demotion.firstMip, outChanges);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void MipResidency::setTarget(
+        Handle const handle,
+        Texture & texture,
+        uint8_t const targetMip,
+        std::vector<Change> & outChanges
+    )
+    {
+        MFA_ASSERT(texture.targetMip == texture.residentMip);
+        MFA_ASSERT(targetMip != texture.residentMip);
+        mResidentBytes -= texture.bytesFrom[texture.targetMip];
+        mResidentBytes += texture.bytesFrom[targetMip];
+        texture.targetMip = targetMip;
+        ++mPendingCount;
+        outChanges.emplace_back(Change {.handle = handle, .firstMip = targetMip});
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
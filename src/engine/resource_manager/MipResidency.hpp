@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace MFA::ResourceManager
+{
+
+    // First mip that covers the given size on the screen, Mip 0 is the largest.
+    // largestDimension is the larger side of mip 0 and screenPixels is the size of the object on the screen.
+    [[nodiscard]]
+    uint8_t ComputeDesiredMip(uint32_t largestDimension, float screenPixels, uint8_t mipCount);
+
+    struct MipResidencyStats
+    {
+        size_t residentBytes = 0;           // Mips above the tails, Changes in flight count with their target
+        size_t budgetBytes = 0;
+        uint32_t textureCount = 0;
+        uint32_t pendingCount = 0;          // Changes that the owner has not applied yet
+        uint64_t promotionCount = 0;
+        uint64_t evictionCount = 0;         // Mips that were dropped
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Decides which mips of the streamed textures are resident. Every texture keeps its tail, The smallest mips,
+    // And the larger mips are added when they are requested and fit in the budget. When a promotion does not fit,
+    // The top mips of the least recently requested textures are dropped first.
+    // Textures keep their mips while they fit, So a texture that is seen again does not stream in again.
+    // The owner applies the changes and reports back, Not thread safe.
+    class MipResidency
+    {
+    public:
+
+        using Handle = uint32_t;
+        static constexpr Handle InvalidHandle = 0;
+
+        struct Change
+        {
+            Handle handle = InvalidHandle;
+            uint8_t firstMip = 0;           // New first resident mip
+        };
+
+        explicit MipResidency(size_t budgetBytes, uint32_t maxPendingCount = 8);
+
+        MipResidency(MipResidency const &) noexcept = delete;
+        MipResidency(MipResidency &&) noexcept = delete;
+        MipResidency & operator = (MipResidency const &) noexcept = delete;
+        MipResidency & operator = (MipResidency &&) noexcept = delete;
+
+        // Mip sizes start from the largest mip. Mips from tailMip are always resident and are not counted by the budget.
+        [[nodiscard]]
+        Handle Add(std::vector<size_t> mipSizes, uint8_t tailMip);
+
+        void Remove(Handle handle);
+
+        // Every user of the texture asks for its mips each update, The smallest requested mip wins.
+        void Request(Handle handle, uint8_t desiredMip);
+
+        // Plans the changes of this update, Requests start over after it.
+        // Promotions are limited by maxPendingCount, Evictions are not.
+        [[nodiscard]]
+        std::vector<Change> Update();
+
+        // Owner calls one of these for each change
+        void OnChangeApplied(Handle handle);
+
+        void OnChangeFailed(Handle handle);
+
+        // Mips above the new budget are dropped on the next update
+        void SetBudget(size_t budgetBytes);
+
+        [[nodiscard]]
+        uint8_t GetResidentMip(Handle handle) const;
+
+        [[nodiscard]]
+        MipResidencyStats GetStats() const;
+
+    private:
+
+        struct Texture
+        {
+            std::vector<size_t> bytesFrom {};       // Bytes of mips [i, tailMip)
+            uint8_t tailMip = 0;
+            uint8_t residentMip = 0;                // What the gpu holds
+            uint8_t targetMip = 0;                  // Equal to residentMip when no change is in flight
+            uint8_t desiredMip = 0;
+            uint64_t lastRequestTick = 0;
+        };
+
+        struct Demotion
+        {
+            Handle handle = InvalidHandle;
+            uint8_t firstMip = 0;
+        };
+
+        [[nodiscard]]
+        bool isRequested(Texture const & texture) const;
+
+        // Plans dropping top mips of the least recently requested textures until neededBytes are freed.
+        // Returns the planned bytes, Nothing is changed.
+        size_t planEviction(size_t neededBytes, Handle excludedHandle, std::vector<Demotion> & outDemotions) const;
+
+        void applyDemotions(std::vector<Demotion> const & demotions, std::vector<Change> & outChanges);
+
+        void setTarget(Handle handle, Texture & texture, uint8_t targetMip, std::vector<Change> & outChanges);
+
+        std::unordered_map<Handle, Texture> mTextures {};
+        Handle mNextHandle = 1;
+
+        size_t mBudgetBytes;
+        size_t mResidentBytes = 0;                  // Of the target mips
+        uint32_t const mMaxPendingCount;
+        uint32_t mPendingCount = 0;
+
+        uint64_t mTick = 1;
+
+        uint64_t mPromotionCount = 0;
+        uint64_t mEvictionCount = 0;
+
+    };
+
+}
@@ -0,0 +1,136 @@
+#include "ResourceCache.hpp"
+
+#include <algorithm>
+
+namespace MFA::ResourceManager
+{
+
+    //-------------------------------------------------------------------------------------------------
+
+    CacheBudget::CacheBudget(size_t const budgetBytes)
+        : mBudgetBytes(budgetBytes)
+    {}
+
+    //-------------------------------------------------------------------------------------------------
+
+    CacheBudget::~CacheBudget()
+    {
+        MFA_ASSERT(mCaches.empty());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CacheBudget::Register(CacheBase * cache)
+    {
+        MFA_ASSERT(cache != nullptr);
+        SCOPE_LOCK(mLock)
+        mCaches.emplace_back(cache);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CacheBudget::UnRegister(CacheBase * cache)
+    {
+        SCOPE_LOCK(mLock)
+        auto const findResult = std::find(mCaches.begin(), mCaches.end(), cache);
+        MFA_ASSERT(findResult != mCaches.end());
+        mCaches.erase(findResult);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CacheBudget::SetBudgetBytes(size_t const budgetBytes)
+    {
+        mBudgetBytes.store(budgetBytes, std::memory_order_relaxed);
+        Trim();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    BudgetStats CacheBudget::GetStats() const
+    {
+        return BudgetStats {
+            .residentBytes = mResidentBytes.load(std::memory_order_relaxed),
+            .budgetBytes = mBudgetBytes.load(std::memory_order_relaxed),
+        };
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool CacheBudget::IsOverBudget() const
+    {
+        return mResidentBytes.load(std::memory_order_relaxed) > mBudgetBytes.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CacheBudget::AddResident(size_t const sizeBytes)
+    {
+        mResidentBytes.fetch_add(sizeBytes, std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void CacheBudget::RemoveResident(size_t const sizeBytes)
+    {
+        MFA_ASSERT(mResidentBytes.load(std::memory_order_relaxed) >= sizeBytes);
+        mResidentBytes.fetch_sub(sizeBytes, std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint64_t CacheBudget::NextTick()
+    {
+        return mTick.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t CacheBudget::Trim()
+    {
+        if (IsOverBudget() == false)
+        {
+            return 0;
+        }
+
+        bool expectedValue = false;
+        if (mIsTrimming.compare_exchange_strong(expectedValue, true) == false)
+        {
+            return 0;
+        }
+
+        std::vector<EvictionCandidate> candidates {};
+        {
+            SCOPE_LOCK(mLock)
+            for (auto * cache : mCaches)
+            {
+                cache->CollectEvictionCandidates(candidates);
+            }
+        }
+
+        // Least recently used first, Ticks are shared by all caches of this budget
+        std::sort(candidates.begin(), candidates.end(), [](EvictionCandidate const & a, EvictionCandidate const & b)->bool
+        {
+            return a.lastUseTick < b.lastUseTick;
+        });
+
+        uint32_t evictedCount = 0;
+        for (auto const & candidate : candidates)
+        {
+            if (IsOverBudget() == false)
+            {
+                break;
+            }
+            if (candidate.cache->TryEvict(candidate))
+            {
+                ++evictedCount;
+            }
+        }
+
+        mIsTrimming = false;
+        return evictedCount;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,394 @@
+#pragma once
+
+#include "engine/BedrockAssert.hpp"
+#include "engine/BedrockSignal.hpp"
+#include "engine/job_system/ScopeLock.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MFA::ResourceManager
+{
+
+    struct CacheStats
+    {
+        uint64_t hitCount = 0;              // Acquires that found the data in the cache
+        uint64_t missCount = 0;             // Acquires that waited for a load or got nothing
+        uint64_t evictionCount = 0;
+        uint32_t residentCount = 0;         // Entries that the cache keeps alive
+        size_t residentBytes = 0;
+    };
+
+    struct BudgetStats
+    {
+        size_t residentBytes = 0;
+        size_t budgetBytes = 0;
+    };
+
+    class CacheBase;
+
+    struct EvictionCandidate
+    {
+        CacheBase * cache = nullptr;
+        void * entry = nullptr;
+        uint64_t lastUseTick = 0;
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    class CacheBase
+    {
+    public:
+
+        virtual ~CacheBase() = default;
+
+        // Entries that only the cache holds
+        virtual void CollectEvictionCandidates(std::vector<EvictionCandidate> & outCandidates) = 0;
+
+        // Fails when the entry was used again after it was collected
+        virtual bool TryEvict(EvictionCandidate const & candidate) = 0;
+
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Memory limit that is shared by every cache of the same kind of memory, For example all cpu side assets.
+    // When the resident size goes over the budget the least recently used entries that nobody holds are evicted.
+    // In-use entries are never evicted, So the resident size can stay above the budget.
+    class CacheBudget
+    {
+    public:
+
+        explicit CacheBudget(size_t budgetBytes);
+        ~CacheBudget();
+
+        CacheBudget(CacheBudget const &) noexcept = delete;
+        CacheBudget(CacheBudget &&) noexcept = delete;
+        CacheBudget & operator = (CacheBudget const &) noexcept = delete;
+        CacheBudget & operator = (CacheBudget &&) noexcept = delete;
+
+        void Register(CacheBase * cache);
+
+        void UnRegister(CacheBase * cache);
+
+        void SetBudgetBytes(size_t budgetBytes);
+
+        [[nodiscard]]
+        BudgetStats GetStats() const;
+
+        [[nodiscard]]
+        bool IsOverBudget() const;
+
+        void AddResident(size_t sizeBytes);
+
+        void RemoveResident(size_t sizeBytes);
+
+        [[nodiscard]]
+        uint64_t NextTick();
+
+        // Evicts least recently used entries until the budget is met, Returns the number of evicted entries.
+        // Only one trim runs at a time, A concurrent call returns immediately.
+        uint32_t Trim();
+
+    private:
+
+        std::atomic<size_t> mBudgetBytes;
+        std::atomic<size_t> mResidentBytes {0};
+        std::atomic<uint64_t> mTick {0};
+
+        std::vector<CacheBase *> mCaches {};            // Guarded by mLock
+        std::atomic<bool> mLock = false;
+
+        std::atomic<bool> mIsTrimming = false;
+
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Thread safe map from resource id to loaded data, Entries are spread over shards that are locked separately.
+    // With a budget the cache holds a strong reference, So unused data stays resident until the budget evicts it.
+    // Without a budget it only holds a weak reference and data is freed with its last user.
+    // Entries are never removed, So references to them stay valid for the lifetime of the cache.
+    template<typename DataType, typename CallbackType>
+    class ResourceCache final : public CacheBase
+    {
+    public:
+
+        static constexpr uint32_t ShardCount = 16;
+
+        using EvictionListener = std::function<void(std::string const & id)>;
+
+        struct Entry
+        {
+            std::string id {};
+            std::weak_ptr<DataType> data {};
+            std::shared_ptr<DataType> retained {};      // Only with a budget
+            std::vector<CallbackType> callbacks {};     // Waiting for the load
+            size_t sizeBytes = 0;
+            uint64_t lastUseTick = 0;
+            std::atomic<bool> lock = false;
+        };
+
+        explicit ResourceCache(CacheBudget * budget = nullptr)
+            : mBudget(budget)
+        {
+            if (mBudget != nullptr)
+            {
+                mBudget->Register(this);
+            }
+        }
+
+        ~ResourceCache() override
+        {
+            if (mBudget != nullptr)
+            {
+                mBudget->UnRegister(this);
+                mBudget->RemoveResident(mResidentBytes.load());
+            }
+        }
+
+        ResourceCache(ResourceCache const &) noexcept = delete;
+        ResourceCache(ResourceCache &&) noexcept = delete;
+        ResourceCache & operator = (ResourceCache const &) noexcept = delete;
+        ResourceCache & operator = (ResourceCache &&) noexcept = delete;
+
+        [[nodiscard]]
+        Entry & GetEntry(std::string const & id)
+        {
+            auto & shard = mShards[std::hash<std::string> {}(id) % ShardCount];
+            SCOPE_LOCK(shard.lock)
+            auto [iterator, isInserted] = shard.entries.try_emplace(id);
+            if (isInserted)
+            {
+                iterator->second.id = id;
+            }
+            return iterator->second;
+        }
+
+        // Returns the data when it is in the cache, Otherwise the callback waits for Store unless canQueue is false.
+        // outShouldLoad is true for the first waiting callback, That caller starts the load.
+        [[nodiscard]]
+        std::shared_ptr<DataType> Acquire(
+            Entry & entry,
+            CallbackType const & callback,
+            bool const canQueue,
+            bool & outShouldLoad
+        )
+        {
+            outShouldLoad = false;
+
+            SCOPE_LOCK(entry.lock)
+
+            auto data = entry.data.lock();
+            if (data != nullptr)
+            {
+                mHitCount.fetch_add(1, std::memory_order_relaxed);
+                if (mBudget != nullptr)
+                {
+                    entry.lastUseTick = mBudget->NextTick();
+                }
+                return data;
+            }
+
+            mMissCount.fetch_add(1, std::memory_order_relaxed);
+            if (canQueue)
+            {
+                entry.callbacks.emplace_back(callback);
+                outShouldLoad = entry.callbacks.size() == 1;
+            }
+            return nullptr;
+        }
+
+        // Returns the callbacks that waited for this data, The caller invokes them without holding any lock.
+        // May evict other entries when the budget is exceeded.
+        [[nodiscard]]
+        std::vector<CallbackType> Store(
+            Entry & entry,
+            std::shared_ptr<DataType> const & data,
+            size_t const sizeBytes
+        )
+        {
+            std::vector<CallbackType> callbacks {};
+            std::shared_ptr<DataType> previous {};
+            {
+                SCOPE_LOCK(entry.lock)
+
+                entry.data = data;
+                std::swap(callbacks, entry.callbacks);
+
+                if (mBudget != nullptr)
+                {
+                    previous = std::move(entry.retained);
+                    if (previous != nullptr)
+                    {
+                        removeResident(entry.sizeBytes);
+                    }
+                    entry.retained = data;
+                    entry.sizeBytes = data != nullptr ? sizeBytes : 0;
+                    entry.lastUseTick = mBudget->NextTick();
+                    if (data != nullptr)
+                    {
+                        addResident(entry.sizeBytes);
+                    }
+                }
+            }
+
+            if (mBudget != nullptr && mBudget->IsOverBudget())
+            {
+                mBudget->Trim();
+            }
+
+            return callbacks;
+        }
+
+        // Drops the waiting callbacks that match the predicate, Returns the number of callbacks that still wait.
+        // A load whose callbacks are all dropped can stop, The next Acquire starts a new one.
+        template<typename Predicate>
+        size_t RemoveCallbacksIf(Entry & entry, Predicate const & predicate)
+        {
+            std::vector<CallbackType> removed {};
+            size_t remainingCount = 0;
+            {
+                SCOPE_LOCK(entry.lock)
+                for (size_t i = 0; i < entry.callbacks.size();)
+                {
+                    if (predicate(entry.callbacks[i]))
+                    {
+                        removed.emplace_back(std::move(entry.callbacks[i]));
+                        entry.callbacks.erase(entry.callbacks.begin() + static_cast<ptrdiff_t>(i));
+                        continue;
+                    }
+                    ++i;
+                }
+                remainingCount = entry.callbacks.size();
+            }
+            // Captures of the removed callbacks are released without holding the lock
+            removed.clear();
+            return remainingCount;
+        }
+
+        template<typename Visitor>
+        void VisitCallbacks(Entry & entry, Visitor const & visitor)
+        {
+            SCOPE_LOCK(entry.lock)
+            for (auto const & callback : entry.callbacks)
+            {
+                visitor(callback);
+            }
+        }
+
+        [[nodiscard]]
+        CacheStats GetStats() const
+        {
+            return CacheStats {
+                .hitCount = mHitCount.load(std::memory_order_relaxed),
+                .missCount = mMissCount.load(std::memory_order_relaxed),
+                .evictionCount = mEvictionCount.load(std::memory_order_relaxed),
+                .residentCount = mResidentCount.load(std::memory_order_relaxed),
+                .residentBytes = mResidentBytes.load(std::memory_order_relaxed),
+            };
+        }
+
+        // Listeners are called on the thread that triggered the eviction
+        SignalId RegisterEvictionListener(EvictionListener const & listener)
+        {
+            return mEvictionSignal.Register(listener);
+        }
+
+        bool UnRegisterEvictionListener(SignalId const listenerId)
+        {
+            return mEvictionSignal.UnRegister(listenerId);
+        }
+
+        void CollectEvictionCandidates(std::vector<EvictionCandidate> & outCandidates) override
+        {
+            for (auto & shard : mShards)
+            {
+                SCOPE_LOCK(shard.lock)
+                for (auto & [id, entry] : shard.entries)
+                {
+                    SCOPE_LOCK(entry.lock)
+                    if (isEvictable(entry))
+                    {
+                        outCandidates.emplace_back(EvictionCandidate {
+                            .cache = this,
+                            .entry = &entry,
+                            .lastUseTick = entry.lastUseTick
+                        });
+                    }
+                }
+            }
+        }
+
+        bool TryEvict(EvictionCandidate const & candidate) override
+        {
+            MFA_ASSERT(candidate.cache == this);
+            auto & entry = *static_cast<Entry *>(candidate.entry);
+
+            // Data is destroyed after the lock is released
+            std::shared_ptr<DataType> evicted {};
+            {
+                SCOPE_LOCK(entry.lock)
+                if (isEvictable(entry) == false || entry.lastUseTick != candidate.lastUseTick)
+                {
+                    return false;
+                }
+                evicted = std::move(entry.retained);
+                entry.data.reset();
+                removeResident(entry.sizeBytes);
+                entry.sizeBytes = 0;
+            }
+            evicted.reset();
+
+            mEvictionCount.fetch_add(1, std::memory_order_relaxed);
+            mEvictionSignal.Emit(entry.id);
+            return true;
+        }
+
+    private:
+
+        struct Shard
+        {
+            std::unordered_map<std::string, Entry> entries {};      // Guarded by lock
+            std::atomic<bool> lock = false;
+        };
+
+        // Must be called while holding the entry lock
+        static bool isEvictable(Entry const & entry)
+        {
+            return entry.retained != nullptr && entry.retained.use_count() == 1 && entry.callbacks.empty();
+        }
+
+        void addResident(size_t const sizeBytes)
+        {
+            mResidentCount.fetch_add(1, std::memory_order_relaxed);
+            mResidentBytes.fetch_add(sizeBytes, std::memory_order_relaxed);
+            mBudget->AddResident(sizeBytes);
+        }
+
+        void removeResident(size_t const sizeBytes)
+        {
+            mResidentCount.fetch_sub(1, std::memory_order_relaxed);
+            mResidentBytes.fetch_sub(sizeBytes, std::memory_order_relaxed);
+            mBudget->RemoveResident(sizeBytes);
+        }
+
+        CacheBudget * const mBudget;
+
+        Shard mShards[ShardCount] {};
+
+        std::atomic<uint64_t> mHitCount {0};
+        std::atomic<uint64_t> mMissCount {0};
+        std::atomic<uint64_t> mEvictionCount {0};
+        std::atomic<uint32_t> mResidentCount {0};
+        std::atomic<size_t> mResidentBytes {0};
+
+        Signal<std::string const &> mEvictionSignal {};
+
+    };
+
+}
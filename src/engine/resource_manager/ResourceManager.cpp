@@ -1,5 +1,6 @@
 #include "ResourceManager.hpp"
 
+#include "ResourceCache.hpp"
 #include "engine/render_system/RenderTypes.hpp"
 #include "engine/BedrockAssert.hpp"
 #include "tools/Importer.hpp"
@@ -12,106 +13,676 @@
 #include "engine/render_system/pipelines/EssenceBase.hpp"
 #include "engine/render_system/pipelines/pbr_with_shadow_v2/PBR_Essence.hpp"
 #include "engine/render_system/pipelines/BasePipeline.hpp"
-#include "engine/scene_manager/SceneManager.hpp"
 #include "engine/job_system/TaskTracker.hpp"
 #include "engine/physics/PhysicsTypes.hpp"
 #include "engine/physics/Physics.hpp"
+#include "engine/physics/PhysicsMeshCache.hpp"
 
 #include <cooking/PxTriangleMeshDesc.h>
 
-#include <unordered_map>
 #include <cooking/PxCooking.h>
 
+#include <algorithm>
+
 namespace MFA::ResourceManager
 {
 
     //-------------------------------------------------------------------------------------------------
 
-    template<typename DataType, typename CallbackType>
-    struct Data
+    template<typename CallbackType>
+    struct Waiter
+    {
+        CallbackType callback = nullptr;
+        RequestPtr request = nullptr;
+    };
+
+    using CpuModelCache = ResourceCache<AS::Model, Waiter<CpuModelCallback>>;
+    using CpuTextureCache = ResourceCache<AS::Texture, Waiter<CpuTextureCallback>>;
+    using GpuTextureCache = ResourceCache<RT::GpuTexture, Waiter<GpuTextureCallback>>;
+    using EssenceCache = ResourceCache<EssenceBase, Waiter<EssenceCallback>>;
+    using PhysicsMeshCache = ResourceCache<Physics::TriangleMeshGroup, Waiter<PhysicsMeshCallback>>;
+
+    //-------------------------------------------------------------------------------------------------
+
+    struct StreamedTexture
     {
-        std::weak_ptr<DataType> data {};
-        std::vector<CallbackType> callbacks {};
-        std::atomic<bool> lock = false;
+        std::string id {};
+        AS::TextureUsage usage {};
+        RT::GpuTexture const * key = nullptr;
+        std::weak_ptr<RT::GpuTexture> texture {};
+        uint32_t largestDimension = 0;              // Of mip 0
+        RequestPtr request = nullptr;               // Promotion that is loading
+    };
+
+    struct RetiredImage
+    {
+        std::shared_ptr<RT::ImageGroup> imageGroup {};
+        std::shared_ptr<RT::ImageViewGroup> imageView {};
+        uint32_t remainingFrames = 0;
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    struct State
+    {
+        explicit State(InitParams const & params)
+            : cpuBudget(params.cpuBudgetBytes)
+            , gpuBudget(params.gpuBudgetBytes)
+            , textureTailSize(params.textureTailSize)
+            , mipResidency(params.mipStreamBudgetBytes, params.maxPendingMipChanges)
+            , scheduler(
+                StreamingScheduler::Params {
+                    .maxIoJobs = params.maxIoJobs,
+                    .maxDecodeJobs = params.maxDecodeJobs,
+                    .uploadBudgetMs = params.uploadBudgetMs
+                },
+                [](StreamingScheduler::Work const & work)->void
+                {
+                    JS::AssignTask([work](JS::ThreadNumber, JS::ThreadNumber)->void
+                    {
+                        work();
+                    });
+                }
+            )
+        {}
+
+        // Budgets are declared first, So the caches are destroyed before them
+        CacheBudget cpuBudget;
+        CacheBudget gpuBudget;
+
+        CpuModelCache cpuModels {&cpuBudget};
+
+        GpuTextureCache gpuTextures {&gpuBudget};
+        CpuTextureCache cpuTextures {&cpuBudget};
+
+        // Pipelines own their essences, So the cache does not keep them alive
+        EssenceCache essences {};
+
+        PhysicsMeshCache physicsMeshes {&cpuBudget};
+
+        // Mip streaming, Main thread only
+        uint32_t const textureTailSize;
+        MipResidency mipResidency;
+        std::unordered_map<MipResidency::Handle, StreamedTexture> streamedTextures {};
+        std::unordered_map<RT::GpuTexture const *, MipResidency::Handle> streamedTextureHandles {};
+        std::vector<RetiredImage> retiredImages {};
+
+        // Pending jobs refer to cache entries, So the scheduler is destroyed first
+        StreamingScheduler scheduler;
+
     };
+    State * state = nullptr;
 
     //-------------------------------------------------------------------------------------------------
 
-    struct CpuModelData : Data<AS::Model, CpuModelCallback> {};
+    void Init(InitParams const & params)
+    {
+        state = new State(params);
+    }
 
     //-------------------------------------------------------------------------------------------------
 
-    struct CpuTextureData : Data<AS::Texture, CpuTextureCallback> {};
+    void Shutdown()
+    {
+        delete state;
+        state = nullptr;
+    }
 
     //-------------------------------------------------------------------------------------------------
 
-    struct GpuTextureData : Data<RT::GpuTexture, GpuTextureCallback> {};
+    static void UpdateMipStreaming();
+
+    void Update()
+    {
+        MFA_ASSERT(JS::IsMainThread());
+        UpdateMipStreaming();
+        state->scheduler.RunUploads();
+    }
 
     //-------------------------------------------------------------------------------------------------
 
-    struct EssenceData : Data<EssenceBase, EssenceCallback> {};
+    StreamStats GetStreamStats()
+    {
+        return state->scheduler.GetStats();
+    }
 
     //-------------------------------------------------------------------------------------------------
 
-    struct PhysicsMeshData : Data<Physics::TriangleMeshGroup, PhysicsMeshCallback> {};
+    void SetUploadBudget(float const budgetMs)
+    {
+        state->scheduler.SetUploadBudget(budgetMs);
+    }
 
     //-------------------------------------------------------------------------------------------------
 
-    struct State
+    float GetUploadBudget()
     {
-        std::unordered_map<std::string, CpuModelData> cpuModels{};
+        return state->scheduler.GetUploadBudget();
+    }
 
-        std::unordered_map<std::string, GpuTextureData> gpuTextures {};
-        std::unordered_map<std::string, CpuTextureData> cpuTextures {};
+    //-------------------------------------------------------------------------------------------------
 
-        std::unordered_map<std::string, EssenceData> essences {};
+    template<typename Function>
+    static decltype(auto) VisitCache(CacheType const cacheType, Function && function)
+    {
+        switch (cacheType)
+        {
+        case CacheType::CpuModel:
+            return function(state->cpuModels);
+        case CacheType::CpuTexture:
+            return function(state->cpuTextures);
+        case CacheType::GpuTexture:
+            return function(state->gpuTextures);
+        case CacheType::PhysicsMesh:
+            return function(state->physicsMeshes);
+        case CacheType::Essence:
+            return function(state->essences);
+        default:
+            MFA_ASSERT(false);
+            return function(state->cpuModels);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static CacheBudget & GetBudget(BudgetType const budgetType)
+    {
+        MFA_ASSERT(budgetType == BudgetType::Cpu || budgetType == BudgetType::Gpu);
+        return budgetType == BudgetType::Gpu ? state->gpuBudget : state->cpuBudget;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    CacheStats GetCacheStats(CacheType const cacheType)
+    {
+        return VisitCache(cacheType, [](auto const & cache)->CacheStats
+        {
+            return cache.GetStats();
+        });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    char const * CacheTypeName(CacheType const cacheType)
+    {
+        switch (cacheType)
+        {
+        case CacheType::CpuModel:
+            return "Cpu model";
+        case CacheType::CpuTexture:
+            return "Cpu texture";
+        case CacheType::GpuTexture:
+            return "Gpu texture";
+        case CacheType::PhysicsMesh:
+            return "Physics mesh";
+        case CacheType::Essence:
+            return "Essence";
+        default:
+            MFA_ASSERT(false);
+            return "";
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    BudgetStats GetBudgetStats(BudgetType const budgetType)
+    {
+        return GetBudget(budgetType).GetStats();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SetBudget(BudgetType const budgetType, size_t const budgetBytes)
+    {
+        GetBudget(budgetType).SetBudgetBytes(budgetBytes);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Trim()
+    {
+        state->cpuBudget.Trim();
+        state->gpuBudget.Trim();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    SignalId RegisterEvictionListener(CacheType const cacheType, EvictionListener const & listener)
+    {
+        return VisitCache(cacheType, [&listener](auto & cache)->SignalId
+        {
+            return cache.RegisterEvictionListener(listener);
+        });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool UnRegisterEvictionListener(CacheType const cacheType, SignalId const listenerId)
+    {
+        return VisitCache(cacheType, [listenerId](auto & cache)->bool
+        {
+            return cache.UnRegisterEvictionListener(listenerId);
+        });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template<typename CallbackType>
+    static bool IsWaiterCancelled(Waiter<CallbackType> const & waiter)
+    {
+        return waiter.request != nullptr && waiter.request->IsCancelled();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Owners cancel their request before they are destroyed, So cancelled callbacks are skipped
+    template<typename WaiterList, typename ... ArgsT>
+    static void InvokeCallbacks(WaiterList const & waiters, ArgsT const & ... args)
+    {
+        for (auto const & waiter : waiters)
+        {
+            if (IsWaiterCancelled(waiter) == false)
+            {
+                waiter.callback(args...);
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Highest priority among the requests that still wait for the entry
+    template<typename Cache>
+    static float WaitingPriority(Cache & cache, typename Cache::Entry & entry)
+    {
+        bool hasWaiter = false;
+        float priority = StreamRequest::DefaultPriority;
+        cache.VisitCallbacks(entry, [&hasWaiter, &priority](auto const & waiter)->void
+        {
+            if (IsWaiterCancelled(waiter))
+            {
+                return;
+            }
+            auto const waiterPriority = waiter.request != nullptr
+                ? waiter.request->GetPriority()
+                : StreamRequest::DefaultPriority;
+            priority = hasWaiter ? std::max(priority, waiterPriority) : waiterPriority;
+            hasWaiter = true;
+        });
+        return priority;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    template<typename Cache>
+    static bool HasActiveWaiter(Cache & cache, typename Cache::Entry & entry)
+    {
+        bool hasActiveWaiter = false;
+        cache.VisitCallbacks(entry, [&hasActiveWaiter](auto const & waiter)->void
+        {
+            hasActiveWaiter |= IsWaiterCancelled(waiter) == false;
+        });
+        return hasActiveWaiter;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Drops cancelled callbacks, Returns true when nobody waits for the entry anymore
+    template<typename Cache>
+    static bool RemoveCancelledWaiters(Cache & cache, typename Cache::Entry & entry)
+    {
+        return cache.RemoveCallbacksIf(entry, [](auto const & waiter)->bool
+        {
+            return IsWaiterCancelled(waiter);
+        }) == 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Request of a load that another load depends on, For example the cpu texture of a gpu texture.
+    // It follows the requests that wait for the dependent entry, So it is cancelled once all of them are cancelled.
+    template<typename Cache>
+    class DependencyRequest final : public StreamRequest
+    {
+    public:
+
+        explicit DependencyRequest(Cache & cache, typename Cache::Entry & entry)
+            : mCache(cache)
+            , mEntry(entry)
+        {}
+
+        [[nodiscard]]
+        float GetPriority() const override
+        {
+            return WaitingPriority(mCache, mEntry);
+        }
+
+        [[nodiscard]]
+        bool IsCancelled() const override
+        {
+            return HasActiveWaiter(mCache, mEntry) == false;
+        }
+
+    private:
+
+        Cache & mCache;
+        typename Cache::Entry & mEntry;
 
-        std::unordered_map<std::string, PhysicsMeshData> physicsMeshes {};
-    
     };
-    State * state = nullptr;
 
     //-------------------------------------------------------------------------------------------------
 
-    void Init()
+    template<typename Cache>
+    static RequestPtr MakeDependencyRequest(Cache & cache, typename Cache::Entry & entry)
     {
-        state = new State();
+        return std::make_shared<DependencyRequest<Cache>>(cache, entry);
     }
 
     //-------------------------------------------------------------------------------------------------
 
-    void Shutdown()
+    // Cancelled callbacks are removed first, Otherwise they would wait for a load that has already stopped
+    template<typename Cache, typename CallbackType>
+    static auto AcquireFromCache(
+        Cache & cache,
+        typename Cache::Entry & entry,
+        CallbackType const & callback,
+        RequestPtr const & request,
+        bool const canQueue,
+        bool & outShouldLoad
+    )
     {
-        
-//        for (auto & cpuTexture : state->cpuTextures)
-//        {
-//            MFA_ASSERT(cpuTexture.second.callbacks.empty());
-//            MFA_ASSERT(cpuTexture.second.data.lock() == nullptr);
-//        }
-        state->cpuTextures.clear();
-
-//        for (auto & essence : state->essences)
-//        {
-//            MFA_ASSERT(essence.second.callbacks.empty());
-//            MFA_ASSERT(essence.second.data.lock() == nullptr);
-//        }
-        state->essences.clear();
-
-//        for (auto & texture : state->gpuTextures)
-//        {
-//            MFA_ASSERT(texture.second.callbacks.empty());
-//            MFA_ASSERT(texture.second.data.lock() == nullptr);
-//        }
-        state->gpuTextures.clear();
-
-//        for (auto & cpuModel : state->cpuModels)
-//        {
-//            MFA_ASSERT(cpuModel.second.callbacks.empty());
-//            MFA_ASSERT(cpuModel.second.data.lock() == nullptr);
-//        }
-        state->cpuModels.clear();
+        (void)RemoveCancelledWaiters(cache, entry);
+        return cache.Acquire(entry, Waiter<CallbackType> {callback, request}, canQueue, outShouldLoad);
+    }
 
-        delete state;
+    //-------------------------------------------------------------------------------------------------
+
+    // Job of a load is dropped when every request that waits for the entry is cancelled
+    template<typename Cache>
+    static void SubmitStage(
+        StreamStage const stage,
+        Cache & cache,
+        typename Cache::Entry & entry,
+        std::function<void()> && run
+    )
+    {
+        state->scheduler.Submit(stage, StreamJob {
+            .getPriority = [&cache, &entry]()->float
+            {
+                return WaitingPriority(cache, entry);
+            },
+            .isCancelled = [&cache, &entry]()->bool
+            {
+                return RemoveCancelledWaiters(cache, entry);
+            },
+            .run = std::move(run)
+        });
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static size_t ModelSizeBytes(AS::Model const * cpuModel)
+    {
+        if (cpuModel == nullptr || cpuModel->mesh == nullptr)
+        {
+            return 0;
+        }
+        size_t sizeBytes = 0;
+        if (auto const * vertexData = cpuModel->mesh->getVertexData(); vertexData != nullptr)
+        {
+            sizeBytes += vertexData->memory.len;
+        }
+        if (auto const * indexData = cpuModel->mesh->getIndexData(); indexData != nullptr)
+        {
+            sizeBytes += indexData->memory.len;
+        }
+        return sizeBytes;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Gpu textures use about the same memory as the cpu texture that they are created from
+    static size_t TextureSizeBytes(AS::Texture const * texture, uint8_t const firstMip = 0)
+    {
+        return texture != nullptr ? texture->GetBuffer().len - texture->GetMipmap(firstMip).offset : 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // First mip that fits in the tail size, Textures with a single mip are not streamed
+    static uint8_t ComputeTailMip(AS::Texture const & texture)
+    {
+        auto const mipCount = texture.GetMipCount();
+        for (uint8_t mip = 0; mip < mipCount; ++mip)
+        {
+            auto const & dimension = texture.GetMipmap(mip).dimension;
+            if (std::max(dimension.width, dimension.height) <= state->textureTailSize)
+            {
+                return mip;
+            }
+        }
+        return static_cast<uint8_t>(mipCount - 1);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void RegisterStreamedTexture(
+        std::string const & id,
+        AS::TextureUsage const usage,
+        std::shared_ptr<RT::GpuTexture> const & gpuTexture,
+        AS::Texture const & cpuTexture,
+        uint8_t const tailMip
+    )
+    {
+        MFA_ASSERT(JS::IsMainThread());
+
+        auto const mipCount = cpuTexture.GetMipCount();
+        std::vector<size_t> mipSizes(mipCount);
+        for (uint8_t mip = 0; mip < mipCount; ++mip)
+        {
+            auto const endOffset = mip + 1 < mipCount ? cpuTexture.GetMipmap(mip + 1).offset : cpuTexture.GetBuffer().len;
+            mipSizes[mip] = endOffset - cpuTexture.GetMipmap(mip).offset;
+        }
+
+        // Address of a destroyed texture can be reused before the next update removes its record
+        auto const findResult = state->streamedTextureHandles.find(gpuTexture.get());
+        if (findResult != state->streamedTextureHandles.end())
+        {
+            auto const & previous = state->streamedTextures.at(findResult->second);
+            MFA_ASSERT(previous.texture.expired());
+            if (previous.request != nullptr)
+            {
+                previous.request->Cancel();
+            }
+            state->mipResidency.Remove(findResult->second);
+            state->streamedTextures.erase(findResult->second);
+            state->streamedTextureHandles.erase(findResult);
+        }
+
+        auto const & largestDimension = cpuTexture.GetMipmap(0).dimension;
+        auto const handle = state->mipResidency.Add(std::move(mipSizes), tailMip);
+        state->streamedTextures.emplace(handle, StreamedTexture {
+            .id = id,
+            .usage = usage,
+            .key = gpuTexture.get(),
+            .texture = gpuTexture,
+            .largestDimension = std::max(largestDimension.width, largestDimension.height),
+        });
+        state->streamedTextureHandles.emplace(gpuTexture.get(), handle);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Texture stays with the mips that it has
+    static void StopStreaming(MipResidency::Handle const handle)
+    {
+        auto const findResult = state->streamedTextures.find(handle);
+        if (findResult == state->streamedTextures.end())
+        {
+            return;
+        }
+        if (findResult->second.request != nullptr)
+        {
+            findResult->second.request->Cancel();
+        }
+        state->streamedTextureHandles.erase(findResult->second.key);
+        state->streamedTextures.erase(findResult);
+        state->mipResidency.Remove(handle);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void ApplyResidency(RT::GpuTexture & texture, uint8_t const firstMip, AS::Texture const * cpuTexture)
+    {
+        RetiredImage retiredImage {.remainingFrames = RF::GetMaxFramesPerFlight() + 1};
+        RF::ChangeTextureResidency(texture, firstMip, cpuTexture, retiredImage.imageGroup, retiredImage.imageView);
+        state->retiredImages.emplace_back(std::move(retiredImage));
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Runs on the upload stage
+    static void OnPromotionLoaded(
+        MipResidency::Handle const handle,
+        uint8_t const firstMip,
+        std::shared_ptr<AS::Texture> const & cpuTexture
+    )
+    {
+        auto const findResult = state->streamedTextures.find(handle);
+        if (findResult == state->streamedTextures.end())
+        {
+            return;
+        }
+        findResult->second.request = nullptr;
+
+        auto const texture = findResult->second.texture.lock();
+        if (
+            texture == nullptr ||
+            cpuTexture == nullptr ||
+            cpuTexture->GetMipCount() != texture->mipCount ||
+            firstMip >= texture->firstResidentMip
+        )
+        {
+            state->mipResidency.OnChangeFailed(handle);
+            StopStreaming(handle);
+            return;
+        }
+
+        ApplyResidency(*texture, firstMip, cpuTexture.get());
+        state->mipResidency.OnChangeApplied(handle);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void StartPromotion(MipResidency::Handle const handle, StreamedTexture & record, uint8_t const firstMip)
+    {
+        // Mips load after the first loads of visible objects, Those use higher priorities
+        auto const request = std::make_shared<StreamRequest>();
+        record.request = request;
+
+        // Full chain comes from the cpu cache, Or from disk when the cache has evicted it
+        AcquireCpuTexture(
+            record.id,
+            [handle, firstMip, request](std::shared_ptr<AS::Texture> const & cpuTexture)->void
+            {
+                state->scheduler.Submit(StreamStage::Upload, StreamJob {
+                    .getPriority = [request]()->float
+                    {
+                        return request->GetPriority();
+                    },
+                    .isCancelled = [request]()->bool
+                    {
+                        return request->IsCancelled();
+                    },
+                    .run = [handle, firstMip, cpuTexture]()->void
+                    {
+                        OnPromotionLoaded(handle, firstMip, cpuTexture);
+                    }
+                });
+            },
+            true,
+            record.usage,
+            request
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void UpdateMipStreaming()
+    {
+        // Old images of the frames that are no longer in flight
+        for (size_t i = 0; i < state->retiredImages.size();)
+        {
+            auto & retiredImage = state->retiredImages[i];
+            if (retiredImage.remainingFrames > 0)
+            {
+                --retiredImage.remainingFrames;
+                ++i;
+                continue;
+            }
+            retiredImage = std::move(state->retiredImages.back());
+            state->retiredImages.pop_back();
+        }
+
+        std::vector<MipResidency::Handle> releasedTextures {};
+        for (auto const & [handle, record] : state->streamedTextures)
+        {
+            if (record.texture.expired())
+            {
+                releasedTextures.emplace_back(handle);
+            }
+        }
+        for (auto const handle : releasedTextures)
+        {
+            StopStreaming(handle);
+        }
+
+        for (auto const & change : state->mipResidency.Update())
+        {
+            auto & record = state->streamedTextures.at(change.handle);
+            auto const texture = record.texture.lock();
+            MFA_ASSERT(texture != nullptr);
+            if (change.firstMip > texture->firstResidentMip)
+            {
+                // Dropped mips only need a gpu copy of the rest
+                ApplyResidency(*texture, change.firstMip, nullptr);
+                state->mipResidency.OnChangeApplied(change.handle);
+            }
+            else
+            {
+                StartPromotion(change.handle, record, change.firstMip);
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void RequestTextureMips(RT::GpuTexture const & texture, float const screenPixels)
+    {
+        MFA_ASSERT(JS::IsMainThread());
+        auto const findResult = state->streamedTextureHandles.find(&texture);
+        if (findResult == state->streamedTextureHandles.end())
+        {
+            return;
+        }
+        auto const & record = state->streamedTextures.at(findResult->second);
+        state->mipResidency.Request(
+            findResult->second,
+            ComputeDesiredMip(record.largestDimension, screenPixels, texture.mipCount)
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    MipResidencyStats GetMipStreamStats()
+    {
+        return state->mipResidency.GetStats();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SetMipStreamBudget(size_t const budgetBytes)
+    {
+        state->mipResidency.SetBudget(budgetBytes);
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -184,33 +755,33 @@ namespace MFA::ResourceManager
     void AcquireCpuModel(
         std::string const & modelId,
         CpuModelCallback const & callback,
-        bool const loadFromFile
+        bool const loadFromFile,
+        RequestPtr const & request
     )
     {
         std::string const relativePath = Path::RelativeToAssetFolder(modelId);
 
-        auto & cpuModelData = state->cpuModels[relativePath];
+        auto & cpuModelData = state->cpuModels.GetEntry(relativePath);
 
-        bool shouldAssignTask;
+        bool shouldAssignTask = false;
+        auto const cpuModel = AcquireFromCache(
+            state->cpuModels,
+            cpuModelData,
+            callback,
+            request,
+            loadFromFile,
+            shouldAssignTask
+        );
+        if (cpuModel != nullptr || loadFromFile == false)
         {
-            SCOPE_LOCK(cpuModelData.lock)
-
-            auto const cpuModel = cpuModelData.data.lock();
-
-            if (cpuModel != nullptr || loadFromFile == false)
-            {
-                callback(cpuModel);
-                return;
-            }
-
-            cpuModelData.callbacks.emplace_back(callback);
-
-            shouldAssignTask = cpuModelData.callbacks.size() == 1;
+            callback(cpuModel);
+            return;
         }
 
         if (shouldAssignTask)
         {
-            JS::AssignTask([relativePath, &cpuModelData](JS::ThreadNumber threadNumber, JS::ThreadNumber totalThreadCount)->void {
+            // Gltf importer reads its own buffers, So models skip the io stage
+            SubmitStage(StreamStage::Decode, state->cpuModels, cpuModelData, [relativePath, &cpuModelData]()->void {
 
                 std::shared_ptr<AS::Model> cpuModel = nullptr;
 
@@ -232,16 +803,8 @@ namespace MFA::ResourceManager
                     MFA_NOT_IMPLEMENTED_YET("Mohammad Fakhreddin");
                 }
 
-                SCOPE_LOCK(cpuModelData.lock)
-
-                cpuModelData.data = cpuModel;
-
-                for (auto & callback : cpuModelData.callbacks)
-                {
-                    callback(cpuModel);
-                }
-
-                cpuModelData.callbacks.clear();
+                auto const callbacks = state->cpuModels.Store(cpuModelData, cpuModel, ModelSizeBytes(cpuModel.get()));
+                InvokeCallbacks(callbacks, cpuModel);
 
             });
         }
@@ -253,7 +816,9 @@ namespace MFA::ResourceManager
     void AcquireGpuTexture(
         std::string const & textureId,
         GpuTextureCallback const & callback,
-        bool const loadFromFile
+        bool const loadFromFile,
+        AS::TextureUsage const usage,
+        RequestPtr const & request
     )
     {
         MFA_ASSERT(textureId.empty() == false);
@@ -261,146 +826,171 @@ namespace MFA::ResourceManager
         
         std::string const relativePath = Path::RelativeToAssetFolder(textureId);
 
-        auto & gpuTextureData = state->gpuTextures[relativePath];
+        auto & gpuTextureData = state->gpuTextures.GetEntry(relativePath);
 
-        bool shouldAssignTask;
+        bool shouldAssignTask = false;
+        auto const gpuTexture = AcquireFromCache(
+            state->gpuTextures,
+            gpuTextureData,
+            callback,
+            request,
+            true,
+            shouldAssignTask
+        );
+        // It means that file is already loaded and still exists
+        if (gpuTexture != nullptr)
         {
-            SCOPE_LOCK(gpuTextureData.lock)
-
-            auto const gpuTexture = gpuTextureData.data.lock();
-
-            // It means that file is already loaded and still exists
-            if (gpuTexture != nullptr)
-            {
-                callback(gpuTexture);
-                return;
-            }
-
-            gpuTextureData.callbacks.emplace_back(callback);
-
-            shouldAssignTask = gpuTextureData.callbacks.size() == 1;
+            callback(gpuTexture);
+            return;
         }
 
         if (shouldAssignTask)
         {
             AcquireCpuTexture(
                 relativePath,
-                [relativePath, &gpuTextureData]
+                [&gpuTextureData, relativePath, usage]
                 (std::shared_ptr<AS::Texture> const & texture)->void{
-                    SceneManager::AssignMainThreadTask([relativePath, &gpuTextureData, texture]()->void {
-                        MFA_ASSERT(texture != nullptr);
-                        
-                        SCOPE_LOCK(gpuTextureData.lock)
-
-                        auto const gpuTexture = RF::CreateTexture(*texture);
-                        gpuTextureData.data = gpuTexture;
-
-                        for (auto & callback : gpuTextureData.callbacks)
+                    MFA_ASSERT(texture != nullptr);
+                    SubmitStage(StreamStage::Upload, state->gpuTextures, gpuTextureData, [&gpuTextureData, relativePath, usage, texture]()->void {
+                        // Only the tail is uploaded, Larger mips stream in when they are requested
+                        auto const tailMip = ComputeTailMip(*texture);
+                        auto const gpuTexture = RF::CreateTexture(*texture, false, tailMip);
+                        if (tailMip > 0)
                         {
-                            // TODO: What if the object holding this callback is dead ?
-                            callback(gpuTexture);
+                            RegisterStreamedTexture(relativePath, usage, gpuTexture, *texture, tailMip);
                         }
-                        gpuTextureData.callbacks.clear();
+                        auto const callbacks = state->gpuTextures.Store(
+                            gpuTextureData,
+                            gpuTexture,
+                            TextureSizeBytes(texture.get(), tailMip)
+                        );
+                        InvokeCallbacks(callbacks, gpuTexture);
                     });
                 },
-                loadFromFile
+                loadFromFile,
+                usage,
+                MakeDependencyRequest(state->gpuTextures, gpuTextureData)
             );
         }
     }
 
     //-------------------------------------------------------------------------------------------------
 
+    static void StoreCpuTexture(CpuTextureCache::Entry & textureData, std::shared_ptr<AS::Texture> const & texture)
+    {
+        auto const callbacks = state->cpuTextures.Store(textureData, texture, TextureSizeBytes(texture.get()));
+        InvokeCallbacks(callbacks, texture);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Png and jpeg files are read on the io stage and decoded (And compressed on the first run) on the decode stage.
+    // Ktx, Ktx2 and dds levels are read straight into the texture, So they finish on the io stage.
     void AcquireCpuTexture(
         std::string const & textureId,
         CpuTextureCallback const & callback,
-        bool const loadFromFile
+        bool const loadFromFile,
+        AS::TextureUsage const usage,
+        RequestPtr const & request
     )
     {
         std::string const relativePath = Path::RelativeToAssetFolder(textureId);
 
-        auto & textureData = state->cpuTextures[relativePath];
+        auto & textureData = state->cpuTextures.GetEntry(relativePath);
 
-        bool shouldAssignTask;
+        bool shouldAssignTask = false;
+        auto const existingTexture = AcquireFromCache(
+            state->cpuTextures,
+            textureData,
+            callback,
+            request,
+            loadFromFile,
+            shouldAssignTask
+        );
+        if (existingTexture != nullptr || loadFromFile == false)
         {
-            SCOPE_LOCK(textureData.lock)
-
-            auto const existingTexture = textureData.data.lock();
-
-            if (existingTexture != nullptr || loadFromFile == false)
-            {
-                callback(existingTexture);
-                return;
-            }
-
-            textureData.callbacks.emplace_back(callback);
-
-            shouldAssignTask = textureData.callbacks.size() == 1;
+            callback(existingTexture);
+            return;
         }
 
-        if (shouldAssignTask)
+        if (shouldAssignTask == false)
         {
-            JS::AssignTask([relativePath, &textureData](JS::ThreadNumber threadNumber, JS::ThreadNumber totalThreadCount)->void {
-
-                std::shared_ptr<AssetSystem::Texture> texture = nullptr;
+            return;
+        }
 
-                auto const extension = Path::ExtractExtensionFromPath(relativePath);
+        auto const extension = Path::ExtractExtensionFromPath(relativePath);
 
-                if (extension == ".ktx")
-                {
-                    texture = Importer::ImportKTXImage(Path::ForReadWrite(relativePath));
-                } else if (extension == ".png" || extension == ".jpg" || extension == ".jpeg")
-                {
-                    texture = Importer::ImportUncompressedImage(Path::ForReadWrite(relativePath));
-                } else if (relativePath == "Error")
-                {
-                    texture = Importer::CreateErrorTexture();
-                } else
+        if (extension == ".ktx")
+        {
+            SubmitStage(StreamStage::Io, state->cpuTextures, textureData, [relativePath, &textureData]()->void {
+                StoreCpuTexture(textureData, Importer::ImportKTXImage(Path::ForReadWrite(relativePath)));
+            });
+        } else if (extension == ".ktx2" || extension == ".dds")
+        {
+            SubmitStage(StreamStage::Io, state->cpuTextures, textureData, [relativePath, &textureData]()->void {
+                StoreCpuTexture(textureData, Importer::ImportImage(Path::ForReadWrite(relativePath)));
+            });
+        } else if (extension == ".png" || extension == ".jpg" || extension == ".jpeg")
+        {
+#if defined(__DESKTOP__)
+            // Each texture decodes on its own job, So a model's textures are compressed in parallel on the first run
+            Importer::ImportTextureOptions options {.usage = usage};
+#else
+            // Mobile gpus do not sample BC formats
+            Importer::ImportTextureOptions options {};
+#endif
+            SubmitStage(StreamStage::Io, state->cpuTextures, textureData, [relativePath, &textureData, options]()->void {
+                auto const path = Path::ForReadWrite(relativePath);
+
+                // Up to date compressed cache needs no decoding
+                if (options.usage != AS::TextureUsage::Generic)
                 {
-                    MFA_NOT_IMPLEMENTED_YET("Mohammad Fakhreddin");
+                    auto cachedTexture = Importer::ImportCompressedImageCache(path, options.usage);
+                    if (cachedTexture != nullptr)
+                    {
+                        StoreCpuTexture(textureData, cachedTexture);
+                        return;
+                    }
                 }
 
-                SCOPE_LOCK(textureData.lock)
-
-                textureData.data = texture;
-
-                for (auto & callback : textureData.callbacks)
+                auto decodeOptions = options;
+                auto const rawFile = Importer::ReadRawFile(path);
+                if (rawFile.data != nullptr && rawFile.valid())
                 {
-                    callback(texture);
+                    decodeOptions.fileData = rawFile.data;
                 }
 
-                textureData.callbacks.clear();
-
+                SubmitStage(StreamStage::Decode, state->cpuTextures, textureData, [path, &textureData, decodeOptions]()->void {
+                    StoreCpuTexture(textureData, Importer::ImportImage(path, decodeOptions));
+                });
+            });
+        } else if (relativePath == "Error")
+        {
+            SubmitStage(StreamStage::Decode, state->cpuTextures, textureData, [&textureData]()->void {
+                StoreCpuTexture(textureData, Importer::CreateErrorTexture());
             });
+        } else
+        {
+            MFA_NOT_IMPLEMENTED_YET("Mohammad Fakhreddin");
         }
     }
     
     //-------------------------------------------------------------------------------------------------
 
     static void CreateEssence(
+        EssenceCache::Entry & essenceData,
         BasePipeline * pipeline,
         std::string const & nameId,
         std::shared_ptr<AS::Model> const & cpuModel,
         std::vector<std::shared_ptr<RT::GpuTexture>> const & gpuTextures
     )
     {
-        SceneManager::AssignMainThreadTask([pipeline, nameId, cpuModel, gpuTextures]()->void{
+        SubmitStage(StreamStage::Upload, state->essences, essenceData, [&essenceData, pipeline, nameId, cpuModel, gpuTextures]()->void{
 
             auto const essence = pipeline->CreateEssence(nameId, cpuModel, gpuTextures);
 
-            auto & essenceData = state->essences[nameId];
-
-            SCOPE_LOCK(essenceData.lock)
-
-            essenceData.data = essence;
-
-            bool const success = essence != nullptr;
-
-            for (auto & callback : essenceData.callbacks)
-            {
-                callback(success);
-            }
-
-            essenceData.callbacks.clear();
+            auto const callbacks = state->essences.Store(essenceData, essence, 0);
+            InvokeCallbacks(callbacks, essence != nullptr);
         });
     }
 
@@ -410,50 +1000,45 @@ namespace MFA::ResourceManager
         std::string const & path,
         BasePipeline * pipeline,
         EssenceCallback const & callback,
-        bool loadFromFile
+        bool loadFromFile,
+        RequestPtr const & request
     )
     {
         MFA_ASSERT(path.length() > 0);
         MFA_ASSERT(pipeline != nullptr);
         MFA_ASSERT(callback != nullptr);
 
-        std::shared_ptr<EssenceBase> essence = nullptr;
-
         auto const nameId = Path::RelativeToAssetFolder(path);
 
-        auto & essenceData = state->essences[nameId];
+        auto & essenceData = state->essences.GetEntry(nameId);
 
-        bool shouldAssignTask;
+        bool shouldAssignTask = false;
+        if (AcquireFromCache(state->essences, essenceData, callback, request, true, shouldAssignTask) != nullptr)
         {
-            SCOPE_LOCK(essenceData.lock)
-
-            essence = essenceData.data.lock();
-
-            if (essence != nullptr)
-            {
-                callback(true);
-                return;
-            }
-
-            essence = pipeline->GetEssence(nameId);
+            callback(true);
+            return;
+        }
 
+        if (shouldAssignTask)
+        {
+            // Pipeline may already have the essence
+            auto const essence = pipeline->GetEssence(nameId);
             if (essence != nullptr)
             {
-                essenceData.data = essence;
-                callback(true);
+                auto const callbacks = state->essences.Store(essenceData, essence, 0);
+                InvokeCallbacks(callbacks, true);
                 return;
             }
-
-            essenceData.callbacks.emplace_back(callback);
-
-            shouldAssignTask = essenceData.callbacks.size() == 1;
         }
 
         if (shouldAssignTask)
         {
+            // Model and textures follow the priority of the essence requests
+            auto const dependencyRequest = MakeDependencyRequest(state->essences, essenceData);
+
             RC::AcquireCpuModel(
                 nameId,
-                [nameId, pipeline, loadFromFile]
+                [&essenceData, nameId, pipeline, loadFromFile, dependencyRequest]
                 (std::shared_ptr<AS::Model> const & cpuModel)->void {
 
                     MFA_ASSERT(cpuModel != nullptr);
@@ -468,8 +1053,8 @@ namespace MFA::ResourceManager
                         auto taskTracker = std::make_shared<JS::TaskTracker1<Data>>(
                             std::make_shared<Data>(),
                             static_cast<int>(cpuModel->textureIds.size()),
-                            [pipeline, nameId, cpuModel](Data const * userData)->void {
-                                CreateEssence(pipeline, nameId, cpuModel, userData->gpuTextures);
+                            [&essenceData, pipeline, nameId, cpuModel](Data const * userData)->void {
+                                CreateEssence(essenceData, pipeline, nameId, cpuModel, userData->gpuTextures);
                             }
                         );
                         
@@ -482,26 +1067,139 @@ namespace MFA::ResourceManager
                                 [taskTracker, i](std::shared_ptr<RT::GpuTexture> const & gpuTexture)->void {
                                     taskTracker->userData->gpuTextures[i] = gpuTexture;
                                     taskTracker->onComplete();
-                                }, loadFromFile
+                                },
+                                loadFromFile,
+                                i < cpuModel->textureUsages.size() ? cpuModel->textureUsages[i] : AS::TextureUsage::Generic,
+                                dependencyRequest
                             );
                         }
                     }
                     else
                     {
-                        CreateEssence(pipeline, nameId, cpuModel, {});
+                        CreateEssence(essenceData, pipeline, nameId, cpuModel, {});
                     }
-                }, loadFromFile
+                },
+                loadFromFile,
+                dependencyRequest
             );
         }
     }
     
     //-------------------------------------------------------------------------------------------------
 
+    static void OnPhysicsMeshCooked(
+        PhysicsMeshCache::Entry & meshData,
+        std::string const & nameId,
+        Physics::MeshCache::CookedMeshList const & cookedMeshes
+    )
+    {
+        auto const meshGroup = std::make_shared<Physics::TriangleMeshGroup>();
+
+        // Cooked data is a close estimate of the memory that physx allocates for the meshes
+        size_t sizeBytes = 0;
+        for (auto const & cookedMesh : cookedMeshes)
+        {
+            Physics::SharedHandle<physx::PxTriangleMesh> triangleMesh = nullptr;
+            if (cookedMesh != nullptr)
+            {
+                triangleMesh = Physics::CreateTriangleMesh(cookedMesh->memory);
+                sizeBytes += cookedMesh->memory.len;
+            }
+
+            if (triangleMesh != nullptr)
+            {
+                meshGroup->triangleMeshes.emplace_back(triangleMesh);
+            } else
+            {
+                MFA_LOG(Warning, Asset, "Failed to create triangle mesh for one of the descriptions of %s", nameId.c_str());
+            }
+        }
+
+        auto const callbacks = state->physicsMeshes.Store(meshData, meshGroup, sizeBytes);
+        InvokeCallbacks(callbacks, meshGroup);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Each mesh description is cooked on a separate job, Result is stored on disk so next time we only deserialize
+    static void CookPhysicsMeshes(
+        PhysicsMeshCache::Entry & meshData,
+        Physics::MeshCache::Key const & cacheKey,
+        std::vector<Physics::TriangleMeshDesc> const & meshDescList
+    )
+    {
+        struct Data
+        {
+            std::vector<Physics::TriangleMeshDesc> meshDescList {};
+            Physics::MeshCache::CookedMeshList cookedMeshes {};
+        };
+        auto data = std::make_shared<Data>();
+        data->meshDescList = meshDescList;
+        data->cookedMeshes.resize(meshDescList.size());
+
+        auto const onFinish = [&meshData, cacheKey, data]()->void
+        {
+            bool allMeshesAreCooked = true;
+            for (auto const & cookedMesh : data->cookedMeshes)
+            {
+                allMeshesAreCooked &= cookedMesh != nullptr;
+            }
+
+            if (allMeshesAreCooked)
+            {
+                Physics::MeshCache::Save(cacheKey, data->cookedMeshes);
+            }
+
+            OnPhysicsMeshCooked(meshData, cacheKey.modelPath, data->cookedMeshes);
+        };
+
+        if (data->meshDescList.empty())
+        {
+            onFinish();
+            return;
+        }
+
+        std::vector<JS::Task> tasks {};
+        for (size_t i = 0; i < data->meshDescList.size(); ++i)
+        {
+            tasks.emplace_back([data, i, nameId = cacheKey.modelPath](JS::ThreadNumber, JS::ThreadNumber)->void
+            {
+                auto const & meshDesc = data->meshDescList[i];
+
+                physx::PxTriangleMeshDesc pxMeshDesc;
+                pxMeshDesc.setToDefault();
+                pxMeshDesc.triangles.count = meshDesc.trianglesCount;
+                pxMeshDesc.triangles.stride = meshDesc.trianglesStride;
+                pxMeshDesc.triangles.data = meshDesc.triangleBuffer->memory.ptr;
+
+                pxMeshDesc.points.count = meshDesc.pointsCount;
+                pxMeshDesc.points.stride = meshDesc.pointsStride;
+                pxMeshDesc.points.data = meshDesc.pointsBuffer->memory.ptr;
+
+                // https://docs.nvidia.com/gameworks/content/gameworkslibrary/physx/guide/Manual/Startup.html#startup
+                // mesh should be validated before cooking without the mesh cleaning
+                if (Physics::ValidateTriangleMesh(pxMeshDesc) == false)
+                {
+                    MFA_LOG(Warning, Asset, "Validation of mesh with name %s failed", nameId.c_str());
+                }
+
+                data->cookedMeshes[i] = Physics::CookTriangleMesh(pxMeshDesc);
+            });
+        }
+
+        JS::AssignTask(tasks, onFinish);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Cooked meshes are read from the disk cache on the io stage and turned into physx meshes on the decode stage.
+    // On a cache miss the model is loaded and cooked first.
     void AcquirePhysicsMesh(
         std::string const & path,
         bool const isConvex,            // Is not used for now
         PhysicsMeshCallback const & callback,
-        bool const loadFromFile
+        bool const loadFromFile,
+        RequestPtr const & request
     )
     {
         MFA_ASSERT(path.empty() == false);
@@ -509,81 +1207,56 @@ namespace MFA::ResourceManager
 
         std::string const nameId = Path::RelativeToAssetFolder(path);
 
-        auto & meshMap = state->physicsMeshes;
-        auto & meshData = meshMap[nameId];
+        auto & meshData = state->physicsMeshes.GetEntry(nameId);
 
-        bool shouldAssignTask;
+        bool shouldAssignTask = false;
+        auto const physicsMesh = AcquireFromCache(
+            state->physicsMeshes,
+            meshData,
+            callback,
+            request,
+            true,
+            shouldAssignTask
+        );
+        if (physicsMesh != nullptr)
         {
-            SCOPE_LOCK(meshData.lock)
-            auto const physicsMesh = meshData.data.lock();
-            if (physicsMesh != nullptr)
-            {
-                callback(physicsMesh);
-                return;
-            }
-            meshData.callbacks.emplace_back(callback);
-            shouldAssignTask = meshData.callbacks.size() == 1;
+            callback(physicsMesh);
+            return;
         }
 
         if (shouldAssignTask)
         {
-            AcquireCpuModel(
-                nameId,
-                [isConvex, &meshData, nameId](std::shared_ptr<AS::Model> const & cpuModel)->void{
-
-                    auto const & mesh = cpuModel->mesh;
+            SubmitStage(StreamStage::Io, state->physicsMeshes, meshData, [&meshData, nameId, loadFromFile]()->void
+            {
+                Physics::MeshCache::Key const cacheKey {
+                    .modelPath = nameId,
+                    .meshType = Physics::MeshCache::MeshType::Triangle
+                };
 
-                    mesh->PreparePhysicsPoints([mesh, isConvex, &meshData, nameId](std::vector<Physics::TriangleMeshDesc> const & meshDescList)->void{
+                auto cookedMeshes = std::make_shared<Physics::MeshCache::CookedMeshList>();
+                if (Physics::MeshCache::Load(cacheKey, *cookedMeshes))
+                {
+                    SubmitStage(StreamStage::Decode, state->physicsMeshes, meshData, [&meshData, nameId, cookedMeshes]()->void
+                    {
+                        OnPhysicsMeshCooked(meshData, nameId, *cookedMeshes);
+                    });
+                    return;
+                }
 
-                        auto const meshGroup = std::make_shared<Physics::TriangleMeshGroup>();
+                AcquireCpuModel(
+                    nameId,
+                    [&meshData, cacheKey](std::shared_ptr<AS::Model> const & cpuModel)->void{
 
-                        for (auto const & meshDesc : meshDescList)
-                        {
-                            physx::PxTriangleMeshDesc pxMeshDesc;
-                            pxMeshDesc.setToDefault();
-                            pxMeshDesc.triangles.count = meshDesc.trianglesCount;
-                            pxMeshDesc.triangles.stride = meshDesc.trianglesStride;
-                            pxMeshDesc.triangles.data = meshDesc.triangleBuffer->memory.ptr;
-
-                            pxMeshDesc.points.count = meshDesc.pointsCount;
-                            pxMeshDesc.points.stride = meshDesc.pointsStride;
-                            pxMeshDesc.points.data = meshDesc.pointsBuffer->memory.ptr;
-
-                            //if (isConvex)
-                            //{
-                            //    meshDesc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX;
-                            //}
-
-                            // https://docs.nvidia.com/gameworks/content/gameworkslibrary/physx/guide/Manual/Startup.html#startup
-                            // mesh should be validated before cooking without the mesh cleaning
-                            //MFA_ASSERT(Physics::ValidateTriangleMesh(meshDesc));
-                            if (Physics::ValidateTriangleMesh(pxMeshDesc))
-                            {
-                                MFA_LOG_WARN("Validation of mesh with name %s failed", nameId.c_str());
-                            }
-                            
-                            auto const triangleMesh = Physics::CreateTriangleMesh(pxMeshDesc);
-
-                            if (triangleMesh != nullptr)
-                            {
-                                meshGroup->triangleMeshes.emplace_back(triangleMesh);
-                            } else
-                            {
-                                MFA_LOG_WARN("Failed to create triangle mesh for one of the descriptions");
-                            }
-                        }
+                        auto const & mesh = cpuModel->mesh;
 
-                        SCOPE_LOCK(meshData.lock)
-                        meshData.data = meshGroup;
-                        for (auto const & callback : meshData.callbacks)
-                        {
-                            callback(meshGroup);
-                        }
-                        meshData.callbacks.clear();
-                    });
-                },
-                loadFromFile
-            );
+                        mesh->PreparePhysicsPoints([mesh, &meshData, cacheKey](std::vector<Physics::TriangleMeshDesc> const & meshDescList)->void{
+                            CookPhysicsMeshes(meshData, cacheKey, meshDescList);
+                        });
+                    },
+                    loadFromFile,
+                    MakeDependencyRequest(state->physicsMeshes, meshData)
+                );
+            });
         }
     }
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "MipResidency.hpp"
+#include "ResourceCache.hpp"
+#include "StreamingScheduler.hpp"
 #include "engine/render_system/RenderTypesFWD.hpp"
 
 #include <memory>
@@ -27,24 +30,106 @@ namespace MFA::AssetSystem
 
 namespace MFA::ResourceManager
 {
-    void Init();
+    struct InitParams
+    {
+        size_t cpuBudgetBytes = 512 * 1024 * 1024;     // Models, Cpu textures and physics meshes
+        size_t gpuBudgetBytes = 512 * 1024 * 1024;     // Gpu textures, Streamed textures only count their tails
+        uint32_t maxIoJobs = 2;                         // Files that are read at the same time
+        uint32_t maxDecodeJobs = 4;                     // Assets that are decoded at the same time
+        float uploadBudgetMs = 2.0f;                    // Main thread time per frame for creating gpu resources
+        size_t mipStreamBudgetBytes = 256 * 1024 * 1024;   // Streamed texture mips above the tails
+        uint32_t textureTailSize = 64;                  // Mips this size or smaller are always resident
+        uint32_t maxPendingMipChanges = 8;              // Texture promotions that load at the same time
+    };
+
+    void Init(InitParams const & params = {});
     void Shutdown();
 
+    // Creates gpu resources of finished loads until the upload budget of the frame is spent.
+    // Must be called from the main thread once per frame.
+    void Update();
+
+    [[nodiscard]]
+    StreamStats GetStreamStats();
+
+    void SetUploadBudget(float budgetMs);
+
+    [[nodiscard]]
+    float GetUploadBudget();
+
+    // Gpu textures start with only their tail, Larger mips stream in when renderers ask for them.
+    // screenPixels is the size of the textured object on the screen. Must be called from the main thread each frame
+    // for each visible user of the texture, Textures that are not streamed are ignored.
+    void RequestTextureMips(RT::GpuTexture const & texture, float screenPixels);
+
+    [[nodiscard]]
+    MipResidencyStats GetMipStreamStats();
+
+    // Mips above the new budget are dropped on the next update, Least recently requested textures first
+    void SetMipStreamBudget(size_t budgetBytes);
+
+    enum class CacheType : uint8_t
+    {
+        CpuModel = 0,
+        CpuTexture = 1,
+        GpuTexture = 2,
+        PhysicsMesh = 3,
+        Essence = 4,
+        Count
+    };
+
+    enum class BudgetType : uint8_t
+    {
+        Cpu = 0,
+        Gpu = 1,
+        Count
+    };
+
+    [[nodiscard]]
+    CacheStats GetCacheStats(CacheType cacheType);
+
+    [[nodiscard]]
+    char const * CacheTypeName(CacheType cacheType);
+
+    [[nodiscard]]
+    BudgetStats GetBudgetStats(BudgetType budgetType);
+
+    // Unused assets above the new budget are evicted right away
+    void SetBudget(BudgetType budgetType, size_t budgetBytes);
+
+    // Evicts unused assets until every budget is met, For example after a scene is unloaded
+    void Trim();
+
+    using EvictionListener = std::function<void(std::string const & id)>;
+
+    // Listener is called on the thread that evicted the asset
+    SignalId RegisterEvictionListener(CacheType cacheType, EvictionListener const & listener);
+
+    bool UnRegisterEvictionListener(CacheType cacheType, SignalId listenerId);
+
+    // Every acquire function takes an optional request. Its priority orders the load in each streaming stage,
+    // Cancelling it drops the callback, So owners cancel their requests before they are destroyed.
+    using RequestPtr = std::shared_ptr<StreamRequest>;
+
     using CpuModelCallback = std::function<void(std::shared_ptr<AssetSystem::Model> const & cpuModel)>;
 
     // Note: No need to use Path, This function does load textures data.
     void AcquireCpuModel(
         std::string const & modelId,
         CpuModelCallback const & callback,
-        bool loadFromFile = true
+        bool loadFromFile = true,
+        RequestPtr const & request = nullptr
     );
 
     using GpuTextureCallback = std::function<void(std::shared_ptr<RT::GpuTexture> const & gpuTexture)>;
 
+    // Usage picks the block compression of png and jpeg images on desktop, See Importer::ImportCompressedImage
     void AcquireGpuTexture(
         std::string const & textureId,
         GpuTextureCallback const & callback,
-        bool loadFromFile = true
+        bool loadFromFile = true,
+        AssetSystem::TextureUsage usage = AssetSystem::TextureUsage::Generic,
+        RequestPtr const & request = nullptr
     );
 
     using CpuTextureCallback = std::function<void(std::shared_ptr<AssetSystem::Texture> const & cpuTexture)>;
@@ -52,7 +137,9 @@ namespace MFA::ResourceManager
     void AcquireCpuTexture(
         std::string const & textureId,
         CpuTextureCallback const & callback,
-        bool loadFromFile = true
+        bool loadFromFile = true,
+        AssetSystem::TextureUsage usage = AssetSystem::TextureUsage::Generic,
+        RequestPtr const & request = nullptr
     );
 
     using EssenceCallback = std::function<void(bool success)>;
@@ -62,7 +149,8 @@ namespace MFA::ResourceManager
         std::string const & nameId,
         BasePipeline * pipeline,
         EssenceCallback const & callback,
-        bool loadFromFile = true
+        bool loadFromFile = true,
+        RequestPtr const & request = nullptr
     );
 
     using PhysicsMeshCallback = std::function<void(std::shared_ptr<Physics::TriangleMeshGroup> const & meshGroup)>;
@@ -71,7 +159,8 @@ namespace MFA::ResourceManager
         std::string const & path,
         bool isConvex,                                  // Convex is not yet supported
         PhysicsMeshCallback const & callback,
-        bool loadFromFile = true
+        bool loadFromFile = true,
+        RequestPtr const & request = nullptr
     );
 
 }
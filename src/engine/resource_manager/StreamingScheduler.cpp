@@ -0,0 +1,299 @@
+#include "StreamingScheduler.hpp"
+
+#include "engine/BedrockAssert.hpp"
+#include "engine/job_system/ScopeLock.hpp"
+
+#include <chrono>
+
+namespace MFA::ResourceManager
+{
+
+    //-------------------------------------------------------------------------------------------------
+
+    char const * StreamStageName(StreamStage const stage)
+    {
+        switch (stage)
+        {
+        case StreamStage::Io:
+            return "Io";
+        case StreamStage::Decode:
+            return "Decode";
+        case StreamStage::Upload:
+            return "Upload";
+        default:
+            MFA_ASSERT(false);
+            return "";
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StreamRequest::StreamRequest(float const priority)
+        : mPriority(priority)
+    {}
+
+    //-------------------------------------------------------------------------------------------------
+
+    void StreamRequest::SetPriority(float const priority)
+    {
+        mPriority.store(priority, std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    float StreamRequest::GetPriority() const
+    {
+        return mPriority.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void StreamRequest::Cancel()
+    {
+        mIsCancelled.store(true, std::memory_order_release);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool StreamRequest::IsCancelled() const
+    {
+        return mIsCancelled.load(std::memory_order_acquire);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    float ComputeStreamPriority(float const screenSize, bool const isInFrustum)
+    {
+        return screenSize + (isInFrustum ? 1.0f : 0.0f);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StreamingScheduler::StreamingScheduler(Params const & params, Dispatcher dispatcher)
+        : mDispatcher(std::move(dispatcher))
+        , mUploadBudgetMs(params.uploadBudgetMs)
+    {
+        MFA_ASSERT(mDispatcher != nullptr);
+        MFA_ASSERT(params.maxIoJobs > 0);
+        MFA_ASSERT(params.maxDecodeJobs > 0);
+        mStages[static_cast<int>(StreamStage::Io)].maxRunningCount = params.maxIoJobs;
+        mStages[static_cast<int>(StreamStage::Decode)].maxRunningCount = params.maxDecodeJobs;
+        // Main thread runs uploads one by one
+        mStages[static_cast<int>(StreamStage::Upload)].maxRunningCount = 1;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StreamingScheduler::~StreamingScheduler()
+    {
+        // Worker jobs hold a pointer to the scheduler
+        for (auto const & stage : mStages)
+        {
+            MFA_ASSERT(stage.runningCount == 0);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void StreamingScheduler::Submit(StreamStage const stage, StreamJob && job)
+    {
+        MFA_ASSERT(stage < StreamStage::Count);
+        MFA_ASSERT(job.run != nullptr);
+        {
+            SCOPE_LOCK(mLock)
+            mStages[static_cast<int>(stage)].pendingJobs.emplace_back(std::move(job));
+        }
+        if (stage != StreamStage::Upload)
+        {
+            dispatchPending(stage);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t StreamingScheduler::RunUploads()
+    {
+        using Clock = std::chrono::steady_clock;
+
+        auto const startTime = Clock::now();
+        auto const budgetMs = mUploadBudgetMs.load(std::memory_order_relaxed);
+        auto & stage = mStages[static_cast<int>(StreamStage::Upload)];
+
+        uint32_t ranCount = 0;
+        float elapsedMs = 0.0f;
+        while (ranCount == 0 || elapsedMs < budgetMs)
+        {
+            StreamJob job {};
+            std::vector<StreamJob> cancelledJobs {};
+            bool hasJob = false;
+            {
+                SCOPE_LOCK(mLock)
+                hasJob = popHighestPriority(stage, job, cancelledJobs);
+            }
+            // Captures of cancelled jobs are released outside of the lock
+            cancelledJobs.clear();
+            if (hasJob == false)
+            {
+                break;
+            }
+
+            job.run();
+            ++ranCount;
+            mCompletedCount.fetch_add(1, std::memory_order_relaxed);
+
+            elapsedMs = std::chrono::duration<float, std::milli>(Clock::now() - startTime).count();
+        }
+
+        mLastUploadMs.store(elapsedMs, std::memory_order_relaxed);
+        return ranCount;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void StreamingScheduler::SetUploadBudget(float const budgetMs)
+    {
+        MFA_ASSERT(budgetMs >= 0.0f);
+        mUploadBudgetMs.store(budgetMs, std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    float StreamingScheduler::GetUploadBudget() const
+    {
+        return mUploadBudgetMs.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    StreamStats StreamingScheduler::GetStats() const
+    {
+        StreamStats stats {};
+        {
+            SCOPE_LOCK(mLock)
+            for (int i = 0; i < static_cast<int>(StreamStage::Count); ++i)
+            {
+                stats.pendingCount[i] = static_cast<uint32_t>(mStages[i].pendingJobs.size());
+                stats.runningCount[i] = mStages[i].runningCount;
+            }
+        }
+        stats.completedCount = mCompletedCount.load(std::memory_order_relaxed);
+        stats.cancelledCount = mCancelledCount.load(std::memory_order_relaxed);
+        stats.lastUploadMs = mLastUploadMs.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool StreamingScheduler::IsIdle() const
+    {
+        auto const stats = GetStats();
+        for (int i = 0; i < static_cast<int>(StreamStage::Count); ++i)
+        {
+            if (stats.pendingCount[i] > 0 || stats.runningCount[i] > 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool StreamingScheduler::popHighestPriority(
+        Stage & stage,
+        StreamJob & outJob,
+        std::vector<StreamJob> & outCancelledJobs
+    )
+    {
+        auto & pendingJobs = stage.pendingJobs;
+
+        // Linear search, Priorities can change at any time so a heap would go stale
+        int bestIndex = -1;
+        float bestPriority = 0.0f;
+        for (int i = 0; i < static_cast<int>(pendingJobs.size());)
+        {
+            auto & job = pendingJobs[i];
+            if (job.isCancelled != nullptr && job.isCancelled())
+            {
+                outCancelledJobs.emplace_back(std::move(job));
+                job = std::move(pendingJobs.back());
+                pendingJobs.pop_back();
+                if (bestIndex == static_cast<int>(pendingJobs.size()))
+                {
+                    bestIndex = i;      // Best job was moved into this slot
+                }
+                continue;
+            }
+
+            auto const priority = job.getPriority != nullptr ? job.getPriority() : StreamRequest::DefaultPriority;
+            if (bestIndex < 0 || priority > bestPriority)
+            {
+                bestIndex = i;
+                bestPriority = priority;
+            }
+            ++i;
+        }
+
+        mCancelledCount.fetch_add(outCancelledJobs.size(), std::memory_order_relaxed);
+
+        if (bestIndex < 0)
+        {
+            return false;
+        }
+
+        outJob = std::move(pendingJobs[bestIndex]);
+        pendingJobs[bestIndex] = std::move(pendingJobs.back());
+        pendingJobs.pop_back();
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void StreamingScheduler::dispatchPending(StreamStage const stage)
+    {
+        auto & stageData = mStages[static_cast<int>(stage)];
+
+        std::vector<StreamJob> jobs {};
+        std::vector<StreamJob> cancelledJobs {};
+        {
+            SCOPE_LOCK(mLock)
+            while (stageData.runningCount < stageData.maxRunningCount)
+            {
+                StreamJob job {};
+                if (popHighestPriority(stageData, job, cancelledJobs) == false)
+                {
+                    break;
+                }
+                ++stageData.runningCount;
+                jobs.emplace_back(std::move(job));
+            }
+        }
+        cancelledJobs.clear();
+
+        for (auto & job : jobs)
+        {
+            mDispatcher([this, stage, run = std::move(job.run)]()->void
+            {
+                run();
+                onWorkerJobFinished(stage);
+            });
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void StreamingScheduler::onWorkerJobFinished(StreamStage const stage)
+    {
+        mCompletedCount.fetch_add(1, std::memory_order_relaxed);
+        {
+            SCOPE_LOCK(mLock)
+            auto & stageData = mStages[static_cast<int>(stage)];
+            MFA_ASSERT(stageData.runningCount > 0);
+            --stageData.runningCount;
+        }
+        dispatchPending(stage);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace MFA::ResourceManager
+{
+
+    // Every load goes through the stages in order, Stages that an asset does not need are skipped.
+    enum class StreamStage : uint8_t
+    {
+        Io = 0,             // Reading files, Worker threads
+        Decode = 1,         // Parsing, Decompressing and compressing, Worker threads
+        Upload = 2,         // Gpu resource creation, Main thread within the frame budget
+        Count
+    };
+
+    [[nodiscard]]
+    char const * StreamStageName(StreamStage stage);
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Handle that the owner of a load keeps, Priority can be changed until the load finishes.
+    // Higher priority loads are picked first by every stage.
+    class StreamRequest
+    {
+    public:
+
+        static constexpr float DefaultPriority = 0.0f;
+
+        explicit StreamRequest(float priority = DefaultPriority);
+        virtual ~StreamRequest() = default;
+
+        StreamRequest(StreamRequest const &) noexcept = delete;
+        StreamRequest(StreamRequest &&) noexcept = delete;
+        StreamRequest & operator = (StreamRequest const &) noexcept = delete;
+        StreamRequest & operator = (StreamRequest &&) noexcept = delete;
+
+        void SetPriority(float priority);
+
+        [[nodiscard]]
+        virtual float GetPriority() const;
+
+        // Callback of a cancelled request is never called, The load itself stops when all of its requests are cancelled
+        void Cancel();
+
+        [[nodiscard]]
+        virtual bool IsCancelled() const;
+
+    private:
+
+        std::atomic<float> mPriority;
+        std::atomic<bool> mIsCancelled = false;
+
+    };
+
+    // Visible objects come first, Then the ones that cover more of the screen.
+    // Screen size already accounts for the distance to the camera, See BoundingVolumeComponent::GetScreenSize
+    [[nodiscard]]
+    float ComputeStreamPriority(float screenSize, bool isInFrustum);
+
+    //-------------------------------------------------------------------------------------------------
+
+    struct StreamJob
+    {
+        std::function<float()> getPriority = nullptr;       // Evaluated each time the stage picks its next job
+        std::function<bool()> isCancelled = nullptr;        // Cancelled jobs are dropped without running
+        std::function<void()> run = nullptr;
+    };
+
+    struct StreamStats
+    {
+        uint32_t pendingCount[static_cast<int>(StreamStage::Count)] {};
+        uint32_t runningCount[static_cast<int>(StreamStage::Count)] {};
+        uint64_t completedCount = 0;
+        uint64_t cancelledCount = 0;
+        float lastUploadMs = 0.0f;                          // Main thread time of the last RunUploads
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Priority queue per stage with a limit on the number of jobs that run at the same time.
+    // Io and decode jobs are handed to the dispatcher as soon as a slot is free,
+    // Upload jobs only run inside RunUploads on the main thread.
+    class StreamingScheduler
+    {
+    public:
+
+        using Work = std::function<void()>;
+        using Dispatcher = std::function<void(Work const & work)>;
+
+        struct Params
+        {
+            uint32_t maxIoJobs = 2;
+            uint32_t maxDecodeJobs = 4;
+            float uploadBudgetMs = 2.0f;        // Per RunUploads call
+        };
+
+        explicit StreamingScheduler(Params const & params, Dispatcher dispatcher);
+        ~StreamingScheduler();
+
+        StreamingScheduler(StreamingScheduler const &) noexcept = delete;
+        StreamingScheduler(StreamingScheduler &&) noexcept = delete;
+        StreamingScheduler & operator = (StreamingScheduler const &) noexcept = delete;
+        StreamingScheduler & operator = (StreamingScheduler &&) noexcept = delete;
+
+        // Thread safe, Jobs can submit their next stage from inside run
+        void Submit(StreamStage stage, StreamJob && job);
+
+        // Runs upload jobs in priority order until the budget is spent, Returns the number of jobs that ran.
+        // The first job always runs so uploads make progress even when a single one is over the budget.
+        uint32_t RunUploads();
+
+        void SetUploadBudget(float budgetMs);
+
+        [[nodiscard]]
+        float GetUploadBudget() const;
+
+        [[nodiscard]]
+        StreamStats GetStats() const;
+
+        // No job is waiting or running
+        [[nodiscard]]
+        bool IsIdle() const;
+
+    private:
+
+        struct Stage
+        {
+            std::vector<StreamJob> pendingJobs {};
+            uint32_t runningCount = 0;
+            uint32_t maxRunningCount = 0;
+        };
+
+        // Must be called while holding the lock, Cancelled jobs that are found on the way are moved to outCancelledJobs
+        bool popHighestPriority(Stage & stage, StreamJob & outJob, std::vector<StreamJob> & outCancelledJobs);
+
+        void dispatchPending(StreamStage stage);
+
+        void onWorkerJobFinished(StreamStage stage);
+
+        Dispatcher const mDispatcher;
+
+        Stage mStages[static_cast<int>(StreamStage::Count)] {};        // Guarded by mLock
+        mutable std::atomic<bool> mLock = false;
+
+        std::atomic<float> mUploadBudgetMs;
+        std::atomic<uint64_t> mCompletedCount {0};
+        std::atomic<uint64_t> mCancelledCount {0};
+        std::atomic<float> mLastUploadMs {0.0f};
+
+    };
+
+}
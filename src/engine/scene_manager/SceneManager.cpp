@@ -2,6 +2,7 @@
 
 #include "engine/BedrockAssert.hpp"
 #include "engine/BedrockMatrix.hpp"
+#include "engine/BedrockMemory.hpp"
 #include "engine/BedrockSignal.hpp"
 #include "engine/camera/CameraComponent.hpp"
 #include "engine/entity_system/EntitySystem.hpp"
@@ -13,7 +14,9 @@
 #include "engine/render_system/pipelines/BasePipeline.hpp"
 #include "engine/render_system/render_passes/display_render_pass/DisplayRenderPass.hpp"
 #include "engine/scene_manager/Scene.hpp"
+#include "engine/scene_manager/SpatialIndex.hpp"
 #include "engine/render_system/RenderBackend.hpp"
+#include "engine/resource_manager/ResourceManager.hpp"
 
 namespace MFA::SceneManager
 {
@@ -99,6 +102,7 @@ namespace MFA::SceneManager
         int UI_RecordListenerId = 0;
 
         RT::ResizeEventListenerId resizeListenerId = 0;
+        RT::RenderQualityEventListenerId renderQualityListenerId = 0;
         float currentFps = 0.0f;
 
         std::unordered_map<std::string, std::unique_ptr<BasePipeline>> pipelines{};
@@ -206,6 +210,7 @@ namespace MFA::SceneManager
         state->displayRenderPass = RF::GetDisplayRenderPass();
 
         state->resizeListenerId = RF::AddResizeEventListener([]()->void { OnResize(); });
+        state->renderQualityListenerId = RF::AddRenderQualityEventListener([]()->void { OnRenderQualityChanged(); });
         if (state->activeSceneIndex < 0 && false == state->registeredScenes.empty())
         {
             state->activeSceneIndex = 0;
@@ -227,10 +232,6 @@ namespace MFA::SceneManager
         {
             UI::PostRender(deltaTime);
         });
-        state->updateSignal.Register([](float const deltaTime)->void
-        {
-            EntitySystem::Update(deltaTime);
-        });
         
 
         
@@ -271,6 +272,7 @@ namespace MFA::SceneManager
         PlayQueuedTasks();
     
         RF::RemoveResizeEventListener(state->resizeListenerId);
+        RF::RemoveRenderQualityEventListener(state->renderQualityListenerId);
 
         if (state->activeScene != nullptr)
         {
@@ -498,6 +500,32 @@ namespace MFA::SceneManager
 
     //-------------------------------------------------------------------------------------------------
 
+    // Bounding volumes have their final bounds for this frame, Each pass below runs once for the whole scene
+    static void updateVisibility()
+    {
+        auto & spatialIndex = GetSpatialIndex();
+        spatialIndex.Refit();
+
+        auto const activeCamera = GetActiveCamera().lock();
+        if (activeCamera == nullptr)
+        {
+            return;
+        }
+        spatialIndex.CullFrustum(activeCamera->GetFrustum());
+
+        // Light range needs the frustum result because lights can be attached to a mesh
+        for (auto const & pointLightComponent : state->pointLightComponents)
+        {
+            auto const ptr = pointLightComponent.lock();
+            if (ptr != nullptr && ptr->IsVisible())
+            {
+                ptr->UpdateObjectsInRange(spatialIndex);
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void Update(float const deltaTime)
     {
         MFA_ASSERT(JS::IsMainThread());
@@ -509,7 +537,17 @@ namespace MFA::SceneManager
 
         PlayQueuedTasks();
 
+        // Gpu side of asset loads, Limited by the upload budget so loading does not cause frame spikes
+        RC::Update();
+
+        // Entity system runs on the main thread because it has to wait for each system to finish before the next one
+        EntitySystem::Update(deltaTime);
+
         state->updateSignal.EmitMultiThread(deltaTime);
+
+        EntitySystem::DestroyQueuedEntities();
+
+        updateVisibility();
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -614,6 +652,7 @@ namespace MFA::SceneManager
     )
     {
         RF::BeginGraphicCommandBuffer(recordState);
+        RF::BeginFrameTimer(recordState);
 
         // Pre render
         updateCameraBuffer(recordState);
@@ -629,10 +668,16 @@ namespace MFA::SceneManager
         state->renderSignal2.Emit(recordState, deltaTime);
         state->renderSignal3.Emit(recordState, deltaTime);
 
+        state->displayRenderPass->EndRenderPass(recordState);
+
+        // Ui is drawn at full resolution on top of the upscaled scene
+        state->displayRenderPass->BeginPresentPass(recordState);
+
         UI::Render(deltaTime, recordState);
 
-        state->displayRenderPass->EndRenderPass(recordState);
+        state->displayRenderPass->EndPresentPass(recordState);
 
+        RF::EndFrameTimer(recordState);
         RF::EndCommandBuffer(recordState);
     }
 
@@ -673,6 +718,16 @@ namespace MFA::SceneManager
 
     //-------------------------------------------------------------------------------------------------
 
+    void OnRenderQualityChanged()
+    {
+        for (auto const & entry : state->pipelines)
+        {
+            entry.second->onRenderQualityChanged();
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     Scene * GetActiveScene()
     {
         return state->activeScene.get();
@@ -680,6 +735,162 @@ namespace MFA::SceneManager
 
     //-------------------------------------------------------------------------------------------------
 
+    static void sampleCountUI(char const * label, VkSampleCountFlagBits & sampleCount)
+    {
+        static std::vector<char const *> const Names {"1x", "2x", "4x", "8x"};
+
+        auto const maxSampleCount = RF::GetMaxSamplesCount();
+        int32_t itemsCount = 0;
+        int32_t selectedIndex = 0;
+        for (int32_t i = 0; i < static_cast<int32_t>(Names.size()) && (1 << i) <= maxSampleCount; ++i)
+        {
+            if ((1 << i) == sampleCount)
+            {
+                selectedIndex = i;
+            }
+            ++itemsCount;
+        }
+
+        UI::SetNextItemWidth(300.0f);
+        if (UI::Combo(label, &selectedIndex, const_cast<char const **>(Names.data()), itemsCount))
+        {
+            sampleCount = static_cast<VkSampleCountFlagBits>(1 << selectedIndex);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void renderQualityUI()
+    {
+        auto renderQuality = RF::GetRenderQuality();
+
+        UI::Text("Gpu frame time is %.2f ms", RF::GetGpuFrameTimeMs());
+        auto const renderExtent = RF::GetRenderExtent();
+        UI::Text("Render resolution is %ux%u", renderExtent.width, renderExtent.height);
+
+        sampleCountUI("Display samples", renderQuality.displaySampleCount);
+        sampleCountUI("Depth pre-pass samples", renderQuality.depthPrePassSampleCount);
+
+        UI::Checkbox("Dynamic resolution", &renderQuality.dynamicResolution);
+        UI::SetNextItemWidth(300.0f);
+        if (renderQuality.dynamicResolution)
+        {
+            UI::InputFloat("Target gpu time (ms)", renderQuality.targetGpuFrameTimeMs);
+            UI::SetNextItemWidth(300.0f);
+            UI::SliderFloat("Min render scale", &renderQuality.minRenderScale, 0.25f, 1.0f);
+            UI::SetNextItemWidth(300.0f);
+            UI::SliderFloat("Max render scale", &renderQuality.maxRenderScale, 0.25f, 1.0f);
+        }
+        else
+        {
+            UI::SliderFloat("Render scale", &renderQuality.renderScale, 0.25f, 1.0f);
+        }
+
+        RF::SetRenderQuality(renderQuality);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void memoryUI()
+    {
+        static constexpr float BytesPerMb = 1024.0f * 1024.0f;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(Memory::Tag::Count); ++i)
+        {
+            auto const tag = static_cast<Memory::Tag>(i);
+            auto const stats = Memory::GetStats(tag);
+            UI::Text(
+                "%s memory %.2f MB, Peak %.2f MB",
+                Memory::TagName(tag),
+                static_cast<float>(stats.currentBytes) / BytesPerMb,
+                static_cast<float>(stats.peakBytes) / BytesPerMb
+            );
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void resourceCacheUI()
+    {
+        static constexpr float BytesPerMb = 1024.0f * 1024.0f;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(RC::BudgetType::Count); ++i)
+        {
+            auto const budgetStats = RC::GetBudgetStats(static_cast<RC::BudgetType>(i));
+            UI::Text(
+                "%s cache %.2f / %.2f MB",
+                static_cast<RC::BudgetType>(i) == RC::BudgetType::Gpu ? "Gpu" : "Cpu",
+                static_cast<float>(budgetStats.residentBytes) / BytesPerMb,
+                static_cast<float>(budgetStats.budgetBytes) / BytesPerMb
+            );
+        }
+        for (uint32_t i = 0; i < static_cast<uint32_t>(RC::CacheType::Count); ++i)
+        {
+            auto const cacheType = static_cast<RC::CacheType>(i);
+            auto const stats = RC::GetCacheStats(cacheType);
+            UI::Text(
+                "%s: Hit %llu, Miss %llu, Evicted %llu, Resident %u",
+                RC::CacheTypeName(cacheType),
+                static_cast<unsigned long long>(stats.hitCount),
+                static_cast<unsigned long long>(stats.missCount),
+                static_cast<unsigned long long>(stats.evictionCount),
+                stats.residentCount
+            );
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void streamingUI()
+    {
+        auto const stats = RC::GetStreamStats();
+        for (uint32_t i = 0; i < static_cast<uint32_t>(RC::StreamStage::Count); ++i)
+        {
+            UI::Text(
+                "%s stage: Pending %u, Running %u",
+                RC::StreamStageName(static_cast<RC::StreamStage>(i)),
+                stats.pendingCount[i],
+                stats.runningCount[i]
+            );
+        }
+        UI::Text(
+            "Streaming: Completed %llu, Cancelled %llu, Last upload %.2f ms",
+            static_cast<unsigned long long>(stats.completedCount),
+            static_cast<unsigned long long>(stats.cancelledCount),
+            stats.lastUploadMs
+        );
+
+        float uploadBudgetMs = RC::GetUploadBudget();
+        UI::SetNextItemWidth(300.0f);
+        UI::SliderFloat("Upload budget (ms)", &uploadBudgetMs, 0.0f, 16.0f);
+        RC::SetUploadBudget(uploadBudgetMs);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void mipStreamingUI()
+    {
+        static constexpr float BytesPerMb = 1024.0f * 1024.0f;
+        auto const stats = RC::GetMipStreamStats();
+        UI::Text(
+            "Texture mips %.2f / %.2f MB, Textures %u, Pending %u",
+            static_cast<float>(stats.residentBytes) / BytesPerMb,
+            static_cast<float>(stats.budgetBytes) / BytesPerMb,
+            stats.textureCount,
+            stats.pendingCount
+        );
+        UI::Text(
+            "Mips: Promoted %llu, Evicted %llu",
+            static_cast<unsigned long long>(stats.promotionCount),
+            static_cast<unsigned long long>(stats.evictionCount)
+        );
+
+        int budgetMb = static_cast<int>(static_cast<float>(stats.budgetBytes) / BytesPerMb);
+        UI::SetNextItemWidth(300.0f);
+        UI::SliderInt("Texture mip budget (MB)", &budgetMb, 0, 2048);
+        RC::SetMipStreamBudget(static_cast<size_t>(budgetMb) * 1024 * 1024);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void OnUI()
     {
         UI::BeginWindow("Scene Subsystem");
@@ -710,6 +921,16 @@ namespace MFA::SceneManager
             SetActiveScene(activeSceneIndex);
         }
 
+        renderQualityUI();
+
+        memoryUI();
+
+        resourceCacheUI();
+
+        streamingUI();
+
+        mipStreamingUI();
+
         UI::EndWindow();
     }
 
@@ -972,4 +1193,13 @@ namespace MFA::SceneManager
 
     //-------------------------------------------------------------------------------------------------
 
+    SpatialIndex & GetSpatialIndex()
+    {
+        // Outlives the scene manager state, Bounding volumes are removed when the entity system shuts down
+        static SpatialIndex spatialIndex {};
+        return spatialIndex;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
 }
@@ -12,6 +12,7 @@ namespace MFA
     class BasePipeline;
     class Scene;
     class CameraComponent;
+    class SpatialIndex;
 }
 
 namespace MFA::SceneManager
@@ -68,6 +69,7 @@ namespace MFA::SceneManager
     void Update(float deltaTime);
     void Render(float deltaTime);
     void OnResize();
+    void OnRenderQualityChanged();
 
     void OnUI();            // Can be called optionally for general info about the scenes
 
@@ -102,4 +104,8 @@ namespace MFA::SceneManager
     [[nodiscard]]
     std::weak_ptr<CameraComponent> GetActiveCamera();
 
+    // Bounding volumes of all scenes, Culled against the active camera at the end of each update
+    [[nodiscard]]
+    SpatialIndex & GetSpatialIndex();
+
 }
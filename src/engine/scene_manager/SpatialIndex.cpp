@@ -0,0 +1,755 @@
+#include "SpatialIndex.hpp"
+
+#include "engine/BedrockAssert.hpp"
+#include "engine/job_system/JobSystem.hpp"
+#include "engine/job_system/ScopeLock.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+
+#if defined(ENABLE_SIMD) && (defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64))
+#include <immintrin.h>
+#elif defined(ENABLE_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace MFA
+{
+
+    //-------------------------------------------------------------------------------------------------
+
+    static AABBTree::Box Union(AABBTree::Box const & a, AABBTree::Box const & b)
+    {
+        return AABBTree::Box {
+            .min = glm::min(a.min, b.min),
+            .max = glm::max(a.max, b.max)
+        };
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static float SurfaceArea(AABBTree::Box const & box)
+    {
+        auto const size = box.max - box.min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static bool Contains(AABBTree::Box const & outer, AABBTree::Box const & inner)
+    {
+        return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+            inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    AABBTree::AABBTree(float const margin)
+        : mMargin(margin)
+    {}
+
+    //-------------------------------------------------------------------------------------------------
+
+    AABBTree::NodeId AABBTree::Insert(int32_t const proxyId, Box const & box)
+    {
+        auto const leaf = allocateNode();
+        auto & node = mNodes[leaf];
+        node.box = Box {.min = box.min - mMargin, .max = box.max + mMargin};
+        node.proxyId = proxyId;
+        node.height = 0;
+
+        insertLeaf(leaf);
+        ++mLeafCount;
+
+        return leaf;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void AABBTree::Remove(NodeId const leaf)
+    {
+        MFA_ASSERT(leaf >= 0 && leaf < static_cast<NodeId>(mNodes.size()));
+        MFA_ASSERT(mNodes[leaf].IsLeaf());
+
+        removeLeaf(leaf);
+        freeNode(leaf);
+        --mLeafCount;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool AABBTree::Move(NodeId const leaf, Box const & box)
+    {
+        MFA_ASSERT(leaf >= 0 && leaf < static_cast<NodeId>(mNodes.size()));
+        MFA_ASSERT(mNodes[leaf].IsLeaf());
+
+        if (Contains(mNodes[leaf].box, box))
+        {
+            return false;
+        }
+
+        removeLeaf(leaf);
+        mNodes[leaf].box = Box {.min = box.min - mMargin, .max = box.max + mMargin};
+        insertLeaf(leaf);
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    AABBTree::Box const & AABBTree::GetFatBox(NodeId const node) const
+    {
+        MFA_ASSERT(node >= 0 && node < static_cast<NodeId>(mNodes.size()));
+        return mNodes[node].box;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    int AABBTree::GetHeight() const
+    {
+        return mRoot == InvalidNode ? 0 : mNodes[mRoot].height;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t AABBTree::GetLeafCount() const
+    {
+        return mLeafCount;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    AABBTree::NodeId AABBTree::allocateNode()
+    {
+        if (mFreeList == InvalidNode)
+        {
+            mNodes.emplace_back();
+            return static_cast<NodeId>(mNodes.size()) - 1;
+        }
+
+        auto const node = mFreeList;
+        mFreeList = mNodes[node].parent;
+        mNodes[node] = Node {};
+        return node;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void AABBTree::freeNode(NodeId const node)
+    {
+        mNodes[node] = Node {};
+        mNodes[node].parent = mFreeList;
+        mFreeList = node;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void AABBTree::insertLeaf(NodeId const leaf)
+    {
+        if (mRoot == InvalidNode)
+        {
+            mRoot = leaf;
+            mNodes[leaf].parent = InvalidNode;
+            return;
+        }
+
+        // Finding the sibling that adds the least surface area to the tree
+        auto const leafBox = mNodes[leaf].box;
+        auto index = mRoot;
+        while (mNodes[index].IsLeaf() == false)
+        {
+            auto const & node = mNodes[index];
+            auto const area = SurfaceArea(node.box);
+            auto const combinedArea = SurfaceArea(Union(node.box, leafBox));
+
+            // Cost of creating a new parent for this node and the leaf
+            auto const cost = 2.0f * combinedArea;
+            // Minimum cost of pushing the leaf further down the tree
+            auto const inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto const descendCost = [&](NodeId const child)->float
+            {
+                auto const & childNode = mNodes[child];
+                auto const childArea = SurfaceArea(Union(leafBox, childNode.box));
+                return childNode.IsLeaf()
+                    ? childArea + inheritanceCost
+                    : childArea - SurfaceArea(childNode.box) + inheritanceCost;
+            };
+            auto const cost1 = descendCost(node.child1);
+            auto const cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2)
+            {
+                break;
+            }
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        auto const sibling = index;
+        auto const newParent = allocateNode();
+        auto const oldParent = mNodes[sibling].parent;
+
+        auto & parentNode = mNodes[newParent];
+        parentNode.parent = oldParent;
+        parentNode.box = Union(leafBox, mNodes[sibling].box);
+        parentNode.height = mNodes[sibling].height + 1;
+        parentNode.child1 = sibling;
+        parentNode.child2 = leaf;
+        mNodes[sibling].parent = newParent;
+        mNodes[leaf].parent = newParent;
+
+        if (oldParent != InvalidNode)
+        {
+            auto & oldParentNode = mNodes[oldParent];
+            (oldParentNode.child1 == sibling ? oldParentNode.child1 : oldParentNode.child2) = newParent;
+        }
+        else
+        {
+            mRoot = newParent;
+        }
+
+        // Walking back up to fix heights and boxes
+        index = mNodes[leaf].parent;
+        while (index != InvalidNode)
+        {
+            index = balance(index);
+
+            auto & node = mNodes[index];
+            node.height = 1 + std::max(mNodes[node.child1].height, mNodes[node.child2].height);
+            node.box = Union(mNodes[node.child1].box, mNodes[node.child2].box);
+
+            index = node.parent;
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void AABBTree::removeLeaf(NodeId const leaf)
+    {
+        if (leaf == mRoot)
+        {
+            mRoot = InvalidNode;
+            return;
+        }
+
+        auto const parent = mNodes[leaf].parent;
+        auto const grandParent = mNodes[parent].parent;
+        auto const sibling = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+        if (grandParent == InvalidNode)
+        {
+            mRoot = sibling;
+            mNodes[sibling].parent = InvalidNode;
+            freeNode(parent);
+            return;
+        }
+
+        // Sibling takes the place of the parent
+        auto & grandParentNode = mNodes[grandParent];
+        (grandParentNode.child1 == parent ? grandParentNode.child1 : grandParentNode.child2) = sibling;
+        mNodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        auto index = grandParent;
+        while (index != InvalidNode)
+        {
+            index = balance(index);
+
+            auto & node = mNodes[index];
+            node.height = 1 + std::max(mNodes[node.child1].height, mNodes[node.child2].height);
+            node.box = Union(mNodes[node.child1].box, mNodes[node.child2].box);
+
+            index = node.parent;
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    AABBTree::NodeId AABBTree::balance(NodeId const iA)
+    {
+        auto & A = mNodes[iA];
+        if (A.IsLeaf() || A.height < 2)
+        {
+            return iA;
+        }
+
+        auto const iB = A.child1;
+        auto const iC = A.child2;
+        auto & B = mNodes[iB];
+        auto & C = mNodes[iC];
+
+        auto const rotateUp = [this, iA, &A](NodeId const iUp, Node & up, Node const & stay, bool const upIsChild2)
+        {
+            auto const iF = up.child1;
+            auto const iG = up.child2;
+            auto & F = mNodes[iF];
+            auto & G = mNodes[iG];
+
+            up.child1 = iA;
+            up.parent = A.parent;
+            A.parent = iUp;
+
+            if (up.parent != InvalidNode)
+            {
+                auto & parentNode = mNodes[up.parent];
+                (parentNode.child1 == iA ? parentNode.child1 : parentNode.child2) = iUp;
+            }
+            else
+            {
+                mRoot = iUp;
+            }
+
+            // Taller grand child stays with the node that moved up, The other one goes down to A
+            auto const keepF = F.height > G.height;
+            auto const iKeep = keepF ? iF : iG;
+            auto const iGive = keepF ? iG : iF;
+            auto & keep = mNodes[iKeep];
+            auto & give = mNodes[iGive];
+
+            up.child2 = iKeep;
+            (upIsChild2 ? A.child2 : A.child1) = iGive;
+            give.parent = iA;
+
+            A.box = Union(stay.box, give.box);
+            A.height = 1 + std::max(stay.height, give.height);
+            up.box = Union(A.box, keep.box);
+            up.height = 1 + std::max(A.height, keep.height);
+        };
+
+        auto const balanceFactor = C.height - B.height;
+        if (balanceFactor > 1)
+        {
+            rotateUp(iC, C, B, true);
+            return iC;
+        }
+        if (balanceFactor < -1)
+        {
+            rotateUp(iB, B, C, false);
+            return iB;
+        }
+        return iA;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool AABBTree::SphereOverlaps(Box const & box, glm::vec3 const & center, float const radiusSquare)
+    {
+        auto const closestPoint = glm::clamp(center, box.min, box.max);
+        auto const difference = center - closestPoint;
+        return glm::dot(difference, difference) <= radiusSquare;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    SpatialIndex::Plane SpatialIndex::Plane::FromPoint(glm::vec3 const & normal, glm::vec3 const & point)
+    {
+        return Plane {.normal = normal, .distance = -glm::dot(normal, point)};
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Static volumes are never refit so they use tight boxes, Dynamic ones get room to move before reinsertion
+    static constexpr float StaticTreeMargin = 0.0f;
+    static constexpr float DynamicTreeMargin = 0.5f;
+
+    SpatialIndex::SpatialIndex()
+        : mStaticTree(StaticTreeMargin)
+        , mDynamicTree(DynamicTreeMargin)
+    {}
+
+    //-------------------------------------------------------------------------------------------------
+
+    SpatialIndex::ProxyId SpatialIndex::Add(glm::vec3 const & center, glm::vec3 const & extent)
+    {
+        SCOPE_LOCK(mLock)
+
+        ProxyId proxyId = InvalidProxy;
+        if (mFreeProxies.empty() == false)
+        {
+            proxyId = mFreeProxies.back();
+            mFreeProxies.pop_back();
+        }
+        else
+        {
+            proxyId = static_cast<ProxyId>(mNextProxy++);
+            auto const pageIndex = static_cast<uint32_t>(proxyId) / PageSize;
+            MFA_ASSERT(pageIndex < MaxPageCount);
+            if (mPages[pageIndex] == nullptr)
+            {
+                mPages[pageIndex] = std::make_unique<Page>();
+                mPageCount = pageIndex + 1;
+            }
+        }
+
+        auto & page = getPage(proxyId);
+        auto const index = static_cast<uint32_t>(proxyId) % PageSize;
+        page.centerX[index] = center.x;
+        page.centerY[index] = center.y;
+        page.centerZ[index] = center.z;
+        page.extentX[index] = extent.x;
+        page.extentY[index] = extent.y;
+        page.extentZ[index] = extent.z;
+        page.isStatic[index] = true;
+        page.isMoved[index] = false;
+        page.alive[index / 64] |= uint64_t{1} << (index % 64);
+        page.visible[index / 64] &= ~(uint64_t{1} << (index % 64));
+        page.leaves[index] = mStaticTree.Insert(proxyId, getBox(proxyId));
+
+        ++mProxyCount;
+
+        return proxyId;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SpatialIndex::Remove(ProxyId const proxyId)
+    {
+        SCOPE_LOCK(mLock)
+
+        auto & page = getPage(proxyId);
+        auto const index = static_cast<uint32_t>(proxyId) % PageSize;
+        auto const bit = uint64_t{1} << (index % 64);
+        MFA_ASSERT((page.alive[index / 64] & bit) != 0);
+
+        (page.isStatic[index] ? mStaticTree : mDynamicTree).Remove(page.leaves[index]);
+        page.leaves[index] = AABBTree::InvalidNode;
+        page.isMoved[index] = false;
+        page.alive[index / 64] &= ~bit;
+        page.visible[index / 64] &= ~bit;
+
+        mFreeProxies.emplace_back(proxyId);
+        --mProxyCount;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SpatialIndex::Move(ProxyId const proxyId, glm::vec3 const & center, glm::vec3 const & extent)
+    {
+        auto & page = getPage(proxyId);
+        auto const index = static_cast<uint32_t>(proxyId) % PageSize;
+
+        if (
+            page.centerX[index] == center.x && page.centerY[index] == center.y && page.centerZ[index] == center.z &&
+            page.extentX[index] == extent.x && page.extentY[index] == extent.y && page.extentZ[index] == extent.z
+        )
+        {
+            return;
+        }
+
+        page.centerX[index] = center.x;
+        page.centerY[index] = center.y;
+        page.centerZ[index] = center.z;
+        page.extentX[index] = extent.x;
+        page.extentY[index] = extent.y;
+        page.extentZ[index] = extent.z;
+
+        if (page.isMoved[index] == false)
+        {
+            page.isMoved[index] = true;
+            SCOPE_LOCK(mLock)
+            mMovedProxies.emplace_back(proxyId);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SpatialIndex::Refit()
+    {
+        for (auto const proxyId : mMovedProxies)
+        {
+            auto & page = getPage(proxyId);
+            auto const index = static_cast<uint32_t>(proxyId) % PageSize;
+            // Proxy is removed or the id is listed twice
+            if (page.isMoved[index] == false)
+            {
+                continue;
+            }
+            page.isMoved[index] = false;
+
+            auto const box = getBox(proxyId);
+            if (page.isStatic[index])
+            {
+                mStaticTree.Remove(page.leaves[index]);
+                page.leaves[index] = mDynamicTree.Insert(proxyId, box);
+                page.isStatic[index] = false;
+            }
+            else
+            {
+                mDynamicTree.Move(page.leaves[index], box);
+            }
+        }
+        mMovedProxies.clear();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SpatialIndex::CullFrustum(Frustum const & frustum)
+    {
+        JS::ParallelFor(
+            mPageCount,
+            1,
+            [this, &frustum](uint32_t const beginIndex, uint32_t const endIndex)->void
+            {
+                for (auto pageIndex = beginIndex; pageIndex < endIndex; ++pageIndex)
+                {
+                    CullPage(*mPages[pageIndex], frustum);
+                }
+            }
+        );
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SpatialIndex::IsVisible(ProxyId const proxyId) const
+    {
+        if (proxyId == InvalidProxy)
+        {
+            return false;
+        }
+        auto const & page = getPage(proxyId);
+        auto const index = static_cast<uint32_t>(proxyId) % PageSize;
+        return (page.visible[index / 64] & (uint64_t{1} << (index % 64))) != 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SpatialIndex::QuerySphere(glm::vec3 const & center, float const radius, ProxyBitset & outProxies) const
+    {
+        outProxies.assign(static_cast<size_t>(mPageCount) * WordsPerPage, 0);
+
+        auto const radiusSquare = radius * radius;
+        auto const visitor = [this, &center, radiusSquare, &outProxies](int32_t const proxyId)->void
+        {
+            // Fat boxes are larger than the volume, So the tight box decides
+            auto const box = getBox(proxyId);
+            auto const closestPoint = glm::clamp(center, box.min, box.max);
+            auto const difference = center - closestPoint;
+            if (glm::dot(difference, difference) <= radiusSquare)
+            {
+                outProxies[proxyId / 64] |= uint64_t{1} << (proxyId % 64);
+            }
+        };
+        mStaticTree.QuerySphere(center, radius, visitor);
+        mDynamicTree.QuerySphere(center, radius, visitor);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SpatialIndex::IsStatic(ProxyId const proxyId) const
+    {
+        return getPage(proxyId).isStatic[static_cast<uint32_t>(proxyId) % PageSize];
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t SpatialIndex::GetProxyCount() const
+    {
+        return mProxyCount;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    AABBTree const & SpatialIndex::GetStaticTree() const
+    {
+        return mStaticTree;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    AABBTree const & SpatialIndex::GetDynamicTree() const
+    {
+        return mDynamicTree;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SpatialIndex::TestBit(ProxyBitset const & bitset, ProxyId const proxyId)
+    {
+        auto const word = static_cast<size_t>(proxyId) / 64;
+        return proxyId >= 0 && word < bitset.size() && (bitset[word] & (uint64_t{1} << (proxyId % 64))) != 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    SpatialIndex::Page & SpatialIndex::getPage(ProxyId const proxyId) const
+    {
+        MFA_ASSERT(proxyId >= 0);
+        auto const pageIndex = static_cast<uint32_t>(proxyId) / PageSize;
+        MFA_ASSERT(pageIndex < MaxPageCount && mPages[pageIndex] != nullptr);
+        return *mPages[pageIndex];
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    AABBTree::Box SpatialIndex::getBox(ProxyId const proxyId) const
+    {
+        auto const & page = getPage(proxyId);
+        auto const index = static_cast<uint32_t>(proxyId) % PageSize;
+        glm::vec3 const center {page.centerX[index], page.centerY[index], page.centerZ[index]};
+        glm::vec3 const extent {page.extentX[index], page.extentY[index], page.extentZ[index]};
+        return AABBTree::Box {.min = center - extent, .max = center + extent};
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Box is inside when for every plane, dot(normal, center) + distance >= -dot(abs(normal), extent)
+    // Every kernel adds the terms in the same order without fused multiply-add, So the result does not depend on the build
+    void SpatialIndex::CullPage(Page & page, Frustum const & frustum)
+    {
+        glm::vec3 absNormals[6];
+        for (int i = 0; i < 6; ++i)
+        {
+            absNormals[i] = glm::abs(frustum[i].normal);
+        }
+
+        for (uint32_t word = 0; word < WordsPerPage; ++word)
+        {
+            if (page.alive[word] == 0)
+            {
+                page.visible[word] = 0;
+                continue;
+            }
+
+            uint64_t visibleBits = 0;
+            for (uint32_t group = 0; group < 64; group += 8)
+            {
+                auto const first = word * 64 + group;
+                uint32_t insideMask = 0;
+
+#if defined(ENABLE_SIMD) && defined(__AVX2__)
+
+                auto const cx = _mm256_load_ps(page.centerX + first);
+                auto const cy = _mm256_load_ps(page.centerY + first);
+                auto const cz = _mm256_load_ps(page.centerZ + first);
+                auto const ex = _mm256_load_ps(page.extentX + first);
+                auto const ey = _mm256_load_ps(page.extentY + first);
+                auto const ez = _mm256_load_ps(page.extentZ + first);
+                auto const zero = _mm256_setzero_ps();
+                auto inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (int i = 0; i < 6; ++i)
+                {
+                    auto const & plane = frustum[i];
+                    auto distance = _mm256_add_ps(
+                        _mm256_add_ps(
+                            _mm256_mul_ps(cx, _mm256_set1_ps(plane.normal.x)),
+                            _mm256_mul_ps(cy, _mm256_set1_ps(plane.normal.y))
+                        ),
+                        _mm256_add_ps(
+                            _mm256_mul_ps(cz, _mm256_set1_ps(plane.normal.z)),
+                            _mm256_set1_ps(plane.distance)
+                        )
+                    );
+                    auto const radius = _mm256_add_ps(
+                        _mm256_add_ps(
+                            _mm256_mul_ps(ex, _mm256_set1_ps(absNormals[i].x)),
+                            _mm256_mul_ps(ey, _mm256_set1_ps(absNormals[i].y))
+                        ),
+                        _mm256_mul_ps(ez, _mm256_set1_ps(absNormals[i].z))
+                    );
+                    distance = _mm256_add_ps(distance, radius);
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+                }
+                insideMask = static_cast<uint32_t>(_mm256_movemask_ps(inside));
+
+#elif defined(ENABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+
+                // Two registers cover the eight volumes
+                for (uint32_t half = 0; half < 8; half += 4)
+                {
+                    auto const cx = _mm_load_ps(page.centerX + first + half);
+                    auto const cy = _mm_load_ps(page.centerY + first + half);
+                    auto const cz = _mm_load_ps(page.centerZ + first + half);
+                    auto const ex = _mm_load_ps(page.extentX + first + half);
+                    auto const ey = _mm_load_ps(page.extentY + first + half);
+                    auto const ez = _mm_load_ps(page.extentZ + first + half);
+                    auto const zero = _mm_setzero_ps();
+                    auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                    for (int i = 0; i < 6; ++i)
+                    {
+                        auto const & plane = frustum[i];
+                        auto distance = _mm_add_ps(
+                            _mm_add_ps(
+                                _mm_mul_ps(cx, _mm_set1_ps(plane.normal.x)),
+                                _mm_mul_ps(cy, _mm_set1_ps(plane.normal.y))
+                            ),
+                            _mm_add_ps(
+                                _mm_mul_ps(cz, _mm_set1_ps(plane.normal.z)),
+                                _mm_set1_ps(plane.distance)
+                            )
+                        );
+                        auto const radius = _mm_add_ps(
+                            _mm_add_ps(
+                                _mm_mul_ps(ex, _mm_set1_ps(absNormals[i].x)),
+                                _mm_mul_ps(ey, _mm_set1_ps(absNormals[i].y))
+                            ),
+                            _mm_mul_ps(ez, _mm_set1_ps(absNormals[i].z))
+                        );
+                        distance = _mm_add_ps(distance, radius);
+                        inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, zero));
+                    }
+                    insideMask |= static_cast<uint32_t>(_mm_movemask_ps(inside)) << half;
+                }
+
+#elif defined(ENABLE_SIMD) && defined(__ARM_NEON)
+
+                for (uint32_t half = 0; half < 8; half += 4)
+                {
+                    auto const cx = vld1q_f32(page.centerX + first + half);
+                    auto const cy = vld1q_f32(page.centerY + first + half);
+                    auto const cz = vld1q_f32(page.centerZ + first + half);
+                    auto const ex = vld1q_f32(page.extentX + first + half);
+                    auto const ey = vld1q_f32(page.extentY + first + half);
+                    auto const ez = vld1q_f32(page.extentZ + first + half);
+                    auto inside = vdupq_n_u32(0xFFFFFFFFu);
+                    for (int i = 0; i < 6; ++i)
+                    {
+                        auto const & plane = frustum[i];
+                        auto distance = vaddq_f32(
+                            vaddq_f32(vmulq_n_f32(cx, plane.normal.x), vmulq_n_f32(cy, plane.normal.y)),
+                            vaddq_f32(vmulq_n_f32(cz, plane.normal.z), vdupq_n_f32(plane.distance))
+                        );
+                        auto const radius = vaddq_f32(
+                            vaddq_f32(vmulq_n_f32(ex, absNormals[i].x), vmulq_n_f32(ey, absNormals[i].y)),
+                            vmulq_n_f32(ez, absNormals[i].z)
+                        );
+                        distance = vaddq_f32(distance, radius);
+                        inside = vandq_u32(inside, vcgeq_f32(distance, vdupq_n_f32(0.0f)));
+                    }
+                    insideMask |= ((vgetq_lane_u32(inside, 0) & 1u) |
+                        (vgetq_lane_u32(inside, 1) & 2u) |
+                        (vgetq_lane_u32(inside, 2) & 4u) |
+                        (vgetq_lane_u32(inside, 3) & 8u)) << half;
+                }
+
+#else
+
+                for (uint32_t lane = 0; lane < 8; ++lane)
+                {
+                    auto const volume = first + lane;
+                    bool inside = true;
+                    for (int i = 0; i < 6 && inside; ++i)
+                    {
+                        auto const & plane = frustum[i];
+                        auto const distance = (page.centerX[volume] * plane.normal.x + page.centerY[volume] * plane.normal.y) +
+                            (page.centerZ[volume] * plane.normal.z + plane.distance);
+                        auto const radius = (page.extentX[volume] * absNormals[i].x + page.extentY[volume] * absNormals[i].y) +
+                            page.extentZ[volume] * absNormals[i].z;
+                        inside = distance + radius >= 0.0f;
+                    }
+                    insideMask |= static_cast<uint32_t>(inside) << lane;
+                }
+
+#endif
+
+                visibleBits |= static_cast<uint64_t>(insideMask) << group;
+            }
+
+            page.visible[word] = visibleBits & page.alive[word];
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "engine/BedrockAssert.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace MFA
+{
+
+    // Bitset that is indexed by proxy id, Word i holds proxies [i * 64, i * 64 + 63]
+    using ProxyBitset = std::vector<uint64_t>;
+
+    // Axis aligned bounding box tree with fattened leaves, Based on the dynamic tree of Box2D.
+    // Leaves are only reinserted when the tight box leaves the fat box.
+    class AABBTree
+    {
+    public:
+
+        using NodeId = int32_t;
+        static constexpr NodeId InvalidNode = -1;
+
+        struct Box
+        {
+            glm::vec3 min {};
+            glm::vec3 max {};
+        };
+
+        explicit AABBTree(float margin);
+
+        // Returns the leaf node, Box is fattened by margin
+        NodeId Insert(int32_t proxyId, Box const & box);
+
+        void Remove(NodeId leaf);
+
+        // Returns false when the fat box still contains the box and the tree did not change
+        bool Move(NodeId leaf, Box const & box);
+
+        // Calls callback with proxy id of every leaf that its fat box overlaps the sphere
+        template<typename Callback>
+        void QuerySphere(glm::vec3 const & center, float radius, Callback const & callback) const;
+
+        [[nodiscard]]
+        Box const & GetFatBox(NodeId node) const;
+
+        [[nodiscard]]
+        int GetHeight() const;
+
+        [[nodiscard]]
+        uint32_t GetLeafCount() const;
+
+    private:
+
+        struct Node
+        {
+            Box box {};
+            NodeId parent = InvalidNode;            // Next free node when the node is not used
+            NodeId child1 = InvalidNode;
+            NodeId child2 = InvalidNode;
+            int32_t proxyId = -1;
+            int32_t height = -1;                    // Leaf is 0, Free node is -1
+
+            [[nodiscard]]
+            bool IsLeaf() const { return child1 == InvalidNode; }
+        };
+
+        NodeId allocateNode();
+
+        void freeNode(NodeId node);
+
+        void insertLeaf(NodeId leaf);
+
+        void removeLeaf(NodeId leaf);
+
+        // AVL style rotation, Keeps the height logarithmic regardless of the insertion order
+        NodeId balance(NodeId node);
+
+        [[nodiscard]]
+        static bool SphereOverlaps(Box const & box, glm::vec3 const & center, float radiusSquare);
+
+        float mMargin = 0.0f;
+        NodeId mRoot = InvalidNode;
+        NodeId mFreeList = InvalidNode;
+        std::vector<Node> mNodes {};
+        uint32_t mLeafCount = 0;
+
+    };
+
+    // Bounding volumes of the scene.
+    // Bounds are stored as struct of arrays so the frustum culling pass tests 8 volumes per instruction,
+    // A flat sweep is cheaper than a tree walk for the entity counts that we have.
+    // Volumes start in the static tree and move to the dynamic one when they move for the first time,
+    // Trees are used for range queries (Point light range).
+    // Proxies live in fixed pages that never reallocate, So Move can run on any thread while another thread adds proxies.
+    class SpatialIndex
+    {
+    public:
+
+        using ProxyId = int32_t;
+        static constexpr ProxyId InvalidProxy = -1;
+
+        // Point p is in front of the plane when dot(normal, p) + distance >= 0
+        struct Plane
+        {
+            glm::vec3 normal {};
+            float distance = 0.0f;
+
+            [[nodiscard]]
+            static Plane FromPoint(glm::vec3 const & normal, glm::vec3 const & point);
+        };
+        using Frustum = std::array<Plane, 6>;
+
+        // Proxies of a page are culled by a single task, Multiple of 64 so tasks never share a bitset word
+        static constexpr uint32_t PageSize = 1024;
+        static constexpr uint32_t MaxPageCount = 256;
+
+        explicit SpatialIndex();
+
+        SpatialIndex(SpatialIndex const &) noexcept = delete;
+        SpatialIndex(SpatialIndex &&) noexcept = delete;
+        SpatialIndex & operator= (SpatialIndex const & rhs) noexcept = delete;
+        SpatialIndex & operator= (SpatialIndex && rhs) noexcept = delete;
+
+        // Thread safe
+        [[nodiscard]]
+        ProxyId Add(glm::vec3 const & center, glm::vec3 const & extent);
+
+        // Thread safe
+        void Remove(ProxyId proxyId);
+
+        // Thread safe for different proxies, Does nothing when bounds are unchanged.
+        // Trees are refit on the next call to Refit.
+        void Move(ProxyId proxyId, glm::vec3 const & center, glm::vec3 const & extent);
+
+        // Applies the moves since the last call to the trees, Must not run together with other functions
+        void Refit();
+
+        // Writes the frustum test result of every proxy into the visibility bits, Pages are culled in parallel by the calling
+        // thread and the job system. Only waits for its own pages, Not for the other jobs of the pool.
+        // Must not run together with Add and Remove.
+        void CullFrustum(Frustum const & frustum);
+
+        // Result of the last CullFrustum, New proxies are not visible until the next pass
+        [[nodiscard]]
+        bool IsVisible(ProxyId proxyId) const;
+
+        // Sets the bit of every proxy that its box overlaps the sphere, Other bits are cleared.
+        void QuerySphere(glm::vec3 const & center, float radius, ProxyBitset & outProxies) const;
+
+        [[nodiscard]]
+        bool IsStatic(ProxyId proxyId) const;
+
+        [[nodiscard]]
+        uint32_t GetProxyCount() const;
+
+        [[nodiscard]]
+        AABBTree const & GetStaticTree() const;
+
+        [[nodiscard]]
+        AABBTree const & GetDynamicTree() const;
+
+        [[nodiscard]]
+        static bool TestBit(ProxyBitset const & bitset, ProxyId proxyId);
+
+    private:
+
+        static constexpr uint32_t WordsPerPage = PageSize / 64;
+
+        struct Page
+        {
+            alignas(32) float centerX[PageSize];
+            alignas(32) float centerY[PageSize];
+            alignas(32) float centerZ[PageSize];
+            alignas(32) float extentX[PageSize];
+            alignas(32) float extentY[PageSize];
+            alignas(32) float extentZ[PageSize];
+            AABBTree::NodeId leaves[PageSize];
+            bool isStatic[PageSize];
+            bool isMoved[PageSize];
+            uint64_t alive[WordsPerPage];
+            uint64_t visible[WordsPerPage];
+        };
+
+        [[nodiscard]]
+        Page & getPage(ProxyId proxyId) const;
+
+        [[nodiscard]]
+        AABBTree::Box getBox(ProxyId proxyId) const;
+
+        static void CullPage(Page & page, Frustum const & frustum);
+
+        std::atomic<bool> mLock = false;
+
+        std::array<std::unique_ptr<Page>, MaxPageCount> mPages {};
+        std::atomic<uint32_t> mPageCount = 0;
+
+        std::vector<ProxyId> mFreeProxies {};
+        std::vector<ProxyId> mMovedProxies {};
+        uint32_t mProxyCount = 0;
+        uint32_t mNextProxy = 0;
+
+        AABBTree mStaticTree;
+        AABBTree mDynamicTree;
+
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    template<typename Callback>
+    void AABBTree::QuerySphere(glm::vec3 const & center, float const radius, Callback const & callback) const
+    {
+        if (mRoot == InvalidNode)
+        {
+            return;
+        }
+
+        auto const radiusSquare = radius * radius;
+
+        NodeId stack[64];
+        int stackSize = 0;
+        stack[stackSize++] = mRoot;
+        while (stackSize > 0)
+        {
+            auto const & node = mNodes[stack[--stackSize]];
+            if (SphereOverlaps(node.box, center, radiusSquare) == false)
+            {
+                continue;
+            }
+            if (node.IsLeaf())
+            {
+                callback(node.proxyId);
+            }
+            else
+            {
+                // Tree is balanced, So its height is far below the stack size
+                MFA_ASSERT(stackSize + 2 <= 64);
+                stack[stackSize++] = node.child1;
+                stack[stackSize++] = node.child2;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
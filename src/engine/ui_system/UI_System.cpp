@@ -346,11 +346,11 @@ namespace MFA::UI_System
         pipelineOptions.colorBlendAttachments.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
         pipelineOptions.useStaticViewportAndScissor = false;
         pipelineOptions.cullMode = VK_CULL_MODE_NONE;
-        // TODO I wish we could render ui without MaxSamplesCount
-        pipelineOptions.rasterizationSamples = RF::GetMaxSamplesCount();
+        // Ui is drawn after the upscale directly into the swap-chain image
+        pipelineOptions.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
 
         state->pipeline = RF::CreateGraphicPipeline(
-            RF::GetDisplayRenderPass()->GetVkRenderPass(),
+            RF::GetDisplayRenderPass()->GetPresentVkRenderPass(),
             static_cast<uint8_t>(shaderStages.size()),
             shaderStages.data(),
             pipelineLayout,
@@ -637,11 +637,11 @@ namespace MFA::UI_System
                 // Create or resize the vertex/index buffers
                 size_t const vertexSize = drawData->TotalVtxCount * sizeof(ImDrawVert);
                 size_t const indexSize = drawData->TotalIdxCount * sizeof(ImDrawIdx);
-                auto const vertexData = Memory::Alloc(vertexSize);
-                auto const indexData = Memory::Alloc(indexSize);
+                auto const vertexData = Memory::FrameAlloc(vertexSize);
+                auto const indexData = Memory::FrameAlloc(indexSize);
                 {
-                    auto * vertexPtr = reinterpret_cast<ImDrawVert *>(vertexData->memory.ptr);
-                    auto * indexPtr = reinterpret_cast<ImDrawIdx *>(indexData->memory.ptr);
+                    auto * vertexPtr = reinterpret_cast<ImDrawVert *>(vertexData.ptr);
+                    auto * indexPtr = reinterpret_cast<ImDrawIdx *>(indexData.ptr);
                     for (int n = 0; n < drawData->CmdListsCount; n++)
                     {
                         const ImDrawList * cmd = drawData->CmdLists[n];
@@ -664,7 +664,7 @@ namespace MFA::UI_System
                     );
                 }
 
-                RF::UpdateHostVisibleBuffer(*vertexBuffer, vertexData->memory);
+                RF::UpdateHostVisibleBuffer(*vertexBuffer, vertexData);
 
                 if (indexBuffer == nullptr || indexBuffer->size < indexSize)
                 {
@@ -675,7 +675,7 @@ namespace MFA::UI_System
                     );
                 }
 
-                RF::UpdateHostVisibleBuffer(*indexBuffer, indexData->memory);
+                RF::UpdateHostVisibleBuffer(*indexBuffer, indexData);
 
                 RF::BindIndexBuffer(
                     recordState,
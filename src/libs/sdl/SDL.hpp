@@ -1,5 +1,12 @@
 #include <cmath>
 
+// SDL_cpuinfo includes the intrinsics headers, They are included here first so their types stay in the global namespace
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace MFA::MSDL {
     // TODO Separate these classes
     #include <SDL2/SDL_keycode.h>
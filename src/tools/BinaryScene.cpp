@@ -0,0 +1,924 @@
+#include "BinaryScene.hpp"
+
+#include "engine/BedrockAssert.hpp"
+#include "engine/entity_system/Component.hpp"
+#include "engine/entity_system/Entity.hpp"
+#include "engine/entity_system/EntitySystem.hpp"
+
+#include "libs/nlohmann/json.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace MFA::BinaryScene
+{
+
+    namespace
+    {
+
+        enum class ValueTag : uint8_t
+        {
+            Null = 0,
+            False = 1,
+            True = 2,
+            Int = 3,            // Zigzag varint
+            UInt = 4,           // Varint
+            Float = 5,          // Doubles that fit in a float without loss
+            Double = 6,
+            String = 7,         // String id
+            Array = 8,          // Count, Values
+            Object = 9,         // Count, Key string id and value pairs
+        };
+
+        // Nested values deeper than this are treated as corrupt data
+        uint32_t constexpr MaxValueDepth = 64;
+
+        // Parent index of the root, Children of the root have the same parent index
+        uint32_t constexpr NoParent = 0;
+
+        using Scene = SceneLoader::Scene;
+
+        //-------------------------------------------------------------------------------------------------
+
+        class Writer
+        {
+        public:
+
+            void U8(uint8_t const value)
+            {
+                mBytes.emplace_back(value);
+            }
+
+            void U32(uint32_t const value)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    mBytes.emplace_back(static_cast<uint8_t>(value >> (i * 8)));
+                }
+            }
+
+            void VarUInt(uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    mBytes.emplace_back(static_cast<uint8_t>(value | 0x80));
+                    value >>= 7;
+                }
+                mBytes.emplace_back(static_cast<uint8_t>(value));
+            }
+
+            void VarInt(int64_t const value)
+            {
+                VarUInt((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+            }
+
+            template<typename T>
+            void Raw(T const & value)
+            {
+                auto const offset = mBytes.size();
+                mBytes.resize(offset + sizeof(T));
+                std::memcpy(mBytes.data() + offset, &value, sizeof(T));
+            }
+
+            void Bytes(uint8_t const * bytes, size_t const size)
+            {
+                mBytes.insert(mBytes.end(), bytes, bytes + size);
+            }
+
+            [[nodiscard]]
+            std::vector<uint8_t> & GetBytes()
+            {
+                return mBytes;
+            }
+
+        private:
+
+            std::vector<uint8_t> mBytes {};
+
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        // Every read is bounds checked, The first failure makes the rest of the reads return zero
+        class Reader
+        {
+        public:
+
+            explicit Reader(uint8_t const * begin, size_t const size)
+                : mCursor(begin)
+                , mEnd(begin + size)
+            {}
+
+            uint8_t U8()
+            {
+                if (canRead(1) == false)
+                {
+                    return 0;
+                }
+                return *mCursor++;
+            }
+
+            uint32_t U32()
+            {
+                if (canRead(4) == false)
+                {
+                    return 0;
+                }
+                uint32_t value = 0;
+                for (int i = 0; i < 4; ++i)
+                {
+                    value |= static_cast<uint32_t>(*mCursor++) << (i * 8);
+                }
+                return value;
+            }
+
+            uint64_t VarUInt()
+            {
+                uint64_t value = 0;
+                for (int shift = 0; shift < 64; shift += 7)
+                {
+                    auto const byte = U8();
+                    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0)
+                    {
+                        return value;
+                    }
+                }
+                mFailed = true;
+                return 0;
+            }
+
+            // Varint that must fit in 32 bits
+            uint32_t VarU32()
+            {
+                auto const value = VarUInt();
+                if (value > UINT32_MAX)
+                {
+                    mFailed = true;
+                    return 0;
+                }
+                return static_cast<uint32_t>(value);
+            }
+
+            int64_t VarInt()
+            {
+                auto const value = VarUInt();
+                return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+            }
+
+            template<typename T>
+            T Raw()
+            {
+                T value {};
+                if (canRead(sizeof(T)))
+                {
+                    std::memcpy(&value, mCursor, sizeof(T));
+                    mCursor += sizeof(T);
+                }
+                return value;
+            }
+
+            uint8_t const * Skip(size_t const size)
+            {
+                if (canRead(size) == false)
+                {
+                    return nullptr;
+                }
+                auto const * position = mCursor;
+                mCursor += size;
+                return position;
+            }
+
+            [[nodiscard]]
+            bool HasFailed() const
+            {
+                return mFailed;
+            }
+
+            [[nodiscard]]
+            bool IsAtEnd() const
+            {
+                return mCursor == mEnd;
+            }
+
+        private:
+
+            bool canRead(size_t const size)
+            {
+                if (mFailed || static_cast<size_t>(mEnd - mCursor) < size)
+                {
+                    mFailed = true;
+                    return false;
+                }
+                return true;
+            }
+
+            uint8_t const * mCursor;
+            uint8_t const * const mEnd;
+            bool mFailed = false;
+
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        class StringTable
+        {
+        public:
+
+            uint32_t Intern(std::string const & string)
+            {
+                auto const [iterator, isInserted] = mIds.try_emplace(string, static_cast<uint32_t>(mStrings.size()));
+                if (isInserted)
+                {
+                    mStrings.emplace_back(string);
+                }
+                return iterator->second;
+            }
+
+            [[nodiscard]]
+            std::vector<std::string> const & GetStrings() const
+            {
+                return mStrings;
+            }
+
+        private:
+
+            std::unordered_map<std::string, uint32_t> mIds {};
+            std::vector<std::string> mStrings {};
+
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void EncodeValue(nlohmann::json const & value, StringTable & strings, Writer & writer)
+        {
+            switch (value.type())
+            {
+            case nlohmann::json::value_t::boolean:
+                writer.U8(static_cast<uint8_t>(value.get<bool>() ? ValueTag::True : ValueTag::False));
+                break;
+            case nlohmann::json::value_t::number_integer:
+                writer.U8(static_cast<uint8_t>(ValueTag::Int));
+                writer.VarInt(value.get<int64_t>());
+                break;
+            case nlohmann::json::value_t::number_unsigned:
+                writer.U8(static_cast<uint8_t>(ValueTag::UInt));
+                writer.VarUInt(value.get<uint64_t>());
+                break;
+            case nlohmann::json::value_t::number_float:
+            {
+                auto const number = value.get<double>();
+                auto const narrowed = static_cast<float>(number);
+                if (static_cast<double>(narrowed) == number)
+                {
+                    writer.U8(static_cast<uint8_t>(ValueTag::Float));
+                    writer.Raw(narrowed);
+                }
+                else
+                {
+                    writer.U8(static_cast<uint8_t>(ValueTag::Double));
+                    writer.Raw(number);
+                }
+                break;
+            }
+            case nlohmann::json::value_t::string:
+                writer.U8(static_cast<uint8_t>(ValueTag::String));
+                writer.VarUInt(strings.Intern(value.get_ref<std::string const &>()));
+                break;
+            case nlohmann::json::value_t::array:
+                writer.U8(static_cast<uint8_t>(ValueTag::Array));
+                writer.VarUInt(value.size());
+                for (auto const & element : value)
+                {
+                    EncodeValue(element, strings, writer);
+                }
+                break;
+            case nlohmann::json::value_t::object:
+                writer.U8(static_cast<uint8_t>(ValueTag::Object));
+                writer.VarUInt(value.size());
+                for (auto const & [key, element] : value.items())
+                {
+                    writer.VarUInt(strings.Intern(key));
+                    EncodeValue(element, strings, writer);
+                }
+                break;
+            default:
+                // Null, Binary and discarded values
+                writer.U8(static_cast<uint8_t>(ValueTag::Null));
+                break;
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        bool DecodeValue(
+            Reader & reader,
+            std::vector<std::string> const & strings,
+            uint32_t const depth,
+            nlohmann::json & outValue
+        )
+        {
+            if (depth > MaxValueDepth)
+            {
+                return false;
+            }
+
+            auto const readString = [&reader, &strings](std::string const *& outString)->bool
+            {
+                auto const id = reader.VarUInt();
+                if (reader.HasFailed() || id >= strings.size())
+                {
+                    return false;
+                }
+                outString = &strings[id];
+                return true;
+            };
+
+            switch (static_cast<ValueTag>(reader.U8()))
+            {
+            case ValueTag::Null:
+                outValue = nullptr;
+                break;
+            case ValueTag::False:
+                outValue = false;
+                break;
+            case ValueTag::True:
+                outValue = true;
+                break;
+            case ValueTag::Int:
+                outValue = reader.VarInt();
+                break;
+            case ValueTag::UInt:
+                outValue = reader.VarUInt();
+                break;
+            case ValueTag::Float:
+                outValue = static_cast<double>(reader.Raw<float>());
+                break;
+            case ValueTag::Double:
+                outValue = reader.Raw<double>();
+                break;
+            case ValueTag::String:
+            {
+                std::string const * string = nullptr;
+                if (readString(string) == false)
+                {
+                    return false;
+                }
+                outValue = *string;
+                break;
+            }
+            case ValueTag::Array:
+            {
+                auto const count = reader.VarU32();
+                outValue = nlohmann::json::array();
+                for (uint32_t i = 0; i < count && reader.HasFailed() == false; ++i)
+                {
+                    if (DecodeValue(reader, strings, depth + 1, outValue.emplace_back()) == false)
+                    {
+                        return false;
+                    }
+                }
+                break;
+            }
+            case ValueTag::Object:
+            {
+                auto const count = reader.VarU32();
+                outValue = nlohmann::json::object();
+                for (uint32_t i = 0; i < count && reader.HasFailed() == false; ++i)
+                {
+                    std::string const * key = nullptr;
+                    if (readString(key) == false || DecodeValue(reader, strings, depth + 1, outValue[*key]) == false)
+                    {
+                        return false;
+                    }
+                }
+                break;
+            }
+            default:
+                return false;
+            }
+            return reader.HasFailed() == false;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        // Collects the entities and component data, Then writes them with one block per component type
+        class SceneBuilder
+        {
+        public:
+
+            // Returns the index of the entity
+            uint32_t AddEntity(std::string const & name, uint32_t const parentIndex, bool const isActive)
+            {
+                mEntities.emplace_back(SceneLoader::EntityRecord {
+                    .nameId = mStrings.Intern(name),
+                    .parentIndex = parentIndex,
+                    .isActive = isActive
+                });
+                return static_cast<uint32_t>(mEntities.size() - 1);
+            }
+
+            void AddComponent(
+                uint32_t const entityIndex,
+                uint8_t const slot,
+                std::string const & typeName,
+                nlohmann::json const & data
+            )
+            {
+                auto const typeNameId = mStrings.Intern(typeName);
+                auto [iterator, isInserted] = mBlockIndices.try_emplace(typeNameId, mBlocks.size());
+                if (isInserted)
+                {
+                    mBlocks.emplace_back(Block {.typeNameId = typeNameId});
+                }
+                auto & block = mBlocks[iterator->second];
+
+                Writer payload {};
+                EncodeValue(data, mStrings, payload);
+
+                block.writer.VarUInt(entityIndex);
+                block.writer.U8(slot);
+                block.writer.VarUInt(payload.GetBytes().size());
+                block.writer.Bytes(payload.GetBytes().data(), payload.GetBytes().size());
+                ++block.count;
+            }
+
+            [[nodiscard]]
+            std::vector<uint8_t> Build()
+            {
+                auto const & strings = mStrings.GetStrings();
+
+                Writer writer {};
+                writer.U32(Magic);
+                writer.U32(Version);
+                writer.U32(static_cast<uint32_t>(strings.size()));
+                writer.U32(static_cast<uint32_t>(mEntities.size()));
+                writer.U32(static_cast<uint32_t>(mBlocks.size()));
+
+                for (auto const & string : strings)
+                {
+                    writer.VarUInt(string.size());
+                    writer.Bytes(reinterpret_cast<uint8_t const *>(string.data()), string.size());
+                }
+
+                for (auto const & entity : mEntities)
+                {
+                    writer.VarUInt(entity.nameId);
+                    writer.VarUInt(entity.parentIndex);
+                    writer.U8(entity.isActive ? 1 : 0);
+                }
+
+                for (auto & block : mBlocks)
+                {
+                    auto const & bytes = block.writer.GetBytes();
+                    writer.VarUInt(block.typeNameId);
+                    writer.VarUInt(block.count);
+                    writer.Bytes(bytes.data(), bytes.size());
+                }
+
+                return std::move(writer.GetBytes());
+            }
+
+        private:
+
+            struct Block
+            {
+                uint32_t typeNameId = 0;
+                uint32_t count = 0;
+                Writer writer {};
+            };
+
+            StringTable mStrings {};
+            std::vector<SceneLoader::EntityRecord> mEntities {};
+            std::vector<Block> mBlocks {};
+            std::unordered_map<uint32_t, size_t> mBlockIndices {};
+
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void AddEntity(SceneBuilder & builder, Entity * entity, uint32_t const parentIndex)
+        {
+            MFA_ASSERT(entity->IsSerializable());
+            auto const entityIndex = builder.AddEntity(entity->GetName(), parentIndex, entity->IsSelfActive());
+
+            uint8_t slot = 0;
+            for (auto * component : entity->GetComponents())
+            {
+                nlohmann::json data {};
+                component->Serialize(data);
+                builder.AddComponent(entityIndex, slot++, component->GetName(), data);
+            }
+
+            for (auto * child : entity->GetChildEntities())
+            {
+                if (child->IsSerializable())
+                {
+                    AddEntity(builder, child, entityIndex);
+                }
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void AddEntityJson(SceneBuilder & builder, nlohmann::json const & entityJson, uint32_t const parentIndex)
+        {
+            auto const entityIndex = builder.AddEntity(
+                entityJson.value("name", "undefined"),
+                parentIndex,
+                entityJson.value("isActive", true)
+            );
+
+            auto const findComponents = entityJson.find("components");
+            if (findComponents != entityJson.end())
+            {
+                MFA_ASSERT(findComponents->size() <= UINT8_MAX);
+                uint8_t slot = 0;
+                for (auto const & rawComponent : *findComponents)
+                {
+                    auto const findData = rawComponent.find("data");
+                    builder.AddComponent(
+                        entityIndex,
+                        slot++,
+                        rawComponent.value("name", "undefined"),
+                        findData != rawComponent.end() ? *findData : nlohmann::json {}
+                    );
+                }
+            }
+
+            auto const findChildren = entityJson.find("children");
+            if (findChildren != entityJson.end())
+            {
+                for (auto const & rawChild : *findChildren)
+                {
+                    AddEntityJson(builder, rawChild, entityIndex);
+                }
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        // Validates the whole layout, Component data is only checked to be inside its block
+        bool ParseScene(std::vector<uint8_t> const & data, Scene & outScene)
+        {
+            Reader reader {data.data(), data.size()};
+
+            if (reader.U32() != Magic)
+            {
+                MFA_LOG_WARN("Data is not a binary scene");
+                return false;
+            }
+            auto const version = reader.U32();
+            if (version == 0 || version > Version)
+            {
+                MFA_LOG_WARN("Binary scene version %u is not supported, Latest version is %u", version, Version);
+                return false;
+            }
+            auto const stringCount = reader.U32();
+            auto const entityCount = reader.U32();
+            auto const blockCount = reader.U32();
+            // Each string, entity and block takes at least one byte
+            if (reader.HasFailed() || entityCount == 0 || static_cast<uint64_t>(stringCount) + entityCount + blockCount > data.size())
+            {
+                return false;
+            }
+
+            outScene.strings.resize(stringCount);
+            for (auto & string : outScene.strings)
+            {
+                auto const size = reader.VarU32();
+                auto const * bytes = reader.Skip(size);
+                if (bytes == nullptr)
+                {
+                    return false;
+                }
+                string.assign(reinterpret_cast<char const *>(bytes), size);
+            }
+
+            outScene.entities.resize(entityCount);
+            for (uint32_t i = 0; i < entityCount; ++i)
+            {
+                auto & entity = outScene.entities[i];
+                entity.nameId = reader.VarU32();
+                entity.parentIndex = reader.VarU32();
+                entity.isActive = reader.U8() != 0;
+                // Parents come first and there is a single root
+                bool const isParentValid = i == 0 ? entity.parentIndex == NoParent : entity.parentIndex < i;
+                if (reader.HasFailed() || entity.nameId >= stringCount || isParentValid == false)
+                {
+                    return false;
+                }
+            }
+
+            std::vector<uint32_t> componentCounts (entityCount, 0);
+            std::vector<std::pair<uint32_t, SceneLoader::ComponentRecord>> records {};
+            for (uint32_t blockIndex = 0; blockIndex < blockCount; ++blockIndex)
+            {
+                auto const typeNameId = reader.VarU32();
+                auto const count = reader.VarU32();
+                if (reader.HasFailed() || typeNameId >= stringCount)
+                {
+                    return false;
+                }
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    auto const entityIndex = reader.VarU32();
+                    auto const slot = reader.U8();
+                    auto const size = reader.VarU32();
+                    auto const * payload = reader.Skip(size);
+                    if (payload == nullptr || entityIndex >= entityCount)
+                    {
+                        return false;
+                    }
+                    ++componentCounts[entityIndex];
+                    records.emplace_back(entityIndex, SceneLoader::ComponentRecord {
+                        .typeNameId = typeNameId,
+                        .slot = slot,
+                        .offset = static_cast<uint32_t>(payload - data.data()),
+                        .size = size
+                    });
+                }
+            }
+            if (reader.IsAtEnd() == false)
+            {
+                return false;
+            }
+
+            // Counting sort by entity, Then by slot inside each entity
+            outScene.firstComponents.resize(entityCount + 1);
+            outScene.firstComponents[0] = 0;
+            for (uint32_t i = 0; i < entityCount; ++i)
+            {
+                outScene.firstComponents[i + 1] = outScene.firstComponents[i] + componentCounts[i];
+            }
+            outScene.components.resize(records.size());
+            std::vector<uint32_t> nextComponents (outScene.firstComponents.begin(), outScene.firstComponents.end() - 1);
+            for (auto const & [entityIndex, record] : records)
+            {
+                outScene.components[nextComponents[entityIndex]++] = record;
+            }
+            for (uint32_t i = 0; i < entityCount; ++i)
+            {
+                std::sort(
+                    outScene.components.begin() + outScene.firstComponents[i],
+                    outScene.components.begin() + outScene.firstComponents[i + 1],
+                    [](SceneLoader::ComponentRecord const & a, SceneLoader::ComponentRecord const & b)->bool
+                    {
+                        return a.slot < b.slot;
+                    }
+                );
+            }
+
+            return true;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        bool DecodeComponentData(
+            std::vector<uint8_t> const & data,
+            Scene const & scene,
+            SceneLoader::ComponentRecord const & record,
+            nlohmann::json & outData
+        )
+        {
+            Reader reader {data.data() + record.offset, record.size};
+            return DecodeValue(reader, scene.strings, 0, outData) && reader.IsAtEnd();
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        bool DecodeEntityJson(
+            std::vector<uint8_t> const & data,
+            Scene const & scene,
+            std::vector<std::vector<uint32_t>> const & children,
+            uint32_t const index,
+            nlohmann::json & outEntityJson
+        )
+        {
+            auto const & entity = scene.entities[index];
+            outEntityJson["isActive"] = entity.isActive;
+            outEntityJson["name"] = scene.strings[entity.nameId];
+
+            for (auto i = scene.firstComponents[index]; i < scene.firstComponents[index + 1]; ++i)
+            {
+                auto const & record = scene.components[i];
+                nlohmann::json componentJson {};
+                componentJson["name"] = scene.strings[record.typeNameId];
+                if (DecodeComponentData(data, scene, record, componentJson["data"]) == false)
+                {
+                    return false;
+                }
+                outEntityJson["components"].emplace_back(std::move(componentJson));
+            }
+
+            for (auto const childIndex : children[index])
+            {
+                if (DecodeEntityJson(data, scene, children, childIndex, outEntityJson["children"].emplace_back()) == false)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::vector<uint8_t> Encode(Entity * root)
+    {
+        MFA_ASSERT(root != nullptr);
+        SceneBuilder builder {};
+        AddEntity(builder, root, NoParent);
+        return builder.Build();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::vector<uint8_t> EncodeJson(nlohmann::json const & entityJson)
+    {
+        SceneBuilder builder {};
+        AddEntityJson(builder, entityJson, NoParent);
+        return builder.Build();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool DecodeToJson(std::vector<uint8_t> const & data, nlohmann::json & outEntityJson)
+    {
+        Scene scene {};
+        if (ParseScene(data, scene) == false)
+        {
+            return false;
+        }
+
+        std::vector<std::vector<uint32_t>> children (scene.entities.size());
+        for (uint32_t i = 1; i < scene.entities.size(); ++i)
+        {
+            children[scene.entities[i].parentIndex].emplace_back(i);
+        }
+
+        outEntityJson = nlohmann::json::object();
+        return DecodeEntityJson(data, scene, children, 0, outEntityJson);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    SceneLoader::SceneLoader(std::vector<uint8_t> data, Entity * root, Params const & params)
+        : mData(std::move(data))
+        , mRoot(root)
+        , mRootHandle(root != nullptr ? root->GetHandle() : EntityHandle {})
+        , mParams(params)
+    {
+        MFA_ASSERT(mRoot != nullptr);
+        mIsValid = mRoot != nullptr && ParseScene(mData, mScene);
+        if (mIsValid)
+        {
+            mHandles.resize(mScene.entities.size());
+        }
+        else
+        {
+            MFA_LOG_WARN("Failed to parse the binary scene");
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SceneLoader::IsValid() const
+    {
+        return mIsValid;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SceneLoader::Update()
+    {
+        using Clock = std::chrono::steady_clock;
+
+        if (IsDone())
+        {
+            return true;
+        }
+
+        // Root was destroyed, Entities without a handle cannot be checked
+        if (mRootHandle.IsValid() && EntitySystem::IsAlive(mRootHandle) == false)
+        {
+            mNextIndex = GetEntityCount();
+            return true;
+        }
+
+        auto const startTime = Clock::now();
+        uint32_t loadedCount = 0;
+        float elapsedMs = 0.0f;
+        while (mNextIndex < GetEntityCount() && (loadedCount == 0 || elapsedMs < mParams.budgetMs))
+        {
+            loadEntity(mNextIndex);
+            ++mNextIndex;
+            ++loadedCount;
+            elapsedMs = std::chrono::duration<float, std::milli>(Clock::now() - startTime).count();
+        }
+        return IsDone();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool SceneLoader::IsDone() const
+    {
+        return mIsValid == false || mNextIndex == GetEntityCount();
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t SceneLoader::GetEntityCount() const
+    {
+        return static_cast<uint32_t>(mScene.entities.size());
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t SceneLoader::GetLoadedCount() const
+    {
+        return mNextIndex;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SceneLoader::SetBudget(float const budgetMs)
+    {
+        mParams.budgetMs = budgetMs;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void SceneLoader::loadEntity(uint32_t const index)
+    {
+        auto const & record = mScene.entities[index];
+
+        Entity * entity = nullptr;
+        if (index == 0)
+        {
+            entity = mRoot;
+        }
+        else
+        {
+            auto * parent = record.parentIndex == 0 ? mRoot : EntitySystem::GetEntity(mHandles[record.parentIndex]);
+            if (parent == nullptr)
+            {
+                return;         // Parent was destroyed while loading
+            }
+            entity = EntitySystem::CreateEntity("prefab-child", parent);
+            mHandles[index] = entity->GetHandle();
+        }
+
+        auto const & name = mScene.strings[record.nameId];
+        if (name.empty() == false)
+        {
+            entity->SetName(name.c_str());
+        }
+        entity->SetActive(record.isActive);
+
+        nlohmann::json componentData {};
+        for (auto i = mScene.firstComponents[index]; i < mScene.firstComponents[index + 1]; ++i)
+        {
+            auto const & componentRecord = mScene.components[i];
+            auto const & typeName = mScene.strings[componentRecord.typeNameId];
+
+            auto component = Component::CreateComponent(typeName);
+            if (MFA_VERIFY(component != nullptr) == false)
+            {
+                continue;
+            }
+            if (DecodeComponentData(mData, mScene, componentRecord, componentData) == false)
+            {
+                MFA_LOG_WARN("Data of component %s is corrupt", typeName.c_str());
+                continue;
+            }
+            entity->AddComponent(component);
+            component->Deserialize(componentData);
+        }
+
+        EntitySystem::InitEntity(entity, mParams.initializeEntities);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Load(std::vector<uint8_t> data, Entity * root, bool const initializeEntities)
+    {
+        SceneLoader loader {std::move(data), root, SceneLoader::Params {
+            .budgetMs = std::numeric_limits<float>::max(),
+            .initializeEntities = initializeEntities
+        }};
+        if (loader.IsValid() == false)
+        {
+            return false;
+        }
+        while (loader.Update() == false);
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "engine/entity_system/EntityHandle.hpp"
+
+#include "libs/nlohmann/json_fwd.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MFA
+{
+    class Entity;
+}
+
+// Compact scene format for loading, Json stays as the interchange and debug format.
+// Layout: Header, String table, Entity table in depth first order, One block per component type.
+// Each string is stored once, Entity names, component names and the keys and string values inside the component data
+// refer to it by index. Component data is the json that the component serializes, Encoded as tagged binary values.
+namespace MFA::BinaryScene
+{
+
+    static constexpr uint32_t Magic = 0x4E435346;           // "FSCN"
+    // Increase when the layout changes, Files with an older version must stay readable
+    static constexpr uint32_t Version = 1;
+    static constexpr char const * FileExtension = ".scene";
+
+    // Root and its serializable children
+    [[nodiscard]]
+    std::vector<uint8_t> Encode(Entity * root);
+
+    // Same json that Entity::Serialize writes
+    [[nodiscard]]
+    std::vector<uint8_t> EncodeJson(nlohmann::json const & entityJson);
+
+    // Returns false when the data is not a valid scene
+    [[nodiscard]]
+    bool DecodeToJson(std::vector<uint8_t> const & data, nlohmann::json & outEntityJson);
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Instantiates the entities of a scene over several frames, Parents are created before their children.
+    // First entity of the scene is loaded into the root, Same as Entity::Deserialize.
+    // Loading stops when the root is destroyed, Children of a destroyed entity are skipped.
+    class SceneLoader
+    {
+    public:
+
+        struct Params
+        {
+            float budgetMs = 2.0f;                  // Per call of Update
+            bool initializeEntities = true;         // Triggers the init signals of the entities
+        };
+
+        // Validates the data and indexes the component blocks, Entities are created by Update
+        explicit SceneLoader(std::vector<uint8_t> data, Entity * root, Params const & params);
+
+        SceneLoader(SceneLoader const &) noexcept = delete;
+        SceneLoader(SceneLoader &&) noexcept = delete;
+        SceneLoader & operator = (SceneLoader const &) noexcept = delete;
+        SceneLoader & operator = (SceneLoader &&) noexcept = delete;
+
+        [[nodiscard]]
+        bool IsValid() const;
+
+        // Instantiates entities until the budget is spent, At least one entity per call.
+        // Returns true when there is nothing left to load.
+        bool Update();
+
+        [[nodiscard]]
+        bool IsDone() const;
+
+        [[nodiscard]]
+        uint32_t GetEntityCount() const;
+
+        [[nodiscard]]
+        uint32_t GetLoadedCount() const;
+
+        void SetBudget(float budgetMs);
+
+        struct EntityRecord
+        {
+            uint32_t nameId = 0;
+            uint32_t parentIndex = 0;               // Ignored for the root
+            bool isActive = true;
+        };
+
+        struct ComponentRecord
+        {
+            uint32_t typeNameId = 0;
+            uint8_t slot = 0;                       // Order inside the entity
+            uint32_t offset = 0;
+            uint32_t size = 0;
+        };
+
+        // Parsed header and tables, Component data stays encoded until its entity is loaded
+        struct Scene
+        {
+            std::vector<std::string> strings {};
+            std::vector<EntityRecord> entities {};
+            std::vector<ComponentRecord> components {};     // Sorted by entity and slot
+            std::vector<uint32_t> firstComponents {};       // Components of entity i are [firstComponents[i], firstComponents[i + 1])
+        };
+
+    private:
+
+        void loadEntity(uint32_t index);
+
+        std::vector<uint8_t> const mData;
+        Scene mScene {};
+        bool mIsValid = false;
+
+        Entity * const mRoot;
+        EntityHandle const mRootHandle;
+        Params mParams;
+
+        std::vector<EntityHandle> mHandles {};
+        uint32_t mNextIndex = 0;
+
+    };
+
+    // Instantiates every entity at once
+    bool Load(std::vector<uint8_t> data, Entity * root, bool initializeEntities);
+
+}
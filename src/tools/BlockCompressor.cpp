@@ -0,0 +1,544 @@
+#include "BlockCompressor.hpp"
+
+#include "engine/BedrockAssert.hpp"
+#include "engine/job_system/JobSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace MFA::BlockCompressor
+{
+
+    static constexpr uint32_t PixelCount = BlockDimension * BlockDimension;
+
+    // Blocks of a band, Enough work per job to hide the cost of handing it out
+    static constexpr uint32_t BandBlockCount = 1 << 8;
+
+    // Interpolation weights of the 4 bit indices in 1/64 steps, From the BC7 specification
+    static constexpr std::array<int, 16> BC7Weights {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    // Fitting the endpoints to the chosen indices rarely improves the block after the second round
+    static constexpr int BC7RefineCount = 2;
+
+    static constexpr int PowerIterationCount = 8;
+
+    using Pixels = std::array<std::array<uint8_t, 4>, PixelCount>;
+    using Color = std::array<float, 4>;
+    using Indices = std::array<uint8_t, PixelCount>;
+
+    struct BC7Endpoints
+    {
+        std::array<std::array<int, 4>, 2> values {};        // 7 bits per component
+        std::array<int, 2> pBits {};                        // Lowest bit of all four components of the endpoint
+    };
+
+    // Fills the 128 bits of a block from the lowest bit up
+    class BitWriter
+    {
+    public:
+
+        void write(uint64_t const value, uint32_t const bitCount)
+        {
+            MFA_ASSERT(mPosition + bitCount <= 128);
+            if (mPosition < 64)
+            {
+                mWords[0] |= value << mPosition;
+                if (mPosition + bitCount > 64)
+                {
+                    mWords[1] |= value >> (64 - mPosition);
+                }
+            }
+            else
+            {
+                mWords[1] |= value << (mPosition - 64);
+            }
+            mPosition += bitCount;
+        }
+
+        void store(uint8_t * outBlock) const
+        {
+            MFA_ASSERT(mPosition == 128);
+            for (int i = 0; i < 16; ++i)
+            {
+                outBlock[i] = static_cast<uint8_t>(mWords[i / 8] >> (8 * (i % 8)));
+            }
+        }
+
+    private:
+
+        std::array<uint64_t, 2> mWords {};
+        uint32_t mPosition = 0;
+
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t BlockSizeBytes(Codec const codec)
+    {
+        return codec == Codec::BC4 ? 8 : 16;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    size_t CompressedSizeBytes(Codec const codec, uint32_t const width, uint32_t const height)
+    {
+        size_t const blockCountX = (width + BlockDimension - 1) / BlockDimension;
+        size_t const blockCountY = (height + BlockDimension - 1) / BlockDimension;
+        return blockCountX * blockCountY * BlockSizeBytes(codec);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static void LoadBlock(
+        uint8_t const * pixels,
+        uint32_t const width,
+        uint32_t const height,
+        uint32_t const componentCount,
+        uint32_t const blockX,
+        uint32_t const blockY,
+        Pixels & outPixels
+    )
+    {
+        for (uint32_t y = 0; y < BlockDimension; ++y)
+        {
+            auto const sourceY = std::min(blockY * BlockDimension + y, height - 1);
+            for (uint32_t x = 0; x < BlockDimension; ++x)
+            {
+                auto const sourceX = std::min(blockX * BlockDimension + x, width - 1);
+                auto const * source = pixels + (static_cast<size_t>(sourceY) * width + sourceX) * componentCount;
+                auto & pixel = outPixels[y * BlockDimension + x];
+                for (uint32_t component = 0; component < 4; ++component)
+                {
+                    if (component < componentCount)
+                    {
+                        pixel[component] = source[component];
+                    }
+                    else
+                    {
+                        pixel[component] = component == 3 ? 255 : 0;
+                    }
+                }
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Endpoints are the extremes of the block in the 8 value mode, So no value is off by more than a fourteenth of the range
+    static void EncodeBC4(Pixels const & pixels, uint32_t const component, uint8_t * outBlock)
+    {
+        int minValue = 255;
+        int maxValue = 0;
+        for (auto const & pixel : pixels)
+        {
+            minValue = std::min<int>(minValue, pixel[component]);
+            maxValue = std::max<int>(maxValue, pixel[component]);
+        }
+        // Equal endpoints select the 6 value mode where index 0 is the first endpoint
+        outBlock[0] = static_cast<uint8_t>(maxValue);
+        outBlock[1] = static_cast<uint8_t>(minValue);
+
+        uint64_t indices = 0;
+        auto const range = maxValue - minValue;
+        if (range > 0)
+        {
+            for (uint32_t i = 0; i < PixelCount; ++i)
+            {
+                // Palette is max, min and then six steps going down from max
+                auto const step = ((pixels[i][component] - minValue) * 7 + range / 2) / range;
+                uint64_t const index = step == 7 ? 0 : (step == 0 ? 1 : 8 - step);
+                indices |= index << (3 * i);
+            }
+        }
+        for (int i = 0; i < 6; ++i)
+        {
+            outBlock[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Closest 7 bit values and p bit for one endpoint, Both p bits are tried since they are shared by all components.
+    // Opaque endpoints always take p bit 1, Otherwise a smaller color error could turn alpha into 254.
+    static void QuantizeBC7Endpoint(
+        Color const & color,
+        std::array<int, 4> & outValues,
+        int & outPBit
+    )
+    {
+        auto bestError = std::numeric_limits<float>::max();
+        for (int pBit = color[3] > 254.5f ? 1 : 0; pBit < 2; ++pBit)
+        {
+            std::array<int, 4> values {};
+            float error = 0.0f;
+            for (int component = 0; component < 4; ++component)
+            {
+                values[component] = std::clamp(static_cast<int>(std::lround((color[component] - static_cast<float>(pBit)) * 0.5f)), 0, 127);
+                auto const difference = static_cast<float>(values[component] * 2 + pBit) - color[component];
+                error += difference * difference;
+            }
+            if (error < bestError)
+            {
+                bestError = error;
+                outValues = values;
+                outPBit = pBit;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static BC7Endpoints QuantizeBC7Endpoints(Color const & first, Color const & second)
+    {
+        BC7Endpoints endpoints {};
+        QuantizeBC7Endpoint(first, endpoints.values[0], endpoints.pBits[0]);
+        QuantizeBC7Endpoint(second, endpoints.values[1], endpoints.pBits[1]);
+        return endpoints;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Picks the closest palette entry for every pixel and returns the squared error of the block
+    static int SelectBC7Indices(
+        Pixels const & pixels,
+        BC7Endpoints const & endpoints,
+        Indices & outIndices
+    )
+    {
+        std::array<std::array<int, 4>, 2> expanded {};
+        for (int endpoint = 0; endpoint < 2; ++endpoint)
+        {
+            for (int component = 0; component < 4; ++component)
+            {
+                expanded[endpoint][component] = endpoints.values[endpoint][component] * 2 + endpoints.pBits[endpoint];
+            }
+        }
+
+        std::array<std::array<int, 4>, 16> palette {};
+        for (int index = 0; index < 16; ++index)
+        {
+            auto const weight = BC7Weights[index];
+            for (int component = 0; component < 4; ++component)
+            {
+                palette[index][component] = ((64 - weight) * expanded[0][component] + weight * expanded[1][component] + 32) >> 6;
+            }
+        }
+
+        std::array<int, 4> direction {};
+        int directionLengthSqr = 0;
+        for (int component = 0; component < 4; ++component)
+        {
+            direction[component] = expanded[1][component] - expanded[0][component];
+            directionLengthSqr += direction[component] * direction[component];
+        }
+
+        int totalError = 0;
+        for (uint32_t i = 0; i < PixelCount; ++i)
+        {
+            auto const & pixel = pixels[i];
+            // Palette lies on the segment between the endpoints, So the projection is at most one index away from the closest entry
+            int guess = 0;
+            if (directionLengthSqr > 0)
+            {
+                int dot = 0;
+                for (int component = 0; component < 4; ++component)
+                {
+                    dot += (pixel[component] - expanded[0][component]) * direction[component];
+                }
+                guess = std::clamp((dot * 15 + directionLengthSqr / 2) / directionLengthSqr, 0, 15);
+            }
+
+            auto bestError = std::numeric_limits<int>::max();
+            for (int index = std::max(guess - 1, 0); index <= std::min(guess + 1, 15); ++index)
+            {
+                int error = 0;
+                for (int component = 0; component < 4; ++component)
+                {
+                    auto const difference = palette[index][component] - pixel[component];
+                    error += difference * difference;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    outIndices[i] = static_cast<uint8_t>(index);
+                }
+            }
+            totalError += bestError;
+        }
+        return totalError;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Least squares endpoints for the weights of the chosen indices, Fails when every pixel uses the same weight
+    static bool FitBC7Endpoints(
+        Pixels const & pixels,
+        Indices const & indices,
+        Color & outFirst,
+        Color & outSecond
+    )
+    {
+        float firstFirst = 0.0f;
+        float firstSecond = 0.0f;
+        float secondSecond = 0.0f;
+        Color firstPixel {};
+        Color secondPixel {};
+        for (uint32_t i = 0; i < PixelCount; ++i)
+        {
+            auto const secondWeight = static_cast<float>(BC7Weights[indices[i]]) / 64.0f;
+            auto const firstWeight = 1.0f - secondWeight;
+            firstFirst += firstWeight * firstWeight;
+            firstSecond += firstWeight * secondWeight;
+            secondSecond += secondWeight * secondWeight;
+            for (int component = 0; component < 4; ++component)
+            {
+                firstPixel[component] += firstWeight * pixels[i][component];
+                secondPixel[component] += secondWeight * pixels[i][component];
+            }
+        }
+
+        auto const determinant = firstFirst * secondSecond - firstSecond * firstSecond;
+        if (std::abs(determinant) < 1e-6f)
+        {
+            return false;
+        }
+        auto const inverseDeterminant = 1.0f / determinant;
+        for (int component = 0; component < 4; ++component)
+        {
+            outFirst[component] = std::clamp(
+                (firstPixel[component] * secondSecond - secondPixel[component] * firstSecond) * inverseDeterminant,
+                0.0f,
+                255.0f
+            );
+            outSecond[component] = std::clamp(
+                (secondPixel[component] * firstFirst - firstPixel[component] * firstSecond) * inverseDeterminant,
+                0.0f,
+                255.0f
+            );
+        }
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Start points of the refinement, The colors are spread along the principal axis of the block
+    static void PrincipalAxisEndpoints(
+        Pixels const & pixels,
+        Color & outFirst,
+        Color & outSecond
+    )
+    {
+        Color mean {};
+        for (auto const & pixel : pixels)
+        {
+            for (int component = 0; component < 4; ++component)
+            {
+                mean[component] += pixel[component];
+            }
+        }
+        for (auto & value : mean)
+        {
+            value /= static_cast<float>(PixelCount);
+        }
+
+        std::array<Color, 4> covariance {};
+        for (auto const & pixel : pixels)
+        {
+            Color difference {};
+            for (int component = 0; component < 4; ++component)
+            {
+                difference[component] = pixel[component] - mean[component];
+            }
+            for (int row = 0; row < 4; ++row)
+            {
+                for (int column = row; column < 4; ++column)
+                {
+                    covariance[row][column] += difference[row] * difference[column];
+                }
+            }
+        }
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < row; ++column)
+            {
+                covariance[row][column] = covariance[column][row];
+            }
+        }
+
+        // Power iteration starting from the variances, They are never orthogonal to the principal axis
+        Color axis {covariance[0][0], covariance[1][1], covariance[2][2], covariance[3][3]};
+        for (int iteration = 0; iteration < PowerIterationCount; ++iteration)
+        {
+            Color next {};
+            float maxValue = 0.0f;
+            for (int row = 0; row < 4; ++row)
+            {
+                for (int column = 0; column < 4; ++column)
+                {
+                    next[row] += covariance[row][column] * axis[column];
+                }
+                maxValue = std::max(maxValue, std::abs(next[row]));
+            }
+            if (maxValue <= 0.0f)
+            {
+                break;
+            }
+            for (int component = 0; component < 4; ++component)
+            {
+                axis[component] = next[component] / maxValue;
+            }
+        }
+
+        float lengthSqr = 0.0f;
+        for (auto const value : axis)
+        {
+            lengthSqr += value * value;
+        }
+
+        float minProjection = 0.0f;
+        float maxProjection = 0.0f;
+        if (lengthSqr > 0.0f)
+        {
+            auto const inverseLength = 1.0f / std::sqrt(lengthSqr);
+            for (auto & value : axis)
+            {
+                value *= inverseLength;
+            }
+            minProjection = std::numeric_limits<float>::max();
+            maxProjection = std::numeric_limits<float>::lowest();
+            for (auto const & pixel : pixels)
+            {
+                float projection = 0.0f;
+                for (int component = 0; component < 4; ++component)
+                {
+                    projection += (pixel[component] - mean[component]) * axis[component];
+                }
+                minProjection = std::min(minProjection, projection);
+                maxProjection = std::max(maxProjection, projection);
+            }
+        }
+
+        for (int component = 0; component < 4; ++component)
+        {
+            outFirst[component] = std::clamp(mean[component] + minProjection * axis[component], 0.0f, 255.0f);
+            outSecond[component] = std::clamp(mean[component] + maxProjection * axis[component], 0.0f, 255.0f);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Mode 6 has a single subset with 7 bit RGBA endpoints, A p bit per endpoint and 4 bit indices.
+    // It handles smooth color and alpha well, The multi subset modes would only help blocks with sharp color edges.
+    static void EncodeBC7(Pixels const & pixels, uint8_t * outBlock)
+    {
+        Color first {};
+        Color second {};
+        PrincipalAxisEndpoints(pixels, first, second);
+
+        auto endpoints = QuantizeBC7Endpoints(first, second);
+        Indices indices {};
+        auto error = SelectBC7Indices(pixels, endpoints, indices);
+
+        for (int iteration = 0; iteration < BC7RefineCount && error > 0; ++iteration)
+        {
+            if (FitBC7Endpoints(pixels, indices, first, second) == false)
+            {
+                break;
+            }
+            auto const fittedEndpoints = QuantizeBC7Endpoints(first, second);
+            Indices fittedIndices {};
+            auto const fittedError = SelectBC7Indices(pixels, fittedEndpoints, fittedIndices);
+            if (fittedError >= error)
+            {
+                break;
+            }
+            endpoints = fittedEndpoints;
+            indices = fittedIndices;
+            error = fittedError;
+        }
+
+        // Index of the first pixel is stored without its top bit, Swapping the endpoints mirrors the weights
+        if (indices[0] >= 8)
+        {
+            std::swap(endpoints.values[0], endpoints.values[1]);
+            std::swap(endpoints.pBits[0], endpoints.pBits[1]);
+            for (auto & index : indices)
+            {
+                index = static_cast<uint8_t>(15 - index);
+            }
+        }
+
+        BitWriter writer {};
+        writer.write(1 << 6, 7);
+        for (int component = 0; component < 4; ++component)
+        {
+            writer.write(endpoints.values[0][component], 7);
+            writer.write(endpoints.values[1][component], 7);
+        }
+        writer.write(endpoints.pBits[0], 1);
+        writer.write(endpoints.pBits[1], 1);
+        writer.write(indices[0], 3);
+        for (uint32_t i = 1; i < PixelCount; ++i)
+        {
+            writer.write(indices[i], 4);
+        }
+        writer.store(outBlock);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Compress(
+        Codec const codec,
+        CBlob const inputPixels,
+        uint32_t const width,
+        uint32_t const height,
+        uint32_t const componentCount,
+        Blob const outputBlocks
+    )
+    {
+        MFA_ASSERT(width > 0 && height > 0);
+        MFA_ASSERT(componentCount >= 1 && componentCount <= 4);
+        MFA_ASSERT(inputPixels.len >= static_cast<size_t>(width) * height * componentCount);
+        MFA_ASSERT(outputBlocks.len >= CompressedSizeBytes(codec, width, height));
+
+        auto const * input = inputPixels.as<uint8_t>();
+        auto * output = outputBlocks.as<uint8_t>();
+        auto const blockCountX = (width + BlockDimension - 1) / BlockDimension;
+        auto const blockCountY = (height + BlockDimension - 1) / BlockDimension;
+        auto const blockSize = BlockSizeBytes(codec);
+
+        auto const processBand = [&](uint32_t const beginRow, uint32_t const endRow)->void
+        {
+            Pixels pixels {};
+            for (uint32_t blockY = beginRow; blockY < endRow; ++blockY)
+            {
+                for (uint32_t blockX = 0; blockX < blockCountX; ++blockX)
+                {
+                    LoadBlock(input, width, height, componentCount, blockX, blockY, pixels);
+                    auto * block = output + (static_cast<size_t>(blockY) * blockCountX + blockX) * blockSize;
+                    switch (codec)
+                    {
+                    case Codec::BC4:
+                        EncodeBC4(pixels, 0, block);
+                        break;
+                    case Codec::BC5:
+                        EncodeBC4(pixels, 0, block);
+                        EncodeBC4(pixels, 1, block + 8);
+                        break;
+                    case Codec::BC7:
+                        EncodeBC7(pixels, block);
+                        break;
+                    }
+                }
+            }
+        };
+
+        auto const rowsPerBand = std::max<uint32_t>(BandBlockCount / blockCountX, 1);
+        JS::ParallelFor(blockCountY, rowsPerBand, processBand);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "engine/BedrockMemory.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MFA::BlockCompressor
+{
+
+    enum class Codec : uint8_t
+    {
+        BC4,            // Red only, 8 bytes per block
+        BC5,            // Red and green as two BC4 blocks, 16 bytes per block
+        BC7             // All four components, 16 bytes per block, Every block is written in mode 6
+    };
+
+    // Width and height of a block in pixels
+    static constexpr uint32_t BlockDimension = 4;
+
+    [[nodiscard]]
+    size_t BlockSizeBytes(Codec codec);
+
+    // Partial blocks on the right and bottom edges take a whole block
+    [[nodiscard]]
+    size_t CompressedSizeBytes(Codec codec, uint32_t width, uint32_t height);
+
+    // Encodes one level of an 8 bit per component image.
+    // Missing color components are read as 0 and missing alpha as 255, Partial blocks repeat the edge pixels.
+    // Rows of blocks are split between the threads of the job system.
+    void Compress(
+        Codec codec,
+        CBlob inputPixels,
+        uint32_t width,
+        uint32_t height,
+        uint32_t componentCount,
+        Blob outputBlocks
+    );
+
+}
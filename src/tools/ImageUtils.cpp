@@ -10,24 +10,36 @@
 #include "libs/stb_image/stb_image.h"
 #include "libs/stb_image/stb_image_resize.h"
 #include "libs/tiny_ktx/tinyktx.h"
+#include "libs/zstd/zstd.h"
 
 // TODO: Separate this file into multiple ones
 namespace MFA::Utils::UncompressedTexture
 {
 
     LoadResult Load(Data & outImageData, std::string const & path, bool const prefer_srgb)
+    {
+        auto const rawFile = Importer::ReadRawFile(path);
+        if (rawFile.valid() == false)
+        {
+            return LoadResult::Invalid;
+        }
+        return Load(outImageData, rawFile.data->memory, prefer_srgb);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    LoadResult Load(Data & outImageData, CBlob const fileData, bool const prefer_srgb)
     {
         using namespace AssetSystem;
         LoadResult ret = LoadResult::Invalid;
 
-        auto const rawFile = Importer::ReadRawFile(path);
-        if (rawFile.valid() == false)
+        if (fileData.ptr == nullptr || fileData.len == 0)
         {
             return ret;
         }
         auto * readData = stbi_load_from_memory(
-            rawFile.data->memory.ptr,
-            static_cast<int>(rawFile.data->memory.len),
+            fileData.ptr,
+            static_cast<int>(fileData.len),
             &outImageData.width,
             &outImageData.height,
             &outImageData.stbi_components,
@@ -44,7 +56,7 @@ namespace MFA::Utils::UncompressedTexture
                     outImageData.height *
                     outImageData.stbi_components *
                     sizeof(uint8_t)
-            });
+            }, Memory::Tag::Texture);
             outImageData.components = outImageData.stbi_components;
             if (prefer_srgb)
             {
@@ -92,7 +104,7 @@ namespace MFA::Utils::UncompressedTexture
                     outImageData.components *
                     sizeof(uint8_t);
                 // TODO We need allocation system (Leak checking)
-                outImageData.pixels = Memory::Alloc(size);
+                outImageData.pixels = Memory::Alloc(size, Memory::Tag::Texture);
                 MFA_ASSERT(outImageData.pixels->memory.ptr != nullptr);
                 auto * pixels_array = outImageData.pixels->memory.as<uint8_t>();
                 auto const * stbi_pixels_array = outImageData.stbi_pixels->memory.as<uint8_t>();
@@ -232,7 +244,7 @@ namespace MFA::Utils::DDSTexture
         {
             auto const fileSize = file->size();
             MFA_ASSERT(fileSize > 0);
-            outImageData.asset = Memory::Alloc(fileSize);
+            outImageData.asset = Memory::Alloc(fileSize, Memory::Tag::Texture);
             auto const readBytes = file->read(outImageData.asset->memory);
             if (readBytes == outImageData.asset->memory.len)
             {
@@ -380,8 +392,8 @@ namespace MFA::Utils::DDSTexture
                                             MFA_ASSERT(mipmap_array[i].width > 0);
                                             mipmap_array[i].height = current_height;
                                             MFA_ASSERT(mipmap_array[i].height > 0);
-                                            current_width /= 2;
-                                            current_height /= 2;
+                                            current_width = Math::Max<uint32_t>(current_width / 2, 1);
+                                            current_height = Math::Max<uint32_t>(current_height / 2, 1);
                                             data_current_ptr += mipmap_array[i].data.len;
                                             mipmaps_total_len += mipmap_array[i].data.len;
                                         }
@@ -465,10 +477,10 @@ namespace MFA::Utils::KTXTexture
     {
 #if defined(__DESKTOP__) || defined(__IOS__)
         auto * file = static_cast<FS::FileHandle *>(userData);
-        return file->seek(static_cast<int>(offset), FS::Origin::Start);
+        return file->seek(offset, FS::Origin::Start);
 #elif defined(__ANDROID__)
         auto * handle = static_cast<FS::AndroidAssetHandle *>(userData);
-        return FS::Android_Seek(handle, static_cast<int>(offset), FS::Origin::Start);
+        return FS::Android_Seek(handle, offset, FS::Origin::Start);
 #else
 #error Os not handled
 #endif
@@ -654,7 +666,8 @@ namespace MFA::Utils::KTXTexture
                 int const imageSize = TinyKtx_ImageSize(ctx, i);
                 MFA_ASSERT(imageSize > 0);
                 totalImageSize += imageSize;
-                MFA_ASSERT(previousImageSize == -1 || imageSize < previousImageSize);
+                // Smallest levels of block compressed textures are a single block each
+                MFA_ASSERT(previousImageSize == -1 || imageSize <= previousImageSize);
                 previousImageSize = imageSize;
             }
 
@@ -699,4 +712,283 @@ namespace MFA::Utils::KTXTexture
         return CBlob{ imagePtr, imageSize };
     }
 
+    //-------------------------------------------------------------------------------------------------
+
+#if defined(__DESKTOP__) || defined(__IOS__)
+    static void tinyktxCallbackWrite(void * userData, void const * data, size_t const size)
+    {
+        auto * file = static_cast<FS::FileHandle *>(userData);
+        auto const writeCount = file->write(CBlob{ data, size });
+        MFA_ASSERT(writeCount == size);
+    }
+#endif
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool Save(AS::Texture const & texture, std::string const & path)
+    {
+        MFA_ASSERT(texture.isValid());
+
+        TinyKtx_Format const tinyKtxFormat = [&texture]() -> TinyKtx_Format
+        {
+            switch (texture.GetFormat())
+            {
+            case TextureFormat::BC7_UNorm_sRGB_RGB:
+            case TextureFormat::BC7_UNorm_sRGB_RGBA:
+                return TKTX_BC7_SRGB_BLOCK;
+            case TextureFormat::BC7_UNorm_Linear_RGB:
+            case TextureFormat::BC7_UNorm_Linear_RGBA:
+                return TKTX_BC7_UNORM_BLOCK;
+            case TextureFormat::BC5_UNorm_Linear_RG:
+                return TKTX_BC5_UNORM_BLOCK;
+            case TextureFormat::BC5_SNorm_Linear_RG:
+                return TKTX_BC5_SNORM_BLOCK;
+            case TextureFormat::BC4_UNorm_Linear_R:
+                return TKTX_BC4_UNORM_BLOCK;
+            case TextureFormat::BC4_SNorm_Linear_R:
+                return TKTX_BC4_SNORM_BLOCK;
+            case TextureFormat::UNCOMPRESSED_UNORM_R8G8B8A8_LINEAR:
+                return TKTX_R8G8B8A8_UNORM;
+            case TextureFormat::UNCOMPRESSED_UNORM_R8G8B8A8_SRGB:
+                return TKTX_R8G8B8A8_SRGB;
+            case TextureFormat::UNCOMPRESSED_UNORM_R8G8_LINEAR:
+                return TKTX_R8G8_UNORM;
+            case TextureFormat::UNCOMPRESSED_UNORM_R8_LINEAR:
+                return TKTX_R8_UNORM;
+            default:
+                return TKTX_UNDEFINED;
+            }
+        } ();
+        if (tinyKtxFormat == TKTX_UNDEFINED)
+        {
+            MFA_LOG_WARN("KTXTexture::Save: Texture format is not supported");
+            return false;
+        }
+
+#if defined(__DESKTOP__) || defined(__IOS__)
+        auto const fileHandle = FS::OpenFile(path, FS::Usage::Write);
+        if (fileHandle == nullptr || FS::FileIsUsable(fileHandle.get()) == false)
+        {
+            return false;
+        }
+
+        auto const mipCount = texture.GetMipCount();
+        std::vector<uint32_t> mipSizes (mipCount);
+        std::vector<void const *> mipData (mipCount);
+        auto const buffer = texture.GetBuffer();
+        for (uint8_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+        {
+            auto const & mipmap = texture.GetMipmap(mipLevel);
+            mipSizes[mipLevel] = mipmap.size;
+            mipData[mipLevel] = buffer.ptr + mipmap.offset;
+        }
+
+        TinyKtx_WriteCallbacks callbacks{
+            &tinyktxCallbackError,
+            &tinyktxCallbackAlloc,
+            &tinyktxCallbackFree,
+            &tinyktxCallbackWrite
+        };
+
+        auto const & dimension = texture.GetMipmap(0).dimension;
+        return TinyKtx_WriteImage(
+            &callbacks,
+            fileHandle.get(),
+            dimension.width,
+            dimension.height,
+            dimension.depth,
+            texture.GetSlices(),
+            mipCount,
+            tinyKtxFormat,
+            false,
+            mipSizes.data(),
+            mipData.data()
+        );
+#else
+        // Assets are read only on this platform
+        return false;
+#endif
+    }
+
+}
+
+namespace MFA::Utils::KTX2Texture
+{
+
+    static constexpr uint8_t Identifier[12] {
+        0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    TextureFormat ConvertVkFormat(uint32_t const vkFormat)
+    {
+        switch (static_cast<VkFormat>(vkFormat))
+        {
+        case VkFormat::BC7_sRGB:
+            return TextureFormat::BC7_UNorm_sRGB_RGBA;
+        case VkFormat::BC7_UNorm:
+            return TextureFormat::BC7_UNorm_Linear_RGBA;
+        case VkFormat::BC6H_UFloat:
+            return TextureFormat::BC6H_UFloat_Linear_RGB;
+        case VkFormat::BC6H_SFloat:
+            return TextureFormat::BC6H_SFloat_Linear_RGB;
+        case VkFormat::BC5_UNorm:
+            return TextureFormat::BC5_UNorm_Linear_RG;
+        case VkFormat::BC5_SNorm:
+            return TextureFormat::BC5_SNorm_Linear_RG;
+        case VkFormat::BC4_UNorm:
+            return TextureFormat::BC4_UNorm_Linear_R;
+        case VkFormat::BC4_SNorm:
+            return TextureFormat::BC4_SNorm_Linear_R;
+        case VkFormat::R8G8B8A8_UNorm:
+            return TextureFormat::UNCOMPRESSED_UNORM_R8G8B8A8_LINEAR;
+        case VkFormat::R8G8B8A8_sRGB:
+            return TextureFormat::UNCOMPRESSED_UNORM_R8G8B8A8_SRGB;
+        case VkFormat::R8G8_UNorm:
+            return TextureFormat::UNCOMPRESSED_UNORM_R8G8_LINEAR;
+        case VkFormat::R8_UNorm:
+            return TextureFormat::UNCOMPRESSED_UNORM_R8_LINEAR;
+        case VkFormat::R8_sRGB:
+            return TextureFormat::UNCOMPRESSED_UNORM_R8_SRGB;
+        default:
+            return TextureFormat::INVALID;
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::shared_ptr<Data> Load(LoadResult & loadResult, std::string const & path)
+    {
+        loadResult = LoadResult::Invalid;
+
+#if defined(__DESKTOP__) || defined(__IOS__)
+        auto fileHandle = FS::OpenFile(path, FS::Usage::Read);
+        if (fileHandle == nullptr || FS::FileIsUsable(fileHandle.get()) == false)
+        {
+            loadResult = LoadResult::FileNotExists;
+            return nullptr;
+        }
+
+        auto data = std::make_shared<Data>();
+        auto & header = data->header;
+
+        auto const fileSize = fileHandle->size();
+        if (
+            fileSize < sizeof(Header) ||
+            fileHandle->read(Blob{&header, sizeof(Header)}) != sizeof(Header) ||
+            ::memcmp(header.identifier, Identifier, sizeof(Identifier)) != 0
+        )
+        {
+            loadResult = LoadResult::CorruptData_InvalidIdentifier;
+            return nullptr;
+        }
+
+        // Zlib and BasisLZ need a decoder that the engine does not ship, Such files must be re-encoded with zstd or without supercompression
+        if (
+            header.supercompression_scheme != static_cast<uint32_t>(SupercompressionScheme::None) &&
+            header.supercompression_scheme != static_cast<uint32_t>(SupercompressionScheme::Zstandard)
+        )
+        {
+            MFA_LOG_WARN(
+                "KTX2Texture::Load: Supercompression scheme %u is not supported, Path: %s",
+                header.supercompression_scheme,
+                path.c_str()
+            );
+            loadResult = LoadResult::NotSupported_Supercompression;
+            return nullptr;
+        }
+
+        data->format = ConvertVkFormat(header.vk_format);
+        if (data->format == TextureFormat::INVALID)
+        {
+            MFA_LOG_WARN("KTX2Texture::Load: VkFormat %u is not supported, Path: %s", header.vk_format, path.c_str());
+            loadResult = LoadResult::NotSupported_Format;
+            return nullptr;
+        }
+
+        if (header.face_count > 1)
+        {
+            loadResult = LoadResult::NotSupported_Cubemap;
+            return nullptr;
+        }
+
+        // Level count of 0 asks the loader to generate the mip chain, We only use the base level in that case
+        auto const levelCount = Math::Max<uint32_t>(header.level_count, 1);
+        auto const levelIndexSize = sizeof(LevelIndex) * levelCount;
+        data->levels.resize(levelCount);
+        if (
+            fileSize < sizeof(Header) + levelIndexSize ||
+            fileHandle->read(Blob{data->levels.data(), levelIndexSize}) != levelIndexSize
+        )
+        {
+            loadResult = LoadResult::CorruptData_InvalidLevelIndex;
+            return nullptr;
+        }
+
+        auto const isSupercompressed = header.supercompression_scheme != static_cast<uint32_t>(SupercompressionScheme::None);
+        for (auto const & level : data->levels)
+        {
+            if (
+                level.byte_length == 0 ||
+                level.uncompressed_byte_length == 0 ||
+                (isSupercompressed == false && level.byte_length != level.uncompressed_byte_length) ||
+                level.byte_offset > fileSize ||
+                level.byte_length > fileSize - level.byte_offset
+            )
+            {
+                loadResult = LoadResult::CorruptData_InvalidLevelIndex;
+                return nullptr;
+            }
+        }
+
+        data->fileHandle = std::move(fileHandle);
+        loadResult = LoadResult::Success;
+        return data;
+#else
+        MFA_LOG_WARN("KTX2Texture::Load: Ktx2 files are not supported on this platform yet");
+        return nullptr;
+#endif
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool ReadLevel(Data const & data, uint32_t const level, Blob const & destination)
+    {
+        MFA_ASSERT(data.fileHandle != nullptr);
+        MFA_ASSERT(level < data.levels.size());
+
+        auto const & levelIndex = data.levels[level];
+        if (destination.ptr == nullptr || destination.len != levelIndex.uncompressed_byte_length)
+        {
+            return false;
+        }
+
+        if (data.fileHandle->seek(static_cast<int64_t>(levelIndex.byte_offset), FS::Origin::Start) == false)
+        {
+            return false;
+        }
+
+        if (data.header.supercompression_scheme == static_cast<uint32_t>(SupercompressionScheme::None))
+        {
+            return data.fileHandle->read(destination) == destination.len;
+        }
+
+        MFA_ASSERT(data.header.supercompression_scheme == static_cast<uint32_t>(SupercompressionScheme::Zstandard));
+        auto const compressed = Memory::Alloc(levelIndex.byte_length, Memory::Tag::Texture);
+        if (data.fileHandle->read(compressed->memory) != compressed->memory.len)
+        {
+            return false;
+        }
+
+        // Each level is a single zstd frame
+        auto const decompressedSize = ZSTD_decompress(
+            destination.ptr,
+            destination.len,
+            compressed->memory.ptr,
+            compressed->memory.len
+        );
+        return ZSTD_isError(decompressedSize) == 0 && decompressedSize == destination.len;
+    }
+
 }
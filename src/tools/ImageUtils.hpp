@@ -50,6 +50,9 @@ namespace MFA::Utils
 
         LoadResult Load(Data & outImageData, std::string const & path, bool prefer_srgb);
 
+        // Decodes an image file that is already in memory
+        LoadResult Load(Data & outImageData, CBlob fileData, bool prefer_srgb);
+
         struct ResizeInputParams
         {
             CBlob inputImagePixels{};
@@ -376,5 +379,110 @@ namespace MFA::Utils
 
         CBlob GetMipBlob(Data * imageData, int mipIndex);
 
+        // Writes all mip levels of the texture, Supports the same formats as Load
+        bool Save(AS::Texture const & texture, std::string const & path);
+
     } // KTXTexture
+
+    namespace KTX2Texture
+    {
+        /*
+         *  KTX2 source :
+         *  https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+         *  Only the header and the level index are read on load, Level data stays in the file until ReadLevel
+         *  Zstd supercompression is decoded by ReadLevel. BasisLZ, zlib and Basis universal (UASTC/ETC1S) payloads
+         *  are rejected by Load until a transcoder is vendored, Such files must be exported with a BC vkFormat.
+         */
+#pragma pack (push, 1)
+        struct Header
+        {
+            uint8_t         identifier[12];
+            uint32_t        vk_format;
+            uint32_t        type_size;
+            uint32_t        pixel_width;
+            uint32_t        pixel_height;
+            uint32_t        pixel_depth;
+            uint32_t        layer_count;
+            uint32_t        face_count;
+            uint32_t        level_count;
+            uint32_t        supercompression_scheme;
+            uint32_t        dfd_byte_offset;
+            uint32_t        dfd_byte_length;
+            uint32_t        kvd_byte_offset;
+            uint32_t        kvd_byte_length;
+            uint64_t        sgd_byte_offset;
+            uint64_t        sgd_byte_length;
+        };
+#pragma pack (pop)
+        static_assert(sizeof(Header) == 80);
+
+#pragma pack (push, 1)
+        struct LevelIndex
+        {
+            uint64_t        byte_offset;
+            uint64_t        byte_length;
+            uint64_t        uncompressed_byte_length;
+        };
+#pragma pack (pop)
+        static_assert(sizeof(LevelIndex) == 24);
+
+        enum class SupercompressionScheme : uint32_t
+        {
+            None = 0,
+            BasisLZ = 1,
+            Zstandard = 2,
+            ZLIB = 3
+        };
+
+        // Subset of VkFormat that the engine has a texture format for, Values are fixed by the vulkan spec
+        enum class VkFormat : uint32_t
+        {
+            Undefined = 0,                  // Basis universal payloads
+            R8_UNorm = 9,
+            R8_SNorm = 10,
+            R8_sRGB = 15,
+            R8G8_UNorm = 16,
+            R8G8B8A8_UNorm = 37,
+            R8G8B8A8_sRGB = 43,
+            BC4_UNorm = 139,
+            BC4_SNorm = 140,
+            BC5_UNorm = 141,
+            BC5_SNorm = 142,
+            BC6H_UFloat = 143,
+            BC6H_SFloat = 144,
+            BC7_UNorm = 145,
+            BC7_sRGB = 146
+        };
+
+        struct Data
+        {
+            Header header{};
+            std::vector<LevelIndex> levels{};              // Level 0 is the largest
+            TextureFormat format = TextureFormat::INVALID;
+            std::shared_ptr<FileSystem::FileHandle> fileHandle{};
+        };
+
+        enum class LoadResult
+        {
+            Invalid,
+            Success,
+            FileNotExists,
+            CorruptData_InvalidIdentifier,
+            CorruptData_InvalidLevelIndex,
+            NotSupported_Format,
+            NotSupported_Supercompression,
+            NotSupported_Cubemap
+        };
+
+        [[nodiscard]]
+        TextureFormat ConvertVkFormat(uint32_t vkFormat);
+
+        std::shared_ptr<Data> Load(LoadResult & loadResult, std::string const & path);
+
+        // Reads the level from the file into destination, destination.len must match the uncompressed level length.
+        // Uncompressed levels are read directly into destination, Zstd levels are read into a temporary buffer first.
+        [[nodiscard]]
+        bool ReadLevel(Data const & data, uint32_t level, Blob const & destination);
+
+    } // KTX2Texture
 } // MFA::Utils
@@ -14,10 +14,12 @@
 #include "engine/asset_system/AssetBaseMesh.hpp"
 #include "engine/asset_system/AssetModel.hpp"
 #include "engine/asset_system/AssetShader.hpp"
+#include "tools/BlockCompressor.hpp"
 
 #include "libs/tiny_obj_loader/tiny_obj_loader.h"
 #include "libs/tiny_gltf_loader/tiny_gltf_loader.h"
 
+#include <filesystem>
 #include <utility>
 
 namespace MFA::Importer
@@ -33,11 +35,9 @@ namespace MFA::Importer
         std::shared_ptr<AS::Texture> texture{};
         Utils::UncompressedTexture::Data imageData{};
         auto const use_srgb = options.preferSrgb;
-        auto const load_image_result = Utils::UncompressedTexture::Load(
-            imageData,
-            path,
-            use_srgb
-        );
+        auto const load_image_result = options.fileData != nullptr
+            ? Utils::UncompressedTexture::Load(imageData, options.fileData->memory, use_srgb)
+            : Utils::UncompressedTexture::Load(imageData, path, use_srgb);
         if (load_image_result == Utils::UncompressedTexture::LoadResult::Success)
         {
             MFA_ASSERT(imageData.valid());
@@ -101,9 +101,6 @@ namespace MFA::Importer
         ImportTextureOptions const & options
     )
     {
-        using namespace Utils::UncompressedTexture;
-
-        auto const useSrgb = options.preferSrgb;            // TODO: Variable not used! Why!
         AS::Texture::Dimensions const originalImageDimension{
             static_cast<uint32_t>(width),
             static_cast<uint32_t>(height),
@@ -112,6 +109,8 @@ namespace MFA::Importer
         uint8_t const mipCount = options.tryToGenerateMipmaps
             ? AS::Texture::ComputeMipCount(originalImageDimension)
             : 1;
+        // Mipmap generator only handles 2D images
+        MFA_ASSERT(mipCount == 1 || (depth == 1 && slices == 1));
 
         auto const bufferSize = AS::Texture::CalculateUncompressedTextureRequiredDataSize(
             format,
@@ -128,12 +127,22 @@ namespace MFA::Importer
             format,
             slices,
             depth,
-            Memory::Alloc(bufferSize)
+            Memory::Alloc(bufferSize, Memory::Tag::Texture)
         );
 
-        // Generating mipmaps (TODO : Code needs debugging)
         texture->addMipmap(originalImageDimension, originalImagePixels);
 
+        // Each level is filtered from the previous one, So the whole chain costs about a third of the first level
+        MipmapGenerator::Params const mipmapParams {
+            .filter = options.mipmapFilter,
+            .isSrgb = AS::Texture::FormatTable[static_cast<unsigned>(format)].color_space == 1
+        };
+        auto previousMipDims = originalImageDimension;
+        CBlob previousMipPixels = originalImagePixels;
+
+        // Levels are copied into the texture, So the intermediate pixels only need scratch memory
+        Memory::ScratchScope scratch {};
+
         for (uint8_t mipLevel = 1; mipLevel < mipCount; mipLevel++)
         {
             auto const currentMipDims = AS::Texture::MipDimensions(
@@ -146,25 +155,26 @@ namespace MFA::Importer
                 slices,
                 currentMipDims
             );
-            auto const mipMapPixels = Memory::Alloc(currentMipSizeBytes);
-
-            // Resize
-            ResizeInputParams inputParams{
-                .inputImagePixels = originalImagePixels,
-                .inputImageWidth = static_cast<int>(originalImageDimension.width),
-                .inputImageHeight = static_cast<int>(originalImageDimension.height),
-                .componentsCount = components,
-                .outputImagePixels = mipMapPixels->memory,
-                .outputWidth = static_cast<int>(currentMipDims.width),
-                .outputHeight = static_cast<int>(currentMipDims.height),
-            };
-            auto const resizeResult = Utils::UncompressedTexture::Resize(inputParams);
-            MFA_ASSERT(resizeResult == true);
+            auto const mipMapPixels = scratch.Alloc(currentMipSizeBytes);
+
+            MipmapGenerator::Downsample(
+                previousMipPixels,
+                previousMipDims.width,
+                previousMipDims.height,
+                components,
+                mipMapPixels,
+                currentMipDims.width,
+                currentMipDims.height,
+                mipmapParams
+            );
 
             texture->addMipmap(
                 currentMipDims,
-                mipMapPixels->memory
+                mipMapPixels
             );
+
+            previousMipDims = currentMipDims;
+            previousMipPixels = mipMapPixels;
         }
 
         MFA_ASSERT(texture->isValid());
@@ -191,7 +201,7 @@ namespace MFA::Importer
                 imageData->format,
                 imageData->sliceCount,
                 imageData->depth,
-                Memory::Alloc(imageData->totalImageSize)
+                Memory::Alloc(imageData->totalImageSize, Memory::Tag::Texture)
             );
 
             auto width = imageData->width;
@@ -229,10 +239,277 @@ namespace MFA::Importer
 
     //-------------------------------------------------------------------------------------------------
 
-    AS::Texture ImportDDSFile(std::string const & path)
+    std::shared_ptr<AS::Texture> CompressTexture(AS::Texture const & texture, AS::TextureUsage const usage)
     {
-        // TODO
-        MFA_NOT_IMPLEMENTED_YET("Mohammad Fakhreddin");
+        auto const & formatInfo = AS::Texture::FormatTable[static_cast<unsigned>(texture.GetFormat())];
+        if (usage == AS::TextureUsage::Generic || formatInfo.compression != 0)
+        {
+            return nullptr;
+        }
+        // Levels of array and 3D textures are not stored one slice after another
+        if (MFA_VERIFY(texture.GetSlices() == 1 && texture.GetDepth() == 1) == false)
+        {
+            return nullptr;
+        }
+
+        BlockCompressor::Codec codec;
+        AS::TextureFormat format;
+        switch (usage)
+        {
+        case AS::TextureUsage::Color:
+            codec = BlockCompressor::Codec::BC7;
+            // Keeps the color space of the source so the shaders read the same values
+            format = formatInfo.color_space == 1
+                ? AS::TextureFormat::BC7_UNorm_sRGB_RGBA
+                : AS::TextureFormat::BC7_UNorm_Linear_RGBA;
+            break;
+        case AS::TextureUsage::Normal:
+            codec = BlockCompressor::Codec::BC5;
+            format = AS::TextureFormat::BC5_UNorm_Linear_RG;
+            break;
+        case AS::TextureUsage::Mask:
+            codec = BlockCompressor::Codec::BC4;
+            format = AS::TextureFormat::BC4_UNorm_Linear_R;
+            break;
+        default:
+            MFA_CRASH("Unhandled texture usage");
+        }
+
+        auto const mipCount = texture.GetMipCount();
+        size_t bufferSize = 0;
+        for (uint8_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+        {
+            auto const & dimension = texture.GetMipmap(mipLevel).dimension;
+            bufferSize += BlockCompressor::CompressedSizeBytes(codec, dimension.width, dimension.height);
+        }
+
+        auto compressedTexture = std::make_shared<AS::Texture>(texture.GetNameId());
+        compressedTexture->initForWrite(format, 1, 1, Memory::Alloc(bufferSize, Memory::Tag::Texture));
+
+        auto const & firstDimension = texture.GetMipmap(0).dimension;
+        Memory::ScratchScope scratch {};
+        auto const blocks = scratch.Alloc(BlockCompressor::CompressedSizeBytes(
+            codec,
+            firstDimension.width,
+            firstDimension.height
+        ));
+        auto const pixels = texture.GetBuffer();
+
+        for (uint8_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+        {
+            auto const & mipmap = texture.GetMipmap(mipLevel);
+            Blob const mipBlocks {
+                blocks.ptr,
+                BlockCompressor::CompressedSizeBytes(codec, mipmap.dimension.width, mipmap.dimension.height)
+            };
+            BlockCompressor::Compress(
+                codec,
+                CBlob {pixels.ptr + mipmap.offset, mipmap.size},
+                mipmap.dimension.width,
+                mipmap.dimension.height,
+                formatInfo.component_count,
+                mipBlocks
+            );
+            compressedTexture->addMipmap(mipmap.dimension, mipBlocks);
+        }
+
+        MFA_ASSERT(compressedTexture->isValid());
+
+        return compressedTexture;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::string CompressedImagePath(std::string const & imagePath, AS::TextureUsage const usage)
+    {
+        MFA_ASSERT(imagePath.empty() == false);
+        switch (usage)
+        {
+        case AS::TextureUsage::Color:
+            return imagePath + ".bc7.ktx";
+        case AS::TextureUsage::Normal:
+            return imagePath + ".bc5.ktx";
+        case AS::TextureUsage::Mask:
+            return imagePath + ".bc4.ktx";
+        default:
+            MFA_CRASH("Generic textures are not compressed");
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Cache is stale once the image is edited after the cache is written
+    static bool IsCompressedImageCacheValid(std::string const & imagePath, std::string const & cachePath)
+    {
+        std::error_code errorCode {};
+        auto const cacheTime = std::filesystem::last_write_time(cachePath, errorCode);
+        if (errorCode)
+        {
+            return false;
+        }
+        auto const imageTime = std::filesystem::last_write_time(imagePath, errorCode);
+        // Cache can be shipped without the image
+        return errorCode || cacheTime >= imageTime;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::shared_ptr<AS::Texture> ImportCompressedImageCache(
+        std::string const & path,
+        AS::TextureUsage const usage
+    )
+    {
+        MFA_ASSERT(usage != AS::TextureUsage::Generic);
+
+        auto const cachePath = CompressedImagePath(path, usage);
+        if (IsCompressedImageCacheValid(path, cachePath))
+        {
+            auto cachedTexture = ImportKTXImage(cachePath);
+            if (cachedTexture != nullptr && cachedTexture->isValid())
+            {
+                return cachedTexture;
+            }
+        }
+        return nullptr;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::shared_ptr<AS::Texture> ImportCompressedImage(
+        std::string const & path,
+        ImportTextureOptions const & options
+    )
+    {
+        MFA_ASSERT(options.usage != AS::TextureUsage::Generic);
+
+        if (auto cachedTexture = ImportCompressedImageCache(path, options.usage); cachedTexture != nullptr)
+        {
+            return cachedTexture;
+        }
+
+        auto const cachePath = CompressedImagePath(path, options.usage);
+
+        // Block compressed textures cannot get their mipmaps from blits on the gpu
+        auto mipmapOptions = options;
+        mipmapOptions.tryToGenerateMipmaps = true;
+        auto texture = ImportUncompressedImage(path, mipmapOptions);
+        if (texture == nullptr)
+        {
+            return nullptr;
+        }
+
+        auto compressedTexture = CompressTexture(*texture, options.usage);
+        if (compressedTexture == nullptr)
+        {
+            return texture;
+        }
+
+        if (Utils::KTXTexture::Save(*compressedTexture, cachePath) == false)
+        {
+            MFA_LOG(Warning, Asset, "Failed to write compressed texture cache: %s", cachePath.c_str());
+        }
+
+        return compressedTexture;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::shared_ptr<AS::Texture> ImportKTX2Image(std::string const & path)
+    {
+        using namespace Utils::KTX2Texture;
+
+        LoadResult loadResult = LoadResult::Invalid;
+        auto const imageData = Load(loadResult, path);
+        if (loadResult != LoadResult::Success || imageData == nullptr)
+        {
+            MFA_LOG_WARN("Failed to load ktx2 file with path: %s", path.c_str());
+            return nullptr;
+        }
+
+        auto const & header = imageData->header;
+        auto const slices = static_cast<uint16_t>(Math::Max<uint32_t>(header.layer_count, 1));
+
+        uint64_t totalImageSize = 0;
+        for (auto const & level : imageData->levels)
+        {
+            totalImageSize += level.uncompressed_byte_length;
+        }
+
+        auto texture = std::make_shared<AS::Texture>(Path::RelativeToAssetFolder(path));
+        texture->initForWrite(
+            imageData->format,
+            slices,
+            static_cast<uint16_t>(Math::Max<uint32_t>(header.pixel_depth, 1)),
+            Memory::Alloc(totalImageSize, Memory::Tag::Texture)
+        );
+
+        AS::Texture::Dimensions dimensions {
+            .width = Math::Max<uint32_t>(header.pixel_width, 1),
+            .height = Math::Max<uint32_t>(header.pixel_height, 1),
+            .depth = static_cast<uint16_t>(Math::Max<uint32_t>(header.pixel_depth, 1)),
+        };
+
+        for (uint32_t level = 0; level < static_cast<uint32_t>(imageData->levels.size()); ++level)
+        {
+            auto const levelSize = imageData->levels[level].uncompressed_byte_length;
+            if (levelSize != AS::Texture::MipSizeBytes(imageData->format, slices, dimensions))
+            {
+                MFA_LOG_WARN("Ktx2 level %u has unexpected size, Path: %s", level, path.c_str());
+                return nullptr;
+            }
+
+            // Level bytes go from the file into the texture buffer, With no intermediate copy unless the file is supercompressed
+            auto const mipBlob = texture->addMipmap(dimensions, levelSize);
+            if (ReadLevel(*imageData, level, mipBlob) == false)
+            {
+                MFA_LOG_WARN("Failed to read ktx2 level %u, Path: %s", level, path.c_str());
+                return nullptr;
+            }
+
+            dimensions.width = Math::Max<uint32_t>(dimensions.width / 2, 1);
+            dimensions.height = Math::Max<uint32_t>(dimensions.height / 2, 1);
+            dimensions.depth = Math::Max<uint16_t>(dimensions.depth / 2, 1);
+        }
+
+        return texture;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::shared_ptr<AS::Texture> ImportDDSFile(std::string const & path)
+    {
+        using namespace Utils::DDSTexture;
+
+        Data imageData {};
+        auto const loadResult = Load(imageData, path);
+        if (loadResult != LoadResult::Success || imageData.valid == false)
+        {
+            MFA_LOG_WARN("Failed to load dds file with path: %s", path.c_str());
+            return nullptr;
+        }
+
+        auto texture = std::make_shared<AS::Texture>(Path::RelativeToAssetFolder(path));
+        texture->initForWrite(
+            imageData.format,
+            1,
+            imageData.depth,
+            Memory::Alloc(imageData.data_offset_in_asset.len, Memory::Tag::Texture)
+        );
+
+        auto const * mipmaps = imageData.mipmaps->memory.as<Mipmap>();
+        for (uint8_t i = 0; i < imageData.mipmap_count; ++i)
+        {
+            texture->addMipmap(
+                AS::Texture::Dimensions {
+                    .width = mipmaps[i].width,
+                    .height = mipmaps[i].height,
+                    .depth = imageData.depth,
+                },
+                mipmaps[i].data
+            );
+        }
+
+        return texture;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -247,12 +524,22 @@ namespace MFA::Importer
 
             if (extension == ".png" || extension == ".jpg" || extension == ".jpeg")
             {
-                texture = ImportUncompressedImage(path, options);
+                texture = options.usage == AS::TextureUsage::Generic
+                    ? ImportUncompressedImage(path, options)
+                    : ImportCompressedImage(path, options);
             }
             else if (extension == ".ktx")
             {
                 texture = ImportKTXImage(path);
             }
+            else if (extension == ".ktx2")
+            {
+                texture = ImportKTX2Image(path);
+            }
+            else if (extension == ".dds")
+            {
+                texture = ImportDDSFile(path);
+            }
         }
 
         return texture;
@@ -457,8 +744,8 @@ namespace MFA::Importer
                         mesh->initForWrite(
                             vertexCount,
                             indexCount,
-                            Memory::Alloc(sizeof(Vertex) * vertexCount),
-                            Memory::Alloc(sizeof(AS::Index) * indexCount)
+                            Memory::Alloc(sizeof(Vertex) * vertexCount, Memory::Tag::Mesh),
+                            Memory::Alloc(sizeof(AS::Index) * indexCount, Memory::Tag::Mesh)
                         );
 
                         auto const subMeshIndex = mesh->insertSubMesh();
@@ -759,6 +1046,47 @@ namespace MFA::Importer
         //MFA_CRASH("Image not found: %s", gltf_name);
     }
 
+    //-------------------------------------------------------------------------------------------------
+
+    // Compression of each texture depends on what the materials read from it, Textures with several roles keep all channels
+    static std::vector<AS::TextureUsage> GLTF_extractTextureUsages(
+        tinygltf::Model const & gltfModel,
+        std::vector<TextureRef> const & textureRefs
+    )
+    {
+        std::vector<AS::TextureUsage> textureUsages (textureRefs.size(), AS::TextureUsage::Generic);
+
+        auto const addUsage = [&gltfModel, &textureRefs, &textureUsages](int const textureIndex, AS::TextureUsage const usage)->void
+        {
+            if (textureIndex < 0)
+            {
+                return;
+            }
+            auto const & image = gltfModel.images[gltfModel.textures[textureIndex].source];
+            auto const refIndex = GLTF_findTextureByName(image.uri.c_str(), textureRefs);
+            if (refIndex < 0)
+            {
+                return;
+            }
+            auto & textureUsage = textureUsages[refIndex];
+            textureUsage = textureUsage == AS::TextureUsage::Generic || textureUsage == usage
+                ? usage
+                : AS::TextureUsage::Color;
+        };
+
+        for (auto const & material : gltfModel.materials)
+        {
+            addUsage(material.pbrMetallicRoughness.baseColorTexture.index, AS::TextureUsage::Color);
+            // Metallic is in blue and roughness is in green, So a single channel format cannot hold them
+            addUsage(material.pbrMetallicRoughness.metallicRoughnessTexture.index, AS::TextureUsage::Color);
+            addUsage(material.normalTexture.index, AS::TextureUsage::Normal);
+            addUsage(material.emissiveTexture.index, AS::TextureUsage::Color);
+            addUsage(material.occlusionTexture.index, AS::TextureUsage::Mask);
+        }
+
+        return textureUsages;
+    }
+
 
     //-------------------------------------------------------------------------------------------------
 
@@ -840,8 +1168,8 @@ namespace MFA::Importer
         mesh->initForWrite(
             totalVerticesCount,
             totalIndicesCount,
-            Memory::Alloc(sizeof(Vertex) * totalVerticesCount),
-            Memory::Alloc(sizeof(AS::Index) * totalIndicesCount)
+            Memory::Alloc(sizeof(Vertex) * totalVerticesCount, Memory::Tag::Mesh),
+            Memory::Alloc(sizeof(AS::Index) * totalIndicesCount, Memory::Tag::Mesh)
         );
         // Step2: Fill subMeshes
         uint32_t primitiveUniqueId = 0;
@@ -1851,7 +2179,12 @@ namespace MFA::Importer
                     textureIds[i] = textureRefs[i].relativePath;
                 }
 
-                result = std::make_shared<AS::Model>(mesh, textureIds, samplerConfigs);
+                result = std::make_shared<AS::Model>(
+                    mesh,
+                    textureIds,
+                    samplerConfigs,
+                    GLTF_extractTextureUsages(gltfModel, textureRefs)
+                );
             }
         }
         return result;
@@ -3,6 +3,7 @@
 #include "engine/asset_system/AssetTypes.hpp"
 #include "engine/BedrockCommon.hpp"
 #include "engine/BedrockMemory.hpp"
+#include "tools/MipmapGenerator.hpp"
 
 #include <memory>
 
@@ -29,7 +30,11 @@ namespace MFA::Importer
         //I think I will remove this op
         bool tryToGenerateMipmaps = false;      // Generates mipmaps for uncompressed texture
         bool preferSrgb = false;                // Not tested and not recommended
-        // TODO Usage flags
+        MipmapGenerator::Filter mipmapFilter = MipmapGenerator::Filter::Box;
+        // Role of the texture in its material, Anything other than Generic is block compressed by ImportCompressedImage
+        AssetSystem::TextureUsage usage = AssetSystem::TextureUsage::Generic;
+        // Content of the image file when the caller has already read it, For example the streaming io stage
+        std::shared_ptr<SmartBlob> fileData = nullptr;
     };
 
     [[nodiscard]]
@@ -56,11 +61,45 @@ namespace MFA::Importer
 
     std::shared_ptr<AssetSystem::Texture> ImportKTXImage(std::string const & path);
 
+    // Encodes every mip level with the block compression that suits the usage:
+    // Color is BC7, Normal is BC5 of red and green and Mask is BC4 of red.
+    // Returns nullptr for Generic usage and for textures that are already compressed.
+    [[nodiscard]]
+    std::shared_ptr<AssetSystem::Texture> CompressTexture(
+        AssetSystem::Texture const & texture,
+        AssetSystem::TextureUsage usage
+    );
+
+    // KTX file next to the image that caches its compressed version, Each usage has its own file
+    [[nodiscard]]
+    std::string CompressedImagePath(std::string const & imagePath, AssetSystem::TextureUsage usage);
+
+    // Only loads the KTX cache of the image, Returns nullptr when the cache is missing or older than the image
+    [[nodiscard]]
+    std::shared_ptr<AssetSystem::Texture> ImportCompressedImageCache(
+        std::string const & path,
+        AssetSystem::TextureUsage usage
+    );
+
+    // Loads the image from its KTX cache when the cache is not older than the image.
+    // Otherwise the image is imported with mipmaps, Compressed for options.usage and written to the cache,
+    // So the compression only runs once per image. Falls back to the uncompressed image if compression fails.
+    [[nodiscard]]
+    std::shared_ptr<AssetSystem::Texture> ImportCompressedImage(
+        std::string const & path,
+        ImportTextureOptions const & options
+    );
+
     // TODO ImageArray
 
-    // TODO
+    // Reads every level from the file straight into the texture buffer.
+    // Supercompressed (Zstd, Zlib) and Basis universal files are rejected since the engine has no decoder for them.
+    [[nodiscard]]
+    std::shared_ptr<AssetSystem::Texture> ImportKTX2Image(std::string const & path);
+
+    // Only DX10 headers are supported
     [[nodiscard]]
-    AssetSystem::Texture ImportDDSFile(std::string const & path);
+    std::shared_ptr<AssetSystem::Texture> ImportDDSFile(std::string const & path);
 
 
     [[nodiscard]]
@@ -0,0 +1,326 @@
+#include "MipmapGenerator.hpp"
+
+#include "engine/BedrockAssert.hpp"
+#include "engine/BedrockMath.hpp"
+#include "engine/job_system/JobSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace MFA::MipmapGenerator
+{
+
+    // Half width of the Kaiser filter in output pixels and the shape of its window, Same defaults as NVTT
+    static constexpr double KaiserWidth = 3.0;
+    static constexpr double KaiserAlpha = 4.0;
+
+    // Output pixels of a band, Small enough for the intermediate rows to stay in the cache
+    static constexpr uint32_t BandPixelCount = 1 << 14;
+
+    // Input pixels that are read for each output pixel along one axis
+    struct AxisFilter
+    {
+        uint32_t tapCount = 0;
+        // tapCount entries per output pixel, Indices are clamped to the image so the edge pixels are repeated
+        std::vector<uint32_t> indices {};
+        std::vector<float> weights {};
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    static double Sinc(double const x)
+    {
+        if (std::abs(x) < 1e-6)
+        {
+            return 1.0;
+        }
+        auto const piX = Math::PiDouble * x;
+        return std::sin(piX) / piX;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Modified Bessel function of the first kind, Series converges quickly for the alpha that is used
+    static double BesselI0(double const x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            auto const factor = x / (2.0 * k);
+            term *= factor * factor;
+            sum += term;
+            if (term < sum * 1e-12)
+            {
+                break;
+            }
+        }
+        return sum;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static double Kaiser(double const x)
+    {
+        if (std::abs(x) >= KaiserWidth)
+        {
+            return 0.0;
+        }
+        auto const t = x / KaiserWidth;
+        auto const window = BesselI0(KaiserAlpha * std::sqrt(1.0 - t * t)) / BesselI0(KaiserAlpha);
+        return Sinc(x) * window;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static AxisFilter CreateAxisFilter(uint32_t const inputSize, uint32_t const outputSize, Filter const filter)
+    {
+        // Pixel i covers [i, i + 1) of the input, Output pixels cover scale input pixels each
+        auto const scale = static_cast<double>(inputSize) / static_cast<double>(outputSize);
+        auto const radius = filter == Filter::Box ? scale * 0.5 : KaiserWidth * scale;
+        auto const windowSize = static_cast<uint32_t>(std::ceil(2.0 * radius)) + 1;
+
+        // Window can have zero weights at its ends, Those are trimmed so aligned box filters only read two pixels
+        std::vector<int64_t> firstTaps (outputSize);
+        std::vector<double> windowWeights (static_cast<size_t>(outputSize) * windowSize);
+        uint32_t tapCount = 1;
+        for (uint32_t x = 0; x < outputSize; ++x)
+        {
+            auto const center = (x + 0.5) * scale;
+            auto const first = static_cast<int64_t>(std::floor(center - radius));
+            auto * weights = windowWeights.data() + static_cast<size_t>(x) * windowSize;
+
+            double sum = 0.0;
+            for (uint32_t tap = 0; tap < windowSize; ++tap)
+            {
+                auto const i = first + tap;
+                if (filter == Filter::Box)
+                {
+                    auto const overlap = std::min<double>(i + 1, center + radius) - std::max<double>(i, center - radius);
+                    weights[tap] = std::max(overlap, 0.0);
+                }
+                else
+                {
+                    weights[tap] = Kaiser((i + 0.5 - center) / scale);
+                }
+                sum += weights[tap];
+            }
+            MFA_ASSERT(sum > 0.0);
+
+            uint32_t begin = 0;
+            uint32_t end = windowSize;
+            while (weights[begin] == 0.0)
+            {
+                ++begin;
+            }
+            while (weights[end - 1] == 0.0)
+            {
+                --end;
+            }
+            for (uint32_t tap = 0; tap < windowSize; ++tap)
+            {
+                weights[tap] = tap + begin < windowSize ? weights[tap + begin] / sum : 0.0;
+            }
+            firstTaps[x] = first + begin;
+            tapCount = std::max(tapCount, end - begin);
+        }
+
+        AxisFilter result {};
+        result.tapCount = tapCount;
+        result.indices.resize(static_cast<size_t>(outputSize) * tapCount);
+        result.weights.resize(result.indices.size());
+        for (uint32_t x = 0; x < outputSize; ++x)
+        {
+            for (uint32_t tap = 0; tap < tapCount; ++tap)
+            {
+                auto const index = std::clamp<int64_t>(firstTaps[x] + tap, 0, static_cast<int64_t>(inputSize) - 1);
+                result.indices[x * tapCount + tap] = static_cast<uint32_t>(index);
+                result.weights[x * tapCount + tap] = static_cast<float>(windowWeights[static_cast<size_t>(x) * windowSize + tap]);
+            }
+        }
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static float SrgbToLinear(float const value)
+    {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    // Codes are at least 1 / (255 * 12.92) apart in linear space
+    static constexpr int SrgbBinCount = 4096;
+
+    struct ConversionTables
+    {
+        std::array<float, 256> unormToFloat {};
+        std::array<float, 256> srgbToLinear {};
+        // Linear value where each sRGB code ends, Encoding compares with it so it rounds exactly like the curve
+        std::array<float, 255> srgbThresholds {};
+        // First sRGB code of each bin of linear values. Bins are narrower than any code, So one compare finishes the encoding.
+        std::array<uint8_t, SrgbBinCount> srgbBinCodes {};
+    };
+
+    static ConversionTables const & GetConversionTables()
+    {
+        static ConversionTables const tables = []()->ConversionTables
+        {
+            ConversionTables result {};
+            for (int i = 0; i < 256; ++i)
+            {
+                result.unormToFloat[i] = static_cast<float>(i) / 255.0f;
+                result.srgbToLinear[i] = SrgbToLinear(static_cast<float>(i) / 255.0f);
+            }
+            for (int i = 0; i < 255; ++i)
+            {
+                result.srgbThresholds[i] = SrgbToLinear((static_cast<float>(i) + 0.5f) / 255.0f);
+            }
+            for (int bin = 0; bin < SrgbBinCount; ++bin)
+            {
+                auto const value = static_cast<float>(bin) / static_cast<float>(SrgbBinCount);
+                auto const & thresholds = result.srgbThresholds;
+                result.srgbBinCodes[bin] = static_cast<uint8_t>(std::upper_bound(thresholds.begin(), thresholds.end(), value) - thresholds.begin());
+            }
+            return result;
+        }();
+        return tables;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    static uint8_t LinearToSrgb(ConversionTables const & tables, float const value)
+    {
+        auto const clamped = std::clamp(value, 0.0f, 1.0f);
+        auto const bin = std::min(static_cast<int>(clamped * SrgbBinCount), SrgbBinCount - 1);
+        uint8_t code = tables.srgbBinCodes[bin];
+        if (code < 255 && clamped >= tables.srgbThresholds[code])
+        {
+            ++code;
+        }
+        return code;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    uint32_t NextMipSize(uint32_t const size)
+    {
+        return std::max<uint32_t>((size + 1) / 2, 1);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    void Downsample(
+        CBlob const inputPixels,
+        uint32_t const inputWidth,
+        uint32_t const inputHeight,
+        uint32_t const componentCount,
+        Blob const outputPixels,
+        uint32_t const outputWidth,
+        uint32_t const outputHeight,
+        Params const & params
+    )
+    {
+        MFA_ASSERT(inputWidth > 0 && inputHeight > 0);
+        MFA_ASSERT(outputWidth > 0 && outputWidth <= inputWidth);
+        MFA_ASSERT(outputHeight > 0 && outputHeight <= inputHeight);
+        MFA_ASSERT(componentCount > 0 && componentCount <= 4);
+        MFA_ASSERT(inputPixels.len >= static_cast<size_t>(inputWidth) * inputHeight * componentCount);
+        MFA_ASSERT(outputPixels.len >= static_cast<size_t>(outputWidth) * outputHeight * componentCount);
+
+        auto const & tables = GetConversionTables();
+        std::array<float const *, 4> decodeTables {};
+        std::array<bool, 4> isSrgb {};
+        for (uint32_t component = 0; component < componentCount; ++component)
+        {
+            isSrgb[component] = params.isSrgb && component < 3;
+            decodeTables[component] = isSrgb[component] ? tables.srgbToLinear.data() : tables.unormToFloat.data();
+        }
+
+        auto const horizontal = CreateAxisFilter(inputWidth, outputWidth, params.filter);
+        auto const vertical = CreateAxisFilter(inputHeight, outputHeight, params.filter);
+
+        auto const * input = inputPixels.as<uint8_t>();
+        auto * output = outputPixels.as<uint8_t>();
+        size_t const inputRowSize = static_cast<size_t>(inputWidth) * componentCount;
+        size_t const outputRowSize = static_cast<size_t>(outputWidth) * componentCount;
+
+        auto const processBand = [&](uint32_t const beginRow, uint32_t const endRow)->void
+        {
+            // Vertical taps only move forward, So the band reads a single range of input rows
+            auto const firstInputRow = vertical.indices[static_cast<size_t>(beginRow) * vertical.tapCount];
+            auto const lastInputRow = vertical.indices[static_cast<size_t>(endRow) * vertical.tapCount - 1];
+
+            // Horizontal pass, Input rows of the band resampled to the output width in linear space
+            std::vector<float> inputValues (inputRowSize);
+            std::vector<float> rows ((lastInputRow - firstInputRow + 1) * outputRowSize);
+            for (uint32_t inputRow = firstInputRow; inputRow <= lastInputRow; ++inputRow)
+            {
+                auto const * inputRowPixels = input + inputRow * inputRowSize;
+                for (size_t pixel = 0; pixel < inputRowSize; pixel += componentCount)
+                {
+                    for (uint32_t component = 0; component < componentCount; ++component)
+                    {
+                        inputValues[pixel + component] = decodeTables[component][inputRowPixels[pixel + component]];
+                    }
+                }
+
+                auto * rowValues = rows.data() + (inputRow - firstInputRow) * outputRowSize;
+                for (uint32_t x = 0; x < outputWidth; ++x)
+                {
+                    auto const * indices = horizontal.indices.data() + static_cast<size_t>(x) * horizontal.tapCount;
+                    auto const * weights = horizontal.weights.data() + static_cast<size_t>(x) * horizontal.tapCount;
+                    float sums[4] {};
+                    for (uint32_t tap = 0; tap < horizontal.tapCount; ++tap)
+                    {
+                        auto const * pixel = inputValues.data() + static_cast<size_t>(indices[tap]) * componentCount;
+                        for (uint32_t component = 0; component < componentCount; ++component)
+                        {
+                            sums[component] += weights[tap] * pixel[component];
+                        }
+                    }
+                    std::copy_n(sums, componentCount, rowValues + x * componentCount);
+                }
+            }
+
+            // Vertical pass
+            std::vector<float> sums (outputRowSize);
+            for (uint32_t outputRow = beginRow; outputRow < endRow; ++outputRow)
+            {
+                std::fill(sums.begin(), sums.end(), 0.0f);
+                auto const * indices = vertical.indices.data() + static_cast<size_t>(outputRow) * vertical.tapCount;
+                auto const * weights = vertical.weights.data() + static_cast<size_t>(outputRow) * vertical.tapCount;
+                for (uint32_t tap = 0; tap < vertical.tapCount; ++tap)
+                {
+                    auto const weight = weights[tap];
+                    auto const * rowValues = rows.data() + (indices[tap] - firstInputRow) * outputRowSize;
+                    for (size_t i = 0; i < outputRowSize; ++i)
+                    {
+                        sums[i] += weight * rowValues[i];
+                    }
+                }
+
+                auto * outputRowPixels = output + outputRow * outputRowSize;
+                for (size_t pixel = 0; pixel < outputRowSize; pixel += componentCount)
+                {
+                    for (uint32_t component = 0; component < componentCount; ++component)
+                    {
+                        auto const value = sums[pixel + component];
+                        outputRowPixels[pixel + component] = isSrgb[component]
+                            ? LinearToSrgb(tables, value)
+                            : static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+                    }
+                }
+            }
+        };
+
+        auto const rowsPerBand = std::max<uint32_t>(BandPixelCount / outputWidth, 1);
+        JS::ParallelFor(outputHeight, rowsPerBand, processBand);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+}
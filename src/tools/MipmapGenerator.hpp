@@ -0,0 +1,42 @@
+#pragma once
+
+#include "engine/BedrockMemory.hpp"
+
+#include <cstdint>
+
+namespace MFA::MipmapGenerator
+{
+
+    enum class Filter : uint8_t
+    {
+        Box,            // Average of the covered area, Cheapest and never overshoots
+        Kaiser          // Kaiser windowed sinc, Keeps more detail but rings a little and is clamped
+    };
+
+    struct Params
+    {
+        Filter filter = Filter::Box;
+        // Color components are decoded to linear before filtering and encoded back after it.
+        // The fourth component is alpha and is always filtered as is.
+        bool isSrgb = false;
+    };
+
+    // Size of the level after the given one, Same rounding as AS::Texture::MipDimensions
+    [[nodiscard]]
+    uint32_t NextMipSize(uint32_t size);
+
+    // Resamples one level of an 8 bit per component image into the next one.
+    // Output can be any size that is not larger than the input, Each level is meant to be made from the previous one.
+    // Large images are split into bands of rows that run on the job system.
+    void Downsample(
+        CBlob inputPixels,
+        uint32_t inputWidth,
+        uint32_t inputHeight,
+        uint32_t componentCount,
+        Blob outputPixels,
+        uint32_t outputWidth,
+        uint32_t outputHeight,
+        Params const & params = {}
+    );
+
+}
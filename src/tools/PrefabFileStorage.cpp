@@ -1,5 +1,6 @@
 #include "PrefabFileStorage.hpp"
 
+#include "BinaryScene.hpp"
 #include "Prefab.hpp"
 #include "engine/BedrockAssert.hpp"
 #include "engine/entity_system/Entity.hpp"
@@ -7,11 +8,26 @@
 #include "libs/nlohmann/json.hpp"
 
 #include <fstream>
+#include <iterator>
 
 namespace MFA
 {
     //-------------------------------------------------------------------------------------------------
 
+    static bool readBinaryFile(std::string const & fileAddress, std::vector<uint8_t> & outData)
+    {
+        std::ifstream file(fileAddress, std::ios::binary);
+        if (file.is_open() == false)
+        {
+            MFA_LOG_WARN("Failed to open %s", fileAddress.c_str());
+            return false;
+        }
+        outData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     void PrefabFileStorage::Serialize(SerializeParams const & params)
     {
         auto * prefab = params.prefab;
@@ -19,6 +35,15 @@ namespace MFA
         auto * entity = prefab->GetEntity();
         MFA_ASSERT(entity != nullptr);
 
+        if (IsBinaryFile(params.saveAddress))
+        {
+            auto const data = BinaryScene::Encode(entity);
+            std::ofstream file(params.saveAddress, std::ios::binary);
+            file.write(reinterpret_cast<char const *>(data.data()), static_cast<std::streamsize>(data.size()));
+            file.close();
+            return;
+        }
+
         nlohmann::json json {};
         entity->Serialize(json["entity"]);
 
@@ -31,12 +56,63 @@ namespace MFA
 
     void PrefabFileStorage::Deserialize(DeserializeParams const & params)
     {
+        auto * entity = params.prefab->GetEntity();
+        MFA_ASSERT(entity != nullptr);
+
+        if (IsBinaryFile(params.fileAddress))
+        {
+            std::vector<uint8_t> data {};
+            if (readBinaryFile(params.fileAddress, data))
+            {
+                (void)BinaryScene::Load(std::move(data), entity, params.initializeEntity);
+            }
+            return;
+        }
+
         std::ifstream ifs(params.fileAddress);
         nlohmann::json jf = nlohmann::json::parse(ifs);
 
+        entity->Deserialize(jf["entity"], params.initializeEntity);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    std::unique_ptr<BinaryScene::SceneLoader> PrefabFileStorage::DeserializeIncremental(
+        DeserializeParams const & params,
+        float const budgetMs
+    )
+    {
+        MFA_ASSERT(IsBinaryFile(params.fileAddress));
         auto * entity = params.prefab->GetEntity();
         MFA_ASSERT(entity != nullptr);
-        entity->Deserialize(jf["entity"], params.initializeEntity);
+
+        std::vector<uint8_t> data {};
+        if (readBinaryFile(params.fileAddress, data) == false)
+        {
+            return nullptr;
+        }
+        auto loader = std::make_unique<BinaryScene::SceneLoader>(
+            std::move(data),
+            entity,
+            BinaryScene::SceneLoader::Params {
+                .budgetMs = budgetMs,
+                .initializeEntities = params.initializeEntity
+            }
+        );
+        if (loader->IsValid() == false)
+        {
+            return nullptr;
+        }
+        return loader;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool PrefabFileStorage::IsBinaryFile(std::string const & fileAddress)
+    {
+        std::string const extension = BinaryScene::FileExtension;
+        return fileAddress.size() >= extension.size() &&
+            fileAddress.compare(fileAddress.size() - extension.size(), extension.size(), extension) == 0;
     }
 
     //-------------------------------------------------------------------------------------------------
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 namespace MFA
@@ -8,7 +9,13 @@ namespace MFA
     class Entity;
 }
 
+namespace MFA::BinaryScene
+{
+    class SceneLoader;
+}
+
 // TODO We can move these functions into prefab
+// Files that end with BinaryScene::FileExtension use the binary format, Other files are json
 namespace MFA::PrefabFileStorage
 {
     struct SerializeParams
@@ -26,4 +33,12 @@ namespace MFA::PrefabFileStorage
     };
     void Deserialize(DeserializeParams const & params);
 
+    // Binary files only, The returned loader instantiates the entities over several frames when its Update is called.
+    // Returns nullptr when the file cannot be read.
+    [[nodiscard]]
+    std::unique_ptr<BinaryScene::SceneLoader> DeserializeIncremental(DeserializeParams const & params, float budgetMs);
+
+    [[nodiscard]]
+    bool IsBinaryFile(std::string const & fileAddress);
+
 }
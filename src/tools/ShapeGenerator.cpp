@@ -66,8 +66,8 @@ namespace MFA::ShapeGenerator
 
             auto mesh = std::make_shared<Mesh>();
 
-            auto const vertexBuffer = Memory::Alloc(sizeof(Vertex) * verticesCount);
-            auto const indexBuffer = Memory::Alloc(sizeof(AS::Index) * indicesCount);
+            auto const vertexBuffer = Memory::Alloc(sizeof(Vertex) * verticesCount, Memory::Tag::Mesh);
+            auto const indexBuffer = Memory::Alloc(sizeof(AS::Index) * indicesCount, Memory::Tag::Mesh);
 
             mesh->initForWrite(
                 verticesCount,
@@ -132,8 +132,8 @@ namespace MFA::ShapeGenerator
             auto const indicesCount = static_cast<uint16_t>(meshIndices.size());
             auto const verticesCount = static_cast<uint16_t>(positions.size());
 
-            auto const verticesBuffer = Memory::Alloc(sizeof(Vertex) * verticesCount);
-            auto const indicesBuffer = Memory::Alloc(sizeof(AS::Index) * indicesCount);
+            auto const verticesBuffer = Memory::Alloc(sizeof(Vertex) * verticesCount, Memory::Tag::Mesh);
+            auto const indicesBuffer = Memory::Alloc(sizeof(AS::Index) * indicesCount, Memory::Tag::Mesh);
 
             auto mesh = std::make_shared<Mesh>();
             mesh->initForWrite(
@@ -194,8 +194,8 @@ namespace MFA::ShapeGenerator
             auto const verticesCount = static_cast<uint16_t>(vertices.size());
             auto const indicesCount = static_cast<uint16_t>(indices.size());
 
-            auto const verticesBuffer = Memory::Alloc(sizeof(Vertex) * verticesCount);
-            auto const indicesBuffer = Memory::Alloc(sizeof(AS::Index) * indicesCount);
+            auto const verticesBuffer = Memory::Alloc(sizeof(Vertex) * verticesCount, Memory::Tag::Mesh);
+            auto const indicesBuffer = Memory::Alloc(sizeof(AS::Index) * indicesCount, Memory::Tag::Mesh);
 
             auto const mesh = std::make_shared<Mesh>();
             MFA_ASSERT(mesh != nullptr);
@@ -275,8 +275,8 @@ namespace MFA::ShapeGenerator
             auto const verticesCount = static_cast<uint16_t>(vertices.size());
             auto const indicesCount = static_cast<uint16_t>(indices.size());
 
-            auto const verticesBuffer = Memory::Alloc(sizeof(Vertex) * verticesCount);
-            auto const indicesBuffer = Memory::Alloc(sizeof(AS::Index) * indicesCount);
+            auto const verticesBuffer = Memory::Alloc(sizeof(Vertex) * verticesCount, Memory::Tag::Mesh);
+            auto const indicesBuffer = Memory::Alloc(sizeof(AS::Index) * indicesCount, Memory::Tag::Mesh);
 
             auto const mesh = std::make_shared<Mesh>();
             MFA_ASSERT(mesh != nullptr);
@@ -0,0 +1,181 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/entity_system/Entity.hpp"
+#include "engine/entity_system/Component.hpp"
+#include "engine/entity_system/ComponentRegistry.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    class TestBaseComponent : public Component
+    {
+    public:
+
+        MFA_ABSTRACT_COMPONENT_PROPS(
+            TestBaseComponent,
+            EventTypes::EmptyEvent,
+            Component
+        )
+
+        explicit TestBaseComponent() = default;
+
+        void Clone(Entity * entity) const override {}
+        void Serialize(nlohmann::json & jsonObject) const override {}
+        void Deserialize(nlohmann::json const & jsonObject) override {}
+    };
+
+    class TestChildComponent final : public TestBaseComponent
+    {
+    public:
+
+        MFA_COMPONENT_PROPS(
+            TestChildComponent,
+            EventTypes::EmptyEvent,
+            TestBaseComponent
+        )
+
+        explicit TestChildComponent() = default;
+    };
+
+    class TestOtherComponent final : public Component
+    {
+    public:
+
+        MFA_COMPONENT_PROPS(
+            TestOtherComponent,
+            EventTypes::EmptyEvent,
+            Component
+        )
+
+        explicit TestOtherComponent() = default;
+
+        void Clone(Entity * entity) const override {}
+        void Serialize(nlohmann::json & jsonObject) const override {}
+        void Deserialize(nlohmann::json const & jsonObject) override {}
+    };
+
+    // Previous implementation of GetComponent, Used as a reference for the benchmark
+    template<typename ComponentClass>
+    ComponentClass * GetComponentWithRTTI(Entity & entity)
+    {
+        for (auto * component : entity.GetComponents())
+        {
+            auto * castResult = dynamic_cast<ComponentClass *>(component);
+            if (castResult != nullptr)
+            {
+                return castResult;
+            }
+        }
+        return nullptr;
+    }
+}
+
+//======================================================================
+
+TEST_CASE("Component TestCase1 TypeId", "[Component][0]")
+{
+    CHECK(TestBaseComponent::GetTypeId() != TestChildComponent::GetTypeId());
+    CHECK(TestChildComponent::GetTypeId() != TestOtherComponent::GetTypeId());
+
+    auto const & childMask = TestChildComponent::GetTypeMask();
+    CHECK(childMask.test(TestChildComponent::GetTypeId()));
+    CHECK(childMask.test(TestBaseComponent::GetTypeId()));
+    CHECK(childMask.test(TestOtherComponent::GetTypeId()) == false);
+
+    // Name hash is computed at compile time
+    STATIC_REQUIRE(TestChildComponent::NameHash == Hash::Fnv1a(std::string_view {"TestChildComponent"}));
+    STATIC_REQUIRE(TestChildComponent::NameHash != TestBaseComponent::NameHash);
+
+    CHECK(ComponentRegistry::FindTypeId("TestChildComponent") == TestChildComponent::GetTypeId());
+    CHECK(ComponentRegistry::FindTypeId("TestBaseComponent") == TestBaseComponent::GetTypeId());
+    CHECK(ComponentRegistry::FindTypeId(std::string {"TestOtherComponent"}) == TestOtherComponent::GetTypeId());
+    CHECK(ComponentRegistry::FindTypeId("NotAComponent") == ComponentTypeIdInvalid);
+    CHECK(ComponentRegistry::FindTypeId("TestChildComponen") == ComponentTypeIdInvalid);
+    CHECK(ComponentRegistry::FindTypeId("") == ComponentTypeIdInvalid);
+}
+
+TEST_CASE("Component TestCase2 GetComponent", "[Component][1]")
+{
+    Entity entity {0, "Entity", nullptr, false};
+
+    CHECK(entity.GetComponent<TestChildComponent>() == nullptr);
+
+    auto const child = entity.AddComponent<TestChildComponent>();
+    auto const other = entity.AddComponent<TestOtherComponent>();
+
+    CHECK(entity.GetComponent<TestChildComponent>() == child);
+    CHECK(entity.GetComponent<TestBaseComponent>() == child);
+    CHECK(entity.GetComponent<TestOtherComponent>() == other);
+    CHECK(entity.GetComponent("TestBaseComponent") == child);
+    CHECK(entity.GetComponent("TestOtherComponent") == other);
+
+    CHECK(entity.RemoveComponent<TestBaseComponent>() == true);
+    CHECK(entity.GetComponent<TestChildComponent>() == nullptr);
+    CHECK(entity.GetComponent<TestOtherComponent>() == other);
+
+    CHECK(entity.RemoveComponent("TestOtherComponent") == true);
+    CHECK(entity.GetComponent<TestOtherComponent>() == nullptr);
+}
+
+TEST_CASE("Component TestCase3 Pool", "[Component][2]")
+{
+    std::vector<std::unique_ptr<Entity>> entities {};
+    for (EntityId i = 0; i < 10; ++i)
+    {
+        entities.emplace_back(std::make_unique<Entity>(i, "Entity", nullptr, false));
+        entities.back()->AddComponent<TestChildComponent>();
+        if (i % 2 == 0)
+        {
+            entities.back()->AddComponent<TestOtherComponent>();
+        }
+    }
+
+    int baseCount = 0;
+    ComponentRegistry::ForEach<TestBaseComponent>([&baseCount](TestBaseComponent * component)->void
+    {
+        CHECK(component->GetEntity() != nullptr);
+        ++baseCount;
+    });
+    CHECK(baseCount == 10);
+    CHECK(ComponentRegistry::GetPool(TestOtherComponent::GetTypeId()).size() == 5);
+
+    entities.erase(entities.begin(), entities.begin() + 4);
+    CHECK(ComponentRegistry::GetPool(TestChildComponent::GetTypeId()).size() == 6);
+    CHECK(ComponentRegistry::GetPool(TestOtherComponent::GetTypeId()).size() == 3);
+
+    entities.clear();
+    CHECK(ComponentRegistry::GetPool(TestChildComponent::GetTypeId()).empty());
+}
+
+TEST_CASE("Component TestCase4 Lookup performance", "[Component][3][!benchmark]")
+{
+    Entity entity {0, "Entity", nullptr, false};
+    entity.AddComponent<TestOtherComponent>();
+    entity.AddComponent<TestChildComponent>();
+
+    BENCHMARK("GetComponent with RTTI")
+    {
+        return GetComponentWithRTTI<TestBaseComponent>(entity);
+    };
+
+    BENCHMARK("GetComponent with type id")
+    {
+        return entity.GetComponent<TestBaseComponent>();
+    };
+
+    BENCHMARK("GetComponent with name")
+    {
+        return entity.GetComponent("TestBaseComponent");
+    };
+}
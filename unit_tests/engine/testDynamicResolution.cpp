@@ -0,0 +1,123 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/BedrockMath.hpp"
+#include "engine/render_system/DynamicResolution.hpp"
+
+#include <cmath>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    // Fixed cost of the frame plus shading cost that grows with the pixel count
+    struct GpuCost
+    {
+        float fixedMs = 0.0f;
+        float fullResolutionMs = 0.0f;
+
+        [[nodiscard]]
+        float FrameTime(float const scale) const
+        {
+            return fixedMs + fullResolutionMs * scale * scale;
+        }
+    };
+
+    void Simulate(DynamicResolution & controller, GpuCost const & cost, uint32_t const frameCount)
+    {
+        for (uint32_t i = 0; i < frameCount; ++i)
+        {
+            controller.Update(cost.FrameTime(controller.GetScale()));
+        }
+    }
+}
+
+//======================================================================
+
+TEST_CASE("DynamicResolution TestCase1 Converges under target", "[DynamicResolution][0]")
+{
+    DynamicResolution::Params params {};
+    params.targetFrameTimeMs = 16.0f;
+    params.minScale = 0.25f;
+    params.maxScale = 1.0f;
+
+    DynamicResolution controller {params, 1.0f};
+
+    // Full resolution costs 26 ms, Scale around 0.72 fits the budget
+    GpuCost const cost {.fixedMs = 2.0f, .fullResolutionMs = 24.0f};
+    Simulate(controller, cost, 500);
+
+    auto const scale = controller.GetScale();
+    CHECK(cost.FrameTime(scale) <= params.targetFrameTimeMs);
+    CHECK(cost.FrameTime(scale) >= params.targetFrameTimeMs * params.increaseThreshold * 0.8f);
+    CHECK(std::fmod(scale, params.quantization) == Approx(0.0f).margin(1e-4f));
+}
+
+//======================================================================
+
+TEST_CASE("DynamicResolution TestCase2 Clamps to the limits", "[DynamicResolution][1]")
+{
+    DynamicResolution::Params params {};
+    params.targetFrameTimeMs = 16.0f;
+    params.minScale = 0.5f;
+    params.maxScale = 1.0f;
+
+    DynamicResolution controller {params, 0.5f};
+
+    // Cheap scene climbs back to full resolution
+    Simulate(controller, GpuCost {.fixedMs = 1.0f, .fullResolutionMs = 4.0f}, 200);
+    CHECK(controller.GetScale() == params.maxScale);
+
+    // Scene that never fits stays at the minimum
+    Simulate(controller, GpuCost {.fixedMs = 20.0f, .fullResolutionMs = 40.0f}, 200);
+    CHECK(controller.GetScale() == params.minScale);
+
+    // Narrower limits apply right away
+    params.minScale = 0.75f;
+    controller.SetParams(params);
+    CHECK(controller.GetScale() == params.minScale);
+}
+
+//======================================================================
+
+TEST_CASE("DynamicResolution TestCase3 Stable under noise", "[DynamicResolution][2]")
+{
+    DynamicResolution::Params params {};
+    params.targetFrameTimeMs = 16.0f;
+
+    DynamicResolution controller {params, 1.0f};
+    GpuCost const cost {.fixedMs = 3.0f, .fullResolutionMs = 20.0f};
+
+    Math::RandomGenerator generator {3};
+
+    // Settle first
+    for (uint32_t i = 0; i < 300; ++i)
+    {
+        auto const noise = generator.NextFloat(-0.5f, 0.5f);
+        controller.Update(cost.FrameTime(controller.GetScale()) + noise);
+    }
+
+    // Frame to frame jitter must not make the resolution flicker
+    uint32_t changeCount = 0;
+    auto previousScale = controller.GetScale();
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        auto const noise = generator.NextFloat(-0.5f, 0.5f);
+        auto const scale = controller.Update(cost.FrameTime(controller.GetScale()) + noise);
+        if (scale != previousScale)
+        {
+            ++changeCount;
+            CHECK(std::abs(scale - previousScale) <= params.maxStep + 1e-5f);
+        }
+        previousScale = scale;
+    }
+    CHECK(changeCount <= 4);
+    CHECK(cost.FrameTime(controller.GetScale()) <= params.targetFrameTimeMs + 0.5f);
+}
+
+//======================================================================
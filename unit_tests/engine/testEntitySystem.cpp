@@ -0,0 +1,156 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/entity_system/Entity.hpp"
+#include "engine/entity_system/EntitySystem.hpp"
+#include "engine/job_system/JobSystem.hpp"
+
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+TEST_CASE("EntitySystem TestCase1 Handles", "[EntitySystem][0]")
+{
+    EntitySystem::Init();
+
+    auto * entity = EntitySystem::CreateEntity("Entity");
+    auto const handle = entity->GetHandle();
+    CHECK(handle.IsValid());
+    CHECK(EntitySystem::GetEntity(handle) == entity);
+    CHECK(EntitySystem::GetEntityCount() == 1);
+
+    EntitySystem::DestroyEntity(entity);
+    CHECK(EntitySystem::IsAlive(handle) == false);
+    CHECK(EntitySystem::GetEntity(handle) == nullptr);
+    CHECK(EntitySystem::GetEntityCount() == 0);
+
+    // Slot is reused but the old handle stays invalid
+    auto * newEntity = EntitySystem::CreateEntity("Entity");
+    auto const newHandle = newEntity->GetHandle();
+    CHECK(newHandle.GetIndex() == handle.GetIndex());
+    CHECK(newHandle.GetVersion() != handle.GetVersion());
+    CHECK(EntitySystem::GetEntity(handle) == nullptr);
+    CHECK(EntitySystem::GetEntity(newHandle) == newEntity);
+
+    CHECK(EntitySystem::GetEntity(EntityHandle {}) == nullptr);
+
+    EntitySystem::Shutdown();
+}
+
+TEST_CASE("EntitySystem TestCase2 Children", "[EntitySystem][1]")
+{
+    EntitySystem::Init();
+
+    auto * root = EntitySystem::CreateEntity("Root");
+    EntitySystem::InitEntity(root);
+
+    std::vector<EntityHandle> handles {};
+    for (int i = 0; i < 10; ++i)
+    {
+        auto * child = EntitySystem::CreateEntity("Child", root);
+        EntitySystem::InitEntity(child);
+        auto * grandChild = EntitySystem::CreateEntity("GrandChild", child);
+        EntitySystem::InitEntity(grandChild);
+
+        handles.emplace_back(child->GetHandle());
+        handles.emplace_back(grandChild->GetHandle());
+    }
+    CHECK(root->GetChildEntities().size() == 10);
+    CHECK(EntitySystem::GetEntityCount() == 21);
+
+    EntitySystem::DestroyEntity(EntitySystem::GetEntity(handles[0]));
+    CHECK(root->GetChildEntities().size() == 9);
+    CHECK(EntitySystem::IsAlive(handles[1]) == false);
+
+    EntitySystem::DestroyEntity(root);
+    CHECK(EntitySystem::GetEntityCount() == 0);
+    for (auto const & handle : handles)
+    {
+        CHECK(EntitySystem::IsAlive(handle) == false);
+    }
+
+    EntitySystem::Shutdown();
+}
+
+TEST_CASE("EntitySystem TestCase3 Deferred destroy", "[EntitySystem][2]")
+{
+    // Queued entities are destroyed on the main thread of the job system
+    JS::Init();
+    EntitySystem::Init();
+
+    auto * parent = EntitySystem::CreateEntity("Parent");
+    EntitySystem::InitEntity(parent);
+    auto * child = EntitySystem::CreateEntity("Child", parent);
+    EntitySystem::InitEntity(child);
+
+    auto const parentHandle = parent->GetHandle();
+    auto const childHandle = child->GetHandle();
+
+    // Child is destroyed with its parent, Its own entry should be ignored
+    EntitySystem::QueueDestroyEntity(parent);
+    EntitySystem::QueueDestroyEntity(child);
+    EntitySystem::QueueDestroyEntity(parent);
+    CHECK(EntitySystem::IsAlive(parentHandle));
+    CHECK(EntitySystem::IsAlive(childHandle));
+
+    EntitySystem::DestroyQueuedEntities();
+    CHECK(EntitySystem::IsAlive(parentHandle) == false);
+    CHECK(EntitySystem::IsAlive(childHandle) == false);
+    CHECK(EntitySystem::GetEntityCount() == 0);
+
+    EntitySystem::Shutdown();
+    JS::Shutdown();
+}
+
+TEST_CASE("EntitySystem TestCase4 Spawn and despawn churn", "[EntitySystem][3][!benchmark]")
+{
+    static constexpr int BatchSize = 1000;
+
+    // Queued entities are destroyed on the main thread of the job system
+    JS::Init();
+    EntitySystem::Init();
+
+    auto * root = EntitySystem::CreateEntity("Root");
+    EntitySystem::InitEntity(root);
+
+    std::vector<Entity *> entities {};
+    entities.reserve(BatchSize);
+
+    BENCHMARK("Spawn and despawn 1000 entities")
+    {
+        for (int i = 0; i < BatchSize; ++i)
+        {
+            auto * entity = EntitySystem::CreateEntity("Projectile", root);
+            EntitySystem::InitEntity(entity);
+            entities.emplace_back(entity);
+        }
+        for (auto * entity : entities)
+        {
+            EntitySystem::QueueDestroyEntity(entity);
+        }
+        EntitySystem::DestroyQueuedEntities();
+        entities.clear();
+    };
+
+    BENCHMARK("Destroy a prefab with 1000 children")
+    {
+        auto * prefab = EntitySystem::CreateEntity("Prefab", root);
+        EntitySystem::InitEntity(prefab);
+        for (int i = 0; i < BatchSize; ++i)
+        {
+            auto * entity = EntitySystem::CreateEntity("Child", prefab);
+            EntitySystem::InitEntity(entity);
+        }
+        EntitySystem::DestroyEntity(prefab);
+    };
+
+    CHECK(EntitySystem::GetEntityCount() == 1);
+
+    EntitySystem::Shutdown();
+    JS::Shutdown();
+}
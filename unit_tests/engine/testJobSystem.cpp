@@ -0,0 +1,107 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/job_system/JobSystem.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+TEST_CASE("JobSystem TestCase1 ParallelFor covers every item once", "[JobSystem][0]")
+{
+    JS::Init();
+
+    for (uint32_t const itemCount : {0u, 1u, 63u, 64u, 65u, 1000u, 4097u})
+    {
+        std::vector<std::atomic<int>> visits (itemCount);
+        JS::ParallelFor(itemCount, 64, [&visits](uint32_t const beginIndex, uint32_t const endIndex)->void
+        {
+            for (auto i = beginIndex; i < endIndex; ++i)
+            {
+                ++visits[i];
+            }
+        });
+
+        bool visitedOnce = true;
+        for (auto const & visit : visits)
+        {
+            visitedOnce &= visit == 1;
+        }
+        CHECK(visitedOnce);
+    }
+
+    JS::Shutdown();
+}
+
+//======================================================================
+
+TEST_CASE("JobSystem TestCase2 ParallelFor does not wait for other jobs", "[JobSystem][1]")
+{
+    JS::Init();
+
+    // Without worker threads the job runs on this thread and never returns
+    if (JS::GetNumberOfAvailableThreads() < 2)
+    {
+        WARN("Needs at least two threads");
+        JS::Shutdown();
+        return;
+    }
+
+    // Job that only finishes after the loop has returned, Waiting for the whole pool would never return
+    std::atomic<bool> isLoopDone = false;
+    std::atomic<bool> isJobDone = false;
+    JS::AssignTask([&isLoopDone, &isJobDone](JS::ThreadNumber, JS::ThreadNumber)->void
+    {
+        while (isLoopDone == false)
+        {
+            std::this_thread::yield();
+        }
+        isJobDone = true;
+    });
+
+    std::atomic<uint32_t> sum = 0;
+    JS::ParallelFor(1000, 10, [&sum](uint32_t const beginIndex, uint32_t const endIndex)->void
+    {
+        for (auto i = beginIndex; i < endIndex; ++i)
+        {
+            sum += i;
+        }
+    });
+    CHECK(sum == 999 * 1000 / 2);
+    CHECK(isJobDone == false);
+
+    isLoopDone = true;
+    JS::WaitForThreadsToFinish();
+    CHECK(isJobDone);
+
+    JS::Shutdown();
+}
+
+//======================================================================
+
+TEST_CASE("JobSystem TestCase3 ParallelFor from a worker thread", "[JobSystem][2]")
+{
+    JS::Init();
+
+    std::atomic<uint32_t> sum = 0;
+    JS::AssignTaskPerThread([&sum](JS::ThreadNumber, JS::ThreadNumber)->void
+    {
+        JS::ParallelFor(100, 7, [&sum](uint32_t const beginIndex, uint32_t const endIndex)->void
+        {
+            sum += endIndex - beginIndex;
+        });
+    });
+    JS::WaitForThreadsToFinish();
+    CHECK(sum == JS::GetNumberOfAvailableThreads() * 100);
+
+    JS::Shutdown();
+}
+
+//======================================================================
@@ -0,0 +1,265 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/BedrockLog.hpp"
+#include "engine/BedrockPath.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    std::string TempLogPath(char const * name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::string ReadAll(FILE * file)
+    {
+        fflush(file);
+        std::string content {};
+        rewind(file);
+        char buffer[4096];
+        size_t readSize = 0;
+        while ((readSize = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            content.append(buffer, readSize);
+        }
+        return content;
+    }
+
+    size_t CountOccurrences(std::string const & text, std::string const & pattern)
+    {
+        size_t count = 0;
+        for (auto position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    void LogFromThreads(uint32_t const threadCount, uint32_t const messageCount)
+    {
+        std::vector<std::thread> threads {};
+        for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+        {
+            threads.emplace_back([threadIndex, messageCount]()->void
+            {
+                for (uint32_t i = 0; i < messageCount; ++i)
+                {
+                    MFA_LOG(Warning, Entity, "Thread %u message %u, Value %f", threadIndex, i, static_cast<float>(i) * 0.5f);
+                }
+            });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    // Same work as the synchronous printf macros that the log thread replaced
+    void LegacyLogFromThreads(FILE * file, uint32_t const threadCount, uint32_t const messageCount)
+    {
+        std::vector<std::thread> threads {};
+        for (uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+        {
+            threads.emplace_back([file, threadIndex, messageCount]()->void
+            {
+                for (uint32_t i = 0; i < messageCount; ++i)
+                {
+                    fprintf(
+                        file,
+                        "\n-----------WARN------------\nFile: %s\nLine: %d\nFunction: %s\n" "Thread %u message %u, Value %f" "\n---------------------------\n",
+                        __FILE__,
+                        __LINE__,
+                        __FUNCTION__,
+                        threadIndex,
+                        i,
+                        static_cast<float>(i) * 0.5f
+                    );
+                }
+            });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
+
+//======================================================================
+
+TEST_CASE("Log TestCase1 Format", "[Log][0]")
+{
+    auto const check = [](std::string const & formatted, char const * expected)->void
+    {
+        CHECK(formatted == expected);
+    };
+
+    check(Log::Format("No arguments"), "No arguments");
+    check(Log::Format("%d %i %u", -5, 7, 42u), "-5 7 42");
+    check(Log::Format("%llu %zu %ld", static_cast<uint64_t>(1) << 40, static_cast<size_t>(12), -3L), "1099511627776 12 -3");
+    check(Log::Format("%5.2f|%-6d|%03d", 3.14159f, 12, 7), " 3.14|12    |007");
+    check(Log::Format("%x %X %o", 255, 255u, 8), "ff FF 10");
+    check(Log::Format("%s and %s", "first", std::string("second").c_str()), "first and second");
+    check(Log::Format("%.3s|%5s", "abcdef", "ab"), "abc|   ab");
+    check(Log::Format("%c%c", 'o', 'k'), "ok");
+    check(Log::Format("100%% %s", "done"), "100% done");
+    check(Log::Format("%*d", 4, 9), "   9");
+    check(Log::Format("%d %d", 1), "1 <missing>");
+
+    char const * nullString = nullptr;
+    check(Log::Format("[%s]", nullString), "[]");
+
+    enum class Color : uint8_t { Red = 2 };
+    check(Log::Format("%d", Color::Red), "2");
+}
+
+//======================================================================
+
+TEST_CASE("Log TestCase2 Multi threaded binary log", "[Log][1]")
+{
+    static constexpr uint32_t ThreadCount = 4;
+    static constexpr uint32_t MessageCount = 500;
+
+    auto const path = TempLogPath("mfa_test_log.bin");
+    Log::SetRateLimit(0);
+    Log::Init(Log::InitParams {
+        .textFile = nullptr,
+        .binaryFilePath = path,
+    });
+
+    auto const droppedCount = Log::GetDroppedCount();
+    LogFromThreads(ThreadCount, MessageCount);
+    Log::Shutdown();
+    REQUIRE(Log::GetDroppedCount() == droppedCount);
+
+    // Messages of each thread arrive in order and none is lost
+    std::vector<uint32_t> nextMessage(ThreadCount, 0);
+    uint64_t previousTimestamp = 0;
+    uint32_t totalCount = 0;
+    bool const success = Log::ReadBinaryFile(path, [&](Log::Message const & message)->void
+    {
+        CHECK(message.severity == Log::Severity::Warning);
+        CHECK(message.category == Log::Category::Entity);
+        CHECK(message.timestampNs >= previousTimestamp);
+        previousTimestamp = message.timestampNs;
+
+        uint32_t threadIndex = 0;
+        uint32_t messageIndex = 0;
+        float value = 0.0f;
+        REQUIRE(sscanf(message.text.c_str(), "Thread %u message %u, Value %f", &threadIndex, &messageIndex, &value) == 3);
+        REQUIRE(threadIndex < ThreadCount);
+        CHECK(messageIndex == nextMessage[threadIndex]);
+        CHECK(value == static_cast<float>(messageIndex) * 0.5f);
+        nextMessage[threadIndex] = messageIndex + 1;
+        ++totalCount;
+    });
+    CHECK(success);
+    CHECK(totalCount == ThreadCount * MessageCount);
+
+    Log::SetRateLimit(32);
+    std::filesystem::remove(path);
+}
+
+//======================================================================
+
+TEST_CASE("Log TestCase3 Filters and rate limit", "[Log][2]")
+{
+    auto * textFile = tmpfile();
+    REQUIRE(textFile != nullptr);
+
+    Log::Init(Log::InitParams {.textFile = textFile});
+
+    // Severity filter
+    Log::SetMinSeverity(Log::Severity::Warning);
+    MFA_LOG(Info, General, "Filtered info");
+    MFA_LOG(Warning, General, "Visible warning");
+
+    // Category filter
+    Log::SetCategoryEnabled(Log::Category::Physics, false);
+    MFA_LOG(Warning, Physics, "Filtered physics");
+    Log::SetCategoryEnabled(Log::Category::Physics, true);
+    MFA_LOG(Warning, Physics, "Visible physics");
+    Log::SetMinSeverity(Log::Severity::Debug);
+
+    // Rate limit, Same call site inside a hot loop
+    Log::SetRateLimit(5, 100);
+    auto const hotLoop = []()->void
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            MFA_LOG(Warning, Entity, "Repeated %d", i);
+        }
+    };
+    hotLoop();
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    hotLoop();
+
+    Log::Shutdown();
+    Log::SetRateLimit(32);
+
+    auto const content = ReadAll(textFile);
+    fclose(textFile);
+
+    CHECK(CountOccurrences(content, "Filtered") == 0);
+    CHECK(CountOccurrences(content, "Visible warning") == 1);
+    CHECK(CountOccurrences(content, "Visible physics") == 1);
+    CHECK(CountOccurrences(content, "Repeated") == 10);
+    CHECK(CountOccurrences(content, "(95 similar messages were suppressed)") == 1);
+    CHECK(CountOccurrences(content, "-----------WARN------------") == 12);
+}
+
+//======================================================================
+
+TEST_CASE("Log TestCase4 Multi threaded load", "[Log][3][!benchmark]")
+{
+    static constexpr uint32_t ThreadCount = 8;
+    static constexpr uint32_t MessageCount = 10000;
+
+    auto * textFile = tmpfile();
+    REQUIRE(textFile != nullptr);
+
+    Log::SetRateLimit(0);
+
+    BENCHMARK("Synchronous printf 8 threads x 10000")
+    {
+        LegacyLogFromThreads(textFile, ThreadCount, MessageCount);
+        return 0;
+    };
+
+    // Large rings so that nothing is dropped, Otherwise the comparison would be unfair
+    Log::Init(Log::InitParams {
+        .textFile = textFile,
+        .bufferSizePerThread = 4 * 1024 * 1024,
+    });
+
+    BENCHMARK("Log thread 8 threads x 10000, Producers only")
+    {
+        LogFromThreads(ThreadCount, MessageCount);
+        return 0;
+    };
+
+    BENCHMARK("Log thread 8 threads x 10000, Including flush")
+    {
+        LogFromThreads(ThreadCount, MessageCount);
+        Log::Flush();
+        return 0;
+    };
+
+    Log::Shutdown();
+    Log::SetRateLimit(32);
+    fclose(textFile);
+}
+
+//======================================================================
@@ -0,0 +1,343 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/BedrockMemory.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    bool IsAligned(void const * pointer, size_t const alignment)
+    {
+        return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+    }
+
+    struct SmallObject
+    {
+        explicit SmallObject(int const value_)
+            : value(value_)
+        {}
+
+        int value = 0;
+        float data[7] {};
+    };
+}
+
+//======================================================================
+
+TEST_CASE("Memory TestCase1 Linear arena", "[Memory][0]")
+{
+    auto const statsBefore = Memory::GetStats(Memory::Tag::Scratch);
+    {
+        Memory::LinearArena arena {1000, Memory::Tag::Scratch};
+        CHECK(arena.GetCapacity() >= 1000);
+        CHECK(Memory::GetStats(Memory::Tag::Scratch).currentBytes == statsBefore.currentBytes + arena.GetCapacity());
+
+        auto const first = arena.Alloc(3);
+        auto const second = arena.Alloc(10);
+        auto const third = arena.Alloc(8, 64);
+        CHECK(IsAligned(first.ptr, Memory::DefaultAlignment));
+        CHECK(IsAligned(second.ptr, Memory::DefaultAlignment));
+        CHECK(IsAligned(third.ptr, 64));
+        CHECK(second.ptr >= first.ptr + first.len);
+        CHECK(third.ptr >= second.ptr + second.len);
+
+        auto const values = arena.AllocArray<uint32_t>(10);
+        CHECK(values.len == 10);
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            values.ptr[i] = i;
+        }
+
+        // Marker releases only what came after it
+        auto const marker = arena.GetMarker();
+        auto const temporary = arena.Alloc(100);
+        arena.ResetToMarker(marker);
+        CHECK(arena.Alloc(100).ptr == temporary.ptr);
+        CHECK(values.ptr[9] == 9);
+
+        arena.Reset();
+        CHECK(arena.GetUsedBytes() == 0);
+        CHECK(arena.Alloc(3).ptr == first.ptr);
+    }
+    CHECK(Memory::GetStats(Memory::Tag::Scratch).currentBytes == statsBefore.currentBytes);
+}
+
+//======================================================================
+
+TEST_CASE("Memory TestCase2 Linear arena overflow and growth", "[Memory][1]")
+{
+    Memory::LinearArena arena {256, Memory::Tag::Scratch};
+    auto const capacity = arena.GetCapacity();
+
+    std::vector<Blob> blobs {};
+    for (int i = 0; i < 10; ++i)
+    {
+        auto const blob = arena.Alloc(100);
+        REQUIRE(blob.ptr != nullptr);
+        memset(blob.ptr, i, blob.len);
+        blobs.emplace_back(blob);
+    }
+    // Blocks that did not fit are still valid and separate
+    for (int i = 0; i < 10; ++i)
+    {
+        CHECK(blobs[i].ptr[0] == i);
+        CHECK(blobs[i].ptr[99] == i);
+    }
+    CHECK(arena.GetUsedBytes() > capacity);
+    CHECK(arena.GetCapacity() == capacity);
+
+    // Next reset grows the arena, So the same usage fits without overflow
+    arena.Reset();
+    CHECK(arena.GetCapacity() > capacity);
+    auto const grownCapacity = arena.GetCapacity();
+    for (int i = 0; i < 10; ++i)
+    {
+        (void)arena.Alloc(100);
+    }
+    CHECK(arena.GetUsedBytes() <= grownCapacity);
+    arena.Reset();
+    CHECK(arena.GetCapacity() == grownCapacity);
+
+    // Growth stops at the max capacity, Larger usage keeps using overflow blocks
+    Memory::LinearArena limitedArena {256, Memory::Tag::Scratch, 512};
+    for (int i = 0; i < 10; ++i)
+    {
+        (void)limitedArena.Alloc(100);
+    }
+    limitedArena.Reset();
+    CHECK(limitedArena.GetCapacity() == 512);
+}
+
+//======================================================================
+
+TEST_CASE("Memory TestCase3 Linear arena from multiple threads", "[Memory][2]")
+{
+    static constexpr uint32_t ThreadCount = 4;
+    static constexpr uint32_t AllocationCount = 1000;
+
+    // Half of the allocations overflow
+    Memory::LinearArena arena {ThreadCount * AllocationCount * 32 / 2, Memory::Tag::Frame};
+
+    std::vector<std::vector<uint8_t *>> pointers(ThreadCount);
+    std::vector<std::thread> threads {};
+    for (uint32_t threadIndex = 0; threadIndex < ThreadCount; ++threadIndex)
+    {
+        threads.emplace_back([&arena, &pointers, threadIndex]()->void
+        {
+            for (uint32_t i = 0; i < AllocationCount; ++i)
+            {
+                auto const blob = arena.Alloc(32);
+                memset(blob.ptr, static_cast<int>(threadIndex), blob.len);
+                pointers[threadIndex].emplace_back(blob.ptr);
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    std::set<uint8_t *> uniquePointers {};
+    for (uint32_t threadIndex = 0; threadIndex < ThreadCount; ++threadIndex)
+    {
+        for (auto * pointer : pointers[threadIndex])
+        {
+            uniquePointers.insert(pointer);
+            CHECK(pointer[0] == threadIndex);
+            CHECK(pointer[31] == threadIndex);
+        }
+    }
+    CHECK(uniquePointers.size() == ThreadCount * AllocationCount);
+}
+
+//======================================================================
+
+TEST_CASE("Memory TestCase4 Scratch and frame arenas", "[Memory][3]")
+{
+    uint8_t * outerPointer = nullptr;
+    {
+        Memory::ScratchScope outer {};
+        auto const outerBlob = outer.Alloc(64);
+        outerPointer = outerBlob.ptr;
+        memset(outerBlob.ptr, 1, outerBlob.len);
+
+        uint8_t * innerPointer = nullptr;
+        {
+            Memory::ScratchScope inner {};
+            innerPointer = inner.Alloc(64).ptr;
+            CHECK(innerPointer != outerPointer);
+        }
+        {
+            // Memory of the ended inner scope is reused
+            Memory::ScratchScope inner {};
+            CHECK(inner.Alloc(64).ptr == innerPointer);
+        }
+        CHECK(outerBlob.ptr[63] == 1);
+    }
+    {
+        Memory::ScratchScope scope {};
+        CHECK(scope.Alloc(64).ptr == outerPointer);
+    }
+
+    // Each thread has its own arena
+    uint8_t * otherThreadPointer = nullptr;
+    std::thread thread {[&otherThreadPointer]()->void
+    {
+        Memory::ScratchScope scope {};
+        otherThreadPointer = scope.Alloc(64).ptr;
+    }};
+    thread.join();
+    CHECK(otherThreadPointer != outerPointer);
+
+    // Frame arenas are reset when their frame slot comes around again
+    Memory::Init(Memory::InitParams {.framesInFlight = 2, .frameArenaSize = 1024});
+    Memory::BeginFrame(0);
+    auto const frame0 = Memory::FrameAlloc(100);
+    Memory::BeginFrame(1);
+    auto const frame1 = Memory::FrameAllocArray<uint32_t>(25);
+    CHECK(frame0.ptr != frame1.as<uint8_t>());
+    Memory::BeginFrame(0);
+    CHECK(Memory::FrameAlloc(100).ptr == frame0.ptr);
+    Memory::Shutdown();
+}
+
+//======================================================================
+
+TEST_CASE("Memory TestCase5 Pools", "[Memory][4]")
+{
+    {
+        Memory::FixedPool pool {24, 4, Memory::Tag::Pool};
+        CHECK(pool.GetBlockSize() == 32);
+        CHECK(pool.GetPageCount() == 0);
+
+        std::vector<void *> blocks {};
+        for (int i = 0; i < 6; ++i)
+        {
+            blocks.emplace_back(pool.Alloc());
+            CHECK(IsAligned(blocks.back(), Memory::DefaultAlignment));
+        }
+        CHECK(pool.GetPageCount() == 2);
+        CHECK(pool.GetUsedBlockCount() == 6);
+
+        // Freed block is the next one to be reused
+        auto * freed = blocks[2];
+        pool.Free(freed);
+        CHECK(pool.Alloc() == freed);
+
+        for (auto * block : blocks)
+        {
+            pool.Free(block);
+        }
+        CHECK(pool.GetUsedBlockCount() == 0);
+        CHECK(pool.GetPageCount() == 2);
+    }
+
+    // Size class pools from multiple threads
+    std::vector<std::thread> threads {};
+    for (int threadIndex = 0; threadIndex < 4; ++threadIndex)
+    {
+        threads.emplace_back([threadIndex]()->void
+        {
+            std::vector<std::shared_ptr<SmallObject>> objects {};
+            for (int i = 0; i < 2000; ++i)
+            {
+                objects.emplace_back(std::allocate_shared<SmallObject>(
+                    Memory::PoolAllocator<SmallObject> {},
+                    threadIndex * 10000 + i
+                ));
+                if (i % 3 == 0)
+                {
+                    objects.erase(objects.begin() + i / 2);
+                }
+            }
+            for (auto const & object : objects)
+            {
+                CHECK(object->value / 10000 == threadIndex);
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<int, Memory::PoolAllocator<int>> values {};
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.emplace_back(i);
+    }
+    CHECK(values[999] == 999);
+
+    // Larger sizes fall back to the heap
+    auto * large = Memory::PoolAlloc(Memory::MaxPoolBlockSize + 1);
+    CHECK(large != nullptr);
+    Memory::PoolFree(large, Memory::MaxPoolBlockSize + 1);
+}
+
+//======================================================================
+
+TEST_CASE("Memory TestCase6 Allocation cost", "[Memory][5][!benchmark]")
+{
+    static constexpr int ObjectCount = 10000;
+
+    BENCHMARK("make_shared 10000 small objects")
+    {
+        std::vector<std::shared_ptr<SmallObject>> objects {};
+        objects.reserve(ObjectCount);
+        for (int i = 0; i < ObjectCount; ++i)
+        {
+            objects.emplace_back(std::make_shared<SmallObject>(i));
+        }
+        return objects.size();
+    };
+
+    BENCHMARK("allocate_shared with pool 10000 small objects")
+    {
+        std::vector<std::shared_ptr<SmallObject>> objects {};
+        objects.reserve(ObjectCount);
+        for (int i = 0; i < ObjectCount; ++i)
+        {
+            objects.emplace_back(std::allocate_shared<SmallObject>(Memory::PoolAllocator<SmallObject> {}, i));
+        }
+        return objects.size();
+    };
+
+    BENCHMARK("Memory::Alloc 10000 temporary buffers")
+    {
+        size_t sum = 0;
+        for (int i = 0; i < ObjectCount; ++i)
+        {
+            auto const blob = Memory::Alloc(256 + i % 64);
+            blob->memory.ptr[0] = static_cast<uint8_t>(i);
+            sum += blob->memory.ptr[0];
+        }
+        return sum;
+    };
+
+    BENCHMARK("Scratch 10000 temporary buffers")
+    {
+        size_t sum = 0;
+        for (int i = 0; i < ObjectCount; ++i)
+        {
+            Memory::ScratchScope scratch {};
+            auto const blob = scratch.Alloc(256 + i % 64);
+            blob.ptr[0] = static_cast<uint8_t>(i);
+            sum += blob.ptr[0];
+        }
+        return sum;
+    };
+}
+
+//======================================================================
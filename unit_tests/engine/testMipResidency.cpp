@@ -0,0 +1,189 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/resource_manager/MipResidency.hpp"
+
+#include <vector>
+
+using namespace MFA;
+using namespace MFA::ResourceManager;
+
+//======================================================================
+
+namespace
+{
+    // Mips 0 and 1 are streamed, 64 + 16 bytes
+    std::vector<size_t> const MipSizes {64, 16, 4, 1};
+    uint8_t constexpr TailMip = 2;
+
+    void ApplyAll(MipResidency & residency, std::vector<MipResidency::Change> const & changes)
+    {
+        for (auto const & change : changes)
+        {
+            residency.OnChangeApplied(change.handle);
+        }
+    }
+}
+
+//======================================================================
+
+TEST_CASE("MipResidency TestCase1 Desired mip", "[MipResidency][0]")
+{
+    CHECK(ComputeDesiredMip(1024, 1024.0f, 11) == 0);
+    CHECK(ComputeDesiredMip(1024, 2000.0f, 11) == 0);
+    CHECK(ComputeDesiredMip(1024, 256.0f, 11) == 2);
+    CHECK(ComputeDesiredMip(1024, 300.0f, 11) == 1);
+    // Not on the screen or smaller than the chain
+    CHECK(ComputeDesiredMip(1024, 0.0f, 11) == 10);
+    CHECK(ComputeDesiredMip(1024, 1.0f, 5) == 4);
+}
+
+//======================================================================
+
+TEST_CASE("MipResidency TestCase2 Promotion", "[MipResidency][1]")
+{
+    MipResidency residency {1000};
+    auto const handle = residency.Add(MipSizes, TailMip);
+    CHECK(residency.GetResidentMip(handle) == TailMip);
+
+    // Nothing streams without a request
+    CHECK(residency.Update().empty());
+
+    // Smallest requested mip wins and requests start over after each update
+    residency.Request(handle, 1);
+    residency.Request(handle, 3);
+    auto changes = residency.Update();
+    REQUIRE(changes.size() == 1);
+    CHECK(changes[0].handle == handle);
+    CHECK(changes[0].firstMip == 1);
+
+    // Change in flight is counted and is not planned again
+    CHECK(residency.GetStats().residentBytes == 16);
+    CHECK(residency.GetStats().pendingCount == 1);
+    residency.Request(handle, 0);
+    CHECK(residency.Update().empty());
+    CHECK(residency.GetResidentMip(handle) == TailMip);
+
+    ApplyAll(residency, changes);
+    CHECK(residency.GetResidentMip(handle) == 1);
+    CHECK(residency.GetStats().pendingCount == 0);
+
+    residency.Request(handle, 0);
+    changes = residency.Update();
+    REQUIRE(changes.size() == 1);
+    CHECK(changes[0].firstMip == 0);
+
+    // Failed load gives the bytes back
+    residency.OnChangeFailed(handle);
+    CHECK(residency.GetResidentMip(handle) == 1);
+    CHECK(residency.GetStats().residentBytes == 16);
+    CHECK(residency.GetStats().pendingCount == 0);
+
+    // Unused texture keeps its mips while they fit
+    for (int i = 0; i < 10; ++i)
+    {
+        CHECK(residency.Update().empty());
+    }
+    CHECK(residency.GetResidentMip(handle) == 1);
+
+    residency.Remove(handle);
+    CHECK(residency.GetStats().residentBytes == 0);
+    CHECK(residency.GetStats().textureCount == 0);
+}
+
+//======================================================================
+
+TEST_CASE("MipResidency TestCase3 LRU eviction of top mips", "[MipResidency][2]")
+{
+    MipResidency residency {160};
+    auto const a = residency.Add(MipSizes, TailMip);
+    auto const b = residency.Add(MipSizes, TailMip);
+    auto const c = residency.Add(MipSizes, TailMip);
+
+    residency.Request(a, 0);
+    auto changes = residency.Update();
+    REQUIRE(changes.size() == 1);
+    ApplyAll(residency, changes);
+
+    residency.Request(b, 1);
+    ApplyAll(residency, residency.Update());
+    CHECK(residency.GetStats().residentBytes == 96);
+
+    // Only the top mip of the least recently requested texture goes
+    residency.Request(c, 0);
+    changes = residency.Update();
+    REQUIRE(changes.size() == 2);
+    CHECK(changes[0].handle == a);
+    CHECK(changes[0].firstMip == 1);
+    CHECK(changes[1].handle == c);
+    CHECK(changes[1].firstMip == 0);
+    ApplyAll(residency, changes);
+    CHECK(residency.GetResidentMip(a) == 1);
+    CHECK(residency.GetResidentMip(b) == 1);
+    CHECK(residency.GetResidentMip(c) == 0);
+    CHECK(residency.GetStats().residentBytes == 16 + 16 + 80);
+    CHECK(residency.GetStats().evictionCount == 1);
+
+    // Textures in use keep what they asked for, So a gets less than it wants
+    residency.Request(a, 0);
+    residency.Request(b, 1);
+    residency.Request(c, 0);
+    CHECK(residency.Update().empty());
+
+    // Lower budget drops the least recently requested mips first
+    residency.Request(c, 0);
+    residency.SetBudget(80);
+    changes = residency.Update();
+    ApplyAll(residency, changes);
+    CHECK(residency.GetResidentMip(a) == TailMip);
+    CHECK(residency.GetResidentMip(b) == TailMip);
+    CHECK(residency.GetResidentMip(c) == 0);
+    CHECK(residency.GetStats().residentBytes == 80);
+}
+
+//======================================================================
+
+TEST_CASE("MipResidency TestCase4 Pending limit", "[MipResidency][3]")
+{
+    MipResidency residency {10000, 2};
+    std::vector<MipResidency::Handle> handles {};
+    for (int i = 0; i < 5; ++i)
+    {
+        handles.emplace_back(residency.Add(MipSizes, TailMip));
+    }
+
+    // Textures that miss more mips go first
+    for (int i = 0; i < 5; ++i)
+    {
+        residency.Request(handles[i], i == 3 ? 0 : 1);
+    }
+    auto changes = residency.Update();
+    REQUIRE(changes.size() == 2);
+    CHECK(changes[0].handle == handles[3]);
+
+    // Rest wait for the pending ones
+    for (auto const handle : handles)
+    {
+        residency.Request(handle, 1);
+    }
+    CHECK(residency.Update().empty());
+
+    ApplyAll(residency, changes);
+    for (auto const handle : handles)
+    {
+        residency.Request(handle, 1);
+    }
+    CHECK(residency.Update().size() == 2);
+
+    // Removing a texture with a change in flight frees its slot, Its late report is ignored
+    residency.Remove(handles[0]);
+    residency.Remove(handles[1]);
+    residency.Remove(handles[2]);
+    residency.OnChangeApplied(handles[0]);
+    CHECK(residency.GetStats().pendingCount == 0);
+}
+
+//======================================================================
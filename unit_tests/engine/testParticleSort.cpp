@@ -0,0 +1,233 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/BedrockMath.hpp"
+#include "engine/asset_system/AssetParticleMesh.hpp"
+#include "engine/render_system/pipelines/particle/ParticleSort.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    using DrawEntry = AS::Particle::DrawEntry;
+
+    static constexpr float SentinelKey = std::numeric_limits<float>::max();
+
+    bool ShouldSwap(DrawEntry const & left, DrawEntry const & right, bool const ascending)
+    {
+        return (left.sortKey > right.sortKey) == ascending;
+    }
+
+    // Same steps as localStep in ParticleSort.comp.hlsl, Threads of a group run one after another
+    void LocalStep(DrawEntry * localEntries, uint32_t const groupOffset, uint32_t const k, uint32_t const j)
+    {
+        for (uint32_t thread = 0; thread < ParticleSort::GroupSize; ++thread)
+        {
+            auto const left = (thread / j) * 2 * j + (thread % j);
+            auto const right = left + j;
+            bool const ascending = ((groupOffset + left) & k) == 0;
+            if (ShouldSwap(localEntries[left], localEntries[right], ascending))
+            {
+                std::swap(localEntries[left], localEntries[right]);
+            }
+        }
+    }
+
+    // Cpu version of ParticleSort.comp.hlsl
+    void ExecutePass(ParticleSort::Pass const & pass, std::vector<DrawEntry> & drawList, uint32_t const aliveCount)
+    {
+        if (pass.stage == ParticleSort::Stage::GlobalMerge)
+        {
+            for (uint32_t thread = 0; thread < pass.groupCount * ParticleSort::GroupSize; ++thread)
+            {
+                auto const left = (thread / pass.j) * 2 * pass.j + (thread % pass.j);
+                auto const right = left + pass.j;
+                bool const ascending = (left & pass.k) == 0;
+                if (ShouldSwap(drawList[left], drawList[right], ascending))
+                {
+                    std::swap(drawList[left], drawList[right]);
+                }
+            }
+            return;
+        }
+
+        DrawEntry localEntries[ParticleSort::LocalSize];
+        for (uint32_t group = 0; group < pass.groupCount; ++group)
+        {
+            auto const groupOffset = group * ParticleSort::LocalSize;
+            for (uint32_t i = 0; i < ParticleSort::LocalSize; ++i)
+            {
+                localEntries[i] = drawList[groupOffset + i];
+                if (pass.stage == ParticleSort::Stage::LocalSort && groupOffset + i >= aliveCount)
+                {
+                    localEntries[i].sortKey = SentinelKey;
+                }
+            }
+
+            if (pass.stage == ParticleSort::Stage::LocalSort)
+            {
+                for (uint32_t k = 2; k <= ParticleSort::LocalSize; k <<= 1)
+                {
+                    for (uint32_t j = k >> 1; j > 0; j >>= 1)
+                    {
+                        LocalStep(localEntries, groupOffset, k, j);
+                    }
+                }
+            }
+            else
+            {
+                for (uint32_t j = ParticleSort::LocalSize >> 1; j > 0; j >>= 1)
+                {
+                    LocalStep(localEntries, groupOffset, pass.k, j);
+                }
+            }
+
+            std::copy_n(localEntries, ParticleSort::LocalSize, drawList.begin() + groupOffset);
+        }
+    }
+
+    // Alive entries are followed by stale ones, As simulation leaves them
+    std::vector<DrawEntry> MakeDrawList(Math::RandomGenerator & generator, uint32_t const capacity, uint32_t const aliveCount)
+    {
+        std::vector<DrawEntry> drawList(ParticleSort::PaddedCount(capacity));
+        for (uint32_t i = 0; i < static_cast<uint32_t>(drawList.size()); ++i)
+        {
+            drawList[i].sortKey = i < aliveCount ? generator.NextFloat(-100.0f, 0.0f) : -1000.0f;
+            drawList[i].particleIndex = i;
+        }
+        return drawList;
+    }
+
+    void RunPlan(std::vector<ParticleSort::Pass> const & plan, std::vector<DrawEntry> & drawList, uint32_t const aliveCount)
+    {
+        for (auto const & pass : plan)
+        {
+            ExecutePass(pass, drawList, aliveCount);
+        }
+    }
+}
+
+//======================================================================
+
+TEST_CASE("ParticleSort TestCase1 Plan", "[ParticleSort][0]")
+{
+    CHECK(ParticleSort::PaddedCount(1) == ParticleSort::LocalSize);
+    CHECK(ParticleSort::PaddedCount(ParticleSort::LocalSize) == ParticleSort::LocalSize);
+    CHECK(ParticleSort::PaddedCount(ParticleSort::LocalSize + 1) == ParticleSort::LocalSize * 2);
+    CHECK(ParticleSort::PaddedCount(1024 * 1024) == 1024 * 1024);
+    CHECK(ParticleSort::PaddedCount(1000 * 1000) == 1024 * 1024);
+
+    std::vector<ParticleSort::Pass> plan {};
+
+    // Single block is sorted in shared memory only
+    ParticleSort::BuildPlan(100, plan);
+    REQUIRE(plan.size() == 1);
+    CHECK(plan[0].stage == ParticleSort::Stage::LocalSort);
+    CHECK(plan[0].groupCount == 1);
+
+    // 2^20 entries: Merges k = 2^10 ... 2^20 need 1 + 2 + ... + 11 global steps and one local merge each
+    ParticleSort::BuildPlan(1024 * 1024, plan);
+    CHECK(plan.size() == 1 + 66 + 11);
+    uint32_t globalMergeCount = 0;
+    for (auto const & pass : plan)
+    {
+        if (pass.stage == ParticleSort::Stage::GlobalMerge)
+        {
+            ++globalMergeCount;
+            CHECK(pass.j >= ParticleSort::LocalSize);
+            CHECK(pass.groupCount * ParticleSort::GroupSize * 2 == 1024 * 1024);
+        }
+        else
+        {
+            CHECK(pass.groupCount * ParticleSort::LocalSize == 1024 * 1024);
+        }
+    }
+    CHECK(globalMergeCount == 66);
+    CHECK(plan.back().stage == ParticleSort::Stage::LocalMerge);
+    CHECK(plan.back().k == 1024 * 1024);
+}
+
+//======================================================================
+
+TEST_CASE("ParticleSort TestCase2 Sorts alive entries", "[ParticleSort][1]")
+{
+    Math::RandomGenerator generator {1};
+    std::vector<ParticleSort::Pass> plan {};
+
+    for (uint32_t const capacity : {1u, 100u, 512u, 513u, 3000u, 70000u})
+    {
+        for (uint32_t const aliveCount : {0u, capacity / 3, capacity})
+        {
+            auto drawList = MakeDrawList(generator, capacity, aliveCount);
+            auto expected = std::vector<DrawEntry>(drawList.begin(), drawList.begin() + aliveCount);
+
+            ParticleSort::BuildPlan(capacity, plan);
+            RunPlan(plan, drawList, aliveCount);
+
+            // Alive entries come first in ascending order, Then the sentinels
+            for (uint32_t i = 1; i < static_cast<uint32_t>(drawList.size()); ++i)
+            {
+                REQUIRE(drawList[i - 1].sortKey <= drawList[i].sortKey);
+            }
+            for (uint32_t i = aliveCount; i < static_cast<uint32_t>(drawList.size()); ++i)
+            {
+                REQUIRE(drawList[i].sortKey == SentinelKey);
+            }
+
+            // Every alive particle is drawn once
+            std::vector<uint32_t> sortedIndices {};
+            for (uint32_t i = 0; i < aliveCount; ++i)
+            {
+                sortedIndices.emplace_back(drawList[i].particleIndex);
+            }
+            std::sort(sortedIndices.begin(), sortedIndices.end());
+            for (uint32_t i = 0; i < aliveCount; ++i)
+            {
+                REQUIRE(sortedIndices[i] == expected[i].particleIndex);
+            }
+        }
+    }
+}
+
+//======================================================================
+
+TEST_CASE("ParticleSort TestCase3 Million particles", "[ParticleSort][2][!benchmark]")
+{
+    static constexpr uint32_t Capacity = 1024 * 1024;
+    static constexpr uint32_t AliveCount = 1000 * 1000;
+
+    Math::RandomGenerator generator {2};
+    std::vector<ParticleSort::Pass> plan {};
+    ParticleSort::BuildPlan(Capacity, plan);
+
+    auto const source = MakeDrawList(generator, Capacity, AliveCount);
+
+    // Cpu emulation of the gpu passes, Useful to compare the amount of work with a comparison sort
+    BENCHMARK("Bitonic plan 1M")
+    {
+        auto drawList = source;
+        RunPlan(plan, drawList, AliveCount);
+        return drawList[0].sortKey;
+    };
+
+    BENCHMARK("std::sort 1M")
+    {
+        auto drawList = std::vector<DrawEntry>(source.begin(), source.begin() + AliveCount);
+        std::sort(drawList.begin(), drawList.end(), [](DrawEntry const & a, DrawEntry const & b)->bool
+        {
+            return a.sortKey < b.sortKey;
+        });
+        return drawList[0].sortKey;
+    };
+}
+
+//======================================================================
@@ -0,0 +1,287 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/BedrockMath.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    // Pearson chi square of values in [0, 1) over equal bins
+    template<size_t BinCount>
+    double ChiSquare(std::vector<float> const & values)
+    {
+        std::array<int, BinCount> bins {};
+        for (auto const value : values)
+        {
+            ++bins[std::min(BinCount - 1, static_cast<size_t>(value * BinCount))];
+        }
+        auto const expected = static_cast<double>(values.size()) / BinCount;
+        double chiSquare = 0.0;
+        for (auto const count : bins)
+        {
+            auto const difference = count - expected;
+            chiSquare += difference * difference / expected;
+        }
+        return chiSquare;
+    }
+
+    // Lag one serial correlation, Should be close to zero for independent values
+    double SerialCorrelation(std::vector<float> const & values)
+    {
+        double sum = 0.0;
+        double sqrSum = 0.0;
+        double productSum = 0.0;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            sum += values[i];
+            sqrSum += values[i] * values[i];
+            productSum += values[i] * values[(i + 1) % values.size()];
+        }
+        auto const count = static_cast<double>(values.size());
+        return (count * productSum - sum * sum) / (count * sqrSum - sum * sum);
+    }
+}
+
+//======================================================================
+
+TEST_CASE("Random TestCase1 Deterministic seed", "[Random][0]")
+{
+    Math::RandomGenerator a {42};
+    Math::RandomGenerator b {42};
+    Math::RandomGenerator c {43};
+    bool isDifferent = false;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto const value = a.NextUInt();
+        CHECK(value == b.NextUInt());
+        isDifferent |= value != c.NextUInt();
+    }
+    CHECK(isDifferent);
+
+    // Jumped stream does not start inside the original one
+    Math::RandomGenerator jumped {42};
+    jumped.Jump();
+    Math::RandomGenerator original {42};
+    std::vector<uint32_t> originalValues {};
+    for (int i = 0; i < 1000; ++i)
+    {
+        originalValues.emplace_back(original.NextUInt());
+    }
+    CHECK(std::ranges::find(originalValues, jumped.NextUInt()) == originalValues.end());
+
+    // Thread generator repeats after the same seed
+    Math::SetRandomSeed(7);
+    std::vector<float> first {};
+    for (int i = 0; i < 100; ++i)
+    {
+        first.emplace_back(Math::Random(0.0f, 1.0f));
+    }
+    std::vector<float> firstBatch (1000);
+    Math::FillRandom(firstBatch.data(), firstBatch.size());
+
+    Math::SetRandomSeed(7);
+    for (int i = 0; i < 100; ++i)
+    {
+        CHECK(Math::Random(0.0f, 1.0f) == first[i]);
+    }
+    std::vector<float> secondBatch (1000);
+    Math::FillRandom(secondBatch.data(), secondBatch.size());
+    CHECK(firstBatch == secondBatch);
+
+    // Other threads get their own stream in deterministic mode
+    float otherThreadValue = 0.0f;
+    std::thread thread {[&otherThreadValue]()->void
+    {
+        otherThreadValue = Math::Random(0.0f, 1.0f);
+    }};
+    thread.join();
+
+    Math::SetRandomSeed(7);
+    CHECK(otherThreadValue != Math::Random(0.0f, 1.0f));
+
+    Math::ClearRandomSeed();
+}
+
+TEST_CASE("Random TestCase2 Batch matches lanes", "[Random][1]")
+{
+    // Batch values come from RandomLaneCount generators that are seeded from the parent generator.
+    // Scaling by a power of two is exact, So every kernel gives the same bits as NextFloat.
+    static constexpr int BlockCount = 100;
+    static constexpr float Min = -2.0f;
+    static constexpr float Max = 3.0f;
+
+    Math::RandomGenerator parent {5};
+    std::vector<Math::RandomGenerator> lanes {};
+    for (int i = 0; i < Math::RandomLaneCount; ++i)
+    {
+        auto const seed = (static_cast<uint64_t>(parent.NextUInt()) << 32) | parent.NextUInt();
+        lanes.emplace_back(seed);
+    }
+
+    Math::RandomGenerator generator {5};
+    std::vector<float> values (BlockCount * Math::RandomLaneCount + 3);
+    Math::FillRandom(generator, values.data(), values.size(), Min, Max);
+
+    for (int block = 0; block < BlockCount; ++block)
+    {
+        for (int lane = 0; lane < Math::RandomLaneCount; ++lane)
+        {
+            auto const expected = lanes[lane].NextFloat(Min, Max);
+            REQUIRE(values[block * Math::RandomLaneCount + lane] == expected);
+        }
+    }
+
+    // Remainder is drawn from the parent generator
+    for (size_t i = BlockCount * Math::RandomLaneCount; i < values.size(); ++i)
+    {
+        CHECK(values[i] == parent.NextFloat(Min, Max));
+    }
+
+    for (auto const value : values)
+    {
+        REQUIRE(value >= Min);
+        REQUIRE(value < Max);
+    }
+}
+
+TEST_CASE("Random TestCase3 Quality", "[Random][2]")
+{
+    static constexpr size_t SampleCount = 1 << 20;
+
+    Math::RandomGenerator generator {11};
+
+    std::vector<float> scalarValues (SampleCount);
+    for (auto & value : scalarValues)
+    {
+        value = generator.NextFloat();
+    }
+    std::vector<float> batchValues (SampleCount);
+    Math::FillRandom(generator, batchValues.data(), batchValues.size());
+
+    for (auto const * values : {&scalarValues, &batchValues})
+    {
+        double mean = 0.0;
+        double variance = 0.0;
+        for (auto const value : *values)
+        {
+            mean += value;
+        }
+        mean /= SampleCount;
+        for (auto const value : *values)
+        {
+            variance += (value - mean) * (value - mean);
+        }
+        variance /= SampleCount;
+
+        CHECK(mean == Approx(0.5).margin(0.002));
+        CHECK(variance == Approx(1.0 / 12.0).margin(0.001));
+        // 255 degrees of freedom, 99.9% critical value is about 330
+        CHECK(ChiSquare<256>(*values) < 330.0);
+        CHECK(std::abs(SerialCorrelation(*values)) < 0.005);
+    }
+
+    std::vector<glm::vec3> vectors (SampleCount / 4);
+    Math::FillRandomUnitVectors(generator, vectors.data(), vectors.size());
+    glm::dvec3 vectorSum {};
+    for (auto const & vector : vectors)
+    {
+        REQUIRE(glm::length(vector) == Approx(1.0f).margin(1e-5));
+        vectorSum += glm::dvec3 {vector};
+    }
+    vectorSum /= static_cast<double>(vectors.size());
+    CHECK(glm::length(vectorSum) < 0.01);
+
+    static constexpr float Radius = 2.0f;
+    std::vector<glm::vec2> points (SampleCount / 4);
+    Math::FillRandomInDisk(generator, points.data(), points.size(), Radius);
+    int innerCount = 0;
+    std::array<int, 8> octantCounts {};
+    for (auto const & point : points)
+    {
+        auto const angle = std::atan2(point.y, point.x) + Math::PiFloat;
+        ++octantCounts[std::min(7, static_cast<int>(angle / (Math::PiFloat * 0.25f)))];
+
+        auto const distance = glm::length(point);
+        REQUIRE(distance <= Radius * 1.0001f);
+        // Area inside half of the radius is a quarter of the disk
+        if (distance < Radius * 0.5f)
+        {
+            ++innerCount;
+        }
+    }
+    CHECK(static_cast<double>(innerCount) / points.size() == Approx(0.25).margin(0.005));
+    for (auto const count : octantCounts)
+    {
+        CHECK(static_cast<double>(count) / points.size() == Approx(0.125).margin(0.005));
+    }
+}
+
+TEST_CASE("Random TestCase4 Throughput", "[Random][3][!benchmark]")
+{
+    static constexpr size_t SampleCount = 1 << 16;
+
+    std::vector<float> values (SampleCount);
+    std::vector<glm::vec3> vectors (SampleCount);
+    std::vector<glm::vec2> points (SampleCount);
+
+    BENCHMARK("std::rand")
+    {
+        for (auto & value : values)
+        {
+            value = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
+        }
+        return values[0];
+    };
+
+    BENCHMARK("Math::Random")
+    {
+        for (auto & value : values)
+        {
+            value = Math::Random(0.0f, 1.0f);
+        }
+        return values[0];
+    };
+
+    auto & generator = Math::GetRandomGenerator();
+    BENCHMARK("RandomGenerator::NextFloat")
+    {
+        for (auto & value : values)
+        {
+            value = generator.NextFloat();
+        }
+        return values[0];
+    };
+
+    BENCHMARK("FillRandom")
+    {
+        Math::FillRandom(generator, values.data(), values.size());
+        return values[0];
+    };
+
+    BENCHMARK("FillRandomUnitVectors")
+    {
+        Math::FillRandomUnitVectors(generator, vectors.data(), vectors.size());
+        return vectors[0];
+    };
+
+    BENCHMARK("FillRandomInDisk")
+    {
+        Math::FillRandomInDisk(generator, points.data(), points.size());
+        return points[0];
+    };
+}
@@ -0,0 +1,228 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/resource_manager/ResourceCache.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace MFA;
+using namespace MFA::ResourceManager;
+
+//======================================================================
+
+namespace
+{
+    struct Asset
+    {
+        explicit Asset(int const value_)
+            : value(value_)
+        {}
+
+        int value = 0;
+    };
+
+    using AssetCallback = std::function<void(std::shared_ptr<Asset> const & asset)>;
+    using AssetCache = ResourceCache<Asset, AssetCallback>;
+
+    // Loads synchronously when the asset is not cached, Loaded value is ignored on a hit
+    std::shared_ptr<Asset> Load(AssetCache & cache, std::string const & id, int const value, size_t const sizeBytes)
+    {
+        auto & entry = cache.GetEntry(id);
+        bool shouldLoad = false;
+        auto const existing = cache.Acquire(entry, nullptr, true, shouldLoad);
+        if (existing != nullptr)
+        {
+            return existing;
+        }
+        REQUIRE(shouldLoad);
+        auto const loaded = std::make_shared<Asset>(value);
+        (void)cache.Store(entry, loaded, sizeBytes);
+        return loaded;
+    }
+}
+
+//======================================================================
+
+TEST_CASE("ResourceCache TestCase1 Hit, Miss and waiting callbacks", "[ResourceCache][0]")
+{
+    CacheBudget budget {1000};
+    AssetCache cache {&budget};
+
+    auto & entry = cache.GetEntry("a");
+    CHECK(&cache.GetEntry("a") == &entry);
+
+    std::vector<int> received {};
+    auto const callback = [&received](std::shared_ptr<Asset> const & asset)->void
+    {
+        received.emplace_back(asset != nullptr ? asset->value : 0);
+    };
+
+    // Only the first waiting callback starts the load
+    bool firstShouldLoad = false;
+    bool secondShouldLoad = false;
+    CHECK(cache.Acquire(entry, callback, true, firstShouldLoad) == nullptr);
+    CHECK(cache.Acquire(entry, callback, true, secondShouldLoad) == nullptr);
+    CHECK(firstShouldLoad);
+    CHECK(secondShouldLoad == false);
+
+    auto const asset = std::make_shared<Asset>(7);
+    auto const callbacks = cache.Store(entry, asset, 100);
+    CHECK(callbacks.size() == 2);
+    for (auto const & waitingCallback : callbacks)
+    {
+        waitingCallback(asset);
+    }
+    CHECK(received == std::vector<int> {7, 7});
+
+    bool shouldLoad = true;
+    CHECK(cache.Acquire(entry, callback, true, shouldLoad) == asset);
+    CHECK(shouldLoad == false);
+
+    // Without queueing nothing waits
+    auto & otherEntry = cache.GetEntry("b");
+    CHECK(cache.Acquire(otherEntry, callback, false, shouldLoad) == nullptr);
+    CHECK(shouldLoad == false);
+
+    auto const stats = cache.GetStats();
+    CHECK(stats.hitCount == 1);
+    CHECK(stats.missCount == 3);
+    CHECK(stats.residentCount == 1);
+    CHECK(stats.residentBytes == 100);
+    CHECK(budget.GetStats().residentBytes == 100);
+}
+
+//======================================================================
+
+TEST_CASE("ResourceCache TestCase2 Retention and LRU eviction", "[ResourceCache][1]")
+{
+    CacheBudget budget {300};
+    AssetCache cache {&budget};
+
+    std::vector<std::string> evicted {};
+    cache.RegisterEvictionListener([&evicted](std::string const & id)->void
+    {
+        evicted.emplace_back(id);
+    });
+
+    // Unused assets stay resident while they fit
+    (void)Load(cache, "a", 1, 100);
+    (void)Load(cache, "b", 2, 100);
+    auto const c = Load(cache, "c", 3, 100);
+    CHECK(Load(cache, "a", 0, 100)->value == 1);
+    CHECK(cache.GetStats().hitCount == 1);
+    CHECK(evicted.empty());
+
+    // Least recently used unused asset goes first, In-use assets are skipped
+    (void)Load(cache, "d", 4, 100);
+    CHECK(evicted == std::vector<std::string> {"b"});
+    CHECK(budget.GetStats().residentBytes == 300);
+
+    (void)Load(cache, "e", 5, 150);
+    CHECK(evicted == std::vector<std::string> {"b", "a", "d"});
+    CHECK(c->value == 3);
+
+    // Evicted asset is loaded again
+    CHECK(Load(cache, "b", 6, 10)->value == 6);
+    auto const stats = cache.GetStats();
+    CHECK(stats.evictionCount == 3);
+    CHECK(stats.residentCount == 3);
+    CHECK(stats.residentBytes == 260);
+
+    // Shrinking the budget evicts right away, Held assets remain
+    budget.SetBudgetBytes(0);
+    CHECK(cache.GetStats().residentCount == 1);
+    CHECK(budget.GetStats().residentBytes == 100);
+}
+
+//======================================================================
+
+TEST_CASE("ResourceCache TestCase3 Without budget", "[ResourceCache][2]")
+{
+    AssetCache cache {};
+    auto & entry = cache.GetEntry("a");
+    bool shouldLoad = false;
+    (void)cache.Acquire(entry, nullptr, true, shouldLoad);
+    REQUIRE(shouldLoad);
+
+    auto asset = std::make_shared<Asset>(1);
+    (void)cache.Store(entry, asset, 100);
+    CHECK(cache.Acquire(entry, nullptr, false, shouldLoad) == asset);
+
+    // Freed with its last user
+    asset.reset();
+    CHECK(cache.Acquire(entry, nullptr, false, shouldLoad) == nullptr);
+    CHECK(cache.GetStats().residentCount == 0);
+}
+
+//======================================================================
+
+TEST_CASE("ResourceCache TestCase4 Concurrent acquire", "[ResourceCache][3]")
+{
+    static constexpr int ThreadCount = 8;
+    static constexpr int IdCount = 64;
+    static constexpr int AcquireCount = 2000;
+
+    CacheBudget budget {IdCount * 10};
+    AssetCache cache {&budget};
+
+    std::atomic<int> loadCount = 0;
+    std::atomic<int> callbackCount = 0;
+    std::atomic<int> wrongValueCount = 0;          // Catch assertions are not thread safe
+
+    std::vector<std::thread> threads {};
+    for (int threadIndex = 0; threadIndex < ThreadCount; ++threadIndex)
+    {
+        threads.emplace_back([&, threadIndex]()->void
+        {
+            for (int i = 0; i < AcquireCount; ++i)
+            {
+                auto const idIndex = (i * 7 + threadIndex) % IdCount;
+                auto & entry = cache.GetEntry("asset" + std::to_string(idIndex));
+                bool shouldLoad = false;
+                auto const callback = [&callbackCount, &wrongValueCount, idIndex](std::shared_ptr<Asset> const & asset)->void
+                {
+                    wrongValueCount += asset->value != idIndex ? 1 : 0;
+                    ++callbackCount;
+                };
+                auto const asset = cache.Acquire(entry, callback, true, shouldLoad);
+                if (asset != nullptr)
+                {
+                    callback(asset);
+                    continue;
+                }
+                if (shouldLoad)
+                {
+                    ++loadCount;
+                    auto const loaded = std::make_shared<Asset>(idIndex);
+                    for (auto const & waitingCallback : cache.Store(entry, loaded, 10))
+                    {
+                        waitingCallback(loaded);
+                    }
+                }
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    // Everything fits, So each asset is loaded once and every acquire is answered
+    CHECK(loadCount == IdCount);
+    CHECK(wrongValueCount == 0);
+    CHECK(callbackCount == ThreadCount * AcquireCount);
+    auto const stats = cache.GetStats();
+    CHECK(stats.hitCount + stats.missCount == ThreadCount * AcquireCount);
+    CHECK(stats.evictionCount == 0);
+    CHECK(stats.residentCount == IdCount);
+}
+
+//======================================================================
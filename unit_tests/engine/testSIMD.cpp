@@ -7,12 +7,73 @@
 #include "engine/BedrockMatrix.hpp"
 
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 using namespace MFA;
 using namespace glm;
 
 //======================================================================
 
+namespace
+{
+    bool IsNear(mat4 const & a, mat4 const & b, float const margin = 1e-4f)
+    {
+        for (int column = 0; column < 4; ++column)
+        {
+            for (int row = 0; row < 4; ++row)
+            {
+                if (std::abs(a[column][row] - b[column][row]) > margin)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool IsNear(vec3 const & a, vec3 const & b, float const margin = 1e-4f)
+    {
+        return all(lessThanEqual(abs(a - b), vec3 {margin}));
+    }
+
+    // Same quaternion rotation, q and -q are equal
+    bool IsNear(quat const & a, quat const & b, float const margin = 1e-4f)
+    {
+        return std::abs(std::abs(dot(a, b)) - 1.0f) < margin;
+    }
+
+    quat RandomRotation(Math::RandomGenerator & generator)
+    {
+        vec4 const value {
+            generator.NextFloat(-1.0f, 1.0f),
+            generator.NextFloat(-1.0f, 1.0f),
+            generator.NextFloat(-1.0f, 1.0f),
+            generator.NextFloat(-1.0f, 1.0f)
+        };
+        auto const normalized = normalize(value);
+        return quat {normalized.w, normalized.x, normalized.y, normalized.z};
+    }
+
+    vec3 RandomVector(Math::RandomGenerator & generator, float const min, float const max)
+    {
+        return vec3 {generator.NextFloat(min, max), generator.NextFloat(min, max), generator.NextFloat(min, max)};
+    }
+
+    mat4 RandomTRS(Math::RandomGenerator & generator)
+    {
+        return translate(mat4 {1.0f}, RandomVector(generator, -10.0f, 10.0f))
+            * toMat4(RandomRotation(generator))
+            * scale(mat4 {1.0f}, RandomVector(generator, 0.5f, 2.0f));
+    }
+}
+
+//======================================================================
+
 TEST_CASE("SIMD TestCase1", "[SIMD][0]") {
     auto const a = vec4 {1.0, 2.0, 3.0, 4.0};
     auto const b = vec4 {1.0, 2.0, 3.0, 4.0};
@@ -43,6 +104,307 @@ TEST_CASE("SIMD TestCase3 Lerp", "[SIMD][2]")
     }
 }
 
-// TODO: Slerp
-// TODO: Matrix transform
-// TODO: Performance comparasion
+TEST_CASE("SIMD TestCase4 Multiply", "[SIMD][3]")
+{
+    Math::RandomGenerator generator {1};
+
+    std::vector<mat4> a {};
+    std::vector<mat4> b {};
+    for (int i = 0; i < 33; ++i)
+    {
+        a.emplace_back(RandomTRS(generator));
+        b.emplace_back(RandomTRS(generator));
+    }
+    // Not affine, Every element takes part
+    a[0][0][3] = 0.5f;
+    a[0][2][3] = -2.0f;
+    b[0][1][3] = 3.0f;
+
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        CHECK(IsNear(Matrix::Multiply(a[i], b[i]), a[i] * b[i]));
+    }
+
+    std::vector<mat4> result (a.size());
+    Matrix::Multiply(a.data(), b.data(), a.size(), result.data());
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        CHECK(IsNear(result[i], a[i] * b[i]));
+    }
+
+    Matrix::Multiply(a[0], b.data(), b.size(), result.data());
+    for (size_t i = 0; i < b.size(); ++i)
+    {
+        CHECK(IsNear(result[i], a[0] * b[i]));
+    }
+
+    // In place
+    auto inPlace = b;
+    Matrix::Multiply(a[0], inPlace.data(), inPlace.size(), inPlace.data());
+    CHECK(inPlace == result);
+}
+
+TEST_CASE("SIMD TestCase5 ComposeTRS", "[SIMD][4]")
+{
+    Math::RandomGenerator generator {2};
+
+    // Not a multiple of the batch width, So the remainder is covered as well
+    static constexpr size_t Count = 11;
+    std::vector<vec3> translations {};
+    std::vector<quat> rotations {};
+    std::vector<vec3> scales {};
+    for (size_t i = 0; i < Count; ++i)
+    {
+        translations.emplace_back(RandomVector(generator, -10.0f, 10.0f));
+        rotations.emplace_back(RandomRotation(generator));
+        scales.emplace_back(RandomVector(generator, -2.0f, 2.0f));
+    }
+
+    std::vector<mat4> result (Count);
+    Matrix::ComposeTRS(translations.data(), rotations.data(), scales.data(), Count, result.data());
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        auto const expected = translate(mat4 {1.0f}, translations[i]) * toMat4(rotations[i]) * scale(mat4 {1.0f}, scales[i]);
+        CHECK(IsNear(result[i], expected));
+        CHECK(IsNear(Matrix::ComposeTRS(translations[i], rotations[i], scales[i]), expected));
+    }
+}
+
+TEST_CASE("SIMD TestCase6 AffineInverse", "[SIMD][5]")
+{
+    Math::RandomGenerator generator {3};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto matrix = RandomTRS(generator);
+        // Shear is not a problem for the affine inverse
+        if (i % 2 == 0)
+        {
+            matrix[1][0] += 0.5f;
+            matrix[2][1] -= 0.25f;
+        }
+        auto const inverse = Matrix::AffineInverse(matrix);
+        CHECK(IsNear(inverse, glm::inverse(matrix)));
+        CHECK(IsNear(matrix * inverse, mat4 {1.0f}));
+        CHECK(inverse[0][3] == 0.0f);
+        CHECK(inverse[1][3] == 0.0f);
+        CHECK(inverse[2][3] == 0.0f);
+        CHECK(inverse[3][3] == 1.0f);
+    }
+}
+
+TEST_CASE("SIMD TestCase7 Slerp", "[SIMD][6]")
+{
+    Math::RandomGenerator generator {4};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto const from = RandomRotation(generator);
+        auto const to = RandomRotation(generator);
+        for (float fraction = 0.0f; fraction <= 1.0f; fraction += 0.125f)
+        {
+            auto const slerp = Matrix::Slerp(from, to, fraction);
+            auto const expected = glm::slerp(from, to, fraction);
+            CHECK(std::abs(slerp.x - expected.x) < 1e-4f);
+            CHECK(std::abs(slerp.y - expected.y) < 1e-4f);
+            CHECK(std::abs(slerp.z - expected.z) < 1e-4f);
+            CHECK(std::abs(slerp.w - expected.w) < 1e-4f);
+
+            auto const nlerp = Matrix::Nlerp(from, to, fraction);
+            CHECK(std::abs(length(nlerp) - 1.0f) < 1e-5f);
+        }
+
+        // Nlerp has the same end points and takes the same path at a different speed
+        CHECK(IsNear(Matrix::Nlerp(from, to, 0.0f), from));
+        CHECK(IsNear(Matrix::Nlerp(from, to, 1.0f), to));
+        CHECK(IsNear(Matrix::Nlerp(from, to, 0.5f), Matrix::Slerp(from, to, 0.5f)));
+    }
+
+    // Nearly equal rotations fall back to a linear blend
+    quat const from {1.0f, 0.0f, 0.0f, 0.0f};
+    CHECK(IsNear(Matrix::Slerp(from, from, 0.5f), from));
+    CHECK(IsNear(Matrix::Slerp(from, -from, 0.5f), from));
+}
+
+TEST_CASE("SIMD TestCase8 TransformAABB", "[SIMD][7]")
+{
+    Math::RandomGenerator generator {5};
+
+    static constexpr size_t Count = 64;
+    std::vector<vec3> mins {};
+    std::vector<vec3> maxs {};
+    for (size_t i = 0; i < Count; ++i)
+    {
+        auto const a = RandomVector(generator, -5.0f, 5.0f);
+        auto const b = RandomVector(generator, -5.0f, 5.0f);
+        mins.emplace_back(min(a, b));
+        maxs.emplace_back(max(a, b));
+    }
+
+    for (int i = 0; i < 10; ++i)
+    {
+        auto const matrix = RandomTRS(generator);
+        std::vector<vec3> outMins (Count);
+        std::vector<vec3> outMaxs (Count);
+        Matrix::TransformAABB(matrix, mins.data(), maxs.data(), Count, outMins.data(), outMaxs.data());
+
+        for (size_t j = 0; j < Count; ++j)
+        {
+            // Bounds of the eight transformed corners
+            vec3 expectedMin {std::numeric_limits<float>::max()};
+            vec3 expectedMax {std::numeric_limits<float>::lowest()};
+            for (int corner = 0; corner < 8; ++corner)
+            {
+                vec4 const point {
+                    (corner & 1) != 0 ? maxs[j].x : mins[j].x,
+                    (corner & 2) != 0 ? maxs[j].y : mins[j].y,
+                    (corner & 4) != 0 ? maxs[j].z : mins[j].z,
+                    1.0f
+                };
+                auto const transformed = vec3 {matrix * point};
+                expectedMin = min(expectedMin, transformed);
+                expectedMax = max(expectedMax, transformed);
+            }
+            CHECK(IsNear(outMins[j], expectedMin, 1e-3f));
+            CHECK(IsNear(outMaxs[j], expectedMax, 1e-3f));
+        }
+    }
+}
+
+TEST_CASE("SIMD TestCase9 Performance comparison", "[SIMD][8][!benchmark]")
+{
+    static constexpr size_t Count = 1024;
+
+    Math::RandomGenerator generator {6};
+    std::vector<vec3> translations {};
+    std::vector<quat> rotations {};
+    std::vector<quat> otherRotations {};
+    std::vector<vec3> scales {};
+    std::vector<mat4> matrices {};
+    std::vector<vec3> mins {};
+    std::vector<vec3> maxs {};
+    for (size_t i = 0; i < Count; ++i)
+    {
+        translations.emplace_back(RandomVector(generator, -10.0f, 10.0f));
+        rotations.emplace_back(RandomRotation(generator));
+        otherRotations.emplace_back(RandomRotation(generator));
+        scales.emplace_back(RandomVector(generator, 0.5f, 2.0f));
+        matrices.emplace_back(RandomTRS(generator));
+        mins.emplace_back(RandomVector(generator, -5.0f, 0.0f));
+        maxs.emplace_back(RandomVector(generator, 0.0f, 5.0f));
+    }
+    auto const parent = RandomTRS(generator);
+
+    std::vector<mat4> results (Count);
+    std::vector<quat> quatResults (Count);
+    std::vector<vec3> outMins (Count);
+    std::vector<vec3> outMaxs (Count);
+
+    BENCHMARK("glm multiply")
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            results[i] = parent * matrices[i];
+        }
+        return results[0];
+    };
+
+    BENCHMARK("Matrix::Multiply")
+    {
+        Matrix::Multiply(parent, matrices.data(), Count, results.data());
+        return results[0];
+    };
+
+    BENCHMARK("glm TRS")
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            auto transform = translate(mat4 {1.0f}, translations[i]);
+            transform = transform * toMat4(rotations[i]);
+            results[i] = scale(transform, scales[i]);
+        }
+        return results[0];
+    };
+
+    BENCHMARK("Matrix::ComposeTRS")
+    {
+        Matrix::ComposeTRS(translations.data(), rotations.data(), scales.data(), Count, results.data());
+        return results[0];
+    };
+
+    BENCHMARK("glm::inverse")
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            results[i] = glm::inverse(matrices[i]);
+        }
+        return results[0];
+    };
+
+    BENCHMARK("Matrix::AffineInverse")
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            results[i] = Matrix::AffineInverse(matrices[i]);
+        }
+        return results[0];
+    };
+
+    BENCHMARK("glm::slerp")
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            quatResults[i] = glm::slerp(rotations[i], otherRotations[i], 0.3f);
+        }
+        return quatResults[0];
+    };
+
+    BENCHMARK("Matrix::Slerp")
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            quatResults[i] = Matrix::Slerp(rotations[i], otherRotations[i], 0.3f);
+        }
+        return quatResults[0];
+    };
+
+    BENCHMARK("Matrix::Nlerp")
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            quatResults[i] = Matrix::Nlerp(rotations[i], otherRotations[i], 0.3f);
+        }
+        return quatResults[0];
+    };
+
+    BENCHMARK("glm AABB corners")
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            vec3 boxMin {std::numeric_limits<float>::max()};
+            vec3 boxMax {std::numeric_limits<float>::lowest()};
+            for (int corner = 0; corner < 8; ++corner)
+            {
+                vec4 const point {
+                    (corner & 1) != 0 ? maxs[i].x : mins[i].x,
+                    (corner & 2) != 0 ? maxs[i].y : mins[i].y,
+                    (corner & 4) != 0 ? maxs[i].z : mins[i].z,
+                    1.0f
+                };
+                auto const transformed = vec3 {parent * point};
+                boxMin = min(boxMin, transformed);
+                boxMax = max(boxMax, transformed);
+            }
+            outMins[i] = boxMin;
+            outMaxs[i] = boxMax;
+        }
+        return outMins[0];
+    };
+
+    BENCHMARK("Matrix::TransformAABB")
+    {
+        Matrix::TransformAABB(parent, mins.data(), maxs.data(), Count, outMins.data(), outMaxs.data());
+        return outMins[0];
+    };
+}
@@ -0,0 +1,408 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/BedrockSignal.hpp"
+#include "engine/job_system/JobSystem.hpp"
+#include "engine/job_system/ScopeLock.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    // Allocations of the current thread are counted only while it is enabled
+    thread_local bool gIsCountingAllocations = false;
+    thread_local uint64_t gAllocationCount = 0;
+
+    // Counts what goes through it, Memory of the rest of the program is not affected
+    template<typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        CountingAllocator() noexcept = default;
+
+        template<typename U>
+        CountingAllocator(CountingAllocator<U> const &) noexcept {}
+
+        [[nodiscard]]
+        T * allocate(size_t const count)
+        {
+            if (gIsCountingAllocations)
+            {
+                ++gAllocationCount;
+            }
+            return std::allocator<T>{}.allocate(count);
+        }
+
+        void deallocate(T * memory, size_t const count) noexcept
+        {
+            std::allocator<T>{}.deallocate(memory, count);
+        }
+
+        template<typename U>
+        bool operator == (CountingAllocator<U> const &) const noexcept
+        {
+            return true;
+        }
+
+        template<typename U>
+        bool operator != (CountingAllocator<U> const &) const noexcept
+        {
+            return false;
+        }
+    };
+
+    class AllocationCounter
+    {
+    public:
+
+        explicit AllocationCounter()
+        {
+            gAllocationCount = 0;
+            gIsCountingAllocations = true;
+        }
+
+        ~AllocationCounter()
+        {
+            gIsCountingAllocations = false;
+        }
+
+        [[nodiscard]]
+        uint64_t Count() const
+        {
+            return gAllocationCount;
+        }
+    };
+
+    struct Counter
+    {
+        void Add(int const value)
+        {
+            sum += value;
+        }
+
+        int sum = 0;
+    };
+
+    // Owns memory from the counting allocator, So every copy of the listener shows up in the count
+    struct CountedListener
+    {
+        void operator()(int const value) const
+        {
+            counter->Add(value);
+        }
+
+        Counter * counter = nullptr;
+        std::vector<int, CountingAllocator<int>> payload {1};
+    };
+
+    // Previous implementation, Every emit copied the listeners into a new vector under a spin lock
+    class LegacySignal
+    {
+    public:
+
+        void Register(std::function<void(int)> const & listener)
+        {
+            SCOPE_LOCK(mLock)
+            mListeners.emplace_back(listener);
+        }
+
+        void Emit(int const value)
+        {
+            std::vector<std::function<void(int)>, CountingAllocator<std::function<void(int)>>> listeners {};
+            {
+                SCOPE_LOCK(mLock)
+                for (auto & listener : mListeners)
+                {
+                    listeners.emplace_back(listener);
+                }
+            }
+            for (auto & listener : listeners)
+            {
+                listener(value);
+            }
+        }
+
+    private:
+
+        std::vector<std::function<void(int)>> mListeners {};
+        std::atomic<bool> mLock = false;
+    };
+}
+
+//======================================================================
+
+TEST_CASE("Signal TestCase1 Register and emit", "[Signal][0]")
+{
+    Signal<int> signal {};
+    CHECK(signal.IsEmpty());
+
+    Counter counter {};
+    std::vector<int> calls {};
+
+    auto const first = signal.Register([&calls](int const value)->void { calls.emplace_back(value); });
+    auto const second = signal.Register(&counter, &Counter::Add);
+    CHECK(first != second);
+    CHECK(signal.IsEmpty() == false);
+
+    signal.Emit(3);
+    CHECK(calls == std::vector<int> {3});
+    CHECK(counter.sum == 3);
+
+    CHECK(signal.UnRegister(first));
+    CHECK(signal.UnRegister(first) == false);
+    CHECK(signal.UnRegister(SignalIdInvalid) == false);
+
+    signal.Emit(4);
+    CHECK(calls == std::vector<int> {3});
+    CHECK(counter.sum == 7);
+
+    CHECK(signal.UnRegister(second));
+    CHECK(signal.IsEmpty());
+    signal.Emit(5);
+    CHECK(counter.sum == 7);
+
+    // Reference arguments reach the listener
+    Signal<int &> referenceSignal {};
+    referenceSignal.Register([](int & value)->void { value += 1; });
+    referenceSignal.Register([](int & value)->void { value *= 10; });
+    int value = 1;
+    referenceSignal.Emit(value);
+    CHECK(value == 20);
+}
+
+//======================================================================
+
+TEST_CASE("Signal TestCase2 Changes during emit", "[Signal][1]")
+{
+    Signal<> signal {};
+    int firstCount = 0;
+    int addedCount = 0;
+    SignalId selfId = SignalIdInvalid;
+    bool hasAdded = false;
+
+    // Listener removes itself and adds another one, The running emit keeps the old listeners
+    selfId = signal.Register([&]()->void
+    {
+        ++firstCount;
+        signal.UnRegister(selfId);
+        if (hasAdded == false)
+        {
+            hasAdded = true;
+            signal.Register([&addedCount]()->void { ++addedCount; });
+        }
+    });
+    int secondCount = 0;
+    signal.Register([&secondCount]()->void { ++secondCount; });
+
+    signal.Emit();
+    CHECK(firstCount == 1);
+    CHECK(secondCount == 1);
+    CHECK(addedCount == 0);
+
+    signal.Emit();
+    CHECK(firstCount == 1);
+    CHECK(secondCount == 2);
+    CHECK(addedCount == 1);
+}
+
+//======================================================================
+
+TEST_CASE("Signal TestCase3 Small function", "[Signal][2]")
+{
+    using Function = SmallFunction<int(int)>;
+
+    int offset = 5;
+    Function small {[offset](int const value)->int { return value + offset; }};
+    CHECK(small.IsInline());
+    CHECK(small(1) == 6);
+
+    struct Large
+    {
+        int values[32] {};
+        int operator()(int const index) const { return values[index]; }
+    };
+    Large large {};
+    large.values[7] = 42;
+    Function heap {large};
+    CHECK(heap.IsInline() == false);
+    CHECK(heap(7) == 42);
+
+    auto copy = heap;
+    auto moved = std::move(heap);
+    CHECK(heap == nullptr);
+    CHECK(copy(7) == 42);
+    CHECK(moved(7) == 42);
+
+    std::function<int(int)> const empty {};
+    Function fromEmpty {empty};
+    CHECK(fromEmpty == nullptr);
+
+    std::function<int(int)> const standard = [](int const value)->int { return value * 2; };
+    Function fromStandard {standard};
+    CHECK(fromStandard.IsInline());
+    CHECK(fromStandard(4) == 8);
+
+    // Same captures as the member function wrapper of Signal
+    Counter counter {};
+    auto const memberFunction = &Counter::Add;
+    Signal<int>::Listener const member {[obj = &counter, memberFunction](int const value)->void
+    {
+        (obj->*memberFunction)(value);
+    }};
+    CHECK(member.IsInline());
+
+    CHECK(Signal<int>::Listener::IsStoredInline<CountedListener>());
+    Signal<int>::Listener const counted {CountedListener {&counter}};
+    {
+        AllocationCounter const allocations {};
+        Signal<int>::Listener const copy {counted};
+        CHECK(allocations.Count() == 1);
+    }
+}
+
+//======================================================================
+
+TEST_CASE("Signal TestCase4 Emit does not allocate", "[Signal][3]")
+{
+    static constexpr int ListenerCount = 1000;
+
+    Signal<int> signal {};
+    std::vector<Counter> counters(ListenerCount);
+    for (auto & counter : counters)
+    {
+        signal.Register(CountedListener {&counter});
+    }
+
+    LegacySignal legacySignal {};
+    for (auto & counter : counters)
+    {
+        legacySignal.Register(CountedListener {&counter});
+    }
+
+    uint64_t emitAllocations = 0;
+    uint64_t multiThreadAllocations = 0;
+    uint64_t legacyAllocations = 0;
+    {
+        AllocationCounter const allocations {};
+        signal.Emit(1);
+        emitAllocations = allocations.Count();
+    }
+    {
+        AllocationCounter const allocations {};
+        signal.EmitMultiThread(1);
+        multiThreadAllocations = allocations.Count();
+    }
+    {
+        AllocationCounter const allocations {};
+        legacySignal.Emit(1);
+        legacyAllocations = allocations.Count();
+    }
+
+    CHECK(emitAllocations == 0);
+    // Job system is not running, ParallelFor runs on the calling thread
+    CHECK(multiThreadAllocations == 0);
+    // Copy of each payload and the growing vector of copies
+    CHECK(legacyAllocations > ListenerCount);
+
+    for (auto const & counter : counters)
+    {
+        CHECK(counter.sum == 3);
+    }
+}
+
+//======================================================================
+
+TEST_CASE("Signal TestCase5 Emit while other threads register", "[Signal][4]")
+{
+    Signal<int> signal {};
+    std::atomic<int> sum = 0;
+    signal.Register([&sum](int const value)->void { sum += value; });
+
+    std::atomic<bool> isDone = false;
+    std::vector<std::thread> writers {};
+    for (int i = 0; i < 2; ++i)
+    {
+        writers.emplace_back([&signal, &isDone]()->void
+        {
+            while (isDone == false)
+            {
+                auto const id = signal.Register([](int)->void {});
+                signal.UnRegister(id);
+            }
+        });
+    }
+
+    std::vector<std::thread> emitters {};
+    for (int i = 0; i < 2; ++i)
+    {
+        emitters.emplace_back([&signal]()->void
+        {
+            for (int j = 0; j < 20000; ++j)
+            {
+                signal.Emit(1);
+            }
+        });
+    }
+    for (auto & emitter : emitters)
+    {
+        emitter.join();
+    }
+    isDone = true;
+    for (auto & writer : writers)
+    {
+        writer.join();
+    }
+
+    // First listener is never removed, So it sees every emit
+    CHECK(sum == 40000);
+}
+
+//======================================================================
+
+TEST_CASE("Signal TestCase6 Emit latency", "[Signal][5][!benchmark]")
+{
+    static constexpr int ListenerCount = 10000;
+
+    JS::Init();
+
+    std::vector<Counter> counters(ListenerCount);
+
+    Signal<int> signal {};
+    LegacySignal legacySignal {};
+    for (auto & counter : counters)
+    {
+        signal.Register(&counter, &Counter::Add);
+        legacySignal.Register([&counter](int const value)->void { counter.Add(value); });
+    }
+
+    BENCHMARK("Legacy emit 10000 listeners")
+    {
+        legacySignal.Emit(1);
+    };
+
+    BENCHMARK("Emit 10000 listeners")
+    {
+        signal.Emit(1);
+    };
+
+    BENCHMARK("EmitMultiThread 10000 listeners")
+    {
+        signal.EmitMultiThread(1);
+    };
+
+    JS::Shutdown();
+}
+
+//======================================================================
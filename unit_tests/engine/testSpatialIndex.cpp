@@ -0,0 +1,325 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/BedrockMath.hpp"
+#include "engine/scene_manager/SpatialIndex.hpp"
+#include "engine/job_system/JobSystem.hpp"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    struct Volume
+    {
+        glm::vec3 center;
+        glm::vec3 extent;
+    };
+
+    Volume RandomVolume(Math::RandomGenerator & generator, float const worldSize)
+    {
+        return Volume {
+            .center = glm::vec3 {
+                generator.NextFloat(-worldSize, worldSize),
+                generator.NextFloat(-worldSize, worldSize),
+                generator.NextFloat(-worldSize, worldSize)
+            },
+            .extent = glm::vec3 {
+                generator.NextFloat(0.1f, 2.0f),
+                generator.NextFloat(0.1f, 2.0f),
+                generator.NextFloat(0.1f, 2.0f)
+            }
+        };
+    }
+
+    // Frustum of a camera at origin looking down -z with a 90 degree field of view, Rotated around y
+    SpatialIndex::Frustum MakeFrustum(float const yaw, float const nearDistance, float const farDistance)
+    {
+        auto const rotate = [yaw](glm::vec3 const & v)->glm::vec3
+        {
+            return glm::vec3 {
+                v.x * std::cos(yaw) + v.z * std::sin(yaw),
+                v.y,
+                -v.x * std::sin(yaw) + v.z * std::cos(yaw)
+            };
+        };
+        auto const forward = rotate(glm::vec3 {0.0f, 0.0f, -1.0f});
+        auto const invSqrt2 = 1.0f / std::sqrt(2.0f);
+        return SpatialIndex::Frustum {
+            SpatialIndex::Plane::FromPoint(forward, forward * nearDistance),
+            SpatialIndex::Plane::FromPoint(-forward, forward * farDistance),
+            SpatialIndex::Plane {.normal = rotate(glm::vec3 {invSqrt2, 0.0f, -invSqrt2}), .distance = 0.0f},
+            SpatialIndex::Plane {.normal = rotate(glm::vec3 {-invSqrt2, 0.0f, -invSqrt2}), .distance = 0.0f},
+            SpatialIndex::Plane {.normal = rotate(glm::vec3 {0.0f, invSqrt2, -invSqrt2}), .distance = 0.0f},
+            SpatialIndex::Plane {.normal = rotate(glm::vec3 {0.0f, -invSqrt2, -invSqrt2}), .distance = 0.0f}
+        };
+    }
+
+    enum class Expected
+    {
+        Inside,
+        Outside,
+        Border              // Too close to a plane to expect the same rounding from every code path
+    };
+
+    Expected ReferenceTest(SpatialIndex::Frustum const & frustum, Volume const & volume)
+    {
+        auto result = Expected::Inside;
+        for (auto const & plane : frustum)
+        {
+            auto const distance = glm::dot(plane.normal, volume.center) + plane.distance;
+            auto const radius = glm::dot(glm::abs(plane.normal), volume.extent);
+            auto const margin = distance + radius;
+            if (margin < -1e-3f)
+            {
+                return Expected::Outside;
+            }
+            if (margin < 1e-3f)
+            {
+                result = Expected::Border;
+            }
+        }
+        return result;
+    }
+
+    bool SphereOverlaps(Volume const & volume, glm::vec3 const & center, float const radius)
+    {
+        auto const closestPoint = glm::clamp(center, volume.center - volume.extent, volume.center + volume.extent);
+        auto const difference = center - closestPoint;
+        return glm::dot(difference, difference) <= radius * radius;
+    }
+}
+
+//======================================================================
+
+TEST_CASE("SpatialIndex TestCase1 Frustum culling", "[SpatialIndex][0]")
+{
+    JS::Init();
+
+    Math::RandomGenerator generator {1};
+    SpatialIndex spatialIndex {};
+
+    // More than a page so the parallel path and the page boundaries are covered
+    static constexpr int VolumeCount = 3000;
+    std::vector<Volume> volumes {};
+    std::vector<SpatialIndex::ProxyId> proxies {};
+    for (int i = 0; i < VolumeCount; ++i)
+    {
+        volumes.emplace_back(RandomVolume(generator, 100.0f));
+        proxies.emplace_back(spatialIndex.Add(volumes.back().center, volumes.back().extent));
+    }
+    REQUIRE(spatialIndex.GetProxyCount() == VolumeCount);
+
+    // New proxies are not visible before the first pass
+    CHECK(spatialIndex.IsVisible(proxies.front()) == false);
+    CHECK(spatialIndex.IsVisible(SpatialIndex::InvalidProxy) == false);
+
+    for (float const yaw : {0.0f, 1.0f, 2.5f, 4.0f})
+    {
+        auto const frustum = MakeFrustum(yaw, 0.5f, 80.0f);
+        spatialIndex.CullFrustum(frustum);
+
+        int insideCount = 0;
+        for (int i = 0; i < VolumeCount; ++i)
+        {
+            auto const expected = ReferenceTest(frustum, volumes[i]);
+            if (expected == Expected::Border)
+            {
+                continue;
+            }
+            CHECK(spatialIndex.IsVisible(proxies[i]) == (expected == Expected::Inside));
+            insideCount += expected == Expected::Inside ? 1 : 0;
+        }
+        // Frustum covers part of the world, Both results must show up
+        CHECK(insideCount > 0);
+        CHECK(insideCount < VolumeCount);
+    }
+
+    // Box that touches the near plane is visible, Every kernel computes the same exact distance for it
+    {
+        auto const touchingProxy = spatialIndex.Add(glm::vec3 {0.0f, 0.0f, 0.5f}, glm::vec3 {1.0f, 1.0f, 1.0f});
+        auto const missingProxy = spatialIndex.Add(glm::vec3 {0.0f, 0.0f, 0.5f + 1e-3f}, glm::vec3 {1.0f, 1.0f, 1.0f});
+        spatialIndex.CullFrustum(MakeFrustum(0.0f, 0.5f, 80.0f));
+        CHECK(spatialIndex.IsVisible(touchingProxy));
+        CHECK(spatialIndex.IsVisible(missingProxy) == false);
+        spatialIndex.Remove(touchingProxy);
+        spatialIndex.Remove(missingProxy);
+    }
+
+    // Culling only waits for its own pages, A job that is still running elsewhere does not block it
+    if (JS::GetNumberOfAvailableThreads() >= 2)
+    {
+        std::atomic<bool> isCullDone = false;
+        JS::AssignTask([&isCullDone](JS::ThreadNumber, JS::ThreadNumber)->void
+        {
+            while (isCullDone == false)
+            {
+                std::this_thread::yield();
+            }
+        });
+        spatialIndex.CullFrustum(MakeFrustum(0.0f, 0.5f, 80.0f));
+        isCullDone = true;
+        JS::WaitForThreadsToFinish();
+    }
+
+    JS::Shutdown();
+}
+
+//======================================================================
+
+TEST_CASE("SpatialIndex TestCase2 Remove and reuse", "[SpatialIndex][1]")
+{
+    SpatialIndex spatialIndex {};
+    auto const frustum = MakeFrustum(0.0f, 0.5f, 80.0f);
+    glm::vec3 const insidePoint {0.0f, 0.0f, -10.0f};
+    glm::vec3 const extent {1.0f};
+
+    auto const first = spatialIndex.Add(insidePoint, extent);
+    auto const second = spatialIndex.Add(insidePoint, extent);
+    spatialIndex.CullFrustum(frustum);
+    CHECK(spatialIndex.IsVisible(first));
+    CHECK(spatialIndex.IsVisible(second));
+
+    spatialIndex.Remove(first);
+    CHECK(spatialIndex.GetProxyCount() == 1);
+    CHECK(spatialIndex.IsVisible(first) == false);
+    spatialIndex.CullFrustum(frustum);
+    CHECK(spatialIndex.IsVisible(first) == false);
+
+    // Removed ids are reused, The new proxy starts invisible and static
+    auto const third = spatialIndex.Add(glm::vec3 {0.0f, 0.0f, 10.0f}, extent);
+    CHECK(third == first);
+    CHECK(spatialIndex.IsStatic(third));
+    spatialIndex.CullFrustum(frustum);
+    CHECK(spatialIndex.IsVisible(third) == false);
+    CHECK(spatialIndex.IsVisible(second));
+
+    CHECK(spatialIndex.GetStaticTree().GetLeafCount() == 2);
+    CHECK(spatialIndex.GetDynamicTree().GetLeafCount() == 0);
+}
+
+//======================================================================
+
+TEST_CASE("SpatialIndex TestCase3 Static and dynamic partitions", "[SpatialIndex][2]")
+{
+    SpatialIndex spatialIndex {};
+    glm::vec3 const extent {1.0f};
+
+    auto const proxy = spatialIndex.Add(glm::vec3 {0.0f, 0.0f, -10.0f}, extent);
+    CHECK(spatialIndex.IsStatic(proxy));
+
+    // Same bounds are not a move
+    spatialIndex.Move(proxy, glm::vec3 {0.0f, 0.0f, -10.0f}, extent);
+    spatialIndex.Refit();
+    CHECK(spatialIndex.IsStatic(proxy));
+
+    // First move takes the proxy to the dynamic tree
+    spatialIndex.Move(proxy, glm::vec3 {0.0f, 0.0f, 10.0f}, extent);
+    spatialIndex.Refit();
+    CHECK(spatialIndex.IsStatic(proxy) == false);
+    CHECK(spatialIndex.GetStaticTree().GetLeafCount() == 0);
+    CHECK(spatialIndex.GetDynamicTree().GetLeafCount() == 1);
+
+    // Frustum test reads the new bounds
+    spatialIndex.CullFrustum(MakeFrustum(0.0f, 0.5f, 80.0f));
+    CHECK(spatialIndex.IsVisible(proxy) == false);
+    spatialIndex.CullFrustum(MakeFrustum(Math::PiFloat, 0.5f, 80.0f));
+    CHECK(spatialIndex.IsVisible(proxy));
+
+    // Range query sees the moved proxy only at its new place
+    ProxyBitset inRange {};
+    spatialIndex.QuerySphere(glm::vec3 {0.0f, 0.0f, 10.0f}, 2.0f, inRange);
+    CHECK(SpatialIndex::TestBit(inRange, proxy));
+    spatialIndex.QuerySphere(glm::vec3 {0.0f, 0.0f, -10.0f}, 2.0f, inRange);
+    CHECK(SpatialIndex::TestBit(inRange, proxy) == false);
+
+    spatialIndex.Remove(proxy);
+    CHECK(spatialIndex.GetDynamicTree().GetLeafCount() == 0);
+}
+
+//======================================================================
+
+TEST_CASE("SpatialIndex TestCase4 Sphere query and tree balance", "[SpatialIndex][3]")
+{
+    Math::RandomGenerator generator {2};
+    SpatialIndex spatialIndex {};
+
+    // Sorted insertion is the worst case for a tree without rotations
+    static constexpr int VolumeCount = 2000;
+    std::vector<Volume> volumes {};
+    std::vector<SpatialIndex::ProxyId> proxies {};
+    for (int i = 0; i < VolumeCount; ++i)
+    {
+        volumes.emplace_back(Volume {
+            .center = glm::vec3 {static_cast<float>(i) * 3.0f, 0.0f, 0.0f},
+            .extent = glm::vec3 {1.0f}
+        });
+        proxies.emplace_back(spatialIndex.Add(volumes.back().center, volumes.back().extent));
+    }
+    auto const maxHeight = static_cast<int>(2.0f * std::log2(static_cast<float>(VolumeCount))) + 2;
+    CHECK(spatialIndex.GetStaticTree().GetHeight() <= maxHeight);
+
+    // Half of the volumes move randomly, They end up in the dynamic tree
+    for (int i = 0; i < VolumeCount; i += 2)
+    {
+        volumes[i] = RandomVolume(generator, 1000.0f);
+        spatialIndex.Move(proxies[i], volumes[i].center, volumes[i].extent);
+    }
+    spatialIndex.Refit();
+    CHECK(spatialIndex.GetStaticTree().GetLeafCount() == VolumeCount / 2);
+    CHECK(spatialIndex.GetDynamicTree().GetLeafCount() == VolumeCount / 2);
+    CHECK(spatialIndex.GetDynamicTree().GetHeight() <= maxHeight);
+
+    ProxyBitset inRange {};
+    for (int query = 0; query < 20; ++query)
+    {
+        glm::vec3 const center {
+            generator.NextFloat(0.0f, 6000.0f),
+            generator.NextFloat(-500.0f, 500.0f),
+            generator.NextFloat(-500.0f, 500.0f)
+        };
+        auto const radius = generator.NextFloat(10.0f, 400.0f);
+        spatialIndex.QuerySphere(center, radius, inRange);
+        for (int i = 0; i < VolumeCount; ++i)
+        {
+            CHECK(SpatialIndex::TestBit(inRange, proxies[i]) == SphereOverlaps(volumes[i], center, radius));
+        }
+    }
+}
+
+//======================================================================
+
+TEST_CASE("SpatialIndex TestCase5 Culling throughput", "[SpatialIndex][4][!benchmark]")
+{
+    JS::Init();
+
+    Math::RandomGenerator generator {3};
+    SpatialIndex spatialIndex {};
+    for (int i = 0; i < 100'000; ++i)
+    {
+        auto const volume = RandomVolume(generator, 500.0f);
+        (void)spatialIndex.Add(volume.center, volume.extent);
+    }
+    auto const frustum = MakeFrustum(0.3f, 0.5f, 300.0f);
+
+    BENCHMARK("Cull 100k volumes")
+    {
+        spatialIndex.CullFrustum(frustum);
+        return spatialIndex.IsVisible(0);
+    };
+
+    JS::Shutdown();
+}
+
+//======================================================================
@@ -0,0 +1,273 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/resource_manager/StreamingScheduler.hpp"
+#include "engine/job_system/ScopeLock.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace MFA;
+using namespace MFA::ResourceManager;
+
+//======================================================================
+
+namespace
+{
+    // Keeps dispatched work until the test runs it, So the order of the jobs is deterministic
+    struct ManualDispatcher
+    {
+        std::vector<StreamingScheduler::Work> works {};
+
+        StreamingScheduler::Dispatcher Get()
+        {
+            return [this](StreamingScheduler::Work const & work)->void
+            {
+                works.emplace_back(work);
+            };
+        }
+
+        void RunFirst()
+        {
+            REQUIRE(works.empty() == false);
+            auto const work = works.front();
+            works.erase(works.begin());
+            work();
+        }
+    };
+
+    StreamJob MakeJob(std::shared_ptr<StreamRequest> const & request, std::function<void()> run)
+    {
+        return StreamJob {
+            .getPriority = [request]()->float
+            {
+                return request->GetPriority();
+            },
+            .isCancelled = [request]()->bool
+            {
+                return request->IsCancelled();
+            },
+            .run = std::move(run)
+        };
+    }
+}
+
+//======================================================================
+
+TEST_CASE("StreamingScheduler TestCase1 Bounded concurrency and priority", "[StreamingScheduler][0]")
+{
+    ManualDispatcher dispatcher {};
+    StreamingScheduler scheduler {StreamingScheduler::Params {.maxIoJobs = 1, .maxDecodeJobs = 2}, dispatcher.Get()};
+
+    std::vector<int> order {};
+    std::vector<std::shared_ptr<StreamRequest>> requests {};
+    for (int i = 0; i < 4; ++i)
+    {
+        requests.emplace_back(std::make_shared<StreamRequest>(static_cast<float>(i)));
+        scheduler.Submit(StreamStage::Io, MakeJob(requests.back(), [&order, i]()->void
+        {
+            order.emplace_back(i);
+        }));
+    }
+
+    // First job takes the only io slot, The rest wait
+    CHECK(dispatcher.works.size() == 1);
+    auto stats = scheduler.GetStats();
+    CHECK(stats.runningCount[static_cast<int>(StreamStage::Io)] == 1);
+    CHECK(stats.pendingCount[static_cast<int>(StreamStage::Io)] == 3);
+
+    // Priority that changes after submission is respected
+    requests[1]->SetPriority(10.0f);
+
+    while (dispatcher.works.empty() == false)
+    {
+        dispatcher.RunFirst();
+        CHECK(dispatcher.works.size() <= 1);
+    }
+    CHECK(order == std::vector<int> {0, 1, 3, 2});
+    CHECK(scheduler.IsIdle());
+    CHECK(scheduler.GetStats().completedCount == 4);
+
+    // Decode stage has its own limit
+    for (int i = 0; i < 3; ++i)
+    {
+        scheduler.Submit(StreamStage::Decode, MakeJob(requests[i], []()->void {}));
+    }
+    CHECK(dispatcher.works.size() == 2);
+    while (dispatcher.works.empty() == false)
+    {
+        dispatcher.RunFirst();
+    }
+    CHECK(scheduler.IsIdle());
+}
+
+//======================================================================
+
+TEST_CASE("StreamingScheduler TestCase2 Cancellation", "[StreamingScheduler][1]")
+{
+    ManualDispatcher dispatcher {};
+    StreamingScheduler scheduler {StreamingScheduler::Params {.maxIoJobs = 1}, dispatcher.Get()};
+
+    int runCount = 0;
+    auto const blocking = std::make_shared<StreamRequest>();
+    auto const cancelled = std::make_shared<StreamRequest>(5.0f);
+    auto const kept = std::make_shared<StreamRequest>();
+
+    scheduler.Submit(StreamStage::Io, MakeJob(blocking, [&runCount]()->void { ++runCount; }));
+    scheduler.Submit(StreamStage::Io, MakeJob(cancelled, [&runCount]()->void { runCount += 100; }));
+    scheduler.Submit(StreamStage::Io, MakeJob(kept, [&runCount]()->void { ++runCount; }));
+
+    // Owner is destroyed while its job waits
+    cancelled->Cancel();
+    while (dispatcher.works.empty() == false)
+    {
+        dispatcher.RunFirst();
+    }
+
+    CHECK(runCount == 2);
+    auto const stats = scheduler.GetStats();
+    CHECK(stats.cancelledCount == 1);
+    CHECK(stats.completedCount == 2);
+    CHECK(scheduler.IsIdle());
+
+    // Cancelled upload never runs
+    auto const upload = std::make_shared<StreamRequest>();
+    scheduler.Submit(StreamStage::Upload, MakeJob(upload, [&runCount]()->void { runCount += 100; }));
+    upload->Cancel();
+    CHECK(scheduler.RunUploads() == 0);
+    CHECK(runCount == 2);
+}
+
+//======================================================================
+
+TEST_CASE("StreamingScheduler TestCase3 Upload budget", "[StreamingScheduler][2]")
+{
+    ManualDispatcher dispatcher {};
+    StreamingScheduler scheduler {StreamingScheduler::Params {.uploadBudgetMs = 5.0f}, dispatcher.Get()};
+
+    // Uploads only run on the thread that calls RunUploads
+    std::vector<int> order {};
+    for (int i = 0; i < 6; ++i)
+    {
+        scheduler.Submit(StreamStage::Upload, MakeJob(std::make_shared<StreamRequest>(static_cast<float>(i)), [&order, i]()->void
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            order.emplace_back(i);
+        }));
+    }
+    CHECK(dispatcher.works.empty());
+
+    // Budget fits a few jobs per call, Highest priority first
+    auto const firstCount = scheduler.RunUploads();
+    CHECK(firstCount >= 1);
+    CHECK(firstCount < 6);
+    CHECK(order.front() == 5);
+
+    uint32_t callCount = 1;
+    while (scheduler.IsIdle() == false)
+    {
+        CHECK(scheduler.RunUploads() >= 1);
+        ++callCount;
+    }
+    CHECK(callCount > 1);
+    CHECK(order == std::vector<int> {5, 4, 3, 2, 1, 0});
+
+    // Single job that is over the budget still runs
+    scheduler.SetUploadBudget(0.0f);
+    scheduler.Submit(StreamStage::Upload, MakeJob(std::make_shared<StreamRequest>(), [&order]()->void
+    {
+        order.emplace_back(6);
+    }));
+    scheduler.Submit(StreamStage::Upload, MakeJob(std::make_shared<StreamRequest>(), [&order]()->void
+    {
+        order.emplace_back(7);
+    }));
+    CHECK(scheduler.RunUploads() == 1);
+    CHECK(scheduler.RunUploads() == 1);
+    CHECK(order.size() == 8);
+}
+
+//======================================================================
+
+TEST_CASE("StreamingScheduler TestCase4 Jobs on worker threads", "[StreamingScheduler][3]")
+{
+    static constexpr int JobCount = 200;
+    static constexpr uint32_t MaxDecodeJobs = 3;
+
+    std::atomic<int> runningCount = 0;
+    std::atomic<int> maxRunningCount = 0;
+    std::atomic<int> decodedCount = 0;
+    std::atomic<int> uploadedCount = 0;
+
+    std::vector<std::thread> threads {};
+    std::atomic<bool> threadsLock = false;
+    {
+        StreamingScheduler scheduler {
+            StreamingScheduler::Params {.maxIoJobs = 2, .maxDecodeJobs = MaxDecodeJobs},
+            [&threads, &threadsLock](StreamingScheduler::Work const & work)->void
+            {
+                SCOPE_LOCK(threadsLock)
+                threads.emplace_back(work);
+            }
+        };
+
+        // Each io job submits its decode job and each decode job submits its upload, Same as the resource manager
+        for (int i = 0; i < JobCount; ++i)
+        {
+            auto const request = std::make_shared<StreamRequest>(static_cast<float>(i % 7));
+            scheduler.Submit(StreamStage::Io, MakeJob(request, [&, request]()->void
+            {
+                scheduler.Submit(StreamStage::Decode, MakeJob(request, [&, request]()->void
+                {
+                    auto const running = ++runningCount;
+                    auto previousMax = maxRunningCount.load();
+                    while (running > previousMax && maxRunningCount.compare_exchange_weak(previousMax, running) == false);
+                    std::this_thread::yield();
+                    --runningCount;
+                    ++decodedCount;
+
+                    scheduler.Submit(StreamStage::Upload, MakeJob(request, [&uploadedCount]()->void
+                    {
+                        ++uploadedCount;
+                    }));
+                }));
+            }));
+        }
+
+        while (uploadedCount < JobCount)
+        {
+            (void)scheduler.RunUploads();
+            std::this_thread::yield();
+        }
+
+        // Threads that finished their work may still be inside the scheduler
+        size_t joinedCount = 0;
+        while (true)
+        {
+            std::thread thread {};
+            {
+                SCOPE_LOCK(threadsLock)
+                if (joinedCount == threads.size())
+                {
+                    break;
+                }
+                thread = std::move(threads[joinedCount]);
+            }
+            thread.join();
+            ++joinedCount;
+        }
+        CHECK(scheduler.IsIdle());
+    }
+
+    CHECK(decodedCount == JobCount);
+    CHECK(uploadedCount == JobCount);
+    CHECK(maxRunningCount <= static_cast<int>(MaxDecodeJobs));
+}
+
+//======================================================================
@@ -0,0 +1,216 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/entity_system/Entity.hpp"
+#include "engine/entity_system/Component.hpp"
+#include "engine/entity_system/EntitySystem.hpp"
+#include "engine/entity_system/UpdateScheduler.hpp"
+#include "engine/job_system/JobSystem.hpp"
+
+#include <atomic>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    std::atomic<int> UpdateCounter = 0;
+
+    class TestMovementComponent final : public Component
+    {
+    public:
+
+        MFA_COMPONENT_PROPS(
+            TestMovementComponent,
+            EventTypes::UpdateEvent,
+            Component
+        )
+
+        explicit TestMovementComponent() = default;
+
+        void Update(float const deltaTimeInSec) override
+        {
+            position += deltaTimeInSec;
+            updateOrder = UpdateCounter++;
+        }
+
+        void Clone(Entity * entity) const override {}
+        void Serialize(nlohmann::json & jsonObject) const override {}
+        void Deserialize(nlohmann::json const & jsonObject) override {}
+
+        float position = 0.0f;
+        int updateOrder = -1;
+    };
+
+    class TestFollowComponent final : public Component
+    {
+    public:
+
+        MFA_COMPONENT_PROPS(
+            TestFollowComponent,
+            EventTypes::UpdateEvent,
+            Component
+        )
+
+        explicit TestFollowComponent() = default;
+
+        void Update(float const deltaTimeInSec) override
+        {
+            updateOrder = UpdateCounter++;
+            if (entityToDeactivate != nullptr)
+            {
+                entityToDeactivate->SetActive(false);
+            }
+        }
+
+        void GetUpdateDependencies(std::vector<ComponentTypeId> & outDependencies) const override
+        {
+            outDependencies.emplace_back(TestMovementComponent::GetTypeId());
+        }
+
+        void Clone(Entity * entity) const override {}
+        void Serialize(nlohmann::json & jsonObject) const override {}
+        void Deserialize(nlohmann::json const & jsonObject) override {}
+
+        int updateOrder = -1;
+        Entity * entityToDeactivate = nullptr;
+    };
+
+    std::unique_ptr<Entity> CreateEntity(EntityId const id)
+    {
+        return std::make_unique<Entity>(id, "Entity", nullptr, false);
+    }
+}
+
+//======================================================================
+
+TEST_CASE("UpdateScheduler TestCase1 Activation", "[UpdateScheduler][0]")
+{
+    auto const typeId = TestMovementComponent::GetTypeId();
+    auto entity = CreateEntity(0);
+    auto const movement = entity->AddComponent<TestMovementComponent>();
+
+    // Entity is not initialized yet
+    CHECK(UpdateScheduler::IsScheduled(movement.get()) == false);
+
+    EntitySystem::InitEntity(entity.get(), true);
+    CHECK(UpdateScheduler::IsScheduled(movement.get()));
+    CHECK(UpdateScheduler::GetUpdateListSize(typeId) == 1);
+
+    UpdateScheduler::Update(1.0f);
+    CHECK(movement->position == 1.0f);
+
+    entity->SetActive(false);
+    CHECK(UpdateScheduler::IsScheduled(movement.get()) == false);
+    UpdateScheduler::Update(1.0f);
+    CHECK(movement->position == 1.0f);
+
+    entity->SetActive(true);
+    movement->SetActive(false);
+    CHECK(UpdateScheduler::IsScheduled(movement.get()) == false);
+
+    movement->SetActive(true);
+    CHECK(UpdateScheduler::IsScheduled(movement.get()));
+
+    entity.reset();
+    CHECK(UpdateScheduler::GetUpdateListSize(typeId) == 0);
+}
+
+TEST_CASE("UpdateScheduler TestCase2 Dependencies", "[UpdateScheduler][1]")
+{
+    // Follow component is created first but it has to run after movement
+    auto followEntity = CreateEntity(0);
+    auto const follow = followEntity->AddComponent<TestFollowComponent>();
+    EntitySystem::InitEntity(followEntity.get(), true);
+
+    auto movementEntity = CreateEntity(1);
+    auto const movement = movementEntity->AddComponent<TestMovementComponent>();
+    EntitySystem::InitEntity(movementEntity.get(), true);
+
+    auto const executionOrder = UpdateScheduler::GetExecutionOrder();
+    auto const movementOrder = std::ranges::find(executionOrder, TestMovementComponent::GetTypeId());
+    auto const followOrder = std::ranges::find(executionOrder, TestFollowComponent::GetTypeId());
+    REQUIRE(movementOrder != executionOrder.end());
+    REQUIRE(followOrder != executionOrder.end());
+    CHECK(movementOrder < followOrder);
+
+    UpdateCounter = 0;
+    UpdateScheduler::Update(1.0f);
+    CHECK(movement->updateOrder < follow->updateOrder);
+}
+
+TEST_CASE("UpdateScheduler TestCase3 Change during update", "[UpdateScheduler][2]")
+{
+    auto const typeId = TestMovementComponent::GetTypeId();
+
+    std::vector<std::unique_ptr<Entity>> entities {};
+    for (EntityId i = 0; i < 4; ++i)
+    {
+        entities.emplace_back(CreateEntity(i));
+        entities.back()->AddComponent<TestMovementComponent>();
+        EntitySystem::InitEntity(entities.back().get(), true);
+    }
+    CHECK(UpdateScheduler::GetUpdateListSize(typeId) == 4);
+
+    auto followEntity = CreateEntity(4);
+    auto const follow = followEntity->AddComponent<TestFollowComponent>();
+    follow->entityToDeactivate = entities[1].get();
+    EntitySystem::InitEntity(followEntity.get(), true);
+
+    UpdateScheduler::Update(1.0f);
+    CHECK(UpdateScheduler::GetUpdateListSize(typeId) == 3);
+    CHECK(entities[1]->GetComponent<TestMovementComponent>()->position == 1.0f);
+
+    UpdateScheduler::Update(1.0f);
+    CHECK(entities[0]->GetComponent<TestMovementComponent>()->position == 2.0f);
+    CHECK(entities[1]->GetComponent<TestMovementComponent>()->position == 1.0f);
+    CHECK(entities[3]->GetComponent<TestMovementComponent>()->position == 2.0f);
+
+    follow->entityToDeactivate = nullptr;
+    entities[1]->SetActive(true);
+    CHECK(UpdateScheduler::GetUpdateListSize(typeId) == 4);
+}
+
+TEST_CASE("UpdateScheduler TestCase4 Update performance", "[UpdateScheduler][3][!benchmark]")
+{
+    static constexpr int EntityCount = 10000;
+
+    JS::Init();
+
+    std::vector<std::unique_ptr<Entity>> entities {};
+    for (EntityId i = 0; i < EntityCount; ++i)
+    {
+        entities.emplace_back(CreateEntity(i));
+        entities.back()->AddComponent<TestMovementComponent>();
+        EntitySystem::InitEntity(entities.back().get(), true);
+    }
+
+    // Previous implementation, Each entity was a listener of a global signal
+    Signal<float> updateSignal {};
+    for (auto const & entity : entities)
+    {
+        auto * component = entity->GetComponent<TestMovementComponent>().get();
+        updateSignal.Register([component](float const deltaTimeInSec)->void
+        {
+            component->Update(deltaTimeInSec);
+        });
+    }
+
+    BENCHMARK("Update with signal")
+    {
+        updateSignal.EmitMultiThread(1.0f);
+    };
+
+    BENCHMARK("Update with scheduler")
+    {
+        UpdateScheduler::Update(1.0f);
+    };
+
+    entities.clear();
+    JS::Shutdown();
+}
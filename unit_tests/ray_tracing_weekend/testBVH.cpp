@@ -0,0 +1,176 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "bvh/BVH.hpp"
+#include "camera/Camera.hpp"
+#include "engine/BedrockMath.hpp"
+#include "geometry/HitRecord.hpp"
+#include "geometry/sphere/Sphere.hpp"
+#include "material/diffuse/Diffuse.hpp"
+#include "random/PCG32.hpp"
+#include "renderer/TileRenderer.hpp"
+#include "scene/Scene.hpp"
+
+#include "glm/glm.hpp"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+    std::vector<std::shared_ptr<Geometry>> CreateRandomSpheres(int const count)
+    {
+        auto const material = std::make_shared<Diffuse>(glm::vec3 {0.5f, 0.5f, 0.5f});
+        std::vector<std::shared_ptr<Geometry>> spheres {};
+        for (int i = 0; i < count; ++i)
+        {
+            spheres.emplace_back(std::make_shared<Sphere>(
+                glm::vec3 {Math::Random(-10.0f, 10.0f), Math::Random(-10.0f, 10.0f), Math::Random(-10.0f, 10.0f)},
+                Math::Random(0.05f, 1.0f),
+                material
+            ));
+        }
+        return spheres;
+    }
+
+    Ray CreateRandomRay(PCG32 & random)
+    {
+        auto const x = random.NextFloat(-15.0f, 15.0f);
+        auto const y = random.NextFloat(-15.0f, 15.0f);
+        auto const z = random.NextFloat(-15.0f, 15.0f);
+        return Ray {glm::vec3 {x, y, z}, Material::RandomUnitVector(random)};
+    }
+
+    // Fixed resolution, sample count and camera, So only the scene size changes between runs
+    glm::vec3 Render(Scene const & scene)
+    {
+        static constexpr int Width = 64;
+        static constexpr int Height = 36;
+
+        Camera const camera {
+            glm::vec3 {13.0f, 2.0f, 3.0f},
+            glm::vec3 {0.0f, 0.0f, 0.0f},
+            Math::UpVec3,
+            20.0f,
+            static_cast<float>(Width) / static_cast<float>(Height),
+            0.1f,
+            10.0f
+        };
+
+        TileRenderer renderer {Width, Height, 4, 8};
+        renderer.Render(scene, camera, 1);
+        return renderer.GetColor(Width / 2, Height / 2);
+    }
+}
+
+//======================================================================
+
+TEST_CASE("BVH TestCase1 Structure", "[BVH][0]")
+{
+    Math::SetRandomSeed(1);
+    auto const spheres = CreateRandomSpheres(1000);
+
+    BVH bvh {};
+    bvh.Build(spheres);
+
+    auto const & nodes = bvh.GetNodes();
+    REQUIRE(nodes.empty() == false);
+    CHECK(bvh.GetGeometries().size() == spheres.size());
+
+    // Every geometry belongs to exactly one leaf and every child is enclosed by its parent
+    std::vector<int> references (spheres.size(), 0);
+    for (uint32_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+    {
+        auto const & node = nodes[nodeIndex];
+        if (node.geometryCount > 0)
+        {
+            for (uint32_t i = node.rightOrFirst; i < node.rightOrFirst + node.geometryCount; ++i)
+            {
+                ++references[i];
+                auto const bounds = bvh.GetGeometries()[i]->GetAABB();
+                CHECK(glm::all(glm::greaterThanEqual(bounds.min, node.bounds.min)));
+                CHECK(glm::all(glm::lessThanEqual(bounds.max, node.bounds.max)));
+            }
+            continue;
+        }
+        for (auto const childIndex : {nodeIndex + 1, node.rightOrFirst})
+        {
+            REQUIRE(childIndex < nodes.size());
+            auto const & child = nodes[childIndex];
+            CHECK(glm::all(glm::greaterThanEqual(child.bounds.min, node.bounds.min)));
+            CHECK(glm::all(glm::lessThanEqual(child.bounds.max, node.bounds.max)));
+        }
+    }
+    CHECK(std::ranges::all_of(references, [](int const count)->bool { return count == 1; }));
+}
+
+TEST_CASE("BVH TestCase2 Matches linear search", "[BVH][1]")
+{
+    Math::SetRandomSeed(2);
+    auto const spheres = CreateRandomSpheres(1000);
+
+    BVH bvh {};
+    bvh.Build(spheres);
+
+    PCG32 random {2};
+    int hitCount = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        auto const ray = CreateRandomRay(random);
+
+        HitRecord expected {};
+        expected.t = Infinity;
+        bool expectedHit = false;
+        for (auto const & sphere : spheres)
+        {
+            if (sphere->HasIntersect(ray, 0.001f, expected.t, expected))
+            {
+                expectedHit = true;
+            }
+        }
+
+        HitRecord actual {};
+        actual.t = Infinity;
+        bool const actualHit = bvh.HasIntersect(ray, 0.001f, Infinity, actual);
+
+        REQUIRE(actualHit == expectedHit);
+        if (expectedHit)
+        {
+            ++hitCount;
+            CHECK(actual.t == Approx(expected.t).epsilon(1e-3));
+        }
+    }
+    CHECK(hitCount > 0);
+}
+
+TEST_CASE("BVH TestCase3 Scene size scaling", "[BVH][2][!benchmark]")
+{
+    for (auto const sphereCount : {500, 10000, 100000})
+    {
+        Math::SetRandomSeed(3);
+        auto const scene = Scene::CreateFinalScene(sphereCount);
+        auto const countText = std::to_string(sphereCount);
+
+        BENCHMARK("Build " + countText + " spheres")
+        {
+            BVH bvh {};
+            bvh.Build(scene->GetBVH().GetGeometries());
+            return bvh.GetNodes().size();
+        };
+
+        BENCHMARK("Render " + countText + " spheres")
+        {
+            return Render(*scene);
+        };
+    }
+}
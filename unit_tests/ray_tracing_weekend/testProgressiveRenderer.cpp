@@ -0,0 +1,161 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "camera/Camera.hpp"
+#include "engine/BedrockMath.hpp"
+#include "engine/job_system/JobSystem.hpp"
+#include "renderer/ProgressiveRenderer.hpp"
+#include "scene/Scene.hpp"
+
+#include <filesystem>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    constexpr int Width = 48;
+    constexpr int Height = 27;
+    constexpr int MaxDepth = 8;
+
+    Camera CreateCamera()
+    {
+        return Camera {
+            glm::vec3 {13.0f, 2.0f, 3.0f},
+            glm::vec3 {0.0f, 0.0f, 0.0f},
+            Math::UpVec3,
+            20.0f,
+            static_cast<float>(Width) / static_cast<float>(Height),
+            0.1f,
+            10.0f
+        };
+    }
+
+    ProgressiveRenderer::Budget CreateBudget()
+    {
+        ProgressiveRenderer::Budget budget {};
+        budget.minSamplesPerPixel = 8;
+        budget.maxSamplesPerPixel = 64;
+        budget.samplesPerPass = 4;
+        budget.maxRelativeError = 0.05f;
+        return budget;
+    }
+
+    bool HasSameImage(ProgressiveRenderer const & a, ProgressiveRenderer const & b)
+    {
+        for (int y = 0; y < Height; ++y)
+        {
+            for (int x = 0; x < Width; ++x)
+            {
+                if (a.GetSampleCount(x, y) != b.GetSampleCount(x, y) || a.GetColor(x, y) != b.GetColor(x, y))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+//======================================================================
+
+TEST_CASE("ProgressiveRenderer TestCase1 Adaptive sampling", "[ProgressiveRenderer][0]")
+{
+    Math::SetRandomSeed(1);
+    auto const scene = Scene::CreateFinalScene(100);
+    auto const camera = CreateCamera();
+    auto const budget = CreateBudget();
+
+    ProgressiveRenderer renderer {Width, Height, MaxDepth};
+    renderer.Render(*scene, camera, budget, 1);
+
+    CHECK(renderer.GetConvergedPixelCount() == Width * Height);
+
+    uint32_t minSampleCount = budget.maxSamplesPerPixel;
+    uint32_t maxSampleCount = 0;
+    for (int y = 0; y < Height; ++y)
+    {
+        for (int x = 0; x < Width; ++x)
+        {
+            auto const sampleCount = renderer.GetSampleCount(x, y);
+            minSampleCount = std::min(minSampleCount, sampleCount);
+            maxSampleCount = std::max(maxSampleCount, sampleCount);
+        }
+    }
+    // Smooth sky converges at the minimum, Noisy pixels take more samples
+    CHECK(minSampleCount == static_cast<uint32_t>(budget.minSamplesPerPixel));
+    CHECK(maxSampleCount > minSampleCount);
+    CHECK(maxSampleCount <= static_cast<uint32_t>(budget.maxSamplesPerPixel));
+    CHECK(renderer.GetTotalSampleCount() < static_cast<uint64_t>(Width * Height * budget.maxSamplesPerPixel));
+}
+
+TEST_CASE("ProgressiveRenderer TestCase2 Time budget", "[ProgressiveRenderer][1]")
+{
+    Math::SetRandomSeed(1);
+    auto const scene = Scene::CreateFinalScene(100);
+    auto const camera = CreateCamera();
+
+    auto budget = CreateBudget();
+    budget.maxTimeInSec = 1e-9;
+
+    ProgressiveRenderer renderer {Width, Height, MaxDepth};
+    renderer.Render(*scene, camera, budget, 1);
+
+    CHECK(renderer.GetPassCount() == 1);
+    CHECK(renderer.GetSampleCount(0, 0) == static_cast<uint32_t>(budget.samplesPerPass));
+    CHECK(renderer.GetConvergedPixelCount() == 0);
+}
+
+TEST_CASE("ProgressiveRenderer TestCase3 Resume from checkpoint", "[ProgressiveRenderer][2]")
+{
+    JS::Init();
+
+    Math::SetRandomSeed(1);
+    auto const scene = Scene::CreateFinalScene(100);
+    auto const camera = CreateCamera();
+    auto const budget = CreateBudget();
+
+    auto const checkpointPath = (std::filesystem::temp_directory_path() / "mfa_progressive_renderer_test").string();
+
+    ProgressiveRenderer uninterrupted {Width, Height, MaxDepth};
+    uninterrupted.Render(*scene, camera, budget, 1);
+
+    // Stops after the first pass
+    {
+        auto shortBudget = budget;
+        shortBudget.maxTimeInSec = 1e-9;
+
+        ProgressiveRenderer interrupted {Width, Height, MaxDepth};
+        interrupted.SetCheckpointPath(checkpointPath);
+        interrupted.Render(*scene, camera, shortBudget, 1);
+        REQUIRE(interrupted.WriteCheckpoint());
+    }
+    CHECK(std::filesystem::exists(checkpointPath + ".png"));
+    CHECK(std::filesystem::exists(checkpointPath + ".hdr"));
+
+    ProgressiveRenderer resumed {Width, Height, MaxDepth};
+    resumed.SetCheckpointPath(checkpointPath);
+    REQUIRE(resumed.LoadCheckpoint());
+    CHECK(resumed.GetPassCount() == 1);
+    // Thread count does not change the result either
+    resumed.Render(*scene, camera, budget);
+
+    CHECK(resumed.GetPassCount() == uninterrupted.GetPassCount());
+    CHECK(HasSameImage(resumed, uninterrupted));
+
+    // Checkpoint of a different size is rejected
+    ProgressiveRenderer otherSize {Width * 2, Height, MaxDepth};
+    otherSize.SetCheckpointPath(checkpointPath);
+    CHECK(otherSize.LoadCheckpoint() == false);
+
+    for (auto const * extension : {".png", ".hdr", ".checkpoint"})
+    {
+        std::filesystem::remove(checkpointPath + extension);
+    }
+
+    JS::Shutdown();
+}
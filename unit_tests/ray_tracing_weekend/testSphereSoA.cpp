@@ -0,0 +1,176 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "geometry/HitRecord.hpp"
+#include "geometry/sphere/Sphere.hpp"
+#include "geometry/sphere/SphereSoA.hpp"
+#include "material/diffuse/Diffuse.hpp"
+#include "random/PCG32.hpp"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+//======================================================================
+
+namespace
+{
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+    constexpr float TMin = 0.001f;
+
+    struct TestScene
+    {
+        std::vector<std::shared_ptr<Sphere>> spheres {};
+        SphereSoA sphereSoA {};
+        std::vector<Ray> rays {};
+    };
+
+    TestScene CreateTestScene(int const sphereCount, int const rayCount)
+    {
+        TestScene scene {};
+        PCG32 random {42};
+        auto const material = std::make_shared<Diffuse>(glm::vec3 {0.5f, 0.5f, 0.5f});
+        for (int i = 0; i < sphereCount; ++i)
+        {
+            auto const x = random.NextFloat(-10.0f, 10.0f);
+            auto const y = random.NextFloat(-10.0f, 10.0f);
+            auto const z = random.NextFloat(-10.0f, 10.0f);
+            auto const radius = random.NextFloat(0.05f, 1.0f);
+            scene.spheres.emplace_back(std::make_shared<Sphere>(glm::vec3 {x, y, z}, radius, material));
+            scene.sphereSoA.Add(glm::vec3 {x, y, z}, radius, static_cast<uint32_t>(i));
+        }
+        for (int i = 0; i < rayCount; ++i)
+        {
+            auto const x = random.NextFloat(-15.0f, 15.0f);
+            auto const y = random.NextFloat(-15.0f, 15.0f);
+            auto const z = random.NextFloat(-15.0f, 15.0f);
+            scene.rays.emplace_back(glm::vec3 {x, y, z}, Material::RandomUnitVector(random));
+        }
+        return scene;
+    }
+}
+
+//======================================================================
+
+TEST_CASE("SphereSoA TestCase1 Matches scalar path", "[SphereSoA][0]")
+{
+    // Not a multiple of SIMD width, So the last batch is partial
+    auto scene = CreateTestScene(1003, 2000);
+    scene.sphereSoA.AddEmpty(1003);
+    auto const count = static_cast<uint32_t>(scene.sphereSoA.GetCount());
+    REQUIRE(count == 1004);
+
+    int hitCount = 0;
+    for (auto const & ray : scene.rays)
+    {
+        // Virtual calls on Sphere objects
+        HitRecord expected {};
+        expected.t = Infinity;
+        int expectedIndex = -1;
+        for (int i = 0; i < static_cast<int>(scene.spheres.size()); ++i)
+        {
+            if (scene.spheres[i]->HasIntersect(ray, TMin, expected.t, expected))
+            {
+                expectedIndex = i;
+            }
+        }
+
+        float scalarT = Infinity;
+        uint32_t scalarIndex = SphereSoA::InvalidIndex;
+        bool const scalarHit = scene.sphereSoA.HasIntersectScalar(
+            0, count, ray.GetOrigin(), ray.GetDirection(), TMin, scalarT, scalarIndex
+        );
+
+        float simdT = Infinity;
+        uint32_t simdIndex = SphereSoA::InvalidIndex;
+        bool const simdHit = scene.sphereSoA.HasIntersect(
+            0, count, ray.GetOrigin(), ray.GetDirection(), TMin, simdT, simdIndex
+        );
+
+        REQUIRE(scalarHit == (expectedIndex >= 0));
+        REQUIRE(simdHit == scalarHit);
+        if (scalarHit)
+        {
+            ++hitCount;
+            CHECK(scalarIndex == static_cast<uint32_t>(expectedIndex));
+            CHECK(simdIndex == scalarIndex);
+            CHECK(scalarT == Approx(expected.t).epsilon(1e-3));
+            // Kernels do the same operations in the same order as the scalar path
+            CHECK(simdT == scalarT);
+            CHECK(scene.sphereSoA.GetId(simdIndex) == simdIndex);
+        }
+    }
+    CHECK(hitCount > 0);
+
+    // Sub ranges and a closer tMax
+    for (auto const & ray : scene.rays)
+    {
+        float scalarT = 5.0f;
+        uint32_t scalarIndex = SphereSoA::InvalidIndex;
+        bool const scalarHit = scene.sphereSoA.HasIntersectScalar(
+            3, 13, ray.GetOrigin(), ray.GetDirection(), TMin, scalarT, scalarIndex
+        );
+        float simdT = 5.0f;
+        uint32_t simdIndex = SphereSoA::InvalidIndex;
+        bool const simdHit = scene.sphereSoA.HasIntersect(
+            3, 13, ray.GetOrigin(), ray.GetDirection(), TMin, simdT, simdIndex
+        );
+        REQUIRE(simdHit == scalarHit);
+        CHECK(simdIndex == scalarIndex);
+    }
+}
+
+TEST_CASE("SphereSoA TestCase2 Throughput", "[SphereSoA][1][!benchmark]")
+{
+    static constexpr int SphereCount = 1024;
+    static constexpr int RayCount = 256;
+
+    auto scene = CreateTestScene(SphereCount, RayCount);
+    auto const count = static_cast<uint32_t>(scene.sphereSoA.GetCount());
+
+    WARN("SIMD width: " << SphereSoA::Width);
+
+    BENCHMARK("Virtual Sphere::HasIntersect")
+    {
+        int hitCount = 0;
+        for (auto const & ray : scene.rays)
+        {
+            HitRecord hitRecord {};
+            hitRecord.t = Infinity;
+            bool hasHit = false;
+            for (auto const & sphere : scene.spheres)
+            {
+                hasHit |= sphere->HasIntersect(ray, TMin, hitRecord.t, hitRecord);
+            }
+            hitCount += hasHit ? 1 : 0;
+        }
+        return hitCount;
+    };
+
+    BENCHMARK("SphereSoA scalar")
+    {
+        int hitCount = 0;
+        for (auto const & ray : scene.rays)
+        {
+            float t = Infinity;
+            uint32_t index = SphereSoA::InvalidIndex;
+            hitCount += scene.sphereSoA.HasIntersectScalar(0, count, ray.GetOrigin(), ray.GetDirection(), TMin, t, index) ? 1 : 0;
+        }
+        return hitCount;
+    };
+
+    BENCHMARK("SphereSoA SIMD")
+    {
+        int hitCount = 0;
+        for (auto const & ray : scene.rays)
+        {
+            float t = Infinity;
+            uint32_t index = SphereSoA::InvalidIndex;
+            hitCount += scene.sphereSoA.HasIntersect(0, count, ray.GetOrigin(), ray.GetDirection(), TMin, t, index) ? 1 : 0;
+        }
+        return hitCount;
+    };
+}
@@ -0,0 +1,130 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "camera/Camera.hpp"
+#include "engine/BedrockMath.hpp"
+#include "engine/job_system/JobSystem.hpp"
+#include "random/PCG32.hpp"
+#include "renderer/TileRenderer.hpp"
+#include "scene/Scene.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    Camera CreateCamera(int const width, int const height)
+    {
+        return Camera {
+            glm::vec3 {13.0f, 2.0f, 3.0f},
+            glm::vec3 {0.0f, 0.0f, 0.0f},
+            Math::UpVec3,
+            20.0f,
+            static_cast<float>(width) / static_cast<float>(height),
+            0.1f,
+            10.0f
+        };
+    }
+}
+
+//======================================================================
+
+TEST_CASE("TileRenderer TestCase1 Random sequence", "[TileRenderer][0]")
+{
+    PCG32 a {10u, 3u};
+    PCG32 b {10u, 3u};
+    PCG32 c {11u, 3u};
+
+    int differentCount = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto const value = a.NextFloat();
+        CHECK(value == b.NextFloat());
+        CHECK(value >= 0.0f);
+        CHECK(value < 1.0f);
+        if (value != c.NextFloat())
+        {
+            ++differentCount;
+        }
+    }
+    CHECK(differentCount > 990);
+}
+
+TEST_CASE("TileRenderer TestCase2 Same image with any thread count", "[TileRenderer][1]")
+{
+    // Not a multiple of tile size on purpose
+    static constexpr int Width = 50;
+    static constexpr int Height = 30;
+
+    JS::Init();
+
+    Math::SetRandomSeed(1);
+    auto const scene = Scene::CreateFinalScene(100);
+    auto const camera = CreateCamera(Width, Height);
+
+    TileRenderer singleThread {Width, Height, 4, 8};
+    singleThread.Render(*scene, camera, 1);
+
+    TileRenderer twoThreads {Width, Height, 4, 8};
+    twoThreads.Render(*scene, camera, 2);
+
+    TileRenderer allThreads {Width, Height, 4, 8};
+    allThreads.Render(*scene, camera);
+
+    auto const & expected = singleThread.GetColors();
+    REQUIRE(expected.size() == Width * Height);
+    CHECK(std::memcmp(expected.data(), twoThreads.GetColors().data(), expected.size() * sizeof(glm::vec3)) == 0);
+    CHECK(std::memcmp(expected.data(), allThreads.GetColors().data(), expected.size() * sizeof(glm::vec3)) == 0);
+    CHECK(singleThread.GetRayCount() == allThreads.GetRayCount());
+    CHECK(singleThread.GetRayCount() >= static_cast<uint64_t>(Width * Height * 4));
+
+    // Every pixel is written, Sky and ground are never black
+    for (auto const & color : expected)
+    {
+        CHECK(color.r + color.g + color.b > 0.0f);
+    }
+
+    JS::Shutdown();
+}
+
+TEST_CASE("TileRenderer TestCase3 Rays per second", "[TileRenderer][2][!benchmark]")
+{
+    static constexpr int Width = 200;
+    static constexpr int Height = 112;
+
+    JS::Init();
+
+    Math::SetRandomSeed(1);
+    auto const scene = Scene::CreateFinalScene(484);
+    auto const camera = CreateCamera(Width, Height);
+
+    std::vector<uint32_t> threadCounts {1};
+    if (JS::GetNumberOfAvailableThreads() > 1)
+    {
+        threadCounts.emplace_back(JS::GetNumberOfAvailableThreads());
+    }
+
+    for (auto const threadCount : threadCounts)
+    {
+        TileRenderer renderer {Width, Height, 8, 50};
+        BENCHMARK("Render with " + std::to_string(threadCount) + " threads")
+        {
+            renderer.Render(*scene, camera, threadCount);
+            return renderer.GetRayCount();
+        };
+        WARN(
+            std::to_string(threadCount) + " threads: "
+            + std::to_string(renderer.GetRaysPerSecond() / 1000000.0) + " million rays per second"
+        );
+    }
+
+    JS::Shutdown();
+}
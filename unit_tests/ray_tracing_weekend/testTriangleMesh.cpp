@@ -0,0 +1,379 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "camera/Camera.hpp"
+#include "engine/BedrockMath.hpp"
+#include "engine/BedrockMemory.hpp"
+#include "engine/asset_system/Asset_PBR_Mesh.hpp"
+#include "geometry/HitRecord.hpp"
+#include "geometry/mesh/MeshInstance.hpp"
+#include "geometry/mesh/TriangleMesh.hpp"
+#include "material/Material.hpp"
+#include "random/PCG32.hpp"
+#include "renderer/TileRenderer.hpp"
+#include "scene/Scene.hpp"
+
+#include "glm/glm.hpp"
+#include "glm/ext/matrix_transform.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+    float GridHeight(float const x, float const z, float const bumpiness)
+    {
+        return bumpiness * std::sin(3.0f * x) * std::cos(3.0f * z);
+    }
+
+    // Height field between -1 and 1 on XZ plane. Rows are split between primitives like the importer does,
+    // Indices are global so they include the starting vertex of their primitive.
+    std::shared_ptr<AS::PBR::Mesh> CreateGridMesh(
+        int const quadCount,
+        int const primitiveCount,
+        float const bumpiness,
+        std::vector<glm::vec3> & outTriangles
+    )
+    {
+        auto const rowCount = quadCount / primitiveCount;
+        auto const vertexCount = static_cast<uint32_t>(primitiveCount * (rowCount + 1) * (quadCount + 1));
+        auto const indexCount = static_cast<uint32_t>(primitiveCount * rowCount * quadCount * 6);
+
+        auto mesh = std::make_shared<AS::PBR::Mesh>();
+        mesh->initForWrite(
+            vertexCount,
+            indexCount,
+            Memory::Alloc(vertexCount * sizeof(AS::PBR::Vertex)),
+            Memory::Alloc(indexCount * sizeof(AS::Index))
+        );
+        auto const subMeshIndex = mesh->insertSubMesh();
+
+        auto const step = 2.0f / static_cast<float>(quadCount);
+        uint32_t startingVertex = 0;
+        for (int p = 0; p < primitiveCount; ++p)
+        {
+            std::vector<AS::PBR::Vertex> vertices {};
+            std::vector<glm::vec3> positions {};
+            for (int r = 0; r <= rowCount; ++r)
+            {
+                for (int c = 0; c <= quadCount; ++c)
+                {
+                    auto const x = -1.0f + static_cast<float>(c) * step;
+                    auto const z = -1.0f + static_cast<float>(p * rowCount + r) * step;
+                    glm::vec3 const position {x, GridHeight(x, z, bumpiness), z};
+
+                    AS::PBR::Vertex vertex {};
+                    Copy<3>(vertex.position, position);
+                    vertex.normalValue[1] = 1.0f;
+                    vertices.emplace_back(vertex);
+                    positions.emplace_back(position);
+                }
+            }
+
+            std::vector<AS::Index> indices {};
+            for (int r = 0; r < rowCount; ++r)
+            {
+                for (int c = 0; c < quadCount; ++c)
+                {
+                    auto const i0 = static_cast<uint32_t>(r * (quadCount + 1) + c);
+                    auto const i1 = i0 + 1;
+                    auto const i2 = i0 + quadCount + 1;
+                    auto const i3 = i2 + 1;
+                    for (auto const index : {i0, i2, i1, i1, i2, i3})
+                    {
+                        indices.emplace_back(startingVertex + index);
+                        outTriangles.emplace_back(positions[index]);
+                    }
+                }
+            }
+
+            AS::PBR::Primitive primitive {};
+            primitive.hasNormalBuffer = true;
+            Copy<4>(primitive.baseColorFactor, {0.8f, 0.8f, 0.8f, 1.0f});
+            mesh->insertPrimitive(
+                subMeshIndex,
+                primitive,
+                static_cast<uint32_t>(vertices.size()),
+                vertices.data(),
+                static_cast<uint32_t>(indices.size()),
+                indices.data()
+            );
+            startingVertex += static_cast<uint32_t>(vertices.size());
+        }
+
+        auto & node = mesh->InsertNode();
+        node.subMeshIndex = static_cast<int>(subMeshIndex);
+        mesh->finalizeData();
+
+        return mesh;
+    }
+
+    TriangleMesh::WatertightRay CreateRandomRay(PCG32 & random)
+    {
+        glm::vec3 const origin {random.NextFloat(-1.5f, 1.5f), random.NextFloat(0.5f, 2.0f), random.NextFloat(-1.5f, 1.5f)};
+        glm::vec3 const target {random.NextFloat(-1.0f, 1.0f), 0.0f, random.NextFloat(-1.0f, 1.0f)};
+        return TriangleMesh::WatertightRay {origin, target - origin};
+    }
+}
+
+//======================================================================
+
+TEST_CASE("TriangleMesh TestCase1 Watertight", "[TriangleMesh][0]")
+{
+    // Two triangles that share the diagonal of a unit quad and a fan of triangles around a shared vertex
+    glm::vec3 const q0 {0.0f, 0.0f, 0.0f};
+    glm::vec3 const q1 {1.0f, 0.0f, 0.0f};
+    glm::vec3 const q2 {1.0f, 1.0f, 0.0f};
+    glm::vec3 const q3 {0.0f, 1.0f, 0.0f};
+
+    static constexpr int FanCount = 7;
+    std::vector<glm::vec3> fan {};
+    for (int i = 0; i < FanCount; ++i)
+    {
+        auto const angle = 2.0f * Math::PiFloat * static_cast<float>(i) / static_cast<float>(FanCount);
+        fan.emplace_back(std::cos(angle), std::sin(angle), 0.0f);
+    }
+
+    PCG32 random {1};
+    int edgeMissCount = 0;
+    int vertexMissCount = 0;
+    for (int i = 0; i < 100000; ++i)
+    {
+        auto const direction = glm::vec3 {
+            random.NextFloat(-1.0f, 1.0f),
+            random.NextFloat(-1.0f, 1.0f),
+            random.NextFloat(0.1f, 1.0f)
+        };
+
+        // Point on the shared diagonal
+        auto const s = random.NextFloat();
+        TriangleMesh::WatertightRay const edgeRay {glm::vec3 {s, s, 0.0f} - direction, direction};
+        TriangleMesh::Hit hit {};
+        bool const hasEdgeHit = TriangleMesh::IntersectTriangle(edgeRay, q0, q1, q2, 0.0f, Infinity, hit)
+            || TriangleMesh::IntersectTriangle(edgeRay, q0, q2, q3, 0.0f, Infinity, hit);
+        if (hasEdgeHit == false)
+        {
+            ++edgeMissCount;
+        }
+
+        TriangleMesh::WatertightRay const vertexRay {-direction, direction};
+        bool hasVertexHit = false;
+        for (int j = 0; j < FanCount; ++j)
+        {
+            hasVertexHit |= TriangleMesh::IntersectTriangle(
+                vertexRay,
+                glm::vec3 {},
+                fan[j],
+                fan[(j + 1) % FanCount],
+                0.0f,
+                Infinity,
+                hit
+            );
+        }
+        if (hasVertexHit == false)
+        {
+            ++vertexMissCount;
+        }
+    }
+    CHECK(edgeMissCount == 0);
+    CHECK(vertexMissCount == 0);
+
+    // Ray that misses the triangle and one that is parallel to it
+    TriangleMesh::Hit hit {};
+    CHECK(TriangleMesh::IntersectTriangle(
+        TriangleMesh::WatertightRay {glm::vec3 {2.0f, 2.0f, -1.0f}, glm::vec3 {0.0f, 0.0f, 1.0f}},
+        q0, q1, q2, 0.0f, Infinity, hit
+    ) == false);
+    CHECK(TriangleMesh::IntersectTriangle(
+        TriangleMesh::WatertightRay {glm::vec3 {-1.0f, 0.5f, 0.0f}, glm::vec3 {1.0f, 0.0f, 0.0f}},
+        q0, q1, q2, 0.0f, Infinity, hit
+    ) == false);
+
+    // Barycentric weights belong to the second and third vertex
+    REQUIRE(TriangleMesh::IntersectTriangle(
+        TriangleMesh::WatertightRay {glm::vec3 {0.75f, 0.25f, -2.0f}, glm::vec3 {0.0f, 0.0f, 1.0f}},
+        q0, q1, q2, 0.0f, Infinity, hit
+    ));
+    CHECK(hit.t == Approx(2.0f));
+    CHECK(hit.u == Approx(0.5f));
+    CHECK(hit.v == Approx(0.25f));
+}
+
+TEST_CASE("TriangleMesh TestCase2 Matches linear search", "[TriangleMesh][1]")
+{
+    std::vector<glm::vec3> triangles {};
+    auto const mesh = CreateGridMesh(32, 4, 0.2f, triangles);
+    TriangleMesh const triangleMesh {mesh, 0};
+
+    REQUIRE(triangleMesh.GetTriangleCount() == triangles.size() / 3);
+    CHECK(triangleMesh.GetNodes().size() > 1);
+
+    PCG32 random {2};
+    int hitCount = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        auto const ray = CreateRandomRay(random);
+
+        TriangleMesh::Hit expected {};
+        expected.t = Infinity;
+        bool expectedHit = false;
+        for (size_t j = 0; j < triangles.size(); j += 3)
+        {
+            if (TriangleMesh::IntersectTriangle(ray, triangles[j], triangles[j + 1], triangles[j + 2], 0.001f, expected.t, expected))
+            {
+                expectedHit = true;
+            }
+        }
+
+        TriangleMesh::Hit actual {};
+        bool const actualHit = triangleMesh.HasIntersect(ray, 0.001f, Infinity, actual);
+
+        REQUIRE(actualHit == expectedHit);
+        if (expectedHit)
+        {
+            ++hitCount;
+            CHECK(actual.t == expected.t);
+        }
+    }
+    CHECK(hitCount > 0);
+}
+
+TEST_CASE("TriangleMesh TestCase3 Instances", "[TriangleMesh][2]")
+{
+    std::vector<glm::vec3> triangles {};
+    auto const mesh = CreateGridMesh(8, 2, 0.0f, triangles);
+
+    // Flat grid scaled by 2 and moved up by 1
+    auto const transform = glm::scale(
+        glm::translate(glm::identity<glm::mat4>(), glm::vec3 {0.0f, 1.0f, 0.0f}),
+        glm::vec3 {2.0f}
+    );
+    auto const instances = MeshInstance::CreateInstances(mesh, transform);
+    REQUIRE(instances.size() == 1);
+
+    auto const bounds = instances[0]->GetAABB();
+    CHECK(bounds.min.x == Approx(-2.0f));
+    CHECK(bounds.max.z == Approx(2.0f));
+    CHECK(bounds.min.y == Approx(1.0f));
+
+    Scene scene {};
+    scene.AddGeometry(instances[0]);
+    // Second instance shares the same triangles
+    auto const & instance = static_cast<MeshInstance const &>(*instances[0]);
+    scene.AddGeometry(std::make_shared<MeshInstance>(
+        instance.mesh,
+        glm::translate(glm::identity<glm::mat4>(), glm::vec3 {10.0f, 0.0f, 0.0f})
+    ));
+    scene.Build();
+
+    HitRecord hitRecord {};
+    REQUIRE(scene.HasIntersect(Ray {glm::vec3 {1.5f, 5.0f, -1.5f}, glm::vec3 {0.0f, -1.0f, 0.0f}}, 0.001f, Infinity, hitRecord));
+    CHECK(hitRecord.t == Approx(4.0f));
+    CHECK(hitRecord.position.y == Approx(1.0f));
+    CHECK(hitRecord.normal.y == Approx(1.0f));
+    CHECK(hitRecord.hitFrontFace);
+    CHECK(hitRecord.material != nullptr);
+
+    // From below the normal faces the ray
+    REQUIRE(scene.HasIntersect(Ray {glm::vec3 {10.5f, -3.0f, 0.5f}, glm::vec3 {0.0f, 1.0f, 0.0f}}, 0.001f, Infinity, hitRecord));
+    CHECK(hitRecord.t == Approx(3.0f));
+    CHECK(hitRecord.normal.y == Approx(-1.0f));
+    CHECK(hitRecord.hitFrontFace == false);
+
+    // Outside of the scaled grid
+    CHECK(scene.HasIntersect(Ray {glm::vec3 {2.5f, 5.0f, 0.0f}, glm::vec3 {0.0f, -1.0f, 0.0f}}, 0.001f, Infinity, hitRecord) == false);
+}
+
+TEST_CASE("TriangleMesh TestCase4 Triangle throughput", "[TriangleMesh][3][!benchmark]")
+{
+    static constexpr int RayCount = 100000;
+
+    for (int const quadCount : {64, 256, 512})
+    {
+        std::vector<glm::vec3> triangles {};
+        auto const mesh = CreateGridMesh(quadCount, 4, 0.2f, triangles);
+        auto const triangleCount = triangles.size() / 3;
+
+        auto const buildStart = std::chrono::steady_clock::now();
+        TriangleMesh const triangleMesh {mesh, 0};
+        std::chrono::duration<double> const buildTime = std::chrono::steady_clock::now() - buildStart;
+
+        PCG32 random {3};
+        std::vector<TriangleMesh::WatertightRay> rays {};
+        rays.reserve(RayCount);
+        for (int i = 0; i < RayCount; ++i)
+        {
+            rays.emplace_back(CreateRandomRay(random));
+        }
+
+        auto const traceStart = std::chrono::steady_clock::now();
+        int hitCount = 0;
+        for (auto const & ray : rays)
+        {
+            TriangleMesh::Hit hit {};
+            if (triangleMesh.HasIntersect(ray, 0.001f, Infinity, hit))
+            {
+                ++hitCount;
+            }
+        }
+        std::chrono::duration<double> const traceTime = std::chrono::steady_clock::now() - traceStart;
+        CHECK(hitCount > 0);
+
+        WARN(
+            std::to_string(triangleCount) + " triangles: Built in "
+            + std::to_string(buildTime.count() * 1000.0) + " ms ("
+            + std::to_string(static_cast<double>(triangleCount) / buildTime.count() / 1000000.0) + " million triangles per second), "
+            + std::to_string(static_cast<double>(RayCount) / traceTime.count() / 1000000.0) + " million rays per second"
+        );
+
+        BENCHMARK("Trace " + std::to_string(RayCount) + " rays against " + std::to_string(triangleCount) + " triangles")
+        {
+            int count = 0;
+            for (auto const & ray : rays)
+            {
+                TriangleMesh::Hit hit {};
+                count += triangleMesh.HasIntersect(ray, 0.001f, Infinity, hit) ? 1 : 0;
+            }
+            return count;
+        };
+    }
+
+    // Full path tracing of the mesh instance, Includes scattering and the sky
+    std::vector<glm::vec3> triangles {};
+    auto const mesh = CreateGridMesh(256, 4, 0.2f, triangles);
+    Scene scene {};
+    for (auto const & instance : MeshInstance::CreateInstances(mesh, glm::identity<glm::mat4>()))
+    {
+        scene.AddGeometry(instance);
+    }
+    scene.Build();
+
+    Camera const camera {
+        glm::vec3 {0.0f, 2.0f, 3.0f},
+        glm::vec3 {0.0f, 0.0f, 0.0f},
+        Math::UpVec3,
+        40.0f,
+        16.0f / 9.0f,
+        0.0f,
+        3.0f
+    };
+    TileRenderer renderer {128, 72, 4, 8};
+    BENCHMARK("Path trace 131072 triangles")
+    {
+        renderer.Render(scene, camera, 1);
+        return renderer.GetRayCount();
+    };
+    WARN(std::to_string(renderer.GetRaysPerSecond() / 1000000.0) + " million path traced rays per second");
+}
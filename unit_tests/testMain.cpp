@@ -7,6 +7,10 @@
 #define CATCH_CONFIG_RUNNER
 #include "catch.hpp"
 
+// Ray tracer checkpoints are written with stb
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "libs/stb_image/stb_image_write.h"
+
 #include "rlutil.h"
 
 //======================================================================
@@ -0,0 +1,353 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/entity_system/Component.hpp"
+#include "engine/entity_system/Entity.hpp"
+#include "engine/entity_system/EntitySystem.hpp"
+#include "tools/BinaryScene.hpp"
+
+#include "libs/nlohmann/json.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    // Same shape of data as the transform component
+    class SceneTestTransformComponent final : public Component
+    {
+    public:
+
+        MFA_COMPONENT_PROPS(
+            SceneTestTransformComponent,
+            EventTypes::EmptyEvent,
+            Component
+        )
+
+        explicit SceneTestTransformComponent() = default;
+
+        void Clone(Entity * entity) const override {}
+
+        void Serialize(nlohmann::json & jsonObject) const override
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                auto & vector = jsonObject[Keys[i]];
+                vector["x"] = values[i * 3 + 0];
+                vector["y"] = values[i * 3 + 1];
+                vector["z"] = values[i * 3 + 2];
+            }
+        }
+
+        void Deserialize(nlohmann::json const & jsonObject) override
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                auto const & vector = jsonObject[Keys[i]];
+                values[i * 3 + 0] = vector["x"].get<float>();
+                values[i * 3 + 1] = vector["y"].get<float>();
+                values[i * 3 + 2] = vector["z"].get<float>();
+            }
+        }
+
+        static constexpr char const * Keys[3] {"position", "rotation", "scale"};
+        float values[9] {};
+    };
+
+    class SceneTestMeshComponent final : public Component
+    {
+    public:
+
+        MFA_COMPONENT_PROPS(
+            SceneTestMeshComponent,
+            EventTypes::EmptyEvent,
+            Component
+        )
+
+        explicit SceneTestMeshComponent() = default;
+
+        void Clone(Entity * entity) const override {}
+
+        void Serialize(nlohmann::json & jsonObject) const override
+        {
+            jsonObject["address"] = address;
+            jsonObject["lod"] = lod;
+            jsonObject["offset"] = offset;
+            jsonObject["isVisible"] = isVisible;
+            jsonObject["weight"] = weight;
+            jsonObject["tags"] = tags;
+        }
+
+        void Deserialize(nlohmann::json const & jsonObject) override
+        {
+            address = jsonObject.value("address", "");
+            lod = jsonObject.value("lod", 0u);
+            offset = jsonObject.value("offset", 0);
+            isVisible = jsonObject.value("isVisible", true);
+            weight = jsonObject.value("weight", 0.0);
+            tags = jsonObject.value("tags", std::vector<std::string> {});
+        }
+
+        std::string address {};
+        uint32_t lod = 0;
+        int offset = 0;
+        bool isVisible = true;
+        double weight = 0.0;
+        std::vector<std::string> tags {};
+    };
+
+    void AddComponents(Entity * entity, int const index)
+    {
+        auto transform = entity->AddComponent<SceneTestTransformComponent>();
+        for (int i = 0; i < 9; ++i)
+        {
+            transform->values[i] = static_cast<float>(index) * 0.5f + static_cast<float>(i);
+        }
+
+        // Every third entity has no mesh
+        if (index % 3 != 0)
+        {
+            auto mesh = entity->AddComponent<SceneTestMeshComponent>();
+            mesh->address = "models/mesh" + std::to_string(index % 4) + ".glb";
+            mesh->lod = static_cast<uint32_t>(index % 3);
+            mesh->offset = -index;
+            mesh->isVisible = index % 2 == 0;
+            mesh->weight = 0.1 * index;
+            mesh->tags = {"static", index % 2 == 0 ? "even" : "odd"};
+        }
+    }
+
+    // Root with childCount children, Each child has grandChildCount children
+    Entity * CreateScene(int const childCount, int const grandChildCount)
+    {
+        auto * root = EntitySystem::CreateEntity("Root");
+        AddComponents(root, 0);
+        EntitySystem::InitEntity(root);
+
+        int index = 1;
+        for (int i = 0; i < childCount; ++i)
+        {
+            auto * child = EntitySystem::CreateEntity("Child", root);
+            AddComponents(child, index++);
+            EntitySystem::InitEntity(child);
+            for (int j = 0; j < grandChildCount; ++j)
+            {
+                auto * grandChild = EntitySystem::CreateEntity("GrandChild", child);
+                AddComponents(grandChild, index++);
+                EntitySystem::InitEntity(grandChild);
+            }
+        }
+        return root;
+    }
+
+    nlohmann::json SerializeToJson(Entity * root)
+    {
+        nlohmann::json json {};
+        root->Serialize(json);
+        return json;
+    }
+}
+
+//======================================================================
+
+TEST_CASE("BinaryScene TestCase1 Round trip", "[BinaryScene][0]")
+{
+    EntitySystem::Init();
+
+    auto * root = CreateScene(4, 3);
+    root->GetChildEntities()[1]->SetActive(false);
+    // Entities that are not serializable are skipped by both formats
+    auto * editorOnly = EntitySystem::CreateEntity("EditorOnly", root, EntitySystem::CreateEntityParams {.serializable = false});
+    EntitySystem::InitEntity(editorOnly);
+
+    auto const json = SerializeToJson(root);
+    auto const data = BinaryScene::Encode(root);
+
+    // Json and binary are interchangeable
+    CHECK(BinaryScene::EncodeJson(json) == data);
+    nlohmann::json decodedJson {};
+    REQUIRE(BinaryScene::DecodeToJson(data, decodedJson));
+    CHECK(decodedJson == json);
+
+    // Strings are stored once, So the binary is much smaller than the text
+    CHECK(data.size() * 2 < json.dump().size());
+
+    auto * loadedRoot = EntitySystem::CreateEntity("Loaded");
+    REQUIRE(BinaryScene::Load(data, loadedRoot, true));
+    CHECK(SerializeToJson(loadedRoot) == json);
+    CHECK(loadedRoot->GetChildEntities().size() == 4);
+    CHECK(loadedRoot->GetChildEntities()[1]->IsActive() == false);
+    CHECK(loadedRoot->GetChildEntities()[1]->GetChildEntities()[0]->IsActive() == false);
+    CHECK(loadedRoot->GetChildEntities()[2]->GetChildEntities()[0]->IsActive());
+
+    auto mesh = loadedRoot->GetChildEntities()[0]->GetComponent<SceneTestMeshComponent>();
+    REQUIRE(mesh != nullptr);
+    CHECK(mesh->address == "models/mesh1.glb");
+    CHECK(mesh->offset == -1);
+    CHECK(mesh->weight == 0.1);
+    CHECK(mesh->tags == std::vector<std::string> {"static", "odd"});
+
+    EntitySystem::Shutdown();
+}
+
+//======================================================================
+
+TEST_CASE("BinaryScene TestCase2 Incremental load", "[BinaryScene][1]")
+{
+    EntitySystem::Init();
+
+    auto * source = CreateScene(10, 4);
+    auto const json = SerializeToJson(source);
+    auto const data = BinaryScene::Encode(source);
+    auto const entityCount = EntitySystem::GetEntityCount();
+
+    // Zero budget loads one entity per update
+    auto * root = EntitySystem::CreateEntity("Loaded");
+    {
+        BinaryScene::SceneLoader loader {data, root, BinaryScene::SceneLoader::Params {.budgetMs = 0.0f}};
+        REQUIRE(loader.IsValid());
+        CHECK(loader.GetEntityCount() == entityCount);
+
+        uint32_t updateCount = 0;
+        while (loader.Update() == false)
+        {
+            ++updateCount;
+            CHECK(loader.GetLoadedCount() == updateCount);
+        }
+        CHECK(updateCount + 1 == entityCount);
+        CHECK(loader.IsDone());
+        CHECK(loader.Update());
+    }
+    CHECK(SerializeToJson(root) == json);
+
+    // Large budget loads the scene at once
+    auto * fastRoot = EntitySystem::CreateEntity("Loaded");
+    {
+        BinaryScene::SceneLoader loader {data, fastRoot, BinaryScene::SceneLoader::Params {.budgetMs = 1000.0f}};
+        CHECK(loader.Update());
+    }
+    CHECK(SerializeToJson(fastRoot) == json);
+
+    // Entities under a destroyed parent are skipped and a destroyed root stops the load
+    auto * partialRoot = EntitySystem::CreateEntity("Loaded");
+    {
+        BinaryScene::SceneLoader loader {data, partialRoot, BinaryScene::SceneLoader::Params {.budgetMs = 0.0f}};
+        for (int i = 0; i < 3; ++i)
+        {
+            CHECK(loader.Update() == false);
+        }
+        REQUIRE(partialRoot->GetChildEntities().size() == 1);
+        EntitySystem::DestroyEntity(partialRoot->GetChildEntities()[0]);
+        auto const countBefore = EntitySystem::GetEntityCount();
+        for (int i = 0; i < 3; ++i)
+        {
+            CHECK(loader.Update() == false);
+        }
+        CHECK(EntitySystem::GetEntityCount() == countBefore);
+
+        EntitySystem::DestroyEntity(partialRoot);
+        CHECK(loader.Update());
+        CHECK(loader.GetLoadedCount() == loader.GetEntityCount());
+    }
+
+    EntitySystem::Shutdown();
+}
+
+//======================================================================
+
+TEST_CASE("BinaryScene TestCase3 Version and corrupt data", "[BinaryScene][2]")
+{
+    EntitySystem::Init();
+
+    auto * source = CreateScene(2, 2);
+    auto const data = BinaryScene::Encode(source);
+    nlohmann::json json {};
+    CHECK(BinaryScene::DecodeToJson(data, json));
+
+    // Header is magic then version
+    auto newerVersion = data;
+    newerVersion[4] = static_cast<uint8_t>(BinaryScene::Version + 1);
+    CHECK(BinaryScene::DecodeToJson(newerVersion, json) == false);
+    auto * root = EntitySystem::CreateEntity("Loaded");
+    {
+        BinaryScene::SceneLoader loader {newerVersion, root, {}};
+        CHECK(loader.IsValid() == false);
+        CHECK(loader.Update());
+    }
+    CHECK(root->GetChildEntities().empty());
+
+    auto wrongMagic = data;
+    wrongMagic[0] ^= 0xFF;
+    CHECK(BinaryScene::DecodeToJson(wrongMagic, json) == false);
+
+    for (size_t size = 0; size < data.size(); ++size)
+    {
+        std::vector<uint8_t> const truncated (data.begin(), data.begin() + static_cast<ptrdiff_t>(size));
+        CHECK(BinaryScene::DecodeToJson(truncated, json) == false);
+    }
+
+    // Corrupt bytes may still form a valid scene but must not read out of the data
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        auto corrupt = data;
+        corrupt[i] ^= 0xA5;
+        (void)BinaryScene::DecodeToJson(corrupt, json);
+    }
+
+    EntitySystem::Shutdown();
+}
+
+//======================================================================
+
+TEST_CASE("BinaryScene TestCase4 Load performance", "[BinaryScene][3][!benchmark]")
+{
+    EntitySystem::Init();
+
+    auto * source = CreateScene(100, 9);
+    auto const text = SerializeToJson(source).dump();
+    auto const data = BinaryScene::Encode(source);
+    EntitySystem::DestroyEntity(source);
+
+    WARN("Json size: " << text.size() << " bytes, Binary size: " << data.size() << " bytes");
+
+    // Both paths create and destroy the same 1000 entities
+    BENCHMARK("Load 1000 entities from json")
+    {
+        auto * root = EntitySystem::CreateEntity("Loaded");
+        auto const json = nlohmann::json::parse(text);
+        root->Deserialize(json, true);
+        EntitySystem::DestroyEntity(root);
+    };
+
+    BENCHMARK("Load 1000 entities from binary")
+    {
+        auto * root = EntitySystem::CreateEntity("Loaded");
+        (void)BinaryScene::Load(data, root, true);
+        EntitySystem::DestroyEntity(root);
+    };
+
+    BENCHMARK("Parse json")
+    {
+        return nlohmann::json::parse(text).size();
+    };
+
+    BENCHMARK("Parse binary")
+    {
+        auto * root = EntitySystem::CreateEntity("Loaded");
+        BinaryScene::SceneLoader loader {data, root, {}};
+        auto const isValid = loader.IsValid();
+        EntitySystem::DestroyEntity(root);
+        return isValid;
+    };
+
+    EntitySystem::Shutdown();
+}
+
+//======================================================================
@@ -0,0 +1,477 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/BedrockMath.hpp"
+#include "engine/asset_system/AssetTexture.hpp"
+#include "engine/job_system/JobSystem.hpp"
+#include "tools/BlockCompressor.hpp"
+#include "tools/ImageUtils.hpp"
+#include "tools/Importer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    // Reference decoders that only follow the specification, So the tests do not share code with the encoders
+
+    uint64_t ReadBits(uint8_t const * block, uint32_t & position, uint32_t const bitCount)
+    {
+        uint64_t value = 0;
+        for (uint32_t i = 0; i < bitCount; ++i, ++position)
+        {
+            value |= static_cast<uint64_t>((block[position / 8] >> (position % 8)) & 1) << i;
+        }
+        return value;
+    }
+
+    std::array<uint8_t, 16> DecodeBC4(uint8_t const * block)
+    {
+        int const first = block[0];
+        int const second = block[1];
+        std::array<int, 8> palette {first, second};
+        if (first > second)
+        {
+            for (int i = 2; i < 8; ++i)
+            {
+                palette[i] = ((8 - i) * first + (i - 1) * second + 3) / 7;
+            }
+        }
+        else
+        {
+            for (int i = 2; i < 6; ++i)
+            {
+                palette[i] = ((6 - i) * first + (i - 1) * second + 2) / 5;
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+        std::array<uint8_t, 16> values {};
+        uint32_t position = 16;
+        for (auto & value : values)
+        {
+            value = static_cast<uint8_t>(palette[ReadBits(block, position, 3)]);
+        }
+        return values;
+    }
+
+    // Only mode 6 is written by the encoder
+    std::array<std::array<uint8_t, 4>, 16> DecodeBC7(uint8_t const * block)
+    {
+        static constexpr std::array<int, 16> Weights {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        uint32_t position = 0;
+        REQUIRE(ReadBits(block, position, 7) == 1 << 6);
+        std::array<std::array<int, 4>, 2> endpoints {};
+        for (int component = 0; component < 4; ++component)
+        {
+            endpoints[0][component] = static_cast<int>(ReadBits(block, position, 7));
+            endpoints[1][component] = static_cast<int>(ReadBits(block, position, 7));
+        }
+        for (auto & endpoint : endpoints)
+        {
+            auto const pBit = static_cast<int>(ReadBits(block, position, 1));
+            for (auto & value : endpoint)
+            {
+                value = (value << 1) | pBit;
+            }
+        }
+        std::array<std::array<uint8_t, 4>, 16> pixels {};
+        for (int i = 0; i < 16; ++i)
+        {
+            auto const weight = Weights[ReadBits(block, position, i == 0 ? 3 : 4)];
+            for (int component = 0; component < 4; ++component)
+            {
+                pixels[i][component] = static_cast<uint8_t>(((64 - weight) * endpoints[0][component] + weight * endpoints[1][component] + 32) >> 6);
+            }
+        }
+        CHECK(position == 128);
+        return pixels;
+    }
+
+    std::vector<uint8_t> Compress(
+        BlockCompressor::Codec const codec,
+        std::vector<uint8_t> const & image,
+        uint32_t const width,
+        uint32_t const height,
+        uint32_t const components
+    )
+    {
+        std::vector<uint8_t> blocks (BlockCompressor::CompressedSizeBytes(codec, width, height));
+        BlockCompressor::Compress(
+            codec,
+            CBlob {image.data(), image.size()},
+            width,
+            height,
+            components,
+            Blob {blocks.data(), blocks.size()}
+        );
+        return blocks;
+    }
+
+    // Decodes the blocks back to an image with the same layout as the input, Components that the codec drops are left as 0
+    std::vector<uint8_t> Decompress(
+        BlockCompressor::Codec const codec,
+        std::vector<uint8_t> const & blocks,
+        uint32_t const width,
+        uint32_t const height,
+        uint32_t const components
+    )
+    {
+        std::vector<uint8_t> image (width * height * components);
+        auto const blockCountX = (width + 3) / 4;
+        auto const blockSize = BlockCompressor::BlockSizeBytes(codec);
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                auto const * block = blocks.data() + ((y / 4) * blockCountX + x / 4) * blockSize;
+                auto const pixelIndex = (y % 4) * 4 + x % 4;
+                auto * pixel = image.data() + (y * width + x) * components;
+                switch (codec)
+                {
+                case BlockCompressor::Codec::BC4:
+                    pixel[0] = DecodeBC4(block)[pixelIndex];
+                    break;
+                case BlockCompressor::Codec::BC5:
+                    pixel[0] = DecodeBC4(block)[pixelIndex];
+                    pixel[1] = DecodeBC4(block + 8)[pixelIndex];
+                    break;
+                case BlockCompressor::Codec::BC7:
+                {
+                    auto const decoded = DecodeBC7(block)[pixelIndex];
+                    for (uint32_t component = 0; component < components; ++component)
+                    {
+                        pixel[component] = decoded[component];
+                    }
+                    break;
+                }
+                }
+            }
+        }
+        return image;
+    }
+
+    // Peak signal to noise ratio over the first componentsToCompare components of every pixel
+    double PSNR(
+        std::vector<uint8_t> const & original,
+        std::vector<uint8_t> const & decoded,
+        uint32_t const components,
+        uint32_t const componentsToCompare
+    )
+    {
+        double errorSum = 0.0;
+        size_t count = 0;
+        for (size_t i = 0; i < original.size(); i += components)
+        {
+            for (uint32_t component = 0; component < componentsToCompare; ++component)
+            {
+                auto const difference = static_cast<double>(original[i + component]) - decoded[i + component];
+                errorSum += difference * difference;
+                ++count;
+            }
+        }
+        if (errorSum == 0.0)
+        {
+            return 1000.0;
+        }
+        return 10.0 * std::log10(255.0 * 255.0 * static_cast<double>(count) / errorSum);
+    }
+
+    std::vector<uint8_t> RandomImage(Math::RandomGenerator & generator, uint32_t const width, uint32_t const height, uint32_t const components)
+    {
+        std::vector<uint8_t> image (width * height * components);
+        for (auto & value : image)
+        {
+            value = static_cast<uint8_t>(generator.NextUInt() & 0xFF);
+        }
+        return image;
+    }
+
+    // Low frequency waves of a few tints with a little noise, Close to the content of real textures
+    std::vector<uint8_t> SmoothImage(Math::RandomGenerator & generator, uint32_t const width, uint32_t const height, uint32_t const components)
+    {
+        std::vector<uint8_t> image (width * height * components);
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                auto const wave = std::sin(static_cast<float>(x) * 0.09f) * std::cos(static_cast<float>(y) * 0.07f);
+                for (uint32_t component = 0; component < components; ++component)
+                {
+                    auto const amplitude = 110.0f - 25.0f * static_cast<float>(component);
+                    auto const noise = generator.NextFloat(-2.0f, 2.0f);
+                    image[(y * width + x) * components + component] = static_cast<uint8_t>(std::clamp(127.5f + amplitude * wave + noise, 0.0f, 255.0f));
+                }
+            }
+        }
+        return image;
+    }
+}
+
+//======================================================================
+
+TEST_CASE("BlockCompressor TestCase1 Sizes", "[BlockCompressor][0]")
+{
+    using Codec = BlockCompressor::Codec;
+    CHECK(BlockCompressor::CompressedSizeBytes(Codec::BC4, 1, 1) == 8);
+    CHECK(BlockCompressor::CompressedSizeBytes(Codec::BC4, 5, 3) == 16);
+    CHECK(BlockCompressor::CompressedSizeBytes(Codec::BC5, 8, 8) == 64);
+    CHECK(BlockCompressor::CompressedSizeBytes(Codec::BC7, 9, 4) == 48);
+
+    // Texture asset agrees on the size of compressed levels
+    CHECK(AS::Texture::MipSizeBytes(AS::TextureFormat::BC4_UNorm_Linear_R, 1, {5, 3, 1}) == 16);
+    CHECK(AS::Texture::MipSizeBytes(AS::TextureFormat::BC5_UNorm_Linear_RG, 1, {8, 8, 1}) == 64);
+    CHECK(AS::Texture::MipSizeBytes(AS::TextureFormat::BC7_UNorm_Linear_RGBA, 1, {9, 4, 1}) == 48);
+    CHECK(AS::Texture::MipSizeBytes(AS::TextureFormat::BC7_UNorm_sRGB_RGBA, 1, {1, 1, 1}) == 16);
+}
+
+TEST_CASE("BlockCompressor TestCase2 BC4 and BC5", "[BlockCompressor][1]")
+{
+    using Codec = BlockCompressor::Codec;
+    Math::RandomGenerator generator {1};
+
+    // Constant blocks are exact
+    std::vector<uint8_t> constant (8 * 4, 77);
+    CHECK(Decompress(Codec::BC4, Compress(Codec::BC4, constant, 8, 4, 1), 8, 4, 1) == constant);
+
+    // Every value is within half a palette step of the block range
+    static constexpr uint32_t Width = 37;
+    static constexpr uint32_t Height = 21;
+    for (uint32_t const components : {1u, 2u, 4u})
+    {
+        auto const image = RandomImage(generator, Width, Height, components);
+        auto const codec = components == 1 ? Codec::BC4 : Codec::BC5;
+        auto const decoded = Decompress(codec, Compress(codec, image, Width, Height, components), Width, Height, components);
+        auto const checkedComponents = codec == Codec::BC4 ? 1u : 2u;
+        for (uint32_t blockY = 0; blockY < Height; blockY += 4)
+        {
+            for (uint32_t blockX = 0; blockX < Width; blockX += 4)
+            {
+                for (uint32_t component = 0; component < checkedComponents; ++component)
+                {
+                    int minValue = 255;
+                    int maxValue = 0;
+                    for (uint32_t y = blockY; y < std::min(blockY + 4, Height); ++y)
+                    {
+                        for (uint32_t x = blockX; x < std::min(blockX + 4, Width); ++x)
+                        {
+                            int const value = image[(y * Width + x) * components + component];
+                            minValue = std::min(minValue, value);
+                            maxValue = std::max(maxValue, value);
+                        }
+                    }
+                    auto const tolerance = (maxValue - minValue) / 14 + 1;
+                    for (uint32_t y = blockY; y < std::min(blockY + 4, Height); ++y)
+                    {
+                        for (uint32_t x = blockX; x < std::min(blockX + 4, Width); ++x)
+                        {
+                            auto const index = (y * Width + x) * components + component;
+                            REQUIRE(std::abs(image[index] - decoded[index]) <= tolerance);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    auto const smoothImage = SmoothImage(generator, 64, 64, 2);
+    auto const decoded = Decompress(Codec::BC5, Compress(Codec::BC5, smoothImage, 64, 64, 2), 64, 64, 2);
+    CHECK(PSNR(smoothImage, decoded, 2, 2) > 40.0);
+}
+
+TEST_CASE("BlockCompressor TestCase3 BC7", "[BlockCompressor][2]")
+{
+    using Codec = BlockCompressor::Codec;
+    Math::RandomGenerator generator {2};
+
+    // Constant colors are off by at most one since the p bit is shared by the components of an endpoint
+    for (int i = 0; i < 64; ++i)
+    {
+        std::array<uint8_t, 4> const color {
+            static_cast<uint8_t>(generator.NextUInt()),
+            static_cast<uint8_t>(generator.NextUInt()),
+            static_cast<uint8_t>(generator.NextUInt()),
+            static_cast<uint8_t>(generator.NextUInt())
+        };
+        std::vector<uint8_t> image {};
+        for (int pixel = 0; pixel < 16; ++pixel)
+        {
+            image.insert(image.end(), color.begin(), color.end());
+        }
+        auto const decoded = Decompress(Codec::BC7, Compress(Codec::BC7, image, 4, 4, 4), 4, 4, 4);
+        for (size_t j = 0; j < image.size(); ++j)
+        {
+            REQUIRE(std::abs(image[j] - decoded[j]) <= 1);
+        }
+    }
+
+    static constexpr uint32_t Size = 64;
+    auto const smoothImage = SmoothImage(generator, Size, Size, 4);
+    auto const smoothDecoded = Decompress(Codec::BC7, Compress(Codec::BC7, smoothImage, Size, Size, 4), Size, Size, 4);
+    CHECK(PSNR(smoothImage, smoothDecoded, 4, 4) > 40.0);
+
+    // Opaque images stay exactly opaque, Missing alpha is read as opaque
+    auto const colorImage = SmoothImage(generator, Size, Size, 3);
+    auto const colorBlocks = Compress(Codec::BC7, colorImage, Size, Size, 3);
+    auto const colorDecoded = Decompress(Codec::BC7, colorBlocks, Size, Size, 3);
+    CHECK(PSNR(colorImage, colorDecoded, 3, 3) > 40.0);
+    for (size_t block = 0; block < colorBlocks.size(); block += 16)
+    {
+        for (auto const & pixel : DecodeBC7(colorBlocks.data() + block))
+        {
+            REQUIRE(pixel[3] == 255);
+        }
+    }
+
+    // Noise is the worst case for a single subset, It still has to stay close to the block average
+    auto const noise = RandomImage(generator, 33, 17, 4);
+    auto const noiseDecoded = Decompress(Codec::BC7, Compress(Codec::BC7, noise, 33, 17, 4), 33, 17, 4);
+    CHECK(PSNR(noise, noiseDecoded, 4, 4) > 12.0);
+}
+
+TEST_CASE("BlockCompressor TestCase4 Parallel", "[BlockCompressor][3]")
+{
+    using Codec = BlockCompressor::Codec;
+    Math::RandomGenerator generator {3};
+    auto const image = SmoothImage(generator, 301, 203, 4);
+
+    std::vector<std::vector<uint8_t>> serialBlocks {};
+    for (auto const codec : {Codec::BC4, Codec::BC5, Codec::BC7})
+    {
+        serialBlocks.emplace_back(Compress(codec, image, 301, 203, 4));
+    }
+
+    JS::Init();
+    size_t index = 0;
+    for (auto const codec : {Codec::BC4, Codec::BC5, Codec::BC7})
+    {
+        CHECK(Compress(codec, image, 301, 203, 4) == serialBlocks[index]);
+        ++index;
+    }
+    JS::Shutdown();
+}
+
+TEST_CASE("BlockCompressor TestCase5 Compressed texture", "[BlockCompressor][4]")
+{
+    Math::RandomGenerator generator {4};
+    static constexpr uint32_t Size = 64;
+    auto const image = SmoothImage(generator, Size, Size, 4);
+
+    auto const texture = Importer::ImportInMemoryTexture(
+        "BlockCompressorTest",
+        CBlob {image.data(), image.size()},
+        Size,
+        Size,
+        AS::TextureFormat::UNCOMPRESSED_UNORM_R8G8B8A8_LINEAR,
+        4,
+        1,
+        1,
+        Importer::ImportTextureOptions {.tryToGenerateMipmaps = true}
+    );
+    REQUIRE(texture != nullptr);
+
+    CHECK(Importer::CompressTexture(*texture, AS::TextureUsage::Generic) == nullptr);
+
+    struct Expectation
+    {
+        AS::TextureUsage usage;
+        AS::TextureFormat format;
+        BlockCompressor::Codec codec;
+        char const * suffix;
+    };
+    for (auto const & [usage, format, codec, suffix] : {
+        Expectation {AS::TextureUsage::Color, AS::TextureFormat::BC7_UNorm_Linear_RGBA, BlockCompressor::Codec::BC7, ".bc7.ktx"},
+        Expectation {AS::TextureUsage::Normal, AS::TextureFormat::BC5_UNorm_Linear_RG, BlockCompressor::Codec::BC5, ".bc5.ktx"},
+        Expectation {AS::TextureUsage::Mask, AS::TextureFormat::BC4_UNorm_Linear_R, BlockCompressor::Codec::BC4, ".bc4.ktx"}
+    })
+    {
+        auto const compressed = Importer::CompressTexture(*texture, usage);
+        REQUIRE(compressed != nullptr);
+        CHECK(compressed->GetFormat() == format);
+        REQUIRE(compressed->GetMipCount() == texture->GetMipCount());
+
+        // Each level is the compressed version of the same uncompressed level
+        for (uint8_t mipLevel = 0; mipLevel < texture->GetMipCount(); ++mipLevel)
+        {
+            auto const & source = texture->GetMipmap(mipLevel);
+            auto const & mipmap = compressed->GetMipmap(mipLevel);
+            REQUIRE(mipmap.dimension.width == source.dimension.width);
+            REQUIRE(mipmap.dimension.height == source.dimension.height);
+            REQUIRE(mipmap.size == AS::Texture::MipSizeBytes(format, 1, mipmap.dimension));
+
+            auto const * sourcePixels = texture->GetBuffer().ptr + source.offset;
+            std::vector<uint8_t> const sourceImage (sourcePixels, sourcePixels + source.size);
+            auto const expected = Compress(codec, sourceImage, source.dimension.width, source.dimension.height, 4);
+            auto const * blocks = compressed->GetBuffer().ptr + mipmap.offset;
+            CHECK(std::equal(expected.begin(), expected.end(), blocks));
+        }
+
+        // Cache survives the round trip through KTX
+        auto const cachePath = Importer::CompressedImagePath(
+            (std::filesystem::temp_directory_path() / "BlockCompressorTest.png").string(),
+            usage
+        );
+        CHECK(cachePath.ends_with(suffix));
+        REQUIRE(Utils::KTXTexture::Save(*compressed, cachePath));
+
+        auto const loaded = Importer::ImportKTXImage(cachePath);
+        REQUIRE(loaded != nullptr);
+        REQUIRE(loaded->isValid());
+        CHECK(loaded->GetFormat() == format);
+        REQUIRE(loaded->GetMipCount() == compressed->GetMipCount());
+        for (uint8_t mipLevel = 0; mipLevel < loaded->GetMipCount(); ++mipLevel)
+        {
+            auto const & expected = compressed->GetMipmap(mipLevel);
+            auto const & actual = loaded->GetMipmap(mipLevel);
+            REQUIRE(actual.size == expected.size);
+            CHECK(std::equal(
+                compressed->GetBuffer().ptr + expected.offset,
+                compressed->GetBuffer().ptr + expected.offset + expected.size,
+                loaded->GetBuffer().ptr + actual.offset
+            ));
+        }
+        std::filesystem::remove(cachePath);
+    }
+}
+
+TEST_CASE("BlockCompressor TestCase6 Throughput", "[BlockCompressor][5][!benchmark]")
+{
+    using Codec = BlockCompressor::Codec;
+    Math::RandomGenerator generator {5};
+    static constexpr uint32_t Size = 1024;
+    auto const image = SmoothImage(generator, Size, Size, 4);
+
+    BENCHMARK("BC4 1024")
+    {
+        return Compress(Codec::BC4, image, Size, Size, 4);
+    };
+
+    BENCHMARK("BC5 1024")
+    {
+        return Compress(Codec::BC5, image, Size, Size, 4);
+    };
+
+    BENCHMARK("BC7 1024")
+    {
+        return Compress(Codec::BC7, image, Size, Size, 4);
+    };
+
+    JS::Init();
+    BENCHMARK("BC7 1024 job system")
+    {
+        return Compress(Codec::BC7, image, Size, Size, 4);
+    };
+    JS::Shutdown();
+}
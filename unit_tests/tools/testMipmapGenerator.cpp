@@ -0,0 +1,271 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/BedrockMath.hpp"
+#include "engine/asset_system/AssetTexture.hpp"
+#include "engine/job_system/JobSystem.hpp"
+#include "tools/Importer.hpp"
+#include "tools/MipmapGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    std::vector<uint8_t> Downsample(
+        std::vector<uint8_t> const & input,
+        uint32_t const width,
+        uint32_t const height,
+        uint32_t const components,
+        MipmapGenerator::Params const & params = {}
+    )
+    {
+        auto const outputWidth = MipmapGenerator::NextMipSize(width);
+        auto const outputHeight = MipmapGenerator::NextMipSize(height);
+        std::vector<uint8_t> output (outputWidth * outputHeight * components);
+        MipmapGenerator::Downsample(
+            CBlob {input.data(), input.size()},
+            width,
+            height,
+            components,
+            Blob {output.data(), output.size()},
+            outputWidth,
+            outputHeight,
+            params
+        );
+        return output;
+    }
+
+    std::vector<uint8_t> RandomImage(Math::RandomGenerator & generator, uint32_t const width, uint32_t const height, uint32_t const components)
+    {
+        std::vector<uint8_t> image (width * height * components);
+        for (auto & value : image)
+        {
+            value = static_cast<uint8_t>(generator.NextUInt() & 0xFF);
+        }
+        return image;
+    }
+
+    double Mean(std::vector<uint8_t> const & image)
+    {
+        double sum = 0.0;
+        for (auto const value : image)
+        {
+            sum += value;
+        }
+        return sum / static_cast<double>(image.size());
+    }
+}
+
+//======================================================================
+
+TEST_CASE("Mipmap TestCase1 Box filter", "[Mipmap][0]")
+{
+    // Each output pixel is the average of a 2x2 block
+    std::vector<uint8_t> const image {
+        0,   10,  20,  30,
+        40,  50,  60,  70,
+        100, 100, 200, 200,
+        100, 100, 200, 201
+    };
+    auto const mip = Downsample(image, 4, 4, 1);
+    REQUIRE(mip.size() == 4);
+    CHECK(mip[0] == 25);
+    CHECK(mip[1] == 45);
+    CHECK(mip[2] == 100);
+    CHECK(mip[3] == 200);
+
+    // Odd sizes cover fractions of the edge pixels, So the mean is kept
+    Math::RandomGenerator generator {1};
+    for (uint32_t size : {3u, 5u, 7u, 33u})
+    {
+        auto const oddImage = RandomImage(generator, size, size + 2, 2);
+        auto const oddMip = Downsample(oddImage, size, size + 2, 2);
+        CHECK(Mean(oddMip) == Approx(Mean(oddImage)).margin(1.0));
+    }
+}
+
+TEST_CASE("Mipmap TestCase2 Constant image", "[Mipmap][1]")
+{
+    for (auto const filter : {MipmapGenerator::Filter::Box, MipmapGenerator::Filter::Kaiser})
+    {
+        for (bool const isSrgb : {false, true})
+        {
+            std::vector<uint8_t> image (13 * 6 * 4);
+            for (size_t i = 0; i < image.size(); i += 4)
+            {
+                image[i] = 17;
+                image[i + 1] = 128;
+                image[i + 2] = 250;
+                image[i + 3] = 99;
+            }
+            auto const mip = Downsample(image, 13, 6, 4, {.filter = filter, .isSrgb = isSrgb});
+            for (size_t i = 0; i < mip.size(); i += 4)
+            {
+                REQUIRE(mip[i] == 17);
+                REQUIRE(mip[i + 1] == 128);
+                REQUIRE(mip[i + 2] == 250);
+                REQUIRE(mip[i + 3] == 99);
+            }
+        }
+    }
+}
+
+TEST_CASE("Mipmap TestCase3 sRGB", "[Mipmap][2]")
+{
+    // Black and white checkerboard with half transparent alpha
+    std::vector<uint8_t> image {};
+    for (int y = 0; y < 2; ++y)
+    {
+        for (int x = 0; x < 2; ++x)
+        {
+            auto const value = static_cast<uint8_t>((x + y) % 2 == 0 ? 0 : 255);
+            image.insert(image.end(), {value, value, value, static_cast<uint8_t>(value == 0 ? 0 : 255)});
+        }
+    }
+
+    // Half of the light in linear space is 188 in sRGB, Averaging the encoded values would give a too dark 128
+    auto const srgbMip = Downsample(image, 2, 2, 4, {.isSrgb = true});
+    CHECK(srgbMip[0] == 188);
+    CHECK(srgbMip[1] == 188);
+    CHECK(srgbMip[2] == 188);
+    CHECK(srgbMip[3] == 128);
+
+    auto const linearMip = Downsample(image, 2, 2, 4);
+    CHECK(linearMip[0] == 128);
+    CHECK(linearMip[3] == 128);
+
+    // Every code survives the round trip through linear space
+    std::vector<uint8_t> ramp (256 * 2);
+    for (int i = 0; i < 256; ++i)
+    {
+        ramp[i * 2] = static_cast<uint8_t>(i);
+        ramp[i * 2 + 1] = static_cast<uint8_t>(i);
+    }
+    std::vector<uint8_t> rampMip (256);
+    MipmapGenerator::Downsample(
+        CBlob {ramp.data(), ramp.size()}, 2, 256, 1,
+        Blob {rampMip.data(), rampMip.size()}, 1, 256,
+        {.isSrgb = true}
+    );
+    for (int i = 0; i < 256; ++i)
+    {
+        REQUIRE(rampMip[i] == i);
+    }
+}
+
+TEST_CASE("Mipmap TestCase4 Kaiser filter", "[Mipmap][3]")
+{
+    // Kaiser keeps more of the contrast of a pattern that is still visible in the next level
+    std::vector<uint8_t> image (64 * 64);
+    for (uint32_t y = 0; y < 64; ++y)
+    {
+        for (uint32_t x = 0; x < 64; ++x)
+        {
+            image[y * 64 + x] = static_cast<uint8_t>(127.5f + 127.5f * std::sin(static_cast<float>(x) * Math::PiFloat / 4.0f));
+        }
+    }
+    auto const contrast = [](std::vector<uint8_t> const & mip)->int
+    {
+        auto const [min, max] = std::minmax_element(mip.begin(), mip.end());
+        return *max - *min;
+    };
+    auto const boxMip = Downsample(image, 64, 64, 1, {.filter = MipmapGenerator::Filter::Box});
+    auto const kaiserMip = Downsample(image, 64, 64, 1, {.filter = MipmapGenerator::Filter::Kaiser});
+    CHECK(contrast(kaiserMip) > contrast(boxMip));
+    CHECK(Mean(kaiserMip) == Approx(Mean(image)).margin(2.0));
+}
+
+TEST_CASE("Mipmap TestCase5 Parallel", "[Mipmap][4]")
+{
+    Math::RandomGenerator generator {2};
+    auto const image = RandomImage(generator, 1000, 700, 4);
+
+    auto const serialMip = Downsample(image, 1000, 700, 4, {.filter = MipmapGenerator::Filter::Kaiser, .isSrgb = true});
+
+    JS::Init();
+    auto const parallelMip = Downsample(image, 1000, 700, 4, {.filter = MipmapGenerator::Filter::Kaiser, .isSrgb = true});
+    JS::Shutdown();
+
+    CHECK(parallelMip == serialMip);
+}
+
+TEST_CASE("Mipmap TestCase6 Import", "[Mipmap][5]")
+{
+    Math::RandomGenerator generator {3};
+    static constexpr uint32_t Width = 37;
+    static constexpr uint32_t Height = 20;
+    auto const image = RandomImage(generator, Width, Height, 4);
+
+    auto const texture = Importer::ImportInMemoryTexture(
+        "MipmapTest",
+        CBlob {image.data(), image.size()},
+        Width,
+        Height,
+        AS::TextureFormat::UNCOMPRESSED_UNORM_R8G8B8A8_LINEAR,
+        4,
+        1,
+        1,
+        Importer::ImportTextureOptions {.tryToGenerateMipmaps = true}
+    );
+    REQUIRE(texture != nullptr);
+    REQUIRE(texture->GetMipCount() == 7);
+
+    // Every level is made from the previous one
+    std::vector<uint8_t> expected = image;
+    uint32_t width = Width;
+    uint32_t height = Height;
+    for (uint8_t mipLevel = 1; mipLevel < texture->GetMipCount(); ++mipLevel)
+    {
+        expected = Downsample(expected, width, height, 4);
+        width = MipmapGenerator::NextMipSize(width);
+        height = MipmapGenerator::NextMipSize(height);
+
+        auto const & mipmap = texture->GetMipmap(mipLevel);
+        REQUIRE(mipmap.dimension.width == width);
+        REQUIRE(mipmap.dimension.height == height);
+        REQUIRE(mipmap.size == expected.size());
+        auto const * pixels = texture->GetBuffer().ptr + mipmap.offset;
+        CHECK(std::equal(expected.begin(), expected.end(), pixels));
+    }
+    CHECK(width == 1);
+    CHECK(height == 1);
+}
+
+TEST_CASE("Mipmap TestCase7 Throughput", "[Mipmap][6][!benchmark]")
+{
+    Math::RandomGenerator generator {4};
+    static constexpr uint32_t Size = 2048;
+    auto const image = RandomImage(generator, Size, Size, 4);
+
+    BENCHMARK("Box 2048 sRGB")
+    {
+        return Downsample(image, Size, Size, 4, {.isSrgb = true});
+    };
+
+    BENCHMARK("Kaiser 2048 sRGB")
+    {
+        return Downsample(image, Size, Size, 4, {.filter = MipmapGenerator::Filter::Kaiser, .isSrgb = true});
+    };
+
+    JS::Init();
+    BENCHMARK("Box 2048 sRGB job system")
+    {
+        return Downsample(image, Size, Size, 4, {.isSrgb = true});
+    };
+
+    BENCHMARK("Kaiser 2048 sRGB job system")
+    {
+        return Downsample(image, Size, Size, 4, {.filter = MipmapGenerator::Filter::Kaiser, .isSrgb = true});
+    };
+    JS::Shutdown();
+}
@@ -0,0 +1,339 @@
+//======================================================================
+//
+//======================================================================
+
+#include "catch.hpp"
+
+#include "engine/asset_system/AssetTexture.hpp"
+#include "tools/ImageUtils.hpp"
+#include "tools/Importer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace MFA;
+
+//======================================================================
+
+namespace
+{
+    struct Level
+    {
+        uint32_t width;
+        uint32_t height;
+        std::vector<uint8_t> bytes;
+    };
+
+    std::vector<Level> MakeLevels(AS::TextureFormat const format, uint32_t width, uint32_t height, uint32_t const count)
+    {
+        std::vector<Level> levels {};
+        uint8_t value = 1;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto const size = AS::Texture::MipSizeBytes(
+                format,
+                1,
+                AS::Texture::Dimensions {.width = width, .height = height, .depth = 1}
+            );
+            Level level {width, height, std::vector<uint8_t>(size)};
+            for (auto & byte : level.bytes)
+            {
+                byte = value++;
+            }
+            levels.emplace_back(std::move(level));
+            width = std::max<uint32_t>(width / 2, 1);
+            height = std::max<uint32_t>(height / 2, 1);
+        }
+        return levels;
+    }
+
+    void WriteFile(std::string const & path, std::vector<uint8_t> const & bytes)
+    {
+        std::ofstream file {path, std::ios::binary | std::ios::trunc};
+        file.write(reinterpret_cast<char const *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    template<typename T>
+    void Append(std::vector<uint8_t> & bytes, T const & value)
+    {
+        auto const * ptr = reinterpret_cast<uint8_t const *>(&value);
+        bytes.insert(bytes.end(), ptr, ptr + sizeof(T));
+    }
+
+    // Zstd frame made of raw blocks, Any zstd decoder must accept it so the test does not need an encoder
+    std::vector<uint8_t> MakeZstdFrame(std::vector<uint8_t> const & content)
+    {
+        static constexpr size_t MaxBlockSize = 128 * 1024;
+
+        std::vector<uint8_t> frame {};
+        Append(frame, static_cast<uint32_t>(0xFD2FB528));         // Magic number
+        frame.emplace_back(static_cast<uint8_t>(0xE0));             // Single segment with an 8 byte content size
+        Append(frame, static_cast<uint64_t>(content.size()));
+
+        size_t offset = 0;
+        do
+        {
+            auto const blockSize = std::min(content.size() - offset, MaxBlockSize);
+            auto const isLast = offset + blockSize == content.size();
+            auto const blockHeader = static_cast<uint32_t>(blockSize << 3) | (isLast ? 1u : 0u);
+            frame.emplace_back(static_cast<uint8_t>(blockHeader));
+            frame.emplace_back(static_cast<uint8_t>(blockHeader >> 8));
+            frame.emplace_back(static_cast<uint8_t>(blockHeader >> 16));
+            frame.insert(frame.end(), content.begin() + offset, content.begin() + offset + blockSize);
+            offset += blockSize;
+        } while (offset < content.size());
+
+        return frame;
+    }
+
+    // Levels are stored smallest first as the specification recommends, So the index is not in file order
+    std::vector<uint8_t> MakeKTX2(
+        uint32_t const vkFormat,
+        uint32_t const supercompression,
+        std::vector<Level> const & levels
+    )
+    {
+        using namespace Utils::KTX2Texture;
+
+        std::vector<std::vector<uint8_t>> levelBytes {};
+        for (auto const & level : levels)
+        {
+            auto const isZstd = supercompression == static_cast<uint32_t>(SupercompressionScheme::Zstandard);
+            levelBytes.emplace_back(isZstd ? MakeZstdFrame(level.bytes) : level.bytes);
+        }
+
+        Header header {};
+        static constexpr uint8_t Identifier[12] {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+        std::memcpy(header.identifier, Identifier, sizeof(Identifier));
+        header.vk_format = vkFormat;
+        header.type_size = 1;
+        header.pixel_width = levels[0].width;
+        header.pixel_height = levels[0].height;
+        header.face_count = 1;
+        header.level_count = static_cast<uint32_t>(levels.size());
+        header.supercompression_scheme = supercompression;
+
+        std::vector<LevelIndex> index (levels.size());
+        uint64_t offset = sizeof(Header) + sizeof(LevelIndex) * levels.size();
+        for (auto i = static_cast<int>(levels.size()) - 1; i >= 0; --i)
+        {
+            index[i] = LevelIndex {offset, levelBytes[i].size(), levels[i].bytes.size()};
+            offset += levelBytes[i].size();
+        }
+
+        std::vector<uint8_t> bytes {};
+        Append(bytes, header);
+        for (auto const & entry : index)
+        {
+            Append(bytes, entry);
+        }
+        for (auto i = static_cast<int>(levels.size()) - 1; i >= 0; --i)
+        {
+            bytes.insert(bytes.end(), levelBytes[i].begin(), levelBytes[i].end());
+        }
+        return bytes;
+    }
+
+    std::vector<uint8_t> MakeDDS(Utils::DDSTexture::DXGI_Format const format, std::vector<Level> const & levels)
+    {
+        using namespace Utils::DDSTexture;
+
+        DDS_Header header {};
+        header.magic.number = 0x20534444;           // "DDS "
+        header.dw_size = 124;
+        header.dw_flags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000;
+        header.dw_height = levels[0].height;
+        header.dw_width = levels[0].width;
+        header.dw_depth = 1;
+        header.dw_mip_map_count = static_cast<uint32_t>(levels.size());
+        header.dds_pixel_format.dw_size = 32;
+        header.dds_pixel_format.dw_flags = 0x4;
+        std::memcpy(header.dds_pixel_format.dw_four_cc.character, "DX10", 4);
+
+        DDS_Header_DXT10 dx10Header {};
+        dx10Header.dxgi_format = format;
+        dx10Header.resource_dimension = D3D10_ResourceDimension::D3D10_RESOURCE_DIMENSION_TEXTURE2D;
+        dx10Header.array_size = 1;
+
+        std::vector<uint8_t> bytes {};
+        Append(bytes, header);
+        Append(bytes, dx10Header);
+        for (auto const & level : levels)
+        {
+            bytes.insert(bytes.end(), level.bytes.begin(), level.bytes.end());
+        }
+        return bytes;
+    }
+
+    void CheckTexture(AS::Texture const & texture, AS::TextureFormat const format, std::vector<Level> const & levels)
+    {
+        CHECK(texture.GetFormat() == format);
+        REQUIRE(texture.GetMipCount() == levels.size());
+        for (uint8_t mipLevel = 0; mipLevel < texture.GetMipCount(); ++mipLevel)
+        {
+            auto const & mipmap = texture.GetMipmap(mipLevel);
+            CHECK(mipmap.dimension.width == levels[mipLevel].width);
+            CHECK(mipmap.dimension.height == levels[mipLevel].height);
+            REQUIRE(mipmap.size == levels[mipLevel].bytes.size());
+            CHECK(std::memcmp(
+                texture.GetBuffer().ptr + mipmap.offset,
+                levels[mipLevel].bytes.data(),
+                mipmap.size
+            ) == 0);
+        }
+    }
+
+    std::string TempPath(char const * name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+//======================================================================
+
+TEST_CASE("TextureContainers TestCase1 KTX2", "[TextureContainers][0]")
+{
+    using namespace Utils::KTX2Texture;
+
+    struct Expectation
+    {
+        VkFormat vkFormat;
+        AS::TextureFormat format;
+    };
+    for (auto const & [vkFormat, format] : {
+        Expectation {VkFormat::BC7_sRGB, AS::TextureFormat::BC7_UNorm_sRGB_RGBA},
+        Expectation {VkFormat::BC5_UNorm, AS::TextureFormat::BC5_UNorm_Linear_RG},
+        Expectation {VkFormat::BC4_UNorm, AS::TextureFormat::BC4_UNorm_Linear_R},
+        Expectation {VkFormat::R8G8B8A8_UNorm, AS::TextureFormat::UNCOMPRESSED_UNORM_R8G8B8A8_LINEAR}
+    })
+    {
+        auto const levels = MakeLevels(format, 32, 16, 6);
+        auto const path = TempPath("TextureContainersTest.ktx2");
+        WriteFile(path, MakeKTX2(static_cast<uint32_t>(vkFormat), 0, levels));
+
+        auto const texture = Importer::ImportImage(path);
+        REQUIRE(texture != nullptr);
+        CheckTexture(*texture, format, levels);
+
+        std::filesystem::remove(path);
+    }
+}
+
+//======================================================================
+
+TEST_CASE("TextureContainers TestCase2 KTX2 rejects unsupported files", "[TextureContainers][1]")
+{
+    using namespace Utils::KTX2Texture;
+
+    auto const path = TempPath("TextureContainersTest.ktx2");
+    auto const levels = MakeLevels(AS::TextureFormat::BC7_UNorm_Linear_RGBA, 16, 16, 3);
+
+    // Zlib supercompression
+    WriteFile(path, MakeKTX2(
+        static_cast<uint32_t>(VkFormat::BC7_UNorm),
+        static_cast<uint32_t>(SupercompressionScheme::ZLIB),
+        levels
+    ));
+    LoadResult loadResult = LoadResult::Invalid;
+    CHECK(Load(loadResult, path) == nullptr);
+    CHECK(loadResult == LoadResult::NotSupported_Supercompression);
+    CHECK(Importer::ImportImage(path) == nullptr);
+
+    // Basis universal payloads have no vkFormat
+    WriteFile(path, MakeKTX2(static_cast<uint32_t>(VkFormat::Undefined), 0, levels));
+    CHECK(Load(loadResult, path) == nullptr);
+    CHECK(loadResult == LoadResult::NotSupported_Format);
+
+    // Truncated level data
+    auto bytes = MakeKTX2(static_cast<uint32_t>(VkFormat::BC7_UNorm), 0, levels);
+    bytes.resize(bytes.size() - 1);
+    WriteFile(path, bytes);
+    CHECK(Load(loadResult, path) == nullptr);
+    CHECK(loadResult == LoadResult::CorruptData_InvalidLevelIndex);
+
+    // Level offset past the end of the file
+    bytes = MakeKTX2(static_cast<uint32_t>(VkFormat::BC7_UNorm), 0, levels);
+    bytes[sizeof(Header)] = 0xFF;
+    bytes[sizeof(Header) + 7] = 0xFF;
+    WriteFile(path, bytes);
+    CHECK(Load(loadResult, path) == nullptr);
+    CHECK(loadResult == LoadResult::CorruptData_InvalidLevelIndex);
+
+    // Not a ktx2 file
+    bytes[0] = 0;
+    WriteFile(path, bytes);
+    CHECK(Load(loadResult, path) == nullptr);
+    CHECK(loadResult == LoadResult::CorruptData_InvalidIdentifier);
+
+    std::filesystem::remove(path);
+}
+
+//======================================================================
+
+TEST_CASE("TextureContainers TestCase3 KTX2 with zstd supercompression", "[TextureContainers][2]")
+{
+    using namespace Utils::KTX2Texture;
+
+    auto const path = TempPath("TextureContainersTest.ktx2");
+
+    // Base level is two full zstd blocks, So the frame has several blocks
+    auto const levels = MakeLevels(AS::TextureFormat::BC7_UNorm_Linear_RGBA, 512, 512, 4);
+    REQUIRE(levels[0].bytes.size() == 2 * 128 * 1024);
+    auto bytes = MakeKTX2(
+        static_cast<uint32_t>(VkFormat::BC7_UNorm),
+        static_cast<uint32_t>(SupercompressionScheme::Zstandard),
+        levels
+    );
+    WriteFile(path, bytes);
+
+    auto const texture = Importer::ImportImage(path);
+    REQUIRE(texture != nullptr);
+    CheckTexture(*texture, AS::TextureFormat::BC7_UNorm_Linear_RGBA, levels);
+
+    // Last block of the base level gets the reserved block type, ReadLevel reports it instead of producing a texture
+    bytes[bytes.size() - 128 * 1024 - 3] |= 0x06;
+    WriteFile(path, bytes);
+    LoadResult loadResult = LoadResult::Invalid;
+    auto const data = Load(loadResult, path);
+    REQUIRE(data != nullptr);
+    std::vector<uint8_t> destination (levels[0].bytes.size());
+    CHECK(ReadLevel(*data, 0, Blob {destination.data(), destination.size()}) == false);
+    CHECK(Importer::ImportImage(path) == nullptr);
+
+    std::filesystem::remove(path);
+}
+
+//======================================================================
+
+TEST_CASE("TextureContainers TestCase4 DDS", "[TextureContainers][3]")
+{
+    using namespace Utils::DDSTexture;
+
+    struct Expectation
+    {
+        DXGI_Format dxgiFormat;
+        AS::TextureFormat format;
+    };
+    for (auto const & [dxgiFormat, format] : {
+        Expectation {DXGI_Format::DXGI_FORMAT_BC7_UNORM, AS::TextureFormat::BC7_UNorm_Linear_RGB},
+        Expectation {DXGI_Format::DXGI_FORMAT_BC4_UNORM, AS::TextureFormat::BC4_UNorm_Linear_R},
+        Expectation {DXGI_Format::DXGI_FORMAT_R8G8B8A8_UNORM, AS::TextureFormat::UNCOMPRESSED_UNORM_R8G8B8A8_LINEAR}
+    })
+    {
+        auto const levels = MakeLevels(format, 16, 32, 6);
+        auto const path = TempPath("TextureContainersTest.dds");
+        WriteFile(path, MakeDDS(dxgiFormat, levels));
+
+        auto const texture = Importer::ImportImage(path);
+        REQUIRE(texture != nullptr);
+        CheckTexture(*texture, format, levels);
+
+        std::filesystem::remove(path);
+    }
+}
+
+//======================================================================